@@ -61,6 +61,7 @@ layout(std140, set = 0, binding = 5) readonly buffer MatSB
 }
 MaterialDataBuffer;
 
+// Unsized : the layout gives it VulkanDevice::BindlessTextureCount descriptors, indexed by GlobalTextures handles
 layout(set = 0, binding = 9) uniform sampler2D TextureArray[];
 
 MaterialData FetchMaterial(uint dataIndex)
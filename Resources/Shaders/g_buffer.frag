@@ -35,7 +35,9 @@ void main()
 
     if (material.NormalMap < INVALID_MAP_HANDLE)
     {
+        // Imported normal maps are BC5 (x and y only) : z is rebuilt from the unit length, in the same [0, 1] encoding
         uint texId = uint(material.NormalMap);
-        OutNormal  = texture(TextureArray[nonuniformEXT(texId)], TexCoord).rgb;
+        vec2 xy    = texture(TextureArray[nonuniformEXT(texId)], TexCoord).rg * 2.0 - 1.0;
+        OutNormal  = vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0))) * 0.5 + 0.5;
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #extension GL_EXT_shader_explicit_arithmetic_types_int64 : enable
 
 layout(location = 0) out vec4 fColor;
+// Unsized : the layout gives it VulkanDevice::BindlessTextureCount descriptors, indexed by GlobalTextures handles
 layout(set = 0, binding = 0) uniform sampler2D TextureArray[];
 
 layout(location = 0) in struct
@@ -5,14 +5,26 @@ struct DrawVertex
     float u, v;
 };
 
+/*
+ * Must match Meshes::VertexFormat and Meshes::IndexFormat (VertexQuantization.h)
+ */
+const uint VERTEX_FORMAT_FLOAT32 = 0;
+const uint VERTEX_FORMAT_COMPACT = 1;
+const uint INDEX_FORMAT_UINT32   = 0;
+const uint INDEX_FORMAT_UINT16   = 1;
+
 struct DrawData
 {
-    uint TransformIndex;
-    uint MaterialIndex;
-    uint VertexOffset;
-    uint IndexOffset;
-    uint VertexCount;
-    uint IndexCount;
+    uint  TransformIndex;
+    uint  MaterialIndex;
+    uint  VertexOffset;
+    uint  IndexOffset;
+    uint  VertexCount;
+    uint  IndexCount;
+    uint  VertexFormat;
+    uint  IndexFormat;
+    float PositionMin[3];
+    float PositionExtent[3];
 };
 
 struct DrawDataView
@@ -32,9 +44,12 @@ layout(set = 0, binding = 0) uniform UBCamera
 }
 Camera;
 
+/*
+ * Raw words : a vertex is 8 floats (VERTEX_FORMAT_FLOAT32) or 4 packed words (VERTEX_FORMAT_COMPACT), see DecodeVertex()
+ */
 layout(set = 0, binding = 1) readonly buffer VertexSB
 {
-    DrawVertex Data[];
+    uint Data[];
 }
 VertexBuffer;
 layout(set = 0, binding = 2) readonly buffer IndexSB
@@ -52,15 +67,80 @@ layout(set = 0, binding = 4) readonly buffer TransformSB
     mat4 Data[];
 }
 TransformBuffer;
+/*
+ * DrawData index of every instance : nodes sharing a mesh and a material are instances of one indirect command
+ * (see DrawInstancing), gl_InstanceIndex starts at the command firstInstance
+ */
+layout(set = 0, binding = 14) readonly buffer InstanceSB
+{
+    uint Data[];
+}
+InstanceBuffer;
+
+uint FetchIndex(DrawData dd, uint i)
+{
+    uint element = dd.IndexOffset + i;
+    if (dd.IndexFormat == INDEX_FORMAT_UINT16)
+    {
+        return (IndexBuffer.Data[element >> 1] >> ((element & 1u) * 16u)) & 0xFFFFu;
+    }
+    return IndexBuffer.Data[element];
+}
+
+vec3 DecodeOctahedral(vec2 e)
+{
+    vec3  n = vec3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x    += (n.x >= 0.0) ? -t : t;
+    n.y    += (n.y >= 0.0) ? -t : t;
+    return normalize(n);
+}
+
+DrawVertex DecodeVertex(DrawData dd, uint verIdx)
+{
+    DrawVertex v;
+    if (dd.VertexFormat == VERTEX_FORMAT_COMPACT)
+    {
+        uint base     = verIdx * 4u;
+        vec2 xy       = unpackUnorm2x16(VertexBuffer.Data[base]);
+        vec2 z        = unpackUnorm2x16(VertexBuffer.Data[base + 1u]);
+        vec3 normal   = DecodeOctahedral(unpackSnorm2x16(VertexBuffer.Data[base + 2u]));
+        vec2 uv       = unpackHalf2x16(VertexBuffer.Data[base + 3u]);
+        vec3 boxMin   = vec3(dd.PositionMin[0], dd.PositionMin[1], dd.PositionMin[2]);
+        vec3 boxSize  = vec3(dd.PositionExtent[0], dd.PositionExtent[1], dd.PositionExtent[2]);
+        vec3 position = boxMin + vec3(xy, z.x) * boxSize;
+
+        v.x           = position.x;
+        v.y           = position.y;
+        v.z           = position.z;
+        v.nx          = normal.x;
+        v.ny          = normal.y;
+        v.nz          = normal.z;
+        v.u           = uv.x;
+        v.v           = uv.y;
+    }
+    else
+    {
+        uint base = verIdx * 8u;
+        v.x       = uintBitsToFloat(VertexBuffer.Data[base]);
+        v.y       = uintBitsToFloat(VertexBuffer.Data[base + 1u]);
+        v.z       = uintBitsToFloat(VertexBuffer.Data[base + 2u]);
+        v.nx      = uintBitsToFloat(VertexBuffer.Data[base + 3u]);
+        v.ny      = uintBitsToFloat(VertexBuffer.Data[base + 4u]);
+        v.nz      = uintBitsToFloat(VertexBuffer.Data[base + 5u]);
+        v.u       = uintBitsToFloat(VertexBuffer.Data[base + 6u]);
+        v.v       = uintBitsToFloat(VertexBuffer.Data[base + 7u]);
+    }
+    return v;
+}
 
 DrawDataView GetDrawDataView()
 {
     DrawDataView dataView;
 
-    DrawData     dd     = DrawDataBuffer.Data[gl_BaseInstance];
-    uint         refIdx = dd.IndexOffset + gl_VertexIndex;
-    uint         verIdx = IndexBuffer.Data[refIdx] + dd.VertexOffset;
-    DrawVertex   v      = VertexBuffer.Data[verIdx];
+    DrawData     dd     = DrawDataBuffer.Data[InstanceBuffer.Data[gl_InstanceIndex]];
+    uint         verIdx = FetchIndex(dd, gl_VertexIndex) + dd.VertexOffset;
+    DrawVertex   v      = DecodeVertex(dd, verIdx);
 
     dataView.Vertex     = vec4(v.x, v.y, v.z, 1.0);
     dataView.Normal     = vec3(v.nx, v.ny, v.nz);
@@ -72,16 +152,15 @@ DrawDataView GetDrawDataView()
 
 DrawData FetchDrawData()
 {
-    return DrawDataBuffer.Data[gl_BaseInstance];
+    return DrawDataBuffer.Data[InstanceBuffer.Data[gl_InstanceIndex]];
 }
 
 DrawVertex FetchVertexData()
 {
     DrawData   dd     = FetchDrawData();
 
-    uint       refIdx = dd.IndexOffset + gl_VertexIndex;
-    uint       verIdx = IndexBuffer.Data[refIdx] + dd.VertexOffset;
-    DrawVertex v      = VertexBuffer.Data[verIdx];
+    uint       verIdx = FetchIndex(dd, gl_VertexIndex) + dd.VertexOffset;
+    DrawVertex v      = DecodeVertex(dd, verIdx);
 
     return v;
 }
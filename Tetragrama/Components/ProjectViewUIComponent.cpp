@@ -26,8 +26,8 @@ namespace Tetragrama::Components
             m_directory_icon = renderer->AsyncLoader->LoadTextureFileSync("Settings/Icons/DirectoryIcon.png");
             m_file_icon      = renderer->AsyncLoader->LoadTextureFileSync("Settings/Icons/FileIcon.png");
 
-            renderer->Device->TextureHandleToUpdates.Enqueue(m_directory_icon);
-            renderer->Device->TextureHandleToUpdates.Enqueue(m_file_icon);
+            renderer->Device->EnqueueTextureUpdate(m_directory_icon);
+            renderer->Device->EnqueueTextureUpdate(m_file_icon);
 
             m_textures_loaded = true;
         }
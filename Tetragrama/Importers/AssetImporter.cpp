@@ -1,42 +1,77 @@
 #include <pch.h>
-#include <Helpers/SerializerCommonHelper.h>
 #include <IAssetImporter.h>
 #include <ZEngine/Helpers/MemoryOperations.h>
+#include <ZEngine/Logging/LoggerDefinition.h>
+#include <ZEngine/Serializers/SceneAssetSerializer.h>
+#include <ZEngine/Serializers/TextureAssetSerializer.h>
 #include <fmt/format.h>
 
 namespace fs = std::filesystem;
 
-using namespace Tetragrama::Helpers;
 using namespace ZEngine::Helpers;
+using namespace ZEngine::Serializers;
+using namespace ZEngine::Rendering::Textures;
 
 namespace Tetragrama::Importers
 {
-    void IAssetImporter::SerializeImporterData(ImporterData& importer_data, const ImportConfiguration& config)
+    namespace
     {
-        importer_data.Name = config.AssetFilename;
-
-        if (!config.OutputMeshFilePath.empty())
+        void ReportWriteError(AssetContainerResult result, std::string_view filename)
         {
-            std::string   fullname_path = fmt::format("{0}/{1}.zemeshes", config.OutputMeshFilePath, config.AssetFilename);
-            std::ofstream out(fullname_path, std::ios::binary | std::ios::trunc);
+            if (result != AssetContainerResult::SUCCESS)
+            {
+                ZENGINE_CORE_ERROR("Failed to write {} : {}", filename, AssetContainer::ToString(result))
+            }
+        }
 
-            if (out.is_open())
+        /*
+         * Returns the cache container of source, encoded only when the cache doesn't hold it already. Empty when source can't be encoded
+         */
+        std::string CompressTexture(const std::string& source, std::string_view directory, TextureUsage usage, const TextureImportOptions& options)
+        {
+            uint64_t     source_hash = 0;
+            DecodedImage image;
+            if (!TextureAssetSerializer::ComputeSourceHash(source, source_hash) || !TextureDecoder::Decode(source, true, image))
             {
-                out.seekp(std::ios::beg);
+                return {};
+            }
 
-                size_t mesh_count = importer_data.Scene.Meshes.size();
-                out.write(reinterpret_cast<const char*>(&mesh_count), sizeof(size_t));
-                out.write(reinterpret_cast<const char*>(importer_data.Scene.Meshes.data()), sizeof(ZEngine::Rendering::Meshes::MeshVNext) * mesh_count);
+            auto        compression = TextureCompressor::SelectOptions(usage, image, options);
+            std::string container   = TextureAssetSerializer::CacheFilename(directory, source_hash, compression.Format);
 
-                size_t indices_count = importer_data.Scene.Indices.size();
-                out.write(reinterpret_cast<const char*>(&indices_count), sizeof(size_t));
-                out.write(reinterpret_cast<const char*>(importer_data.Scene.Indices.data()), sizeof(uint32_t) * indices_count);
+            DecodedImage cached;
+            uint64_t     cached_hash = 0;
+            if ((TextureAssetSerializer::ReadHeader(container, cached, &cached_hash) == TextureAssetLoadResult::SUCCESS) && (cached_hash == source_hash))
+            {
+                return container;
+            }
 
-                size_t vertice_count = importer_data.Scene.Vertices.size();
-                out.write(reinterpret_cast<const char*>(&vertice_count), sizeof(size_t));
-                out.write(reinterpret_cast<const char*>(importer_data.Scene.Vertices.data()), sizeof(float) * vertice_count);
+            DecodedImage compressed;
+            if (!TextureCompressor::Compress(image, compression, compressed))
+            {
+                ZENGINE_CORE_ERROR("Failed to encode texture {}, it is copied as is", source)
+                return {};
+            }
+
+            auto result = TextureAssetSerializer::Write(container, compressed, source_hash);
+            if (result != AssetContainerResult::SUCCESS)
+            {
+                ReportWriteError(result, container);
+                return {};
             }
-            out.close();
+            return container;
+        }
+    } // namespace
+
+    void IAssetImporter::SerializeImporterData(ImporterData& importer_data, const ImportConfiguration& config)
+    {
+        importer_data.Name = config.AssetFilename;
+
+        if (!config.OutputMeshFilePath.empty())
+        {
+            std::string fullname_path = fmt::format("{0}/{1}.zemeshes", config.OutputMeshFilePath, config.AssetFilename);
+
+            ReportWriteError(SceneAssetSerializer::WriteMeshes(importer_data.Scene, fullname_path), fullname_path);
 
             importer_data.SerializedMeshesPath = fullname_path;
         }
@@ -58,8 +93,10 @@ namespace Tetragrama::Importers
                 }
             };
 
-            std::vector<std::string> src_tex_files = {};
-            std::vector<std::string> dst_tex_files = {};
+            std::vector<std::string>  src_tex_files = {};
+            std::vector<std::string>  dst_tex_files = {};
+            std::vector<char*>        tex_paths     = {};
+            std::vector<TextureUsage> tex_usages    = {};
             for (auto& mat_file : importer_data.Scene.MaterialFiles)
             {
                 if (!std::string_view(mat_file.AlbedoTexture).empty())
@@ -72,6 +109,8 @@ namespace Tetragrama::Importers
 
                     src_tex_files.emplace_back(src_file);
                     dst_tex_files.emplace_back(dst_file);
+                    tex_paths.emplace_back(mat_file.AlbedoTexture);
+                    tex_usages.emplace_back(TextureUsage::COLOR);
                 }
 
                 if (!std::string_view(mat_file.EmissiveTexture).empty())
@@ -85,6 +124,8 @@ namespace Tetragrama::Importers
 
                     src_tex_files.emplace_back(src_file);
                     dst_tex_files.emplace_back(dst_file);
+                    tex_paths.emplace_back(mat_file.EmissiveTexture);
+                    tex_usages.emplace_back(TextureUsage::COLOR);
                 }
 
                 if (!std::string_view(mat_file.NormalTexture).empty())
@@ -97,6 +138,8 @@ namespace Tetragrama::Importers
 
                     src_tex_files.emplace_back(src_file);
                     dst_tex_files.emplace_back(dst_file);
+                    tex_paths.emplace_back(mat_file.NormalTexture);
+                    tex_usages.emplace_back(TextureUsage::NORMAL_MAP);
                 }
 
                 if (!std::string_view(mat_file.OpacityTexture).empty())
@@ -110,6 +153,8 @@ namespace Tetragrama::Importers
 
                     src_tex_files.emplace_back(src_file);
                     dst_tex_files.emplace_back(dst_file);
+                    tex_paths.emplace_back(mat_file.OpacityTexture);
+                    tex_usages.emplace_back(TextureUsage::MASK);
                 }
 
                 if (!std::string_view(mat_file.SpecularTexture).empty())
@@ -123,17 +168,30 @@ namespace Tetragrama::Importers
 
                     src_tex_files.emplace_back(src_file);
                     dst_tex_files.emplace_back(dst_file);
+                    tex_paths.emplace_back(mat_file.SpecularTexture);
+                    tex_usages.emplace_back(TextureUsage::COLOR);
                 }
             }
             /*
              * Texture files processing
              *  (1) Ensuring Scene sub-dir is created
-             *  (2) Copying files to destination
+             *  (2) Encoding files to the texture cache, the material points to the container
+             *  (3) Copying files to destination when they can't be encoded
              */
 
             ZENGINE_VALIDATE_ASSERT(src_tex_files.size() == dst_tex_files.size(), "source files count can't be diff of destination files count")
             for (int i = 0; i < src_tex_files.size(); ++i)
             {
+                if (config.TextureCompression.Enabled)
+                {
+                    auto container = CompressTexture(fs::absolute(src_tex_files[i]).string(), dst_dir, tex_usages[i], config.TextureCompression);
+                    if (!container.empty())
+                    {
+                        ZEngine::Helpers::secure_strcpy(tex_paths[i], MAX_FILE_PATH_COUNT, container.c_str());
+                        continue;
+                    }
+                }
+
                 auto          src = fs::absolute(src_tex_files[i]);
                 auto          dst = fs::absolute(dst_tex_files[i]);
 
@@ -153,62 +211,17 @@ namespace Tetragrama::Importers
                 out.close();
             }
 
-            std::string   fullname_path = fmt::format("{0}/{1}.zematerials", config.OutputMaterialsPath, config.AssetFilename);
-            std::ofstream out(fullname_path, std::ios::binary | std::ios::trunc);
-
-            if (out.is_open())
-            {
-                out.seekp(std::ios::beg);
-
-                size_t material_total_count = importer_data.Scene.Materials.size();
-                out.write(reinterpret_cast<const char*>(&material_total_count), sizeof(size_t));
-                out.write(reinterpret_cast<const char*>(importer_data.Scene.Materials.data()), sizeof(ZEngine::Rendering::Meshes::MeshMaterial) * material_total_count);
+            std::string fullname_path = fmt::format("{0}/{1}.zematerials", config.OutputMaterialsPath, config.AssetFilename);
 
-                size_t mat_file_count = importer_data.Scene.MaterialFiles.size();
-                out.write(reinterpret_cast<const char*>(&mat_file_count), sizeof(size_t));
-                for (auto& mat_file : importer_data.Scene.MaterialFiles)
-                {
-                    Tetragrama::Helpers::SerializeStringData(out, mat_file.AlbedoTexture);
-                    Tetragrama::Helpers::SerializeStringData(out, mat_file.EmissiveTexture);
-                    Tetragrama::Helpers::SerializeStringData(out, mat_file.NormalTexture);
-                    Tetragrama::Helpers::SerializeStringData(out, mat_file.OpacityTexture);
-                    Tetragrama::Helpers::SerializeStringData(out, mat_file.SpecularTexture);
-                }
-            }
-            out.close();
+            ReportWriteError(SceneAssetSerializer::WriteMaterials(importer_data.Scene, fullname_path), fullname_path);
 
             importer_data.SerializedMaterialsPath = fullname_path;
         }
 
         if (!config.OutputModelFilePath.empty())
         {
-            std::string   fullname_path = fmt::format("{0}/{1}.zemodel", config.OutputModelFilePath, config.AssetFilename);
-            std::ofstream out(fullname_path, std::ios::binary | std::ios::trunc);
-
-            if (out.is_open())
-            {
-                out.seekp(std::ios::beg);
-
-                size_t local_transform_count = importer_data.Scene.LocalTransforms.size();
-                out.write(reinterpret_cast<const char*>(&local_transform_count), sizeof(size_t));
-                out.write(reinterpret_cast<const char*>(importer_data.Scene.LocalTransforms.data()), sizeof(glm::mat4) * local_transform_count);
-
-                size_t gobal_transform_count = importer_data.Scene.GlobalTransforms.size();
-                out.write(reinterpret_cast<const char*>(&gobal_transform_count), sizeof(size_t));
-                out.write(reinterpret_cast<const char*>(importer_data.Scene.GlobalTransforms.data()), sizeof(glm::mat4) * gobal_transform_count);
-
-                size_t node_hierarchy_count = importer_data.Scene.NodeHierarchies.size();
-                out.write(reinterpret_cast<const char*>(&node_hierarchy_count), sizeof(size_t));
-                out.write(reinterpret_cast<const char*>(importer_data.Scene.NodeHierarchies.data()), sizeof(ZEngine::Rendering::Scenes::SceneNodeHierarchy) * node_hierarchy_count);
-
-                Tetragrama::Helpers::SerializeStringArrayData(out, importer_data.Scene.Names);
-                Tetragrama::Helpers::SerializeStringArrayData(out, importer_data.Scene.MaterialNames);
-                Tetragrama::Helpers::SerializeMapData(out, importer_data.Scene.NodeNames);
-                Tetragrama::Helpers::SerializeMapData(out, importer_data.Scene.NodeMeshes);
-                Tetragrama::Helpers::SerializeMapData(out, importer_data.Scene.NodeMaterials);
-            }
-
-            out.close();
+            std::string fullname_path = fmt::format("{0}/{1}.zemodel", config.OutputModelFilePath, config.AssetFilename);
+            ReportWriteError(SceneAssetSerializer::WriteModel(importer_data.Scene, fullname_path), fullname_path);
 
             importer_data.SerializedModelPath = fullname_path;
         }
@@ -218,97 +231,11 @@ namespace Tetragrama::Importers
     {
         ImporterData deserialized_data = {};
 
-        if (!mesh_path.empty())
-        {
-            std::ifstream in(mesh_path.data(), std::ios::binary);
-
-            if (in.is_open())
-            {
-                in.seekg(0, std::ios::beg);
-
-                size_t mesh_count;
-                in.read(reinterpret_cast<char*>(&mesh_count), sizeof(size_t));
-                deserialized_data.Scene.Meshes.resize(mesh_count);
-                in.read(reinterpret_cast<char*>(deserialized_data.Scene.Meshes.data()), sizeof(ZEngine::Rendering::Meshes::MeshVNext) * mesh_count);
-
-                size_t indices_count;
-                in.read(reinterpret_cast<char*>(&indices_count), sizeof(size_t));
-                deserialized_data.Scene.Indices.resize(indices_count);
-                in.read(reinterpret_cast<char*>(deserialized_data.Scene.Indices.data()), sizeof(uint32_t) * indices_count);
-
-                size_t vertice_count;
-                in.read(reinterpret_cast<char*>(&vertice_count), sizeof(size_t));
-                deserialized_data.Scene.Vertices.resize(vertice_count);
-                in.read(reinterpret_cast<char*>(deserialized_data.Scene.Vertices.data()), sizeof(float) * vertice_count);
-            }
-            in.close();
-        }
-
-        if (!material_path.empty())
+        SceneAssetFiles files = {.ModelPath = std::string(model_path), .MeshPath = std::string(mesh_path), .MaterialPath = std::string(material_path)};
+        auto            load  = SceneAssetSerializer::LoadScene(files, deserialized_data.Scene);
+        if (load.Result != AssetContainerResult::SUCCESS)
         {
-            std::ifstream in(material_path.data(), std::ios::binary);
-
-            if (in.is_open())
-            {
-                in.seekg(0, std::ios::beg);
-
-                size_t material_total_count;
-                in.read(reinterpret_cast<char*>(&material_total_count), sizeof(size_t));
-                deserialized_data.Scene.Materials.resize(material_total_count);
-                in.read(reinterpret_cast<char*>(deserialized_data.Scene.Materials.data()), sizeof(ZEngine::Rendering::Meshes::MeshMaterial) * material_total_count);
-
-                size_t mat_file_count;
-                in.read(reinterpret_cast<char*>(&mat_file_count), sizeof(size_t));
-                deserialized_data.Scene.MaterialFiles.resize(mat_file_count);
-
-                std::string textures[5] = {""};
-                for (auto& mat_file : deserialized_data.Scene.MaterialFiles)
-                {
-                    Tetragrama::Helpers::DeserializeStringData(in, textures[0]);
-                    Tetragrama::Helpers::DeserializeStringData(in, textures[1]);
-                    Tetragrama::Helpers::DeserializeStringData(in, textures[2]);
-                    Tetragrama::Helpers::DeserializeStringData(in, textures[3]);
-                    Tetragrama::Helpers::DeserializeStringData(in, textures[4]);
-
-                    ZEngine::Helpers::secure_strcpy(mat_file.AlbedoTexture, MAX_FILE_PATH_COUNT, textures[0].c_str());
-                    ZEngine::Helpers::secure_strcpy(mat_file.EmissiveTexture, MAX_FILE_PATH_COUNT, textures[1].c_str());
-                    ZEngine::Helpers::secure_strcpy(mat_file.NormalTexture, MAX_FILE_PATH_COUNT, textures[2].c_str());
-                    ZEngine::Helpers::secure_strcpy(mat_file.OpacityTexture, MAX_FILE_PATH_COUNT, textures[3].c_str());
-                    ZEngine::Helpers::secure_strcpy(mat_file.SpecularTexture, MAX_FILE_PATH_COUNT, textures[4].c_str());
-                }
-            }
-            in.close();
-        }
-
-        if (!model_path.empty())
-        {
-            std::ifstream in(model_path.data(), std::ios::binary);
-            if (in.is_open())
-            {
-                in.seekg(0, std::ios::beg);
-
-                size_t local_transform_count;
-                in.read(reinterpret_cast<char*>(&local_transform_count), sizeof(size_t));
-                deserialized_data.Scene.LocalTransforms.resize(local_transform_count);
-                in.read(reinterpret_cast<char*>(deserialized_data.Scene.LocalTransforms.data()), sizeof(glm::mat4) * local_transform_count);
-
-                size_t gobal_transform_count;
-                in.read(reinterpret_cast<char*>(&gobal_transform_count), sizeof(size_t));
-                deserialized_data.Scene.GlobalTransforms.resize(gobal_transform_count);
-                in.read(reinterpret_cast<char*>(deserialized_data.Scene.GlobalTransforms.data()), sizeof(glm::mat4) * gobal_transform_count);
-
-                size_t node_hierarchy_count;
-                in.read(reinterpret_cast<char*>(&node_hierarchy_count), sizeof(size_t));
-                deserialized_data.Scene.NodeHierarchies.resize(node_hierarchy_count);
-                in.read(reinterpret_cast<char*>(deserialized_data.Scene.NodeHierarchies.data()), sizeof(ZEngine::Rendering::Scenes::SceneNodeHierarchy) * node_hierarchy_count);
-
-                DeserializeStringArrayData(in, deserialized_data.Scene.Names);
-                DeserializeStringArrayData(in, deserialized_data.Scene.MaterialNames);
-                DeserializeMapData(in, deserialized_data.Scene.NodeNames);
-                DeserializeMapData(in, deserialized_data.Scene.NodeMeshes);
-                DeserializeMapData(in, deserialized_data.Scene.NodeMaterials);
-            }
-            in.close();
+            ZENGINE_CORE_ERROR("Failed to read {} : {}, the asset may need to be imported again", load.Filename, AssetContainer::ToString(load.Result))
         }
 
         return deserialized_data;
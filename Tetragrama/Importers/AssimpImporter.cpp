@@ -2,6 +2,7 @@
 #include <AssimpImporter.h>
 #include <Core/Coroutine.h>
 #include <Helpers/MemoryOperations.h>
+#include <Helpers/MeshHelper.h>
 #include <Helpers/ThreadPool.h>
 #include <assimp/postprocess.h>
 #include <fmt/format.h>
@@ -44,6 +45,9 @@ namespace Tetragrama::Importers
                 ImporterData import_data = {};
 
                 ExtractMeshes(scene, import_data);
+                OptimizeMeshes(import_data, config.MeshOptimization);
+                GenerateMeshLods(import_data, config.MeshLods);
+                GenerateMeshlets(import_data, config.Meshlets);
                 ExtractMaterials(scene, import_data);
                 ExtractTextures(scene, import_data);
                 CreateHierachyScene(scene, import_data);
@@ -78,68 +82,67 @@ namespace Tetragrama::Importers
             return;
         }
 
-        uint32_t number_of_meshes = scene->mNumMeshes;
-        importer_data.Scene.Meshes.reserve(number_of_meshes);
+        REPORT_LOG(Context, fmt::format("Extracting {0} meshes", scene->mNumMeshes).c_str())
 
-        for (uint32_t m = 0; m < number_of_meshes; ++m)
-        {
-
-            REPORT_LOG(Context, fmt::format("Extrating Meshes : {0}/{1} ", (m + 1), number_of_meshes).c_str())
+        auto& raw_data = importer_data.Scene;
+        ExtractAssimpMeshes(scene, raw_data.Vertices, raw_data.Indices, raw_data.Meshes, importer_data.VertexOffset, importer_data.IndexOffset);
+    }
 
-            aiMesh*  ai_mesh = scene->mMeshes[m];
+    void AssimpImporter::OptimizeMeshes(ImporterData& importer_data, const MeshOptimizationOptions& options)
+    {
+        auto& raw_data = importer_data.Scene;
+        if ((!options.Enabled) || raw_data.Meshes.empty())
+        {
+            return;
+        }
 
-            uint32_t vertex_count{0};
+        REPORT_LOG(Context, "Optimizing meshes...")
 
-            /* Vertice processing */
-            for (int v = 0; v < ai_mesh->mNumVertices; ++v)
-            {
-                const aiVector3D position = ai_mesh->mVertices[v];
-                const aiVector3D normal   = ai_mesh->mNormals[v];
-                const aiVector3D texture  = ai_mesh->HasTextureCoords(0) ? ai_mesh->mTextureCoords[0][v] : aiVector3D{};
+        auto statistics = MeshOptimizer::OptimizeMeshes(raw_data.Vertices, 8, raw_data.Indices, raw_data.Meshes, options);
+        REPORT_LOG(
+            Context,
+            fmt::format("Mesh optimization : ACMR {0:.3f} -> {1:.3f}, ATVR {2:.3f} -> {3:.3f}", statistics.Before.ACMR, statistics.After.ACMR, statistics.Before.ATVR, statistics.After.ATVR).c_str())
+    }
 
-                importer_data.Scene.Vertices.push_back(position.x);
-                importer_data.Scene.Vertices.push_back(position.y);
-                importer_data.Scene.Vertices.push_back(position.z);
+    void AssimpImporter::GenerateMeshLods(ImporterData& importer_data, const MeshLodOptions& options)
+    {
+        auto& raw_data = importer_data.Scene;
+        if ((!options.Enabled) || raw_data.Meshes.empty())
+        {
+            return;
+        }
 
-                importer_data.Scene.Vertices.push_back(normal.x);
-                importer_data.Scene.Vertices.push_back(normal.y);
-                importer_data.Scene.Vertices.push_back(normal.z);
+        REPORT_LOG(Context, "Generating mesh LODs...")
 
-                importer_data.Scene.Vertices.push_back(texture.x);
-                importer_data.Scene.Vertices.push_back(texture.y);
+        size_t base_index_count = raw_data.Indices.size();
+        MeshSimplifier::GenerateMeshLods(raw_data.Vertices, 8, raw_data.Indices, raw_data.Meshes, raw_data.MeshLods, options);
+        importer_data.IndexOffset = (uint32_t) raw_data.Indices.size();
 
-                vertex_count++;
-            }
+        uint32_t lod_count = 0;
+        for (const auto& chain : raw_data.MeshLods)
+        {
+            lod_count += chain.LodCount;
+        }
+        REPORT_LOG(Context, fmt::format("Mesh LODs : {0} levels over {1} meshes, {2} indices added", lod_count, raw_data.Meshes.size(), raw_data.Indices.size() - base_index_count).c_str())
+    }
 
-            /* Face and Indices processing */
-            uint32_t index_count{0};
-            for (int f = 0; f < ai_mesh->mNumFaces; ++f)
-            {
-                aiFace ai_face = ai_mesh->mFaces[f];
+    void AssimpImporter::GenerateMeshlets(ImporterData& importer_data, const MeshletOptions& options)
+    {
+        auto& raw_data = importer_data.Scene;
+        if ((!options.Enabled) || raw_data.Meshes.empty())
+        {
+            return;
+        }
 
-                for (int fidx = 0; fidx < ai_face.mNumIndices; ++fidx)
-                {
-                    importer_data.Scene.Indices.push_back(ai_face.mIndices[fidx]);
+        REPORT_LOG(Context, "Generating meshlets...")
 
-                    index_count++;
-                }
-            }
+        MeshletData meshlets = {};
+        MeshletBuilder::GenerateMeshMeshlets(raw_data.Vertices, 8, raw_data.Indices, raw_data.Meshes, meshlets, raw_data.MeshletRanges, options);
+        raw_data.Meshlets         = std::move(meshlets.Meshlets);
+        raw_data.MeshletVertices  = std::move(meshlets.Vertices);
+        raw_data.MeshletTriangles = std::move(meshlets.Triangles);
 
-            MeshVNext& mesh             = importer_data.Scene.Meshes.emplace_back();
-            mesh.VertexCount            = vertex_count;
-            mesh.VertexOffset           = importer_data.VertexOffset;
-            mesh.VertexUnitStreamSize   = sizeof(float) * (3 + 3 + 2) /*pos-cmp + normal-cmp + tex-cmp*/;
-            mesh.StreamOffset           = (mesh.VertexUnitStreamSize * mesh.VertexOffset);
-            mesh.IndexOffset            = importer_data.IndexOffset;
-            mesh.IndexCount             = index_count;
-            mesh.IndexUnitStreamSize    = sizeof(uint32_t);
-            mesh.IndexStreamOffset      = (mesh.IndexUnitStreamSize * mesh.IndexOffset);
-            mesh.TotalByteSize          = (mesh.VertexCount * mesh.VertexUnitStreamSize) + (mesh.IndexCount * mesh.IndexUnitStreamSize);
-
-            /* Computing offset data */
-            importer_data.VertexOffset += ai_mesh->mNumVertices;
-            importer_data.IndexOffset  += index_count;
-        }
+        REPORT_LOG(Context, fmt::format("Meshlets : {0} clusters over {1} meshes", raw_data.Meshlets.size(), raw_data.Meshes.size()).c_str())
     }
 
     void AssimpImporter::ExtractMaterials(const aiScene* scene, ImporterData& importer_data)
@@ -33,6 +33,9 @@ namespace Tetragrama::Importers
         friend struct AssimpProgressHandler;
 
         void      ExtractMeshes(const aiScene*, ImporterData&);
+        void      OptimizeMeshes(ImporterData&, const ZEngine::Rendering::Meshes::MeshOptimizationOptions&);
+        void      GenerateMeshLods(ImporterData&, const ZEngine::Rendering::Meshes::MeshLodOptions&);
+        void      GenerateMeshlets(ImporterData&, const ZEngine::Rendering::Meshes::MeshletOptions&);
         void      ExtractMaterials(const aiScene*, ImporterData&);
         void      ExtractTextures(const aiScene*, ImporterData&);
         void      CreateHierachyScene(const aiScene*, ImporterData&);
@@ -1,7 +1,11 @@
 #pragma once
 #include <Helpers/IntrusivePtr.h>
 #include <Rendering/Meshes/Mesh.h>
+#include <Rendering/Meshes/MeshOptimizer.h>
+#include <Rendering/Meshes/MeshSimplifier.h>
+#include <Rendering/Meshes/MeshletBuilder.h>
 #include <Rendering/Scenes/GraphicScene.h>
+#include <Rendering/Textures/TextureCompressor.h>
 #include <atomic>
 #include <future>
 #include <mutex>
@@ -31,12 +35,19 @@ namespace Tetragrama::Importers
 
     struct ImportConfiguration
     {
-        std::string AssetFilename;
-        std::string InputBaseAssetFilePath;
-        std::string OutputModelFilePath;
-        std::string OutputMeshFilePath;
-        std::string OutputTextureFilesPath;
-        std::string OutputMaterialsPath;
+        std::string                                         AssetFilename;
+        std::string                                         InputBaseAssetFilePath;
+        std::string                                         OutputModelFilePath;
+        std::string                                         OutputMeshFilePath;
+        std::string                                         OutputTextureFilesPath;
+        std::string                                         OutputMaterialsPath;
+        ZEngine::Rendering::Meshes::MeshOptimizationOptions MeshOptimization   = {};
+        ZEngine::Rendering::Meshes::MeshLodOptions          MeshLods           = {};
+        ZEngine::Rendering::Meshes::MeshletOptions          Meshlets           = {};
+        /*
+         * Material textures are encoded into block compressed .zetexture containers, copied verbatim when disabled
+         */
+        ZEngine::Rendering::Textures::TextureImportOptions  TextureCompression = {};
     };
 
     struct IAssetImporter : public ZEngine::Helpers::RefCounted
@@ -3,11 +3,13 @@
 #include <Helpers/ThreadPool.h>
 #include <Importers/IAssetImporter.h>
 #include <Serializers/EditorSceneSerializer.h>
+#include <ZEngine/Serializers/SceneAssetSerializer.h>
 #include <fmt/format.h>
 
 using namespace ZEngine::Helpers;
 using namespace Tetragrama::Helpers;
 using namespace Tetragrama::Importers;
+using namespace ZEngine::Serializers;
 
 namespace Tetragrama::Serializers
 {
@@ -161,29 +163,51 @@ namespace Tetragrama::Serializers
                 scene.Data[hash] = {.MeshFileIndex = indices[0], .ModelPathIndex = indices[1], .MaterialPathIndex = indices[2]};
             }
 
-            REPORT_PROGRESS(Context, 1.f)
-
             in_stream.close();
 
-            auto                                                  ctx    = reinterpret_cast<EditorContext*>(Context);
-            const auto&                                           config = *ctx->ConfigurationPtr;
+            auto        ctx    = reinterpret_cast<EditorContext*>(Context);
+            const auto& config = *ctx->ConfigurationPtr;
 
-            std::vector<ZEngine::Rendering::Scenes::SceneRawData> scene_data;
+            std::vector<SceneAssetFiles> model_files;
+            model_files.reserve(scene.Data.size());
             for (auto& [_, model] : scene.Data)
             {
-                auto mesh_path     = fmt::format("{0}/{1}", config.WorkingSpacePath, scene.MeshFiles[model.MeshFileIndex]);
-                auto model_path    = fmt::format("{0}/{1}", config.WorkingSpacePath, scene.ModelFiles[model.ModelPathIndex]);
-                auto material_path = fmt::format("{0}/{1}", config.WorkingSpacePath, scene.MaterialFiles[model.MaterialPathIndex]);
+                auto& files        = model_files.emplace_back();
+                files.MeshPath     = fmt::format("{0}/{1}", config.WorkingSpacePath, scene.MeshFiles[model.MeshFileIndex]);
+                files.ModelPath    = fmt::format("{0}/{1}", config.WorkingSpacePath, scene.ModelFiles[model.ModelPathIndex]);
+                files.MaterialPath = fmt::format("{0}/{1}", config.WorkingSpacePath, scene.MaterialFiles[model.MaterialPathIndex]);
 
 #ifdef _WIN32
-                std::replace(model_path.begin(), model_path.end(), '/', '\\');
-                std::replace(mesh_path.begin(), mesh_path.end(), '/', '\\');
-                std::replace(material_path.begin(), material_path.end(), '/', '\\');
+                std::replace(files.ModelPath.begin(), files.ModelPath.end(), '/', '\\');
+                std::replace(files.MeshPath.begin(), files.MeshPath.end(), '/', '\\');
+                std::replace(files.MaterialPath.begin(), files.MaterialPath.end(), '/', '\\');
 #endif // _WIN32
+            }
 
-                auto import_data = IAssetImporter::DeserializeImporterData(model_path, mesh_path, material_path);
-                scene_data.push_back(import_data.Scene);
+            /*
+             * Models are decoded concurrently, scene_data keeps the order of model_files so the merged scene doesn't depend on
+             * which load finishes first
+             */
+            std::vector<ZEngine::Rendering::Scenes::SceneRawData> scene_data;
+            auto                                                  load = SceneAssetSerializer::LoadScenes(model_files, scene_data, SceneAssetSerializer::DefaultLoadConcurrency, [this](size_t loaded_count, size_t total_count) {
+                REPORT_PROGRESS(Context, 0.75f + 0.25f * (float(loaded_count) / float(total_count)))
+            });
+
+            if (load.Result != AssetContainerResult::SUCCESS)
+            {
+                {
+                    std::unique_lock l(m_mutex);
+                    m_is_deserializing = false;
+                }
+
+                if (m_error_callback)
+                {
+                    auto message = fmt::format("Error: Unable to load {0} ({1}), the asset may need to be imported again.", load.Filename, AssetContainer::ToString(load.Result));
+                    m_error_callback(Context, message);
+                }
+                return;
             }
+            REPORT_PROGRESS(Context, 1.f)
 
             scene.RenderScene->SceneData->Vertices.clear();
             scene.RenderScene->SceneData->Indices.clear();
@@ -42,16 +42,19 @@ namespace ZENGINE_COROUTINE_NAMESPACE
             void return_value(U&& u)
             {
                 m_promise.set_value(std::forward<U>(u));
+                ZEngine::Core::CoroutineScheduler::NotifyCompletion();
             }
 
             void set_exception(std::exception_ptr e)
             {
                 m_promise.set_exception(std::move(e));
+                ZEngine::Core::CoroutineScheduler::NotifyCompletion();
             }
 
             void unhandled_exception()
             {
                 m_promise.set_exception(std::current_exception());
+                ZEngine::Core::CoroutineScheduler::NotifyCompletion();
             }
         };
     };
@@ -81,16 +84,19 @@ namespace ZENGINE_COROUTINE_NAMESPACE
             void return_void()
             {
                 m_promise.set_value();
+                ZEngine::Core::CoroutineScheduler::NotifyCompletion();
             }
 
             void set_exception(std::exception_ptr e)
             {
                 m_promise.set_exception(std::move(e));
+                ZEngine::Core::CoroutineScheduler::NotifyCompletion();
             }
 
             void unhandled_exception()
             {
                 m_promise.set_exception(std::current_exception());
+                ZEngine::Core::CoroutineScheduler::NotifyCompletion();
             }
         };
     };
@@ -1,51 +1,197 @@
 #include <Core/CoroutineScheduler.h>
 #include <Helpers/ThreadPool.h>
-#include <thread>
+#include <algorithm>
 
 using namespace ZEngine::Helpers;
 
 namespace ZEngine::Core
 {
-    std::atomic_bool                                 CoroutineScheduler::s_running      = false;
-    Helpers::Ref<CoroutineScheduler::SchedulerQueue> CoroutineScheduler::s_action_queue = Helpers::CreateRef<CoroutineScheduler::SchedulerQueue>();
+    using Clock = std::chrono::steady_clock;
 
-    void                                             CoroutineScheduler::Schedule(CoroutineAction&& action)
+    std::mutex                   CoroutineScheduler::s_mutex              = {};
+    std::condition_variable      CoroutineScheduler::s_condition          = {};
+    std::thread                  CoroutineScheduler::s_thread             = {};
+    bool                         CoroutineScheduler::s_running            = false;
+    bool                         CoroutineScheduler::s_stopping           = false;
+    uint64_t                     CoroutineScheduler::s_completion_epoch   = 0;
+    std::vector<CoroutineAction> CoroutineScheduler::s_incoming_actions   = {};
+    CoroutineSchedulerStatistics CoroutineScheduler::s_statistics         = {};
+
+    static std::atomic_size_t    s_pending_action_count                   = 0;
+    static Clock::time_point     s_last_completion_time                   = {};
+
+    /*
+     * Joins the scheduler thread during static destruction, a joinable std::thread must not outlive main()
+     */
+    static struct CoroutineSchedulerGuard
+    {
+        ~CoroutineSchedulerGuard()
+        {
+            CoroutineScheduler::Shutdown();
+        }
+    } s_scheduler_guard;
+
+    void CoroutineScheduler::Schedule(CoroutineAction&& action)
     {
         if (!action)
         {
             return;
         }
 
-        s_action_queue->Emplace(std::move(action));
-        if (!s_running.exchange(true))
+        action.ScheduledAt = Clock::now();
+        s_pending_action_count.fetch_add(1);
+        {
+            std::lock_guard l(s_mutex);
+            s_incoming_actions.emplace_back(std::move(action));
+            s_statistics.ScheduledCount++;
+            s_statistics.QueueDepth++;
+
+            if (!s_running)
+            {
+                Start();
+            }
+        }
+        s_condition.notify_one();
+    }
+
+    void CoroutineScheduler::NotifyCompletion()
+    {
+        /*
+         * Nothing is parked : a continuation scheduled afterwards is evaluated as soon as it reaches the scheduler thread
+         */
+        if (s_pending_action_count.load() == 0)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard l(s_mutex);
+            s_completion_epoch++;
+            s_last_completion_time = Clock::now();
+        }
+        s_condition.notify_one();
+    }
+
+    void CoroutineScheduler::Shutdown()
+    {
+        {
+            std::lock_guard l(s_mutex);
+            if (!s_running)
+            {
+                return;
+            }
+            s_stopping = true;
+        }
+        s_condition.notify_one();
+
+        if (s_thread.joinable())
         {
-            CoroutineScheduler::Start();
+            s_thread.join();
         }
+        ThreadPool::SetCompletionObserver(nullptr);
+
+        std::lock_guard l(s_mutex);
+        s_incoming_actions.clear();
+        s_pending_action_count  = 0;
+        s_statistics.QueueDepth = 0;
+        s_running               = false;
+        s_stopping              = false;
+    }
+
+    CoroutineSchedulerStatistics CoroutineScheduler::GetStatistics()
+    {
+        std::lock_guard l(s_mutex);
+        return s_statistics;
+    }
+
+    void CoroutineScheduler::ResetStatistics()
+    {
+        std::lock_guard l(s_mutex);
+        s_statistics = {.QueueDepth = s_pending_action_count.load()};
     }
 
     void CoroutineScheduler::Start()
     {
-        std::thread(Run, s_action_queue.Weak()).detach();
+        s_running = true;
+        s_thread  = std::thread(Run);
+        ThreadPool::SetCompletionObserver(NotifyCompletion);
     }
 
-    void CoroutineScheduler::Run(Helpers::WeakRef<SchedulerQueue> queue_ref)
+    void CoroutineScheduler::Run()
     {
-        while (auto queue = queue_ref.lock())
+        std::vector<CoroutineAction> parked_actions   = {};
+        std::vector<CoroutineAction> incoming_actions = {};
+        std::vector<CoroutineAction> ready_actions    = {};
+        uint64_t                     observed_epoch   = 0;
+        Clock::time_point            completion_time  = {};
+
+        auto                         take_ready       = [&ready_actions](std::vector<CoroutineAction>& actions) {
+            auto split = std::partition(actions.begin(), actions.end(), [](CoroutineAction& action) { return !action.Ready(); });
+            std::move(split, actions.end(), std::back_inserter(ready_actions));
+            actions.erase(split, actions.end());
+        };
+
+        while (true)
         {
-            CoroutineAction co_action;
+            bool completed = false;
+            {
+                /*
+                 * No timeout : only a new continuation or a completion wakes the thread up
+                 */
+                std::unique_lock l(s_mutex);
+                s_condition.wait(l, [&observed_epoch] { return s_stopping || !s_incoming_actions.empty() || (s_completion_epoch != observed_epoch); });
+
+                if (s_stopping)
+                {
+                    break;
+                }
+
+                s_statistics.WakeupCount++;
+                completed       = (s_completion_epoch != observed_epoch);
+                observed_epoch  = s_completion_epoch;
+                completion_time = s_last_completion_time;
+                std::swap(incoming_actions, s_incoming_actions);
+            }
 
-            if (!queue->Pop(co_action))
+            /*
+             * New continuations are checked once, the parked ones only when something completed since their last check
+             */
+            uint64_t readiness_checks = incoming_actions.size() + (completed ? parked_actions.size() : 0);
+            if (completed)
             {
-                continue;
+                take_ready(parked_actions);
             }
+            take_ready(incoming_actions);
+            std::move(incoming_actions.begin(), incoming_actions.end(), std::back_inserter(parked_actions));
+            incoming_actions.clear();
 
-            if (co_action && !co_action.Ready())
+            auto     now           = Clock::now();
+            uint64_t total_latency = 0;
+            uint64_t max_latency   = 0;
+            for (auto& action : ready_actions)
             {
-                queue->Emplace(std::move(co_action));
-                continue;
+                auto    origin  = std::max(action.ScheduledAt, completion_time);
+                int64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - origin).count();
+                latency         = std::max<int64_t>(latency, 0);
+                total_latency  += latency;
+                max_latency     = std::max<uint64_t>(max_latency, latency);
             }
 
-            ThreadPoolHelper::Submit(co_action.Action);
+            s_pending_action_count.fetch_sub(ready_actions.size());
+            {
+                std::lock_guard l(s_mutex);
+                s_statistics.ReadinessCheckCount  += readiness_checks;
+                s_statistics.ResumedCount         += ready_actions.size();
+                s_statistics.TotalResumeLatencyNs += total_latency;
+                s_statistics.MaxResumeLatencyNs    = std::max(s_statistics.MaxResumeLatencyNs, max_latency);
+                s_statistics.QueueDepth            = parked_actions.size() + s_incoming_actions.size();
+            }
+
+            for (auto& action : ready_actions)
+            {
+                ThreadPoolHelper::Post(std::move(action.Action), TaskPriority::High);
+            }
+            ready_actions.clear();
         }
     }
 } // namespace ZEngine::Core
@@ -1,19 +1,23 @@
 #pragma once
 #include <Helpers/IntrusivePtr.h>
-#include <Helpers/ThreadSafeQueue.h>
-#include <ZEngineDef.h>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace ZEngine::Core
 {
     struct CoroutineAction : public Helpers::RefCounted
     {
-        using ReadyCallback    = std::function<bool(void)>;
-        using ExecuteCallback  = std::function<void(void)>;
+        using ReadyCallback                               = std::function<bool(void)>;
+        using ExecuteCallback                             = std::function<void(void)>;
 
-        ReadyCallback   Ready  = nullptr;
-        ExecuteCallback Action = nullptr;
+        ReadyCallback                         Ready       = nullptr;
+        ExecuteCallback                       Action      = nullptr;
+        std::chrono::steady_clock::time_point ScheduledAt = {};
 
         operator bool() noexcept
         {
@@ -21,18 +25,50 @@ namespace ZEngine::Core
         }
     };
 
-    struct CoroutineScheduler
+    struct CoroutineSchedulerStatistics
     {
-        using SchedulerQueue = Helpers::ThreadSafeQueue<CoroutineAction>;
+        uint64_t QueueDepth           = 0;
+        uint64_t ScheduledCount       = 0;
+        uint64_t ResumedCount         = 0;
+        uint64_t WakeupCount          = 0;
+        uint64_t ReadinessCheckCount  = 0;
+        uint64_t TotalResumeLatencyNs = 0;
+        uint64_t MaxResumeLatencyNs   = 0;
 
-        static void Schedule(CoroutineAction&& action);
+        double   AverageResumeLatencyNs() const
+        {
+            return ResumedCount ? (double(TotalResumeLatencyNs) / double(ResumedCount)) : 0.0;
+        }
+    };
+
+    /*
+     * Continuation scheduler for coroutines awaiting a std::future.
+     * A suspended coroutine registers its continuation here, it is checked once when it arrives and then parked. Completion sources
+     * call NotifyCompletion() when they set a future : every coroutine promise, and every ThreadPool task submitted with a result.
+     * Only then does the scheduler thread re-evaluate the parked continuations, and resume the ready ones on the ThreadPool.
+     * The thread never wakes up on a timer : a future set by any other producer (a raw std::promise, std::async) needs that
+     * producer to call NotifyCompletion() itself.
+     */
+    struct CoroutineScheduler
+    {
+        static void                         Schedule(CoroutineAction&& action);
+        static void                         NotifyCompletion();
+        static void                         Shutdown();
+        static CoroutineSchedulerStatistics GetStatistics();
+        static void                         ResetStatistics();
 
     private:
-        static std::atomic_bool                                        s_running;
-        static Helpers::Ref<Helpers::ThreadSafeQueue<CoroutineAction>> s_action_queue;
+        static std::mutex                   s_mutex;
+        static std::condition_variable      s_condition;
+        static std::thread                  s_thread;
+        static bool                         s_running;
+        static bool                         s_stopping;
+        static uint64_t                     s_completion_epoch;
+        static std::vector<CoroutineAction> s_incoming_actions;
+        static CoroutineSchedulerStatistics s_statistics;
 
-        static void                                                    Start();
-        static void                                                    Run(Helpers::WeakRef<SchedulerQueue> queue);
+        static void                         Start();
+        static void                         Run();
     };
 
 } // namespace ZEngine::Core
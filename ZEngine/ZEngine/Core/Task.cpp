@@ -0,0 +1,111 @@
+#include <pch.h>
+#include <Core/Task.h>
+
+namespace ZEngine::Core
+{
+    /*
+     * Every frame is prefixed with the allocator that produced it, the header size keeps the default new alignment.
+     */
+    static constexpr size_t FrameHeaderByteSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    static_assert(FrameHeaderByteSize >= sizeof(ITaskFrameAllocator*));
+
+    static DefaultTaskFrameAllocator         s_default_frame_allocator = {};
+    static std::atomic<ITaskFrameAllocator*> s_frame_allocator         = &s_default_frame_allocator;
+
+    void*                                    DefaultTaskFrameAllocator::Allocate(size_t byte_size)
+    {
+        return ::operator new(byte_size);
+    }
+
+    void DefaultTaskFrameAllocator::Deallocate(void* ptr, size_t byte_size)
+    {
+        ::operator delete(ptr, byte_size);
+    }
+
+    struct FrameFreeLists
+    {
+        static constexpr size_t SizeClassCount = PooledTaskFrameAllocator::MaxPooledByteSize / PooledTaskFrameAllocator::SizeClassGranularity;
+
+        struct FreeBlock
+        {
+            FreeBlock* Next = nullptr;
+        };
+
+        FreeBlock* Heads[SizeClassCount] = {};
+
+        ~FrameFreeLists()
+        {
+            for (size_t i = 0; i < SizeClassCount; ++i)
+            {
+                while (Heads[i])
+                {
+                    FreeBlock* block = Heads[i];
+                    Heads[i]         = block->Next;
+                    ::operator delete(block, (i + 1) * PooledTaskFrameAllocator::SizeClassGranularity);
+                }
+            }
+        }
+    };
+
+    static thread_local FrameFreeLists s_frame_free_lists = {};
+
+    void*                              PooledTaskFrameAllocator::Allocate(size_t byte_size)
+    {
+        if (byte_size > MaxPooledByteSize)
+        {
+            return ::operator new(byte_size);
+        }
+
+        size_t size_class = (byte_size + SizeClassGranularity - 1) / SizeClassGranularity - 1;
+        auto&  head       = s_frame_free_lists.Heads[size_class];
+        if (head)
+        {
+            auto block = head;
+            head       = block->Next;
+            return block;
+        }
+        return ::operator new((size_class + 1) * SizeClassGranularity);
+    }
+
+    void PooledTaskFrameAllocator::Deallocate(void* ptr, size_t byte_size)
+    {
+        if (byte_size > MaxPooledByteSize)
+        {
+            ::operator delete(ptr, byte_size);
+            return;
+        }
+
+        /*
+         * A frame released on another thread than the one that created it simply migrates to the releasing thread's free list
+         */
+        size_t size_class                    = (byte_size + SizeClassGranularity - 1) / SizeClassGranularity - 1;
+        auto   block                         = static_cast<FrameFreeLists::FreeBlock*>(ptr);
+        block->Next                          = s_frame_free_lists.Heads[size_class];
+        s_frame_free_lists.Heads[size_class] = block;
+    }
+
+    ITaskFrameAllocator* TaskFrameAllocator::Get()
+    {
+        return s_frame_allocator.load(std::memory_order_acquire);
+    }
+
+    void TaskFrameAllocator::Set(ITaskFrameAllocator* allocator)
+    {
+        s_frame_allocator.store(allocator ? allocator : &s_default_frame_allocator, std::memory_order_release);
+    }
+
+    void* TaskFrameAllocator::AllocateFrame(size_t byte_size)
+    {
+        auto allocator                                   = Get();
+        auto memory                                      = static_cast<uint8_t*>(allocator->Allocate(byte_size + FrameHeaderByteSize));
+        *reinterpret_cast<ITaskFrameAllocator**>(memory) = allocator;
+        return memory + FrameHeaderByteSize;
+    }
+
+    void TaskFrameAllocator::DeallocateFrame(void* ptr, size_t byte_size)
+    {
+        auto memory    = static_cast<uint8_t*>(ptr) - FrameHeaderByteSize;
+        auto allocator = *reinterpret_cast<ITaskFrameAllocator**>(memory);
+        allocator->Deallocate(memory, byte_size + FrameHeaderByteSize);
+    }
+} // namespace ZEngine::Core
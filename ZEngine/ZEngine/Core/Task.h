@@ -0,0 +1,510 @@
+#pragma once
+#include <Core/Coroutine.h>
+#include <Helpers/ThreadPool.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace ZEngine::Core
+{
+    /*
+     * Allocation strategy for Task<T> coroutine frames.
+     * Every frame records the allocator that produced it, so the active allocator can be swapped at any time.
+     */
+    struct ITaskFrameAllocator
+    {
+        virtual ~ITaskFrameAllocator()                        = default;
+        virtual void* Allocate(size_t byte_size)              = 0;
+        virtual void  Deallocate(void* ptr, size_t byte_size) = 0;
+    };
+
+    struct DefaultTaskFrameAllocator : public ITaskFrameAllocator
+    {
+        void* Allocate(size_t byte_size) override;
+        void  Deallocate(void* ptr, size_t byte_size) override;
+    };
+
+    /*
+     * Thread-local free lists bucketed by size class : once warm, creating a Task frame neither hits the heap nor takes a lock.
+     * Frames larger than MaxPooledByteSize fall back to the global heap.
+     */
+    struct PooledTaskFrameAllocator : public ITaskFrameAllocator
+    {
+        static constexpr size_t SizeClassGranularity = 64;
+        static constexpr size_t MaxPooledByteSize    = 1024;
+
+        void*                   Allocate(size_t byte_size) override;
+        void                    Deallocate(void* ptr, size_t byte_size) override;
+    };
+
+    struct TaskFrameAllocator
+    {
+        static ITaskFrameAllocator* Get();
+        static void                 Set(ITaskFrameAllocator* allocator);
+
+        static void*                AllocateFrame(size_t byte_size);
+        static void                 DeallocateFrame(void* ptr, size_t byte_size);
+
+    private:
+        TaskFrameAllocator()  = delete;
+        ~TaskFrameAllocator() = delete;
+    };
+
+    template <typename T = void>
+    class Task;
+
+    namespace Internal
+    {
+        struct TaskPromiseBase
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                /*
+                 * Symmetric transfer : when the awaiter has already suspended, it is resumed as a tail call instead of a nested resume().
+                 * When the body completed synchronously inside AwaiterBase::await_suspend(), the awaiter simply does not suspend,
+                 * which keeps tight await loops in constant stack space even where the compiler does not emit the tail call (e.g -O0).
+                 */
+                template <typename TPromise>
+                ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<> await_suspend(ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<TPromise> handle) noexcept
+                {
+                    auto& promise = handle.promise();
+                    if (promise.Completed.exchange(true, std::memory_order_acq_rel) && promise.Continuation)
+                    {
+                        return promise.Continuation;
+                    }
+                    return ZENGINE_COROUTINE_NAMESPACE::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<> Continuation = nullptr;
+            std::exception_ptr                              Exception    = nullptr;
+            /*
+             * Raced by the final awaiter and the awaiting coroutine, the second one to flip it is responsible for the continuation
+             */
+            std::atomic_bool                                Completed    = false;
+
+            /*
+             * Starts the lazily created coroutine on behalf of `awaiting`, returns whether `awaiting` must stay suspended
+             */
+            template <typename TPromise>
+            static bool Start(ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<TPromise> handle, ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<> awaiting)
+            {
+                auto& promise        = handle.promise();
+                promise.Continuation = awaiting;
+                handle.resume();
+                return !promise.Completed.exchange(true, std::memory_order_acq_rel);
+            }
+
+            ZENGINE_COROUTINE_NAMESPACE::suspend_always     initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                Exception = std::current_exception();
+            }
+
+            static void* operator new(size_t byte_size)
+            {
+                return TaskFrameAllocator::AllocateFrame(byte_size);
+            }
+
+            static void operator delete(void* ptr, size_t byte_size)
+            {
+                TaskFrameAllocator::DeallocateFrame(ptr, byte_size);
+            }
+        };
+
+        template <typename T>
+        struct TaskPromise : public TaskPromiseBase
+        {
+            std::optional<T> Value = std::nullopt;
+
+            Task<T>          get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U&& value)
+            {
+                Value.emplace(std::forward<U>(value));
+            }
+
+            T& Result() &
+            {
+                if (Exception)
+                {
+                    std::rethrow_exception(Exception);
+                }
+                return *Value;
+            }
+
+            T&& Result() &&
+            {
+                if (Exception)
+                {
+                    std::rethrow_exception(Exception);
+                }
+                return std::move(*Value);
+            }
+        };
+
+        template <>
+        struct TaskPromise<void> : public TaskPromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+
+            void       return_void() noexcept {}
+
+            void       Result()
+            {
+                if (Exception)
+                {
+                    std::rethrow_exception(Exception);
+                }
+            }
+        };
+    } // namespace Internal
+
+    /*
+     * Lazily started, single-consumer coroutine.
+     * Unlike the std::future coroutines there is no shared state, no mutex and no polling : the body starts when awaited and
+     * hands control back to its awaiter (see TaskPromiseBase::FinalAwaiter) when it completes.
+     */
+    template <typename T>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = Internal::TaskPromise<T>;
+        using HandleType   = ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<promise_type>;
+
+        Task()             = default;
+        explicit Task(HandleType handle) noexcept : m_handle(handle) {}
+        Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+        Task(const Task&)            = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Destroy();
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~Task()
+        {
+            Destroy();
+        }
+
+        bool IsReady() const noexcept
+        {
+            return !m_handle || m_handle.done();
+        }
+
+        HandleType Handle() const noexcept
+        {
+            return m_handle;
+        }
+
+        auto operator co_await() & noexcept
+        {
+            struct Awaiter : public AwaiterBase
+            {
+                decltype(auto) await_resume()
+                {
+                    return this->m_handle.promise().Result();
+                }
+            };
+            return Awaiter{{m_handle}};
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter : public AwaiterBase
+            {
+                decltype(auto) await_resume()
+                {
+                    return std::move(this->m_handle.promise()).Result();
+                }
+            };
+            return Awaiter{{m_handle}};
+        }
+
+    private:
+        HandleType m_handle = nullptr;
+
+        struct AwaiterBase
+        {
+            HandleType m_handle;
+
+            bool       await_ready() const noexcept
+            {
+                return !m_handle || m_handle.done();
+            }
+
+            bool await_suspend(ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<> awaiting)
+            {
+                return Internal::TaskPromiseBase::Start(m_handle, awaiting);
+            }
+        };
+
+        void Destroy()
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+                m_handle = nullptr;
+            }
+        }
+    };
+
+    namespace Internal
+    {
+        template <typename T>
+        inline Task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return Task<T>{Task<T>::HandleType::from_promise(*this)};
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return Task<void>{Task<void>::HandleType::from_promise(*this)};
+        }
+    } // namespace Internal
+
+    /*
+     * Result holder for operations that usually complete synchronously (cache hits, already loaded resources...).
+     * The ready path stores the value inline and allocates no coroutine frame, the slow path wraps a Task<T>.
+     */
+    template <typename T = void>
+    class [[nodiscard]] ValueTask
+    {
+    public:
+        ValueTask(T value) : m_value(std::move(value)) {}
+        ValueTask(Task<T>&& task) : m_task(std::move(task)) {}
+
+        bool IsReady() const noexcept
+        {
+            return m_value.has_value() || m_task.IsReady();
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                ValueTask& m_owner;
+
+                bool       await_ready() const noexcept
+                {
+                    return m_owner.m_value.has_value() || m_owner.m_task.IsReady();
+                }
+
+                bool await_suspend(ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<> awaiting)
+                {
+                    return Internal::TaskPromiseBase::Start(m_owner.m_task.Handle(), awaiting);
+                }
+
+                T await_resume()
+                {
+                    if (m_owner.m_value.has_value())
+                    {
+                        return std::move(*m_owner.m_value);
+                    }
+                    return std::move(m_owner.m_task.Handle().promise()).Result();
+                }
+            };
+            return Awaiter{*this};
+        }
+
+    private:
+        std::optional<T> m_value = std::nullopt;
+        Task<T>          m_task  = {};
+    };
+
+    template <>
+    class [[nodiscard]] ValueTask<void>
+    {
+    public:
+        ValueTask() = default;
+        ValueTask(Task<void>&& task) : m_task(std::move(task)) {}
+
+        bool IsReady() const noexcept
+        {
+            return m_task.IsReady();
+        }
+
+        auto operator co_await() && noexcept
+        {
+            return std::move(m_task).operator co_await();
+        }
+
+    private:
+        Task<void> m_task = {};
+    };
+
+    /*
+     * Awaitable moving the rest of the coroutine onto a ThreadPool worker
+     */
+    struct ThreadPoolAwaitable
+    {
+        Helpers::TaskPriority Priority = Helpers::TaskPriority::Normal;
+
+        bool                  await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(ZENGINE_COROUTINE_NAMESPACE::coroutine_handle<> handle) const
+        {
+            Helpers::ThreadPoolHelper::Post([handle] { handle.resume(); }, Priority);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    inline ThreadPoolAwaitable ResumeOnThreadPool(Helpers::TaskPriority priority = Helpers::TaskPriority::Normal)
+    {
+        return ThreadPoolAwaitable{priority};
+    }
+
+    namespace Internal
+    {
+        struct SyncWaitEvent
+        {
+            std::mutex              Mutex;
+            std::condition_variable Condition;
+            bool                    Completed = false;
+
+            void                    Set()
+            {
+                std::lock_guard l(Mutex);
+                Completed = true;
+                Condition.notify_all();
+            }
+
+            void Wait()
+            {
+                std::unique_lock l(Mutex);
+                Condition.wait(l, [this] { return Completed; });
+            }
+        };
+
+        struct DetachedTask
+        {
+            struct promise_type
+            {
+                DetachedTask get_return_object() const noexcept
+                {
+                    return {};
+                }
+
+                ZENGINE_COROUTINE_NAMESPACE::suspend_never initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                ZENGINE_COROUTINE_NAMESPACE::suspend_never final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                void return_void() const noexcept {}
+
+                void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+
+        template <typename T>
+        DetachedTask RunAndSignal(Task<T>& task, std::optional<T>& result, std::exception_ptr& exception, SyncWaitEvent& event)
+        {
+            try
+            {
+                result.emplace(co_await task);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            event.Set();
+        }
+
+        inline DetachedTask RunAndSignal(Task<void>& task, std::exception_ptr& exception, SyncWaitEvent& event)
+        {
+            try
+            {
+                co_await task;
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            event.Set();
+        }
+    } // namespace Internal
+
+    /*
+     * Blocks the calling thread until the task completes. Meant for the boundary between synchronous and coroutine code
+     */
+    template <typename T>
+    T SyncWait(Task<T> task)
+    {
+        Internal::SyncWaitEvent event     = {};
+        std::exception_ptr      exception = nullptr;
+
+        if constexpr (std::is_void_v<T>)
+        {
+            Internal::RunAndSignal(task, exception, event);
+            event.Wait();
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+        else
+        {
+            std::optional<T> result = std::nullopt;
+            Internal::RunAndSignal(task, result, exception, event);
+            event.Wait();
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+            return std::move(*result);
+        }
+    }
+
+    /*
+     * Bridges a Task<T> to the std::future based APIs
+     */
+    template <typename T>
+    std::future<T> AsFuture(Task<T> task)
+    {
+        co_return co_await std::move(task);
+    }
+
+    inline std::future<void> AsFuture(Task<void> task)
+    {
+        co_await std::move(task);
+    }
+} // namespace ZEngine::Core
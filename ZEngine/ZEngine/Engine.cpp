@@ -75,6 +75,7 @@ namespace ZEngine
             /*On Update*/
             window->Update(dt);
 
+            g_renderer->Update();
             g_device->Update();
             if (g_renderer->EnqueuedResizeRequests.Size())
             {
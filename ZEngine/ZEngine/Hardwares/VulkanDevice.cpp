@@ -154,6 +154,18 @@ namespace ZEngine::Hardwares
             }
         }
 
+        /*
+         * Every descriptor set layout is created with UPDATE_AFTER_BIND_POOL : its sampled images count against the update-after-bind
+         * limits, per set and per stage
+         */
+        VkPhysicalDeviceDescriptorIndexingProperties descriptor_indexing_properties = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES, .pNext = nullptr};
+        VkPhysicalDeviceProperties2                  physical_device_properties_2   = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &descriptor_indexing_properties};
+        vkGetPhysicalDeviceProperties2(PhysicalDevice, &physical_device_properties_2);
+
+        uint32_t sampled_image_limit = std::min(descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages, descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages);
+        BindlessTextureCount         = std::min(MaxBindlessTextureCount, (sampled_image_limit > ReservedSampledImageCount) ? (sampled_image_limit - ReservedSampledImageCount) : 1u);
+        GlobalTextures               = CreateRef<Textures::TextureHandleManager>(std::min(600u, BindlessTextureCount), BindlessTextureCount);
+
         std::vector<const char*> requested_device_enabled_layer_name_collection   = {};
         std::vector<const char*> requested_device_extension_layer_name_collection = {VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME};
 
@@ -231,6 +243,10 @@ namespace ZEngine::Hardwares
         PhysicalDeviceFeature.multiDrawIndirect                                                    = VK_TRUE;
         PhysicalDeviceFeature.shaderSampledImageArrayDynamicIndexing                               = VK_TRUE;
 
+        VkPhysicalDeviceTimelineSemaphoreFeatures     physical_device_timeline_features            = {};
+        physical_device_timeline_features.sType                                                    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        physical_device_timeline_features.timelineSemaphore                                        = VK_TRUE;
+
         VkPhysicalDeviceDescriptorIndexingFeaturesEXT physical_device_descriptor_indexing_features = {};
         physical_device_descriptor_indexing_features.sType                                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
         physical_device_descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
@@ -238,6 +254,7 @@ namespace ZEngine::Hardwares
         physical_device_descriptor_indexing_features.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
         physical_device_descriptor_indexing_features.descriptorBindingPartiallyBound               = VK_TRUE;
         physical_device_descriptor_indexing_features.runtimeDescriptorArray                        = VK_TRUE;
+        physical_device_descriptor_indexing_features.pNext                                         = &physical_device_timeline_features;
 
         VkPhysicalDeviceFeatures2 device_features_2                                                = {};
         device_features_2.sType                                                                    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
@@ -255,16 +272,7 @@ namespace ZEngine::Hardwares
 
         ZENGINE_VALIDATE_ASSERT(vkCreateDevice(PhysicalDevice, &device_create_info, nullptr, &LogicalDevice) == VK_SUCCESS, "Failed to create GPU logical device")
 
-        /*Create Vulkan Graphic Queue*/
-        m_queue_map[Rendering::QueueType::GRAPHIC_QUEUE] = VK_NULL_HANDLE;
-        vkGetDeviceQueue(LogicalDevice, GraphicFamilyIndex, 0, &(m_queue_map[Rendering::QueueType::GRAPHIC_QUEUE]));
-
-        /*Create Vulkan Transfer Queue*/
-        if (HasSeperateTransfertQueueFamily)
-        {
-            m_queue_map[Rendering::QueueType::TRANSFER_QUEUE] = VK_NULL_HANDLE;
-            vkGetDeviceQueue(LogicalDevice, TransferFamilyIndex, 0, &(m_queue_map[Rendering::QueueType::TRANSFER_QUEUE]));
-        }
+        GetDeviceQueues();
 
         /* Surface format selection */
         uint32_t                        format_count    = 0;
@@ -331,6 +339,18 @@ namespace ZEngine::Hardwares
         m_buffer_manager.Initialize(this);
         EnqueuedCommandbuffers.resize(m_buffer_manager.TotalCommandBufferCount);
 
+        __loadPipelineCache();
+
+        /*
+         * Creating the staging ring, mapped once for the device lifetime
+         */
+        m_staging_buffer               = CreateBuffer(StagingRingByteSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        VmaAllocationInfo staging_info = {};
+        vmaGetAllocationInfo(VmaAllocator, m_staging_buffer.Allocation, &staging_info);
+        m_staging_data = static_cast<uint8_t*>(staging_info.pMappedData);
+        m_staging_ring.Reset(m_staging_data ? static_cast<size_t>(StagingRingByteSize) : 0);
+        m_transfer_batcher.Initialize(this);
+
         /*
          * Creating Swapchain
          */
@@ -387,43 +407,87 @@ namespace ZEngine::Hardwares
         ZENGINE_CLEAR_STD_VECTOR(SwapchainImageViews)
         ZENGINE_CLEAR_STD_VECTOR(SwapchainFramebuffers)
 
-        m_buffer_manager.Deinitialize();
+        __savePipelineCache();
 
-        __cleanupBufferDirtyResource();
+        m_transfer_batcher.Wait(m_transfer_batcher.Flush());
+        __retireStaging();
+        m_transfer_batcher.Deinitialize();
+        m_buffer_manager.Deinitialize();
 
-        __cleanupBufferImageDirtyResource();
+        m_staging_ring.Reset(0);
+        m_staging_data = nullptr;
+        EnqueueBufferForDeletion(m_staging_buffer);
+        m_staging_buffer = {};
 
-        __cleanupDirtyResource();
+        CollectDirtyResources();
 
         ZENGINE_DESTROY_VULKAN_HANDLE(Instance, vkDestroySurfaceKHR, Surface, nullptr)
     }
 
     void VulkanDevice::Update()
     {
-        Textures::TextureHandle tex_handle = {};
-        if (TextureHandleToUpdates.Pop(tex_handle))
+        /*
+         * Every texture that landed since the last frame, streamed levels swap in several at once : one descriptor update.
+         * The deferred ones come first, they were queued earlier
+         */
+        std::vector<Textures::TextureHandle> pending = std::move(m_deferred_texture_updates);
+        m_deferred_texture_updates.clear();
+
+        size_t update_count = TextureHandleToUpdates.Size();
+        if (pending.empty() && (update_count == 0))
         {
+            return;
+        }
+
+        for (size_t i = 0; i < update_count; ++i)
+        {
+            Textures::TextureHandle tex_handle = {};
+            if (!TextureHandleToUpdates.Pop(tex_handle))
+            {
+                break;
+            }
+            pending.push_back(tex_handle);
+        }
 
-            auto& texture = GlobalTextures->Access(tex_handle);
+        std::vector<VkDescriptorImageInfo> image_infos           = {};
+        std::vector<VkWriteDescriptorSet>  write_descriptor_sets = {};
+        image_infos.reserve(pending.size());
+        write_descriptor_sets.reserve(pending.size() * WriteBindlessDescriptorSetRequests.size());
 
+        for (const auto& tex_handle : pending)
+        {
+            auto* texture = GlobalTextures->TryAccess(tex_handle);
             if (!texture)
             {
-                TextureHandleToUpdates.Enqueue(tex_handle);
-                return;
+                continue;
+            }
+            if (!(*texture))
+            {
+                EnqueueTextureUpdate(tex_handle);
+                continue;
             }
-            const auto&                       image_info            = texture->ImageBuffer->GetDescriptorImageInfo();
-            std::vector<VkWriteDescriptorSet> write_descriptor_sets = {};
-            write_descriptor_sets.reserve(WriteBindlessDescriptorSetRequests.size());
 
+            const auto& image_info = image_infos.emplace_back((*texture)->ImageBuffer->GetDescriptorImageInfo());
             for (auto& req : WriteBindlessDescriptorSetRequests)
             {
                 write_descriptor_sets.push_back(VkWriteDescriptorSet{.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = req.DstSet, .dstBinding = req.Binding, .dstArrayElement = (uint32_t) tex_handle.Index, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .pImageInfo = &(image_info), .pBufferInfo = nullptr, .pTexelBufferView = nullptr});
             }
+        }
 
+        if (!write_descriptor_sets.empty())
+        {
             vkUpdateDescriptorSets(LogicalDevice, write_descriptor_sets.size(), write_descriptor_sets.data(), 0, nullptr);
         }
     }
 
+    void VulkanDevice::EnqueueTextureUpdate(const Textures::TextureHandle& handle)
+    {
+        if (!TextureHandleToUpdates.TryEnqueue(handle))
+        {
+            m_deferred_texture_updates.push_back(handle);
+        }
+    }
+
     void VulkanDevice::Dispose()
     {
         vmaDestroyAllocator(VmaAllocator);
@@ -463,7 +527,10 @@ namespace ZEngine::Hardwares
                      .pSignalSemaphores    = 0,
         };
 
-        ZENGINE_VALIDATE_ASSERT(vkQueueSubmit(GetQueue(command_buffer->QueueType).Handle, 1, &submit_info, fence->GetHandle()) == VK_SUCCESS, "Failed to submit queue")
+        {
+            std::lock_guard l(QueueSubmitMutex);
+            ZENGINE_VALIDATE_ASSERT(vkQueueSubmit(GetQueue(command_buffer->QueueType).Handle, 1, &submit_info, fence->GetHandle()) == VK_SUCCESS, "Failed to submit queue")
+        }
         command_buffer->SetState(CommanBufferState::Pending);
 
         fence->SetState(FenceState::Submitted);
@@ -508,6 +575,20 @@ namespace ZEngine::Hardwares
         m_dirty_buffer_images.Add(buffer);
     }
 
+    void VulkanDevice::GetDeviceQueues()
+    {
+        /*Create Vulkan Graphic Queue*/
+        m_queue_map[Rendering::QueueType::GRAPHIC_QUEUE] = VK_NULL_HANDLE;
+        vkGetDeviceQueue(LogicalDevice, GraphicFamilyIndex, 0, &(m_queue_map[Rendering::QueueType::GRAPHIC_QUEUE]));
+
+        /*Create Vulkan Transfer Queue*/
+        if (HasSeperateTransfertQueueFamily)
+        {
+            m_queue_map[Rendering::QueueType::TRANSFER_QUEUE] = VK_NULL_HANDLE;
+            vkGetDeviceQueue(LogicalDevice, TransferFamilyIndex, 0, &(m_queue_map[Rendering::QueueType::TRANSFER_QUEUE]));
+        }
+    }
+
     void VulkanDevice::QueueWait(Rendering::QueueType type)
     {
         if (!HasSeperateTransfertQueueFamily)
@@ -563,110 +644,91 @@ namespace ZEngine::Hardwares
         return VK_FALSE;
     }
 
-    void VulkanDevice::__cleanupDirtyResource()
+    void VulkanDevice::__destroyDirtyResource(const DirtyResource& res_handle)
     {
-        size_t dirty_resource_count = m_dirty_resources.Head();
-        for (size_t i = 0; i < dirty_resource_count; ++i)
+        switch (res_handle.Type)
         {
-            auto handle = m_dirty_resources.ToHandle(i);
-
-            if (!handle)
-            {
-                continue;
-            }
-
-            DirtyResource& res_handle = m_dirty_resources[handle];
-            switch (res_handle.Type)
+            case Rendering::DeviceResourceType::SAMPLER:
+                vkDestroySampler(LogicalDevice, reinterpret_cast<VkSampler>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::FRAMEBUFFER:
+                vkDestroyFramebuffer(LogicalDevice, reinterpret_cast<VkFramebuffer>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::IMAGEVIEW:
+                vkDestroyImageView(LogicalDevice, reinterpret_cast<VkImageView>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::IMAGE:
+                vkDestroyImage(LogicalDevice, reinterpret_cast<VkImage>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::RENDERPASS:
+                vkDestroyRenderPass(LogicalDevice, reinterpret_cast<VkRenderPass>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::BUFFERMEMORY:
+                vkFreeMemory(LogicalDevice, reinterpret_cast<VkDeviceMemory>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::BUFFER:
+                vkDestroyBuffer(LogicalDevice, reinterpret_cast<VkBuffer>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::PIPELINE_LAYOUT:
+                vkDestroyPipelineLayout(LogicalDevice, reinterpret_cast<VkPipelineLayout>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::PIPELINE:
+                vkDestroyPipeline(LogicalDevice, reinterpret_cast<VkPipeline>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::DESCRIPTORSETLAYOUT:
+                vkDestroyDescriptorSetLayout(LogicalDevice, reinterpret_cast<VkDescriptorSetLayout>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::DESCRIPTORPOOL:
+                vkDestroyDescriptorPool(LogicalDevice, reinterpret_cast<VkDescriptorPool>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::SEMAPHORE:
+                vkDestroySemaphore(LogicalDevice, reinterpret_cast<VkSemaphore>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::FENCE:
+                vkDestroyFence(LogicalDevice, reinterpret_cast<VkFence>(res_handle.Handle), nullptr);
+                break;
+            case Rendering::DeviceResourceType::DESCRIPTORSET:
             {
-                case Rendering::DeviceResourceType::SAMPLER:
-                    vkDestroySampler(LogicalDevice, reinterpret_cast<VkSampler>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::FRAMEBUFFER:
-                    vkDestroyFramebuffer(LogicalDevice, reinterpret_cast<VkFramebuffer>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::IMAGEVIEW:
-                    vkDestroyImageView(LogicalDevice, reinterpret_cast<VkImageView>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::IMAGE:
-                    vkDestroyImage(LogicalDevice, reinterpret_cast<VkImage>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::RENDERPASS:
-                    vkDestroyRenderPass(LogicalDevice, reinterpret_cast<VkRenderPass>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::BUFFERMEMORY:
-                    vkFreeMemory(LogicalDevice, reinterpret_cast<VkDeviceMemory>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::BUFFER:
-                    vkDestroyBuffer(LogicalDevice, reinterpret_cast<VkBuffer>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::PIPELINE_LAYOUT:
-                    vkDestroyPipelineLayout(LogicalDevice, reinterpret_cast<VkPipelineLayout>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::PIPELINE:
-                    vkDestroyPipeline(LogicalDevice, reinterpret_cast<VkPipeline>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::DESCRIPTORSETLAYOUT:
-                    vkDestroyDescriptorSetLayout(LogicalDevice, reinterpret_cast<VkDescriptorSetLayout>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::DESCRIPTORPOOL:
-                    vkDestroyDescriptorPool(LogicalDevice, reinterpret_cast<VkDescriptorPool>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::SEMAPHORE:
-                    vkDestroySemaphore(LogicalDevice, reinterpret_cast<VkSemaphore>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::FENCE:
-                    vkDestroyFence(LogicalDevice, reinterpret_cast<VkFence>(res_handle.Handle), nullptr);
-                    break;
-                case Rendering::DeviceResourceType::DESCRIPTORSET:
-                {
-                    auto ds = reinterpret_cast<VkDescriptorSet>(res_handle.Handle);
-                    vkFreeDescriptorSets(LogicalDevice, reinterpret_cast<VkDescriptorPool>(res_handle.Data1), 1, &ds);
-                    break;
-                }
+                auto ds = reinterpret_cast<VkDescriptorSet>(res_handle.Handle);
+                vkFreeDescriptorSets(LogicalDevice, reinterpret_cast<VkDescriptorPool>(res_handle.Data1), 1, &ds);
+                break;
             }
-
-            m_dirty_resources.Remove(handle);
         }
     }
 
-    void VulkanDevice::__cleanupBufferDirtyResource()
+    void VulkanDevice::CollectDirtyResources()
     {
-        size_t dirty_buffer_count = m_dirty_buffers.Head();
-        for (size_t i = 0; i < dirty_buffer_count; ++i)
-        {
-            auto handle = m_dirty_buffers.ToHandle(i);
+        __cleanupBufferDirtyResource();
 
-            if (!handle)
-            {
-                continue;
-            }
+        __cleanupBufferImageDirtyResource();
 
-            BufferView& buffer = m_dirty_buffers[handle];
-            vmaDestroyBuffer(VmaAllocator, buffer.Handle, buffer.Allocation);
-            m_dirty_buffers.Remove(handle);
-        }
+        __cleanupDirtyResource();
     }
 
-    void VulkanDevice::__cleanupBufferImageDirtyResource()
+    void VulkanDevice::__cleanupDirtyResource()
     {
-        size_t dirty_buffer_image_count = m_dirty_buffer_images.Head();
-        for (size_t i = 0; i < dirty_buffer_image_count; ++i)
-        {
-            auto handle = m_dirty_buffer_images.ToHandle(i);
-
-            if (!handle)
-            {
-                continue;
-            }
+        m_dirty_resources.RemoveIf([this](const DirtyResource& res_handle) {
+            __destroyDirtyResource(res_handle);
+            return true;
+        });
+    }
 
-            BufferImage& buffer = m_dirty_buffer_images[handle];
+    void VulkanDevice::__cleanupBufferDirtyResource()
+    {
+        m_dirty_buffers.RemoveIf([this](const BufferView& buffer) {
+            vmaDestroyBuffer(VmaAllocator, buffer.Handle, buffer.Allocation);
+            return true;
+        });
+    }
 
+    void VulkanDevice::__cleanupBufferImageDirtyResource()
+    {
+        m_dirty_buffer_images.RemoveIf([this](const BufferImage& buffer) {
             vkDestroyImageView(LogicalDevice, buffer.ViewHandle, nullptr);
             vkDestroySampler(LogicalDevice, buffer.Sampler, nullptr);
             vmaDestroyImage(VmaAllocator, buffer.Handle, buffer.Allocation);
-
-            m_dirty_buffer_images.Remove(handle);
-        }
+            return true;
+        });
     }
 
     void VulkanDevice::MapAndCopyToMemory(BufferView& buffer, size_t data_size, const void* data)
@@ -682,16 +744,23 @@ namespace ZEngine::Hardwares
 
     BufferView VulkanDevice::CreateBuffer(VkDeviceSize byte_size, VkBufferUsageFlags buffer_usage, VmaAllocationCreateFlags vma_create_flags)
     {
-        BufferView         buffer_view                 = {};
-        VkBufferCreateInfo buffer_create_info          = {};
-        buffer_create_info.sType                       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buffer_create_info.size                        = byte_size;
-        buffer_create_info.usage                       = buffer_usage;
-        buffer_create_info.sharingMode                 = VK_SHARING_MODE_EXCLUSIVE;
-
-        VmaAllocationCreateInfo allocation_create_info = {};
-        allocation_create_info.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
-        allocation_create_info.flags                   = vma_create_flags;
+        /*
+         * With a dedicated transfer queue, buffers are shared by both families : the transfer batch can write again a buffer the
+         * graphic queue already used (partial updates included) without handing its ownership back to the transfer family first
+         */
+        std::array<uint32_t, 2> family_indices           = {GraphicFamilyIndex, TransferFamilyIndex};
+        BufferView              buffer_view              = {};
+        VkBufferCreateInfo      buffer_create_info       = {};
+        buffer_create_info.sType                         = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_create_info.size                          = byte_size;
+        buffer_create_info.usage                         = buffer_usage;
+        buffer_create_info.sharingMode                   = HasSeperateTransfertQueueFamily ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+        buffer_create_info.queueFamilyIndexCount         = HasSeperateTransfertQueueFamily ? 2 : 0;
+        buffer_create_info.pQueueFamilyIndices           = HasSeperateTransfertQueueFamily ? family_indices.data() : nullptr;
+
+        VmaAllocationCreateInfo allocation_create_info   = {};
+        allocation_create_info.usage                     = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        allocation_create_info.flags                     = vma_create_flags;
 
         ZENGINE_VALIDATE_ASSERT(vmaCreateBuffer(VmaAllocator, &buffer_create_info, &allocation_create_info, &(buffer_view.Handle), &(buffer_view.Allocation), nullptr) == VK_SUCCESS, "Failed to create buffer");
 
@@ -701,21 +770,176 @@ namespace ZEngine::Hardwares
         return buffer_view;
     }
 
-    void VulkanDevice::CopyBuffer(const BufferView& source, const BufferView& destination, VkDeviceSize byte_size)
+    uint64_t VulkanDevice::CopyBuffer(const BufferView& source, const BufferView& destination, VkDeviceSize byte_size, VkDeviceSize source_offset)
+    {
+        VkBufferCopy buffer_copy = {};
+        buffer_copy.srcOffset    = source_offset;
+        buffer_copy.dstOffset    = 0;
+        buffer_copy.size         = byte_size;
+
+        return m_transfer_batcher.EnqueueBufferCopy(source, destination, {&buffer_copy, 1});
+    }
+
+    uint64_t VulkanDevice::CopyBuffer(const BufferView& source, const BufferView& destination, std::span<const VkBufferCopy> regions)
+    {
+        return m_transfer_batcher.EnqueueBufferCopy(source, destination, regions);
+    }
+
+    uint64_t VulkanDevice::CopyBufferToImage(const StagingAllocation& source, BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageAspectFlagBits aspect, VkImageLayout final_layout, uint32_t mip_levels, std::span<const VkDeviceSize> level_offsets)
+    {
+        return m_transfer_batcher.EnqueueImageCopy(source.Buffer, source.Offset, destination, width, height, layer_count, aspect, final_layout, mip_levels, level_offsets);
+    }
+
+    uint64_t VulkanDevice::FlushTransfers()
+    {
+        return m_transfer_batcher.Flush();
+    }
+
+    bool VulkanDevice::IsTransferComplete(uint64_t token) const
+    {
+        return m_transfer_batcher.IsComplete(token);
+    }
+
+    bool VulkanDevice::WaitTransfer(uint64_t token)
+    {
+        return m_transfer_batcher.Wait(token);
+    }
+
+    StagingAllocation VulkanDevice::AllocateStaging(VkDeviceSize byte_size, VkDeviceSize alignment)
+    {
+        if (byte_size == 0)
+        {
+            return {};
+        }
+
+        if (byte_size <= StagingDedicatedThreshold)
+        {
+            std::lock_guard l(m_staging_mutex);
+            size_t          offset = m_staging_ring.Allocate(static_cast<size_t>(byte_size), static_cast<size_t>(alignment));
+            if (offset != Helpers::StagingRingAllocator::InvalidOffset)
+            {
+                return StagingAllocation{.Buffer = m_staging_buffer, .Offset = offset, .ByteSize = byte_size, .Data = m_staging_data + offset, .Dedicated = false};
+            }
+        }
+
+        /*
+         * Oversized payload, or every slice of the ring is still in flight
+         */
+        BufferView        buffer          = CreateBuffer(byte_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        VmaAllocationInfo allocation_info = {};
+        vmaGetAllocationInfo(VmaAllocator, buffer.Allocation, &allocation_info);
+        return StagingAllocation{.Buffer = buffer, .Offset = 0, .ByteSize = byte_size, .Data = allocation_info.pMappedData, .Dedicated = true};
+    }
+
+    void VulkanDevice::FlushStaging(const StagingAllocation& allocation)
+    {
+        if (allocation)
+        {
+            ZENGINE_VALIDATE_ASSERT(vmaFlushAllocation(VmaAllocator, allocation.Buffer.Allocation, allocation.Offset, allocation.ByteSize) == VK_SUCCESS, "Failed to flush allocation")
+        }
+    }
+
+    void VulkanDevice::ReleaseStaging(StagingAllocation& allocation, uint64_t transfer_token)
+    {
+        if (!allocation.Buffer)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard l(m_staging_mutex);
+            if (allocation.Dedicated)
+            {
+                m_pending_staging_buffers.push_back({.Buffer = allocation.Buffer, .TransferToken = transfer_token});
+            }
+            else
+            {
+                m_staging_ring.Submit(static_cast<size_t>(allocation.Offset), transfer_token);
+            }
+        }
+        allocation = {};
+
+        __retireStaging();
+    }
+
+    void VulkanDevice::__retireStaging()
+    {
+        uint64_t        completed_value = m_transfer_batcher.GetCompletedValue();
+
+        std::lock_guard l(m_staging_mutex);
+        m_staging_ring.Retire(completed_value);
+        std::erase_if(m_pending_staging_buffers, [this, completed_value](PendingStagingBuffer& pending) {
+            if (pending.TransferToken > completed_value)
+            {
+                return false;
+            }
+            EnqueueBufferForDeletion(pending.Buffer);
+            return true;
+        });
+    }
+
+    Serializers::PipelineCacheIdentity VulkanDevice::__pipelineCacheIdentity() const
     {
-        auto command_buffer = GetInstantCommandBuffer(Rendering::QueueType::TRANSFER_QUEUE);
+        VkPhysicalDeviceIDProperties id_properties = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES, .pNext = nullptr};
+        VkPhysicalDeviceProperties2  properties    = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &id_properties};
+        vkGetPhysicalDeviceProperties2(PhysicalDevice, &properties);
+
+        Serializers::PipelineCacheIdentity identity = {.VendorID = PhysicalDeviceProperties.vendorID, .DeviceID = PhysicalDeviceProperties.deviceID, .DriverVersion = PhysicalDeviceProperties.driverVersion};
+        std::memcpy(identity.PipelineCacheUUID.data(), PhysicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+        std::memcpy(identity.DriverUUID.data(), id_properties.driverUUID, VK_UUID_SIZE);
+        return identity;
+    }
+
+    void VulkanDevice::__loadPipelineCache()
+    {
+        std::vector<std::byte> data   = {};
+        auto                   result = Serializers::PipelineCacheSerializer::Load(PipelineCacheFilename, __pipelineCacheIdentity(), data);
+        if (result == Serializers::PipelineCacheLoadResult::IDENTITY_MISMATCH)
+        {
+            ZENGINE_CORE_INFO("Pipeline cache {} was written for another device or driver, starting empty", PipelineCacheFilename)
+        }
+        else if (result == Serializers::PipelineCacheLoadResult::INVALID_DATA)
         {
-            VkBufferCopy buffer_copy = {};
-            buffer_copy.srcOffset    = 0;
-            buffer_copy.dstOffset    = 0;
-            buffer_copy.size         = byte_size;
+            ZENGINE_CORE_WARN("Pipeline cache {} holds invalid data, starting empty", PipelineCacheFilename)
+        }
 
-            vkCmdCopyBuffer(command_buffer->GetHandle(), source.Handle, destination.Handle, 1, &buffer_copy);
+        VkPipelineCacheCreateInfo create_info = {.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO, .pNext = nullptr, .flags = 0, .initialDataSize = data.size(), .pInitialData = data.empty() ? nullptr : data.data()};
+        if ((vkCreatePipelineCache(LogicalDevice, &create_info, nullptr, &PipelineCache) != VK_SUCCESS) && !data.empty())
+        {
+            ZENGINE_CORE_WARN("The driver refused pipeline cache {}, starting empty", PipelineCacheFilename)
+            create_info.initialDataSize = 0;
+            create_info.pInitialData    = nullptr;
+            ZENGINE_VALIDATE_ASSERT(vkCreatePipelineCache(LogicalDevice, &create_info, nullptr, &PipelineCache) == VK_SUCCESS, "Failed to create pipeline cache")
         }
-        EnqueueInstantCommandBuffer(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT);
     }
 
-    BufferImage VulkanDevice::CreateImage(uint32_t width, uint32_t height, VkImageType image_type, VkImageViewType image_view_type, VkFormat image_format, VkImageTiling image_tiling, VkImageLayout image_initial_layout, VkImageUsageFlags image_usage, VkSharingMode image_sharing_mode, VkSampleCountFlagBits image_sample_count, VkMemoryPropertyFlags requested_properties, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count, VkImageCreateFlags image_create_flag_bit)
+    void VulkanDevice::__savePipelineCache()
+    {
+        if (!PipelineCache)
+        {
+            return;
+        }
+
+        size_t                 byte_size = 0;
+        std::vector<std::byte> data      = {};
+        if ((vkGetPipelineCacheData(LogicalDevice, PipelineCache, &byte_size, nullptr) == VK_SUCCESS) && (byte_size > 0))
+        {
+            data.resize(byte_size);
+            if (vkGetPipelineCacheData(LogicalDevice, PipelineCache, &byte_size, data.data()) == VK_SUCCESS)
+            {
+                data.resize(byte_size);
+                auto result = Serializers::PipelineCacheSerializer::Write(PipelineCacheFilename, __pipelineCacheIdentity(), data);
+                if (result != Serializers::AssetContainerResult::SUCCESS)
+                {
+                    ZENGINE_CORE_WARN("Failed to save pipeline cache {} : {}", PipelineCacheFilename, Serializers::AssetContainer::ToString(result))
+                }
+            }
+        }
+
+        ZENGINE_DESTROY_VULKAN_HANDLE(LogicalDevice, vkDestroyPipelineCache, PipelineCache, nullptr)
+    }
+
+    BufferImage VulkanDevice::CreateImage(uint32_t width, uint32_t height, VkImageType image_type, VkImageViewType image_view_type, VkFormat image_format, VkImageTiling image_tiling, VkImageLayout image_initial_layout, VkImageUsageFlags image_usage, VkSharingMode image_sharing_mode, VkSampleCountFlagBits image_sample_count, VkMemoryPropertyFlags requested_properties, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count, VkImageCreateFlags image_create_flag_bit, uint32_t mip_levels)
     {
         BufferImage       buffer_image                 = {};
         VkImageCreateInfo image_create_info            = {};
@@ -725,7 +949,7 @@ namespace ZEngine::Hardwares
         image_create_info.extent.width                 = width;
         image_create_info.extent.height                = height;
         image_create_info.extent.depth                 = 1;
-        image_create_info.mipLevels                    = 1;
+        image_create_info.mipLevels                    = mip_levels;
         image_create_info.arrayLayers                  = layer_count;
         image_create_info.format                       = image_format;
         image_create_info.tiling                       = image_tiling;
@@ -741,7 +965,7 @@ namespace ZEngine::Hardwares
 
         ZENGINE_VALIDATE_ASSERT(vmaCreateImage(VmaAllocator, &image_create_info, &allocation_create_info, &(buffer_image.Handle), &(buffer_image.Allocation), nullptr) == VK_SUCCESS, "Failed to create buffer");
 
-        buffer_image.ViewHandle = CreateImageView(buffer_image.Handle, image_format, image_view_type, image_aspect_flag, layer_count);
+        buffer_image.ViewHandle = CreateImageView(buffer_image.Handle, image_format, image_view_type, image_aspect_flag, layer_count, mip_levels);
         buffer_image.Sampler    = CreateImageSampler();
 
         // Metadata info
@@ -812,7 +1036,20 @@ namespace ZEngine::Hardwares
         return FindSupportedFormat({VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT}, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
     }
 
-    VkImageView VulkanDevice::CreateImageView(VkImage image, VkFormat image_format, VkImageViewType image_view_type, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count)
+    bool VulkanDevice::IsLinearBlitSupported(VkFormat format)
+    {
+        VkFormatProperties   format_properties;
+        VkFormatFeatureFlags required_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        vkGetPhysicalDeviceFormatProperties(PhysicalDevice, format, &format_properties);
+        return (format_properties.optimalTilingFeatures & required_features) == required_features;
+    }
+
+    bool VulkanDevice::IsBlockCompressionSupported() const
+    {
+        return PhysicalDeviceFeature.textureCompressionBC == VK_TRUE;
+    }
+
+    VkImageView VulkanDevice::CreateImageView(VkImage image, VkFormat image_format, VkImageViewType image_view_type, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count, uint32_t mip_levels)
     {
         VkImageView           image_view{VK_NULL_HANDLE};
         VkImageViewCreateInfo image_view_create_info           = {};
@@ -826,7 +1063,7 @@ namespace ZEngine::Hardwares
         image_view_create_info.components.a                    = VK_COMPONENT_SWIZZLE_A;
         image_view_create_info.subresourceRange.aspectMask     = image_aspect_flag;
         image_view_create_info.subresourceRange.baseMipLevel   = 0;
-        image_view_create_info.subresourceRange.levelCount     = 1;
+        image_view_create_info.subresourceRange.levelCount     = mip_levels;
         image_view_create_info.subresourceRange.baseArrayLayer = 0;
         image_view_create_info.subresourceRange.layerCount     = layer_count;
 
@@ -1033,6 +1270,7 @@ namespace ZEngine::Hardwares
         }
 
         m_buffer_manager.ResetPool(CurrentFrameIndex);
+        __retireStaging();
     }
 
     void VulkanDevice::Present()
@@ -1041,6 +1279,11 @@ namespace ZEngine::Hardwares
         Primitives::Semaphore*       render_complete_semaphore = SwapchainRenderCompleteSemaphores[CurrentFrameIndex].get();
         Primitives::Fence*           signal_fence              = SwapchainSignalFences[CurrentFrameIndex].get();
 
+        /*
+         * Uploads recorded during the frame are submitted ahead of it, the graphic queue acquires them before the frame runs
+         */
+        m_transfer_batcher.Flush();
+
         std::vector<VkCommandBuffer> buffer(EnqueuedCommandbufferIndex);
         for (int i = 0; i < EnqueuedCommandbufferIndex; ++i)
         {
@@ -1057,7 +1300,11 @@ namespace ZEngine::Hardwares
         VkPipelineStageFlags stage_flags[]       = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
         VkSubmitInfo         submit_info         = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO, .pNext = nullptr, .waitSemaphoreCount = 1, .pWaitSemaphores = wait_semaphores, .pWaitDstStageMask = stage_flags, .commandBufferCount = (uint32_t) buffer.size(), .pCommandBuffers = buffer.data(), .signalSemaphoreCount = 1, .pSignalSemaphores = signal_semaphores};
 
-        auto                 submit              = vkQueueSubmit(queue, 1, &(submit_info), signal_fence->GetHandle());
+        VkResult submit = VK_SUCCESS;
+        {
+            std::lock_guard l(QueueSubmitMutex);
+            submit = vkQueueSubmit(queue, 1, &(submit_info), signal_fence->GetHandle());
+        }
         ZENGINE_VALIDATE_ASSERT(submit == VK_SUCCESS, "Failed to submit queue")
 
         for (int i = 0; i < EnqueuedCommandbufferIndex; ++i)
@@ -1072,8 +1319,12 @@ namespace ZEngine::Hardwares
         uint32_t         frames[]       = {SwapchainImageIndex};
         VkPresentInfoKHR present_info   = {.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR, .pNext = nullptr, .waitSemaphoreCount = 1, .pWaitSemaphores = signal_semaphores, .swapchainCount = 1, .pSwapchains = swapchains, .pImageIndices = frames};
 
-        VkResult         present_result = vkQueuePresentKHR(queue, &present_info);
-        EnqueuedCommandbufferIndex      = 0;
+        VkResult         present_result = VK_SUCCESS;
+        {
+            std::lock_guard l(QueueSubmitMutex);
+            present_result = vkQueuePresentKHR(queue, &present_info);
+        }
+        EnqueuedCommandbufferIndex = 0;
         acquired_semaphore->SetState(SemaphoreState::Idle);
         render_complete_semaphore->SetState(SemaphoreState::Idle);
 
@@ -1137,111 +1388,34 @@ namespace ZEngine::Hardwares
                 break;
             }
 
-            uint32_t dirty_resource_count = m_dirty_resources.Head();
-            for (uint32_t i = 0; i < dirty_resource_count; ++i)
-            {
-                auto handle = m_dirty_resources.ToHandle(i);
-
-                if (!handle)
-                {
-                    continue;
-                }
-
-                DirtyResource& res_handle = m_dirty_resources[handle];
-                if (res_handle.FrameIndex == CurrentFrameIndex)
-                {
-                    switch (res_handle.Type)
-                    {
-                        case Rendering::DeviceResourceType::SAMPLER:
-                            vkDestroySampler(LogicalDevice, reinterpret_cast<VkSampler>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::FRAMEBUFFER:
-                            vkDestroyFramebuffer(LogicalDevice, reinterpret_cast<VkFramebuffer>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::IMAGEVIEW:
-                            vkDestroyImageView(LogicalDevice, reinterpret_cast<VkImageView>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::IMAGE:
-                            vkDestroyImage(LogicalDevice, reinterpret_cast<VkImage>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::RENDERPASS:
-                            vkDestroyRenderPass(LogicalDevice, reinterpret_cast<VkRenderPass>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::BUFFERMEMORY:
-                            vkFreeMemory(LogicalDevice, reinterpret_cast<VkDeviceMemory>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::BUFFER:
-                            vkDestroyBuffer(LogicalDevice, reinterpret_cast<VkBuffer>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::PIPELINE_LAYOUT:
-                            vkDestroyPipelineLayout(LogicalDevice, reinterpret_cast<VkPipelineLayout>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::PIPELINE:
-                            vkDestroyPipeline(LogicalDevice, reinterpret_cast<VkPipeline>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::DESCRIPTORSETLAYOUT:
-                            vkDestroyDescriptorSetLayout(LogicalDevice, reinterpret_cast<VkDescriptorSetLayout>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::DESCRIPTORPOOL:
-                            vkDestroyDescriptorPool(LogicalDevice, reinterpret_cast<VkDescriptorPool>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::SEMAPHORE:
-                            vkDestroySemaphore(LogicalDevice, reinterpret_cast<VkSemaphore>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::FENCE:
-                            vkDestroyFence(LogicalDevice, reinterpret_cast<VkFence>(res_handle.Handle), nullptr);
-                            break;
-                        case Rendering::DeviceResourceType::DESCRIPTORSET:
-                        {
-                            auto ds = reinterpret_cast<VkDescriptorSet>(res_handle.Handle);
-                            vkFreeDescriptorSets(LogicalDevice, reinterpret_cast<VkDescriptorPool>(res_handle.Data1), 1, &ds);
-                            break;
-                        }
-                    }
-
-                    m_dirty_resources.Remove(handle);
-                }
-            }
-
-            uint32_t dirty_buffer_count = m_dirty_buffers.Head();
-            for (uint32_t i = 0; i < dirty_buffer_count; ++i)
-            {
-                auto handle = m_dirty_buffers.ToHandle(i);
-
-                if (!handle)
-                {
-                    continue;
-                }
-
-                BufferView& buffer = m_dirty_buffers[handle];
-                if (buffer.FrameIndex == CurrentFrameIndex)
+            m_dirty_resources.RemoveIf([this](const DirtyResource& res_handle) {
+                if (res_handle.FrameIndex != CurrentFrameIndex)
                 {
-                    vmaDestroyBuffer(VmaAllocator, buffer.Handle, buffer.Allocation);
-                    m_dirty_buffers.Remove(handle);
+                    return false;
                 }
-            }
+                __destroyDirtyResource(res_handle);
+                return true;
+            });
 
-            uint32_t dirty_buffer_image_count = m_dirty_buffer_images.Head();
-            for (uint32_t i = 0; i < dirty_buffer_image_count; ++i)
-            {
-                auto handle = m_dirty_buffer_images.ToHandle(i);
-
-                if (!handle)
+            m_dirty_buffers.RemoveIf([this](const BufferView& buffer) {
+                if (buffer.FrameIndex != CurrentFrameIndex)
                 {
-                    continue;
+                    return false;
                 }
+                vmaDestroyBuffer(VmaAllocator, buffer.Handle, buffer.Allocation);
+                return true;
+            });
 
-                BufferImage& buffer = m_dirty_buffer_images[handle];
-
-                if (buffer.FrameIndex == CurrentFrameIndex)
+            m_dirty_buffer_images.RemoveIf([this](const BufferImage& buffer) {
+                if (buffer.FrameIndex != CurrentFrameIndex)
                 {
-                    vkDestroyImageView(LogicalDevice, buffer.ViewHandle, nullptr);
-                    vkDestroySampler(LogicalDevice, buffer.Sampler, nullptr);
-                    vmaDestroyImage(VmaAllocator, buffer.Handle, buffer.Allocation);
-
-                    m_dirty_buffer_images.Remove(handle);
+                    return false;
                 }
-            }
+                vkDestroyImageView(LogicalDevice, buffer.ViewHandle, nullptr);
+                vkDestroySampler(LogicalDevice, buffer.Sampler, nullptr);
+                vmaDestroyImage(VmaAllocator, buffer.Handle, buffer.Allocation);
+                return true;
+            });
 
             IdleFrameCount = 0;
         }
@@ -1531,12 +1705,12 @@ namespace ZEngine::Hardwares
         vkCmdPipelineBarrier(m_command_buffer, barrier_spec.SourceStageMask, barrier_spec.DestinationStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier_handle);
     }
 
-    void CommandBuffer::CopyBufferToImage(const Hardwares::BufferView& source, Hardwares::BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageLayout new_layout)
+    void CommandBuffer::CopyBufferToImage(const Hardwares::BufferView& source, Hardwares::BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageLayout new_layout, VkDeviceSize buffer_offset)
     {
         ZENGINE_VALIDATE_ASSERT(m_command_buffer != nullptr, "Command buffer can't be null")
 
         VkBufferImageCopy buffer_image_copy               = {};
-        buffer_image_copy.bufferOffset                    = 0;
+        buffer_image_copy.bufferOffset                    = buffer_offset;
         buffer_image_copy.bufferRowLength                 = 0;
         buffer_image_copy.bufferImageHeight               = 0;
         buffer_image_copy.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -1698,6 +1872,346 @@ namespace ZEngine::Hardwares
         }
     }
 
+    void TransferBatcher::Initialize(VulkanDevice* device)
+    {
+        m_device        = device;
+        m_timeline      = CreateRef<Primitives::Semaphore>(device, Primitives::SemaphoreType::Timeline);
+
+        auto queue_type = device->HasSeperateTransfertQueueFamily ? QueueType::TRANSFER_QUEUE : QueueType::GRAPHIC_QUEUE;
+        for (auto& batch : m_batches)
+        {
+            batch.TransferPool          = CreateRef<Rendering::Pools::CommandPool>(device, queue_type);
+            batch.TransferCommandBuffer = CreateRef<CommandBuffer>(device, batch.TransferPool->Handle, queue_type, true);
+
+            if (device->HasSeperateTransfertQueueFamily)
+            {
+                batch.AcquirePool          = CreateRef<Rendering::Pools::CommandPool>(device, QueueType::GRAPHIC_QUEUE);
+                batch.AcquireCommandBuffer = CreateRef<CommandBuffer>(device, batch.AcquirePool->Handle, QueueType::GRAPHIC_QUEUE, true);
+            }
+        }
+    }
+
+    void TransferBatcher::Deinitialize()
+    {
+        if (!m_timeline)
+        {
+            return;
+        }
+
+        m_timeline->Wait(Flush());
+        for (auto& batch : m_batches)
+        {
+            batch.TransferCommandBuffer.reset();
+            batch.AcquireCommandBuffer.reset();
+            batch.TransferPool.reset();
+            batch.AcquirePool.reset();
+        }
+        m_timeline.reset();
+    }
+
+    uint64_t TransferBatcher::EnqueueBufferCopy(const BufferView& source, const BufferView& destination, std::span<const VkBufferCopy> regions)
+    {
+        if (regions.empty() || !source || !destination)
+        {
+            return 0;
+        }
+
+        std::lock_guard l(m_mutex);
+        auto&           batch = OpenBatch();
+        vkCmdCopyBuffer(batch.TransferCommandBuffer->GetHandle(), source.Handle, destination.Handle, static_cast<uint32_t>(regions.size()), regions.data());
+
+        /*
+         * Buffers are CONCURRENT between the families (see VulkanDevice::CreateBuffer) : no ownership transfer, only the write
+         * availability here and its visibility on the graphic queue
+         */
+        batch.BufferBarriers.push_back(VkBufferMemoryBarrier{
+            .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .pNext               = nullptr,
+            .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask       = VK_ACCESS_MEMORY_READ_BIT,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer              = destination.Handle,
+            .offset              = 0,
+            .size                = VK_WHOLE_SIZE,
+        });
+        return batch.Value;
+    }
+
+    uint64_t TransferBatcher::EnqueueImageCopy(const BufferView& source, VkDeviceSize source_offset, BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageAspectFlagBits aspect, VkImageLayout final_layout, uint32_t mip_levels, std::span<const VkDeviceSize> level_offsets)
+    {
+        if (!source || !destination.Handle)
+        {
+            return 0;
+        }
+
+        mip_levels             = std::max(mip_levels, 1u);
+        uint32_t source_levels = std::clamp(static_cast<uint32_t>(level_offsets.size()), 1u, mip_levels);
+
+        std::lock_guard         l(m_mutex);
+        auto&                   batch            = OpenBatch();
+        auto                    command_buffer   = batch.TransferCommandBuffer.get();
+        VkImageSubresourceRange subresource      = {.aspectMask = static_cast<VkImageAspectFlags>(aspect), .baseMipLevel = 0, .levelCount = mip_levels, .baseArrayLayer = 0, .layerCount = layer_count};
+
+        VkImageMemoryBarrier    to_transfer      = {};
+        to_transfer.sType                        = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        to_transfer.srcAccessMask                = VK_ACCESS_NONE;
+        to_transfer.dstAccessMask                = VK_ACCESS_TRANSFER_WRITE_BIT;
+        to_transfer.oldLayout                    = VK_IMAGE_LAYOUT_UNDEFINED;
+        to_transfer.newLayout                    = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        to_transfer.srcQueueFamilyIndex          = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.dstQueueFamilyIndex          = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.image                        = destination.Handle;
+        to_transfer.subresourceRange             = subresource;
+        vkCmdPipelineBarrier(command_buffer->GetHandle(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &to_transfer);
+
+        std::vector<VkBufferImageCopy> regions(source_levels);
+        for (uint32_t level = 0; level < source_levels; ++level)
+        {
+            regions[level].bufferOffset      = source_offset + (level_offsets.empty() ? 0 : level_offsets[level]);
+            regions[level].bufferRowLength   = 0;
+            regions[level].bufferImageHeight = 0;
+            regions[level].imageSubresource  = {.aspectMask = static_cast<VkImageAspectFlags>(aspect), .mipLevel = level, .baseArrayLayer = 0, .layerCount = layer_count};
+            regions[level].imageOffset       = {0, 0, 0};
+            regions[level].imageExtent       = {std::max(width >> level, 1u), std::max(height >> level, 1u), 1};
+        }
+        vkCmdCopyBufferToImage(command_buffer->GetHandle(), source.Handle, destination.Handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, source_levels, regions.data());
+
+        bool                 separate_family = m_device->HasSeperateTransfertQueueFamily;
+        VkImageMemoryBarrier to_final        = to_transfer;
+        to_final.srcAccessMask               = VK_ACCESS_TRANSFER_WRITE_BIT;
+        to_final.dstAccessMask               = (final_layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) ? (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT) : VK_ACCESS_SHADER_READ_BIT;
+        to_final.oldLayout                   = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        to_final.newLayout                   = final_layout;
+        to_final.srcQueueFamilyIndex         = separate_family ? m_device->TransferFamilyIndex : VK_QUEUE_FAMILY_IGNORED;
+        to_final.dstQueueFamilyIndex         = separate_family ? m_device->GraphicFamilyIndex : VK_QUEUE_FAMILY_IGNORED;
+
+        if (source_levels < mip_levels)
+        {
+            MipBlit blit = {.Image = destination.Handle, .Width = width, .Height = height, .LayerCount = layer_count, .Aspect = aspect, .FirstLevel = source_levels, .LevelCount = mip_levels, .FinalLayout = final_layout};
+            if (separate_family)
+            {
+                /*
+                 * Transfer queues can't blit : the image changes hands as it is, the chain and the final layout are recorded by the
+                 * graphic queue after the acquire
+                 */
+                to_final.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+                to_final.newLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                batch.MipBlits.push_back(blit);
+            }
+            else
+            {
+                RecordMipBlits(command_buffer->GetHandle(), blit);
+                to_final.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            }
+        }
+        batch.ImageBarriers.push_back(to_final);
+        return batch.Value;
+    }
+
+    void TransferBatcher::RecordMipBlits(VkCommandBuffer command_buffer, const MipBlit& blit)
+    {
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask        = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.oldLayout            = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout            = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                = blit.Image;
+        barrier.subresourceRange     = {.aspectMask = static_cast<VkImageAspectFlags>(blit.Aspect), .baseMipLevel = 0, .levelCount = blit.FirstLevel, .baseArrayLayer = 0, .layerCount = blit.LayerCount};
+
+        /*
+         * The uploaded levels become sources at once, then each generated level once it is written
+         */
+        for (uint32_t level = blit.FirstLevel; level <= blit.LevelCount; ++level)
+        {
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+            if (level == blit.LevelCount)
+            {
+                break;
+            }
+
+            int32_t     source_width              = static_cast<int32_t>(std::max(blit.Width >> (level - 1), 1u));
+            int32_t     source_height             = static_cast<int32_t>(std::max(blit.Height >> (level - 1), 1u));
+            int32_t     destination_width         = static_cast<int32_t>(std::max(blit.Width >> level, 1u));
+            int32_t     destination_height        = static_cast<int32_t>(std::max(blit.Height >> level, 1u));
+
+            VkImageBlit region                    = {};
+            region.srcSubresource                 = {.aspectMask = static_cast<VkImageAspectFlags>(blit.Aspect), .mipLevel = level - 1, .baseArrayLayer = 0, .layerCount = blit.LayerCount};
+            region.srcOffsets[1]                  = {source_width, source_height, 1};
+            region.dstSubresource                 = {.aspectMask = static_cast<VkImageAspectFlags>(blit.Aspect), .mipLevel = level, .baseArrayLayer = 0, .layerCount = blit.LayerCount};
+            region.dstOffsets[1]                  = {destination_width, destination_height, 1};
+            vkCmdBlitImage(command_buffer, blit.Image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, blit.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region, VK_FILTER_LINEAR);
+
+            barrier.subresourceRange.baseMipLevel = level;
+            barrier.subresourceRange.levelCount   = 1;
+        }
+    }
+
+    uint64_t TransferBatcher::Flush()
+    {
+        std::lock_guard l(m_mutex);
+        return SubmitOpenBatch();
+    }
+
+    uint64_t TransferBatcher::GetCompletedValue() const
+    {
+        return m_timeline ? m_timeline->GetValue() : 0;
+    }
+
+    bool TransferBatcher::IsComplete(uint64_t token) const
+    {
+        return (token == 0) || (token <= GetCompletedValue());
+    }
+
+    bool TransferBatcher::Wait(uint64_t token)
+    {
+        if (IsComplete(token))
+        {
+            return true;
+        }
+
+        {
+            std::lock_guard l(m_mutex);
+            if (m_is_open && (token >= m_batches[m_open_batch].Value))
+            {
+                SubmitOpenBatch();
+            }
+        }
+        return m_timeline->Wait(token);
+    }
+
+    TransferBatcher::Batch& TransferBatcher::OpenBatch()
+    {
+        auto& batch = m_batches[m_open_batch];
+        if (m_is_open)
+        {
+            return batch;
+        }
+
+        /*
+         * The slot was last submitted MaxBatchInFlight batches ago, its command buffers are reusable once that batch completed
+         */
+        if (batch.Value)
+        {
+            m_timeline->Wait(batch.Value);
+        }
+
+        vkResetCommandPool(m_device->LogicalDevice, batch.TransferPool->Handle, 0);
+        batch.TransferCommandBuffer->ResetState();
+        batch.TransferCommandBuffer->Begin();
+        if (batch.AcquirePool)
+        {
+            vkResetCommandPool(m_device->LogicalDevice, batch.AcquirePool->Handle, 0);
+            batch.AcquireCommandBuffer->ResetState();
+        }
+
+        batch.BufferBarriers.clear();
+        batch.ImageBarriers.clear();
+        batch.MipBlits.clear();
+        batch.Value = m_submitted_value + 1;
+        m_is_open   = true;
+        return batch;
+    }
+
+    uint64_t TransferBatcher::SubmitOpenBatch()
+    {
+        if (!m_is_open)
+        {
+            return m_submitted_value;
+        }
+
+        auto&                              batch           = m_batches[m_open_batch];
+        bool                               separate_family = m_device->HasSeperateTransfertQueueFamily;
+        std::vector<VkBufferMemoryBarrier> buffer_barriers = batch.BufferBarriers;
+        std::vector<VkImageMemoryBarrier>  image_barriers  = batch.ImageBarriers;
+
+        /*
+         * Same family : one barrier makes the writes visible to the frames submitted after the batch.
+         * Separate families : the release half of the image transfers and the buffer writes availability here, dstAccessMask is ignored
+         */
+        if (separate_family)
+        {
+            for (auto& barrier : buffer_barriers)
+            {
+                barrier.dstAccessMask = VK_ACCESS_NONE;
+            }
+            for (auto& barrier : image_barriers)
+            {
+                barrier.dstAccessMask = VK_ACCESS_NONE;
+            }
+        }
+
+        VkPipelineStageFlags release_stage = separate_family ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        vkCmdPipelineBarrier(batch.TransferCommandBuffer->GetHandle(), VK_PIPELINE_STAGE_TRANSFER_BIT, release_stage, 0, 0, nullptr, static_cast<uint32_t>(buffer_barriers.size()), buffer_barriers.data(), static_cast<uint32_t>(image_barriers.size()), image_barriers.data());
+        batch.TransferCommandBuffer->End();
+
+        VkSemaphore                   timeline_handle = m_timeline->GetHandle();
+        VkCommandBuffer               transfer_buffer = batch.TransferCommandBuffer->GetHandle();
+        VkTimelineSemaphoreSubmitInfo transfer_values = {.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO, .pNext = nullptr, .waitSemaphoreValueCount = 0, .pWaitSemaphoreValues = nullptr, .signalSemaphoreValueCount = 1, .pSignalSemaphoreValues = &batch.Value};
+        VkSubmitInfo                  transfer_submit = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO, .pNext = &transfer_values, .waitSemaphoreCount = 0, .pWaitSemaphores = nullptr, .pWaitDstStageMask = nullptr, .commandBufferCount = 1, .pCommandBuffers = &transfer_buffer, .signalSemaphoreCount = 1, .pSignalSemaphores = &timeline_handle};
+
+        {
+            std::lock_guard l(m_device->QueueSubmitMutex);
+            auto            queue_type = separate_family ? QueueType::TRANSFER_QUEUE : QueueType::GRAPHIC_QUEUE;
+            ZENGINE_VALIDATE_ASSERT(vkQueueSubmit(m_device->GetQueue(queue_type).Handle, 1, &transfer_submit, VK_NULL_HANDLE) == VK_SUCCESS, "Failed to submit transfer batch")
+        }
+        batch.TransferCommandBuffer->SetState(CommanBufferState::Pending);
+
+        /*
+         * Acquire half on the graphic queue, waiting for the batch : the frames submitted after it see the uploads. The barriers
+         * start at the semaphore wait stage so they chain with the wait
+         */
+        if (separate_family)
+        {
+            for (auto& barrier : batch.BufferBarriers)
+            {
+                barrier.srcAccessMask = VK_ACCESS_NONE;
+            }
+            for (auto& barrier : batch.ImageBarriers)
+            {
+                barrier.srcAccessMask = VK_ACCESS_NONE;
+            }
+
+            auto acquire_command_buffer = batch.AcquireCommandBuffer.get();
+            acquire_command_buffer->Begin();
+            vkCmdPipelineBarrier(acquire_command_buffer->GetHandle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, static_cast<uint32_t>(batch.BufferBarriers.size()), batch.BufferBarriers.data(), static_cast<uint32_t>(batch.ImageBarriers.size()), batch.ImageBarriers.data());
+            for (const auto& blit : batch.MipBlits)
+            {
+                RecordMipBlits(acquire_command_buffer->GetHandle(), blit);
+
+                VkImageMemoryBarrier to_final = {};
+                to_final.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                to_final.srcAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+                to_final.dstAccessMask        = (blit.FinalLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) ? (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT) : VK_ACCESS_SHADER_READ_BIT;
+                to_final.oldLayout            = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                to_final.newLayout            = blit.FinalLayout;
+                to_final.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+                to_final.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+                to_final.image                = blit.Image;
+                to_final.subresourceRange     = {.aspectMask = static_cast<VkImageAspectFlags>(blit.Aspect), .baseMipLevel = 0, .levelCount = blit.LevelCount, .baseArrayLayer = 0, .layerCount = blit.LayerCount};
+                vkCmdPipelineBarrier(acquire_command_buffer->GetHandle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &to_final);
+            }
+            acquire_command_buffer->End();
+
+            VkCommandBuffer               acquire_buffer = acquire_command_buffer->GetHandle();
+            VkPipelineStageFlags          wait_stage     = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            VkTimelineSemaphoreSubmitInfo acquire_values = {.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO, .pNext = nullptr, .waitSemaphoreValueCount = 1, .pWaitSemaphoreValues = &batch.Value, .signalSemaphoreValueCount = 0, .pSignalSemaphoreValues = nullptr};
+            VkSubmitInfo                  acquire_submit = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO, .pNext = &acquire_values, .waitSemaphoreCount = 1, .pWaitSemaphores = &timeline_handle, .pWaitDstStageMask = &wait_stage, .commandBufferCount = 1, .pCommandBuffers = &acquire_buffer, .signalSemaphoreCount = 0, .pSignalSemaphores = nullptr};
+
+            std::lock_guard               l(m_device->QueueSubmitMutex);
+            ZENGINE_VALIDATE_ASSERT(vkQueueSubmit(m_device->GetQueue(QueueType::GRAPHIC_QUEUE).Handle, 1, &acquire_submit, VK_NULL_HANDLE) == VK_SUCCESS, "Failed to submit transfer acquire")
+            acquire_command_buffer->SetState(CommanBufferState::Pending);
+        }
+
+        m_submitted_value = batch.Value;
+        m_is_open         = false;
+        m_open_batch      = (m_open_batch + 1) % MaxBatchInFlight;
+        return m_submitted_value;
+    }
+
     void VertexBuffer::SetData(const void* data, size_t byte_size)
     {
 
@@ -1732,20 +2246,18 @@ namespace ZEngine::Hardwares
         }
         else
         {
-            BufferView        staging_buffer  = m_device->CreateBuffer(static_cast<VkDeviceSize>(this->m_byte_size), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
-
-            VmaAllocationInfo allocation_info = {};
-            vmaGetAllocationInfo(m_device->VmaAllocator, staging_buffer.Allocation, &allocation_info);
+            StagingAllocation staging        = m_device->AllocateStaging(static_cast<VkDeviceSize>(this->m_byte_size));
+            uint64_t          transfer_token = 0;
 
-            if (data && allocation_info.pMappedData)
+            if (data && staging)
             {
-                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
-                ZENGINE_VALIDATE_ASSERT(vmaFlushAllocation(m_device->VmaAllocator, staging_buffer.Allocation, 0, static_cast<VkDeviceSize>(this->m_byte_size)) == VK_SUCCESS, "Failed to flush allocation")
-                m_device->CopyBuffer(staging_buffer, m_vertex_buffer, static_cast<VkDeviceSize>(this->m_byte_size));
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(staging.Data, staging.ByteSize, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                m_device->FlushStaging(staging);
+                transfer_token = m_device->CopyBuffer(staging.Buffer, m_vertex_buffer, static_cast<VkDeviceSize>(this->m_byte_size), staging.Offset);
             }
 
             /* Cleanup resource */
-            m_device->EnqueueBufferForDeletion(staging_buffer);
+            m_device->ReleaseStaging(staging, transfer_token);
         }
     }
 
@@ -1786,25 +2298,103 @@ namespace ZEngine::Hardwares
             vmaGetAllocationInfo(m_device->VmaAllocator, m_storage_buffer.Allocation, &allocation_info);
             if (data && allocation_info.pMappedData)
             {
-                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
             }
         }
         else
         {
-            BufferView        staging_buffer  = m_device->CreateBuffer(static_cast<VkDeviceSize>(this->m_byte_size), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+            StagingAllocation staging        = m_device->AllocateStaging(static_cast<VkDeviceSize>(byte_size));
+            uint64_t          transfer_token = 0;
+
+            if (data && staging)
+            {
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(staging.Data, staging.ByteSize, data, byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                m_device->FlushStaging(staging);
+                transfer_token = m_device->CopyBuffer(staging.Buffer, m_storage_buffer, static_cast<VkDeviceSize>(byte_size), staging.Offset);
+            }
+
+            /* Cleanup resource */
+            m_device->ReleaseStaging(staging, transfer_token);
+        }
+    }
+
+    void StorageBuffer::SetSubData(const void* data, size_t data_byte_size, std::span<const Helpers::BufferRange> ranges)
+    {
+        if (!data || ranges.empty() || !m_storage_buffer)
+        {
+            return;
+        }
+
+        auto          source        = static_cast<const uint8_t*>(data);
+        const size_t  writable_size = std::min(data_byte_size, this->m_byte_size);
 
+        VkMemoryPropertyFlags mem_prop_flags;
+        vmaGetAllocationMemoryProperties(m_device->VmaAllocator, m_storage_buffer.Allocation, &mem_prop_flags);
+
+        if (mem_prop_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
             VmaAllocationInfo allocation_info = {};
-            vmaGetAllocationInfo(m_device->VmaAllocator, staging_buffer.Allocation, &allocation_info);
+            vmaGetAllocationInfo(m_device->VmaAllocator, m_storage_buffer.Allocation, &allocation_info);
+            if (!allocation_info.pMappedData)
+            {
+                return;
+            }
 
-            if (data && allocation_info.pMappedData)
+            auto destination = static_cast<uint8_t*>(allocation_info.pMappedData);
+            for (const auto& range : ranges)
             {
-                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
-                ZENGINE_VALIDATE_ASSERT(vmaFlushAllocation(m_device->VmaAllocator, staging_buffer.Allocation, 0, static_cast<VkDeviceSize>(this->m_byte_size)) == VK_SUCCESS, "Failed to flush allocation")
-                m_device->CopyBuffer(staging_buffer, m_storage_buffer, static_cast<VkDeviceSize>(this->m_byte_size));
+                if (range.Offset >= writable_size)
+                {
+                    break;
+                }
+
+                size_t byte_size = std::min(range.End(), writable_size) - range.Offset;
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(destination + range.Offset, allocation_info.size - range.Offset, source + range.Offset, byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                vmaFlushAllocation(m_device->VmaAllocator, m_storage_buffer.Allocation, static_cast<VkDeviceSize>(range.Offset), static_cast<VkDeviceSize>(byte_size));
+            }
+        }
+        else
+        {
+            /*
+             * Ranges are packed back to back in the staging buffer and scattered by one vkCmdCopyBuffer
+             */
+            std::vector<VkBufferCopy> regions;
+            regions.reserve(ranges.size());
+            VkDeviceSize staging_size = 0;
+            for (const auto& range : ranges)
+            {
+                if (range.Offset >= writable_size)
+                {
+                    break;
+                }
+
+                VkDeviceSize byte_size = static_cast<VkDeviceSize>(std::min(range.End(), writable_size) - range.Offset);
+                regions.push_back(VkBufferCopy{.srcOffset = staging_size, .dstOffset = static_cast<VkDeviceSize>(range.Offset), .size = byte_size});
+                staging_size += byte_size;
+            }
+
+            if (regions.empty())
+            {
+                return;
+            }
+
+            StagingAllocation staging        = m_device->AllocateStaging(staging_size);
+            uint64_t          transfer_token = 0;
+
+            if (staging)
+            {
+                auto destination = static_cast<uint8_t*>(staging.Data);
+                for (auto& region : regions)
+                {
+                    ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(destination + region.srcOffset, staging.ByteSize - region.srcOffset, source + region.dstOffset, region.size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                    region.srcOffset += staging.Offset;
+                }
+                m_device->FlushStaging(staging);
+                transfer_token = m_device->CopyBuffer(staging.Buffer, m_storage_buffer, regions);
             }
 
             /* Cleanup resource */
-            m_device->EnqueueBufferForDeletion(staging_buffer);
+            m_device->ReleaseStaging(staging, transfer_token);
         }
     }
 
@@ -1851,20 +2441,18 @@ namespace ZEngine::Hardwares
         }
         else
         {
-            BufferView        staging_buffer  = m_device->CreateBuffer(static_cast<VkDeviceSize>(this->m_byte_size), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
-
-            VmaAllocationInfo allocation_info = {};
-            vmaGetAllocationInfo(m_device->VmaAllocator, staging_buffer.Allocation, &allocation_info);
+            StagingAllocation staging        = m_device->AllocateStaging(static_cast<VkDeviceSize>(this->m_byte_size));
+            uint64_t          transfer_token = 0;
 
-            if (data && allocation_info.pMappedData)
+            if (data && staging)
             {
-                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
-                ZENGINE_VALIDATE_ASSERT(vmaFlushAllocation(m_device->VmaAllocator, staging_buffer.Allocation, 0, static_cast<VkDeviceSize>(this->m_byte_size)) == VK_SUCCESS, "Failed to flush allocation")
-                m_device->CopyBuffer(staging_buffer, m_index_buffer, static_cast<VkDeviceSize>(this->m_byte_size));
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(staging.Data, staging.ByteSize, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                m_device->FlushStaging(staging);
+                transfer_token = m_device->CopyBuffer(staging.Buffer, m_index_buffer, static_cast<VkDeviceSize>(this->m_byte_size), staging.Offset);
             }
 
             /* Cleanup resource */
-            m_device->EnqueueBufferForDeletion(staging_buffer);
+            m_device->ReleaseStaging(staging, transfer_token);
         }
     }
 
@@ -1879,6 +2467,10 @@ namespace ZEngine::Hardwares
 
     void IndirectBuffer::SetData(const VkDrawIndirectCommand* data, size_t byte_size)
     {
+        /*
+         * The command list can shrink from a frame to the next (e.g culling), the buffer is kept and only the count changes
+         */
+        m_command_count = byte_size / sizeof(VkDrawIndirectCommand);
         if (byte_size == 0)
         {
             return;
@@ -1906,25 +2498,23 @@ namespace ZEngine::Hardwares
             vmaGetAllocationInfo(m_device->VmaAllocator, m_indirect_buffer.Allocation, &allocation_info);
             if (data && allocation_info.pMappedData)
             {
-                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
             }
         }
         else
         {
-            BufferView        staging_buffer  = m_device->CreateBuffer(static_cast<VkDeviceSize>(this->m_byte_size), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
-
-            VmaAllocationInfo allocation_info = {};
-            vmaGetAllocationInfo(m_device->VmaAllocator, staging_buffer.Allocation, &allocation_info);
+            StagingAllocation staging        = m_device->AllocateStaging(static_cast<VkDeviceSize>(byte_size));
+            uint64_t          transfer_token = 0;
 
-            if (data && allocation_info.pMappedData)
+            if (data && staging)
             {
-                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(allocation_info.pMappedData, allocation_info.size, data, this->m_byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
-                ZENGINE_VALIDATE_ASSERT(vmaFlushAllocation(m_device->VmaAllocator, staging_buffer.Allocation, 0, VK_WHOLE_SIZE) == VK_SUCCESS, "Failed to flush allocation")
-                m_device->CopyBuffer(staging_buffer, m_indirect_buffer, static_cast<VkDeviceSize>(this->m_byte_size));
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(staging.Data, staging.ByteSize, data, byte_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                m_device->FlushStaging(staging);
+                transfer_token = m_device->CopyBuffer(staging.Buffer, m_indirect_buffer, static_cast<VkDeviceSize>(byte_size), staging.Offset);
             }
 
             /* Cleanup resource */
-            m_device->EnqueueBufferForDeletion(staging_buffer);
+            m_device->ReleaseStaging(staging, transfer_token);
         }
     }
 
@@ -1998,7 +2588,7 @@ namespace ZEngine::Hardwares
             image_create_flag = Specifications::ImageCreateFlag::CUBE_COMPATIBLE_BIT;
         }
 
-        m_buffer_image = m_device->CreateImage(m_width, m_height, VK_IMAGE_TYPE_2D, Specifications::ImageViewTypeMap[VALUE_FROM_SPEC_MAP(image_view_type)], spec.ImageFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_LAYOUT_UNDEFINED, spec.ImageUsage, VK_SHARING_MODE_EXCLUSIVE, VK_SAMPLE_COUNT_1_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, spec.ImageAspectFlag, spec.LayerCount, Specifications::ImageCreateFlagMap[VALUE_FROM_SPEC_MAP(image_create_flag)]);
+        m_buffer_image = m_device->CreateImage(m_width, m_height, VK_IMAGE_TYPE_2D, Specifications::ImageViewTypeMap[VALUE_FROM_SPEC_MAP(image_view_type)], spec.ImageFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_LAYOUT_UNDEFINED, spec.ImageUsage, VK_SHARING_MODE_EXCLUSIVE, VK_SAMPLE_COUNT_1_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, spec.ImageAspectFlag, spec.LayerCount, Specifications::ImageCreateFlagMap[VALUE_FROM_SPEC_MAP(image_create_flag)], spec.MipLevels);
     }
 
     Image2DBuffer::~Image2DBuffer()
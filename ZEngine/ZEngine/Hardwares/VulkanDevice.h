@@ -6,8 +6,11 @@
  * ^^^^ Headers above are not candidates for sorting by clang-format ^^^^^
  */
 #include <Hardwares/VulkanLayer.h>
+#include <Helpers/BufferRangeTracker.h>
 #include <Helpers/HandleManager.h>
+#include <Helpers/LockFreeQueue.h>
 #include <Helpers/MemoryOperations.h>
+#include <Helpers/StagingRingAllocator.h>
 #include <Helpers/ThreadSafeQueue.h>
 #include <Primitives/Fence.h>
 #include <Primitives/Semaphore.h>
@@ -16,7 +19,10 @@
 #include <Rendering/ResourceTypes.h>
 #include <Rendering/Specifications/TextureSpecification.h>
 #include <Rendering/Textures/Texture.h>
+#include <Serializers/PipelineCacheSerializer.h>
+#include <array>
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace ZEngine::Windows
@@ -61,6 +67,24 @@ namespace ZEngine::Hardwares
         }
     };
 
+    /*
+     * Upload space handed out by VulkanDevice::AllocateStaging : a slice of the staging ring, or a dedicated buffer when the
+     * payload is too large for the ring or the ring is full
+     */
+    struct StagingAllocation
+    {
+        BufferView   Buffer    = {};
+        VkDeviceSize Offset    = 0;
+        VkDeviceSize ByteSize  = 0;
+        void*        Data      = nullptr;
+        bool         Dedicated = false;
+
+        operator bool() const
+        {
+            return (Data != nullptr);
+        }
+    };
+
     struct BufferImage
     {
         uint8_t       FrameIndex{std::numeric_limits<uint8_t>::max()};
@@ -110,7 +134,7 @@ namespace ZEngine::Hardwares
     template <typename T, typename = std::enable_if_t<std::is_base_of_v<IGraphicBuffer, T>>>
     struct IBufferSet : public Helpers::RefCounted
     {
-        IBufferSet(Hardwares::VulkanDevice* device, uint32_t count = 0)
+        IBufferSet(Hardwares::VulkanDevice* device, uint32_t count = 0) : m_dirty_ranges(count), m_synced_byte_sizes(count, 0)
         {
             for (int i = 0; i < count; ++i)
             {
@@ -146,6 +170,59 @@ namespace ZEngine::Hardwares
             }
         }
 
+        /*
+         * Records that [offset, offset + byte_size) of the source data changed, the region becomes stale for every frame slot
+         */
+        void MarkDirty(size_t offset, size_t byte_size)
+        {
+            m_dirty_ranges.MarkDirty(offset, byte_size);
+        }
+
+        template <typename K>
+        void MarkElementsDirty(size_t first_element, size_t element_count)
+        {
+            m_dirty_ranges.MarkDirty(first_element * sizeof(K), element_count * sizeof(K));
+        }
+
+        void MarkAllDirty()
+        {
+            m_dirty_ranges.MarkAllDirty();
+        }
+
+        /*
+         * Brings the buffer of the given frame slot up to date with data, copying only the ranges that are stale for that slot.
+         * Falls back to a full SetData() on the first upload or when the data size changed.
+         */
+        template <typename K>
+        void SyncData(uint32_t index, std::span<const K> data)
+        {
+            ZENGINE_VALIDATE_ASSERT(index < m_set.size(), "Index out of range")
+
+            if constexpr (std::is_same_v<T, StorageBuffer>)
+            {
+                if (m_dirty_ranges.IsFullyDirty(index) || (m_synced_byte_sizes[index] != data.size_bytes()))
+                {
+                    m_set[index].template SetData<K>(data);
+                }
+                else if (m_dirty_ranges.HasPendingChanges(index))
+                {
+                    m_set[index].SetSubData(data.data(), data.size_bytes(), m_dirty_ranges.GetRanges(index));
+                }
+
+                m_synced_byte_sizes[index] = data.size_bytes();
+                m_dirty_ranges.Consume(index);
+            }
+            else
+            {
+                SetData<K>(index, data);
+            }
+        }
+
+        Helpers::BufferRangeTracker& DirtyRanges()
+        {
+            return m_dirty_ranges;
+        }
+
         const std::vector<T>& Data() const
         {
             return m_set;
@@ -159,7 +236,9 @@ namespace ZEngine::Hardwares
         void Dispose() {}
 
     protected:
-        std::vector<T> m_set;
+        std::vector<T>              m_set;
+        Helpers::BufferRangeTracker m_dirty_ranges;
+        std::vector<size_t>         m_synced_byte_sizes;
     };
 
     class VertexBuffer : public IGraphicBuffer
@@ -230,6 +309,12 @@ namespace ZEngine::Hardwares
             SetData(content.data(), 0, content.size_bytes());
         }
 
+        /*
+         * Updates the given ranges of an already allocated buffer in place, data and ranges share the same byte addressing.
+         * Device-local buffers go through a single staging buffer and a single multi-region copy.
+         */
+        void SetSubData(const void* data, size_t data_byte_size, std::span<const Helpers::BufferRange> ranges);
+
         ~StorageBuffer()
         {
             CleanUpMemory();
@@ -596,7 +681,7 @@ namespace ZEngine::Hardwares
         void                              DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
         void                              Draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_index, uint32_t first_instance);
         void                              TransitionImageLayout(const Rendering::Primitives::ImageMemoryBarrier& image_barrier);
-        void                              CopyBufferToImage(const Hardwares::BufferView& source, Hardwares::BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageLayout new_layout);
+        void                              CopyBufferToImage(const Hardwares::BufferView& source, Hardwares::BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageLayout new_layout, VkDeviceSize buffer_offset = 0);
         void                              BindVertexBuffer(const Hardwares::VertexBuffer& buffer);
         void                              BindIndexBuffer(const Hardwares::IndexBuffer& buffer, VkIndexType type);
         void                              SetScissor(const VkRect2D& scissor);
@@ -640,6 +725,88 @@ namespace ZEngine::Hardwares
         Helpers::Ref<Rendering::Primitives::Fence>     m_instant_fence;
     };
 
+    /*
+     * Uploads recorded by any thread into the open batch and submitted together by Flush, instead of one waited instant submission
+     * each. Every batch signals the next value of a timeline semaphore : the value returned when recording is the completion token.
+     * With a dedicated transfer queue the batch releases the images it wrote to the graphic queue family, and a graphic submission
+     * waiting on the batch value acquires them, so the frame submitted after the flush sees the uploads. Images are always uploaded
+     * whole from UNDEFINED, so one already owned by the graphic family needs no transfer back. Buffers take partial writes and are
+     * created CONCURRENT instead : the same submission only makes their writes visible.
+     */
+    struct TransferBatcher
+    {
+        static constexpr uint32_t MaxBatchInFlight = 4;
+
+        void                      Initialize(VulkanDevice* device);
+        void                      Deinitialize();
+        uint64_t                  EnqueueBufferCopy(const BufferView& source, const BufferView& destination, std::span<const VkBufferCopy> regions);
+        /*
+         * Whole image upload, from UNDEFINED to final_layout, the previous content is discarded. The mip levels missing from the
+         * source are blitted down from the last one it holds, on the graphic queue : in the batch itself when it runs there, on the
+         * acquire side of the ownership transfer otherwise
+         */
+        uint64_t                  EnqueueImageCopy(const BufferView& source, VkDeviceSize source_offset, BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageAspectFlagBits aspect, VkImageLayout final_layout, uint32_t mip_levels = 1U, std::span<const VkDeviceSize> level_offsets = {});
+        /*
+         * Submits the open batch, returns the token of the last submitted batch
+         */
+        uint64_t                  Flush();
+        uint64_t                  GetCompletedValue() const;
+        bool                      IsComplete(uint64_t token) const;
+        /*
+         * Flushes the batch holding token if it is still open, then waits for it
+         */
+        bool                      Wait(uint64_t token);
+
+    private:
+        struct MipBlit
+        {
+            VkImage               Image       = VK_NULL_HANDLE;
+            uint32_t              Width       = 0;
+            uint32_t              Height      = 0;
+            uint32_t              LayerCount  = 1;
+            VkImageAspectFlagBits Aspect      = VK_IMAGE_ASPECT_COLOR_BIT;
+            /*
+             * Levels [FirstLevel, LevelCount) are generated, each from the previous one
+             */
+            uint32_t              FirstLevel  = 1;
+            uint32_t              LevelCount  = 1;
+            VkImageLayout         FinalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        };
+
+        struct Batch
+        {
+            Helpers::Ref<Rendering::Pools::CommandPool> TransferPool          = nullptr;
+            Helpers::Ref<CommandBuffer>                 TransferCommandBuffer = nullptr;
+            Helpers::Ref<Rendering::Pools::CommandPool> AcquirePool           = nullptr;
+            Helpers::Ref<CommandBuffer>                 AcquireCommandBuffer  = nullptr;
+            /*
+             * Transfer write to first use of every destination, split in release and acquire halves between queue families
+             */
+            std::vector<VkBufferMemoryBarrier>          BufferBarriers        = {};
+            std::vector<VkImageMemoryBarrier>           ImageBarriers         = {};
+            /*
+             * Mip chains recorded after the acquire barriers, when the transfer queue can't blit
+             */
+            std::vector<MipBlit>                        MipBlits              = {};
+            uint64_t                                    Value                 = 0;
+        };
+
+        VulkanDevice*                                   m_device{nullptr};
+        Helpers::Ref<Rendering::Primitives::Semaphore>  m_timeline;
+        std::array<Batch, MaxBatchInFlight>             m_batches;
+        uint32_t                                        m_open_batch{0};
+        bool                                            m_is_open{false};
+        uint64_t                                        m_submitted_value{0};
+        std::mutex                                      m_mutex;
+
+        Batch&                                          OpenBatch();
+        uint64_t                                        SubmitOpenBatch();
+        /*
+         * Leaves every level of the image in TRANSFER_SRC_OPTIMAL, the levels before FirstLevel being in TRANSFER_DST_OPTIMAL
+         */
+        static void                                     RecordMipBlits(VkCommandBuffer command_buffer, const MipBlit& blit);
+    };
+
     struct WriteDescriptorSetRequestKey
     {
         uint32_t        Binding = 0;
@@ -670,6 +837,12 @@ namespace ZEngine::Hardwares
      */
     struct VulkanDevice
     {
+        static constexpr uint32_t                                    MaxBindlessTextureCount            = 16384;
+        /*
+         * Sampled images a shader stage declares beside its bindless table
+         */
+        static constexpr uint32_t                                    ReservedSampledImageCount          = 16;
+
         bool                                                         HasSeperateTransfertQueueFamily    = false;
         uint32_t                                                     SwapchainImageIndex                = std::numeric_limits<uint8_t>::max();
         uint32_t                                                     CurrentFrameIndex                  = std::numeric_limits<uint8_t>::max();
@@ -692,6 +865,11 @@ namespace ZEngine::Hardwares
         VkPhysicalDeviceMemoryProperties                             PhysicalDeviceMemoryProperties     = {};
         VkSwapchainKHR                                               SwapchainHandle                    = VK_NULL_HANDLE;
         VmaAllocator                                                 VmaAllocator                       = nullptr;
+        /*
+         * Shared by every pipeline creation, loaded at Initialize and saved back at Deinitialize when the device and driver match
+         */
+        VkPipelineCache                                              PipelineCache                      = VK_NULL_HANDLE;
+        std::string                                                  PipelineCacheFilename              = "Shaders/Cache/pipelines.zepipelines";
         const std::string_view                                       ApplicationName                    = "Tetragrama";
         const std::string_view                                       EngineName                         = "ZEngine";
         Helpers::Ref<Rendering::Renderers::RenderPasses::Attachment> SwapchainAttachment                = {};
@@ -702,40 +880,99 @@ namespace ZEngine::Hardwares
         std::vector<Helpers::Ref<Rendering::Primitives::Fence>>      SwapchainSignalFences              = {};
         std::vector<CommandBuffer*>                                  EnqueuedCommandbuffers             = {};
         std::set<WriteDescriptorSetRequestKey>                       WriteBindlessDescriptorSetRequests = {};
-        Helpers::Ref<Rendering::Textures::TextureHandleManager>      GlobalTextures                     = Helpers::CreateRef<Rendering::Textures::TextureHandleManager>(600);
-        Helpers::ThreadSafeQueue<Rendering::Textures::TextureHandle> TextureHandleToUpdates             = {};
+        /*
+         * Size of the bindless texture table : the descriptor count of every unsized sampler array (TextureArray[] in the shaders)
+         * and the capacity of GlobalTextures, whose indices address it. MaxBindlessTextureCount clamped to the device limits at Initialize
+         */
+        uint32_t                                                     BindlessTextureCount               = 0;
+        Helpers::Ref<Rendering::Textures::TextureHandleManager>      GlobalTextures                     = nullptr;
+        /*
+         * Textures whose bindless descriptor Update() rewrites. The main thread drains the queue and never waits on it : it enqueues
+         * through EnqueueTextureUpdate(), other threads with TryEnqueue and keep what doesn't fit for later
+         */
+        static constexpr size_t                                      TextureUpdateQueueCapacity         = 4096;
+        Helpers::LockFreeQueue<Rendering::Textures::TextureHandle>   TextureHandleToUpdates             = {TextureUpdateQueueCapacity};
         Helpers::HandleManager<VertexBufferSetRef>                   VertexBufferSetManager             = {300};
         Helpers::HandleManager<StorageBufferSetRef>                  StorageBufferSetManager            = {300};
         Helpers::HandleManager<IndirectBufferSetRef>                 IndirectBufferSetManager           = {300};
         Helpers::HandleManager<IndexBufferSetRef>                    IndexBufferSetManager              = {300};
         Helpers::HandleManager<UniformBufferSetRef>                  UniformBufferSetManager            = {300};
+        /*
+         * Persistently mapped ring every upload is staged in, payloads over StagingDedicatedThreshold get a buffer of their own
+         */
+        static constexpr VkDeviceSize                                StagingRingByteSize                = 64ull * 1024 * 1024;
+        static constexpr VkDeviceSize                                StagingDedicatedThreshold          = StagingRingByteSize / 4;
+        static constexpr VkDeviceSize                                StagingAlignment                   = 16;
         std::atomic_bool                                             RunningDirtyCollector              = true;
         std::atomic_uint                                             IdleFrameCount                     = 0;
         std::atomic_uint                                             IdleFrameThreshold                 = SwapchainImageCount * 3;
         std::condition_variable                                      DirtyCollectorCond                 = {};
+        /*
+         * vkQueueSubmit and vkQueuePresentKHR need the queue externally synchronized, uploads are submitted from any thread
+         */
+        std::mutex                                                   QueueSubmitMutex                   = {};
         std::mutex                                                   DirtyMutex                         = {};
         Windows::CoreWindow*                                         CurrentWindow                      = nullptr;
 
         void                                                         Initialize(const Helpers::Ref<Windows::CoreWindow>& window);
         void                                                         Deinitialize();
         void                                                         Update();
+        /*
+         * Main thread : queues a descriptor rewrite of the texture, deferred to the next Update() when TextureHandleToUpdates is full
+         */
+        void                                                         EnqueueTextureUpdate(const Rendering::Textures::TextureHandle& handle);
         void                                                         Dispose();
         bool                                                         QueueSubmit(const VkPipelineStageFlags wait_stage_flag, CommandBuffer* const command_buffer, Rendering::Primitives::Semaphore* const signal_semaphore = nullptr, Rendering::Primitives::Fence* const fence = nullptr);
         void                                                         EnqueueForDeletion(Rendering::DeviceResourceType resource_type, void* const resource_handle);
         void                                                         EnqueueForDeletion(Rendering::DeviceResourceType resource_type, DirtyResource resource);
         void                                                         EnqueueBufferForDeletion(BufferView& buffer);
         void                                                         EnqueueBufferImageForDeletion(BufferImage& buffer);
+        /*
+         * Destroys every resource queued for deletion whatever its frame, the queues must be idle
+         */
+        void                                                         CollectDirtyResources();
+        /*
+         * Fetches the graphic and transfer queues of LogicalDevice from GraphicFamilyIndex and TransferFamilyIndex
+         */
+        void                                                         GetDeviceQueues();
         QueueView                                                    GetQueue(Rendering::QueueType type);
         void                                                         QueueWait(Rendering::QueueType type);
         void                                                         QueueWaitAll();
         void                                                         MapAndCopyToMemory(BufferView& buffer, size_t data_size, const void* data);
         BufferView                                                   CreateBuffer(VkDeviceSize byte_size, VkBufferUsageFlags buffer_usage, VmaAllocationCreateFlags vma_create_flags = 0);
-        void                                                         CopyBuffer(const BufferView& source, const BufferView& destination, VkDeviceSize byte_size);
-        BufferImage                                                  CreateImage(uint32_t width, uint32_t height, VkImageType image_type, VkImageViewType image_view_type, VkFormat image_format, VkImageTiling image_tiling, VkImageLayout image_initial_layout, VkImageUsageFlags image_usage, VkSharingMode image_sharing_mode, VkSampleCountFlagBits image_sample_count, VkMemoryPropertyFlags requested_properties, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count = 1U, VkImageCreateFlags image_create_flag_bit = 0);
+        /*
+         * Copies are recorded into the transfer batch and return its completion token, see TransferBatcher
+         */
+        uint64_t                                                     CopyBuffer(const BufferView& source, const BufferView& destination, VkDeviceSize byte_size, VkDeviceSize source_offset = 0);
+        uint64_t                                                     CopyBuffer(const BufferView& source, const BufferView& destination, std::span<const VkBufferCopy> regions);
+        /*
+         * level_offsets : where each level the staging holds starts, from source.Offset. An empty span is level 0 alone at the
+         * start. The levels of mip_levels the staging doesn't hold are generated with linear blits, see IsLinearBlitSupported
+         */
+        uint64_t                                                     CopyBufferToImage(const StagingAllocation& source, BufferImage& destination, uint32_t width, uint32_t height, uint32_t layer_count, VkImageAspectFlagBits aspect, VkImageLayout final_layout, uint32_t mip_levels = 1U, std::span<const VkDeviceSize> level_offsets = {});
+        uint64_t                                                     FlushTransfers();
+        bool                                                         IsTransferComplete(uint64_t token) const;
+        bool                                                         WaitTransfer(uint64_t token);
+        /*
+         * Upload space for byte_size bytes : the caller writes Data, calls FlushStaging, records the copy from Buffer at Offset and
+         * calls ReleaseStaging with the token of the copy (0 when the submission reading it has already been waited on). Thread safe
+         */
+        StagingAllocation                                            AllocateStaging(VkDeviceSize byte_size, VkDeviceSize alignment = StagingAlignment);
+        void                                                         FlushStaging(const StagingAllocation& allocation);
+        void                                                         ReleaseStaging(StagingAllocation& allocation, uint64_t transfer_token = 0);
+        BufferImage                                                  CreateImage(uint32_t width, uint32_t height, VkImageType image_type, VkImageViewType image_view_type, VkFormat image_format, VkImageTiling image_tiling, VkImageLayout image_initial_layout, VkImageUsageFlags image_usage, VkSharingMode image_sharing_mode, VkSampleCountFlagBits image_sample_count, VkMemoryPropertyFlags requested_properties, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count = 1U, VkImageCreateFlags image_create_flag_bit = 0, uint32_t mip_levels = 1U);
         VkSampler                                                    CreateImageSampler();
         VkFormat                                                     FindSupportedFormat(const std::vector<VkFormat>& format_collection, VkImageTiling image_tiling, VkFormatFeatureFlags feature_flags);
         VkFormat                                                     FindDepthFormat();
-        VkImageView                                                  CreateImageView(VkImage image, VkFormat image_format, VkImageViewType image_view_type, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count = 1U);
+        /*
+         * Optimal tiling images of the format can blit from and to themselves with a linear filter : mip levels can be generated
+         */
+        bool                                                         IsLinearBlitSupported(VkFormat format);
+        /*
+         * BC1 to BC7 images can be sampled (textureCompressionBC, enabled whenever the device has it)
+         */
+        bool                                                         IsBlockCompressionSupported() const;
+        VkImageView                                                  CreateImageView(VkImage image, VkFormat image_format, VkImageViewType image_view_type, VkImageAspectFlagBits image_aspect_flag, uint32_t layer_count = 1U, uint32_t mip_levels = 1U);
         VkFramebuffer                                                CreateFramebuffer(const std::vector<VkImageView>& attachments, const VkRenderPass& render_pass, uint32_t width, uint32_t height, uint32_t layer_number = 1);
         VertexBufferSetHandle                                        CreateVertexBufferSet();
         StorageBufferSetHandle                                       CreateStorageBufferSet();
@@ -761,9 +998,32 @@ namespace ZEngine::Hardwares
         Helpers::HandleManager<DirtyResource>   m_dirty_resources{300};
         Helpers::HandleManager<BufferView>      m_dirty_buffers{500};
         Helpers::HandleManager<BufferImage>     m_dirty_buffer_images{500};
+        BufferView                              m_staging_buffer{};
+        uint8_t*                                m_staging_data{nullptr};
+        Helpers::StagingRingAllocator           m_staging_ring{};
+        std::mutex                              m_staging_mutex;
+        TransferBatcher                         m_transfer_batcher{};
+        /*
+         * Main thread only : texture updates that didn't fit in TextureHandleToUpdates, Update() takes them first
+         */
+        std::vector<Rendering::Textures::TextureHandle> m_deferred_texture_updates{};
+        /*
+         * Dedicated staging buffers wait for the transfer reading them before going to the dirty collector
+         */
+        struct PendingStagingBuffer
+        {
+            BufferView Buffer        = {};
+            uint64_t   TransferToken = 0;
+        };
+        std::vector<PendingStagingBuffer>       m_pending_staging_buffers{};
         VkDebugUtilsMessengerEXT                m_debug_messenger{VK_NULL_HANDLE};
         PFN_vkCreateDebugUtilsMessengerEXT      __createDebugMessengerPtr{VK_NULL_HANDLE};
         PFN_vkDestroyDebugUtilsMessengerEXT     __destroyDebugMessengerPtr{VK_NULL_HANDLE};
+        void                                    __destroyDirtyResource(const DirtyResource& res_handle);
+        void                                    __retireStaging();
+        void                                    __loadPipelineCache();
+        void                                    __savePipelineCache();
+        Serializers::PipelineCacheIdentity      __pipelineCacheIdentity() const;
         void                                    __cleanupDirtyResource();
         void                                    __cleanupBufferDirtyResource();
         void                                    __cleanupBufferImageDirtyResource();
@@ -776,60 +1036,55 @@ namespace ZEngine::Helpers
     template <>
     inline void HandleManager<Hardwares::VertexBufferSetRef>::Dispose()
     {
-        for (size_t i = 0; i < m_count; ++i)
-        {
-            if (m_data[i].Data)
+        ForEach([](auto& data) {
+            if (data)
             {
-                m_data[i].Data->Dispose();
+                data->Dispose();
             }
-        }
+        });
     }
 
     template <>
     inline void HandleManager<Hardwares::StorageBufferSetRef>::Dispose()
     {
-        for (size_t i = 0; i < m_count; ++i)
-        {
-            if (m_data[i].Data)
+        ForEach([](auto& data) {
+            if (data)
             {
-                m_data[i].Data->Dispose();
+                data->Dispose();
             }
-        }
+        });
     }
 
     template <>
     inline void HandleManager<Hardwares::IndirectBufferSetRef>::Dispose()
     {
-        for (size_t i = 0; i < m_count; ++i)
-        {
-            if (m_data[i].Data)
+        ForEach([](auto& data) {
+            if (data)
             {
-                m_data[i].Data->Dispose();
+                data->Dispose();
             }
-        }
+        });
     }
 
     template <>
     inline void HandleManager<Hardwares::IndexBufferSetRef>::Dispose()
     {
-        for (size_t i = 0; i < m_count; ++i)
-        {
-            if (m_data[i].Data)
+        ForEach([](auto& data) {
+            if (data)
             {
-                m_data[i].Data->Dispose();
+                data->Dispose();
             }
-        }
+        });
     }
 
     template <>
     inline void HandleManager<Hardwares::UniformBufferSetRef>::Dispose()
     {
-        for (size_t i = 0; i < m_count; ++i)
-        {
-            if (m_data[i].Data)
+        ForEach([](auto& data) {
+            if (data)
             {
-                m_data[i].Data->Dispose();
+                data->Dispose();
             }
-        }
+        });
     }
 } // namespace ZEngine::Helpers
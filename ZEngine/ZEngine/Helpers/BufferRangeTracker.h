@@ -0,0 +1,182 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Helpers
+{
+    struct BufferRange
+    {
+        size_t Offset   = 0;
+        size_t ByteSize = 0;
+
+        size_t End() const
+        {
+            return Offset + ByteSize;
+        }
+
+        bool operator==(const BufferRange&) const = default;
+    };
+
+    /*
+     * Tracks which byte ranges of a multi-buffered resource are stale, independently for each frame slot (swapchain image).
+     * A change is recorded once and becomes pending for every slot, each slot then consumes its own list when it gets uploaded,
+     * so a region written at frame N is copied exactly once into each per-frame copy and never again while it stays unchanged.
+     *
+     * Recording is an append, ranges are sorted and coalesced lazily when a slot reads them.
+     * Ranges separated by at most merge_gap bytes are fused : copying a few unchanged bytes is cheaper than issuing another copy.
+     */
+    class BufferRangeTracker
+    {
+    public:
+        static constexpr size_t DefaultMergeGap   = 256;
+        /*
+         * Past that many pending ranges a slot is coalesced on the spot, keeping memory bounded when nobody consumes it.
+         * The threshold then doubles from the coalesced size so that disjoint ranges don't trigger a sort on every append
+         */
+        static constexpr size_t MaxPendingRanges  = 4096;
+
+        BufferRangeTracker(uint32_t slot_count = 0, size_t merge_gap = DefaultMergeGap) : m_merge_gap(merge_gap), m_slots(slot_count) {}
+
+        void SetSlotCount(uint32_t slot_count)
+        {
+            m_slots.resize(slot_count);
+        }
+
+        uint32_t SlotCount() const
+        {
+            return static_cast<uint32_t>(m_slots.size());
+        }
+
+        void MarkDirty(size_t offset, size_t byte_size)
+        {
+            if (byte_size == 0)
+            {
+                return;
+            }
+
+            for (auto& slot : m_slots)
+            {
+                if (slot.FullyDirty)
+                {
+                    continue;
+                }
+
+                slot.Ranges.push_back(BufferRange{.Offset = offset, .ByteSize = byte_size});
+                slot.Coalesced = (slot.Ranges.size() == 1);
+                if (slot.Ranges.size() > slot.CoalesceThreshold)
+                {
+                    Coalesce(slot);
+                    slot.CoalesceThreshold = std::max(MaxPendingRanges, 2 * slot.Ranges.size());
+                }
+            }
+        }
+
+        /*
+         * The whole resource is stale for every slot (e.g it was resized), pending ranges become irrelevant
+         */
+        void MarkAllDirty()
+        {
+            for (auto& slot : m_slots)
+            {
+                slot.FullyDirty = true;
+                slot.Ranges.clear();
+                slot.Coalesced = true;
+            }
+        }
+
+        bool IsFullyDirty(uint32_t slot_index) const
+        {
+            return (slot_index < m_slots.size()) && m_slots[slot_index].FullyDirty;
+        }
+
+        bool HasPendingChanges(uint32_t slot_index) const
+        {
+            return (slot_index < m_slots.size()) && (m_slots[slot_index].FullyDirty || !m_slots[slot_index].Ranges.empty());
+        }
+
+        /*
+         * Sorted, non-overlapping ranges still to upload for the slot. Empty when the slot is fully dirty
+         */
+        std::span<const BufferRange> GetRanges(uint32_t slot_index)
+        {
+            if (slot_index >= m_slots.size())
+            {
+                return {};
+            }
+
+            auto& slot = m_slots[slot_index];
+            if (!slot.Coalesced)
+            {
+                Coalesce(slot);
+            }
+            return slot.Ranges;
+        }
+
+        size_t GetPendingByteSize(uint32_t slot_index)
+        {
+            size_t byte_size = 0;
+            for (const auto& range : GetRanges(slot_index))
+            {
+                byte_size += range.ByteSize;
+            }
+            return byte_size;
+        }
+
+        /*
+         * The slot is up to date, its pending ranges are dropped (their memory is kept for the next frames)
+         */
+        void Consume(uint32_t slot_index)
+        {
+            if (slot_index >= m_slots.size())
+            {
+                return;
+            }
+
+            auto& slot             = m_slots[slot_index];
+            slot.FullyDirty        = false;
+            slot.Coalesced         = true;
+            slot.CoalesceThreshold = MaxPendingRanges;
+            slot.Ranges.clear();
+        }
+
+    private:
+        struct SlotRanges
+        {
+            bool                     FullyDirty        = true;
+            bool                     Coalesced         = true;
+            size_t                   CoalesceThreshold = MaxPendingRanges;
+            std::vector<BufferRange> Ranges            = {};
+        };
+
+        size_t                  m_merge_gap;
+        std::vector<SlotRanges> m_slots;
+
+        void                    Coalesce(SlotRanges& slot) const
+        {
+            auto& ranges = slot.Ranges;
+            std::sort(ranges.begin(), ranges.end(), [](const BufferRange& a, const BufferRange& b) { return a.Offset < b.Offset; });
+
+            size_t last = 0;
+            for (size_t i = 1; i < ranges.size(); ++i)
+            {
+                if (ranges[i].Offset <= ranges[last].End() + m_merge_gap)
+                {
+                    ranges[last].ByteSize = std::max(ranges[last].End(), ranges[i].End()) - ranges[last].Offset;
+                }
+                else
+                {
+                    ranges[++last] = ranges[i];
+                }
+            }
+
+            if (!ranges.empty())
+            {
+                ranges.resize(last + 1);
+            }
+            slot.Coalesced = true;
+        }
+    };
+} // namespace ZEngine::Helpers
@@ -1,9 +1,10 @@
 #pragma once
 #include <IntrusivePtr.h>
 #include <ZEngineDef.h>
-#include <set>
-#include <shared_mutex>
-#include <span>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #define INVALID_HANDLE_INDEX -1
@@ -23,7 +24,7 @@ namespace ZEngine::Helpers
 
         bool Valid() const
         {
-            return Index > INVALID_HANDLE_INDEX && m_counter > INVALID_HANDLE_INDEX;
+            return Index > INVALID_HANDLE_INDEX && m_generation > INVALID_HANDLE_INDEX;
         }
 
         operator bool() const
@@ -32,172 +33,355 @@ namespace ZEngine::Helpers
         }
 
     private:
-        int m_counter = INVALID_HANDLE_INDEX;
+        int m_generation = INVALID_HANDLE_INDEX;
         friend class HandleManager<T>;
     };
 
+    /*
+     * Generation-checked handle pool.
+     *
+     * Slots live in fixed-size pages that are allocated on demand and never moved, so a reference returned by Access() stays valid until the handle is removed.
+     * Released slots are chained through an intrusive LIFO free list, making Create() and Remove() O(1) without any extra allocation.
+     * Each slot carries a generation that is bumped on every reuse : a handle that outlived its slot no longer matches it and is rejected.
+     *
+     * Create/Remove/Update serialize on a mutex, while Access/ToHandle/IsAlive only read the page table and the slot generation and never lock.
+     * Update() therefore overwrites the payload under the feet of unlocked readers : it must not run concurrently with Access/TryAccess
+     * of the same handle, a payload is swapped from the thread that reads it. Access/TryAccess assert it, on a best-effort basis.
+     *
+     * Live slots are also indexed by a packed list (swap-and-pop on removal) so that ForEach/RemoveIf visit O(live) entries instead of
+     * scanning every slot up to Head(). The payloads themselves stay in their slots, for Access() to remain lock-free and its
+     * references stable : the walk still reads them from their pages.
+     */
     template <typename T>
     class HandleManager : public Helpers::RefCounted
     {
         struct ArrayData
         {
-            int Counter{INVALID_HANDLE_INDEX};
-            T   Data;
+            std::atomic_int32_t Generation{INVALID_HANDLE_INDEX};
+            int32_t             Version{INVALID_HANDLE_INDEX};
+            int32_t             NextFree{INVALID_HANDLE_INDEX};
+            uint32_t            LiveIndex{0};
+            T                   Data{};
         };
 
-        int32_t                   m_counter{INVALID_HANDLE_INDEX};
-        uint32_t                  m_count{0};
-        uint32_t                  m_free_indice_head{0};
-        std::vector<ArrayData>    m_data;
-        std::set<uint32_t>        m_free_indices;
-        mutable std::shared_mutex m_mutex;
+        struct LiveEntry
+        {
+            uint32_t Index;
+            T*       Data;
+        };
 
     public:
-        HandleManager(uint32_t count = 0) : m_data(count), m_count(count) {}
-
-        T& operator[](const Handle<T>& handle)
+        static constexpr uint32_t PageShift       = 8;
+        static constexpr uint32_t PageSize        = 1u << PageShift;
+        static constexpr uint32_t PageMask        = PageSize - 1;
+        static constexpr uint32_t DefaultMaxCount = 1u << 20;
+
+        /*
+         * count    : slots reserved up-front, the pool grows page by page past it
+         * maxCount : hard ceiling, Create() fails once that many slots are live
+         */
+        HandleManager(uint32_t count = 0, uint32_t maxCount = DefaultMaxCount)
+            : m_max_count(std::max(maxCount, 1u)), m_page_capacity((m_max_count + PageMask) >> PageShift), m_pages(std::make_unique<std::atomic<ArrayData*>[]>(m_page_capacity))
         {
-            return Access(handle);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            uint32_t                    reserved = std::min(count, m_max_count);
+            while (m_page_count * PageSize < reserved)
+            {
+                AllocatePage();
+            }
         }
 
-        std::span<ArrayData> Data() const
+        HandleManager(const HandleManager&)            = delete;
+        HandleManager& operator=(const HandleManager&) = delete;
+
+        ~HandleManager()
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            return m_data;
+            for (uint32_t i = 0; i < m_page_count; ++i)
+            {
+                delete[] m_pages[i].load(std::memory_order_relaxed);
+            }
         }
 
-        std::vector<ArrayData>& Data()
+        T& operator[](const Handle<T>& handle)
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            return m_data;
+            return Access(handle);
         }
 
         Handle<T> Create()
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
-            Handle<T>                           handle = {};
-
-            if (m_free_indice_head >= m_count)
+            std::lock_guard<std::mutex> lock(m_mutex);
+            int32_t                     index = AcquireSlot();
+            if (index == INVALID_HANDLE_INDEX)
             {
-                return handle;
+                return {};
             }
+            return Publish(index);
+        }
 
-            uint32_t index = INVALID_HANDLE_INDEX;
-            if (!m_free_indices.empty())
+        T& Access(const Handle<T>& handle)
+        {
+            ZENGINE_VALIDATE_ASSERT(IsAlive(handle), "Handle is invalid or refers to a released slot")
+            ZENGINE_VALIDATE_ASSERT(m_updating_index.load(std::memory_order_acquire) != handle.Index, "Handle is accessed while Update() overwrites it")
+            return SlotAt(handle.Index).Data;
+        }
+
+        /*
+         * Variant of Access() returning nullptr when the handle is stale
+         */
+        T* TryAccess(const Handle<T>& handle)
+        {
+            if (!IsAlive(handle))
             {
-                auto begin = m_free_indices.begin();
-                index      = *begin;
-                m_free_indices.erase(index);
-                ZENGINE_VALIDATE_ASSERT(m_data[index].Counter == INVALID_HANDLE_INDEX, "Counter shouldn't be valid")
+                return nullptr;
             }
-            else
+            ZENGINE_VALIDATE_ASSERT(m_updating_index.load(std::memory_order_acquire) != handle.Index, "Handle is accessed while Update() overwrites it")
+            return &SlotAt(handle.Index).Data;
+        }
+
+        bool IsAlive(const Handle<T>& handle) const
+        {
+            if (!handle || (static_cast<uint32_t>(handle.Index) >= m_head.load(std::memory_order_acquire)))
             {
-                ZENGINE_VALIDATE_ASSERT(m_data[m_free_indice_head].Counter == INVALID_HANDLE_INDEX, "Counter shouldn't be valid")
-                index = m_free_indice_head++;
+                return false;
             }
+            return SlotAt(handle.Index).Generation.load(std::memory_order_acquire) == handle.m_generation;
+        }
 
-            auto& data       = m_data[index];
-            data.Counter     = ++m_counter;
-            handle.Index     = index;
-            handle.m_counter = data.Counter;
+        Handle<T> Add(const T& value)
+        {
+            return Insert(value);
+        }
 
+        Handle<T> Add(T&& value)
+        {
+            return Insert(std::move(value));
+        }
+
+        /*
+         * Rebuilds the handle currently owning the slot, the result is invalid when the slot is free
+         */
+        Handle<T> ToHandle(uint32_t index) const
+        {
+            Handle<T> handle{};
+            ZENGINE_VALIDATE_ASSERT(index < Head(), "Handle Index is beyond the head")
+
+            handle.Index        = index;
+            handle.m_generation = SlotAt(index).Generation.load(std::memory_order_acquire);
             return handle;
         }
 
-        T& Access(const Handle<T>& handle)
+        /*
+         * Overwrites the payload in place, see the class comment : not concurrently with Access/TryAccess of the same handle
+         */
+        void Update(Handle<T>& handle, T& data)
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            ZENGINE_VALIDATE_ASSERT(handle.Index < m_free_indice_head, "Handle Index is beyond the head")
-            return m_data[handle.Index].Data;
+            Overwrite(handle, data);
         }
 
-        Handle<T> Add(const T& value)
+        void Update(Handle<T>& handle, T&& data)
         {
-            Handle<T> handle = Create();
+            Overwrite(handle, std::move(data));
+        }
 
-            if (handle)
+        void Remove(Handle<T>& handle)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!IsAlive(handle))
             {
-                m_data[handle.Index].Data = value;
+                return;
             }
 
-            return handle;
+            Release(handle.Index);
+            handle = Handle<T>{};
         }
 
-        Handle<T> Add(T&& value)
+        /*
+         * Number of slots currently backed by a page
+         */
+        size_t Size() const
         {
-            Handle<T> handle = Create();
-
-            if (handle)
-            {
-                m_data[handle.Index].Data = std::move(value);
-            }
+            return std::min(m_reserved_count.load(std::memory_order_acquire), m_max_count);
+        }
 
-            return handle;
+        size_t MaxSize() const
+        {
+            return m_max_count;
         }
 
-        Handle<T> ToHandle(uint32_t index)
+        /*
+         * One past the highest slot ever handed out, the range to scan with ToHandle()
+         */
+        uint32_t Head() const
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            Handle<T>                           handle{};
-            ZENGINE_VALIDATE_ASSERT(index < m_free_indice_head, "Handle Index is beyond the head");
+            return m_head.load(std::memory_order_acquire);
+        }
 
-            ArrayData data   = m_data[index];
-            handle.Index     = index;
-            handle.m_counter = data.Counter;
-            return handle;
+        /*
+         * Number of live handles
+         */
+        uint32_t Delta() const
+        {
+            return m_live_count.load(std::memory_order_relaxed);
         }
 
-        void Update(Handle<T>& handle, T& data)
+        /*
+         * Visits every live entry. m_mutex is held for the whole walk : the callback must not create, update or remove handles of this manager
+         */
+        template <typename TCallback>
+        void ForEach(TCallback&& callback)
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
-            if ((handle) && (m_data[handle.Index].Counter == handle.m_counter) && (handle.Index < m_free_indice_head))
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const LiveEntry& entry : m_live_entries)
             {
-                m_data[handle.Index].Data = data;
+                callback(*entry.Data);
             }
         }
 
-        void Update(Handle<T>& handle, T&& data)
+        /*
+         * Visits every live entry and releases those for which the predicate returns true.
+         * The packed list is walked backward so that swap-and-pop never moves an entry that is still to be visited
+         */
+        template <typename TPredicate>
+        uint32_t RemoveIf(TPredicate&& predicate)
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
-            if ((handle) && (m_data[handle.Index].Counter == handle.m_counter) && (handle.Index < m_free_indice_head))
+            std::lock_guard<std::mutex> lock(m_mutex);
+            uint32_t                    removed_count = 0;
+            for (size_t i = m_live_entries.size(); i > 0; --i)
             {
-                m_data[handle.Index].Data = std::move(data);
+                uint32_t index = m_live_entries[i - 1].Index;
+                if (predicate(*m_live_entries[i - 1].Data))
+                {
+                    Release(index);
+                    removed_count++;
+                }
             }
+            return removed_count;
         }
 
-        void Remove(Handle<T>& handle)
+        void Dispose() {}
+
+    private:
+        const uint32_t                              m_max_count;
+        const uint32_t                              m_page_capacity;
+        std::unique_ptr<std::atomic<ArrayData*>[]>  m_pages;
+        uint32_t                                    m_page_count{0};
+        int32_t                                     m_free_head{INVALID_HANDLE_INDEX};
+        std::atomic_uint32_t                        m_head{0};
+        std::atomic_uint32_t                        m_reserved_count{0};
+        std::atomic_uint32_t                        m_live_count{0};
+        std::vector<LiveEntry>                      m_live_entries;
+        std::mutex                                  m_mutex;
+        /*
+         * Slot Update() is writing, INVALID_HANDLE_INDEX otherwise
+         */
+        std::atomic_int32_t                         m_updating_index{INVALID_HANDLE_INDEX};
+
+        ArrayData&                                  SlotAt(uint32_t index) const
+        {
+            ArrayData* page = m_pages[index >> PageShift].load(std::memory_order_acquire);
+            return page[index & PageMask];
+        }
+
+        void AllocatePage()
+        {
+            m_pages[m_page_count].store(new ArrayData[PageSize], std::memory_order_release);
+            m_page_count++;
+            m_reserved_count.store(m_page_count * PageSize, std::memory_order_release);
+        }
+
+        /*
+         * Must be called with m_mutex held
+         */
+        int32_t AcquireSlot()
         {
-            std::unique_lock<std::shared_mutex> lock(m_mutex);
-            if (!handle)
+            if (m_free_head != INVALID_HANDLE_INDEX)
             {
-                return;
+                int32_t index = m_free_head;
+                m_free_head   = SlotAt(index).NextFree;
+                ZENGINE_VALIDATE_ASSERT(SlotAt(index).Generation.load(std::memory_order_relaxed) == INVALID_HANDLE_INDEX, "Released slot shouldn't be alive")
+                return index;
+            }
+
+            uint32_t head = m_head.load(std::memory_order_relaxed);
+            if (head >= m_max_count)
+            {
+                return INVALID_HANDLE_INDEX;
             }
 
-            if ((handle.Index < m_free_indice_head) && (m_data[handle.Index].Counter == handle.m_counter))
+            if ((head >> PageShift) >= m_page_count)
             {
-                m_free_indices.insert(handle.Index);
-                m_data[handle.Index] = ArrayData{};
-                handle               = Handle<T>{};
+                AllocatePage();
             }
+            return static_cast<int32_t>(head);
         }
 
-        size_t Size() const
+        /*
+         * Must be called with m_mutex held, once the slot payload is in place
+         */
+        Handle<T> Publish(int32_t index)
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            return m_count;
+            auto& slot   = SlotAt(index);
+            slot.Version = (slot.Version == INT32_MAX) ? 0 : slot.Version + 1;
+            slot.Generation.store(slot.Version, std::memory_order_release);
+
+            slot.LiveIndex = static_cast<uint32_t>(m_live_entries.size());
+            m_live_entries.push_back(LiveEntry{static_cast<uint32_t>(index), &slot.Data});
+
+            if (static_cast<uint32_t>(index) == m_head.load(std::memory_order_relaxed))
+            {
+                m_head.store(index + 1, std::memory_order_release);
+            }
+            m_live_count.fetch_add(1, std::memory_order_relaxed);
+
+            Handle<T> handle{};
+            handle.Index        = index;
+            handle.m_generation = slot.Version;
+            return handle;
         }
 
-        uint32_t Head() const
+        /*
+         * Must be called with m_mutex held, on a live slot
+         */
+        void Release(uint32_t index)
         {
-            std::shared_lock<std::shared_mutex> lock(m_mutex);
-            return m_free_indice_head;
+            auto& slot = SlotAt(index);
+            slot.Generation.store(INVALID_HANDLE_INDEX, std::memory_order_release);
+            slot.Data                      = T{};
+            slot.NextFree                  = m_free_head;
+            m_free_head                    = static_cast<int32_t>(index);
+
+            LiveEntry last                 = m_live_entries.back();
+            m_live_entries[slot.LiveIndex] = last;
+            SlotAt(last.Index).LiveIndex   = slot.LiveIndex;
+            m_live_entries.pop_back();
+
+            m_live_count.fetch_sub(1, std::memory_order_relaxed);
         }
 
-        uint32_t Delta() const
+        template <typename U>
+        void Overwrite(Handle<T>& handle, U&& data)
         {
-            return m_free_indice_head - (uint32_t) m_free_indices.size();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (IsAlive(handle))
+            {
+                m_updating_index.store(handle.Index, std::memory_order_release);
+                SlotAt(handle.Index).Data = std::forward<U>(data);
+                m_updating_index.store(INVALID_HANDLE_INDEX, std::memory_order_release);
+            }
         }
 
-        void Dispose() {}
+        template <typename U>
+        Handle<T> Insert(U&& value)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            int32_t                     index = AcquireSlot();
+            if (index == INVALID_HANDLE_INDEX)
+            {
+                return {};
+            }
+
+            SlotAt(index).Data = std::forward<U>(value);
+            return Publish(index);
+        }
     };
 } // namespace ZEngine::Helpers
@@ -0,0 +1,301 @@
+#pragma once
+#include <Helpers/IntrusivePtr.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace ZEngine::Helpers
+{
+    /*
+     * Bounded multi-producer/multi-consumer ring queue (sequence-numbered cells, D. Vyukov's design).
+     * Producers and consumers only contend on their own cursor with a single CAS, no mutex is taken on the Enqueue/Pop paths.
+     *
+     * The interface mirrors ThreadSafeQueue so call sites can switch between both, with two differences inherent to the bounded storage :
+     *  - Try* variants fail instead of waiting when the queue is full (TryEnqueue, TryEmplace) or empty (Pop), a failed TryEmplace
+     *    leaves its argument untouched for the caller to keep it elsewhere,
+     *  - Enqueue/Emplace wait for a free cell when the queue is full, a consumer must never enqueue into a queue only it drains.
+     */
+    template <typename T>
+    class LockFreeQueue : public Helpers::RefCounted
+    {
+    public:
+        static constexpr size_t DefaultCapacity = 1024;
+
+        LockFreeQueue(size_t capacity = DefaultCapacity) : m_capacity(RoundUpPowerOfTwo(capacity)), m_mask(m_capacity - 1), m_cells(std::make_unique<Cell[]>(m_capacity))
+        {
+            for (size_t i = 0; i < m_capacity; ++i)
+            {
+                m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        LockFreeQueue(const LockFreeQueue&)            = delete;
+        LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+        bool           TryEnqueue(const T& task)
+        {
+            return TryPush(task);
+        }
+
+        bool TryEmplace(T&& task)
+        {
+            return TryPush(std::move(task));
+        }
+
+        void Enqueue(const T& task)
+        {
+            while (!TryPush(task))
+            {
+                WaitForFreeCell();
+            }
+        }
+
+        void Emplace(T&& task)
+        {
+            while (!TryPush(std::move(task)))
+            {
+                WaitForFreeCell();
+            }
+        }
+
+        bool Pop(T& task)
+        {
+            Cell*  cell     = nullptr;
+            size_t position = m_dequeue_position.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell              = &m_cells[position & m_mask];
+                size_t   sequence = cell->Sequence.load(std::memory_order_acquire);
+                intptr_t delta    = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+                if (delta == 0)
+                {
+                    if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (delta < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_dequeue_position.load(std::memory_order_relaxed);
+                }
+            }
+
+            task       = std::move(cell->Data);
+            cell->Data = T{};
+            cell->Sequence.store(position + m_capacity, std::memory_order_release);
+
+            Signal(m_pop_epoch, m_pop_waiter_count);
+            return true;
+        }
+
+        /*
+         * Blocking pop : waits until an item is available, or until the token is raised (returns false in that case)
+         */
+        bool WaitPop(T& task, const std::atomic_bool& cancellationToken)
+        {
+            while (!Pop(task))
+            {
+                Wait(cancellationToken);
+                if (cancellationToken.load())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void WaitPop(T& task)
+        {
+            while (!Pop(task))
+            {
+                Wait();
+            }
+        }
+
+        bool Empty() const
+        {
+            return Size() == 0;
+        }
+
+        /*
+         * Approximate when producers or consumers are concurrently active
+         */
+        size_t Size() const
+        {
+            size_t dequeue_position = m_dequeue_position.load(std::memory_order_acquire);
+            size_t enqueue_position = m_enqueue_position.load(std::memory_order_acquire);
+            return (enqueue_position > dequeue_position) ? (enqueue_position - dequeue_position) : 0;
+        }
+
+        size_t Capacity() const
+        {
+            return m_capacity;
+        }
+
+        void Wait()
+        {
+            while (Empty())
+            {
+                WaitOnEpoch(m_push_epoch, m_push_waiter_count, [this] { return !Empty(); });
+            }
+        }
+
+        /*
+         * std::atomic::wait can't time out : timed waiters block on a condition variable instead, that producers only touch while
+         * one is registered
+         */
+        void WaitFor(std::chrono::milliseconds time = std::chrono::milliseconds(1))
+        {
+            auto deadline = std::chrono::steady_clock::now() + time;
+            m_timed_waiter_count.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock l(m_timed_wait_mutex);
+                m_timed_wait_condition.wait_until(l, deadline, [this] { return !Empty(); });
+            }
+            m_timed_waiter_count.fetch_sub(1);
+        }
+
+        void Wait(const std::atomic_bool& cancellationToken)
+        {
+            while (Empty() && !cancellationToken.load())
+            {
+                WaitOnEpoch(m_push_epoch, m_push_waiter_count, [this, &cancellationToken] { return !Empty() || cancellationToken.load(); });
+            }
+        }
+
+        /*
+         * Drains the queue and wakes every waiter, so that waiters blocked on a cancellation token can observe it
+         */
+        void Clear()
+        {
+            T discarded;
+            while (Pop(discarded)) {}
+
+            m_push_epoch.fetch_add(1, std::memory_order_release);
+            m_push_epoch.notify_all();
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic_size_t Sequence{0};
+            T                  Data{};
+        };
+
+        static constexpr size_t CacheLineSize = 64;
+
+        const size_t            m_capacity;
+        const size_t            m_mask;
+        std::unique_ptr<Cell[]> m_cells;
+        alignas(CacheLineSize) std::atomic_size_t m_enqueue_position{0};
+        alignas(CacheLineSize) std::atomic_size_t m_dequeue_position{0};
+        alignas(CacheLineSize) std::atomic_uint32_t m_push_epoch{0};
+        std::atomic_uint32_t m_push_waiter_count{0};
+        alignas(CacheLineSize) std::atomic_uint32_t m_pop_epoch{0};
+        std::atomic_uint32_t    m_pop_waiter_count{0};
+        std::atomic_uint32_t    m_timed_waiter_count{0};
+        std::mutex              m_timed_wait_mutex;
+        std::condition_variable m_timed_wait_condition;
+
+        static size_t           RoundUpPowerOfTwo(size_t value)
+        {
+            size_t result = 2;
+            while (result < value)
+            {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        template <typename U>
+        bool TryPush(U&& task)
+        {
+            Cell*  cell     = nullptr;
+            size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell              = &m_cells[position & m_mask];
+                size_t   sequence = cell->Sequence.load(std::memory_order_acquire);
+                intptr_t delta    = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (delta == 0)
+                {
+                    if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (delta < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->Data = std::forward<U>(task);
+            cell->Sequence.store(position + 1, std::memory_order_release);
+
+            Signal(m_push_epoch, m_push_waiter_count);
+            SignalTimedWaiters();
+            return true;
+        }
+
+        void WaitForFreeCell()
+        {
+            WaitOnEpoch(m_pop_epoch, m_pop_waiter_count, [this] { return Size() < m_capacity; });
+        }
+
+        /*
+         * Waiters register themselves before re-checking the predicate and signalers only touch the epoch when someone is registered,
+         * the two fences guarantee that either the signaler sees the waiter or the waiter sees the published cell.
+         */
+        template <typename TPredicate>
+        static void WaitOnEpoch(std::atomic_uint32_t& epoch, std::atomic_uint32_t& waiter_count, TPredicate&& predicate)
+        {
+            waiter_count.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint32_t observed_epoch = epoch.load(std::memory_order_acquire);
+            if (!predicate())
+            {
+                epoch.wait(observed_epoch);
+            }
+            waiter_count.fetch_sub(1);
+        }
+
+        /*
+         * The fence of Signal() orders the published cell before the load of the count, same handshake as WaitOnEpoch()
+         */
+        void SignalTimedWaiters()
+        {
+            if (m_timed_waiter_count.load(std::memory_order_relaxed) > 0)
+            {
+                {
+                    std::lock_guard l(m_timed_wait_mutex);
+                }
+                m_timed_wait_condition.notify_all();
+            }
+        }
+
+        static void Signal(std::atomic_uint32_t& epoch, std::atomic_uint32_t& waiter_count)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiter_count.load(std::memory_order_relaxed) > 0)
+            {
+                epoch.fetch_add(1, std::memory_order_release);
+                epoch.notify_all();
+            }
+        }
+    };
+} // namespace ZEngine::Helpers
@@ -0,0 +1,176 @@
+#include <pch.h>
+#include <Helpers/MemoryMappedFile.h>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ZEngine::Helpers
+{
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        Close();
+    }
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+    {
+        Swap(other);
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    void MemoryMappedFile::Swap(MemoryMappedFile& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_is_open, other.m_is_open);
+#ifdef _WIN32
+        std::swap(m_file_handle, other.m_file_handle);
+        std::swap(m_mapping_handle, other.m_mapping_handle);
+#endif
+    }
+
+    bool MemoryMappedFile::Open(std::string_view filename)
+    {
+        Close();
+
+        std::string path(filename);
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER file_size = {};
+        if (!GetFileSizeEx(file, &file_size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        m_file_handle = file;
+        m_size        = static_cast<size_t>(file_size.QuadPart);
+        m_is_open     = true;
+        if (m_size == 0)
+        {
+            return true;
+        }
+
+        m_mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping_handle)
+        {
+            Close();
+            return false;
+        }
+
+        m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data)
+        {
+            Close();
+            return false;
+        }
+#else
+        int file_descriptor = ::open(path.c_str(), O_RDONLY);
+        if (file_descriptor < 0)
+        {
+            return false;
+        }
+
+        struct stat file_stat = {};
+        if (::fstat(file_descriptor, &file_stat) != 0)
+        {
+            ::close(file_descriptor);
+            return false;
+        }
+
+        m_size    = static_cast<size_t>(file_stat.st_size);
+        m_is_open = true;
+        if (m_size > 0)
+        {
+            void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(file_descriptor);
+                m_size    = 0;
+                m_is_open = false;
+                return false;
+            }
+            /*
+             * Assets are mostly read front to back, aggressive read-ahead gets close to the disk throughput
+             */
+            ::posix_madvise(data, m_size, POSIX_MADV_SEQUENTIAL);
+            m_data = static_cast<const std::byte*>(data);
+        }
+        /*
+         * The mapping keeps its own reference to the file
+         */
+        ::close(file_descriptor);
+#endif
+        return true;
+    }
+
+    void MemoryMappedFile::Close()
+    {
+#ifdef _WIN32
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping_handle)
+        {
+            CloseHandle(m_mapping_handle);
+        }
+        if (m_file_handle)
+        {
+            CloseHandle(m_file_handle);
+        }
+        m_mapping_handle = nullptr;
+        m_file_handle    = nullptr;
+#else
+        if (m_data)
+        {
+            ::munmap(const_cast<std::byte*>(m_data), m_size);
+        }
+#endif
+        m_data    = nullptr;
+        m_size    = 0;
+        m_is_open = false;
+    }
+
+    bool MemoryMappedFile::IsOpen() const
+    {
+        return m_is_open;
+    }
+
+    size_t MemoryMappedFile::Size() const
+    {
+        return m_size;
+    }
+
+    std::span<const std::byte> MemoryMappedFile::Bytes() const
+    {
+        return {m_data, m_size};
+    }
+} // namespace ZEngine::Helpers
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace ZEngine::Helpers
+{
+    /*
+     * Read-only view of a whole file mapped in the address space.
+     * Pages are brought in by the OS on first access, reading a byte range costs no copy into a user buffer.
+     * The mapping is released on Close() or destruction, spans taken from Bytes() must not outlive it.
+     */
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile() = default;
+        ~MemoryMappedFile();
+
+        MemoryMappedFile(const MemoryMappedFile&)            = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+        MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+        /*
+         * An empty file opens successfully with no bytes
+         */
+        bool                       Open(std::string_view filename);
+        void                       Close();
+
+        bool                       IsOpen() const;
+        size_t                     Size() const;
+        std::span<const std::byte> Bytes() const;
+
+    private:
+        const std::byte* m_data{nullptr};
+        size_t           m_size{0};
+        bool             m_is_open{false};
+#ifdef _WIN32
+        void*            m_file_handle{nullptr};
+        void*            m_mapping_handle{nullptr};
+#endif
+
+        void             Swap(MemoryMappedFile& other) noexcept;
+    };
+} // namespace ZEngine::Helpers
@@ -0,0 +1,191 @@
+#include <pch.h>
+#include <Helpers/MeshHelper.h>
+#include <Helpers/ThreadPool.h>
+
+using namespace ZEngine::Rendering::Meshes;
+
+namespace ZEngine::Helpers
+{
+    namespace
+    {
+        constexpr uint32_t VertexComponentCount = 3 + 3 + 2; /*pos-cmp + normal-cmp + tex-cmp*/
+        /*
+         * Work items are slices of a mesh, so a single large mesh still spreads over every worker
+         */
+        constexpr uint32_t VertexChunkSize      = 16384;
+        constexpr uint32_t FaceChunkSize        = 16384;
+
+        struct MeshExtractionRange
+        {
+            size_t   VertexFirst = 0; /* in vertices, relative to the first appended vertex */
+            size_t   IndexFirst  = 0; /* in indices, relative to the first appended index */
+            uint32_t IndexCount  = 0;
+            /*
+             * Indices per face when every face of the mesh has the same count (triangulated meshes), 0 otherwise.
+             * Face slices can only be located without a scan when it is set.
+             */
+            uint32_t FaceSize    = 0;
+        };
+
+        struct MeshExtractionChunk
+        {
+            uint32_t Mesh  = 0;
+            uint32_t Begin = 0;
+            uint32_t End   = 0;
+            bool     Faces = false;
+        };
+
+        void CountMeshIndices(const aiMesh* mesh, MeshExtractionRange& range)
+        {
+            range.IndexCount = 0;
+            range.FaceSize   = (mesh->mNumFaces > 0) ? mesh->mFaces[0].mNumIndices : 0;
+            for (uint32_t f = 0; f < mesh->mNumFaces; ++f)
+            {
+                uint32_t face_size  = mesh->mFaces[f].mNumIndices;
+                range.IndexCount   += face_size;
+                if (face_size != range.FaceSize)
+                {
+                    range.FaceSize = 0;
+                }
+            }
+        }
+
+        BoundingBox PackVertices(const aiMesh* mesh, uint32_t begin, uint32_t end, float* out)
+        {
+            BoundingBox       bounds     = {};
+            const aiVector3D* tex_coords = mesh->HasTextureCoords(0) ? mesh->mTextureCoords[0] : nullptr;
+            for (uint32_t v = begin; v < end; ++v, out += VertexComponentCount)
+            {
+                const aiVector3D& position = mesh->mVertices[v];
+                const aiVector3D  normal   = mesh->mNormals ? mesh->mNormals[v] : aiVector3D{};
+                const aiVector3D  texture  = tex_coords ? tex_coords[v] : aiVector3D{};
+
+                out[0]                     = position.x;
+                out[1]                     = position.y;
+                out[2]                     = position.z;
+                out[3]                     = normal.x;
+                out[4]                     = normal.y;
+                out[5]                     = normal.z;
+                out[6]                     = texture.x;
+                out[7]                     = texture.y;
+                bounds.Expand(glm::vec3(position.x, position.y, position.z));
+            }
+            return bounds;
+        }
+
+        void PackIndices(const aiMesh* mesh, uint32_t begin, uint32_t end, uint32_t* out)
+        {
+            for (uint32_t f = begin; f < end; ++f)
+            {
+                const aiFace& face = mesh->mFaces[f];
+                std::copy_n(face.mIndices, face.mNumIndices, out);
+                out += face.mNumIndices;
+            }
+        }
+    } // namespace
+
+    void ExtractAssimpMeshes(const aiScene* assimp_scene, std::vector<float>& vertices, std::vector<uint32_t>& indices, std::vector<MeshVNext>& meshes, uint32_t& vertex_offset, uint32_t& index_offset)
+    {
+        if (!assimp_scene || !assimp_scene->HasMeshes())
+        {
+            return;
+        }
+
+        const uint32_t                   mesh_count = assimp_scene->mNumMeshes;
+        std::vector<MeshExtractionRange> ranges(mesh_count);
+
+        /*
+         * (1) Index counts need a walk over the faces, it is done per mesh in parallel
+         */
+        ThreadPoolHelper::ParallelFor(mesh_count, 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m)
+            {
+                CountMeshIndices(assimp_scene->mMeshes[m], ranges[m]);
+            }
+        });
+
+        /*
+         * (2) Prefix sums give every mesh its own slice of the outputs, which are sized once
+         */
+        size_t                           vertex_total = 0;
+        size_t                           index_total  = 0;
+        std::vector<MeshExtractionChunk> chunks;
+        for (uint32_t m = 0; m < mesh_count; ++m)
+        {
+            const aiMesh* mesh       = assimp_scene->mMeshes[m];
+            auto&         range      = ranges[m];
+            range.VertexFirst        = vertex_total;
+            range.IndexFirst         = index_total;
+            vertex_total            += mesh->mNumVertices;
+            index_total             += range.IndexCount;
+
+            for (uint32_t v = 0; v < mesh->mNumVertices; v += VertexChunkSize)
+            {
+                chunks.push_back({.Mesh = m, .Begin = v, .End = std::min(v + VertexChunkSize, mesh->mNumVertices), .Faces = false});
+            }
+
+            uint32_t face_chunk_size = (range.FaceSize > 0) ? FaceChunkSize : std::max(mesh->mNumFaces, 1u);
+            for (uint32_t f = 0; f < mesh->mNumFaces; f += face_chunk_size)
+            {
+                chunks.push_back({.Mesh = m, .Begin = f, .End = std::min(f + face_chunk_size, mesh->mNumFaces), .Faces = true});
+            }
+        }
+
+        const size_t first_vertex_float = vertices.size();
+        const size_t first_index        = indices.size();
+        vertices.resize(first_vertex_float + vertex_total * VertexComponentCount);
+        indices.resize(first_index + index_total);
+
+        /*
+         * (3) Slices are disjoint, chunks are packed without synchronization. Bounds are kept per chunk and reduced below.
+         */
+        std::vector<BoundingBox> chunk_bounds(chunks.size());
+        ThreadPoolHelper::ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c)
+            {
+                const auto&   chunk = chunks[c];
+                const aiMesh* mesh  = assimp_scene->mMeshes[chunk.Mesh];
+                const auto&   range = ranges[chunk.Mesh];
+                if (chunk.Faces)
+                {
+                    size_t index_first = range.IndexFirst + size_t(chunk.Begin) * range.FaceSize;
+                    PackIndices(mesh, chunk.Begin, chunk.End, indices.data() + first_index + index_first);
+                }
+                else
+                {
+                    size_t vertex_first = range.VertexFirst + chunk.Begin;
+                    chunk_bounds[c]     = PackVertices(mesh, chunk.Begin, chunk.End, vertices.data() + first_vertex_float + vertex_first * VertexComponentCount);
+                }
+            }
+        });
+
+        std::vector<BoundingBox> mesh_bounds(mesh_count);
+        for (size_t c = 0; c < chunks.size(); ++c)
+        {
+            if (!chunks[c].Faces)
+            {
+                mesh_bounds[chunks[c].Mesh].Expand(chunk_bounds[c]);
+            }
+        }
+
+        meshes.reserve(meshes.size() + mesh_count);
+        for (uint32_t m = 0; m < mesh_count; ++m)
+        {
+            MeshVNext& mesh           = meshes.emplace_back();
+            mesh.VertexCount          = assimp_scene->mMeshes[m]->mNumVertices;
+            mesh.VertexOffset         = vertex_offset + uint32_t(ranges[m].VertexFirst);
+            mesh.VertexUnitStreamSize = sizeof(float) * VertexComponentCount;
+            mesh.StreamOffset         = (mesh.VertexUnitStreamSize * mesh.VertexOffset);
+            mesh.IndexOffset          = index_offset + uint32_t(ranges[m].IndexFirst);
+            mesh.IndexCount           = ranges[m].IndexCount;
+            mesh.IndexUnitStreamSize  = sizeof(uint32_t);
+            mesh.IndexStreamOffset    = (mesh.IndexUnitStreamSize * mesh.IndexOffset);
+            mesh.TotalByteSize        = (mesh.VertexCount * mesh.VertexUnitStreamSize) + (mesh.IndexCount * mesh.IndexUnitStreamSize);
+            mesh.FaceSize             = ranges[m].FaceSize;
+            mesh.Bounds               = mesh_bounds[m];
+        }
+
+        vertex_offset += uint32_t(vertex_total);
+        index_offset  += uint32_t(index_total);
+    }
+} // namespace ZEngine::Helpers
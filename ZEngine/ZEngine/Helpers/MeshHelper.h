@@ -7,4 +7,10 @@ namespace ZEngine::Helpers
     Rendering::Meshes::MeshVNext              CreateBuiltInMesh(Rendering::Meshes::MeshType mesh_type);
     bool                                      ExtractMeshFromAssimpSceneNode(aiNode* const scene_root_node, std::vector<uint32_t>* const mesh_id_collection_ptr);
     std::vector<Rendering::Meshes::MeshVNext> ConvertAssimpMeshToZEngineMeshModel(const aiScene* assimp_scene, const std::vector<uint32_t>& assimp_mesh_ids);
+    /*
+     * Appends the meshes of the scene, in scene order : interleaved vertices (position, normal, uv), indices and one MeshVNext per mesh.
+     * vertex_offset and index_offset locate the first appended vertex and index and are advanced past the appended data.
+     * Output ranges are sized up front from the mesh sizes, then filled in parallel.
+     */
+    void                                      ExtractAssimpMeshes(const aiScene* assimp_scene, std::vector<float>& vertices, std::vector<uint32_t>& indices, std::vector<Rendering::Meshes::MeshVNext>& meshes, uint32_t& vertex_offset, uint32_t& index_offset);
 } // namespace ZEngine::Helpers
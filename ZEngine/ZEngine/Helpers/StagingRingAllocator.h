@@ -0,0 +1,166 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+namespace ZEngine::Helpers
+{
+    /*
+     * Bookkeeping of a persistently mapped upload buffer used as a ring : allocations are carved at the head, in order, and
+     * given back at the tail once the GPU work reading them is known to be complete.
+     *
+     * Every allocation is tagged with the fence value of the submission that reads it (Submit), Retire then releases the oldest
+     * allocations whose value was reached. Retirement stays in allocation order : an allocation not yet submitted keeps the ones
+     * behind it alive. An allocation that doesn't fit before the end of the buffer restarts at offset 0, the skipped tail is
+     * accounted to it and comes back with it.
+     */
+    class StagingRingAllocator
+    {
+    public:
+        static constexpr size_t   InvalidOffset = std::numeric_limits<size_t>::max();
+        static constexpr uint64_t NotSubmitted  = std::numeric_limits<uint64_t>::max();
+
+        StagingRingAllocator(size_t capacity = 0) : m_capacity(capacity) {}
+
+        /*
+         * Forgets every allocation, the caller makes sure the GPU no longer reads any of them
+         */
+        void Reset(size_t capacity)
+        {
+            m_capacity  = capacity;
+            m_head      = 0;
+            m_tail      = 0;
+            m_used_size = 0;
+            m_allocations.clear();
+        }
+
+        size_t Capacity() const
+        {
+            return m_capacity;
+        }
+
+        size_t UsedByteSize() const
+        {
+            return m_used_size;
+        }
+
+        size_t AllocationCount() const
+        {
+            return m_allocations.size();
+        }
+
+        /*
+         * Returns the offset of byte_size bytes aligned on alignment (a power of two), InvalidOffset when the ring has no room left
+         */
+        size_t Allocate(size_t byte_size, size_t alignment = 1)
+        {
+            if ((byte_size == 0) || (byte_size > m_capacity))
+            {
+                return InvalidOffset;
+            }
+
+            size_t offset = AlignUp(m_head, alignment);
+            size_t end    = offset + byte_size;
+
+            if (m_used_size == 0)
+            {
+                /* Nothing in flight : restarting at 0 keeps the whole buffer contiguous */
+                m_head = m_tail = 0;
+                offset          = 0;
+                end             = byte_size;
+            }
+            else if (m_head > m_tail)
+            {
+                /* Free space is [head, capacity) then [0, tail) */
+                if (end > m_capacity)
+                {
+                    if (byte_size > m_tail)
+                    {
+                        return InvalidOffset;
+                    }
+                    offset = 0;
+                    end    = byte_size;
+                }
+            }
+            else
+            {
+                /* Free space is [head, tail) */
+                if (end > m_tail)
+                {
+                    return InvalidOffset;
+                }
+            }
+
+            /* Padding and skipped tail of the buffer belong to the allocation, they are released with it */
+            size_t reserved_size  = (offset >= m_head) ? (end - m_head) : ((m_capacity - m_head) + end);
+            m_head                = (end == m_capacity) ? 0 : end;
+            m_used_size          += reserved_size;
+            m_allocations.push_back(Allocation{.Offset = offset, .End = m_head, .ReservedSize = reserved_size, .FenceValue = NotSubmitted});
+            return offset;
+        }
+
+        /*
+         * The allocation at offset is read by GPU work signaling fence_value when done
+         */
+        bool Submit(size_t offset, uint64_t fence_value)
+        {
+            for (auto it = m_allocations.rbegin(); it != m_allocations.rend(); ++it)
+            {
+                if ((it->Offset == offset) && (it->FenceValue == NotSubmitted))
+                {
+                    it->FenceValue = fence_value;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*
+         * Releases, from the oldest, every submitted allocation whose fence value is reached. Returns the released byte size
+         */
+        size_t Retire(uint64_t completed_fence_value)
+        {
+            size_t released_size = 0;
+            while (!m_allocations.empty())
+            {
+                const auto& oldest = m_allocations.front();
+                if ((oldest.FenceValue == NotSubmitted) || (oldest.FenceValue > completed_fence_value))
+                {
+                    break;
+                }
+
+                m_tail         = oldest.End;
+                m_used_size   -= oldest.ReservedSize;
+                released_size += oldest.ReservedSize;
+                m_allocations.pop_front();
+            }
+
+            if (m_allocations.empty())
+            {
+                m_head = m_tail = 0;
+            }
+            return released_size;
+        }
+
+    private:
+        struct Allocation
+        {
+            size_t   Offset;
+            size_t   End;
+            size_t   ReservedSize;
+            uint64_t FenceValue;
+        };
+
+        size_t                 m_capacity  = 0;
+        size_t                 m_head      = 0;
+        size_t                 m_tail      = 0;
+        size_t                 m_used_size = 0;
+        std::deque<Allocation> m_allocations;
+
+        static size_t          AlignUp(size_t value, size_t alignment)
+        {
+            return (alignment > 1) ? ((value + alignment - 1) & ~(alignment - 1)) : value;
+        }
+    };
+} // namespace ZEngine::Helpers
@@ -3,5 +3,171 @@
 
 namespace ZEngine::Helpers
 {
-    Scope<ThreadPool> ThreadPoolHelper::m_threadPool = CreateScope<ThreadPool>();
-}
\ No newline at end of file
+    static thread_local ThreadPool* s_current_pool   = nullptr;
+    static thread_local size_t      s_current_worker = 0;
+
+    Scope<ThreadPool>               ThreadPoolHelper::m_threadPool    = CreateScope<ThreadPool>();
+    std::atomic<void (*)()>         ThreadPool::s_completion_observer = nullptr;
+
+    ThreadPool::ThreadPool(size_t maxThreadCount) : m_maxThreadCount(std::max<size_t>(1, maxThreadCount))
+    {
+        m_queues.reserve(m_maxThreadCount);
+        for (size_t i = 0; i < m_maxThreadCount; ++i)
+        {
+            m_queues.emplace_back(std::make_unique<WorkStealingQueue>());
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        Shutdown();
+    }
+
+    void ThreadPool::Enqueue(std::function<void()>&& f, TaskPriority priority)
+    {
+        if (!f || m_cancellationToken.load())
+        {
+            return;
+        }
+
+        std::call_once(m_start_flag, [this] { StartWorkerThreads(); });
+
+        /*
+         * The pending counter and the sleeping counter form a handshake with WorkerThread() :
+         * either this thread observes a sleeping worker and wakes it, or the worker observes the new task before going to sleep.
+         * The counter is raised before the push so that it can never be observed lower than the number of queued tasks.
+         */
+        m_pending_task_count.fetch_add(1);
+
+        size_t queue_index = (s_current_pool == this) ? s_current_worker : (m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size());
+        m_queues[queue_index]->Push(std::move(f), priority);
+
+        if (m_sleeping_worker_count.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_idle_mutex);
+            }
+            m_idle_condition.notify_one();
+        }
+    }
+
+    void ThreadPool::Shutdown()
+    {
+        if (m_cancellationToken.exchange(true))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_idle_mutex);
+        }
+        m_idle_condition.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            if (!worker.joinable())
+            {
+                continue;
+            }
+
+            if (worker.get_id() == std::this_thread::get_id())
+            {
+                worker.detach();
+                continue;
+            }
+            worker.join();
+        }
+        m_workers.clear();
+
+        for (auto& queue : m_queues)
+        {
+            queue->Clear();
+        }
+        m_pending_task_count = 0;
+    }
+
+    size_t ThreadPool::WorkerCount() const
+    {
+        return m_workers.size();
+    }
+
+    size_t ThreadPool::PendingTaskCount() const
+    {
+        return m_pending_task_count.load();
+    }
+
+    void ThreadPool::SetCompletionObserver(void (*observer)())
+    {
+        s_completion_observer.store(observer);
+    }
+
+    void ThreadPool::NotifyCompletionObserver()
+    {
+        if (auto observer = s_completion_observer.load())
+        {
+            observer();
+        }
+    }
+
+    void ThreadPool::StartWorkerThreads()
+    {
+        m_workers.reserve(m_maxThreadCount);
+        for (size_t i = 0; i < m_maxThreadCount; ++i)
+        {
+            m_workers.emplace_back(&ThreadPool::WorkerThread, this, i);
+        }
+    }
+
+    void ThreadPool::WorkerThread(size_t worker_index)
+    {
+        s_current_pool   = this;
+        s_current_worker = worker_index;
+
+        std::function<void()> task;
+        while (!m_cancellationToken.load())
+        {
+            if (AcquireTask(worker_index, task))
+            {
+                m_pending_task_count.fetch_sub(1);
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_idle_mutex);
+            m_sleeping_worker_count.fetch_add(1);
+            m_idle_condition.wait(lock, [this] { return (m_pending_task_count.load() > 0) || m_cancellationToken.load(); });
+            m_sleeping_worker_count.fetch_sub(1);
+        }
+
+        s_current_pool = nullptr;
+    }
+
+    bool ThreadPool::AcquireTask(size_t worker_index, std::function<void()>& task)
+    {
+        const size_t queue_count = m_queues.size();
+
+        /*
+         * Priorities are honoured pool-wide : a worker drains its own deque and then steals from its siblings
+         * for a given priority class before looking at the next, lower one.
+         */
+        for (size_t p = 0; p < static_cast<size_t>(TaskPriority::COUNT); ++p)
+        {
+            auto priority = static_cast<TaskPriority>(p);
+
+            if (m_queues[worker_index]->Pop(task, priority))
+            {
+                return true;
+            }
+
+            for (size_t i = 1; i < queue_count; ++i)
+            {
+                if (m_queues[(worker_index + i) % queue_count]->Steal(task, priority))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+} // namespace ZEngine::Helpers
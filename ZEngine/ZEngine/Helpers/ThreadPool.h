@@ -1,87 +1,275 @@
 #pragma once
 #include <IntrusivePtr.h>
-#include <ThreadSafeQueue.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace ZEngine::Helpers
 {
+    enum class TaskPriority : uint8_t
+    {
+        High = 0,
+        Normal,
+        Low,
+        COUNT
+    };
 
-    class ThreadPool
+    /*
+     * Per-worker task storage.
+     * The owner thread pushes and pops at the back (LIFO, cache friendly) while other workers steal from the front (FIFO),
+     * so the owner and thieves rarely fight for the same end of the deque and never for a pool-wide lock.
+     */
+    class WorkStealingQueue
     {
     public:
-        ThreadPool(size_t maxThreadCount = std::thread::hardware_concurrency()) : m_maxThreadCount(maxThreadCount), m_taskQueue(CreateRef<ThreadSafeQueue<std::function<void()>>>()) {}
+        using Task = std::function<void()>;
 
-        ~ThreadPool()
+        void Push(Task&& task, TaskPriority priority)
         {
-            Shutdown();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks[static_cast<size_t>(priority)].emplace_back(std::move(task));
         }
 
-        void Enqueue(std::function<void()>&& f)
+        bool Pop(Task& task, TaskPriority priority)
         {
-            m_taskQueue->Emplace(std::forward<std::function<void()>>(f));
-            if (!m_taskQueue->Empty())
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto&                       tasks = m_tasks[static_cast<size_t>(priority)];
+            if (tasks.empty())
             {
-                StartWorkerThread();
+                return false;
             }
+            task = std::move(tasks.back());
+            tasks.pop_back();
+            return true;
         }
 
-        void Shutdown()
+        bool Steal(Task& task, TaskPriority priority)
         {
-            m_cancellationToken.exchange(true);
-            m_taskQueue->Clear();
+            std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                return false;
+            }
+
+            auto& tasks = m_tasks[static_cast<size_t>(priority)];
+            if (tasks.empty())
+            {
+                return false;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& tasks : m_tasks)
+            {
+                tasks.clear();
+            }
         }
 
     private:
-        size_t                                      m_maxThreadCount;
-        size_t                                      m_currentThreadCount{0};
-        std::atomic_bool                            m_cancellationToken{false};
-        std::mutex                                  m_mutex;
-        Ref<ThreadSafeQueue<std::function<void()>>> m_taskQueue;
+        std::mutex                                                             m_mutex;
+        std::array<std::deque<Task>, static_cast<size_t>(TaskPriority::COUNT)> m_tasks;
+    };
+
+    class ThreadPool
+    {
+    public:
+        ThreadPool(size_t maxThreadCount = std::thread::hardware_concurrency());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
 
-        static void                                 WorkerThread(WeakRef<ThreadSafeQueue<std::function<void()>>> weakQueue, const std::atomic_bool& cancellationToken)
+        /*
+         * Fire-and-forget submission.
+         * When called from one of this pool's workers the task lands on that worker's own deque, otherwise it is
+         * distributed round-robin across the workers.
+         */
+        void        Enqueue(std::function<void()>&& f, TaskPriority priority = TaskPriority::Normal);
+
+        /*
+         * Submission with a result the caller can wait on.
+         * Tasks still queued when the pool is shut down are dropped and their future reports std::future_errc::broken_promise.
+         */
+        template <typename F>
+        auto EnqueueWithResult(F&& f, TaskPriority priority = TaskPriority::Normal) -> std::future<std::invoke_result_t<std::decay_t<F>>>
         {
-            while (auto queue = weakQueue.lock())
-            {
-                queue->Wait(cancellationToken);
+            using ResultType = std::invoke_result_t<std::decay_t<F>>;
 
-                if (cancellationToken == true)
-                {
-                    break;
-                }
+            auto task        = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(f));
+            auto future      = task->get_future();
+            Enqueue(
+                [task] {
+                    (*task)();
+                    NotifyCompletionObserver();
+                },
+                priority);
+            return future;
+        }
 
-                std::function<void()> task;
-                if (!queue->Pop(task))
-                {
-                    continue;
-                }
-                task();
+        /*
+         * Called on the worker once the task of an EnqueueWithResult() has set its future, e.g to resume what awaits it
+         * without polling the future. nullptr removes it
+         */
+        static void SetCompletionObserver(void (*observer)());
+
+        /*
+         * Stops the workers and joins them. Running tasks are allowed to complete, pending ones are discarded.
+         */
+        void        Shutdown();
+
+        size_t      WorkerCount() const;
+        size_t      PendingTaskCount() const;
+
+    private:
+        size_t                                          m_maxThreadCount;
+        std::once_flag                                  m_start_flag;
+        std::atomic_bool                                m_cancellationToken{false};
+        std::atomic_size_t                              m_pending_task_count{0};
+        std::atomic_size_t                              m_sleeping_worker_count{0};
+        std::atomic_size_t                              m_next_queue{0};
+        std::mutex                                      m_idle_mutex;
+        std::condition_variable                         m_idle_condition;
+        std::vector<std::unique_ptr<WorkStealingQueue>> m_queues;
+        std::vector<std::thread>                        m_workers;
+
+        static std::atomic<void (*)()>                  s_completion_observer;
+
+        static void                                     NotifyCompletionObserver();
+        void                                            StartWorkerThreads();
+        void                                            WorkerThread(size_t worker_index);
+        bool                                            AcquireTask(size_t worker_index, std::function<void()>& task);
+    };
+
+    struct ThreadPoolHelper
+    {
+        template <typename T>
+        static auto Submit(T&& f, TaskPriority priority = TaskPriority::Normal)
+        {
+            if (!m_threadPool)
+            {
+                m_threadPool = CreateScope<ThreadPool>();
+            }
+            return m_threadPool->EnqueueWithResult(std::forward<T>(f), priority);
+        }
+
+        template <typename T>
+        static void Post(T&& f, TaskPriority priority = TaskPriority::Normal)
+        {
+            if (!m_threadPool)
+            {
+                m_threadPool = CreateScope<ThreadPool>();
             }
+            m_threadPool->Enqueue(std::function<void()>(std::forward<T>(f)), priority);
         }
 
-        void StartWorkerThread()
+        /*
+         * Splits [0, count) into batches of batch_size items and runs callback(begin, end) on each of them.
+         * The calling thread takes part in the work and helpers only pull batches that nobody claimed yet, so waiting here
+         * never depends on a queued task being picked up : calling it from a pool worker, or while the pool is shut down, is safe.
+         * The first exception thrown by a batch is rethrown once every claimed batch has completed.
+         * max_concurrency bounds the number of threads working on the batches, the calling thread included (0 : one per hardware thread, plus the caller).
+         */
+        template <typename TCallback>
+        static void ParallelFor(size_t count, size_t batch_size, TCallback&& callback, TaskPriority priority = TaskPriority::High, size_t max_concurrency = 0)
         {
+            if (count == 0)
+            {
+                return;
+            }
+
+            batch_size         = std::max<size_t>(batch_size, 1);
+            size_t batch_count = (count + batch_size - 1) / batch_size;
+            if (batch_count == 1)
+            {
+                callback(size_t(0), count);
+                return;
+            }
+
+            struct ParallelForState
             {
-                std::unique_lock<std::mutex> lock(m_mutex);
-                if (m_currentThreadCount < m_maxThreadCount)
+                std::atomic_size_t                  NextBatch{0};
+                std::atomic_size_t                  CompletedBatch{0};
+                size_t                              Count      = 0;
+                size_t                              BatchSize  = 0;
+                size_t                              BatchCount = 0;
+                std::remove_reference_t<TCallback>* Callback   = nullptr;
+                std::mutex                          ExceptionMutex;
+                std::exception_ptr                  Exception;
+
+                void                                Run()
                 {
-                    std::thread(ThreadPool::WorkerThread, m_taskQueue.Weak(), std::cref(m_cancellationToken)).detach();
-                    m_currentThreadCount++;
+                    for (size_t batch = NextBatch.fetch_add(1); batch < BatchCount; batch = NextBatch.fetch_add(1))
+                    {
+                        size_t begin = batch * BatchSize;
+                        try
+                        {
+                            (*Callback)(begin, std::min(begin + BatchSize, Count));
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard<std::mutex> lock(ExceptionMutex);
+                            if (!Exception)
+                            {
+                                Exception = std::current_exception();
+                            }
+                        }
+
+                        if (CompletedBatch.fetch_add(1) + 1 == BatchCount)
+                        {
+                            CompletedBatch.notify_all();
+                        }
+                    }
                 }
+            };
+
+            /*
+             * Shared with the helpers : one may only start running after this call has returned, it then finds no batch left
+             */
+            auto state        = std::make_shared<ParallelForState>();
+            state->Count      = count;
+            state->BatchSize  = batch_size;
+            state->BatchCount = batch_count;
+            state->Callback   = &callback;
+
+            size_t max_helper_count = (max_concurrency > 0) ? (max_concurrency - 1) : std::max(std::thread::hardware_concurrency(), 1u);
+            size_t helper_count     = std::min<size_t>(batch_count - 1, max_helper_count);
+            for (size_t i = 0; i < helper_count; ++i)
+            {
+                Post([state] { state->Run(); }, priority);
+            }
+
+            state->Run();
+
+            for (size_t completed = state->CompletedBatch.load(); completed < batch_count; completed = state->CompletedBatch.load())
+            {
+                state->CompletedBatch.wait(completed);
+            }
+
+            if (state->Exception)
+            {
+                std::rethrow_exception(state->Exception);
             }
         }
-    };
 
-    struct ThreadPoolHelper
-    {
-        template <typename T>
-        static void Submit(T&& f)
+        static void Shutdown()
         {
-            if (!m_threadPool)
+            if (m_threadPool)
             {
-                m_threadPool = CreateScope<ThreadPool>();
+                m_threadPool->Shutdown();
             }
-            m_threadPool->Enqueue(std::move(f));
         }
 
     private:
@@ -90,4 +278,4 @@ namespace ZEngine::Helpers
 
         static Scope<ThreadPool> m_threadPool;
     };
-} // namespace ZEngine::Helpers
\ No newline at end of file
+} // namespace ZEngine::Helpers
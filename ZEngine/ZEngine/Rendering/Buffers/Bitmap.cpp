@@ -0,0 +1,476 @@
+#include <pch.h>
+#include <Rendering/Buffers/Bitmap.h>
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ZENGINE_BITMAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define ZENGINE_BITMAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ZEngine::Rendering::Buffers
+{
+    namespace
+    {
+        /*
+         * Support of the Kaiser filter in destination texels, and the shape of its window
+         */
+        constexpr float KaiserRadius = 3.0f;
+        constexpr float KaiserAlpha  = 4.0f;
+
+        /*
+         * Four float lanes, one texel : the filters only ever multiply-add whole texels
+         */
+#if defined(ZENGINE_BITMAP_SSE2)
+        using Lanes = __m128;
+
+        inline Lanes LoadLanes(const float* source)
+        {
+            return _mm_loadu_ps(source);
+        }
+
+        inline void StoreLanes(float* destination, Lanes value)
+        {
+            _mm_storeu_ps(destination, value);
+        }
+
+        inline Lanes ZeroLanes()
+        {
+            return _mm_setzero_ps();
+        }
+
+        inline Lanes MultiplyAdd(Lanes accumulator, Lanes value, float weight)
+        {
+            return _mm_add_ps(accumulator, _mm_mul_ps(value, _mm_set1_ps(weight)));
+        }
+#elif defined(ZENGINE_BITMAP_NEON)
+        using Lanes = float32x4_t;
+
+        inline Lanes LoadLanes(const float* source)
+        {
+            return vld1q_f32(source);
+        }
+
+        inline void StoreLanes(float* destination, Lanes value)
+        {
+            vst1q_f32(destination, value);
+        }
+
+        inline Lanes ZeroLanes()
+        {
+            return vdupq_n_f32(0.0f);
+        }
+
+        inline Lanes MultiplyAdd(Lanes accumulator, Lanes value, float weight)
+        {
+            return vmlaq_n_f32(accumulator, value, weight);
+        }
+#else
+        struct Lanes
+        {
+            float Values[4];
+        };
+
+        inline Lanes LoadLanes(const float* source)
+        {
+            return Lanes{{source[0], source[1], source[2], source[3]}};
+        }
+
+        inline void StoreLanes(float* destination, Lanes value)
+        {
+            std::copy_n(value.Values, 4, destination);
+        }
+
+        inline Lanes ZeroLanes()
+        {
+            return Lanes{{0.0f, 0.0f, 0.0f, 0.0f}};
+        }
+
+        inline Lanes MultiplyAdd(Lanes accumulator, Lanes value, float weight)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                accumulator.Values[i] += value.Values[i] * weight;
+            }
+            return accumulator;
+        }
+#endif
+
+        /*
+         * Full precision working copy of a level : four floats per texel whatever the channel count, colors in linear space
+         */
+        struct LinearImage
+        {
+            int                Width  = 0;
+            int                Height = 0;
+            std::vector<float> Texels = {};
+
+            float*             Row(int y)
+            {
+                return Texels.data() + size_t(y) * size_t(Width) * 4;
+            }
+
+            const float*       Row(int y) const
+            {
+                return Texels.data() + size_t(y) * size_t(Width) * 4;
+            }
+        };
+
+        /*
+         * Source texels and weights of every destination texel along one axis, TapCount of them each (zero weights pad the
+         * shorter ones). Indices are clamped to the edge.
+         */
+        struct FilterTaps
+        {
+            int                TapCount = 0;
+            std::vector<int>   Indices  = {};
+            std::vector<float> Weights  = {};
+        };
+
+        /*
+         * Which channels hold color, as opposed to alpha : grey-alpha bitmaps keep their alpha in the second channel
+         */
+        inline int ColorChannelCount(int channel)
+        {
+            return (channel == 2) ? 1 : std::min(channel, 3);
+        }
+
+        float SrgbToLinear(float value)
+        {
+            return (value <= 0.04045f) ? (value / 12.92f) : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        const std::array<float, 256>& SrgbDecodeTable()
+        {
+            static const std::array<float, 256> table = [] {
+                std::array<float, 256> values = {};
+                for (int i = 0; i < 256; ++i)
+                {
+                    values[i] = SrgbToLinear(float(i) / 255.0f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        /*
+         * Linear value at the midpoint between two consecutive sRGB codes : encoding is a search in this table, and rounds to the
+         * nearest code in sRGB space exactly
+         */
+        const std::array<float, 255>& SrgbEncodeThresholds()
+        {
+            static const std::array<float, 255> thresholds = [] {
+                std::array<float, 255> values = {};
+                for (int i = 0; i < 255; ++i)
+                {
+                    values[i] = SrgbToLinear((float(i) + 0.5f) / 255.0f);
+                }
+                return values;
+            }();
+            return thresholds;
+        }
+
+        inline uint8_t LinearToSrgbByte(float value)
+        {
+            const auto& thresholds = SrgbEncodeThresholds();
+            return uint8_t(std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin());
+        }
+
+        inline uint8_t UnormToByte(float value)
+        {
+            return uint8_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+
+        float BesselI0(float x)
+        {
+            float sum  = 1.0f;
+            float term = 1.0f;
+            for (int k = 1; k < 32; ++k)
+            {
+                term *= (x * 0.5f) / float(k);
+                sum  += term * term;
+                if (term * term < sum * 1e-9f)
+                {
+                    break;
+                }
+            }
+            return sum;
+        }
+
+        float Sinc(float x)
+        {
+            if (std::abs(x) < 1e-6f)
+            {
+                return 1.0f;
+            }
+            const float pi_x = glm::pi<float>() * x;
+            return std::sin(pi_x) / pi_x;
+        }
+
+        /*
+         * t in destination texels from the destination texel center
+         */
+        float KaiserWeight(float t)
+        {
+            const float ratio = t / KaiserRadius;
+            if (std::abs(ratio) >= 1.0f)
+            {
+                return 0.0f;
+            }
+            return Sinc(t) * BesselI0(KaiserAlpha * std::sqrt(1.0f - ratio * ratio)) / BesselI0(KaiserAlpha);
+        }
+
+        FilterTaps ComputeTaps(int source_size, int destination_size, MipFilter filter)
+        {
+            const float                     scale = float(source_size) / float(destination_size);
+            std::vector<std::vector<int>>   indices(destination_size);
+            std::vector<std::vector<float>> weights(destination_size);
+            FilterTaps                      taps;
+
+            for (int d = 0; d < destination_size; ++d)
+            {
+                const float center = (float(d) + 0.5f) * scale;
+                const float radius = (filter == MipFilter::BOX) ? (0.5f * scale) : (KaiserRadius * scale);
+                const int   first  = int(std::floor(center - radius));
+                const int   last   = int(std::ceil(center + radius));
+                float       sum    = 0.0f;
+
+                for (int i = first; i < last; ++i)
+                {
+                    float weight = 0.0f;
+                    if (filter == MipFilter::BOX)
+                    {
+                        /* Overlap of the source texel [i, i + 1) with the footprint of the destination texel */
+                        weight = std::min(float(i + 1), center + radius) - std::max(float(i), center - radius);
+                    }
+                    else
+                    {
+                        weight = KaiserWeight((float(i) + 0.5f - center) / scale);
+                    }
+
+                    if (weight != 0.0f)
+                    {
+                        indices[d].push_back(std::clamp(i, 0, source_size - 1));
+                        weights[d].push_back(weight);
+                        sum += weight;
+                    }
+                }
+
+                for (auto& weight : weights[d])
+                {
+                    weight /= sum;
+                }
+                taps.TapCount = std::max(taps.TapCount, int(weights[d].size()));
+            }
+
+            taps.Indices.assign(size_t(destination_size) * taps.TapCount, 0);
+            taps.Weights.assign(size_t(destination_size) * taps.TapCount, 0.0f);
+            for (int d = 0; d < destination_size; ++d)
+            {
+                std::copy(indices[d].begin(), indices[d].end(), taps.Indices.begin() + size_t(d) * taps.TapCount);
+                std::copy(weights[d].begin(), weights[d].end(), taps.Weights.begin() + size_t(d) * taps.TapCount);
+            }
+            return taps;
+        }
+
+        /*
+         * Renormalizes the normals, and keeps byte sized levels in the range they can be stored in : what the next level is
+         * filtered from must be what this level holds, up to the rounding
+         */
+        void FinalizeLevel(LinearImage& image, const Bitmap& format, const MipChainOptions& options)
+        {
+            const bool is_normal_map = options.IsNormalMap && (format.Channel >= 3);
+            const bool is_clamped    = format.Format == BitmapFormat::UNSIGNED_BYTE;
+
+            for (size_t i = 0; i < image.Texels.size(); i += 4)
+            {
+                float* texel = &image.Texels[i];
+                if (is_normal_map)
+                {
+                    const float length = std::sqrt(texel[0] * texel[0] + texel[1] * texel[1] + texel[2] * texel[2]);
+                    if (length > 1e-8f)
+                    {
+                        texel[0] /= length;
+                        texel[1] /= length;
+                        texel[2] /= length;
+                    }
+                    else
+                    {
+                        texel[0] = 0.0f;
+                        texel[1] = 0.0f;
+                        texel[2] = 1.0f;
+                    }
+                }
+
+                if (is_clamped)
+                {
+                    for (int c = is_normal_map ? 3 : 0; c < 4; ++c)
+                    {
+                        texel[c] = std::clamp(texel[c], 0.0f, 1.0f);
+                    }
+                }
+            }
+        }
+
+        LinearImage ToLinear(const Bitmap& input_map, const MipChainOptions& options)
+        {
+            const bool   is_normal_map = options.IsNormalMap && (input_map.Channel >= 3);
+            const bool   is_srgb       = options.IsSrgb && !is_normal_map && (input_map.Format == BitmapFormat::UNSIGNED_BYTE);
+            const int    color_count   = ColorChannelCount(input_map.Channel);
+            const auto&  srgb_table    = SrgbDecodeTable();
+            const size_t texel_count   = size_t(input_map.Width) * size_t(input_map.Height);
+
+            LinearImage  image         = {.Width = input_map.Width, .Height = input_map.Height, .Texels = std::vector<float>(texel_count * 4, 0.0f)};
+
+            for (size_t i = 0; i < texel_count; ++i)
+            {
+                float* texel = &image.Texels[i * 4];
+                for (int c = 0; c < input_map.Channel; ++c)
+                {
+                    if (input_map.Format == BitmapFormat::FLOAT)
+                    {
+                        texel[c] = reinterpret_cast<const float*>(input_map.Buffer.data())[i * input_map.Channel + c];
+                    }
+                    else
+                    {
+                        uint8_t value = input_map.Buffer[i * input_map.Channel + c];
+                        texel[c]      = (is_srgb && (c < color_count)) ? srgb_table[value] : float(value) / 255.0f;
+                    }
+                }
+
+                if (is_normal_map)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        texel[c] = texel[c] * 2.0f - 1.0f;
+                    }
+                }
+            }
+
+            if (is_normal_map)
+            {
+                FinalizeLevel(image, input_map, options);
+            }
+            return image;
+        }
+
+        Bitmap FromLinear(const LinearImage& image, const Bitmap& format, const MipChainOptions& options)
+        {
+            const bool   is_normal_map = options.IsNormalMap && (format.Channel >= 3);
+            const bool   is_srgb       = options.IsSrgb && !is_normal_map && (format.Format == BitmapFormat::UNSIGNED_BYTE);
+            const int    color_count   = ColorChannelCount(format.Channel);
+            const size_t texel_count   = size_t(image.Width) * size_t(image.Height);
+
+            Bitmap       output(image.Width, image.Height, format.Channel, format.Format);
+
+            for (size_t i = 0; i < texel_count; ++i)
+            {
+                const float* texel = &image.Texels[i * 4];
+                for (int c = 0; c < format.Channel; ++c)
+                {
+                    float value = texel[c];
+                    if (is_normal_map && (c < 3))
+                    {
+                        value = value * 0.5f + 0.5f;
+                    }
+
+                    if (format.Format == BitmapFormat::FLOAT)
+                    {
+                        reinterpret_cast<float*>(output.Buffer.data())[i * format.Channel + c] = value;
+                    }
+                    else
+                    {
+                        output.Buffer[i * format.Channel + c] = (is_srgb && (c < color_count)) ? LinearToSrgbByte(value) : UnormToByte(value);
+                    }
+                }
+            }
+            return output;
+        }
+
+        /*
+         * Separable resampling : rows first into a (destination width x source height) image, then columns
+         */
+        LinearImage Resample(const LinearImage& source, int width, int height, MipFilter filter)
+        {
+            const FilterTaps horizontal   = ComputeTaps(source.Width, width, filter);
+            const FilterTaps vertical     = ComputeTaps(source.Height, height, filter);
+
+            LinearImage      intermediate = {.Width = width, .Height = source.Height, .Texels = std::vector<float>(size_t(width) * source.Height * 4)};
+            for (int y = 0; y < source.Height; ++y)
+            {
+                const float* source_row = source.Row(y);
+                float*       row        = intermediate.Row(y);
+                for (int x = 0; x < width; ++x)
+                {
+                    const int*   indices     = &horizontal.Indices[size_t(x) * horizontal.TapCount];
+                    const float* weights     = &horizontal.Weights[size_t(x) * horizontal.TapCount];
+                    Lanes        accumulator = ZeroLanes();
+                    for (int k = 0; k < horizontal.TapCount; ++k)
+                    {
+                        accumulator = MultiplyAdd(accumulator, LoadLanes(source_row + size_t(indices[k]) * 4), weights[k]);
+                    }
+                    StoreLanes(row + size_t(x) * 4, accumulator);
+                }
+            }
+
+            LinearImage destination = {.Width = width, .Height = height, .Texels = std::vector<float>(size_t(width) * height * 4)};
+            for (int y = 0; y < height; ++y)
+            {
+                const int*   indices = &vertical.Indices[size_t(y) * vertical.TapCount];
+                const float* weights = &vertical.Weights[size_t(y) * vertical.TapCount];
+                float*       row     = destination.Row(y);
+                for (int x = 0; x < width; ++x)
+                {
+                    Lanes accumulator = ZeroLanes();
+                    for (int k = 0; k < vertical.TapCount; ++k)
+                    {
+                        accumulator = MultiplyAdd(accumulator, LoadLanes(intermediate.Row(indices[k]) + size_t(x) * 4), weights[k]);
+                    }
+                    StoreLanes(row + size_t(x) * 4, accumulator);
+                }
+            }
+            return destination;
+        }
+    } // namespace
+
+    uint32_t Bitmap::MipLevelCount(uint32_t width, uint32_t height)
+    {
+        uint32_t level_count = 1;
+        for (uint32_t size = std::max(width, height); size > 1; size /= 2)
+        {
+            level_count++;
+        }
+        return level_count;
+    }
+
+    Bitmap Bitmap::Downsample(const Bitmap& input_map, const MipChainOptions& options)
+    {
+        ZENGINE_VALIDATE_ASSERT((input_map.Type == BitmapType::TEXTURE_2D) && (input_map.Depth == 1), "Only 2D bitmaps can be downsampled")
+
+        LinearImage level = Resample(ToLinear(input_map, options), std::max(1, input_map.Width / 2), std::max(1, input_map.Height / 2), options.Filter);
+        FinalizeLevel(level, input_map, options);
+        return FromLinear(level, input_map, options);
+    }
+
+    std::vector<Bitmap> Bitmap::GenerateMipChain(const Bitmap& level_0, const MipChainOptions& options)
+    {
+        ZENGINE_VALIDATE_ASSERT((level_0.Type == BitmapType::TEXTURE_2D) && (level_0.Depth == 1), "Only 2D bitmaps can be downsampled")
+
+        std::vector<Bitmap> levels;
+        uint32_t            level_count = MipLevelCount(uint32_t(level_0.Width), uint32_t(level_0.Height));
+        levels.reserve(level_count - 1);
+
+        LinearImage previous = ToLinear(level_0, options);
+        for (uint32_t i = 1; i < level_count; ++i)
+        {
+            LinearImage level = Resample(previous, std::max(1, previous.Width / 2), std::max(1, previous.Height / 2), options.Filter);
+            FinalizeLevel(level, level_0, options);
+            levels.emplace_back(FromLinear(level, level_0, options));
+            previous = std::move(level);
+        }
+        return levels;
+    }
+} // namespace ZEngine::Rendering::Buffers
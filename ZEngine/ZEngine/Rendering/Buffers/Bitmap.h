@@ -21,6 +21,31 @@ namespace ZEngine::Rendering::Buffers
         FLOAT
     };
 
+    enum class MipFilter : uint8_t
+    {
+        /*
+         * Area average of the texels under each destination texel
+         */
+        BOX,
+        /*
+         * Kaiser windowed sinc : sharper than the box, keeps the detail that survives at the smaller size
+         */
+        KAISER
+    };
+
+    struct MipChainOptions
+    {
+        MipFilter Filter      = MipFilter::KAISER;
+        /*
+         * Color channels are filtered in linear space and stored back as sRGB. Alpha is always linear
+         */
+        bool      IsSrgb      = true;
+        /*
+         * Tangent space normals stored as [0, 1] : filtered as vectors and renormalized at every level
+         */
+        bool      IsNormalMap = false;
+    };
+
     struct BitmapPixel
     {
         /*
@@ -162,12 +187,32 @@ namespace ZEngine::Rendering::Buffers
                 return Bitmap();
             }
 
-            const int        face_size      = input_map.Width / 4;
+            Bitmap vertical_cross = CreateVerticalCross(input_map);
+            EquirectangularMapToVerticalCross(input_map, vertical_cross, 0, VerticalCrossLineCount(input_map));
+            return vertical_cross;
+        }
 
-            const int        width          = face_size * 3;
-            const int        height         = face_size * 4;
+        /*
+         * Destination of EquirectangularMapToVerticalCross : 3 x 4 faces of a quarter of the input width
+         */
+        inline static Bitmap CreateVerticalCross(const Bitmap& input_map)
+        {
+            const int face_size = input_map.Width / 4;
+            return Bitmap(face_size * 3, face_size * 4, input_map.Channel, input_map.Format);
+        }
+
+        /*
+         * The projection runs one face line at a time, 6 faces of face_size lines. Lines write disjoint pixels : any split of
+         * [0, VerticalCrossLineCount) can run concurrently and yields the same image.
+         */
+        inline static size_t VerticalCrossLineCount(const Bitmap& input_map)
+        {
+            return size_t(6) * size_t(input_map.Width / 4);
+        }
 
-            Bitmap           vertical_cross = Bitmap(width, height, input_map.Channel, input_map.Format);
+        inline static void EquirectangularMapToVerticalCross(const Bitmap& input_map, Bitmap& vertical_cross, size_t line_begin, size_t line_end)
+        {
+            const int        face_size      = input_map.Width / 4;
 
             const glm::ivec2 face_offsets[] = {
                 glm::ivec2{    face_size, face_size * 3},
@@ -181,39 +226,38 @@ namespace ZEngine::Rendering::Buffers
             const int clamped_width  = input_map.Width - 1;
             const int clamped_height = input_map.Height - 1;
 
-            for (int face = 0; face < 6; ++face)
+            for (size_t line = line_begin; line < line_end; ++line)
             {
-                for (int i = 0; i < face_size; ++i)
+                const int face = int(line / face_size);
+                const int i    = int(line % face_size);
+
+                for (int j = 0; j < face_size; ++j)
                 {
-                    for (int j = 0; j < face_size; ++j)
-                    {
-                        const glm::vec3 P     = BitmapPixel::FaceCoordToXYZ(i, j, face, face_size);
-                        const float     R     = hypot(P.x, P.y);
-                        const float     theta = atan2(P.y, P.x);
-                        const float     phi   = atan2(P.z, R);
+                    const glm::vec3 P     = BitmapPixel::FaceCoordToXYZ(i, j, face, face_size);
+                    const float     R     = hypot(P.x, P.y);
+                    const float     theta = atan2(P.y, P.x);
+                    const float     phi   = atan2(P.z, R);
 
-                        const float     Uf    = float(2.0f * face_size * (theta + glm::pi<float>()) / glm::pi<float>());
-                        const float     Vf    = float(2.0f * face_size * (glm::pi<float>() / 2.0f - phi) / glm::pi<float>());
+                    const float     Uf    = float(2.0f * face_size * (theta + glm::pi<float>()) / glm::pi<float>());
+                    const float     Vf    = float(2.0f * face_size * (glm::pi<float>() / 2.0f - phi) / glm::pi<float>());
 
-                        const int       U1    = glm::clamp(int(floor(Uf)), 0, clamped_width);
-                        const int       V1    = glm::clamp(int(floor(Vf)), 0, clamped_height);
-                        const int       U2    = glm::clamp(U1 + 1, 0, clamped_width);
-                        const int       V2    = glm::clamp(V1 + 1, 0, clamped_height);
+                    const int       U1    = glm::clamp(int(floor(Uf)), 0, clamped_width);
+                    const int       V1    = glm::clamp(int(floor(Vf)), 0, clamped_height);
+                    const int       U2    = glm::clamp(U1 + 1, 0, clamped_width);
+                    const int       V2    = glm::clamp(V1 + 1, 0, clamped_height);
 
-                        const float     s     = Uf - U1;
-                        const float     t     = Vf - V1;
+                    const float     s     = Uf - U1;
+                    const float     t     = Vf - V1;
 
-                        const glm::vec4 A     = input_map.GetPixel(U1, V1);
-                        const glm::vec4 B     = input_map.GetPixel(U2, V1);
-                        const glm::vec4 C     = input_map.GetPixel(U1, V2);
-                        const glm::vec4 D     = input_map.GetPixel(U2, V2);
+                    const glm::vec4 A     = input_map.GetPixel(U1, V1);
+                    const glm::vec4 B     = input_map.GetPixel(U2, V1);
+                    const glm::vec4 C     = input_map.GetPixel(U1, V2);
+                    const glm::vec4 D     = input_map.GetPixel(U2, V2);
 
-                        const glm::vec4 color = A * (1 - s) * (1 - t) + B * (s) * (1 - t) + C * (1 - s) * t + D * (s) * (t);
-                        vertical_cross.SetPixel(i + face_offsets[face].x, j + face_offsets[face].y, color);
-                    }
+                    const glm::vec4 color = A * (1 - s) * (1 - t) + B * (s) * (1 - t) + C * (1 - s) * t + D * (s) * (t);
+                    vertical_cross.SetPixel(i + face_offsets[face].x, j + face_offsets[face].y, color);
                 }
             }
-            return vertical_cross;
         }
 
         inline static Bitmap VerticalCrossToCubemap(const Bitmap& input_map)
@@ -292,12 +336,25 @@ namespace ZEngine::Rendering::Buffers
             return cubemap;
         }
 
-        int                  Width   = 0;
-        int                  Height  = 0;
-        int                  Depth   = 1;
-        int                  Channel = 3;
-        BitmapType           Type    = BitmapType::TEXTURE_2D;
-        BitmapFormat         Format  = BitmapFormat::UNSIGNED_BYTE;
-        std::vector<uint8_t> Buffer  = {};
+        /*
+         * Levels of a full chain down to 1x1
+         */
+        static uint32_t            MipLevelCount(uint32_t width, uint32_t height);
+        /*
+         * Next level of a 2D bitmap, half the size rounded down. Any channel count, UNSIGNED_BYTE or FLOAT (always linear)
+         */
+        static Bitmap              Downsample(const Bitmap& input_map, const MipChainOptions& options);
+        /*
+         * Every level after level_0, each filtered from the full precision result of the previous one
+         */
+        static std::vector<Bitmap> GenerateMipChain(const Bitmap& level_0, const MipChainOptions& options);
+
+        int                        Width   = 0;
+        int                        Height  = 0;
+        int                        Depth   = 1;
+        int                        Channel = 3;
+        BitmapType                 Type    = BitmapType::TEXTURE_2D;
+        BitmapFormat               Format  = BitmapFormat::UNSIGNED_BYTE;
+        std::vector<uint8_t>       Buffer  = {};
     };
 } // namespace ZEngine::Rendering::Buffers
\ No newline at end of file
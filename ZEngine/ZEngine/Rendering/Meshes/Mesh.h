@@ -1,8 +1,10 @@
 #pragma once
 #include <Rendering/GPUTypes.h>
 #include <ZEngineDef.h>
+#include <limits>
 
 #define INVALID_MAP_HANDLE 0xFFFFFFFFu
+#define MAX_MESH_LOD_COUNT 4
 
 namespace ZEngine::Rendering::Meshes
 {
@@ -15,17 +17,135 @@ namespace ZEngine::Rendering::Meshes
         SQUARE = 3
     };
 
+    /*
+     * Axis-aligned bounding box, a default constructed box is empty (Min > Max) and grows with Expand()
+     */
+    struct BoundingBox
+    {
+        glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        bool      Valid() const
+        {
+            return (Min.x <= Max.x) && (Min.y <= Max.y) && (Min.z <= Max.z);
+        }
+
+        glm::vec3 Center() const
+        {
+            return (Min + Max) * 0.5f;
+        }
+
+        glm::vec3 Extents() const
+        {
+            return (Max - Min) * 0.5f;
+        }
+
+        void Expand(const glm::vec3& point)
+        {
+            Min = glm::min(Min, point);
+            Max = glm::max(Max, point);
+        }
+
+        void Expand(const BoundingBox& box)
+        {
+            Min = glm::min(Min, box.Min);
+            Max = glm::max(Max, box.Max);
+        }
+
+        /*
+         * Smallest box enclosing this one once transformed (J. Arvo, Graphics Gems 1990), an empty box stays empty
+         */
+        BoundingBox Transform(const glm::mat4& transform) const
+        {
+            if (!Valid())
+            {
+                return {};
+            }
+
+            glm::vec3 center        = glm::vec3(transform * glm::vec4(Center(), 1.0f));
+            glm::vec3 extents       = Extents();
+            glm::vec3 world_extents = glm::vec3(0.0f);
+            for (int column = 0; column < 3; ++column)
+            {
+                world_extents += glm::abs(glm::vec3(transform[column])) * extents[column];
+            }
+            return BoundingBox{.Min = center - world_extents, .Max = center + world_extents};
+        }
+    };
+
     struct MeshVNext
     {
-        uint32_t VertexCount          = 0;
-        uint32_t IndexCount           = 0;
-        uint32_t VertexOffset         = 0;
-        uint32_t IndexOffset          = 0;
-        uint32_t StreamOffset         = 0;
-        uint32_t IndexStreamOffset    = 0;
-        uint32_t VertexUnitStreamSize = 0;
-        uint32_t IndexUnitStreamSize  = 0;
-        uint32_t TotalByteSize        = 0;
+        uint32_t    VertexCount          = 0;
+        uint32_t    IndexCount           = 0;
+        uint32_t    VertexOffset         = 0;
+        uint32_t    IndexOffset          = 0;
+        uint32_t    StreamOffset         = 0;
+        uint32_t    IndexStreamOffset    = 0;
+        uint32_t    VertexUnitStreamSize = 0;
+        uint32_t    IndexUnitStreamSize  = 0;
+        uint32_t    TotalByteSize        = 0;
+        /*
+         * Indices per face, 0 when the faces mix sizes. Only triangle lists (3) go through the index optimizations and meshlets.
+         */
+        uint32_t    FaceSize             = 3;
+        /*
+         * Bounds of the vertex positions, in mesh local space
+         */
+        BoundingBox Bounds               = {};
+    };
+
+    struct MeshLod
+    {
+        uint32_t IndexOffset = 0;
+        uint32_t IndexCount  = 0;
+        /*
+         * Simplification error bound, in mesh local units : vertices stay within that distance of the original surface
+         */
+        float    Error       = 0.0f;
+    };
+
+    /*
+     * Simplified levels of a mesh, coarser as the level grows. The full mesh (MeshVNext index range) is the implicit level 0.
+     * Levels index the same vertices as the mesh, their IndexOffset is absolute as MeshVNext::IndexOffset.
+     */
+    struct MeshLodChain
+    {
+        uint32_t LodCount                 = 0;
+        MeshLod  Lods[MAX_MESH_LOD_COUNT] = {};
+    };
+
+    /*
+     * Small cluster of a mesh triangles. Its vertices are MeshletVertices[VertexOffset, VertexOffset + VertexCount), read as the
+     * mesh indices (absolute vertex = MeshVNext::VertexOffset + value), and its triangles are 3 bytes each in MeshletTriangles
+     * from TriangleOffset, indexing the meshlet vertices.
+     */
+    struct Meshlet
+    {
+        uint32_t VertexOffset   = 0;
+        uint32_t TriangleOffset = 0;
+        uint32_t VertexCount    = 0;
+        uint32_t TriangleCount  = 0;
+        /*
+         * Bounding sphere, in mesh local space
+         */
+        float    Center[3]      = {0.0f, 0.0f, 0.0f};
+        float    Radius         = 0.0f;
+        /*
+         * Normal cone : every triangle is backfacing for a camera at c when dot(normalize(ConeApex - c), ConeAxis) >= ConeCutoff.
+         * A cutoff of 1 is a cone too wide to ever reject the meshlet.
+         */
+        float    ConeApex[3]    = {0.0f, 0.0f, 0.0f};
+        float    ConeAxis[3]    = {0.0f, 0.0f, 0.0f};
+        float    ConeCutoff     = 1.0f;
+    };
+
+    /*
+     * Meshlets of a mesh : Meshlets[MeshletOffset, MeshletOffset + MeshletCount)
+     */
+    struct MeshletRange
+    {
+        uint32_t MeshletOffset = 0;
+        uint32_t MeshletCount  = 0;
     };
 
     struct MeshMaterial
@@ -0,0 +1,419 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Meshes/MeshOptimizer.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace ZEngine::Helpers;
+
+namespace ZEngine::Rendering::Meshes
+{
+    namespace
+    {
+        /*
+         * Forsyth's scoring constants, the LRU cache modeled here is larger than the measured FIFO on purpose
+         */
+        constexpr uint32_t ScoringCacheSize  = 32;
+        constexpr float    CacheDecayPower   = 1.5f;
+        constexpr float    LastTriangleScore = 0.75f;
+        constexpr float    ValenceBoostScale = 2.0f;
+        constexpr float    ValenceBoostPower = 0.5f;
+
+        float VertexScore(int cache_position, uint32_t remaining_triangles)
+        {
+            if (remaining_triangles == 0)
+            {
+                return -1.0f;
+            }
+
+            float score = 0.0f;
+            if (cache_position >= 0)
+            {
+                if (cache_position < 3)
+                {
+                    score = LastTriangleScore;
+                }
+                else
+                {
+                    float scaler = 1.0f / float(ScoringCacheSize - 3);
+                    score        = std::pow(1.0f - float(cache_position - 3) * scaler, CacheDecayPower);
+                }
+            }
+            return score + ValenceBoostScale * std::pow(float(remaining_triangles), -ValenceBoostPower);
+        }
+
+        /*
+         * Every stage indexes per vertex arrays with the mesh indices, they only run on triangle lists whose indices are all in range
+         */
+        bool IsValidTriangleList(std::span<const uint32_t> indices, size_t vertex_count)
+        {
+            return (indices.size() % 3 == 0) && std::all_of(indices.begin(), indices.end(), [vertex_count](uint32_t index) { return index < vertex_count; });
+        }
+
+        struct IndexCluster
+        {
+            uint32_t TriangleBegin = 0;
+            uint32_t TriangleEnd   = 0;
+            float    SortKey       = 0.0f;
+        };
+    } // namespace
+
+    void VertexCacheStatistics::Accumulate(const VertexCacheStatistics& statistics)
+    {
+        TriangleCount       += statistics.TriangleCount;
+        VertexCount         += statistics.VertexCount;
+        TransformedVertices += statistics.TransformedVertices;
+        ACMR                 = TriangleCount ? float(TransformedVertices) / float(TriangleCount) : 0.0f;
+        ATVR                 = VertexCount ? float(TransformedVertices) / float(VertexCount) : 0.0f;
+    }
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertex_count, uint32_t cache_size)
+    {
+        VertexCacheStatistics statistics = {};
+        statistics.TriangleCount         = uint32_t(indices.size() / 3);
+        statistics.VertexCount           = vertex_count;
+
+        /*
+         * A vertex is in the FIFO when it was pushed less than cache_size misses ago
+         */
+        std::vector<uint32_t> pushed_at(vertex_count, 0);
+        uint32_t              timestamp = cache_size + 1;
+        for (uint32_t index : indices)
+        {
+            if (index >= vertex_count)
+            {
+                continue;
+            }
+
+            if (timestamp - pushed_at[index] > cache_size)
+            {
+                pushed_at[index] = timestamp++;
+                statistics.TransformedVertices++;
+            }
+        }
+
+        statistics.ACMR = statistics.TriangleCount ? float(statistics.TransformedVertices) / float(statistics.TriangleCount) : 0.0f;
+        statistics.ATVR = vertex_count ? float(statistics.TransformedVertices) / float(vertex_count) : 0.0f;
+        return statistics;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertex_count)
+    {
+        const uint32_t triangle_count = uint32_t(indices.size() / 3);
+        if (triangle_count == 0 || !IsValidTriangleList(indices, vertex_count))
+        {
+            return;
+        }
+
+        /*
+         * Vertex -> triangles adjacency, packed. remaining[v] counts the not yet emitted triangles at the front of the vertex slice.
+         */
+        std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+        for (uint32_t index : indices)
+        {
+            adjacency_offsets[index + 1]++;
+        }
+        std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+
+        std::vector<uint32_t> adjacency(triangle_count * 3);
+        std::vector<uint32_t> remaining(vertex_count, 0);
+        for (uint32_t t = 0; t < triangle_count; ++t)
+        {
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                uint32_t v                                     = indices[t * 3 + k];
+                adjacency[adjacency_offsets[v] + remaining[v]] = t;
+                remaining[v]++;
+            }
+        }
+
+        std::vector<int>   cache_position(vertex_count, -1);
+        std::vector<float> vertex_score(vertex_count);
+        for (uint32_t v = 0; v < vertex_count; ++v)
+        {
+            vertex_score[v] = VertexScore(-1, remaining[v]);
+        }
+
+        std::vector<float> triangle_score(triangle_count);
+        std::vector<bool>  emitted(triangle_count, false);
+        for (uint32_t t = 0; t < triangle_count; ++t)
+        {
+            triangle_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+        }
+
+        std::vector<uint32_t> output(triangle_count * 3);
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> next_cache;
+        cache.reserve(ScoringCacheSize + 3);
+        next_cache.reserve(ScoringCacheSize + 3);
+
+        uint32_t best_triangle = 0;
+        float    best_score    = triangle_score[0];
+        for (uint32_t t = 1; t < triangle_count; ++t)
+        {
+            if (triangle_score[t] > best_score)
+            {
+                best_score    = triangle_score[t];
+                best_triangle = t;
+            }
+        }
+
+        uint32_t scan_cursor = 0;
+        for (uint32_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count)
+        {
+            if (best_score < 0.0f)
+            {
+                /*
+                 * Nothing adjacent to the cache is left : restart from the next triangle in input order
+                 */
+                while (emitted[scan_cursor])
+                {
+                    scan_cursor++;
+                }
+                best_triangle = scan_cursor;
+            }
+
+            const uint32_t* triangle = &indices[best_triangle * 3];
+            std::copy_n(triangle, 3, &output[emitted_count * 3]);
+            emitted[best_triangle] = true;
+
+            /*
+             * Drop the triangle from its vertices adjacency and move its vertices to the front of the cache
+             */
+            next_cache.clear();
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                uint32_t  v     = triangle[k];
+                uint32_t* begin = &adjacency[adjacency_offsets[v]];
+                uint32_t* end   = begin + remaining[v];
+                std::swap(*std::find(begin, end, best_triangle), *(end - 1));
+                remaining[v]--;
+                next_cache.push_back(v);
+            }
+            for (uint32_t v : cache)
+            {
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                {
+                    next_cache.push_back(v);
+                }
+            }
+
+            for (size_t i = 0; i < next_cache.size(); ++i)
+            {
+                uint32_t v        = next_cache[i];
+                cache_position[v] = (i < ScoringCacheSize) ? int(i) : -1;
+                vertex_score[v]   = VertexScore(cache_position[v], remaining[v]);
+            }
+            if (next_cache.size() > ScoringCacheSize)
+            {
+                next_cache.resize(ScoringCacheSize);
+            }
+            std::swap(cache, next_cache);
+
+            /*
+             * Only triangles around cached vertices changed score, the next triangle is searched among them
+             */
+            best_score = -1.0f;
+            for (uint32_t v : cache)
+            {
+                for (uint32_t a = 0; a < remaining[v]; ++a)
+                {
+                    uint32_t t        = adjacency[adjacency_offsets[v] + a];
+                    float    score    = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+                    triangle_score[t] = score;
+                    if (score > best_score)
+                    {
+                        best_score    = score;
+                        best_triangle = t;
+                    }
+                }
+            }
+        }
+
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::span<uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, uint32_t cache_size, float threshold)
+    {
+        const uint32_t triangle_count = uint32_t(indices.size() / 3);
+        if ((triangle_count < 2) || (positions.size() < size_t(vertex_count) * position_stride) || !IsValidTriangleList(indices, vertex_count))
+        {
+            return;
+        }
+
+        /*
+         * Clusters end where the FIFO simulation misses every vertex of a triangle : the cache restarts there, so moving clusters
+         * around mostly keeps the cache efficiency of the input order
+         */
+        std::vector<IndexCluster> clusters;
+        std::vector<uint32_t>     pushed_at(vertex_count, 0);
+        uint32_t                  timestamp = cache_size + 1;
+        for (uint32_t t = 0; t < triangle_count; ++t)
+        {
+            uint32_t misses = 0;
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                uint32_t v = indices[t * 3 + k];
+                if (timestamp - pushed_at[v] > cache_size)
+                {
+                    pushed_at[v] = timestamp++;
+                    misses++;
+                }
+            }
+
+            if (clusters.empty() || misses == 3)
+            {
+                clusters.push_back({.TriangleBegin = t, .TriangleEnd = t});
+            }
+            clusters.back().TriangleEnd = t + 1;
+        }
+
+        if (clusters.size() < 2)
+        {
+            return;
+        }
+
+        auto position_fn = [&](uint32_t v) {
+            const float* p = &positions[v * position_stride];
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+
+        /*
+         * Area weighted centroids, of the mesh and of every cluster, and the cluster average normal
+         */
+        glm::vec3              mesh_centroid(0.0f);
+        float                  mesh_area = 0.0f;
+        std::vector<float>     cluster_area(clusters.size(), 0.0f);
+        std::vector<glm::vec3> cluster_centroid(clusters.size(), glm::vec3(0.0f));
+        std::vector<glm::vec3> cluster_normal(clusters.size(), glm::vec3(0.0f));
+        for (size_t c = 0; c < clusters.size(); ++c)
+        {
+            for (uint32_t t = clusters[c].TriangleBegin; t < clusters[c].TriangleEnd; ++t)
+            {
+                glm::vec3 p0     = position_fn(indices[t * 3]);
+                glm::vec3 p1     = position_fn(indices[t * 3 + 1]);
+                glm::vec3 p2     = position_fn(indices[t * 3 + 2]);
+                glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                float     area   = glm::length(normal);
+                glm::vec3 center = (p0 + p1 + p2) / 3.0f;
+
+                cluster_centroid[c] += center * area;
+                cluster_normal[c]   += normal;
+                cluster_area[c]     += area;
+            }
+            mesh_centroid += cluster_centroid[c];
+            mesh_area     += cluster_area[c];
+        }
+        mesh_centroid = (mesh_area > 0.0f) ? mesh_centroid / mesh_area : mesh_centroid;
+
+        for (size_t c = 0; c < clusters.size(); ++c)
+        {
+            glm::vec3 centroid  = (cluster_area[c] > 0.0f) ? cluster_centroid[c] / cluster_area[c] : glm::vec3(0.0f);
+            float     length    = glm::length(cluster_normal[c]);
+            glm::vec3 normal    = (length > 0.0f) ? cluster_normal[c] / length : glm::vec3(0.0f);
+            clusters[c].SortKey = glm::dot(centroid - mesh_centroid, normal);
+        }
+
+        std::stable_sort(clusters.begin(), clusters.end(), [](const IndexCluster& a, const IndexCluster& b) { return a.SortKey > b.SortKey; });
+
+        std::vector<uint32_t> reordered;
+        reordered.reserve(triangle_count * 3);
+        for (const auto& cluster : clusters)
+        {
+            reordered.insert(reordered.end(), indices.begin() + cluster.TriangleBegin * 3, indices.begin() + cluster.TriangleEnd * 3);
+        }
+
+        float acmr_before = AnalyzeVertexCache(indices, vertex_count, cache_size).ACMR;
+        float acmr_after  = AnalyzeVertexCache(reordered, vertex_count, cache_size).ACMR;
+        if (acmr_after <= acmr_before * threshold)
+        {
+            std::copy(reordered.begin(), reordered.end(), indices.begin());
+        }
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::span<uint32_t> indices, std::span<float> vertices, size_t vertex_stride)
+    {
+        const size_t vertex_count = vertices.size() / vertex_stride;
+        if (vertex_count == 0 || !IsValidTriangleList(indices, vertex_count))
+        {
+            return;
+        }
+
+        constexpr uint32_t    Unassigned = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> remap(vertex_count, Unassigned);
+        uint32_t              next_vertex = 0;
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == Unassigned)
+            {
+                remap[index] = next_vertex++;
+            }
+            index = remap[index];
+        }
+
+        for (size_t v = 0; v < vertex_count; ++v)
+        {
+            if (remap[v] == Unassigned)
+            {
+                remap[v] = next_vertex++;
+            }
+        }
+
+        std::vector<float> reordered(vertices.size());
+        for (size_t v = 0; v < vertex_count; ++v)
+        {
+            std::copy_n(&vertices[v * vertex_stride], vertex_stride, &reordered[remap[v] * vertex_stride]);
+        }
+        std::copy(reordered.begin(), reordered.end(), vertices.begin());
+    }
+
+    MeshOptimizationStatistics MeshOptimizer::OptimizeMeshes(std::span<float> vertices, size_t vertex_stride, std::span<uint32_t> indices, std::span<const MeshVNext> meshes, const MeshOptimizationOptions& options)
+    {
+        std::vector<MeshOptimizationStatistics> mesh_statistics(meshes.size());
+
+        ThreadPoolHelper::ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m)
+            {
+                const auto& mesh          = meshes[m];
+                auto        mesh_indices  = indices.subspan(mesh.IndexOffset, mesh.IndexCount);
+                auto        mesh_vertices = vertices.subspan(size_t(mesh.VertexOffset) * vertex_stride, size_t(mesh.VertexCount) * vertex_stride);
+                auto&       statistics    = mesh_statistics[m];
+
+                /*
+                 * Line and point meshes are kept by the importer, they are left as they are and out of the statistics
+                 */
+                if ((mesh.FaceSize != 3) || !IsValidTriangleList(mesh_indices, mesh.VertexCount))
+                {
+                    continue;
+                }
+
+                statistics.Before = AnalyzeVertexCache(mesh_indices, mesh.VertexCount, options.CacheSize);
+                if (options.Enabled)
+                {
+                    if (options.VertexCache)
+                    {
+                        OptimizeVertexCache(mesh_indices, mesh.VertexCount);
+                    }
+                    if (options.Overdraw)
+                    {
+                        OptimizeOverdraw(mesh_indices, mesh_vertices, vertex_stride, mesh.VertexCount, options.CacheSize, options.OverdrawThreshold);
+                    }
+                    if (options.VertexFetch)
+                    {
+                        OptimizeVertexFetch(mesh_indices, mesh_vertices, vertex_stride);
+                    }
+                }
+                statistics.After = AnalyzeVertexCache(mesh_indices, mesh.VertexCount, options.CacheSize);
+            }
+        });
+
+        MeshOptimizationStatistics total = {};
+        for (const auto& statistics : mesh_statistics)
+        {
+            total.Before.Accumulate(statistics.Before);
+            total.After.Accumulate(statistics.After);
+        }
+        return total;
+    }
+} // namespace ZEngine::Rendering::Meshes
@@ -0,0 +1,81 @@
+#pragma once
+#include <Rendering/Meshes/Mesh.h>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Rendering::Meshes
+{
+    struct MeshOptimizationOptions
+    {
+        bool     Enabled           = true;
+        bool     VertexCache       = true;
+        bool     Overdraw          = true;
+        bool     VertexFetch       = true;
+        /*
+         * Overdraw ordering may cost that much vertex cache efficiency : 1.05 accepts an ACMR up to 5% worse than the cache optimized order
+         */
+        float    OverdrawThreshold = 1.05f;
+        /*
+         * FIFO size used to measure ACMR/ATVR, a conservative value for post-transform caches of current GPUs
+         */
+        uint32_t CacheSize         = 16;
+    };
+
+    struct VertexCacheStatistics
+    {
+        uint32_t TriangleCount       = 0;
+        uint32_t VertexCount         = 0;
+        uint32_t TransformedVertices = 0;
+        /*
+         * Average cache miss ratio : transformed vertices per triangle, 0.5 at best on regular grids and 3 at worst
+         */
+        float    ACMR                = 0.0f;
+        /*
+         * Average transformed vertex ratio : transformed vertices per vertex, 1 at best
+         */
+        float    ATVR                = 0.0f;
+
+        void     Accumulate(const VertexCacheStatistics& statistics);
+    };
+
+    struct MeshOptimizationStatistics
+    {
+        VertexCacheStatistics Before = {};
+        VertexCacheStatistics After  = {};
+    };
+
+    /*
+     * Index buffer reordering for the GPU vertex pipeline, indices are triangle lists local to their mesh.
+     * A stage leaves its inputs untouched when the index count isn't a multiple of 3 or an index is past the vertex count,
+     * and OptimizeMeshes skips the meshes whose FaceSize isn't 3.
+     */
+    struct MeshOptimizer
+    {
+        /*
+         * Simulates a FIFO post-transform cache of cache_size entries
+         */
+        static VertexCacheStatistics      AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertex_count, uint32_t cache_size = 16);
+        /*
+         * Reorders triangles for post-transform cache locality (Forsyth, "Linear-Speed Vertex Cache Optimisation")
+         */
+        static void                       OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertex_count);
+        /*
+         * Splits the cache optimized order at its cache restarts, then sorts the clusters so the ones facing away from the mesh center
+         * come first : outer surfaces are drawn before the ones they hide. The order is kept when ACMR grows past threshold.
+         * positions are read at positions[vertex * position_stride], in floats.
+         */
+        static void                       OptimizeOverdraw(std::span<uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, uint32_t cache_size = 16, float threshold = 1.05f);
+        /*
+         * Renumbers vertices in first use order and permutes the vertex data (vertex_stride floats per vertex) to match, so vertex
+         * fetches walk memory forward. Unreferenced vertices are moved at the end.
+         */
+        static void                       OptimizeVertexFetch(std::span<uint32_t> indices, std::span<float> vertices, size_t vertex_stride);
+
+        /*
+         * Runs the enabled stages on every mesh, meshes are processed in parallel.
+         * Vertices are interleaved (vertex_stride floats, position first), mesh vertex and index ranges come from VertexOffset/IndexOffset
+         * relative to the first element of the spans.
+         */
+        static MeshOptimizationStatistics OptimizeMeshes(std::span<float> vertices, size_t vertex_stride, std::span<uint32_t> indices, std::span<const MeshVNext> meshes, const MeshOptimizationOptions& options = {});
+    };
+} // namespace ZEngine::Rendering::Meshes
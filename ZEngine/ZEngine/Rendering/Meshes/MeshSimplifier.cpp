@@ -0,0 +1,404 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Meshes/MeshOptimizer.h>
+#include <Rendering/Meshes/MeshSimplifier.h>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+using namespace ZEngine::Helpers;
+
+namespace ZEngine::Rendering::Meshes
+{
+    namespace
+    {
+        /*
+         * Symmetric 4x4 matrix of the squared distance to a set of planes, in double : sums of many planes lose precision in float
+         */
+        struct Quadric
+        {
+            double A00 = 0.0;
+            double A01 = 0.0;
+            double A02 = 0.0;
+            double A11 = 0.0;
+            double A12 = 0.0;
+            double A22 = 0.0;
+            double B0  = 0.0;
+            double B1  = 0.0;
+            double B2  = 0.0;
+            double C   = 0.0;
+
+            static Quadric FromPlane(const glm::vec3& normal, float distance)
+            {
+                double a = normal.x;
+                double b = normal.y;
+                double c = normal.z;
+                double d = distance;
+
+                Quadric q = {};
+                q.A00     = a * a;
+                q.A01     = a * b;
+                q.A02     = a * c;
+                q.A11     = b * b;
+                q.A12     = b * c;
+                q.A22     = c * c;
+                q.B0      = a * d;
+                q.B1      = b * d;
+                q.B2      = c * d;
+                q.C       = d * d;
+                return q;
+            }
+
+            void Add(const Quadric& q)
+            {
+                A00 += q.A00;
+                A01 += q.A01;
+                A02 += q.A02;
+                A11 += q.A11;
+                A12 += q.A12;
+                A22 += q.A22;
+                B0  += q.B0;
+                B1  += q.B1;
+                B2  += q.B2;
+                C   += q.C;
+            }
+
+            double Evaluate(const glm::vec3& p) const
+            {
+                double x = p.x;
+                double y = p.y;
+                double z = p.z;
+                double r = A00 * x * x + A11 * y * y + A22 * z * z + 2.0 * (A01 * x * y + A02 * x * z + A12 * y * z) + 2.0 * (B0 * x + B1 * y + B2 * z) + C;
+                return std::max(r, 0.0);
+            }
+        };
+
+        struct EdgeCollapse
+        {
+            uint32_t From = 0;
+            uint32_t To   = 0;
+            double   Cost = 0.0;
+        };
+
+        /*
+         * Vertices that must not move : on an open border, or sharing their position with another vertex
+         */
+        std::vector<bool> FindLockedVertices(std::span<const uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count)
+        {
+            std::vector<bool> locked(vertex_count, false);
+
+            std::unordered_map<uint64_t, uint32_t> edge_use;
+            edge_use.reserve(indices.size());
+            for (size_t t = 0; t + 2 < indices.size(); t += 3)
+            {
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    uint32_t a = indices[t + k];
+                    uint32_t b = indices[t + (k + 1) % 3];
+                    edge_use[(uint64_t(std::min(a, b)) << 32) | std::max(a, b)]++;
+                }
+            }
+            for (const auto& [edge, count] : edge_use)
+            {
+                if (count == 1)
+                {
+                    locked[uint32_t(edge >> 32)]        = true;
+                    locked[uint32_t(edge & 0xFFFFFFFF)] = true;
+                }
+            }
+
+            struct PositionKey
+            {
+                float X, Y, Z;
+                bool  operator==(const PositionKey&) const = default;
+            };
+            struct PositionHash
+            {
+                size_t operator()(const PositionKey& key) const
+                {
+                    return std::hash<float>{}(key.X) ^ (std::hash<float>{}(key.Y) * 31) ^ (std::hash<float>{}(key.Z) * 131);
+                }
+            };
+
+            std::unordered_map<PositionKey, uint32_t, PositionHash> first_vertex;
+            first_vertex.reserve(vertex_count);
+            for (uint32_t v = 0; v < vertex_count; ++v)
+            {
+                const float* p      = &positions[v * position_stride];
+                auto [it, inserted] = first_vertex.try_emplace(PositionKey{p[0], p[1], p[2]}, v);
+                if (!inserted)
+                {
+                    locked[v]          = true;
+                    locked[it->second] = true;
+                }
+            }
+            return locked;
+        }
+    } // namespace
+
+    MeshSimplificationResult MeshSimplifier::Simplify(std::span<const uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, size_t target_index_count, float target_error)
+    {
+        MeshSimplificationResult result = {};
+        result.Indices.assign(indices.begin(), indices.begin() + (indices.size() / 3) * 3);
+        if (result.Indices.size() <= target_index_count || vertex_count == 0)
+        {
+            return result;
+        }
+
+        auto position_fn = [&](uint32_t v) {
+            const float* p = &positions[v * position_stride];
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+
+        /*
+         * Unit planes rather than area weighted ones : the quadric value is then a sum of squared distances, its square root bounds the
+         * distance to every accumulated plane
+         */
+        std::vector<Quadric> quadrics(vertex_count);
+        for (size_t t = 0; t < result.Indices.size(); t += 3)
+        {
+            uint32_t  v0     = result.Indices[t];
+            uint32_t  v1     = result.Indices[t + 1];
+            uint32_t  v2     = result.Indices[t + 2];
+            glm::vec3 p0     = position_fn(v0);
+            glm::vec3 normal = glm::cross(position_fn(v1) - p0, position_fn(v2) - p0);
+            float     length = glm::length(normal);
+            if (length <= 0.0f)
+            {
+                continue;
+            }
+            normal        = normal / length;
+            Quadric plane = Quadric::FromPlane(normal, -glm::dot(normal, p0));
+            quadrics[v0].Add(plane);
+            quadrics[v1].Add(plane);
+            quadrics[v2].Add(plane);
+        }
+
+        const std::vector<bool>   locked       = FindLockedVertices(result.Indices, positions, position_stride, vertex_count);
+        const double              max_cost     = double(target_error) * double(target_error);
+        double                    applied_cost = 0.0;
+        std::vector<uint32_t>     remap(vertex_count);
+        std::vector<bool>         touched(vertex_count);
+        std::vector<uint32_t>     adjacency_offsets(vertex_count + 1);
+        std::vector<uint32_t>     adjacency;
+        std::vector<EdgeCollapse> collapses;
+
+        while (result.Indices.size() > target_index_count)
+        {
+            const size_t triangle_count = result.Indices.size() / 3;
+
+            /*
+             * Vertex -> triangles adjacency of the current triangles
+             */
+            std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+            for (uint32_t index : result.Indices)
+            {
+                adjacency_offsets[index + 1]++;
+            }
+            std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+            adjacency.resize(result.Indices.size());
+            {
+                std::vector<uint32_t> cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+                for (size_t i = 0; i < result.Indices.size(); ++i)
+                {
+                    adjacency[cursor[result.Indices[i]]++] = uint32_t(i / 3);
+                }
+            }
+
+            /*
+             * Candidate collapses, both directions of every edge, cheapest first
+             */
+            collapses.clear();
+            for (size_t t = 0; t < triangle_count; ++t)
+            {
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    uint32_t a = result.Indices[t * 3 + k];
+                    uint32_t b = result.Indices[t * 3 + (k + 1) % 3];
+                    for (auto [from, to] : {std::pair{a, b}, std::pair{b, a}})
+                    {
+                        if (locked[from])
+                        {
+                            continue;
+                        }
+
+                        Quadric q = quadrics[from];
+                        q.Add(quadrics[to]);
+                        double cost = q.Evaluate(position_fn(to));
+                        if (cost <= max_cost)
+                        {
+                            collapses.push_back({.From = from, .To = to, .Cost = cost});
+                        }
+                    }
+                }
+            }
+            if (collapses.empty())
+            {
+                break;
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse& x, const EdgeCollapse& y) { return (x.Cost < y.Cost) || (x.Cost == y.Cost && (x.From < y.From || (x.From == y.From && x.To < y.To))); });
+
+            /*
+             * Independent collapses : a vertex and the one ring of a collapsed vertex are left alone for the rest of the pass, so the
+             * flip test below sees the triangles as they will be
+             */
+            std::iota(remap.begin(), remap.end(), 0u);
+            std::fill(touched.begin(), touched.end(), false);
+            size_t remaining_triangles = triangle_count;
+            size_t applied             = 0;
+            for (const auto& collapse : collapses)
+            {
+                if ((remaining_triangles * 3) <= target_index_count)
+                {
+                    break;
+                }
+                if (touched[collapse.From] || touched[collapse.To])
+                {
+                    continue;
+                }
+
+                /*
+                 * Triangles around From must not flip nor degenerate once From moves to To
+                 */
+                glm::vec3 target_position = position_fn(collapse.To);
+                size_t    removed         = 0;
+                bool      valid           = true;
+                for (uint32_t a = adjacency_offsets[collapse.From]; valid && a < adjacency_offsets[collapse.From + 1]; ++a)
+                {
+                    const uint32_t* triangle = &result.Indices[adjacency[a] * 3];
+                    if (triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To)
+                    {
+                        removed++;
+                        continue;
+                    }
+
+                    glm::vec3 p[3], moved[3];
+                    for (uint32_t k = 0; k < 3; ++k)
+                    {
+                        p[k]     = position_fn(triangle[k]);
+                        moved[k] = (triangle[k] == collapse.From) ? target_position : p[k];
+                    }
+                    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    glm::vec3 after  = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+                    float     scale  = glm::length(before) * glm::length(after);
+                    valid            = (scale > 0.0f) && (glm::dot(before, after) > 0.25f * scale);
+                }
+
+                if (!valid || removed == 0)
+                {
+                    continue;
+                }
+
+                remap[collapse.From] = collapse.To;
+                quadrics[collapse.To].Add(quadrics[collapse.From]);
+                applied_cost         = std::max(applied_cost, collapse.Cost);
+                remaining_triangles -= removed;
+                applied++;
+
+                for (uint32_t a = adjacency_offsets[collapse.From]; a < adjacency_offsets[collapse.From + 1]; ++a)
+                {
+                    const uint32_t* triangle = &result.Indices[adjacency[a] * 3];
+                    touched[triangle[0]]     = true;
+                    touched[triangle[1]]     = true;
+                    touched[triangle[2]]     = true;
+                }
+            }
+
+            if (applied == 0)
+            {
+                break;
+            }
+
+            /*
+             * Applies the pass collapses, degenerate triangles go away
+             */
+            size_t write = 0;
+            for (size_t t = 0; t < triangle_count; ++t)
+            {
+                uint32_t v0 = remap[result.Indices[t * 3]];
+                uint32_t v1 = remap[result.Indices[t * 3 + 1]];
+                uint32_t v2 = remap[result.Indices[t * 3 + 2]];
+                if (v0 == v1 || v1 == v2 || v0 == v2)
+                {
+                    continue;
+                }
+                result.Indices[write++] = v0;
+                result.Indices[write++] = v1;
+                result.Indices[write++] = v2;
+            }
+            result.Indices.resize(write);
+        }
+
+        result.Error = float(std::sqrt(applied_cost));
+        return result;
+    }
+
+    std::vector<MeshSimplificationResult> MeshSimplifier::GenerateLodChain(std::span<const uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, float target_error, const MeshLodOptions& options)
+    {
+        std::vector<MeshSimplificationResult> chain;
+        const size_t                          min_index_count = size_t(options.MinTriangleCount) * 3;
+        size_t                                previous_count  = (indices.size() / 3) * 3;
+        float                                 previous_error  = 0.0f;
+
+        for (uint32_t level = 0; level < std::min<uint32_t>(options.MaxLodCount, MAX_MESH_LOD_COUNT); ++level)
+        {
+            if (previous_count <= min_index_count)
+            {
+                break;
+            }
+
+            size_t target_count = std::max(size_t(float(previous_count / 3) * options.ReductionRatio) * 3, min_index_count);
+            auto   lod          = Simplify(indices, positions, position_stride, vertex_count, target_count, target_error);
+
+            /*
+             * Less than 10% fewer triangles : the error budget is spent, coarser levels would be the same
+             */
+            if (lod.Indices.empty() || lod.Indices.size() * 10 > previous_count * 9)
+            {
+                break;
+            }
+
+            lod.Error      = std::max(lod.Error, previous_error);
+            previous_count = lod.Indices.size();
+            previous_error = lod.Error;
+            chain.push_back(std::move(lod));
+        }
+        return chain;
+    }
+
+    void MeshSimplifier::GenerateMeshLods(std::span<const float> vertices, size_t vertex_stride, std::vector<uint32_t>& indices, std::span<const MeshVNext> meshes, std::vector<MeshLodChain>& lod_chains, const MeshLodOptions& options)
+    {
+        std::vector<std::vector<MeshSimplificationResult>> chains(meshes.size());
+
+        ThreadPoolHelper::ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m)
+            {
+                const auto& mesh          = meshes[m];
+                auto        mesh_indices  = std::span<const uint32_t>(indices).subspan(mesh.IndexOffset, mesh.IndexCount);
+                auto        mesh_vertices = vertices.subspan(size_t(mesh.VertexOffset) * vertex_stride, size_t(mesh.VertexCount) * vertex_stride);
+                glm::vec3   diagonal      = mesh.Bounds.Valid() ? (mesh.Bounds.Max - mesh.Bounds.Min) : glm::vec3(0.0f);
+                float       target_error  = options.MaxRelativeError * glm::length(diagonal);
+
+                chains[m] = GenerateLodChain(mesh_indices, mesh_vertices, vertex_stride, mesh.VertexCount, target_error, options);
+                for (auto& lod : chains[m])
+                {
+                    MeshOptimizer::OptimizeVertexCache(lod.Indices, mesh.VertexCount);
+                }
+            }
+        });
+
+        lod_chains.resize(meshes.size());
+        for (size_t m = 0; m < meshes.size(); ++m)
+        {
+            auto& lod_chain    = lod_chains[m];
+            lod_chain          = {};
+            lod_chain.LodCount = uint32_t(chains[m].size());
+            for (uint32_t level = 0; level < lod_chain.LodCount; ++level)
+            {
+                const auto& lod       = chains[m][level];
+                lod_chain.Lods[level] = {.IndexOffset = uint32_t(indices.size()), .IndexCount = uint32_t(lod.Indices.size()), .Error = lod.Error};
+                indices.insert(indices.end(), lod.Indices.begin(), lod.Indices.end());
+            }
+        }
+    }
+} // namespace ZEngine::Rendering::Meshes
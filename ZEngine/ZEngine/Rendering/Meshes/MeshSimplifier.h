@@ -0,0 +1,58 @@
+#pragma once
+#include <Rendering/Meshes/Mesh.h>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Rendering::Meshes
+{
+    struct MeshLodOptions
+    {
+        bool     Enabled          = true;
+        uint32_t MaxLodCount      = MAX_MESH_LOD_COUNT;
+        /*
+         * Every level targets that fraction of the triangles of the previous one
+         */
+        float    ReductionRatio   = 0.5f;
+        /*
+         * Largest error accepted for the coarsest level, relative to the mesh bounds diagonal
+         */
+        float    MaxRelativeError = 0.02f;
+        /*
+         * Meshes (and levels) with fewer triangles aren't simplified further
+         */
+        uint32_t MinTriangleCount = 64;
+    };
+
+    struct MeshSimplificationResult
+    {
+        std::vector<uint32_t> Indices = {};
+        float                 Error   = 0.0f;
+    };
+
+    /*
+     * Edge collapse simplification driven by quadric error metrics (Garland & Heckbert, "Surface Simplification Using Quadric Error
+     * Metrics"). Vertices collapse onto one of their neighbours, so simplified indices keep addressing the original vertex buffer.
+     * Border vertices and vertices sharing their position with another vertex (attribute seams) never move : levels keep the mesh
+     * outline and don't open cracks.
+     */
+    struct MeshSimplifier
+    {
+        /*
+         * Collapses edges, cheapest first, until the triangle list has at most target_index_count indices or the next collapse would
+         * move a vertex farther than target_error (in position units) from the planes of the triangles it replaced.
+         * positions are read at positions[vertex * position_stride], in floats.
+         */
+        static MeshSimplificationResult              Simplify(std::span<const uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, size_t target_index_count, float target_error);
+        /*
+         * Levels of decreasing triangle count, each one simplified from the full mesh. Errors are non decreasing, the chain stops
+         * when a level no longer reduces the previous one enough.
+         */
+        static std::vector<MeshSimplificationResult> GenerateLodChain(std::span<const uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, float target_error, const MeshLodOptions& options = {});
+        /*
+         * Builds the chains of every mesh in parallel. The level indices are appended to indices, mesh after mesh, and reordered for
+         * the vertex cache. lod_chains gets one chain per mesh.
+         * Vertices are interleaved (vertex_stride floats, position first), mesh indices are relative to their VertexOffset.
+         */
+        static void                                  GenerateMeshLods(std::span<const float> vertices, size_t vertex_stride, std::vector<uint32_t>& indices, std::span<const MeshVNext> meshes, std::vector<MeshLodChain>& lod_chains, const MeshLodOptions& options = {});
+    };
+} // namespace ZEngine::Rendering::Meshes
@@ -0,0 +1,386 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Meshes/MeshletBuilder.h>
+#include <algorithm>
+
+using namespace ZEngine::Helpers;
+
+namespace ZEngine::Rendering::Meshes
+{
+    namespace
+    {
+        constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+
+        glm::vec3          ReadPosition(std::span<const float> positions, size_t position_stride, uint32_t vertex)
+        {
+            const float* p = &positions[size_t(vertex) * position_stride];
+            return glm::vec3(p[0], p[1], p[2]);
+        }
+
+        /*
+         * Unit normal of a triangle, zero for a degenerate one
+         */
+        glm::vec3          TriangleNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+        {
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float     length = glm::length(normal);
+            return (length > 0.0f) ? normal / length : glm::vec3(0.0f);
+        }
+
+        /*
+         * Meshlet being grown : its vertices, their slot in the meshlet and its local triangles
+         */
+        struct MeshletBuilderState
+        {
+            std::vector<uint32_t> Vertices   = {};
+            std::vector<uint8_t>  Triangles  = {};
+            glm::vec3             NormalSum  = glm::vec3(0.0f);
+            BoundingBox           Bounds     = {};
+            std::vector<uint32_t> Candidates = {};
+        };
+    } // namespace
+
+    MeshletData MeshletBuilder::BuildMeshlets(std::span<const uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, const MeshletOptions& options)
+    {
+        MeshletData    data           = {};
+        const uint32_t max_vertices   = std::clamp<uint32_t>(options.MaxVertices, 3, MaxVertexLimit);
+        const uint32_t max_triangles  = std::clamp<uint32_t>(options.MaxTriangles, 1, MaxTriangleLimit);
+        const size_t   triangle_count = indices.size() / 3;
+        if (triangle_count == 0)
+        {
+            return data;
+        }
+
+        /*
+         * Only whole triangle lists whose indices address the given vertices are split, anything else gets no meshlet
+         */
+        bool in_range = std::all_of(indices.begin(), indices.end(), [vertex_count](uint32_t index) { return index < vertex_count; });
+        if ((indices.size() % 3 != 0) || !in_range || (positions.size() < size_t(vertex_count) * position_stride))
+        {
+            return data;
+        }
+
+        /*
+         * Triangles around every vertex, in compressed rows
+         */
+        std::vector<uint32_t> adjacency_offsets(size_t(vertex_count) + 1, 0);
+        std::vector<uint32_t> adjacency(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacency_offsets[indices[i] + 1]++;
+        }
+        for (uint32_t v = 0; v < vertex_count; ++v)
+        {
+            adjacency_offsets[v + 1] += adjacency_offsets[v];
+        }
+        std::vector<uint32_t> adjacency_cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacency[adjacency_cursor[indices[i]]++] = uint32_t(i / 3);
+        }
+
+        std::vector<glm::vec3> normals(triangle_count);
+        for (size_t t = 0; t < triangle_count; ++t)
+        {
+            normals[t] = TriangleNormal(ReadPosition(positions, position_stride, indices[t * 3]), ReadPosition(positions, position_stride, indices[t * 3 + 1]), ReadPosition(positions, position_stride, indices[t * 3 + 2]));
+        }
+
+        std::vector<uint8_t>  emitted(triangle_count, 0);
+        std::vector<uint32_t> candidate_stamps(triangle_count, InvalidSlot);
+        std::vector<uint32_t> slots(vertex_count, InvalidSlot);
+        MeshletBuilderState   state         = {};
+        size_t                seed_cursor   = 0;
+        size_t                emitted_count = 0;
+        uint32_t              meshlet_index = 0;
+
+        auto new_vertex_fn = [&](size_t triangle) {
+            const uint32_t* tri   = &indices[triangle * 3];
+            uint32_t        count = 0;
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                bool repeated = (corner > 0 && tri[corner] == tri[0]) || (corner > 1 && tri[corner] == tri[1]);
+                if ((slots[tri[corner]] == InvalidSlot) && !repeated)
+                {
+                    ++count;
+                }
+            }
+            return count;
+        };
+
+        auto flush_fn = [&]() {
+            if (state.Triangles.empty())
+            {
+                return;
+            }
+
+            Meshlet meshlet        = {};
+            meshlet.VertexOffset   = uint32_t(data.Vertices.size());
+            meshlet.TriangleOffset = uint32_t(data.Triangles.size());
+            meshlet.VertexCount    = uint32_t(state.Vertices.size());
+            meshlet.TriangleCount  = uint32_t(state.Triangles.size() / 3);
+
+            data.Vertices.insert(data.Vertices.end(), state.Vertices.begin(), state.Vertices.end());
+            data.Triangles.insert(data.Triangles.end(), state.Triangles.begin(), state.Triangles.end());
+            data.Triangles.resize((data.Triangles.size() + 3) & ~size_t(3), 0);
+
+            ComputeBounds(meshlet, state.Vertices, state.Triangles, positions, position_stride);
+            data.Meshlets.push_back(meshlet);
+
+            for (uint32_t vertex : state.Vertices)
+            {
+                slots[vertex] = InvalidSlot;
+            }
+            state = {};
+            ++meshlet_index;
+        };
+
+        auto add_fn = [&](size_t triangle) {
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertex = indices[triangle * 3 + corner];
+                if (slots[vertex] == InvalidSlot)
+                {
+                    slots[vertex] = uint32_t(state.Vertices.size());
+                    state.Vertices.push_back(vertex);
+                    state.Bounds.Expand(ReadPosition(positions, position_stride, vertex));
+
+                    for (uint32_t a = adjacency_offsets[vertex]; a < adjacency_offsets[vertex + 1]; ++a)
+                    {
+                        uint32_t neighbour = adjacency[a];
+                        if (!emitted[neighbour] && (candidate_stamps[neighbour] != meshlet_index))
+                        {
+                            candidate_stamps[neighbour] = meshlet_index;
+                            state.Candidates.push_back(neighbour);
+                        }
+                    }
+                }
+                state.Triangles.push_back(uint8_t(slots[vertex]));
+            }
+            state.NormalSum  += normals[triangle];
+            emitted[triangle] = 1;
+            ++emitted_count;
+        };
+
+        while (emitted_count < triangle_count)
+        {
+            if (state.Triangles.empty())
+            {
+                while (emitted[seed_cursor])
+                {
+                    ++seed_cursor;
+                }
+                add_fn(seed_cursor);
+            }
+            else
+            {
+                /*
+                 * Best neighbouring triangle that still fits, the candidates list drops the emitted ones on the way
+                 */
+                float     axis_length = glm::length(state.NormalSum);
+                glm::vec3 axis        = (axis_length > 0.0f) ? state.NormalSum / axis_length : glm::vec3(0.0f);
+                size_t    best        = triangle_count;
+                float     best_score  = std::numeric_limits<float>::max();
+                size_t    kept        = 0;
+                for (size_t c = 0; c < state.Candidates.size(); ++c)
+                {
+                    uint32_t triangle = state.Candidates[c];
+                    if (emitted[triangle])
+                    {
+                        continue;
+                    }
+                    state.Candidates[kept++] = triangle;
+
+                    uint32_t extra = new_vertex_fn(triangle);
+                    if (state.Vertices.size() + extra > max_vertices)
+                    {
+                        continue;
+                    }
+
+                    float score = float(extra) + options.ConeWeight * (1.0f - glm::dot(normals[triangle], axis));
+                    if (score < best_score)
+                    {
+                        best       = triangle;
+                        best_score = score;
+                    }
+                }
+                state.Candidates.resize(kept);
+
+                /*
+                 * Nothing connected is left (disconnected parts are common in CAD models) : the next triangle in input order
+                 * fills the meshlet when it fits and stays close, at most doubling the meshlet diagonal
+                 */
+                if ((kept == 0) && (best == triangle_count))
+                {
+                    while (emitted[seed_cursor])
+                    {
+                        ++seed_cursor;
+                    }
+
+                    BoundingBox grown = state.Bounds;
+                    for (int corner = 0; corner < 3; ++corner)
+                    {
+                        grown.Expand(ReadPosition(positions, position_stride, indices[seed_cursor * 3 + corner]));
+                    }
+                    bool fits  = (state.Vertices.size() + new_vertex_fn(seed_cursor)) <= max_vertices;
+                    bool close = glm::length(grown.Max - grown.Min) <= 2.0f * glm::length(state.Bounds.Max - state.Bounds.Min);
+                    if (fits && close)
+                    {
+                        best = seed_cursor;
+                    }
+                }
+
+                if (best == triangle_count)
+                {
+                    flush_fn();
+                    continue;
+                }
+                add_fn(best);
+            }
+
+            if (state.Triangles.size() / 3 >= max_triangles)
+            {
+                flush_fn();
+            }
+        }
+        flush_fn();
+
+        return data;
+    }
+
+    void MeshletBuilder::ComputeBounds(Meshlet& meshlet, std::span<const uint32_t> meshlet_vertices, std::span<const uint8_t> meshlet_triangles, std::span<const float> positions, size_t position_stride)
+    {
+        BoundingBox box = {};
+        for (uint32_t vertex : meshlet_vertices)
+        {
+            box.Expand(ReadPosition(positions, position_stride, vertex));
+        }
+
+        glm::vec3 center = box.Valid() ? box.Center() : glm::vec3(0.0f);
+        float     radius = 0.0f;
+        for (uint32_t vertex : meshlet_vertices)
+        {
+            radius = std::max(radius, glm::length(ReadPosition(positions, position_stride, vertex) - center));
+        }
+
+        /*
+         * Normal cone (the apex form of meshoptimizer) : the axis averages the triangle normals, mindp is the cosine of the widest
+         * normal. The cone of back-facing view directions is the normal cone widened by 90 degrees on every side, its cutoff is
+         * sin(acos(mindp)). Past 84 degrees the cone is too wide to be useful and is disabled.
+         */
+        const size_t           triangle_count = meshlet_triangles.size() / 3;
+        std::vector<glm::vec3> corners(triangle_count * 3);
+        std::vector<glm::vec3> normals(triangle_count);
+        glm::vec3              normal_sum = glm::vec3(0.0f);
+        for (size_t t = 0; t < triangle_count; ++t)
+        {
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                corners[t * 3 + corner] = ReadPosition(positions, position_stride, meshlet_vertices[meshlet_triangles[t * 3 + corner]]);
+            }
+            normals[t]  = TriangleNormal(corners[t * 3], corners[t * 3 + 1], corners[t * 3 + 2]);
+            normal_sum += normals[t];
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            meshlet.Center[axis]   = center[axis];
+            meshlet.ConeApex[axis] = center[axis];
+            meshlet.ConeAxis[axis] = 0.0f;
+        }
+        meshlet.Radius     = radius;
+        meshlet.ConeCutoff = 1.0f;
+
+        float axis_length = glm::length(normal_sum);
+        if (axis_length <= 0.0f)
+        {
+            return;
+        }
+        glm::vec3 cone_axis = normal_sum / axis_length;
+
+        float min_dot = 1.0f;
+        for (const auto& normal : normals)
+        {
+            if (normal != glm::vec3(0.0f))
+            {
+                min_dot = std::min(min_dot, glm::dot(normal, cone_axis));
+            }
+        }
+        if (min_dot <= 0.1f)
+        {
+            return;
+        }
+
+        /*
+         * Apex : moved back along the axis until it lies behind every triangle plane
+         */
+        float max_t = 0.0f;
+        for (size_t t = 0; t < triangle_count; ++t)
+        {
+            if (normals[t] == glm::vec3(0.0f))
+            {
+                continue;
+            }
+            float distance = glm::dot(center - corners[t * 3], normals[t]);
+            max_t          = std::max(max_t, distance / glm::dot(cone_axis, normals[t]));
+        }
+
+        glm::vec3 apex = center - cone_axis * max_t;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            meshlet.ConeApex[axis] = apex[axis];
+            meshlet.ConeAxis[axis] = cone_axis[axis];
+        }
+        meshlet.ConeCutoff = std::sqrt(1.0f - min_dot * min_dot);
+    }
+
+    bool MeshletBuilder::IsBackfacing(const Meshlet& meshlet, const glm::vec3& camera_position)
+    {
+        if (meshlet.ConeCutoff >= 1.0f)
+        {
+            return false;
+        }
+
+        glm::vec3 to_apex = glm::vec3(meshlet.ConeApex[0], meshlet.ConeApex[1], meshlet.ConeApex[2]) - camera_position;
+        float     length  = glm::length(to_apex);
+        if (length <= 0.0f)
+        {
+            return false;
+        }
+        return glm::dot(to_apex / length, glm::vec3(meshlet.ConeAxis[0], meshlet.ConeAxis[1], meshlet.ConeAxis[2])) >= meshlet.ConeCutoff;
+    }
+
+    void MeshletBuilder::GenerateMeshMeshlets(std::span<const float> vertices, size_t vertex_stride, std::span<const uint32_t> indices, std::span<const MeshVNext> meshes, MeshletData& meshlets, std::vector<MeshletRange>& meshlet_ranges, const MeshletOptions& options)
+    {
+        std::vector<MeshletData> mesh_meshlets(meshes.size());
+
+        ThreadPoolHelper::ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m)
+            {
+                const auto& mesh = meshes[m];
+                if (mesh.FaceSize != 3)
+                {
+                    continue;
+                }
+
+                auto mesh_indices  = indices.subspan(mesh.IndexOffset, mesh.IndexCount);
+                auto mesh_vertices = vertices.subspan(size_t(mesh.VertexOffset) * vertex_stride, size_t(mesh.VertexCount) * vertex_stride);
+                mesh_meshlets[m]   = BuildMeshlets(mesh_indices, mesh_vertices, vertex_stride, mesh.VertexCount, options);
+            }
+        });
+
+        meshlet_ranges.resize(meshes.size());
+        for (size_t m = 0; m < meshes.size(); ++m)
+        {
+            auto& data        = mesh_meshlets[m];
+            meshlet_ranges[m] = {.MeshletOffset = uint32_t(meshlets.Meshlets.size()), .MeshletCount = uint32_t(data.Meshlets.size())};
+            for (auto meshlet : data.Meshlets)
+            {
+                meshlet.VertexOffset   += uint32_t(meshlets.Vertices.size());
+                meshlet.TriangleOffset += uint32_t(meshlets.Triangles.size());
+                meshlets.Meshlets.push_back(meshlet);
+            }
+            meshlets.Vertices.insert(meshlets.Vertices.end(), data.Vertices.begin(), data.Vertices.end());
+            meshlets.Triangles.insert(meshlets.Triangles.end(), data.Triangles.begin(), data.Triangles.end());
+        }
+    }
+} // namespace ZEngine::Rendering::Meshes
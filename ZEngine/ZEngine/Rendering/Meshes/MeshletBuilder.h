@@ -0,0 +1,62 @@
+#pragma once
+#include <Rendering/Meshes/Mesh.h>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Rendering::Meshes
+{
+    struct MeshletOptions
+    {
+        bool     Enabled      = true;
+        /*
+         * Meshlet triangles index their vertices with a byte, at most 255 vertices
+         */
+        uint32_t MaxVertices  = 64;
+        uint32_t MaxTriangles = 124;
+        /*
+         * Weight of the normal deviation against new vertices when growing a meshlet : higher values give tighter normal cones
+         */
+        float    ConeWeight   = 0.25f;
+    };
+
+    struct MeshletData
+    {
+        std::vector<Meshlet>  Meshlets  = {};
+        std::vector<uint32_t> Vertices  = {};
+        /*
+         * 3 bytes per triangle, every meshlet starts on a 4 bytes boundary
+         */
+        std::vector<uint8_t>  Triangles = {};
+    };
+
+    /*
+     * Splits triangle lists into meshlets, grown greedily from a seed triangle over the triangles sharing their vertices : the
+     * candidate adding the fewest vertices, then deviating the least from the meshlet normal, is taken until a limit is reached.
+     * Every input triangle ends up in exactly one meshlet, with its winding.
+     */
+    struct MeshletBuilder
+    {
+        static constexpr uint32_t MaxVertexLimit   = 255;
+        static constexpr uint32_t MaxTriangleLimit = 512;
+
+        /*
+         * Meshlet vertices are the values of indices, positions are read at positions[vertex * position_stride], in floats.
+         * No meshlet is built when the index count isn't a multiple of 3 or an index is past vertex_count.
+         */
+        static MeshletData        BuildMeshlets(std::span<const uint32_t> indices, std::span<const float> positions, size_t position_stride, uint32_t vertex_count, const MeshletOptions& options = {});
+        /*
+         * Bounding sphere and normal cone of a meshlet, from its vertices and triangles
+         */
+        static void               ComputeBounds(Meshlet& meshlet, std::span<const uint32_t> meshlet_vertices, std::span<const uint8_t> meshlet_triangles, std::span<const float> positions, size_t position_stride);
+        /*
+         * Camera position in the meshlet space : true when no triangle of the meshlet can face it
+         */
+        static bool               IsBackfacing(const Meshlet& meshlet, const glm::vec3& camera_position);
+        /*
+         * Builds the meshlets of every mesh in parallel and concatenates them, mesh after mesh. meshlet_ranges gets one range per mesh.
+         * Vertices are interleaved (vertex_stride floats, position first), mesh indices are relative to their VertexOffset.
+         * Meshes whose FaceSize isn't 3 (lines, points, mixed faces) get an empty range.
+         */
+        static void               GenerateMeshMeshlets(std::span<const float> vertices, size_t vertex_stride, std::span<const uint32_t> indices, std::span<const MeshVNext> meshes, MeshletData& meshlets, std::vector<MeshletRange>& meshlet_ranges, const MeshletOptions& options = {});
+    };
+} // namespace ZEngine::Rendering::Meshes
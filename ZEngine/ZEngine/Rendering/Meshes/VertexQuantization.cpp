@@ -0,0 +1,215 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Meshes/VertexQuantization.h>
+
+using namespace ZEngine::Helpers;
+
+namespace ZEngine::Rendering::Meshes
+{
+    namespace
+    {
+        constexpr uint32_t VertexComponentCount = 3 + 3 + 2; /*pos-cmp + normal-cmp + tex-cmp*/
+
+        float SignNotZero(float value)
+        {
+            return (value >= 0.0f) ? 1.0f : -1.0f;
+        }
+
+        glm::vec3 PositionScale(const BoundingBox& bounds)
+        {
+            glm::vec3 extent = bounds.Max - bounds.Min;
+            return glm::vec3(extent.x > 0.0f ? 1.0f / extent.x : 0.0f, extent.y > 0.0f ? 1.0f / extent.y : 0.0f, extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+        }
+
+        CompactVertex EncodeVertexScaled(const float* vertex, const glm::vec3& min, const glm::vec3& scale)
+        {
+            glm::vec3     position = (glm::vec3(vertex[0], vertex[1], vertex[2]) - min) * scale;
+
+            CompactVertex out      = {};
+            out.PositionXY         = glm::packUnorm2x16(glm::vec2(position.x, position.y));
+            out.PositionZ          = glm::packUnorm2x16(glm::vec2(position.z, 0.0f));
+            out.Normal             = VertexQuantization::EncodeOctahedral(glm::vec3(vertex[3], vertex[4], vertex[5]));
+            out.TexCoord           = glm::packHalf2x16(glm::vec2(vertex[6], vertex[7]));
+            return out;
+        }
+
+        struct MeshVertexRange
+        {
+            uint32_t First = 0;
+            uint32_t Count = 0;
+        };
+    } // namespace
+
+    uint32_t VertexQuantization::EncodeOctahedral(const glm::vec3& normal)
+    {
+        float l1_norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (l1_norm <= 0.0f)
+        {
+            return glm::packSnorm2x16(glm::vec2(0.0f));
+        }
+
+        glm::vec2 projected = glm::vec2(normal.x, normal.y) / l1_norm;
+        if (normal.z < 0.0f)
+        {
+            projected = glm::vec2((1.0f - std::abs(projected.y)) * SignNotZero(projected.x), (1.0f - std::abs(projected.x)) * SignNotZero(projected.y));
+        }
+        return glm::packSnorm2x16(projected);
+    }
+
+    glm::vec3 VertexQuantization::DecodeOctahedral(uint32_t encoded)
+    {
+        glm::vec2 e      = glm::unpackSnorm2x16(encoded);
+        glm::vec3 normal = glm::vec3(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        float     t      = std::max(-normal.z, 0.0f);
+        normal.x        += (normal.x >= 0.0f) ? -t : t;
+        normal.y        += (normal.y >= 0.0f) ? -t : t;
+        return glm::normalize(normal);
+    }
+
+    CompactVertex VertexQuantization::EncodeVertex(const float* vertex, const BoundingBox& bounds)
+    {
+        return EncodeVertexScaled(vertex, bounds.Min, PositionScale(bounds));
+    }
+
+    void VertexQuantization::DecodeVertex(const CompactVertex& vertex, const BoundingBox& bounds, float* out)
+    {
+        glm::vec3 extent   = bounds.Max - bounds.Min;
+        glm::vec2 xy       = glm::unpackUnorm2x16(vertex.PositionXY);
+        glm::vec2 z        = glm::unpackUnorm2x16(vertex.PositionZ);
+        glm::vec3 position = bounds.Min + glm::vec3(xy.x, xy.y, z.x) * extent;
+        glm::vec3 normal   = DecodeOctahedral(vertex.Normal);
+        glm::vec2 uv       = glm::unpackHalf2x16(vertex.TexCoord);
+
+        out[0]             = position.x;
+        out[1]             = position.y;
+        out[2]             = position.z;
+        out[3]             = normal.x;
+        out[4]             = normal.y;
+        out[5]             = normal.z;
+        out[6]             = uv.x;
+        out[7]             = uv.y;
+    }
+
+    CompactGeometry VertexQuantization::Compress(std::span<const float> vertices, std::span<const uint32_t> indices, std::span<const MeshVNext> meshes, std::span<const MeshLodChain> lod_chains)
+    {
+        CompactGeometry              geometry = {};
+        std::vector<MeshVertexRange> ranges(meshes.size());
+        geometry.Meshes.resize(meshes.size());
+
+        /*
+         * (1) Vertex range and bounds of every mesh, from the vertices its indices reference
+         */
+        ThreadPoolHelper::ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m)
+            {
+                const auto& mesh        = meshes[m];
+                auto&       compact     = geometry.Meshes[m];
+                uint32_t    first       = std::numeric_limits<uint32_t>::max();
+                uint32_t    last        = 0;
+                compact.IndexCount      = mesh.IndexCount;
+                for (uint32_t i = 0; i < mesh.IndexCount; ++i)
+                {
+                    uint32_t vertex = mesh.VertexOffset + indices[mesh.IndexOffset + i];
+                    first           = std::min(first, vertex);
+                    last            = std::max(last, vertex);
+                }
+
+                if (mesh.IndexCount == 0)
+                {
+                    continue;
+                }
+
+                ranges[m] = {.First = first, .Count = last - first + 1};
+                for (uint32_t v = first; v <= last; ++v)
+                {
+                    const float* vertex = &vertices[size_t(v) * VertexComponentCount];
+                    compact.Bounds.Expand(glm::vec3(vertex[0], vertex[1], vertex[2]));
+                }
+                compact.VertexCount = ranges[m].Count;
+                compact.IndexFormat = (ranges[m].Count <= (1u << 16)) ? IndexFormat::UINT16 : IndexFormat::UINT32;
+            }
+        });
+
+        /*
+         * (2) Output slices, every index range starts on a word
+         */
+        size_t vertex_total = 0;
+        size_t word_total   = 0;
+        for (size_t m = 0; m < meshes.size(); ++m)
+        {
+            auto&  compact       = geometry.Meshes[m];
+            bool   narrow        = (compact.IndexFormat == IndexFormat::UINT16);
+            size_t element_count = compact.IndexCount;
+            compact.VertexOffset = uint32_t(vertex_total);
+            compact.IndexOffset  = uint32_t(narrow ? word_total * 2 : word_total);
+
+            if ((m < lod_chains.size()) && (compact.VertexCount > 0))
+            {
+                compact.Lods.LodCount = std::min<uint32_t>(lod_chains[m].LodCount, MAX_MESH_LOD_COUNT);
+                for (uint32_t level = 0; level < compact.Lods.LodCount; ++level)
+                {
+                    const auto& lod           = lod_chains[m].Lods[level];
+                    compact.Lods.Lods[level]  = {.IndexOffset = compact.IndexOffset + uint32_t(element_count), .IndexCount = lod.IndexCount, .Error = lod.Error};
+                    element_count            += lod.IndexCount;
+                }
+            }
+
+            vertex_total += compact.VertexCount;
+            word_total   += narrow ? (element_count + 1) / 2 : element_count;
+        }
+        geometry.Vertices.resize(vertex_total);
+        geometry.Indices.resize(word_total, 0);
+
+        /*
+         * (3) Encoding, slices are disjoint
+         */
+        ThreadPoolHelper::ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t m = begin; m < end; ++m)
+            {
+                const auto& mesh    = meshes[m];
+                const auto& compact = geometry.Meshes[m];
+                const auto& range   = ranges[m];
+                glm::vec3   scale   = PositionScale(compact.Bounds);
+                for (uint32_t v = 0; v < range.Count; ++v)
+                {
+                    const float* vertex                         = &vertices[size_t(range.First + v) * VertexComponentCount];
+                    geometry.Vertices[compact.VertexOffset + v] = EncodeVertexScaled(vertex, compact.Bounds.Min, scale);
+                }
+
+                auto encode_fn = [&](uint32_t source_offset, uint32_t target_offset, uint32_t count) {
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        uint32_t local = mesh.VertexOffset + indices[source_offset + i] - range.First;
+                        if (compact.IndexFormat == IndexFormat::UINT16)
+                        {
+                            uint32_t element                = target_offset + i;
+                            geometry.Indices[element >> 1] |= local << ((element & 1u) * 16);
+                        }
+                        else
+                        {
+                            geometry.Indices[target_offset + i] = local;
+                        }
+                    }
+                };
+
+                encode_fn(mesh.IndexOffset, compact.IndexOffset, mesh.IndexCount);
+                for (uint32_t level = 0; level < compact.Lods.LodCount; ++level)
+                {
+                    encode_fn(lod_chains[m].Lods[level].IndexOffset, compact.Lods.Lods[level].IndexOffset, compact.Lods.Lods[level].IndexCount);
+                }
+            }
+        });
+
+        return geometry;
+    }
+
+    uint32_t VertexQuantization::FetchIndex(const CompactGeometry& geometry, const CompactMeshRange& mesh, uint32_t i)
+    {
+        uint32_t element = mesh.IndexOffset + i;
+        if (mesh.IndexFormat == IndexFormat::UINT16)
+        {
+            return (geometry.Indices[element >> 1] >> ((element & 1u) * 16)) & 0xFFFFu;
+        }
+        return geometry.Indices[element];
+    }
+} // namespace ZEngine::Rendering::Meshes
@@ -0,0 +1,92 @@
+#pragma once
+#include <Rendering/Meshes/Mesh.h>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Rendering::Meshes
+{
+    /*
+     * Encodings of the vertex and index storage buffers, the values are read by vertex_common.glsl
+     */
+    enum class VertexFormat : uint32_t
+    {
+        FLOAT32 = 0,
+        COMPACT = 1
+    };
+
+    enum class IndexFormat : uint32_t
+    {
+        UINT32 = 0,
+        UINT16 = 1
+    };
+
+    /*
+     * 16 bytes per vertex, half of the 8 floats layout :
+     *  - position as unorm16 relative to the mesh bounds (x, y | z, unused)
+     *  - normal as octahedral snorm16 x2
+     *  - texture coordinates as half floats x2
+     */
+    struct CompactVertex
+    {
+        uint32_t PositionXY = 0;
+        uint32_t PositionZ  = 0;
+        uint32_t Normal     = 0;
+        uint32_t TexCoord   = 0;
+    };
+    static_assert(sizeof(CompactVertex) == 16, "CompactVertex must match the GLSL decoder");
+
+    struct CompactMeshRange
+    {
+        /*
+         * First vertex of the mesh in CompactGeometry::Vertices, indices of the mesh are relative to it
+         */
+        uint32_t            VertexOffset = 0;
+        uint32_t            VertexCount  = 0;
+        /*
+         * In elements of IndexFormat, from the start of CompactGeometry::Indices
+         */
+        uint32_t            IndexOffset  = 0;
+        uint32_t            IndexCount   = 0;
+        Meshes::IndexFormat IndexFormat  = Meshes::IndexFormat::UINT32;
+        /*
+         * Quantization box of the positions, computed from the referenced vertices
+         */
+        BoundingBox         Bounds       = {};
+        /*
+         * Simplified levels, their index ranges follow the mesh one and share its IndexFormat
+         */
+        MeshLodChain        Lods         = {};
+    };
+
+    struct CompactGeometry
+    {
+        std::vector<CompactVertex>    Vertices = {};
+        /*
+         * UINT16 ranges hold two indices per word, the low half first
+         */
+        std::vector<uint32_t>         Indices  = {};
+        std::vector<CompactMeshRange> Meshes   = {};
+    };
+
+    struct VertexQuantization
+    {
+        static uint32_t        EncodeOctahedral(const glm::vec3& normal);
+        static glm::vec3       DecodeOctahedral(uint32_t encoded);
+        /*
+         * vertex is the 8 floats layout : position, normal, texture coordinates
+         */
+        static CompactVertex   EncodeVertex(const float* vertex, const BoundingBox& bounds);
+        static void            DecodeVertex(const CompactVertex& vertex, const BoundingBox& bounds, float* out);
+        /*
+         * Re-encodes the 8 floats geometry, meshes are processed in parallel. Every mesh gets its own vertex range, so indices are
+         * rebased on the first vertex the mesh references and narrowed to 16 bits when the range allows it.
+         * Absolute vertex indices are mesh.VertexOffset + indices[i], as for the float geometry.
+         * lod_chains, when given, holds one chain per mesh (a shorter span leaves the last meshes without levels).
+         */
+        static CompactGeometry Compress(std::span<const float> vertices, std::span<const uint32_t> indices, std::span<const MeshVNext> meshes, std::span<const MeshLodChain> lod_chains = {});
+        /*
+         * CPU counterpart of the shader index fetch, i is relative to the mesh IndexOffset
+         */
+        static uint32_t        FetchIndex(const CompactGeometry& geometry, const CompactMeshRange& mesh, uint32_t i);
+    };
+} // namespace ZEngine::Rendering::Meshes
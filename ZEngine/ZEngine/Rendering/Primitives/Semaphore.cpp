@@ -4,11 +4,17 @@
 
 namespace ZEngine::Rendering::Primitives
 {
-    Semaphore::Semaphore(Hardwares::VulkanDevice* const device)
+    Semaphore::Semaphore(Hardwares::VulkanDevice* const device, SemaphoreType type) : m_type(type)
     {
         Device                                      = device;
+        VkSemaphoreTypeCreateInfo type_create_info  = {};
+        type_create_info.sType                      = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        type_create_info.semaphoreType              = VK_SEMAPHORE_TYPE_TIMELINE;
+        type_create_info.initialValue               = 0;
+
         VkSemaphoreCreateInfo semaphore_create_info = {};
         semaphore_create_info.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphore_create_info.pNext                 = (type == SemaphoreType::Timeline) ? &type_create_info : nullptr;
         ZENGINE_VALIDATE_ASSERT(vkCreateSemaphore(Device->LogicalDevice, &semaphore_create_info, nullptr, &m_handle) == VK_SUCCESS, "Failed to create Semaphore")
     }
 
@@ -25,14 +31,36 @@ namespace ZEngine::Rendering::Primitives
         m_semaphore_state = SemaphoreState::Idle;
     }
 
-    void Semaphore::Wait(const uint64_t value, const uint64_t timeout)
+    bool Semaphore::Wait(const uint64_t value, const uint64_t timeout)
     {
-        /*No-Op for now, because it's for timeline semaphore*/
+        if (m_type != SemaphoreType::Timeline)
+        {
+            return false;
+        }
+
+        VkSemaphoreWaitInfo wait_info = {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO, .pNext = nullptr, .flags = 0, .semaphoreCount = 1, .pSemaphores = &m_handle, .pValues = &value};
+        return vkWaitSemaphores(Device->LogicalDevice, &wait_info, timeout) == VK_SUCCESS;
     }
 
     void Semaphore::Signal(const uint64_t value)
     {
-        /*No-Op for now, because it's for timeline semaphore*/
+        if (m_type != SemaphoreType::Timeline)
+        {
+            return;
+        }
+
+        VkSemaphoreSignalInfo signal_info = {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO, .pNext = nullptr, .semaphore = m_handle, .value = value};
+        ZENGINE_VALIDATE_ASSERT(vkSignalSemaphore(Device->LogicalDevice, &signal_info) == VK_SUCCESS, "Failed to signal Semaphore")
+    }
+
+    uint64_t Semaphore::GetValue() const
+    {
+        uint64_t value = 0;
+        if (m_type == SemaphoreType::Timeline)
+        {
+            ZENGINE_VALIDATE_ASSERT(vkGetSemaphoreCounterValue(Device->LogicalDevice, m_handle, &value) == VK_SUCCESS, "Failed to read Semaphore value")
+        }
+        return value;
     }
 
     VkSemaphore Semaphore::GetHandle() const
@@ -49,4 +77,9 @@ namespace ZEngine::Rendering::Primitives
     {
         return m_semaphore_state;
     }
+
+    SemaphoreType Semaphore::GetType() const
+    {
+        return m_type;
+    }
 } // namespace ZEngine::Rendering::Primitives
\ No newline at end of file
@@ -16,21 +16,33 @@ namespace ZEngine::Rendering::Primitives
         Undefined,
     };
 
+    enum class SemaphoreType
+    {
+        Binary,
+        Timeline,
+    };
+
     struct Semaphore : public Helpers::RefCounted
     {
-        Semaphore(Hardwares::VulkanDevice* const device);
+        Semaphore(Hardwares::VulkanDevice* const device, SemaphoreType type = SemaphoreType::Binary);
         ~Semaphore();
 
         Hardwares::VulkanDevice* Device = nullptr;
-        void                     Wait(const uint64_t value, const uint64_t timeout = UINT64_MAX);
+        /*
+         * Timeline semaphores only : host wait until the counter reaches value, host signal, current counter value
+         */
+        bool                     Wait(const uint64_t value, const uint64_t timeout = UINT64_MAX);
         void                     Signal(const uint64_t value);
+        uint64_t                 GetValue() const;
         VkSemaphore              GetHandle() const;
+        SemaphoreType            GetType() const;
 
         void                     SetState(SemaphoreState state);
         SemaphoreState           GetState() const;
 
     private:
         SemaphoreState m_semaphore_state{SemaphoreState::Idle};
+        SemaphoreType  m_type{SemaphoreType::Binary};
         VkSemaphore    m_handle{VK_NULL_HANDLE};
     };
 } // namespace ZEngine::Rendering::Primitives
\ No newline at end of file
@@ -2,22 +2,10 @@
 #include <Helpers/ThreadPool.h>
 #include <ImGUIRenderer.h>
 #include <RendererPasses.h>
-#include <Rendering/Buffers/Bitmap.h>
 #include <Rendering/Renderers/Contracts/RendererDataContract.h>
 #include <Rendering/Renderers/GraphicRenderer.h>
 #include <Specifications/FormatSpecification.h>
 
-#define STB_IMAGE_IMPLEMENTATION
-#ifdef __GNUC__
-#define STBI_NO_SIMD
-#endif
-#include <stb/stb_image.h>
-
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#define STB_IMAGE_RESIZE_IMPLEMENTATION
-#include <stb/stb_image_resize.h>
-#include <stb/stb_image_write.h>
-
 using namespace ZEngine::Hardwares;
 using namespace ZEngine::Rendering::Specifications;
 using namespace ZEngine::Rendering::Renderers::Contracts;
@@ -58,7 +46,7 @@ namespace ZEngine::Rendering::Renderers
         FrameColorRenderTarget = Device->GlobalTextures->Add(CreateTexture({.PerformTransition = false, .Width = 1280, .Height = 780, .Format = ImageFormat::R8G8B8A8_UNORM}));
         FrameDepthRenderTarget = Device->GlobalTextures->Add(CreateTexture({.PerformTransition = false, .Width = 1280, .Height = 780, .Format = ImageFormat::DEPTH_STENCIL_FROM_DEVICE}));
 
-        Device->TextureHandleToUpdates.Enqueue(FrameColorRenderTarget);
+        Device->EnqueueTextureUpdate(FrameColorRenderTarget);
         /*
          * Subsystems initialization
          */
@@ -97,7 +85,10 @@ namespace ZEngine::Rendering::Renderers
         ImguiRenderer->Deinitialize();
     }
 
-    void GraphicRenderer::Update() {}
+    void GraphicRenderer::Update()
+    {
+        AsyncLoader->UpdateStreaming();
+    }
 
     void GraphicRenderer::DrawScene(Hardwares::CommandBuffer* const command_buffer, Cameras::Camera* const camera, Scenes::SceneRawData* const scene)
     {
@@ -106,6 +97,11 @@ namespace ZEngine::Rendering::Renderers
         auto     ubo_camera_data = UBOCameraLayout{.View = camera->GetViewMatrix(), .Projection = camera->GetPerspectiveMatrix(), .Position = glm::vec4(camera->GetPosition(), 1.0f)};
 
         scene_camera->At(frame_index).SetData(&ubo_camera_data, sizeof(UBOCameraLayout));
+        CameraFrustum = Scenes::Frustum::FromViewProjection(ubo_camera_data.Projection * ubo_camera_data.View);
+
+        auto frame_output             = Device->GlobalTextures->Access(GetFrameOutput());
+        CameraLodView.Position        = camera->GetPosition();
+        CameraLodView.ProjectionScale = frame_output ? std::abs(ubo_camera_data.Projection[1][1]) * 0.5f * float(frame_output->Height) : 0.0f;
 
         if (RenderGraph->MarkAsDirty)
         {
@@ -133,21 +129,62 @@ namespace ZEngine::Rendering::Renderers
         uint32_t                                   sampled_bit            = spec.IsUsageSampled ? VK_IMAGE_USAGE_SAMPLED_BIT : 0;
         uint32_t                                   image_aspect           = (spec.Format == Specifications::ImageFormat::DEPTH_STENCIL_FROM_DEVICE) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
         uint32_t                                   image_usage_attachment = (spec.Format == Specifications::ImageFormat::DEPTH_STENCIL_FROM_DEVICE) ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        if (Specifications::IsBlockCompressedFormat(spec.Format))
+        {
+            image_usage_attachment = 0;
+        }
 
         VkFormat                                   image_format           = (spec.Format == Specifications::ImageFormat::DEPTH_STENCIL_FROM_DEVICE) ? Device->FindDepthFormat() : Specifications::ImageFormatMap[VALUE_FROM_SPEC_MAP(spec.Format)];
 
-        Specifications::Image2DBufferSpecification buffer_spec            = {.Width = spec.Width, .Height = spec.Height, .BufferUsageType = spec.IsCubemap ? Specifications::ImageBufferUsageType::CUBEMAP : Specifications::ImageBufferUsageType::SINGLE_2D_IMAGE, .ImageFormat = image_format, .ImageAspectFlag = VkImageAspectFlagBits(image_aspect), .LayerCount = spec.LayerCount};
+        /*
+         * The levels Data doesn't hold are blitted from the last one it does, a texture whose format can't be blitted keeps only those
+         */
+        Specifications::TextureSpecification       texture_spec           = spec;
+        uint32_t                                   data_mip_levels        = std::clamp(spec.DataMipLevels, 1u, std::max(spec.MipLevels, 1u));
+        texture_spec.MipLevels                                            = std::max(spec.MipLevels, 1u);
+        if (spec.Data && (texture_spec.MipLevels > data_mip_levels) && !Device->IsLinearBlitSupported(image_format))
+        {
+            texture_spec.MipLevels = data_mip_levels;
+        }
+        uint32_t                                   mip_source_bit         = (texture_spec.MipLevels > 1) ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0;
+
+        Specifications::Image2DBufferSpecification buffer_spec            = {.Width = spec.Width, .Height = spec.Height, .BufferUsageType = spec.IsCubemap ? Specifications::ImageBufferUsageType::CUBEMAP : Specifications::ImageBufferUsageType::SINGLE_2D_IMAGE, .ImageFormat = image_format, .ImageAspectFlag = VkImageAspectFlagBits(image_aspect), .LayerCount = spec.LayerCount, .MipLevels = texture_spec.MipLevels};
 
-        buffer_spec.ImageUsage                                            = VkImageUsageFlagBits(image_usage_attachment | transfert_bit | sampled_bit | storage_bit);
+        buffer_spec.ImageUsage                                            = VkImageUsageFlagBits(image_usage_attachment | transfert_bit | sampled_bit | storage_bit | mip_source_bit);
         Ref<Hardwares::Image2DBuffer> image_2d_buffer                     = CreateRef<Hardwares::Image2DBuffer>(Device, std::move(buffer_spec));
 
-        auto                          command_buffer                      = Device->GetInstantCommandBuffer(QueueType::GRAPHIC_QUEUE);
-
-        auto                          image_handle                        = image_2d_buffer->GetHandle();
-        auto&                         image_buffer                        = image_2d_buffer->GetBuffer();
+        StagingAllocation         staging       = {};
+        std::vector<VkDeviceSize> level_offsets = {};
+        if (spec.PerformTransition && spec.Data)
+        {
+            VkDeviceSize buffer_size = 0;
+            for (uint32_t level = 0; level < data_mip_levels; ++level)
+            {
+                level_offsets.push_back(buffer_size);
+                buffer_size += Specifications::ImageLevelByteSize(spec.Format, std::max(spec.Width >> level, 1u), std::max(spec.Height >> level, 1u), spec.BytePerPixel) * spec.LayerCount;
+            }
+            staging = Device->AllocateStaging(buffer_size);
+            if (staging)
+            {
+                ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(staging.Data, staging.ByteSize, spec.Data, buffer_size) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                Device->FlushStaging(staging);
+            }
+        }
 
-        if (spec.PerformTransition)
+        if (staging)
         {
+            /*
+             * The upload joins the open transfer batch, submitted at the latest before the next frame
+             */
+            VkImageLayout final_layout   = VkImageAspectFlagBits(image_aspect) == VK_IMAGE_ASPECT_DEPTH_BIT ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            uint64_t      transfer_token = Device->CopyBufferToImage(staging, image_2d_buffer->GetBuffer(), spec.Width, spec.Height, spec.LayerCount, VkImageAspectFlagBits(image_aspect), final_layout, texture_spec.MipLevels, level_offsets);
+            Device->ReleaseStaging(staging, transfer_token);
+        }
+        else if (spec.PerformTransition)
+        {
+            auto                                            command_buffer = Device->GetInstantCommandBuffer(QueueType::GRAPHIC_QUEUE);
+            auto                                            image_handle   = image_2d_buffer->GetHandle();
+
             Specifications::ImageMemoryBarrierSpecification barrier_spec_0 = {};
             barrier_spec_0.ImageHandle                                     = image_handle;
             barrier_spec_0.OldLayout                                       = Specifications::ImageLayout::UNDEFINED;
@@ -158,18 +195,10 @@ namespace ZEngine::Rendering::Renderers
             barrier_spec_0.SourceStageMask                                 = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
             barrier_spec_0.DestinationStageMask                            = VK_PIPELINE_STAGE_TRANSFER_BIT;
             barrier_spec_0.LayerCount                                      = spec.LayerCount;
+            barrier_spec_0.MipLevelCount                                   = texture_spec.MipLevels;
             Primitives::ImageMemoryBarrier barrier_0{barrier_spec_0};
             command_buffer->TransitionImageLayout(barrier_0);
 
-            if (spec.Data)
-            {
-                auto       buffer_size    = spec.Width * spec.Height * spec.BytePerPixel * spec.LayerCount;
-                BufferView staging_buffer = Device->CreateBuffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT);
-                Device->MapAndCopyToMemory(staging_buffer, buffer_size, spec.Data);
-                command_buffer->CopyBufferToImage(staging_buffer, image_2d_buffer->GetBuffer(), spec.Width, spec.Height, spec.LayerCount, barrier_0.GetHandle().newLayout);
-                Device->EnqueueBufferForDeletion(staging_buffer);
-            }
-
             Specifications::ImageMemoryBarrierSpecification barrier_spec_1 = {};
             barrier_spec_1.ImageHandle                                     = image_handle;
             barrier_spec_1.OldLayout                                       = Specifications::ImageLayout::TRANSFER_DST_OPTIMAL;
@@ -180,13 +209,14 @@ namespace ZEngine::Rendering::Renderers
             barrier_spec_1.SourceStageMask                                 = VK_PIPELINE_STAGE_TRANSFER_BIT;
             barrier_spec_1.DestinationStageMask                            = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
             barrier_spec_1.LayerCount                                      = spec.LayerCount;
+            barrier_spec_1.MipLevelCount                                   = texture_spec.MipLevels;
             Primitives::ImageMemoryBarrier barrier_1{barrier_spec_1};
             command_buffer->TransitionImageLayout(barrier_1);
-        }
 
-        Device->EnqueueInstantCommandBuffer(command_buffer);
+            Device->EnqueueInstantCommandBuffer(command_buffer);
+        }
 
-        return CreateRef<Textures::Texture>(spec, std::move(image_2d_buffer));
+        return CreateRef<Textures::Texture>(std::move(texture_spec), std::move(image_2d_buffer));
     }
 
     Helpers::Ref<Textures::Texture> GraphicRenderer::CreateTexture(uint32_t width, uint32_t height)
@@ -229,343 +259,438 @@ namespace ZEngine::Rendering::Renderers
         return CreateTexture(spec);
     }
 
+    namespace
+    {
+        Specifications::ImageFormat BlockCompressedTextureFormat(const Textures::DecodedImage& header)
+        {
+            switch (header.Format)
+            {
+                case Textures::DecodedPixelFormat::BC1:
+                    return header.IsSrgb ? ImageFormat::BC1_RGBA_SRGB : ImageFormat::BC1_RGBA_UNORM;
+                case Textures::DecodedPixelFormat::BC3:
+                    return header.IsSrgb ? ImageFormat::BC3_SRGB : ImageFormat::BC3_UNORM;
+                case Textures::DecodedPixelFormat::BC4:
+                    return ImageFormat::BC4_UNORM;
+                case Textures::DecodedPixelFormat::BC5:
+                    return ImageFormat::BC5_UNORM;
+                case Textures::DecodedPixelFormat::BC6H:
+                    return ImageFormat::BC6H_UFLOAT;
+                case Textures::DecodedPixelFormat::BC7:
+                    return header.IsSrgb ? ImageFormat::BC7_SRGB : ImageFormat::BC7_UNORM;
+                default:
+                    return ImageFormat::UNDEFINED;
+            }
+        }
+
+        /*
+         * Levels [first_level, MipLevels) of spec
+         */
+        Specifications::TextureSpecification StreamedLevelSpecification(const Specifications::TextureSpecification& spec, uint32_t first_level)
+        {
+            Specifications::TextureSpecification level_spec = spec;
+            level_spec.Width                                = std::max(spec.Width >> first_level, 1u);
+            level_spec.Height                               = std::max(spec.Height >> first_level, 1u);
+            level_spec.MipLevels                            = spec.MipLevels - first_level;
+            return level_spec;
+        }
+
+        /*
+         * What TextureCompressor::Decompress gives back
+         */
+        Specifications::ImageFormat DecompressedTextureFormat(const Textures::DecodedImage& header)
+        {
+            if (header.Format == Textures::DecodedPixelFormat::BC6H)
+            {
+                return ImageFormat::R32G32B32A32_SFLOAT;
+            }
+            return header.IsSrgb ? ImageFormat::R8G8B8A8_SRGB : ImageFormat::R8G8B8A8_UNORM;
+        }
+    } // namespace
+
     // AsyncResourceLoader
     //
     void AsyncResourceLoader::Initialize(GraphicRenderer* renderer)
     {
         Renderer = renderer;
-        m_buffer_manager.Initialize(Renderer->Device);
-        Helpers::ThreadPoolHelper::Submit([this] { Run(); });
+        m_decode_pool.SetCompletionCallback([this] {
+            {
+                std::lock_guard l(m_mutex);
+            }
+            m_cond.notify_one();
+        });
+        m_run_future = Helpers::ThreadPoolHelper::Submit([this] { Run(); });
     }
 
     Textures::TextureHandle AsyncResourceLoader::LoadTextureFileSync(std::string_view filename)
     {
-        int      width = 0, height = 0, channel = 0;
-        stbi_uc* image_data = stbi_load(filename.data(), &width, &height, &channel, STBI_rgb_alpha);
-        if (!image_data)
+        /*
+         * Used for UI images, drawn top row first : not flipped
+         */
+        Textures::DecodedImage image;
+        if (!Textures::TextureDecoder::Decode(filename, false, image) || image.IsCubemap)
         {
-            ZENGINE_CORE_ERROR("Failed to load texture file synchronously: {}", filename.data());
+            ZENGINE_CORE_ERROR("Failed to load texture file synchronously: {}", filename.data())
             return Textures::TextureHandle{};
         }
 
         Specifications::TextureSpecification spec = {
-            .Width        = static_cast<uint32_t>(width),
-            .Height       = static_cast<uint32_t>(height),
+            .Width        = image.Width,
+            .Height       = image.Height,
             .BytePerPixel = 4, // RGBA
             .Format       = Specifications::ImageFormat::R8G8B8A8_SRGB,
-            .Data         = image_data,
+            .Data         = image.Pixels.data(),
         };
 
-        Textures::TextureHandle handle = Renderer->Device->GlobalTextures->Add(Renderer->CreateTexture(spec));
-        stbi_image_free(image_data);
-
-        return handle;
+        return Renderer->Device->GlobalTextures->Add(Renderer->CreateTexture(spec));
     }
 
-    Textures::TextureHandle AsyncResourceLoader::LoadTextureFile(std::string_view filename)
+    Textures::TextureHandle AsyncResourceLoader::LoadTextureFile(std::string_view filename, Helpers::TaskPriority priority, bool is_normal_map)
     {
         auto abs_filename = std::filesystem::absolute(filename).string();
 
-        int  w, h, ch;
-        if (!stbi_info(abs_filename.c_str(), &w, &h, &ch))
+        Textures::DecodedImage header;
+        if (!Textures::TextureDecoder::ReadHeader(abs_filename, header))
         {
             return {};
         }
 
-        const std::set<std::string_view>     known_cubmap_file_ext = {".hdr", ".exr"};
-        auto                                 file_ext              = std::filesystem::path(filename).extension().string();
-
-        Specifications::TextureSpecification spec{.Width = (uint32_t) w, .Height = (uint32_t) h, .Format = Specifications::ImageFormat::R8G8B8A8_SRGB};
+        Specifications::TextureSpecification    spec{.Width = header.Width, .Height = header.Height, .Format = is_normal_map ? Specifications::ImageFormat::R8G8B8A8_UNORM : Specifications::ImageFormat::R8G8B8A8_SRGB};
+        std::optional<Buffers::MipChainOptions> cpu_mip_chain;
+        bool                                    decompress_blocks = false;
 
-        if (known_cubmap_file_ext.contains(file_ext))
+        if (Textures::IsBlockCompressed(header.Format))
+        {
+            /*
+             * The container holds every level already. Without BC sampling, the blocks are decoded back on the decode thread
+             */
+            spec.MipLevels    = header.MipLevelCount;
+            spec.LayerCount   = header.LayerCount;
+            spec.IsCubemap    = header.IsCubemap;
+            decompress_blocks = !Renderer->Device->IsBlockCompressionSupported();
+            spec.Format       = decompress_blocks ? DecompressedTextureFormat(header) : BlockCompressedTextureFormat(header);
+        }
+        else if (header.IsCubemap)
         {
-            int face_size   = w / 4;
-
             spec.IsCubemap  = true;
-            spec.LayerCount = 6;
+            spec.LayerCount = header.LayerCount;
             spec.Format     = Specifications::ImageFormat::R32G32B32A32_SFLOAT;
+        }
+        else
+        {
+            /*
+             * Color levels are blitted by the GPU when the format can be filtered that way, normal maps need their renormalization
+             */
+            spec.MipLevels = Buffers::Bitmap::MipLevelCount(header.Width, header.Height);
+            if (is_normal_map || !Renderer->Device->IsLinearBlitSupported(Specifications::ImageFormatMap[VALUE_FROM_SPEC_MAP(spec.Format)]))
+            {
+                cpu_mip_chain = Buffers::MipChainOptions{.IsSrgb = !is_normal_map, .IsNormalMap = is_normal_map};
+            }
+        }
+
+        if (spec.IsCubemap || (spec.MipLevels <= 1))
+        {
+            Textures::TextureHandle handle = Renderer->Device->GlobalTextures->Add(Renderer->CreateTexture(spec));
+            EnqueueTextureRequest(filename, handle, priority, cpu_mip_chain, decompress_blocks);
+            return handle;
+        }
+
+        /*
+         * Streamed : the budget accounts for the levels as they sit on the device
+         */
+        StreamedTextureFile file = {
+            .Filename         = std::string(filename),
+            .Priority         = priority,
+            .Specification    = spec,
+            .CpuMipChain      = cpu_mip_chain.has_value(),
+            .MipOptions       = Buffers::MipChainOptions{.IsSrgb = !is_normal_map, .IsNormalMap = is_normal_map},
+            .IsTextureAsset   = Textures::IsBlockCompressed(header.Format),
+            .DecompressBlocks = decompress_blocks,
+        };
+
+        Textures::DecodedImage shape = header;
+        shape.MipLevelCount          = spec.MipLevels;
+        if (decompress_blocks)
+        {
+            shape.Format = (header.Format == Textures::DecodedPixelFormat::BC6H) ? Textures::DecodedPixelFormat::RGBA32F : Textures::DecodedPixelFormat::RGBA8;
+        }
 
-            spec.Width      = face_size;
-            spec.Height     = face_size;
+        uint32_t tail_level = 0;
+        {
+            std::lock_guard l(m_mutex);
+            tail_level = m_streamer.TailFirstLevel(shape);
         }
 
-        Textures::TextureHandle handle = Renderer->Device->GlobalTextures->Add(Renderer->CreateTexture(spec));
-        EnqueueTextureRequest(filename, handle);
+        Textures::TextureRef    tail   = Renderer->CreateTexture(StreamedLevelSpecification(spec, tail_level));
+        Textures::TextureHandle handle = Renderer->Device->GlobalTextures->Add(tail);
+        file.Handle                    = handle;
+        {
+            std::lock_guard l(m_mutex);
+            m_streamer.Register(handle.Index, shape);
+            m_streamed_files[handle.Index] = file;
+        }
+
+        /*
+         * The tail decode carries its texture like any streamed decode : Run() never reads a slot UpdateStreaming() swaps
+         */
+        EnqueueStreamedDecode(file, tail_level, std::move(tail));
         return handle;
     }
 
     void AsyncResourceLoader::Run()
     {
+        std::vector<Textures::TextureDecodeResult> decoded;
+        std::vector<VkDeviceSize>                  level_offsets;
+        decoded.reserve(MaxUploadBatchSize);
+
         while (true)
         {
-            std::unique_lock l(m_mutex);
-            m_cond.wait(l, [this] { return !m_file_requests.Empty() || !m_update_texture_request.Empty() || !m_upload_requests.Empty() || m_cancellation_token.load() == true; });
+            {
+                std::unique_lock l(m_mutex);
+                m_cond.wait(l, [this] { return m_decode_pool.HasCompleted() || !m_update_texture_request.Empty() || m_cancellation_token.load() == true; });
+            }
 
             if (m_cancellation_token.load() == true)
             {
                 break;
             }
 
-            // Processing update requests
-            if (m_update_texture_request.Size())
+            // Uploading finished decodes : every copy of the batch goes in the same transfer submission
+            decoded.clear();
+            if (m_decode_pool.PopCompleted(decoded, MaxUploadBatchSize))
             {
-                UpdateTextureRequest tr;
-                if (m_update_texture_request.Pop(tr))
+                for (auto& result : decoded)
                 {
-                    auto&    texture      = Renderer->Device->GlobalTextures->Access(tr.Handle);
-                    auto&    spec         = texture->Specification;
-                    auto     image_handle = texture->ImageBuffer->GetHandle();
-                    uint32_t image_aspect = (texture->Specification.Format == Specifications::ImageFormat::DEPTH_STENCIL_FROM_DEVICE) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
-
-                    if (Renderer->Device->HasSeperateTransfertQueueFamily)
+                    UpdateTextureRequest request;
                     {
-                        Specifications::ImageMemoryBarrierSpecification barrier_spec_0 = {};
-                        barrier_spec_0.ImageHandle                                     = image_handle;
-                        barrier_spec_0.OldLayout                                       = Specifications::ImageLayout::TRANSFER_DST_OPTIMAL;
-                        barrier_spec_0.NewLayout                                       = VkImageAspectFlagBits(image_aspect) == VK_IMAGE_ASPECT_DEPTH_BIT ? Specifications::ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL : Specifications::ImageLayout::SHADER_READ_ONLY_OPTIMAL;
-                        barrier_spec_0.ImageAspectMask                                 = VkImageAspectFlagBits(image_aspect);
-                        barrier_spec_0.SourceAccessMask                                = VK_ACCESS_TRANSFER_WRITE_BIT;
-                        barrier_spec_0.DestinationAccessMask                           = VK_ACCESS_NONE;
-                        barrier_spec_0.SourceStageMask                                 = VK_PIPELINE_STAGE_TRANSFER_BIT;
-                        barrier_spec_0.DestinationStageMask                            = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-                        barrier_spec_0.LayerCount                                      = spec.LayerCount;
-                        barrier_spec_0.SourceQueueFamily                               = Renderer->Device->TransferFamilyIndex;
-                        barrier_spec_0.DestinationQueueFamily                          = Renderer->Device->GraphicFamilyIndex;
-                        Primitives::ImageMemoryBarrier barrier_0{barrier_spec_0};
-                        auto                           command_buffer_0 = m_buffer_manager.GetInstantCommandBuffer(QueueType::TRANSFER_QUEUE, Renderer->Device->CurrentFrameIndex);
+                        std::lock_guard l(m_mutex);
+                        auto            it = m_decoding_textures.find(result.Request.Tag);
+                        if (it != m_decoding_textures.end())
                         {
-                            command_buffer_0->TransitionImageLayout(barrier_0);
+                            request = std::move(it->second);
+                            m_decoding_textures.erase(it);
                         }
-                        m_buffer_manager.EndInstantCommandBuffer(command_buffer_0, Renderer->Device);
                     }
 
-                    VkAccessFlags                                   access_flag  = Renderer->Device->HasSeperateTransfertQueueFamily ? VK_ACCESS_NONE : VK_ACCESS_TRANSFER_WRITE_BIT;
-                    VkPipelineStageFlagBits                         src_stage    = Renderer->Device->HasSeperateTransfertQueueFamily ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-                    Specifications::ImageMemoryBarrierSpecification barrier_spec = {};
-                    barrier_spec.ImageHandle                                     = image_handle;
-                    barrier_spec.OldLayout                                       = Specifications::ImageLayout::TRANSFER_DST_OPTIMAL;
-                    barrier_spec.NewLayout                                       = VkImageAspectFlagBits(image_aspect) == VK_IMAGE_ASPECT_DEPTH_BIT ? Specifications::ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL : Specifications::ImageLayout::SHADER_READ_ONLY_OPTIMAL;
-                    barrier_spec.ImageAspectMask                                 = VkImageAspectFlagBits(image_aspect);
-                    barrier_spec.SourceAccessMask                                = access_flag;
-                    barrier_spec.DestinationAccessMask                           = VK_ACCESS_SHADER_READ_BIT;
-                    barrier_spec.SourceStageMask                                 = src_stage;
-                    barrier_spec.DestinationStageMask                            = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-                    barrier_spec.LayerCount                                      = spec.LayerCount;
-                    barrier_spec.SourceQueueFamily                               = Renderer->Device->TransferFamilyIndex;
-                    barrier_spec.DestinationQueueFamily                          = Renderer->Device->GraphicFamilyIndex;
-                    Primitives::ImageMemoryBarrier barrier{barrier_spec};
-
-                    auto                           command_buffer = m_buffer_manager.GetInstantCommandBuffer(QueueType::GRAPHIC_QUEUE, Renderer->Device->CurrentFrameIndex);
+                    /*
+                     * The placeholder texture may have been removed while its file was decoding. A streamed decode fills the
+                     * texture it carries, the slot it is published to is only written and read by the main thread
+                     */
+                    const auto& handle  = request.Handle;
+                    bool        alive   = Renderer->Device->GlobalTextures->IsAlive(handle);
+                    auto*       texture = request.Texture ? (alive ? &(request.Texture) : nullptr) : Renderer->Device->GlobalTextures->TryAccess(handle);
+                    if (!result.Succeeded || !texture || !(*texture))
                     {
-                        command_buffer->TransitionImageLayout(barrier);
+                        if (!result.Succeeded)
+                        {
+                            ZENGINE_CORE_ERROR("Failed to load texture file : {0}", result.Request.Filename)
+                        }
+                        if (alive)
+                        {
+                            std::lock_guard l(m_mutex);
+                            m_streamer.OnFailed(handle.Index);
+                        }
+                        m_decode_pool.Release(result.ReservedByteSize);
+                        continue;
                     }
-                    m_buffer_manager.EndInstantCommandBuffer(command_buffer, Renderer->Device);
 
-                    Renderer->Device->TextureHandleToUpdates.Enqueue(tr.Handle);
-                }
-            }
-
-            // Processing upload requests
-            if (m_upload_requests.Size())
-            {
-                TextureUploadRequest upload_request;
-                if (m_upload_requests.Pop(upload_request))
-                {
-                    auto&    texture        = Renderer->Device->GlobalTextures->Access(upload_request.Handle);
-                    uint32_t image_aspect   = (texture->Specification.Format == Specifications::ImageFormat::DEPTH_STENCIL_FROM_DEVICE) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
-
-                    auto     command_buffer = m_buffer_manager.GetInstantCommandBuffer(QueueType::TRANSFER_QUEUE, Renderer->Device->CurrentFrameIndex);
+                    const auto& image          = result.Image;
+                    auto        staging        = Renderer->Device->AllocateStaging(image.ByteSize());
+                    uint64_t    transfer_token = 0;
+                    if (staging)
                     {
-                        auto                                            image_handle   = texture->ImageBuffer->GetHandle();
-                        auto&                                           image_buffer   = texture->ImageBuffer->GetBuffer();
-
-                        Specifications::ImageMemoryBarrierSpecification barrier_spec_0 = {};
-                        barrier_spec_0.ImageHandle                                     = image_handle;
-                        barrier_spec_0.OldLayout                                       = Specifications::ImageLayout::UNDEFINED;
-                        barrier_spec_0.NewLayout                                       = Specifications::ImageLayout::TRANSFER_DST_OPTIMAL;
-                        barrier_spec_0.ImageAspectMask                                 = VkImageAspectFlagBits(image_aspect);
-                        barrier_spec_0.SourceAccessMask                                = 0;
-                        barrier_spec_0.DestinationAccessMask                           = VK_ACCESS_TRANSFER_WRITE_BIT;
-                        barrier_spec_0.SourceStageMask                                 = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-                        barrier_spec_0.DestinationStageMask                            = VK_PIPELINE_STAGE_TRANSFER_BIT;
-                        barrier_spec_0.LayerCount                                      = upload_request.TextureSpec.LayerCount;
-                        barrier_spec_0.SourceQueueFamily                               = Renderer->Device->TransferFamilyIndex;
-                        barrier_spec_0.DestinationQueueFamily                          = Renderer->Device->TransferFamilyIndex;
-                        Primitives::ImageMemoryBarrier barrier_0{barrier_spec_0};
-                        command_buffer->TransitionImageLayout(barrier_0);
-
-                        BufferView staging_buffer = Renderer->Device->CreateBuffer(upload_request.BufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT);
-                        Renderer->Device->MapAndCopyToMemory(staging_buffer, upload_request.BufferSize, upload_request.TextureSpec.Data);
-                        command_buffer->CopyBufferToImage(staging_buffer, image_buffer, upload_request.TextureSpec.Width, upload_request.TextureSpec.Height, upload_request.TextureSpec.LayerCount, barrier_0.GetHandle().newLayout);
-                        Renderer->Device->EnqueueBufferForDeletion(staging_buffer);
+                        ZENGINE_VALIDATE_ASSERT(Helpers::secure_memcpy(staging.Data, staging.ByteSize, image.Pixels.data(), image.ByteSize()) == Helpers::MEMORY_OP_SUCCESS, "Failed to perform memory copy operation")
+                        Renderer->Device->FlushStaging(staging);
+
+                        /*
+                         * The levels the decode didn't filter are blitted from the last one it did
+                         */
+                        level_offsets.resize(image.MipLevelCount);
+                        for (uint32_t level = 0; level < image.MipLevelCount; ++level)
+                        {
+                            level_offsets[level] = image.MipByteOffset(level);
+                        }
+                        transfer_token = Renderer->Device->CopyBufferToImage(staging, (*texture)->ImageBuffer->GetBuffer(), image.Width, image.Height, image.LayerCount, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, (*texture)->Specification.MipLevels, level_offsets);
                     }
-                    m_buffer_manager.EndInstantCommandBuffer(command_buffer, Renderer->Device, VK_PIPELINE_STAGE_TRANSFER_BIT);
+                    Renderer->Device->ReleaseStaging(staging, transfer_token);
 
-                    UpdateTextureRequest tr = {.Handle = upload_request.Handle};
+                    /*
+                     * The pixels are in the staging memory now, their share of the decode budget goes to the next requests
+                     */
+                    result.Image = {};
+                    m_decode_pool.Release(result.ReservedByteSize);
 
-                    m_update_texture_request.Emplace(std::move(tr));
-
-                    /* Cleanup resource */
-                    ZENGINE_CLEAR_STD_VECTOR(m_temp_buffer)
+                    request.TransferToken = transfer_token;
+                    m_update_texture_request.Emplace(std::move(request));
                 }
+
+                Renderer->Device->FlushTransfers();
             }
 
-            // Processing file requests
-            TextureFileRequest file_request;
-            if (m_file_requests.Pop(file_request))
+            // Processing update requests
+            size_t update_count = m_update_texture_request.Size();
+            for (size_t i = 0; i < update_count; ++i)
             {
-                const std::set<std::string_view>     known_cubmap_file_ext = {".hdr", ".exr"};
-                auto                                 file_ext              = std::filesystem::path(file_request.Filename).extension().string();
-
-                Specifications::TextureSpecification spec{};
-                if (known_cubmap_file_ext.contains(file_ext))
+                UpdateTextureRequest tr;
+                if (!m_update_texture_request.Pop(tr))
                 {
-                    stbi_set_flip_vertically_on_load(1);
-                    spec.IsCubemap = true;
+                    break;
                 }
 
-                int width = 0, height = 0, channel = 0;
-
-                if (spec.IsCubemap)
+                /*
+                 * The batch carries the layout transition and the queue ownership transfer, the texture is published once its
+                 * transfer completed. With no decode left to upload, waiting beats spinning on the queue.
+                 */
+                bool idle = !m_decode_pool.HasCompleted();
+                if (Renderer->Device->IsTransferComplete(tr.TransferToken) || (idle && Renderer->Device->WaitTransfer(tr.TransferToken)))
                 {
-                    const float* image_data = stbi_loadf(file_request.Filename.data(), &width, &height, &channel, 4);
-                    if (!image_data)
+                    /*
+                     * Both queues are drained by the main thread, which may be waiting on this one : a full queue sends the
+                     * request back for the next pass instead of blocking
+                     */
+                    uint32_t index     = tr.Handle.Index;
+                    bool     published = tr.Texture ? m_streamed_textures.TryEmplace(std::move(tr)) : Renderer->Device->TextureHandleToUpdates.TryEnqueue(tr.Handle);
+                    if (!published)
                     {
-                        ZENGINE_CORE_ERROR("Failed to load texture file : {0}", file_request.Filename.data())
+                        m_update_texture_request.Emplace(std::move(tr));
                         continue;
                     }
 
-                    spec.LayerCount                                = 6;
-                    spec.Format                                    = Specifications::ImageFormat::R32G32B32A32_SFLOAT;
-
-                    bool               perform_convert_rgb_to_rgba = (channel == STBI_rgb);
+                    std::lock_guard l(m_mutex);
+                    m_streamer.OnResident(index);
+                }
+                else
+                {
+                    m_update_texture_request.Emplace(std::move(tr));
+                }
+            }
+        }
+    }
 
-                    std::vector<float> output_buffer               = {};
-                    if (perform_convert_rgb_to_rgba)
-                    {
-                        size_t total_pixel = width * height;
-                        size_t buffer_size = total_pixel * 4;
-                        output_buffer.resize(buffer_size);
-                        stbir_resize_float(image_data, width, height, 0, output_buffer.data(), width, height, 0, 4);
+    void AsyncResourceLoader::Shutdown()
+    {
+        /*
+         * Running decodes complete first : they notify this loader
+         */
+        m_decode_pool.Shutdown();
+        {
+            std::unique_lock l(m_mutex);
+            m_cancellation_token = true;
+            m_decoding_textures.clear();
+        }
+        m_cond.notify_one();
 
-                        for (int i = 0; i < total_pixel; ++i)
-                        {
-                            int offset = i * 4; // RGBA format (4 channels)
-
-                            if (channel == 1)
-                            {
-                                output_buffer[offset + 3] = 255;
-                            }
-                            else if (channel == 2)
-                            {
-                                output_buffer[offset + 3] = image_data[i * 2 + 1];
-                            }
-                            else if (channel == 3)
-                            {
-                                output_buffer[offset + 3] = 255;
-                            }
-                        }
-                    }
-                    else
-                    {
-                        size_t total_pixel = width * height;
-                        size_t buffer_size = total_pixel * channel;
-                        output_buffer.resize(buffer_size);
-                        Helpers::secure_memset(output_buffer.data(), 0.f, buffer_size, buffer_size);
-                    }
+        if (m_run_future.valid())
+        {
+            m_run_future.wait();
+        }
 
-                    stbi_image_free((void*) image_data);
+        m_streamed_textures.Clear();
+        m_retired_textures.clear();
+    }
 
-                    Buffers::Bitmap in             = {width, height, 4, Buffers::BitmapFormat::FLOAT, output_buffer.data()};
-                    Buffers::Bitmap vertical_cross = Buffers::Bitmap::EquirectangularMapToVerticalCross(in);
-                    Buffers::Bitmap cubemap        = Buffers::Bitmap::VerticalCrossToCubemap(vertical_cross);
+    void AsyncResourceLoader::EnqueueTextureRequest(std::string_view file, const Textures::TextureHandle& handle, Helpers::TaskPriority priority, std::optional<Buffers::MipChainOptions> cpu_mip_chain, bool decompress_blocks)
+    {
+        EnqueueDecode({.Filename = std::string(file), .Priority = priority, .GenerateMipChain = cpu_mip_chain.has_value(), .MipOptions = cpu_mip_chain.value_or(Buffers::MipChainOptions{}), .DecompressBlocks = decompress_blocks}, {.Handle = handle});
+    }
 
-                    spec.Width                     = cubemap.Width;
-                    spec.Height                    = cubemap.Height;
-                    size_t buffer_size             = cubemap.Buffer.size();
-                    size_t buffer_byte             = buffer_size * sizeof(uint8_t);
-                    m_temp_buffer.resize(buffer_size);
-                    Helpers::secure_memmove(m_temp_buffer.data(), buffer_byte, cubemap.Buffer.data(), buffer_byte);
-                }
-                else
-                {
-                    stbi_set_flip_vertically_on_load(1);
+    void AsyncResourceLoader::ReportTextureUsage(std::span<const Textures::TextureUsageReport> reports)
+    {
+        std::lock_guard l(m_mutex);
+        for (const auto& report : reports)
+        {
+            m_streamer.ReportUsage(report.Key, report.ScreenSize);
+        }
+    }
 
-                    stbi_uc* image_data = stbi_load(file_request.Filename.data(), &width, &height, &channel, STBI_rgb_alpha);
-                    if (!image_data)
-                    {
-                        ZENGINE_CORE_ERROR("Failed to load texture file : {0}", file_request.Filename.data())
-                        continue;
-                    }
+    void AsyncResourceLoader::SetTextureStreamingOptions(const Textures::TextureStreamingOptions& options)
+    {
+        std::lock_guard l(m_mutex);
+        m_streamer.SetOptions(options);
+    }
 
-                    bool perform_convert_rgb_to_rgba = (channel <= STBI_rgb);
+    void AsyncResourceLoader::UpdateStreaming()
+    {
+        uint64_t frame = 0;
+        {
+            std::lock_guard l(m_mutex);
+            frame = m_streamer.Frame();
+        }
 
-                    if (perform_convert_rgb_to_rgba)
-                    {
-                        size_t total_pixel = width * height;
-                        size_t buffer_size = total_pixel * 4;
-                        m_temp_buffer.resize(buffer_size);
-                        stbir_resize_uint8(image_data, width, height, 0, m_temp_buffer.data(), width, height, 0, 4);
+        /*
+         * The slot takes the new levels, the descriptor follows on the next device update. GlobalTextures::Update() can't race
+         * with the readers of the slot : they all run on this thread. A tail lands in the texture already in its slot
+         */
+        UpdateTextureRequest streamed;
+        while (m_streamed_textures.Pop(streamed))
+        {
+            auto* current = Renderer->Device->GlobalTextures->TryAccess(streamed.Handle);
+            if (!current)
+            {
+                continue;
+            }
+            if (*current != streamed.Texture)
+            {
+                m_retired_textures.push_back({.Texture = *current, .Frame = frame});
+                Renderer->Device->GlobalTextures->Update(streamed.Handle, std::move(streamed.Texture));
+            }
+            Renderer->Device->EnqueueTextureUpdate(streamed.Handle);
+        }
 
-                        for (int i = 0; i < total_pixel; ++i)
-                        {
-                            int offset = i * 4; // RGBA format (4 channels)
-
-                            if (channel == 1)
-                            {
-                                m_temp_buffer[offset + 3] = 255;
-                            }
-                            else if (channel == 2)
-                            {
-                                m_temp_buffer[offset + 3] = image_data[i * 2 + 1];
-                            }
-                            else if (channel == 3)
-                            {
-                                m_temp_buffer[offset + 3] = 255;
-                            }
-                        }
-                    }
-                    else
-                    {
-                        size_t total_pixel = width * height;
-                        size_t buffer_size = total_pixel * channel;
-                        m_temp_buffer.resize(buffer_size, 0);
-                        Helpers::secure_memmove(m_temp_buffer.data(), buffer_size, image_data, buffer_size);
-                    }
+        std::erase_if(m_retired_textures, [this, frame](const RetiredTexture& retired) { return (frame - retired.Frame) > Renderer->Device->SwapchainImageCount; });
 
-                    spec.Width      = width;
-                    spec.Height     = height;
-                    spec.LayerCount = 1;
-                    spec.Format     = Specifications::ImageFormat::R8G8B8A8_SRGB;
+        std::vector<std::pair<StreamedTextureFile, uint32_t>> loads;
+        {
+            std::lock_guard l(m_mutex);
 
-                    stbi_image_free(image_data);
+            /*
+             * Removed textures give their levels back to the budget
+             */
+            std::erase_if(m_streamed_files, [this](const auto& entry) {
+                if (Renderer->Device->GlobalTextures->IsAlive(entry.second.Handle))
+                {
+                    return false;
                 }
+                m_streamer.Unregister(entry.first);
+                return true;
+            });
 
-                spec.Data         = m_temp_buffer.data();
-                spec.BytePerPixel = Specifications::BytePerChannelMap[VALUE_FROM_SPEC_MAP(spec.Format)];
-
-                m_upload_requests.Emplace({.BufferSize = (m_temp_buffer.size() * sizeof(uint8_t)), .Handle = file_request.Handle, .TextureSpec = std::move(spec)});
+            m_streaming_actions.clear();
+            m_streamer.Update(m_streaming_actions);
+            for (const auto& action : m_streaming_actions)
+            {
+                loads.emplace_back(m_streamed_files.at(action.Key), action.FirstLevel);
             }
         }
 
-        ZENGINE_CLEAR_STD_VECTOR(m_temp_buffer)
+        for (auto& [file, first_level] : loads)
+        {
+            EnqueueStreamedDecode(file, first_level, Renderer->CreateTexture(StreamedLevelSpecification(file.Specification, first_level)));
+        }
     }
 
-    void AsyncResourceLoader::Shutdown()
+    void AsyncResourceLoader::EnqueueDecode(Textures::TextureDecodeRequest&& request, UpdateTextureRequest&& texture)
     {
         {
-            std::unique_lock l(m_mutex);
-            m_cancellation_token = true;
+            std::lock_guard l(m_mutex);
+            request.Tag                      = m_next_decode_tag++;
+            m_decoding_textures[request.Tag] = std::move(texture);
         }
-        m_cond.notify_one();
-
-        m_buffer_manager.Deinitialize();
+        m_decode_pool.Enqueue(std::move(request));
     }
 
-    void AsyncResourceLoader::EnqueueTextureRequest(std::string_view file, const Textures::TextureHandle& handle)
+    void AsyncResourceLoader::EnqueueStreamedDecode(const StreamedTextureFile& file, uint32_t first_level, Textures::TextureRef&& texture)
     {
-        m_file_requests.Emplace({.Filename = file.data(), .Handle = handle});
-        m_cond.notify_one();
+        /*
+         * Skipped levels can't be blitted from : the decode filters the chain and keeps what follows first_level
+         */
+        Textures::TextureDecodeRequest request = {
+            .Filename         = file.Filename,
+            .Priority         = file.Priority,
+            .GenerateMipChain = !file.IsTextureAsset && (file.CpuMipChain || (first_level > 0)),
+            .MipOptions       = file.MipOptions,
+            .DecompressBlocks = file.DecompressBlocks,
+            .FirstMipLevel    = first_level,
+        };
+        EnqueueDecode(std::move(request), {.Handle = file.Handle, .Texture = std::move(texture)});
     }
 } // namespace ZEngine::Rendering::Renderers
@@ -1,15 +1,23 @@
 #pragma once
 #include <Camera.h>
 #include <Hardwares/VulkanDevice.h>
+#include <Helpers/LockFreeQueue.h>
 #include <Helpers/ThreadSafeQueue.h>
 #include <ImGUIRenderer.h>
 #include <Primitives/Fence.h>
 #include <Primitives/Semaphore.h>
 #include <RenderPasses/RenderPass.h>
 #include <Rendering/Renderers/RenderGraph.h>
+#include <Rendering/Scenes/SceneCulling.h>
+#include <Rendering/Scenes/SceneLod.h>
+#include <Rendering/Textures/TextureDecodePool.h>
+#include <Rendering/Textures/TextureStreamer.h>
 #include <Textures/Texture.h>
 #include <vulkan/vulkan.h>
+#include <future>
+#include <optional>
 #include <span>
+#include <unordered_map>
 
 namespace ZEngine::Rendering::Renderers
 {
@@ -22,20 +30,14 @@ namespace ZEngine::Rendering::Renderers
     struct UpdateTextureRequest
     {
         Textures::TextureHandle Handle;
+        /*
+         * Streamed levels are uploaded to a texture of their own, it takes the place of Handle once they landed
+         */
         Textures::TextureRef    Texture;
-    };
-
-    struct TextureFileRequest
-    {
-        std::string             Filename;
-        Textures::TextureHandle Handle;
-    };
-
-    struct TextureUploadRequest
-    {
-        size_t                               BufferSize;
-        Textures::TextureHandle              Handle;
-        Specifications::TextureSpecification TextureSpec;
+        /*
+         * Transfer batch uploading the texture, 0 when there was nothing to upload
+         */
+        uint64_t                TransferToken = 0;
     };
 
     struct AsyncResourceLoader;
@@ -54,6 +56,14 @@ namespace ZEngine::Rendering::Renderers
         Helpers::Scope<RenderGraph>             RenderGraph                = nullptr;
         Helpers::Ref<AsyncResourceLoader>       AsyncLoader                = nullptr;
         Helpers::ThreadSafeQueue<ResizeRequest> EnqueuedResizeRequests     = {};
+        /*
+         * Frustum of the camera the current frame is drawn with
+         */
+        Scenes::Frustum                         CameraFrustum              = {};
+        /*
+         * Camera position and projection the mesh levels are selected with
+         */
+        Scenes::LodView                         CameraLodView              = {};
 
         void                                    Initialize(Hardwares::VulkanDevice* device);
         void                                    Deinitialize();
@@ -69,6 +79,15 @@ namespace ZEngine::Rendering::Renderers
     private:
     };
 
+    /*
+     * Texture files are decoded on the thread pool by m_decode_pool, within its memory budget and in priority order.
+     * Run() is the only thread touching the device : it collects the finished decodes and uploads them in batches of at most
+     * MaxUploadBatchSize, one transfer submission per batch, then publishes each texture once its transfer completed.
+     *
+     * 2D textures with a mip chain are streamed : they start with their tail, then m_streamer decides from the usage reported
+     * every frame which levels to load or evict. A change of levels decodes the file again into a new texture, swapped in by
+     * UpdateStreaming() once uploaded : the bindless slot, and so the materials, keep their texture index.
+     */
     struct AsyncResourceLoader : public Helpers::RefCounted
     {
         GraphicRenderer*        Renderer = nullptr;
@@ -77,18 +96,86 @@ namespace ZEngine::Rendering::Renderers
         void                    Run();
         void                    Shutdown();
 
-        void                    EnqueueTextureRequest(std::string_view file, const Textures::TextureHandle& handle);
-        Textures::TextureHandle LoadTextureFile(std::string_view filename);
+        /*
+         * cpu_mip_chain : the mip levels are filtered on the decode thread with these options, instead of blitted on the GPU
+         * decompress_blocks : a block compressed file is uploaded as RGBA8 / RGBA32F
+         */
+        void                    EnqueueTextureRequest(std::string_view file, const Textures::TextureHandle& handle, Helpers::TaskPriority priority = Helpers::TaskPriority::Normal, std::optional<Buffers::MipChainOptions> cpu_mip_chain = std::nullopt, bool decompress_blocks = false);
+        /*
+         * 2D textures get a full mip chain. Normal maps are stored linear (UNORM) and renormalized at every level.
+         * A .zetexture keeps the block format and the mip chain it was imported with
+         */
+        Textures::TextureHandle LoadTextureFile(std::string_view filename, Helpers::TaskPriority priority = Helpers::TaskPriority::Normal, bool is_normal_map = false);
         Textures::TextureHandle LoadTextureFileSync(std::string_view filename);
+        /*
+         * Screen sizes of the textures drawn this frame, keyed by their GlobalTextures index
+         */
+        void                    ReportTextureUsage(std::span<const Textures::TextureUsageReport> reports);
+        /*
+         * Main thread, once a frame : swaps in the streamed textures that landed, then closes the frame of the streaming policy
+         * and issues its actions
+         */
+        void                    UpdateStreaming();
+        void                    SetTextureStreamingOptions(const Textures::TextureStreamingOptions& options);
 
     private:
-        std::atomic_bool                               m_cancellation_token{false};
-        std::mutex                                     m_mutex;
-        std::condition_variable                        m_cond;
-        std::vector<uint8_t>                           m_temp_buffer{};
-        Hardwares::CommandBufferManager                m_buffer_manager{};
-        Helpers::ThreadSafeQueue<UpdateTextureRequest> m_update_texture_request;
-        Helpers::ThreadSafeQueue<TextureFileRequest>   m_file_requests;
-        Helpers::ThreadSafeQueue<TextureUploadRequest> m_upload_requests;
+        static constexpr size_t MaxUploadBatchSize           = 16;
+        static constexpr size_t StreamedTextureQueueCapacity = 256;
+
+        /*
+         * What it takes to decode the levels of a streamed texture again
+         */
+        struct StreamedTextureFile
+        {
+            Textures::TextureHandle              Handle           = {};
+            std::string                          Filename         = {};
+            Helpers::TaskPriority                Priority         = Helpers::TaskPriority::Normal;
+            /*
+             * The full mip chain
+             */
+            Specifications::TextureSpecification Specification    = {};
+            /*
+             * Filtered on the decode thread even when all the levels are loaded, otherwise only when the first ones are skipped
+             */
+            bool                                 CpuMipChain      = false;
+            Buffers::MipChainOptions             MipOptions       = {};
+            bool                                 IsTextureAsset   = false;
+            bool                                 DecompressBlocks = false;
+        };
+
+        struct RetiredTexture
+        {
+            Textures::TextureRef Texture = {};
+            uint64_t             Frame   = 0;
+        };
+
+        void EnqueueDecode(Textures::TextureDecodeRequest&& request, UpdateTextureRequest&& texture);
+        void EnqueueStreamedDecode(const StreamedTextureFile& file, uint32_t first_level, Textures::TextureRef&& texture);
+
+        std::atomic_bool                                   m_cancellation_token{false};
+        std::mutex                                         m_mutex;
+        std::condition_variable                            m_cond;
+        std::future<void>                                  m_run_future;
+        /*
+         * Textures waiting for their decode, keyed by the tag of their decode request. Guarded by m_mutex
+         */
+        uint64_t                                           m_next_decode_tag = 0;
+        std::unordered_map<uint64_t, UpdateTextureRequest> m_decoding_textures;
+        Helpers::ThreadSafeQueue<UpdateTextureRequest>     m_update_texture_request;
+        Textures::TextureDecodePool                        m_decode_pool;
+        /*
+         * Guarded by m_mutex, keyed by GlobalTextures index
+         */
+        Textures::TextureStreamer                          m_streamer;
+        std::unordered_map<uint32_t, StreamedTextureFile>  m_streamed_files;
+        /*
+         * Uploaded streamed textures waiting for UpdateStreaming() to take their slot, Run() only ever tries to enqueue
+         */
+        Helpers::LockFreeQueue<UpdateTextureRequest>       m_streamed_textures{StreamedTextureQueueCapacity};
+        /*
+         * Main thread only : replaced textures, kept alive while the frames in flight may still sample them
+         */
+        std::vector<RetiredTexture>                        m_retired_textures;
+        std::vector<Textures::TextureStreamingAction>      m_streaming_actions;
     };
 } // namespace ZEngine::Rendering::Renderers
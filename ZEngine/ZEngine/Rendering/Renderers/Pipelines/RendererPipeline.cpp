@@ -1,5 +1,6 @@
 #include <pch.h>
 #include <Hardwares/VulkanDevice.h>
+#include <Helpers/ThreadPool.h>
 #include <Managers/ShaderManager.h>
 #include <Rendering/Renderers/Pipelines/RendererPipeline.h>
 
@@ -23,6 +24,22 @@ namespace ZEngine::Rendering::Renderers::Pipelines
     }
 
     void GraphicPipeline::Bake()
+    {
+        auto bake_flag = std::make_shared<std::once_flag>();
+        m_bake_flag    = bake_flag;
+
+        ThreadPoolHelper::Post([pipeline = Ref<GraphicPipeline>(this), bake_flag] { std::call_once(*bake_flag, [&pipeline] { pipeline->__create(); }); }, TaskPriority::High);
+    }
+
+    void GraphicPipeline::__waitBake() const
+    {
+        if (m_bake_flag)
+        {
+            std::call_once(*m_bake_flag, [this] { const_cast<GraphicPipeline*>(this)->__create(); });
+        }
+    }
+
+    void GraphicPipeline::__create()
     {
         /*Pipeline fixed states*/
         /*
@@ -170,11 +187,18 @@ namespace ZEngine::Rendering::Renderers::Pipelines
         graphic_pipeline_create_info.basePipelineIndex             = -1;             // Optional
         graphic_pipeline_create_info.flags                         = 0;              // Optional
         graphic_pipeline_create_info.pNext                         = nullptr;        // Optional
-        ZENGINE_VALIDATE_ASSERT(vkCreateGraphicsPipelines(m_device->LogicalDevice, VK_NULL_HANDLE, 1, &graphic_pipeline_create_info, nullptr, &m_pipeline_handle) == VK_SUCCESS, "Failed to create Graphics Pipeline")
+        ZENGINE_VALIDATE_ASSERT(vkCreateGraphicsPipelines(m_device->LogicalDevice, m_device->PipelineCache, 1, &graphic_pipeline_create_info, nullptr, &m_pipeline_handle) == VK_SUCCESS, "Failed to create Graphics Pipeline")
     }
 
     void GraphicPipeline::Dispose()
     {
+        /*
+         * A bake nobody started yet is dropped, a running one is waited for
+         */
+        if (m_bake_flag)
+        {
+            std::call_once(*m_bake_flag, [] {});
+        }
         m_shader->Dispose();
 
         m_device->EnqueueForDeletion(Rendering::DeviceResourceType::PIPELINE_LAYOUT, m_pipeline_layout);
@@ -185,11 +209,13 @@ namespace ZEngine::Rendering::Renderers::Pipelines
 
     VkPipeline GraphicPipeline::GetHandle() const
     {
+        __waitBake();
         return m_pipeline_handle;
     }
 
     VkPipelineLayout GraphicPipeline::GetPipelineLayout() const
     {
+        __waitBake();
         return m_pipeline_layout;
     }
 
@@ -4,6 +4,8 @@
 #include <Rendering/Specifications/GraphicRendererPipelineSpecification.h>
 #include <ZEngineDef.h>
 #include <vulkan/vulkan.h>
+#include <memory>
+#include <mutex>
 
 namespace ZEngine::Rendering::Renderers::Pipelines
 {
@@ -15,6 +17,10 @@ namespace ZEngine::Rendering::Renderers::Pipelines
 
         Specifications::GraphicRendererPipelineSpecification& GetSpecification();
         void                                                  SetSpecification(Specifications::GraphicRendererPipelineSpecification& spec);
+        /*
+         * Queues the pipeline creation on the thread pool and returns : passes baked one after the other compile in parallel.
+         * The first GetHandle() or GetPipelineLayout() waits for it, or creates the pipeline itself if no worker picked it up yet.
+         */
         void                                                  Bake();
         void                                                  Dispose();
         VkPipeline                                            GetHandle() const;
@@ -27,5 +33,12 @@ namespace ZEngine::Rendering::Renderers::Pipelines
         Specifications::GraphicRendererPipelineSpecification m_pipeline_specification;
         Helpers::Ref<Shaders::Shader>                        m_shader;
         Hardwares::VulkanDevice*                             m_device{nullptr};
+        /*
+         * Claimed by whichever of the pool task or the first user of the handles runs first, the other one waits
+         */
+        std::shared_ptr<std::once_flag>                      m_bake_flag;
+
+        void                                                 __create();
+        void                                                 __waitBake() const;
     };
 } // namespace ZEngine::Rendering::Renderers::Pipelines
\ No newline at end of file
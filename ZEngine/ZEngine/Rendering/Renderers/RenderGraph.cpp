@@ -69,7 +69,7 @@ namespace ZEngine::Rendering::Renderers
 
         m_graph.m_resource_map[resource_name].Name                       = name.data();
         m_graph.m_resource_map[resource_name].Type                       = RenderGraphResourceType::TEXTURE;
-        m_graph.m_resource_map[resource_name].ResourceInfo.TextureHandle = m_graph.Renderer->AsyncLoader->LoadTextureFile(filename);
+        m_graph.m_resource_map[resource_name].ResourceInfo.TextureHandle = m_graph.Renderer->AsyncLoader->LoadTextureFile(filename, Helpers::TaskPriority::High);
         return m_graph.m_resource_map[resource_name];
     }
 
@@ -404,7 +404,7 @@ namespace ZEngine::Rendering::Renderers
 
                 if ((output.Name == Renderer->FrameColorRenderTargetName) || (output.Name == Renderer->FrameDepthRenderTargetName))
                 {
-                    Renderer->Device->TextureHandleToUpdates.Enqueue(resource.ResourceInfo.TextureHandle);
+                    Renderer->Device->EnqueueTextureUpdate(resource.ResourceInfo.TextureHandle);
                 }
                 pass_spec.ExternalOutputs.emplace_back(resource.ResourceInfo.TextureHandle);
             }
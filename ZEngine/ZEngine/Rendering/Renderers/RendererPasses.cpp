@@ -80,6 +80,7 @@ namespace ZEngine::Rendering::Renderers
             pass->SetInput("VertexSB", scene->VertexBufferHandle);
             pass->SetInput("IndexSB", scene->IndexBufferHandle);
             pass->SetInput("DrawDataSB", scene->IndirectDataDrawBufferHandle);
+            pass->SetInput("InstanceSB", scene->InstanceBufferHandle);
             pass->SetInput("TransformSB", scene->TransformBufferHandle);
         }
         pass->Verify();
@@ -95,7 +96,98 @@ namespace ZEngine::Rendering::Renderers
             return;
         }
         auto& transfor_buffer = graph->Renderer->Device->StorageBufferSetManager.Access(scene->TransformBufferHandle);
-        transfor_buffer->SetData<glm::mat4>(frame_index, scene->GlobalTransforms);
+        for (const auto& range : scene->ChangedTransformRanges)
+        {
+            transfor_buffer->MarkDirty(range.Offset, range.ByteSize);
+        }
+        scene->ChangedTransformRanges.clear();
+
+        /*
+         * Only the ranges that are stale for this frame's copy get uploaded, an unchanged scene uploads nothing
+         */
+        transfor_buffer->SyncData<glm::mat4>(frame_index, scene->GlobalTransforms);
+
+        /*
+         * Culling against the camera frustum, the compacted command list is shared by every pass drawing the scene this frame.
+         * Every visible draw takes the coarsest level of its mesh whose error stays under a pixel, through firstVertex, then draws
+         * sharing a mesh, a material and a level are batched as instances of one command.
+         */
+        if (!scene->IndirectBufferHandle)
+        {
+            return;
+        }
+        auto        visible_draws = scene->Culling.Cull(graph->Renderer->CameraFrustum, scene->GlobalTransforms);
+        auto        world_bounds  = scene->Culling.WorldBounds();
+        const auto& lod_view      = graph->Renderer->CameraLodView;
+
+        m_visible_draw_ranges.resize(visible_draws.size());
+        for (size_t i = 0; i < visible_draws.size(); ++i)
+        {
+            uint32_t             draw  = visible_draws[i];
+            Scenes::DrawLodRange range = {.FirstIndex = 0, .IndexCount = scene->DrawData[draw].IndexCount};
+            if ((draw < scene->DrawLods.size()) && (scene->DrawLods[draw].LodCount > 1))
+            {
+                const auto& chain       = scene->DrawLods[draw];
+                float       world_scale = Scenes::LodSelector::MaxScale(scene->GlobalTransforms[scene->DrawData[draw].TransformIndex]);
+                range                   = chain.Lods[Scenes::LodSelector::SelectLod(chain, world_bounds[draw], world_scale, lod_view)];
+            }
+            m_visible_draw_ranges[i] = range;
+        }
+
+        /*
+         * Texture streaming feedback : a visible draw covers about the projected size of its bounds, its material maps are
+         * assumed to be laid once over them. Without bounds or a projection, the maps are asked at full resolution
+         */
+        m_texture_usage.clear();
+        for (uint32_t draw : visible_draws)
+        {
+            uint32_t material_index = scene->DrawData[draw].MaterialIndex;
+            if (material_index >= scene->Materials.size())
+            {
+                continue;
+            }
+
+            float       screen_size = std::numeric_limits<float>::max();
+            const auto& bounds      = world_bounds[draw];
+            if (bounds.Valid() && (lod_view.ProjectionScale > 0.0f))
+            {
+                glm::vec3 closest = glm::clamp(lod_view.Position, bounds.Min, bounds.Max);
+                screen_size       = Scenes::LodSelector::ProjectedError(glm::length(bounds.Max - bounds.Min), glm::length(lod_view.Position - closest), lod_view);
+            }
+
+            const auto& material = scene->Materials[material_index];
+            for (uint64_t map : {material.EmissiveMap, material.AlbedoMap, material.SpecularMap, material.NormalMap, material.OpacityMap})
+            {
+                if (map < INVALID_MAP_HANDLE)
+                {
+                    m_texture_usage.push_back({.Key = uint32_t(map), .ScreenSize = screen_size});
+                }
+            }
+        }
+        graph->Renderer->AsyncLoader->ReportTextureUsage(m_texture_usage);
+
+        Scenes::DrawInstancing::Batch(visible_draws, scene->DrawGroups, m_visible_draw_ranges, m_batched_draw_commands, m_visible_instance_draws);
+
+        m_visible_draw_commands.resize(m_batched_draw_commands.size());
+        for (size_t i = 0; i < m_batched_draw_commands.size(); ++i)
+        {
+            const auto& command        = m_batched_draw_commands[i];
+            m_visible_draw_commands[i] = {
+                .vertexCount   = command.VertexCount,
+                .instanceCount = command.InstanceCount,
+                .firstVertex   = command.FirstVertex,
+                .firstInstance = command.FirstInstance,
+            };
+        }
+
+        /*
+         * The instance buffer was sized for every draw, the visible ones always fit : its descriptor stays valid
+         */
+        auto& instance_buffer = graph->Renderer->Device->StorageBufferSetManager.Access(scene->InstanceBufferHandle);
+        instance_buffer->SetData<uint32_t>(frame_index, m_visible_instance_draws);
+
+        auto& indirect_buffer = graph->Renderer->Device->IndirectBufferSetManager.Access(scene->IndirectBufferHandle);
+        indirect_buffer->SetData<VkDrawIndirectCommand>(frame_index, m_visible_draw_commands);
     }
 
     void DepthPrePass::Render(uint32_t frame_index, Rendering::Scenes::SceneRawData* const scene, RenderPasses::RenderPass* pass, Buffers::FramebufferVNext* framebuffer, Hardwares::CommandBuffer* command_buffer, RenderGraph* graph)
@@ -274,6 +366,7 @@ namespace ZEngine::Rendering::Renderers
             pass->SetInput("VertexSB", scene->VertexBufferHandle);
             pass->SetInput("IndexSB", scene->IndexBufferHandle);
             pass->SetInput("DrawDataSB", scene->IndirectDataDrawBufferHandle);
+            pass->SetInput("InstanceSB", scene->InstanceBufferHandle);
             pass->SetInput("TransformSB", scene->TransformBufferHandle);
             pass->SetInput("MatSB", scene->MaterialBufferHandle);
         }
@@ -333,6 +426,7 @@ namespace ZEngine::Rendering::Renderers
         pass->SetInput("VertexSB", scene->VertexBufferHandle);
         pass->SetInput("IndexSB", scene->IndexBufferHandle);
         pass->SetInput("DrawDataSB", scene->IndirectDataDrawBufferHandle);
+        pass->SetInput("InstanceSB", scene->InstanceBufferHandle);
         pass->SetInput("TransformSB", scene->TransformBufferHandle);
         pass->SetInput("MatSB", scene->MaterialBufferHandle);
 
@@ -2,6 +2,7 @@
 #include <RenderGraph.h>
 #include <Rendering/Renderers/RenderPasses/RenderPass.h>
 #include <Rendering/Scenes/GraphicScene.h>
+#include <Rendering/Textures/TextureStreamer.h>
 #include <ZEngineDef.h>
 #include <vector>
 
@@ -32,6 +33,13 @@ namespace ZEngine::Rendering::Renderers
         virtual void Compile(Helpers::Ref<RenderPasses::RenderPass>& pass, RenderGraph* const graph, Rendering::Scenes::SceneRawData* const scene) override;
         virtual void Execute(uint32_t frame_index, Rendering::Scenes::SceneRawData* const scene_data, RenderPasses::RenderPass* const pass, Hardwares::CommandBuffer* const command_buffer, RenderGraph* const graph) override;
         virtual void Render(uint32_t frame_index, Rendering::Scenes::SceneRawData* const scene, RenderPasses::RenderPass* const pass, Buffers::FramebufferVNext* const framebuffer, Hardwares::CommandBuffer* const command_buffer, RenderGraph* const graph) override;
+
+    private:
+        std::vector<Scenes::DrawLodRange>         m_visible_draw_ranges;
+        std::vector<Scenes::DrawCommand>          m_batched_draw_commands;
+        std::vector<uint32_t>                     m_visible_instance_draws;
+        std::vector<VkDrawIndirectCommand>        m_visible_draw_commands;
+        std::vector<Textures::TextureUsageReport> m_texture_usage;
     };
 
     struct SkyboxPass : public IRenderGraphCallbackPass
@@ -118,6 +118,8 @@ namespace ZEngine::Rendering::Scenes
                 return;
             }
             scene->GlobalTransforms[m_node] = transform;
+            scene->ChangedTransformRanges.push_back({.Offset = m_node * sizeof(glm::mat4), .ByteSize = sizeof(glm::mat4)});
+            scene->Culling.InvalidateWorldBounds();
         }
     }
 
@@ -166,16 +168,32 @@ namespace ZEngine::Rendering::Scenes
     {
         auto                               draw_count         = SceneData->NodeMeshes.size();
         std::vector<VkDrawIndirectCommand> indirect_commmands = {};
+        std::vector<Meshes::BoundingBox>   draw_bounds        = {};
+        std::vector<uint32_t>              draw_transforms    = {};
+        std::vector<uint32_t>              draw_meshes        = {};
+        std::vector<uint32_t>              draw_materials     = {};
+        Meshes::CompactGeometry            compact_geometry   = {};
+
+        if (draw_count && UseCompactGeometry)
+        {
+            compact_geometry = Meshes::VertexQuantization::Compress(SceneData->Vertices, SceneData->Indices, SceneData->Meshes, SceneData->MeshLods);
+        }
+        const bool use_compact_geometry = !compact_geometry.Vertices.empty();
 
         if (draw_count)
         {
             SceneData->DrawData.resize(draw_count);
-            indirect_commmands.resize(draw_count);
+            SceneData->DrawLods.resize(draw_count);
+            draw_bounds.resize(draw_count);
+            draw_transforms.resize(draw_count);
+            draw_meshes.resize(draw_count);
+            draw_materials.resize(draw_count);
 
             int i = 0;
             for (auto& [node, mesh] : SceneData->NodeMeshes)
             {
                 DrawData& draw_data      = SceneData->DrawData[i];
+                draw_data                = {};
                 draw_data.TransformIndex = node;
                 draw_data.MaterialIndex  = SceneData->NodeMaterials[node];
                 draw_data.VertexOffset   = SceneData->Meshes[mesh].VertexOffset;
@@ -183,25 +201,79 @@ namespace ZEngine::Rendering::Scenes
                 draw_data.VertexCount    = SceneData->Meshes[mesh].VertexCount;
                 draw_data.IndexCount     = SceneData->Meshes[mesh].IndexCount;
 
+                Meshes::MeshLodChain lods = (mesh < SceneData->MeshLods.size()) ? SceneData->MeshLods[mesh] : Meshes::MeshLodChain{};
+
+                if (use_compact_geometry)
+                {
+                    const auto& compact    = compact_geometry.Meshes[mesh];
+                    draw_data.VertexOffset = compact.VertexOffset;
+                    draw_data.IndexOffset  = compact.IndexOffset;
+                    draw_data.VertexFormat = Meshes::VertexFormat::COMPACT;
+                    draw_data.IndexFormat  = compact.IndexFormat;
+                    glm::vec3   min        = compact.Bounds.Valid() ? compact.Bounds.Min : glm::vec3(0.0f);
+                    glm::vec3   extent     = compact.Bounds.Valid() ? compact.Bounds.Max - compact.Bounds.Min : glm::vec3(0.0f);
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        draw_data.PositionMin[axis]    = min[axis];
+                        draw_data.PositionExtent[axis] = extent[axis];
+                    }
+                    lods = compact.Lods;
+                }
+
+                SceneData->DrawLods[i] = LodSelector::BuildDrawChain(draw_data.IndexOffset, draw_data.IndexCount, lods);
+                draw_bounds[i]         = SceneData->Meshes[mesh].Bounds;
+                draw_transforms[i]     = node;
+                draw_meshes[i]         = mesh;
+                draw_materials[i]      = draw_data.MaterialIndex;
+
                 ++i;
             }
         }
         else
         {
-            // We use the default data
-            indirect_commmands.resize(SceneData->DrawData.size());
+            // We use the default data, it has no bounds and is never culled
+            draw_bounds.resize(SceneData->DrawData.size());
+            SceneData->DrawLods.clear();
+            for (const auto& draw_data : SceneData->DrawData)
+            {
+                draw_transforms.push_back(draw_data.TransformIndex);
+                draw_meshes.push_back(DrawInstancing::NoMesh);
+                draw_materials.push_back(draw_data.MaterialIndex);
+                SceneData->DrawLods.push_back(LodSelector::BuildDrawChain(draw_data.IndexOffset, draw_data.IndexCount, {}));
+            }
         }
 
+        SceneData->Culling.SetDraws(draw_bounds, draw_transforms);
+
+        /*
+         * Nodes sharing a mesh and a material are drawn as instances of one command, every frame regroups the visible ones
+         */
+        std::vector<uint32_t>     all_draws(SceneData->DrawData.size());
+        std::vector<DrawLodRange> full_ranges(SceneData->DrawData.size());
+        std::vector<DrawCommand>  draw_commands  = {};
+        std::vector<uint32_t>     instance_draws = {};
         for (uint32_t i = 0; i < SceneData->DrawData.size(); ++i)
+        {
+            all_draws[i]   = i;
+            full_ranges[i] = SceneData->DrawLods[i].Lods[0];
+        }
+        DrawInstancing::AssignGroups(draw_meshes, draw_materials, SceneData->DrawGroups);
+        DrawInstancing::Batch(all_draws, SceneData->DrawGroups, full_ranges, draw_commands, instance_draws);
+
+        indirect_commmands.resize(draw_commands.size());
+        for (size_t i = 0; i < draw_commands.size(); ++i)
         {
             indirect_commmands[i] = {
-                .vertexCount   = SceneData->DrawData[i].IndexCount,
-                .instanceCount = 1,
-                .firstVertex   = 0,
-                .firstInstance = i,
+                .vertexCount   = draw_commands[i].VertexCount,
+                .instanceCount = draw_commands[i].InstanceCount,
+                .firstVertex   = draw_commands[i].FirstVertex,
+                .firstInstance = draw_commands[i].FirstInstance,
             };
         }
 
+        /*
+         * Decoded in priority order : albedo first since it's what the scene looks wrong without, emissive and specular last
+         */
         for (int i = 0; i < SceneData->Materials.size(); ++i)
         {
             auto& mat       = SceneData->Materials[i];
@@ -209,7 +281,7 @@ namespace ZEngine::Rendering::Scenes
 
             if (!std::string_view(mat_files.AlbedoTexture).empty())
             {
-                auto handle = async_loader->LoadTextureFile(mat_files.AlbedoTexture);
+                auto handle = async_loader->LoadTextureFile(mat_files.AlbedoTexture, Helpers::TaskPriority::High);
                 if (handle)
                 {
                     mat.AlbedoMap = handle.Index;
@@ -218,7 +290,7 @@ namespace ZEngine::Rendering::Scenes
 
             if (!std::string_view(mat_files.EmissiveTexture).empty())
             {
-                auto handle = async_loader->LoadTextureFile(mat_files.EmissiveTexture);
+                auto handle = async_loader->LoadTextureFile(mat_files.EmissiveTexture, Helpers::TaskPriority::Low);
                 if (handle)
                 {
                     mat.EmissiveMap = handle.Index;
@@ -227,7 +299,7 @@ namespace ZEngine::Rendering::Scenes
 
             if (!std::string_view(mat_files.NormalTexture).empty())
             {
-                auto handle = async_loader->LoadTextureFile(mat_files.NormalTexture);
+                auto handle = async_loader->LoadTextureFile(mat_files.NormalTexture, Helpers::TaskPriority::Normal, true);
                 if (handle)
                 {
                     mat.NormalMap = handle.Index;
@@ -245,7 +317,7 @@ namespace ZEngine::Rendering::Scenes
 
             if (!std::string_view(mat_files.SpecularTexture).empty())
             {
-                auto handle = async_loader->LoadTextureFile(mat_files.SpecularTexture);
+                auto handle = async_loader->LoadTextureFile(mat_files.SpecularTexture, Helpers::TaskPriority::Low);
                 if (handle)
                 {
                     mat.SpecularMap = handle.Index;
@@ -258,6 +330,7 @@ namespace ZEngine::Rendering::Scenes
         SceneData->IndexBufferHandle            = device->CreateStorageBufferSet();
         SceneData->MaterialBufferHandle         = device->CreateStorageBufferSet();
         SceneData->IndirectDataDrawBufferHandle = device->CreateStorageBufferSet();
+        SceneData->InstanceBufferHandle         = device->CreateStorageBufferSet();
         SceneData->IndirectBufferHandle         = device->CreateIndirectBufferSet();
 
         auto& transform_buf                     = device->StorageBufferSetManager.Access(SceneData->TransformBufferHandle);
@@ -265,15 +338,26 @@ namespace ZEngine::Rendering::Scenes
         auto& ind_buf                           = device->StorageBufferSetManager.Access(SceneData->IndexBufferHandle);
         auto& material_buf                      = device->StorageBufferSetManager.Access(SceneData->MaterialBufferHandle);
         auto& indirect_datadraw_buf             = device->StorageBufferSetManager.Access(SceneData->IndirectDataDrawBufferHandle);
+        auto& instance_buf                      = device->StorageBufferSetManager.Access(SceneData->InstanceBufferHandle);
         auto& indirect_buf                      = device->IndirectBufferSetManager.Access(SceneData->IndirectBufferHandle);
 
+        SceneData->ChangedTransformRanges.clear();
         for (unsigned i = 0; i < device->SwapchainImageCount; ++i)
         {
-            transform_buf->SetData<glm::mat4>(i, SceneData->GlobalTransforms);
-            vert_buf->SetData<float>(i, SceneData->Vertices);
-            ind_buf->SetData<uint32_t>(i, SceneData->Indices);
+            transform_buf->SyncData<glm::mat4>(i, SceneData->GlobalTransforms);
+            if (use_compact_geometry)
+            {
+                vert_buf->SetData<Meshes::CompactVertex>(i, compact_geometry.Vertices);
+                ind_buf->SetData<uint32_t>(i, compact_geometry.Indices);
+            }
+            else
+            {
+                vert_buf->SetData<float>(i, SceneData->Vertices);
+                ind_buf->SetData<uint32_t>(i, SceneData->Indices);
+            }
             material_buf->SetData<Meshes::MeshMaterial>(i, SceneData->Materials);
             indirect_datadraw_buf->SetData<DrawData>(i, SceneData->DrawData);
+            instance_buf->SetData<uint32_t>(i, instance_draws);
             indirect_buf->SetData<VkDrawIndirectCommand>(i, indirect_commmands);
         }
 
@@ -393,12 +477,62 @@ namespace ZEngine::Rendering::Scenes
 
         for (auto& scene : scenes)
         {
-            MergeVector(std::span{scene.Vertices}, vertices);
-            MergeVector(std::span{scene.Indices}, indices);
+            /*
+             * Vertex and index buffers are the bulk of a scene, they are moved rather than copied (the scene gives them up)
+             */
+            uint32_t vertex_count = (uint32_t) scene.Vertices.size();
+            uint32_t index_count  = (uint32_t) scene.Indices.size();
+
+            MergeVector(std::move(scene.Vertices), vertices);
+            MergeVector(std::move(scene.Indices), indices);
             MergeVector(std::span{scene.Meshes}, meshes);
 
+            /*
+             * Level ranges live in the scene index buffer too, they move with it
+             */
+            if (!scene.MeshLods.empty())
+            {
+                SceneData->MeshLods.resize(SceneData->SMeshCountOffset);
+                for (auto lod_chain : scene.MeshLods)
+                {
+                    for (uint32_t level = 0; level < lod_chain.LodCount; ++level)
+                    {
+                        lod_chain.Lods[level].IndexOffset += SceneData->SIndexDataSize;
+                    }
+                    SceneData->MeshLods.push_back(lod_chain);
+                }
+            }
+
             uint32_t vtxOffset = SceneData->SVertexDataSize / 8; /* 8 is the number of per-vertex attributes: position, normal + UV */
 
+            /*
+             * Meshlet vertices are read as the indices and get the same shift, triangle bytes stay 4 bytes aligned per scene
+             */
+            if (!scene.Meshlets.empty())
+            {
+                uint32_t meshlet_offset  = (uint32_t) SceneData->Meshlets.size();
+                uint32_t vertex_offset   = (uint32_t) SceneData->MeshletVertices.size();
+                uint32_t triangle_offset = (uint32_t) SceneData->MeshletTriangles.size();
+
+                SceneData->MeshletRanges.resize(SceneData->SMeshCountOffset);
+                for (auto range : scene.MeshletRanges)
+                {
+                    range.MeshletOffset += meshlet_offset;
+                    SceneData->MeshletRanges.push_back(range);
+                }
+                for (auto meshlet : scene.Meshlets)
+                {
+                    meshlet.VertexOffset   += vertex_offset;
+                    meshlet.TriangleOffset += triangle_offset;
+                    SceneData->Meshlets.push_back(meshlet);
+                }
+                for (uint32_t vertex : scene.MeshletVertices)
+                {
+                    SceneData->MeshletVertices.push_back(vertex + vtxOffset);
+                }
+                MergeVector(std::span{scene.MeshletTriangles}, SceneData->MeshletTriangles);
+            }
+
             for (size_t j = 0; j < (uint32_t) scene.Meshes.size(); j++)
             {
                 // m.vertexCount, m.lodCount and m.streamCount do not change
@@ -407,15 +541,15 @@ namespace ZEngine::Rendering::Scenes
             }
 
             // shift individual indices
-            for (size_t j = 0; j < scene.Indices.size(); j++)
+            for (size_t j = 0; j < index_count; j++)
             {
                 indices[SceneData->SIndexDataSize + j] += vtxOffset;
             }
 
             SceneData->SMeshCountOffset += (uint32_t) scene.Meshes.size();
 
-            SceneData->SIndexDataSize   += (uint32_t) scene.Indices.size();
-            SceneData->SVertexDataSize  += (uint32_t) scene.Vertices.size();
+            SceneData->SIndexDataSize   += index_count;
+            SceneData->SVertexDataSize  += vertex_count;
         }
     }
 
@@ -679,25 +813,24 @@ namespace ZEngine::Rendering::Scenes
         {
             std::lock_guard l(m_mutex);
 
-            const auto&     hierarchy         = SceneData->NodeHierarchies;
-            auto&           global_transforms = SceneData->GlobalTransforms;
-            auto&           local_transforms  = SceneData->LocalTransforms;
-            auto&           node_changed_map  = SceneData->LevelSceneNodeChangedMap;
-            for (auto& [level, nodes] : node_changed_map)
+            auto&           dirty_transforms = SceneData->DirtyTransforms;
+            if (dirty_transforms.Empty())
             {
-                for (auto node : nodes)
+                return;
+            }
+
+            SceneTransformSystem::ComputeParallel(SceneData->NodeHierarchies, SceneData->LocalTransforms, SceneData->GlobalTransforms, dirty_transforms);
+
+            auto& changed_ranges = SceneData->ChangedTransformRanges;
+            for (const auto& nodes : dirty_transforms.Levels)
+            {
+                for (uint32_t node : nodes)
                 {
-                    if (node != -1)
-                    {
-                        int parent = hierarchy[node].Parent;
-                        if (parent != -1)
-                        {
-                            global_transforms[node] = global_transforms[parent] * local_transforms[node];
-                        }
-                    }
+                    changed_ranges.push_back({.Offset = node * sizeof(glm::mat4), .ByteSize = sizeof(glm::mat4)});
                 }
             }
-            node_changed_map.clear();
+            dirty_transforms.Clear();
+            SceneData->Culling.InvalidateWorldBounds();
         }
     }
 
@@ -705,39 +838,7 @@ namespace ZEngine::Rendering::Scenes
     {
         {
             std::lock_guard l(m_mutex);
-
-            auto&           hierarchy = SceneData->NodeHierarchies;
-            if (hierarchy.empty())
-            {
-                return;
-            }
-
-            std::queue<int>  q;
-            std::vector<int> n;
-            auto&            node_changed_map = SceneData->LevelSceneNodeChangedMap;
-            q.push(node_identifier);
-            while (!q.empty())
-            {
-                int front = q.front();
-                n.push_back(front);
-                q.pop();
-                int first = hierarchy[front].FirstChild;
-                if (first > -1)
-                {
-                    q.push(first);
-                    for (int sibling = hierarchy[first].RightSibling; sibling != -1; sibling = hierarchy[sibling].RightSibling)
-                    {
-                        q.push(sibling);
-                    }
-                }
-            }
-
-            for (int i = 0; i < n.size(); ++i)
-            {
-                int node  = n[i];
-                int level = hierarchy[node].DepthLevel;
-                node_changed_map[level].emplace(node);
-            }
+            SceneData->DirtyTransforms.MarkSubtree(SceneData->NodeHierarchies, node_identifier);
         }
     }
 
@@ -2,6 +2,11 @@
 #include <Hardwares/VulkanDevice.h>
 #include <Rendering/Lights/Light.h>
 #include <Rendering/Meshes/Mesh.h>
+#include <Rendering/Meshes/VertexQuantization.h>
+#include <Rendering/Scenes/SceneCulling.h>
+#include <Rendering/Scenes/SceneInstancing.h>
+#include <Rendering/Scenes/SceneLod.h>
+#include <Rendering/Scenes/SceneTransforms.h>
 #include <Textures/Texture.h>
 #include <ZEngineDef.h>
 #include <entt/entt.hpp>
@@ -25,32 +30,21 @@ namespace ZEngine::Rendering::Renderers
 
 namespace ZEngine::Rendering::Scenes
 {
-    /*
-     * This internal defragmented storage represents SceneNode struct with a DoD (Data-Oriented Design) approach
-     * The access is index based.
-     *
-     *  (1)
-     *  /
-     * (2) --> (3) --> (4) --> (5) --> ##-1
-     *         /
-     *        (6) --> ##-1
-     */
-    struct SceneNodeHierarchy
-    {
-        int Parent       = -1;
-        int FirstChild   = -1;
-        int RightSibling = -1;
-        int DepthLevel   = -1;
-    };
-
     struct DrawData
     {
-        uint32_t TransformIndex = std::numeric_limits<uint32_t>::max();
-        uint32_t MaterialIndex  = std::numeric_limits<uint32_t>::max();
-        uint32_t VertexOffset   = std::numeric_limits<uint32_t>::max();
-        uint32_t IndexOffset    = std::numeric_limits<uint32_t>::max();
-        uint32_t VertexCount    = std::numeric_limits<uint32_t>::max();
-        uint32_t IndexCount     = std::numeric_limits<uint32_t>::max();
+        uint32_t             TransformIndex    = std::numeric_limits<uint32_t>::max();
+        uint32_t             MaterialIndex     = std::numeric_limits<uint32_t>::max();
+        uint32_t             VertexOffset      = std::numeric_limits<uint32_t>::max();
+        uint32_t             IndexOffset       = std::numeric_limits<uint32_t>::max();
+        uint32_t             VertexCount       = std::numeric_limits<uint32_t>::max();
+        uint32_t             IndexCount        = std::numeric_limits<uint32_t>::max();
+        Meshes::VertexFormat VertexFormat      = Meshes::VertexFormat::FLOAT32;
+        Meshes::IndexFormat  IndexFormat       = Meshes::IndexFormat::UINT32;
+        /*
+         * Dequantization box of COMPACT vertices : position = PositionMin + unorm * PositionExtent
+         */
+        float                PositionMin[3]    = {0.0f, 0.0f, 0.0f};
+        float                PositionExtent[3] = {0.0f, 0.0f, 0.0f};
     };
 
     struct SceneRawData : public Helpers::RefCounted
@@ -61,13 +55,25 @@ namespace ZEngine::Rendering::Scenes
         std::vector<SceneNodeHierarchy>            NodeHierarchies              = {};
         std::vector<glm::mat4>                     LocalTransforms              = {};
         std::vector<glm::mat4>                     GlobalTransforms             = {};
-        std::map<uint32_t, std::set<uint32_t>>     LevelSceneNodeChangedMap     = {};
+        SceneTransformDirtyList                    DirtyTransforms              = {};
+        /*
+         * GlobalTransforms byte ranges written since the transform buffer last consumed them
+         */
+        std::vector<Helpers::BufferRange>          ChangedTransformRanges       = {};
         /*
          * New Properties
          */
         std::vector<float>                         Vertices                     = {};
         std::vector<uint32_t>                      Indices                      = {};
         std::vector<DrawData>                      DrawData                     = {};
+        /*
+         * Index ranges the renderer picks from for every DrawData entry, see LodSelector
+         */
+        std::vector<DrawLodChain>                  DrawLods                     = {};
+        /*
+         * Instancing group of every DrawData entry : same mesh and material, see DrawInstancing
+         */
+        std::vector<uint32_t>                      DrawGroups                   = {};
         std::vector<std::string>                   Names                        = {};
         std::vector<std::string>                   MaterialNames                = {};
         std::unordered_map<uint32_t, uint32_t>     NodeMeshes                   = {};
@@ -75,8 +81,23 @@ namespace ZEngine::Rendering::Scenes
         std::unordered_map<uint32_t, uint32_t>     NodeMaterials                = {};
         std::unordered_map<uint32_t, entt::entity> NodeEntities                 = {};
         std::vector<Meshes::MeshVNext>             Meshes                       = {};
+        /*
+         * Simplified levels of Meshes, can be shorter than Meshes : missing chains have no levels
+         */
+        std::vector<Meshes::MeshLodChain>          MeshLods                     = {};
+        /*
+         * Meshlets of Meshes, see Meshes::Meshlet. MeshletRanges can be shorter than Meshes : missing ranges have no meshlet
+         */
+        std::vector<Meshes::MeshletRange>          MeshletRanges                = {};
+        std::vector<Meshes::Meshlet>               Meshlets                     = {};
+        std::vector<uint32_t>                      MeshletVertices              = {};
+        std::vector<uint8_t>                       MeshletTriangles             = {};
         std::vector<Meshes::MeshMaterial>          Materials                    = {};
         std::vector<Meshes::MaterialFile>          MaterialFiles                = {};
+        /*
+         * Visibility of the DrawData entries, from the mesh bounds and GlobalTransforms
+         */
+        SceneCuller                                Culling                      = {};
 
         /*
          * Scene Entity Related data
@@ -93,6 +114,10 @@ namespace ZEngine::Rendering::Scenes
         Hardwares::StorageBufferSetHandle          IndexBufferHandle            = {};
         Hardwares::StorageBufferSetHandle          MaterialBufferHandle         = {};
         Hardwares::StorageBufferSetHandle          IndirectDataDrawBufferHandle = {};
+        /*
+         * DrawData index of every instance drawn this frame, indexed by gl_InstanceIndex
+         */
+        Hardwares::StorageBufferSetHandle          InstanceBufferHandle         = {};
         Hardwares::IndirectBufferSetHandle         IndirectBufferHandle         = {};
 
         int                                        AddNode(int parent, int depth);
@@ -172,8 +197,13 @@ namespace ZEngine::Rendering::Scenes
     {
         GraphicScene();
 
-        bool                           IsDrawDataDirty = false;
-        Helpers::Ref<SceneRawData>     SceneData       = nullptr;
+        bool                           IsDrawDataDirty    = false;
+        /*
+         * Opt-in : geometry is uploaded in the quantized format of VertexQuantization.h, about half the memory and fetch bandwidth.
+         * SceneData keeps the float vertices either way.
+         */
+        bool                           UseCompactGeometry = false;
+        Helpers::Ref<SceneRawData>     SceneData          = nullptr;
 
         void                           InitOrResetDrawBuffer(Hardwares::VulkanDevice* device, Renderers::RenderGraph* render_graph, Renderers::AsyncResourceLoader* async_loader);
 
@@ -231,6 +261,23 @@ namespace ZEngine::Rendering::Scenes
             dst.insert(std::end(dst), std::cbegin(src), std::cend(src));
         }
 
+        /*
+         * Steals the storage of src when dst is empty, src is left empty in every case
+         */
+        template <typename T>
+        static void MergeVector(std::vector<T>&& src, std::vector<T>& dst)
+        {
+            if (dst.empty())
+            {
+                dst = std::move(src);
+            }
+            else
+            {
+                dst.insert(std::end(dst), std::make_move_iterator(std::begin(src)), std::make_move_iterator(std::end(src)));
+            }
+            src.clear();
+        }
+
     private:
         std::recursive_mutex m_mutex = {};
         friend class ZEngine::Serializers::GraphicScene3DSerializer;
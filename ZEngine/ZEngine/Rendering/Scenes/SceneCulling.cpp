@@ -0,0 +1,369 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Meshes/MeshletBuilder.h>
+#include <Rendering/Scenes/SceneCulling.h>
+
+using namespace ZEngine::Helpers;
+using namespace ZEngine::Rendering::Meshes;
+
+namespace ZEngine::Rendering::Scenes
+{
+    Frustum Frustum::FromViewProjection(const glm::mat4& view_projection)
+    {
+        auto row = [&](int index) {
+            return glm::vec4(view_projection[0][index], view_projection[1][index], view_projection[2][index], view_projection[3][index]);
+        };
+
+        Frustum frustum   = {};
+        frustum.Planes[0] = row(3) + row(0); // Left
+        frustum.Planes[1] = row(3) - row(0); // Right
+        frustum.Planes[2] = row(3) + row(1); // Bottom
+        frustum.Planes[3] = row(3) - row(1); // Top
+        frustum.Planes[4] = row(2);          // Near
+        frustum.Planes[5] = row(3) - row(2); // Far
+
+        for (auto& plane : frustum.Planes)
+        {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+            {
+                plane /= length;
+            }
+        }
+        return frustum;
+    }
+
+    FrustumTestResult Frustum::Classify(const BoundingBox& box) const
+    {
+        glm::vec3         center  = box.Center();
+        glm::vec3         extents = box.Extents();
+        FrustumTestResult result  = FrustumTestResult::INSIDE;
+
+        for (const auto& plane : Planes)
+        {
+            glm::vec3 normal   = glm::vec3(plane);
+            float     distance = glm::dot(normal, center) + plane.w;
+            float     radius   = glm::dot(extents, glm::abs(normal));
+
+            if (distance + radius < 0.0f)
+            {
+                return FrustumTestResult::OUTSIDE;
+            }
+
+            if (distance - radius < 0.0f)
+            {
+                result = FrustumTestResult::INTERSECT;
+            }
+        }
+        return result;
+    }
+
+    bool Frustum::Intersects(const BoundingBox& box) const
+    {
+        return Classify(box) != FrustumTestResult::OUTSIDE;
+    }
+
+    bool Frustum::Intersects(const glm::vec3& center, float radius) const
+    {
+        for (const auto& plane : Planes)
+        {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void SceneBvh::Build(std::span<const BoundingBox> bounds, uint32_t leaf_size)
+    {
+        Clear();
+
+        for (uint32_t i = 0; i < bounds.size(); ++i)
+        {
+            if (bounds[i].Valid())
+            {
+                Items.push_back(i);
+            }
+            else
+            {
+                UnboundedItems.push_back(i);
+            }
+        }
+
+        if (!Items.empty())
+        {
+            Nodes.reserve(2 * ((Items.size() + leaf_size - 1) / std::max(leaf_size, 1u)));
+            BuildNode(bounds, 0, static_cast<uint32_t>(Items.size()), std::max(leaf_size, 1u), 0);
+        }
+    }
+
+    uint32_t SceneBvh::BuildNode(std::span<const BoundingBox> bounds, uint32_t item_offset, uint32_t item_count, uint32_t leaf_size, uint32_t depth)
+    {
+        uint32_t    node_index      = static_cast<uint32_t>(Nodes.size());
+        BoundingBox node_bounds     = {};
+        BoundingBox centroid_bounds = {};
+        for (uint32_t i = item_offset; i < item_offset + item_count; ++i)
+        {
+            node_bounds.Expand(bounds[Items[i]]);
+            centroid_bounds.Expand(bounds[Items[i]].Center());
+        }
+        Nodes.push_back(SceneBvhNode{.Bounds = node_bounds, .ItemOffset = item_offset, .ItemCount = item_count});
+
+        /*
+         * Median splits keep the tree balanced, the depth can't come close to MaxDepth but the traversal stack relies on it
+         */
+        if ((item_count <= leaf_size) || (depth + 1 >= MaxDepth))
+        {
+            return node_index;
+        }
+
+        glm::vec3 spread = centroid_bounds.Max - centroid_bounds.Min;
+        int       axis   = (spread.x > spread.y) ? ((spread.x > spread.z) ? 0 : 2) : ((spread.y > spread.z) ? 1 : 2);
+
+        uint32_t  middle = item_offset + item_count / 2;
+        auto      first  = Items.begin() + item_offset;
+        std::nth_element(first, Items.begin() + middle, first + item_count, [&](uint32_t a, uint32_t b) { return bounds[a].Center()[axis] < bounds[b].Center()[axis]; });
+
+        BuildNode(bounds, item_offset, middle - item_offset, leaf_size, depth + 1);
+        uint32_t right_child         = BuildNode(bounds, middle, item_offset + item_count - middle, leaf_size, depth + 1);
+        Nodes[node_index].RightChild = right_child;
+        return node_index;
+    }
+
+    void SceneBvh::Refit(std::span<const BoundingBox> bounds)
+    {
+        /*
+         * Children are always stored after their parent, walking backward visits them first
+         */
+        for (size_t i = Nodes.size(); i > 0; --i)
+        {
+            auto&       node        = Nodes[i - 1];
+            BoundingBox node_bounds = {};
+            if (node.IsLeaf())
+            {
+                for (uint32_t item = node.ItemOffset; item < node.ItemOffset + node.ItemCount; ++item)
+                {
+                    node_bounds.Expand(bounds[Items[item]]);
+                }
+            }
+            else
+            {
+                node_bounds.Expand(Nodes[i].Bounds);
+                node_bounds.Expand(Nodes[node.RightChild].Bounds);
+            }
+            node.Bounds = node_bounds;
+        }
+    }
+
+    void SceneBvh::Query(const Frustum& frustum, std::span<const BoundingBox> bounds, std::vector<uint32_t>& visible_items, uint32_t root_node) const
+    {
+        if (root_node >= Nodes.size())
+        {
+            return;
+        }
+
+        std::array<uint32_t, MaxDepth + 1> stack;
+        uint32_t                           stack_size = 0;
+        stack[stack_size++]                           = root_node;
+
+        while (stack_size > 0)
+        {
+            const auto&       node   = Nodes[stack[--stack_size]];
+            FrustumTestResult result = frustum.Classify(node.Bounds);
+
+            if (result == FrustumTestResult::OUTSIDE)
+            {
+                continue;
+            }
+
+            if ((result == FrustumTestResult::INSIDE) || node.IsLeaf())
+            {
+                /*
+                 * A single item leaf has the item box as bounds, it was just tested
+                 */
+                auto first = Items.begin() + node.ItemOffset;
+                if ((result == FrustumTestResult::INSIDE) || (node.ItemCount == 1))
+                {
+                    visible_items.insert(visible_items.end(), first, first + node.ItemCount);
+                }
+                else
+                {
+                    std::copy_if(first, first + node.ItemCount, std::back_inserter(visible_items), [&](uint32_t item) { return frustum.Intersects(bounds[item]); });
+                }
+                continue;
+            }
+
+            uint32_t node_index = static_cast<uint32_t>(&node - Nodes.data());
+            stack[stack_size++] = node.RightChild;
+            stack[stack_size++] = node_index + 1;
+        }
+    }
+
+    bool SceneBvh::Empty() const
+    {
+        return Nodes.empty() && UnboundedItems.empty();
+    }
+
+    void SceneBvh::Clear()
+    {
+        Nodes.clear();
+        Items.clear();
+        UnboundedItems.clear();
+    }
+
+    void SceneCuller::SetDraws(std::span<const BoundingBox> local_bounds, std::span<const uint32_t> transform_indices)
+    {
+        ZENGINE_VALIDATE_ASSERT(local_bounds.size() == transform_indices.size(), "Every draw needs bounds and a transform")
+
+        m_local_bounds.assign(local_bounds.begin(), local_bounds.end());
+        m_transform_indices.assign(transform_indices.begin(), transform_indices.end());
+        m_world_bounds.resize(m_local_bounds.size());
+        m_visible_draws.clear();
+        m_rebuild_bvh        = true;
+        m_world_bounds_dirty = true;
+    }
+
+    void SceneCuller::InvalidateWorldBounds()
+    {
+        m_world_bounds_dirty = true;
+    }
+
+    void SceneCuller::UpdateWorldBounds(std::span<const glm::mat4> global_transforms)
+    {
+        ThreadPoolHelper::ParallelFor(m_local_bounds.size(), ParallelBatchSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                uint32_t transform_index = m_transform_indices[i];
+                m_world_bounds[i]        = (transform_index < global_transforms.size()) ? m_local_bounds[i].Transform(global_transforms[transform_index]) : BoundingBox{};
+            }
+        });
+
+        /*
+         * Refitting keeps the topology, which is only worth rebuilding when the set of draws changed.
+         * A different transform count may turn draws unbounded (or back), they then have to move in or out of the tree
+         */
+        if (m_rebuild_bvh || (m_transform_count != global_transforms.size()))
+        {
+            m_bvh.Build(m_world_bounds);
+            m_rebuild_bvh     = false;
+            m_transform_count = global_transforms.size();
+        }
+        else
+        {
+            m_bvh.Refit(m_world_bounds);
+        }
+        m_world_bounds_dirty = false;
+    }
+
+    std::span<const uint32_t> SceneCuller::Cull(const Frustum& frustum, std::span<const glm::mat4> global_transforms)
+    {
+        if (m_world_bounds_dirty)
+        {
+            UpdateWorldBounds(global_transforms);
+        }
+
+        m_visible_draws.assign(m_bvh.UnboundedItems.begin(), m_bvh.UnboundedItems.end());
+        if (m_bvh.Nodes.empty())
+        {
+            return m_visible_draws;
+        }
+
+        if (m_bvh.Items.size() < ParallelThreshold)
+        {
+            m_bvh.Query(frustum, m_world_bounds, m_visible_draws);
+            return m_visible_draws;
+        }
+
+        /*
+         * Splitting the top levels, breadth-first, gives independent subtrees of similar size
+         */
+        m_subtrees.assign(1, 0);
+        for (bool split = true; split && (m_subtrees.size() < ParallelSubtreeCount);)
+        {
+            split = false;
+            m_next_subtrees.clear();
+            for (uint32_t node : m_subtrees)
+            {
+                if (m_bvh.Nodes[node].IsLeaf())
+                {
+                    m_next_subtrees.push_back(node);
+                    continue;
+                }
+                m_next_subtrees.push_back(node + 1);
+                m_next_subtrees.push_back(m_bvh.Nodes[node].RightChild);
+                split = true;
+            }
+            std::swap(m_subtrees, m_next_subtrees);
+        }
+
+        if (m_subtree_visible_draws.size() < m_subtrees.size())
+        {
+            m_subtree_visible_draws.resize(m_subtrees.size());
+        }
+
+        ThreadPoolHelper::ParallelFor(m_subtrees.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_subtree_visible_draws[i].clear();
+                m_bvh.Query(frustum, m_world_bounds, m_subtree_visible_draws[i], m_subtrees[i]);
+            }
+        });
+
+        for (size_t i = 0; i < m_subtrees.size(); ++i)
+        {
+            m_visible_draws.insert(m_visible_draws.end(), m_subtree_visible_draws[i].begin(), m_subtree_visible_draws[i].end());
+        }
+        return m_visible_draws;
+    }
+
+    std::span<const uint32_t> SceneCuller::VisibleDraws() const
+    {
+        return m_visible_draws;
+    }
+
+    std::span<const BoundingBox> SceneCuller::WorldBounds() const
+    {
+        return m_world_bounds;
+    }
+
+    const SceneBvh& SceneCuller::Bvh() const
+    {
+        return m_bvh;
+    }
+
+    size_t SceneCuller::DrawCount() const
+    {
+        return m_local_bounds.size();
+    }
+
+    void SceneCuller::CullBruteForce(const Frustum& frustum, std::span<const BoundingBox> world_bounds, std::vector<uint32_t>& visible_draws)
+    {
+        visible_draws.clear();
+        for (uint32_t i = 0; i < world_bounds.size(); ++i)
+        {
+            if (!world_bounds[i].Valid() || frustum.Intersects(world_bounds[i]))
+            {
+                visible_draws.push_back(i);
+            }
+        }
+    }
+
+    void SceneCuller::CullMeshlets(const Frustum& frustum, const glm::vec3& camera_position, std::span<const Meshlet> meshlets, std::vector<uint32_t>& visible_meshlets)
+    {
+        visible_meshlets.clear();
+        for (uint32_t i = 0; i < meshlets.size(); ++i)
+        {
+            const auto& meshlet = meshlets[i];
+            if (MeshletBuilder::IsBackfacing(meshlet, camera_position))
+            {
+                continue;
+            }
+
+            if (frustum.Intersects(glm::vec3(meshlet.Center[0], meshlet.Center[1], meshlet.Center[2]), meshlet.Radius))
+            {
+                visible_meshlets.push_back(i);
+            }
+        }
+    }
+} // namespace ZEngine::Rendering::Scenes
@@ -0,0 +1,135 @@
+#pragma once
+#include <Rendering/Meshes/Mesh.h>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Rendering::Scenes
+{
+    enum class FrustumTestResult : uint8_t
+    {
+        OUTSIDE = 0,
+        INTERSECT,
+        INSIDE
+    };
+
+    /*
+     * Six inward-facing planes (xyz : normal, w : distance) extracted from a view-projection matrix (Gribb & Hartmann).
+     * The matrix is expected to map depth to [0, 1] as our cameras do (GLM_FORCE_DEPTH_ZERO_TO_ONE).
+     */
+    struct Frustum
+    {
+        std::array<glm::vec4, 6> Planes = {};
+
+        static Frustum           FromViewProjection(const glm::mat4& view_projection);
+        FrustumTestResult        Classify(const Meshes::BoundingBox& box) const;
+        bool                     Intersects(const Meshes::BoundingBox& box) const;
+        bool                     Intersects(const glm::vec3& center, float radius) const;
+    };
+
+    struct SceneBvhNode
+    {
+        Meshes::BoundingBox Bounds     = {};
+        /*
+         * Range of SceneBvh::Items covered by the whole subtree
+         */
+        uint32_t            ItemOffset = 0;
+        uint32_t            ItemCount  = 0;
+        /*
+         * The left child always directly follows its parent, a leaf has no right child
+         */
+        uint32_t            RightChild = 0;
+
+        bool                IsLeaf() const
+        {
+            return RightChild == 0;
+        }
+    };
+
+    /*
+     * Bounding volume hierarchy over a set of boxes, built by median split along the longest axis of the centroids.
+     * Nodes are stored depth-first and every subtree covers a contiguous range of Items : a node found entirely inside the frustum
+     * accepts its items with a single copy, without visiting its children.
+     * Items with an empty box can't be tested and are kept aside in UnboundedItems, they are never culled.
+     */
+    struct SceneBvh
+    {
+        static constexpr uint32_t DefaultLeafSize = 4;
+        static constexpr uint32_t MaxDepth        = 64;
+
+        std::vector<SceneBvhNode> Nodes           = {};
+        std::vector<uint32_t>     Items           = {};
+        std::vector<uint32_t>     UnboundedItems  = {};
+
+        void                      Build(std::span<const Meshes::BoundingBox> bounds, uint32_t leaf_size = DefaultLeafSize);
+        /*
+         * Recomputes the node bounds after the items moved, the topology is kept
+         */
+        void                      Refit(std::span<const Meshes::BoundingBox> bounds);
+        /*
+         * Appends the items of the subtree rooted at root_node whose box (bounds, as given to Build) intersects the frustum.
+         * UnboundedItems aren't included
+         */
+        void                      Query(const Frustum& frustum, std::span<const Meshes::BoundingBox> bounds, std::vector<uint32_t>& visible_items, uint32_t root_node = 0) const;
+        bool                      Empty() const;
+        void                      Clear();
+
+    private:
+        uint32_t                  BuildNode(std::span<const Meshes::BoundingBox> bounds, uint32_t item_offset, uint32_t item_count, uint32_t leaf_size, uint32_t depth);
+    };
+
+    /*
+     * Per-scene visibility state.
+     * Draw i is bounded by the mesh box LocalBounds[i] placed in the world by GlobalTransforms[TransformIndices[i]].
+     * World bounds and the BVH are only updated when transforms were invalidated, an idle scene costs a traversal per frame.
+     */
+    struct SceneCuller
+    {
+        /*
+         * The BVH top levels are split into about that many subtrees, traversed in parallel across the ThreadPool
+         */
+        static constexpr size_t              ParallelSubtreeCount = 64;
+        /*
+         * Below that many bounded draws a single thread traverses the whole tree
+         */
+        static constexpr size_t              ParallelThreshold    = 4096;
+        static constexpr size_t              ParallelBatchSize    = 2048;
+
+        void                                 SetDraws(std::span<const Meshes::BoundingBox> local_bounds, std::span<const uint32_t> transform_indices);
+        void                                 InvalidateWorldBounds();
+        /*
+         * Compacted indices of the visible draws, unbounded draws first. The span stays valid until the next call
+         */
+        std::span<const uint32_t>            Cull(const Frustum& frustum, std::span<const glm::mat4> global_transforms);
+        std::span<const uint32_t>            VisibleDraws() const;
+        std::span<const Meshes::BoundingBox> WorldBounds() const;
+        const SceneBvh&                      Bvh() const;
+        size_t                               DrawCount() const;
+
+        /*
+         * Reference implementation, tests every box
+         */
+        static void                          CullBruteForce(const Frustum& frustum, std::span<const Meshes::BoundingBox> world_bounds, std::vector<uint32_t>& visible_draws);
+        /*
+         * Meshlets of a draw kept by their bounding sphere and normal cone. The frustum (from view_projection * transform) and the
+         * camera position are in the mesh local space : both tests hold under any affine transform.
+         */
+        static void                          CullMeshlets(const Frustum& frustum, const glm::vec3& camera_position, std::span<const Meshes::Meshlet> meshlets, std::vector<uint32_t>& visible_meshlets);
+
+    private:
+        bool                                 m_rebuild_bvh           = true;
+        bool                                 m_world_bounds_dirty    = true;
+        size_t                               m_transform_count       = 0;
+        std::vector<Meshes::BoundingBox>     m_local_bounds          = {};
+        std::vector<uint32_t>                m_transform_indices     = {};
+        std::vector<Meshes::BoundingBox>     m_world_bounds          = {};
+        SceneBvh                             m_bvh                   = {};
+        std::vector<uint32_t>                m_subtrees              = {};
+        std::vector<uint32_t>                m_next_subtrees         = {};
+        std::vector<std::vector<uint32_t>>   m_subtree_visible_draws = {};
+        std::vector<uint32_t>                m_visible_draws         = {};
+
+        void                                 UpdateWorldBounds(std::span<const glm::mat4> global_transforms);
+    };
+} // namespace ZEngine::Rendering::Scenes
@@ -0,0 +1,58 @@
+#include <pch.h>
+#include <Rendering/Scenes/SceneInstancing.h>
+#include <algorithm>
+#include <unordered_map>
+
+namespace ZEngine::Rendering::Scenes
+{
+    uint32_t DrawInstancing::AssignGroups(std::span<const uint32_t> draw_meshes, std::span<const uint32_t> draw_materials, std::vector<uint32_t>& draw_groups)
+    {
+        std::unordered_map<uint64_t, uint32_t> groups      = {};
+        uint32_t                               group_count = 0;
+
+        draw_groups.resize(draw_meshes.size());
+        for (size_t draw = 0; draw < draw_meshes.size(); ++draw)
+        {
+            if (draw_meshes[draw] == NoMesh)
+            {
+                draw_groups[draw] = group_count++;
+                continue;
+            }
+
+            uint64_t key          = (uint64_t(draw_meshes[draw]) << 32) | draw_materials[draw];
+            auto [group, created] = groups.try_emplace(key, group_count);
+            draw_groups[draw]     = group->second;
+            group_count          += created ? 1 : 0;
+        }
+        return group_count;
+    }
+
+    void DrawInstancing::Batch(std::span<const uint32_t> draws, std::span<const uint32_t> draw_groups, std::span<const DrawLodRange> draw_ranges, std::vector<DrawCommand>& commands, std::vector<uint32_t>& instance_draws)
+    {
+        struct InstanceKey
+        {
+            uint64_t Key;
+            uint32_t Position;
+        };
+
+        std::vector<InstanceKey> keys(draws.size());
+        for (uint32_t i = 0; i < draws.size(); ++i)
+        {
+            keys[i] = {.Key = (uint64_t(draw_groups[draws[i]]) << 32) | draw_ranges[i].FirstIndex, .Position = i};
+        }
+        std::sort(keys.begin(), keys.end(), [](const InstanceKey& a, const InstanceKey& b) { return (a.Key < b.Key) || ((a.Key == b.Key) && (a.Position < b.Position)); });
+
+        commands.clear();
+        instance_draws.resize(draws.size());
+        for (uint32_t i = 0; i < keys.size(); ++i)
+        {
+            const auto& range = draw_ranges[keys[i].Position];
+            if ((i == 0) || (keys[i].Key != keys[i - 1].Key))
+            {
+                commands.push_back({.VertexCount = range.IndexCount, .InstanceCount = 0, .FirstVertex = range.FirstIndex, .FirstInstance = i});
+            }
+            commands.back().InstanceCount++;
+            instance_draws[i] = draws[keys[i].Position];
+        }
+    }
+} // namespace ZEngine::Rendering::Scenes
@@ -0,0 +1,41 @@
+#pragma once
+#include <Rendering/Scenes/SceneLod.h>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Rendering::Scenes
+{
+    /*
+     * Same layout as VkDrawIndirectCommand, the batching stays free of Vulkan
+     */
+    struct DrawCommand
+    {
+        uint32_t VertexCount   = 0;
+        uint32_t InstanceCount = 0;
+        uint32_t FirstVertex   = 0;
+        uint32_t FirstInstance = 0;
+    };
+
+    /*
+     * Draws of the same mesh with the same material become the instances of a single indirect command. The per node DrawData
+     * entries are kept : an indirection buffer maps every instance to its DrawData, read by the shaders at gl_InstanceIndex
+     * (which starts at the command FirstInstance).
+     */
+    struct DrawInstancing
+    {
+        static constexpr uint32_t NoMesh = std::numeric_limits<uint32_t>::max();
+
+        /*
+         * Dense group ids, numbered in order of the first draw of every group. A draw without mesh (NoMesh) is a group of its own.
+         * Returns the group count.
+         */
+        static uint32_t AssignGroups(std::span<const uint32_t> draw_meshes, std::span<const uint32_t> draw_materials, std::vector<uint32_t>& draw_groups);
+        /*
+         * One command per group and index range among draws, draw_ranges[i] being the range selected for draws[i]. instance_draws
+         * gets the DrawData index of every instance, commands address it through FirstInstance. Instances of a command keep the
+         * order of draws.
+         */
+        static void     Batch(std::span<const uint32_t> draws, std::span<const uint32_t> draw_groups, std::span<const DrawLodRange> draw_ranges, std::vector<DrawCommand>& commands, std::vector<uint32_t>& instance_draws);
+    };
+} // namespace ZEngine::Rendering::Scenes
@@ -0,0 +1,63 @@
+#include <pch.h>
+#include <Rendering/Scenes/SceneLod.h>
+
+namespace ZEngine::Rendering::Scenes
+{
+    DrawLodChain LodSelector::BuildDrawChain(uint32_t index_offset, uint32_t index_count, const Meshes::MeshLodChain& mesh_lods)
+    {
+        DrawLodChain chain = {};
+        chain.Lods[0]      = {.FirstIndex = 0, .IndexCount = index_count, .Error = 0.0f};
+
+        for (uint32_t level = 0; level < std::min<uint32_t>(mesh_lods.LodCount, MAX_MESH_LOD_COUNT); ++level)
+        {
+            const auto& lod = mesh_lods.Lods[level];
+            if ((lod.IndexOffset < index_offset) || (lod.IndexCount == 0))
+            {
+                continue;
+            }
+            chain.Lods[chain.LodCount++] = {.FirstIndex = lod.IndexOffset - index_offset, .IndexCount = lod.IndexCount, .Error = lod.Error};
+        }
+        return chain;
+    }
+
+    float LodSelector::ProjectedError(float world_error, float distance, const LodView& view)
+    {
+        if (distance <= 0.0f)
+        {
+            return std::numeric_limits<float>::max();
+        }
+        return world_error * view.ProjectionScale / distance;
+    }
+
+    float LodSelector::MaxScale(const glm::mat4& transform)
+    {
+        float scale = 0.0f;
+        for (int column = 0; column < 3; ++column)
+        {
+            scale = std::max(scale, glm::length(glm::vec3(transform[column])));
+        }
+        return scale;
+    }
+
+    uint32_t LodSelector::SelectLod(const DrawLodChain& chain, const Meshes::BoundingBox& world_bounds, float world_scale, const LodView& view)
+    {
+        if ((chain.LodCount <= 1) || (view.ProjectionScale <= 0.0f) || !world_bounds.Valid())
+        {
+            return 0;
+        }
+
+        glm::vec3 closest  = glm::clamp(view.Position, world_bounds.Min, world_bounds.Max);
+        float     distance = glm::length(view.Position - closest);
+
+        uint32_t selected = 0;
+        for (uint32_t level = 1; level < chain.LodCount; ++level)
+        {
+            if (ProjectedError(chain.Lods[level].Error * world_scale, distance, view) > view.PixelErrorThreshold)
+            {
+                break;
+            }
+            selected = level;
+        }
+        return selected;
+    }
+} // namespace ZEngine::Rendering::Scenes
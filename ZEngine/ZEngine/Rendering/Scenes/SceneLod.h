@@ -0,0 +1,62 @@
+#pragma once
+#include <Rendering/Meshes/Mesh.h>
+#include <span>
+
+namespace ZEngine::Rendering::Scenes
+{
+    /*
+     * What the LOD selection needs from the camera
+     */
+    struct LodView
+    {
+        glm::vec3 Position            = glm::vec3(0.0f);
+        /*
+         * Pixels covered by one world unit seen at a distance of one unit : projection[1][1] * viewport_height / 2
+         */
+        float     ProjectionScale     = 0.0f;
+        /*
+         * Coarsest level whose error projects below that many pixels is drawn
+         */
+        float     PixelErrorThreshold = 1.0f;
+    };
+
+    struct DrawLodRange
+    {
+        /*
+         * Relative to DrawData::IndexOffset, goes in VkDrawIndirectCommand::firstVertex (the shaders add it to the draw IndexOffset)
+         */
+        uint32_t FirstIndex = 0;
+        uint32_t IndexCount = 0;
+        float    Error      = 0.0f;
+    };
+
+    /*
+     * Index ranges of a draw, level 0 is the full mesh
+     */
+    struct DrawLodChain
+    {
+        uint32_t     LodCount                     = 1;
+        DrawLodRange Lods[MAX_MESH_LOD_COUNT + 1] = {};
+    };
+
+    struct LodSelector
+    {
+        /*
+         * Makes the chain of a draw whose full mesh is [index_offset, index_offset + index_count), levels before index_offset are skipped
+         */
+        static DrawLodChain BuildDrawChain(uint32_t index_offset, uint32_t index_count, const Meshes::MeshLodChain& mesh_lods);
+        /*
+         * Size on screen, in pixels, of a world space error seen at distance
+         */
+        static float        ProjectedError(float world_error, float distance, const LodView& view);
+        /*
+         * Largest axis scale of the transform, mesh errors are scaled by it
+         */
+        static float        MaxScale(const glm::mat4& transform);
+        /*
+         * Coarsest level of the chain whose error stays under the view threshold, from the distance of the camera to the draw world
+         * bounds. A camera inside the bounds, an unknown projection or an empty box selects level 0.
+         */
+        static uint32_t     SelectLod(const DrawLodChain& chain, const Meshes::BoundingBox& world_bounds, float world_scale, const LodView& view);
+    };
+} // namespace ZEngine::Rendering::Scenes
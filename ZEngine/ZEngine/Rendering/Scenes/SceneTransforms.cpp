@@ -0,0 +1,120 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Scenes/SceneTransforms.h>
+
+using namespace ZEngine::Helpers;
+
+namespace ZEngine::Rendering::Scenes
+{
+    void SceneTransformDirtyList::MarkSubtree(std::span<const SceneNodeHierarchy> hierarchy, int node)
+    {
+        if ((node < 0) || (node >= (int) hierarchy.size()))
+        {
+            return;
+        }
+
+        if (m_marked_epochs.size() < hierarchy.size())
+        {
+            m_marked_epochs.resize(hierarchy.size(), 0);
+        }
+
+        m_pending_nodes.clear();
+        m_pending_nodes.push_back(node);
+        while (!m_pending_nodes.empty())
+        {
+            int current = m_pending_nodes.back();
+            m_pending_nodes.pop_back();
+
+            /*
+             * A node is only ever marked along with its whole subtree, so meeting an already marked node means the rest is done
+             */
+            if (m_marked_epochs[current] == m_epoch)
+            {
+                continue;
+            }
+            m_marked_epochs[current] = m_epoch;
+
+            int level                = hierarchy[current].DepthLevel;
+            if (level > -1)
+            {
+                if (Levels.size() <= (size_t) level)
+                {
+                    Levels.resize(level + 1);
+                }
+                Levels[level].push_back(current);
+                m_count++;
+            }
+
+            for (int child = hierarchy[current].FirstChild; child != -1; child = hierarchy[child].RightSibling)
+            {
+                m_pending_nodes.push_back(child);
+            }
+        }
+    }
+
+    bool SceneTransformDirtyList::IsMarked(uint32_t node) const
+    {
+        return (node < m_marked_epochs.size()) && (m_marked_epochs[node] == m_epoch);
+    }
+
+    size_t SceneTransformDirtyList::Count() const
+    {
+        return m_count;
+    }
+
+    bool SceneTransformDirtyList::Empty() const
+    {
+        return m_count == 0;
+    }
+
+    void SceneTransformDirtyList::Clear()
+    {
+        for (auto& level : Levels)
+        {
+            level.clear();
+        }
+        m_count = 0;
+
+        if (++m_epoch == 0)
+        {
+            std::fill(m_marked_epochs.begin(), m_marked_epochs.end(), 0);
+            m_epoch = 1;
+        }
+    }
+
+    void SceneTransformSystem::ComputeSerial(std::span<const SceneNodeHierarchy> hierarchy, std::span<const glm::mat4> local_transforms, std::span<glm::mat4> global_transforms, const SceneTransformDirtyList& dirty_list)
+    {
+        for (const auto& nodes : dirty_list.Levels)
+        {
+            for (uint32_t node : nodes)
+            {
+                int parent = hierarchy[node].Parent;
+                if (parent != -1)
+                {
+                    global_transforms[node] = global_transforms[parent] * local_transforms[node];
+                }
+            }
+        }
+    }
+
+    void SceneTransformSystem::ComputeParallel(std::span<const SceneNodeHierarchy> hierarchy, std::span<const glm::mat4> local_transforms, std::span<glm::mat4> global_transforms, const SceneTransformDirtyList& dirty_list, size_t batch_size)
+    {
+        /*
+         * Levels are processed one after the other since a level reads the global transforms its parent level just wrote
+         */
+        for (const auto& nodes : dirty_list.Levels)
+        {
+            ThreadPoolHelper::ParallelFor(nodes.size(), batch_size, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    uint32_t node   = nodes[i];
+                    int      parent = hierarchy[node].Parent;
+                    if (parent != -1)
+                    {
+                        global_transforms[node] = global_transforms[parent] * local_transforms[node];
+                    }
+                }
+            });
+        }
+    }
+} // namespace ZEngine::Rendering::Scenes
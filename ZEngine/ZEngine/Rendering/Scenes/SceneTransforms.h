@@ -0,0 +1,65 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ZEngine::Rendering::Scenes
+{
+    /*
+     * This internal defragmented storage represents SceneNode struct with a DoD (Data-Oriented Design) approach
+     * The access is index based.
+     *
+     *  (1)
+     *  /
+     * (2) --> (3) --> (4) --> (5) --> ##-1
+     *         /
+     *        (6) --> ##-1
+     */
+    struct SceneNodeHierarchy
+    {
+        int Parent       = -1;
+        int FirstChild   = -1;
+        int RightSibling = -1;
+        int DepthLevel   = -1;
+    };
+
+    /*
+     * Nodes whose global transform must be recomputed, bucketed by depth level.
+     * Buckets are flat arrays whose capacity is kept across frames, and a per-node epoch stamp turns repeated marks of the
+     * same node (or of an already marked subtree) into a single comparison : no allocation happens once the scene has warmed up.
+     */
+    struct SceneTransformDirtyList
+    {
+        std::vector<std::vector<uint32_t>> Levels = {};
+
+        /*
+         * Marks the node and all its descendants
+         */
+        void                               MarkSubtree(std::span<const SceneNodeHierarchy> hierarchy, int node);
+        bool                               IsMarked(uint32_t node) const;
+        size_t                             Count() const;
+        bool                               Empty() const;
+        /*
+         * Empties the buckets without releasing their memory
+         */
+        void                               Clear();
+
+    private:
+        uint32_t              m_epoch         = 1;
+        size_t                m_count         = 0;
+        std::vector<uint32_t> m_marked_epochs = {};
+        std::vector<int>      m_pending_nodes = {};
+    };
+
+    struct SceneTransformSystem
+    {
+        /*
+         * Nodes of a level are independent from each other, a level is split in batches of that many nodes across the ThreadPool
+         */
+        static constexpr size_t ParallelBatchSize = 2048;
+
+        static void             ComputeSerial(std::span<const SceneNodeHierarchy> hierarchy, std::span<const glm::mat4> local_transforms, std::span<glm::mat4> global_transforms, const SceneTransformDirtyList& dirty_list);
+        static void             ComputeParallel(std::span<const SceneNodeHierarchy> hierarchy, std::span<const glm::mat4> local_transforms, std::span<glm::mat4> global_transforms, const SceneTransformDirtyList& dirty_list, size_t batch_size = ParallelBatchSize);
+    };
+} // namespace ZEngine::Rendering::Scenes
@@ -170,9 +170,9 @@ namespace ZEngine::Rendering::Shaders
                 if (!type.array.empty())
                 {
                     count = type.array[0];
-                    if (count == 0) // Unsized arrays
+                    if (count == 0) // Unsized arrays : the bindless texture table
                     {
-                        count = m_device->PhysicalDeviceProperties.limits.maxDescriptorSetSampledImages - 1;
+                        count = m_device->BindlessTextureCount;
                     }
                 }
 
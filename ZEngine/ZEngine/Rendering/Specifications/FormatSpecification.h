@@ -19,6 +19,18 @@ namespace ZEngine::Rendering::Specifications
         DEPTH16_UNORM_S8_UINT,
         DEPTH24_UNORM_S8_UINT,
         DEPTH32_SFLOAT_S8_UINT,
+        /*
+         * Block compressed, sampled only : they can't be rendered to nor blitted
+         */
+        BC1_RGBA_UNORM,
+        BC1_RGBA_SRGB,
+        BC3_UNORM,
+        BC3_SRGB,
+        BC4_UNORM,
+        BC5_UNORM,
+        BC6H_UFLOAT,
+        BC7_UNORM,
+        BC7_SRGB,
         /*Special value to allow fetch from VulkanDevice*/
         FORMAT_FROM_DEVICE,
         DEPTH_STENCIL_FROM_DEVICE
@@ -29,7 +41,26 @@ namespace ZEngine::Rendering::Specifications
      */
     static uint32_t BytePerChannelMap[] = {0u, 4u, 4u, (4u * (sizeof(float) / 2)), (4u * sizeof(float))};
 
-    static VkFormat ImageFormatMap[]    = {VK_FORMAT_UNDEFINED, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB, VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_D16_UNORM, VK_FORMAT_D16_UNORM_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT};
+    static VkFormat ImageFormatMap[]    = {VK_FORMAT_UNDEFINED, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB, VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_D16_UNORM, VK_FORMAT_D16_UNORM_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_BC1_RGBA_UNORM_BLOCK, VK_FORMAT_BC1_RGBA_SRGB_BLOCK, VK_FORMAT_BC3_UNORM_BLOCK, VK_FORMAT_BC3_SRGB_BLOCK, VK_FORMAT_BC4_UNORM_BLOCK, VK_FORMAT_BC5_UNORM_BLOCK, VK_FORMAT_BC6H_UFLOAT_BLOCK, VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK};
+
+    inline bool IsBlockCompressedFormat(ImageFormat format)
+    {
+        return (format >= ImageFormat::BC1_RGBA_UNORM) && (format <= ImageFormat::BC7_SRGB);
+    }
+
+    /*
+     * Byte size of one level of one layer. Block compressed formats store 4x4 texel blocks, 8 bytes for BC1 and BC4, 16 otherwise
+     */
+    inline uint64_t ImageLevelByteSize(ImageFormat format, uint32_t width, uint32_t height, uint32_t byte_per_pixel)
+    {
+        if (!IsBlockCompressedFormat(format))
+        {
+            return uint64_t(width) * height * byte_per_pixel;
+        }
+
+        bool is_half_block = (format == ImageFormat::BC1_RGBA_UNORM) || (format == ImageFormat::BC1_RGBA_SRGB) || (format == ImageFormat::BC4_UNORM);
+        return uint64_t((width + 3) / 4) * ((height + 3) / 4) * (is_half_block ? 8u : 16u);
+    }
 
     enum class LoadOperation : uint32_t
     {
@@ -15,6 +15,7 @@ namespace ZEngine::Rendering::Specifications
         VkPipelineStageFlagBits SourceStageMask;
         VkPipelineStageFlagBits DestinationStageMask;
         uint32_t                LayerCount             = 1;
+        uint32_t                MipLevelCount          = 1;
         uint32_t                SourceQueueFamily      = VK_QUEUE_FAMILY_IGNORED;
         uint32_t                DestinationQueueFamily = VK_QUEUE_FAMILY_IGNORED;
     };
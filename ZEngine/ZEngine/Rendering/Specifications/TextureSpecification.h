@@ -15,6 +15,11 @@ namespace ZEngine::Rendering::Specifications
         uint32_t      Height            = 0;
         uint32_t      BytePerPixel      = 4;
         uint32_t      LayerCount        = 1;
+        uint32_t      MipLevels         = 1;
+        /*
+         * Levels Data holds, level after level, each with every layer. The levels after them are blitted on the GPU
+         */
+        uint32_t      DataMipLevels     = 1;
         ImageFormat   Format            = ImageFormat::UNDEFINED;
         LoadOperation LoadOp            = LoadOperation::CLEAR;
         const void*   Data              = nullptr;
@@ -38,6 +43,7 @@ namespace ZEngine::Rendering::Specifications
         VkImageUsageFlags     ImageUsage;
         VkImageAspectFlagBits ImageAspectFlag;
         uint32_t              LayerCount      = 1U;
+        uint32_t              MipLevels       = 1U;
         ImageCreateFlag       ImageCreateFlag = ImageCreateFlag::NONE;
     };
 
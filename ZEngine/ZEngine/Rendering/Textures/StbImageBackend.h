@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+namespace ZEngine::Rendering::Textures
+{
+    /*
+     * Entry points of one stb_image build. The library is compiled twice : TextureDecoder.cpp holds the scalar build, the one
+     * every other stbi_* caller links against, and StbImageSimd.cpp a private (STB_IMAGE_STATIC) build with SSE2 / NEON enabled.
+     * stb's SIMD kernels (JPEG IDCT, YCbCr conversion, chroma upsampling) are written to match the scalar ones bit for bit.
+     * Each build keeps its own per-thread flip flag, it must be set through the same table the image is loaded with.
+     */
+    struct StbImageBackend
+    {
+        uint8_t* (*Load)(const char* filename, int* width, int* height, int* channel, int desired_channel);
+        float* (*LoadFloat)(const char* filename, int* width, int* height, int* channel, int desired_channel);
+        int (*Info)(const char* filename, int* width, int* height, int* channel);
+        void (*Free)(void* data);
+        void (*SetFlipVerticallyOnThread)(int flip);
+    };
+
+    const StbImageBackend& GetScalarStbImageBackend();
+    /*
+     * nullptr when this build has no SIMD path for the target, or the running CPU lacks the instructions it was compiled for
+     */
+    const StbImageBackend* GetSimdStbImageBackend();
+} // namespace ZEngine::Rendering::Textures
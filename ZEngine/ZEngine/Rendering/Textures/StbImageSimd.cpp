@@ -0,0 +1,64 @@
+#include <pch.h>
+#include <Rendering/Textures/StbImageBackend.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+/*
+ * Private stb_image build with its SIMD kernels enabled. stb turns SSE2 on by itself for x86 targets (and off for 32-bit GCC
+ * builds lacking -msse2), NEON has to be asked for
+ */
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define STBI_NEON
+#endif
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include <stb/stb_image.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace ZEngine::Rendering::Textures
+{
+    namespace
+    {
+        bool IsSimdSupportedByCpu()
+        {
+#if defined(STBI_SSE2)
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[3] & (1 << 26)) != 0;
+#else
+            return __builtin_cpu_supports("sse2");
+#endif
+#elif defined(STBI_NEON)
+            /*
+             * Advanced SIMD is mandatory on AArch64
+             */
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        const StbImageBackend SimdBackend = {
+            .Load                      = stbi_load,
+            .LoadFloat                 = stbi_loadf,
+            .Info                      = stbi_info,
+            .Free                      = stbi_image_free,
+            .SetFlipVerticallyOnThread = stbi_set_flip_vertically_on_load_thread,
+        };
+    } // namespace
+
+    const StbImageBackend* GetSimdStbImageBackend()
+    {
+        static const bool is_supported = IsSimdSupportedByCpu();
+        return is_supported ? &SimdBackend : nullptr;
+    }
+} // namespace ZEngine::Rendering::Textures
@@ -46,12 +46,11 @@ namespace ZEngine::Helpers
     template <>
     inline void HandleManager<Helpers::Ref<Rendering::Textures::Texture>>::Dispose()
     {
-        for (size_t i = 0; i < m_count; ++i)
-        {
-            if (m_data[i].Data)
+        ForEach([](auto& data) {
+            if (data)
             {
-                m_data[i].Data->Dispose();
+                data->Dispose();
             }
-        }
+        });
     }
 } // namespace ZEngine::Helpers
\ No newline at end of file
@@ -0,0 +1,1204 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Textures/TextureCompressor.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ZEngine::Rendering::Textures
+{
+    namespace
+    {
+        constexpr int    BlockTexelCount = 16;
+        constexpr size_t BlockRowBatch   = 4;
+        /*
+         * Interpolation weights (out of 64) of the 4 bit indices, shared by BC6H and BC7
+         */
+        constexpr int    IndexWeights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        /*
+         * Principal axis fit, then that many rounds of index selection and least squares refinement of the endpoints
+         */
+        constexpr int    RefinementCount  = 3;
+
+        template <int N>
+        using Vector = std::array<float, N>;
+
+        /*
+         * Bits are stored from the least significant bit of the first byte, as every BC format expects them
+         */
+        struct BitWriter
+        {
+            uint8_t* Data     = nullptr;
+            uint32_t Position = 0;
+
+            void     Write(uint32_t value, uint32_t count)
+            {
+                for (uint32_t i = 0; i < count; ++i, ++Position)
+                {
+                    if ((value >> i) & 1u)
+                    {
+                        Data[Position >> 3] |= uint8_t(1u << (Position & 7));
+                    }
+                }
+            }
+        };
+
+        struct BitReader
+        {
+            const uint8_t* Data     = nullptr;
+            uint32_t       Position = 0;
+
+            uint32_t       Read(uint32_t count)
+            {
+                uint32_t value = 0;
+                for (uint32_t i = 0; i < count; ++i, ++Position)
+                {
+                    value |= uint32_t((Data[Position >> 3] >> (Position & 7)) & 1u) << i;
+                }
+                return value;
+            }
+        };
+
+        template <int N>
+        Vector<N> Clamp(const Vector<N>& value, float min_value, float max_value)
+        {
+            Vector<N> result;
+            for (int c = 0; c < N; ++c)
+            {
+                result[c] = std::clamp(value[c], min_value, max_value);
+            }
+            return result;
+        }
+
+        /*
+         * Segment the texels spread along : the principal axis of their covariance (power iteration) through their mean, cut at
+         * the extreme projections
+         */
+        template <int N>
+        void FitPrincipalAxis(const Vector<N>* texels, float min_value, float max_value, Vector<N>& e0, Vector<N>& e1)
+        {
+            Vector<N> mean = {};
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                for (int c = 0; c < N; ++c)
+                {
+                    mean[c] += texels[i][c] / float(BlockTexelCount);
+                }
+            }
+
+            float covariance[N][N] = {};
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                for (int r = 0; r < N; ++r)
+                {
+                    for (int c = 0; c < N; ++c)
+                    {
+                        covariance[r][c] += (texels[i][r] - mean[r]) * (texels[i][c] - mean[c]);
+                    }
+                }
+            }
+
+            /*
+             * Started from the row of the largest variance, which can't be orthogonal to the principal axis
+             */
+            int largest = 0;
+            for (int c = 1; c < N; ++c)
+            {
+                largest = (covariance[c][c] > covariance[largest][largest]) ? c : largest;
+            }
+
+            Vector<N> axis;
+            for (int c = 0; c < N; ++c)
+            {
+                axis[c] = covariance[largest][c];
+            }
+
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                Vector<N> next      = {};
+                float     magnitude = 0.0f;
+                for (int r = 0; r < N; ++r)
+                {
+                    for (int c = 0; c < N; ++c)
+                    {
+                        next[r] += covariance[r][c] * axis[c];
+                    }
+                    magnitude = std::max(magnitude, std::abs(next[r]));
+                }
+
+                if (magnitude <= 0.0f)
+                {
+                    break;
+                }
+                for (int c = 0; c < N; ++c)
+                {
+                    axis[c] = next[c] / magnitude;
+                }
+            }
+
+            float length = 0.0f;
+            for (int c = 0; c < N; ++c)
+            {
+                length += axis[c] * axis[c];
+            }
+            length = std::sqrt(length);
+
+            if (length < 1e-6f)
+            {
+                e0 = Clamp<N>(mean, min_value, max_value);
+                e1 = e0;
+                return;
+            }
+
+            float min_t = std::numeric_limits<float>::max(), max_t = std::numeric_limits<float>::lowest();
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                float t = 0.0f;
+                for (int c = 0; c < N; ++c)
+                {
+                    t += (texels[i][c] - mean[c]) * axis[c] / length;
+                }
+                min_t = std::min(min_t, t);
+                max_t = std::max(max_t, t);
+            }
+
+            for (int c = 0; c < N; ++c)
+            {
+                e0[c] = mean[c] + axis[c] / length * min_t;
+                e1[c] = mean[c] + axis[c] / length * max_t;
+            }
+            e0 = Clamp<N>(e0, min_value, max_value);
+            e1 = Clamp<N>(e1, min_value, max_value);
+        }
+
+        /*
+         * Least squares endpoints for the texels given their position t on the segment (0 at e0, 1 at e1).
+         * False when every texel sits at the same position : the fit is undetermined
+         */
+        template <int N>
+        bool RefineEndpoints(const Vector<N>* texels, const float* t, float min_value, float max_value, Vector<N>& e0, Vector<N>& e1)
+        {
+            float     a = 0.0f, b = 0.0f, c = 0.0f;
+            Vector<N> x0 = {}, x1 = {};
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                float s  = 1.0f - t[i];
+                a       += s * s;
+                b       += s * t[i];
+                c       += t[i] * t[i];
+                for (int k = 0; k < N; ++k)
+                {
+                    x0[k] += s * texels[i][k];
+                    x1[k] += t[i] * texels[i][k];
+                }
+            }
+
+            float determinant = a * c - b * b;
+            if (std::abs(determinant) < 1e-6f)
+            {
+                return false;
+            }
+
+            for (int k = 0; k < N; ++k)
+            {
+                e0[k] = (c * x0[k] - b * x1[k]) / determinant;
+                e1[k] = (a * x1[k] - b * x0[k]) / determinant;
+            }
+            e0 = Clamp<N>(e0, min_value, max_value);
+            e1 = Clamp<N>(e1, min_value, max_value);
+            return true;
+        }
+
+        // BC1 color block, also the color half of BC3
+        //
+        uint16_t PackRgb565(const Vector<3>& color)
+        {
+            auto r = uint16_t(std::lround(color[0] * 31.0f / 255.0f));
+            auto g = uint16_t(std::lround(color[1] * 63.0f / 255.0f));
+            auto b = uint16_t(std::lround(color[2] * 31.0f / 255.0f));
+            return uint16_t((r << 11) | (g << 5) | b);
+        }
+
+        void UnpackRgb565(uint16_t value, int* rgb)
+        {
+            int r  = (value >> 11) & 0x1F;
+            int g  = (value >> 5) & 0x3F;
+            int b  = value & 0x1F;
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        }
+
+        /*
+         * Four color mode when c0 > c1 (always for BC3), three colors and transparent black otherwise
+         */
+        void ColorPalette(uint16_t c0, uint16_t c1, bool always_four_color, int (*palette)[4])
+        {
+            UnpackRgb565(c0, palette[0]);
+            UnpackRgb565(c1, palette[1]);
+            palette[0][3] = palette[1][3] = 255;
+
+            bool four_color = always_four_color || (c0 > c1);
+            for (int c = 0; c < 3; ++c)
+            {
+                if (four_color)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+                }
+                else
+                {
+                    palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+            palette[2][3] = 255;
+            palette[3][3] = four_color ? 255 : 0;
+        }
+
+        void EncodeColorBlock(const uint8_t* rgba, uint8_t* block)
+        {
+            constexpr float IndexPosition[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+            Vector<3> texels[BlockTexelCount];
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                texels[i] = {float(rgba[i * 4]), float(rgba[i * 4 + 1]), float(rgba[i * 4 + 2])};
+            }
+
+            Vector<3> e0, e1;
+            FitPrincipalAxis<3>(texels, 0.0f, 255.0f, e0, e1);
+
+            float    best_error                    = std::numeric_limits<float>::max();
+            uint16_t best_c0                       = 0;
+            uint16_t best_c1                       = 0;
+            uint8_t  best_indices[BlockTexelCount] = {};
+
+            for (int round = 0; round < RefinementCount; ++round)
+            {
+                uint16_t c0 = PackRgb565(e0);
+                uint16_t c1 = PackRgb565(e1);
+                if (c0 < c1)
+                {
+                    std::swap(c0, c1);
+                    std::swap(e0, e1);
+                }
+
+                /*
+                 * Equal endpoints select the three color mode : index 0 is the only safe one
+                 */
+                int palette[4][4];
+                ColorPalette(c0, c1, false, palette);
+                int     entry_count = (c0 == c1) ? 1 : 4;
+                float   error       = 0.0f;
+                uint8_t indices[BlockTexelCount];
+                float   t[BlockTexelCount];
+                for (int i = 0; i < BlockTexelCount; ++i)
+                {
+                    float texel_error = std::numeric_limits<float>::max();
+                    for (int entry = 0; entry < entry_count; ++entry)
+                    {
+                        float distance = 0.0f;
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            float delta  = texels[i][c] - float(palette[entry][c]);
+                            distance    += delta * delta;
+                        }
+                        if (distance < texel_error)
+                        {
+                            texel_error = distance;
+                            indices[i]  = uint8_t(entry);
+                        }
+                    }
+                    error += texel_error;
+                    t[i]   = IndexPosition[indices[i]];
+                }
+
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best_c0    = c0;
+                    best_c1    = c1;
+                    std::copy_n(indices, BlockTexelCount, best_indices);
+                }
+
+                if ((c0 == c1) || !RefineEndpoints<3>(texels, t, 0.0f, 255.0f, e0, e1))
+                {
+                    break;
+                }
+            }
+
+            uint32_t packed_indices = 0;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                packed_indices |= uint32_t(best_indices[i]) << (2 * i);
+            }
+            std::memcpy(block, &best_c0, sizeof(best_c0));
+            std::memcpy(block + 2, &best_c1, sizeof(best_c1));
+            std::memcpy(block + 4, &packed_indices, sizeof(packed_indices));
+        }
+
+        void DecodeColorBlock(const uint8_t* block, bool always_four_color, uint8_t* rgba)
+        {
+            uint16_t c0, c1;
+            uint32_t packed_indices;
+            std::memcpy(&c0, block, sizeof(c0));
+            std::memcpy(&c1, block + 2, sizeof(c1));
+            std::memcpy(&packed_indices, block + 4, sizeof(packed_indices));
+
+            int palette[4][4];
+            ColorPalette(c0, c1, always_four_color, palette);
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                const int* color = palette[(packed_indices >> (2 * i)) & 3];
+                for (int c = 0; c < 4; ++c)
+                {
+                    rgba[i * 4 + c] = uint8_t(color[c]);
+                }
+            }
+        }
+
+        // BC4 single channel block, also the alpha half of BC3 and both halves of BC5
+        //
+        /*
+         * Eight values when r0 > r1, otherwise six and the 0 / 255 extremes
+         */
+        void ChannelPalette(int r0, int r1, int* palette)
+        {
+            palette[0] = r0;
+            palette[1] = r1;
+            if (r0 > r1)
+            {
+                for (int k = 1; k <= 6; ++k)
+                {
+                    palette[k + 1] = ((7 - k) * r0 + k * r1 + 3) / 7;
+                }
+            }
+            else
+            {
+                for (int k = 1; k <= 4; ++k)
+                {
+                    palette[k + 1] = ((5 - k) * r0 + k * r1 + 2) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        float FitChannelIndices(const Vector<1>* values, int r0, int r1, uint8_t* indices)
+        {
+            int palette[8];
+            ChannelPalette(r0, r1, palette);
+
+            float error = 0.0f;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                float texel_error = std::numeric_limits<float>::max();
+                for (int entry = 0; entry < 8; ++entry)
+                {
+                    float delta = values[i][0] - float(palette[entry]);
+                    if (delta * delta < texel_error)
+                    {
+                        texel_error = delta * delta;
+                        indices[i]  = uint8_t(entry);
+                    }
+                }
+                error += texel_error;
+            }
+            return error;
+        }
+
+        void EncodeChannelBlock(const uint8_t* rgba, int channel, uint8_t* block)
+        {
+            Vector<1> values[BlockTexelCount];
+            float     min_value = 255.0f, max_value = 0.0f;
+            float     inner_min = 255.0f, inner_max = 0.0f;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                values[i][0] = float(rgba[i * 4 + channel]);
+                min_value    = std::min(min_value, values[i][0]);
+                max_value    = std::max(max_value, values[i][0]);
+                if ((values[i][0] > 0.0f) && (values[i][0] < 255.0f))
+                {
+                    inner_min = std::min(inner_min, values[i][0]);
+                    inner_max = std::max(inner_max, values[i][0]);
+                }
+            }
+
+            float   best_error = std::numeric_limits<float>::max();
+            int     best_r0 = 0, best_r1 = 0;
+            uint8_t best_indices[BlockTexelCount] = {};
+            uint8_t indices[BlockTexelCount];
+
+            auto try_endpoints = [&](int r0, int r1) {
+                float error = FitChannelIndices(values, r0, r1, indices);
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best_r0    = r0;
+                    best_r1    = r1;
+                    std::copy_n(indices, BlockTexelCount, best_indices);
+                }
+            };
+
+            /*
+             * Candidates : the minimum alone, the six value mode between the values the 0 / 255 extremes don't already cover,
+             * then the eight value mode from the full range, refined
+             */
+            try_endpoints(int(min_value), int(min_value));
+            if (inner_min <= inner_max)
+            {
+                try_endpoints(int(inner_min), int(inner_max));
+            }
+
+            Vector<1> e0 = {max_value}, e1 = {min_value};
+            for (int round = 0; (round < RefinementCount) && (max_value > min_value); ++round)
+            {
+                int r0 = int(std::lround(e0[0]));
+                int r1 = int(std::lround(e1[0]));
+                if (r0 < r1)
+                {
+                    std::swap(r0, r1);
+                }
+                if (r0 == r1)
+                {
+                    break;
+                }
+
+                /*
+                 * Indices 0 and 1 are the endpoints, 2 to 7 the interpolated values from r0 to r1
+                 */
+                float t[BlockTexelCount];
+                try_endpoints(r0, r1);
+                for (int i = 0; i < BlockTexelCount; ++i)
+                {
+                    t[i] = (indices[i] < 2) ? float(indices[i]) : float(indices[i] - 1) / 7.0f;
+                }
+
+                e0 = {float(r0)};
+                e1 = {float(r1)};
+                if (!RefineEndpoints<1>(values, t, 0.0f, 255.0f, e0, e1))
+                {
+                    break;
+                }
+            }
+
+            block[0]                = uint8_t(best_r0);
+            block[1]                = uint8_t(best_r1);
+            uint64_t packed_indices = 0;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                packed_indices |= uint64_t(best_indices[i]) << (3 * i);
+            }
+            for (int byte = 0; byte < 6; ++byte)
+            {
+                block[2 + byte] = uint8_t(packed_indices >> (8 * byte));
+            }
+        }
+
+        void DecodeChannelBlock(const uint8_t* block, int channel, uint8_t* rgba)
+        {
+            int palette[8];
+            ChannelPalette(block[0], block[1], palette);
+
+            uint64_t packed_indices = 0;
+            for (int byte = 0; byte < 6; ++byte)
+            {
+                packed_indices |= uint64_t(block[2 + byte]) << (8 * byte);
+            }
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                rgba[i * 4 + channel] = uint8_t(palette[(packed_indices >> (3 * i)) & 7]);
+            }
+        }
+
+        // BC7, mode 6 only
+        //
+        constexpr uint32_t Bc7Mode = 6;
+
+        float              FitBc7Indices(const Vector<4>* texels, const int (*endpoints)[4], uint8_t* indices)
+        {
+            float palette[16][4];
+            for (int entry = 0; entry < 16; ++entry)
+            {
+                for (int c = 0; c < 4; ++c)
+                {
+                    palette[entry][c] = float(((64 - IndexWeights[entry]) * endpoints[0][c] + IndexWeights[entry] * endpoints[1][c] + 32) >> 6);
+                }
+            }
+
+            float error = 0.0f;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                float texel_error = std::numeric_limits<float>::max();
+                for (int entry = 0; entry < 16; ++entry)
+                {
+                    float distance = 0.0f;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        float delta  = texels[i][c] - palette[entry][c];
+                        distance    += delta * delta;
+                    }
+                    if (distance < texel_error)
+                    {
+                        texel_error = distance;
+                        indices[i]  = uint8_t(entry);
+                    }
+                }
+                error += texel_error;
+            }
+            return error;
+        }
+
+        void EncodeBc7Block(const uint8_t* rgba, uint8_t* block)
+        {
+            Vector<4> texels[BlockTexelCount];
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                texels[i] = {float(rgba[i * 4]), float(rgba[i * 4 + 1]), float(rgba[i * 4 + 2]), float(rgba[i * 4 + 3])};
+            }
+
+            Vector<4> e0, e1;
+            FitPrincipalAxis<4>(texels, 0.0f, 255.0f, e0, e1);
+
+            float   best_error                    = std::numeric_limits<float>::max();
+            int     best_quantized[2][4]          = {};
+            int     best_pbits[2]                 = {};
+            uint8_t best_indices[BlockTexelCount] = {};
+
+            for (int round = 0; round < RefinementCount; ++round)
+            {
+                /*
+                 * The p-bit is the shared low bit of an endpoint's four channels : every combination is tried
+                 */
+                float   round_error = std::numeric_limits<float>::max();
+                uint8_t round_indices[BlockTexelCount];
+                for (int pbits = 0; pbits < 4; ++pbits)
+                {
+                    int quantized[2][4], endpoints[2][4], pbit[2] = {pbits & 1, pbits >> 1};
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        quantized[0][c] = std::clamp(int(std::lround((e0[c] - float(pbit[0])) / 2.0f)), 0, 127);
+                        quantized[1][c] = std::clamp(int(std::lround((e1[c] - float(pbit[1])) / 2.0f)), 0, 127);
+                        endpoints[0][c] = (quantized[0][c] << 1) | pbit[0];
+                        endpoints[1][c] = (quantized[1][c] << 1) | pbit[1];
+                    }
+
+                    uint8_t indices[BlockTexelCount];
+                    float   error = FitBc7Indices(texels, endpoints, indices);
+                    if (error < round_error)
+                    {
+                        round_error = error;
+                        std::copy_n(indices, BlockTexelCount, round_indices);
+                    }
+                    if (error < best_error)
+                    {
+                        best_error    = error;
+                        best_pbits[0] = pbit[0];
+                        best_pbits[1] = pbit[1];
+                        std::memcpy(best_quantized, quantized, sizeof(quantized));
+                        std::copy_n(indices, BlockTexelCount, best_indices);
+                    }
+                }
+
+                float t[BlockTexelCount];
+                for (int i = 0; i < BlockTexelCount; ++i)
+                {
+                    t[i] = float(IndexWeights[round_indices[i]]) / 64.0f;
+                }
+                if (!RefineEndpoints<4>(texels, t, 0.0f, 255.0f, e0, e1))
+                {
+                    break;
+                }
+            }
+
+            /*
+             * The anchor (first) index is stored without its high bit : swapping the endpoints clears it
+             */
+            if (best_indices[0] & 8)
+            {
+                std::swap(best_quantized[0], best_quantized[1]);
+                std::swap(best_pbits[0], best_pbits[1]);
+                for (auto& index : best_indices)
+                {
+                    index = uint8_t(15 - index);
+                }
+            }
+
+            std::memset(block, 0, 16);
+            BitWriter writer = {.Data = block};
+            writer.Write(1u << Bc7Mode, Bc7Mode + 1);
+            for (int c = 0; c < 4; ++c)
+            {
+                writer.Write(uint32_t(best_quantized[0][c]), 7);
+                writer.Write(uint32_t(best_quantized[1][c]), 7);
+            }
+            writer.Write(uint32_t(best_pbits[0]), 1);
+            writer.Write(uint32_t(best_pbits[1]), 1);
+            writer.Write(best_indices[0], 3);
+            for (int i = 1; i < BlockTexelCount; ++i)
+            {
+                writer.Write(best_indices[i], 4);
+            }
+        }
+
+        bool DecodeBc7Block(const uint8_t* block, uint8_t* rgba)
+        {
+            BitReader reader = {.Data = block};
+            uint32_t  mode   = 0;
+            while ((mode < 8) && (reader.Read(1) == 0))
+            {
+                ++mode;
+            }
+            if (mode != Bc7Mode)
+            {
+                return false;
+            }
+
+            int endpoints[2][4];
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoints[0][c] = int(reader.Read(7));
+                endpoints[1][c] = int(reader.Read(7));
+            }
+            int pbit[2] = {int(reader.Read(1)), int(reader.Read(1))};
+            for (int c = 0; c < 4; ++c)
+            {
+                endpoints[0][c] = (endpoints[0][c] << 1) | pbit[0];
+                endpoints[1][c] = (endpoints[1][c] << 1) | pbit[1];
+            }
+
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                int weight = IndexWeights[reader.Read(i == 0 ? 3 : 4)];
+                for (int c = 0; c < 4; ++c)
+                {
+                    rgba[i * 4 + c] = uint8_t(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+                }
+            }
+            return true;
+        }
+
+        // BC6H, unsigned mode 11 only
+        //
+        constexpr uint32_t Bc6hMode        = 0x03;
+        constexpr int      Bc6hEndpointMax = (1 << 10) - 1;
+
+        /*
+         * Half float bits of a non negative value, NaN and negative values read as zero
+         */
+        uint16_t           FloatToHalf(float value)
+        {
+            if (!(value > 0.0f))
+            {
+                return 0;
+            }
+            if (value >= 65504.0f)
+            {
+                return 0x7BFF;
+            }
+            if (value < 6.103515625e-05f)
+            {
+                /*
+                 * Subnormal : multiples of 2^-24
+                 */
+                return uint16_t(std::lround(value * 16777216.0f));
+            }
+
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            uint32_t exponent  = ((bits >> 23) & 0xFF) - 127 + 15;
+            uint32_t mantissa  = bits & 0x7FFFFF;
+            uint32_t half      = (exponent << 10) | (mantissa >> 13);
+            uint32_t remainder = mantissa & 0x1FFF;
+            if ((remainder > 0x1000) || ((remainder == 0x1000) && (half & 1)))
+            {
+                ++half;
+            }
+            return uint16_t(half);
+        }
+
+        float HalfToFloat(uint16_t half)
+        {
+            int exponent = (half >> 10) & 0x1F;
+            int mantissa = half & 0x3FF;
+            if (exponent == 0)
+            {
+                return std::ldexp(float(mantissa), -24);
+            }
+            if (exponent == 31)
+            {
+                return mantissa ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+            }
+            return std::ldexp(float(mantissa | 0x400), exponent - 25);
+        }
+
+        int Bc6hUnquantize(int value)
+        {
+            if (value == 0)
+            {
+                return 0;
+            }
+            if (value == Bc6hEndpointMax)
+            {
+                return 0xFFFF;
+            }
+            return ((value << 16) + 0x8000) >> 10;
+        }
+
+        /*
+         * The 10 bit endpoint whose unquantized value is the closest
+         */
+        int Bc6hQuantize(float value)
+        {
+            int guess = int((value - 32.0f) / 64.0f);
+            int best  = 0;
+            for (int candidate = std::max(guess - 1, 0); candidate <= std::min(guess + 2, Bc6hEndpointMax); ++candidate)
+            {
+                if (std::abs(float(Bc6hUnquantize(candidate)) - value) < std::abs(float(Bc6hUnquantize(best)) - value))
+                {
+                    best = candidate;
+                }
+            }
+            return std::abs(float(Bc6hUnquantize(Bc6hEndpointMax)) - value) < std::abs(float(Bc6hUnquantize(best)) - value) ? Bc6hEndpointMax : best;
+        }
+
+        /*
+         * Interpolated value back to half float bits
+         */
+        int Bc6hInterpolate(int e0, int e1, int weight)
+        {
+            int value = ((64 - weight) * Bc6hUnquantize(e0) + weight * Bc6hUnquantize(e1) + 32) >> 6;
+            return (value * 31) >> 6;
+        }
+
+        float FitBc6hIndices(const Vector<3>* halves, const int (*endpoints)[3], uint8_t* indices)
+        {
+            float palette[16][3];
+            for (int entry = 0; entry < 16; ++entry)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    palette[entry][c] = float(Bc6hInterpolate(endpoints[0][c], endpoints[1][c], IndexWeights[entry]));
+                }
+            }
+
+            float error = 0.0f;
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                float texel_error = std::numeric_limits<float>::max();
+                for (int entry = 0; entry < 16; ++entry)
+                {
+                    float distance = 0.0f;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        float delta  = halves[i][c] - palette[entry][c];
+                        distance    += delta * delta;
+                    }
+                    if (distance < texel_error)
+                    {
+                        texel_error = distance;
+                        indices[i]  = uint8_t(entry);
+                    }
+                }
+                error += texel_error;
+            }
+            return error;
+        }
+
+        /*
+         * Endpoints are fitted where the hardware interpolates : the half float bits scaled by 64 / 31 (the inverse of the final
+         * unquantization), a roughly logarithmic space. The error is measured on the half float bits
+         */
+        void EncodeBc6hBlock(const float* rgba, uint8_t* block)
+        {
+            Vector<3> halves[BlockTexelCount];
+            Vector<3> texels[BlockTexelCount];
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    halves[i][c] = float(FloatToHalf(rgba[i * 4 + c]));
+                    texels[i][c] = halves[i][c] * 64.0f / 31.0f;
+                }
+            }
+
+            Vector<3> e0, e1;
+            FitPrincipalAxis<3>(texels, 0.0f, 65535.0f, e0, e1);
+
+            float   best_error = std::numeric_limits<float>::max();
+            int     best_endpoints[2][3] = {};
+            uint8_t best_indices[BlockTexelCount] = {};
+
+            for (int round = 0; round < RefinementCount; ++round)
+            {
+                int endpoints[2][3];
+                for (int c = 0; c < 3; ++c)
+                {
+                    endpoints[0][c] = Bc6hQuantize(e0[c]);
+                    endpoints[1][c] = Bc6hQuantize(e1[c]);
+                }
+
+                uint8_t indices[BlockTexelCount];
+                float   error = FitBc6hIndices(halves, endpoints, indices);
+                if (error < best_error)
+                {
+                    best_error = error;
+                    std::memcpy(best_endpoints, endpoints, sizeof(endpoints));
+                    std::copy_n(indices, BlockTexelCount, best_indices);
+                }
+
+                float t[BlockTexelCount];
+                for (int i = 0; i < BlockTexelCount; ++i)
+                {
+                    t[i] = float(IndexWeights[indices[i]]) / 64.0f;
+                }
+                if (!RefineEndpoints<3>(texels, t, 0.0f, 65535.0f, e0, e1))
+                {
+                    break;
+                }
+            }
+
+            if (best_indices[0] & 8)
+            {
+                std::swap(best_endpoints[0], best_endpoints[1]);
+                for (auto& index : best_indices)
+                {
+                    index = uint8_t(15 - index);
+                }
+            }
+
+            std::memset(block, 0, 16);
+            BitWriter writer = {.Data = block};
+            writer.Write(Bc6hMode, 5);
+            for (int endpoint = 0; endpoint < 2; ++endpoint)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    writer.Write(uint32_t(best_endpoints[endpoint][c]), 10);
+                }
+            }
+            writer.Write(best_indices[0], 3);
+            for (int i = 1; i < BlockTexelCount; ++i)
+            {
+                writer.Write(best_indices[i], 4);
+            }
+        }
+
+        bool DecodeBc6hBlock(const uint8_t* block, float* rgba)
+        {
+            BitReader reader = {.Data = block};
+            uint32_t  mode   = reader.Read(2);
+            if (mode > 1)
+            {
+                mode |= reader.Read(3) << 2;
+            }
+            if (mode != Bc6hMode)
+            {
+                return false;
+            }
+
+            int endpoints[2][3];
+            for (int endpoint = 0; endpoint < 2; ++endpoint)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    endpoints[endpoint][c] = int(reader.Read(10));
+                }
+            }
+
+            for (int i = 0; i < BlockTexelCount; ++i)
+            {
+                int weight = IndexWeights[reader.Read(i == 0 ? 3 : 4)];
+                for (int c = 0; c < 3; ++c)
+                {
+                    rgba[i * 4 + c] = HalfToFloat(uint16_t(Bc6hInterpolate(endpoints[0][c], endpoints[1][c], weight)));
+                }
+                rgba[i * 4 + 3] = 1.0f;
+            }
+            return true;
+        }
+
+        /*
+         * One row of blocks of one layer of one level : where its texels and its blocks start in their image
+         */
+        struct BlockRow
+        {
+            size_t   TexelOffset = 0;
+            size_t   BlockOffset = 0;
+            uint32_t Width       = 0;
+            uint32_t Height      = 0;
+            uint32_t Y           = 0;
+        };
+
+        /*
+         * Pairs the levels and layers of an image with their blocks, both laid out level after level
+         */
+        std::vector<BlockRow> CollectBlockRows(const DecodedImage& texel_image, const DecodedImage& block_image)
+        {
+            std::vector<BlockRow> rows;
+            for (uint32_t level = 0; level < texel_image.MipLevelCount; ++level)
+            {
+                uint32_t width            = std::max(texel_image.Width >> level, 1u);
+                uint32_t height           = std::max(texel_image.Height >> level, 1u);
+                size_t   texel_layer_size = texel_image.LevelByteSize(level) / texel_image.LayerCount;
+                size_t   block_layer_size = block_image.LevelByteSize(level) / block_image.LayerCount;
+                size_t   block_row_size   = size_t((width + 3) / 4) * BlockByteSize(block_image.Format);
+                for (uint32_t layer = 0; layer < texel_image.LayerCount; ++layer)
+                {
+                    size_t texel_offset = texel_image.MipByteOffset(level) + layer * texel_layer_size;
+                    size_t block_offset = block_image.MipByteOffset(level) + layer * block_layer_size;
+                    for (uint32_t y = 0; y < height; y += 4)
+                    {
+                        rows.push_back({.TexelOffset = texel_offset, .BlockOffset = block_offset + (y / 4) * block_row_size, .Width = width, .Height = height, .Y = y});
+                    }
+                }
+            }
+            return rows;
+        }
+
+        bool HasTranslucentTexels(const DecodedImage& image)
+        {
+            for (size_t i = 3; i < image.LevelByteSize(0); i += 4)
+            {
+                if (image.Pixels[i] != 255)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    } // namespace
+
+    TextureCompressionOptions TextureCompressor::SelectOptions(TextureUsage usage, const DecodedImage& image, const TextureImportOptions& options)
+    {
+        if (image.Format == DecodedPixelFormat::RGBA32F)
+        {
+            return {.Format = DecodedPixelFormat::BC6H, .IsSrgb = false, .MipOptions = {.IsSrgb = false}};
+        }
+
+        switch (usage)
+        {
+            case TextureUsage::NORMAL_MAP:
+                return {.Format = DecodedPixelFormat::BC5, .IsSrgb = false, .MipOptions = {.IsSrgb = false, .IsNormalMap = true}};
+            case TextureUsage::MASK:
+                return {.Format = DecodedPixelFormat::BC4, .IsSrgb = false, .MipOptions = {.IsSrgb = false}};
+            case TextureUsage::COLOR:
+                break;
+        }
+
+        if (options.HighQualityColor)
+        {
+            return {.Format = DecodedPixelFormat::BC7};
+        }
+        return {.Format = HasTranslucentTexels(image) ? DecodedPixelFormat::BC3 : DecodedPixelFormat::BC1};
+    }
+
+    bool TextureCompressor::Compress(const DecodedImage& source, const TextureCompressionOptions& options, DecodedImage& compressed)
+    {
+        compressed           = {};
+        bool is_float_format = (options.Format == DecodedPixelFormat::BC6H);
+        auto expected_format = is_float_format ? DecodedPixelFormat::RGBA32F : DecodedPixelFormat::RGBA8;
+        if (!IsBlockCompressed(options.Format) || (source.Format != expected_format) || (source.Width == 0) || (source.Height == 0) || (source.Pixels.size() != source.MipByteOffset(source.MipLevelCount)))
+        {
+            return false;
+        }
+
+        /*
+         * Each layer gets its own chain, interleaved back level after level
+         */
+        DecodedImage        chain;
+        const DecodedImage* levels      = &source;
+        uint32_t            level_count = Buffers::Bitmap::MipLevelCount(source.Width, source.Height);
+        if (options.GenerateMipChain && (source.MipLevelCount == 1) && (level_count > 1))
+        {
+            auto                                      bitmap_format = is_float_format ? Buffers::BitmapFormat::FLOAT : Buffers::BitmapFormat::UNSIGNED_BYTE;
+            size_t                                    layer_size    = source.LevelByteSize(0) / source.LayerCount;
+            std::vector<std::vector<Buffers::Bitmap>> layer_chains;
+            for (uint32_t layer = 0; layer < source.LayerCount; ++layer)
+            {
+                Buffers::Bitmap layer_0(int(source.Width), int(source.Height), 4, bitmap_format, source.Pixels.data() + layer * layer_size);
+                layer_chains.emplace_back(Buffers::Bitmap::GenerateMipChain(layer_0, options.MipOptions));
+            }
+
+            chain               = source;
+            chain.MipLevelCount = level_count;
+            chain.Pixels.reserve(chain.MipByteOffset(level_count));
+            for (uint32_t level = 1; level < level_count; ++level)
+            {
+                for (const auto& layer_chain : layer_chains)
+                {
+                    const auto& buffer = layer_chain[level - 1].Buffer;
+                    chain.Pixels.insert(chain.Pixels.end(), buffer.begin(), buffer.end());
+                }
+            }
+            levels = &chain;
+        }
+
+        compressed.Width         = source.Width;
+        compressed.Height        = source.Height;
+        compressed.LayerCount    = source.LayerCount;
+        compressed.MipLevelCount = levels->MipLevelCount;
+        compressed.IsCubemap     = source.IsCubemap;
+        compressed.Format        = options.Format;
+        /*
+         * Only BC1, BC3 and BC7 have sRGB variants
+         */
+        compressed.IsSrgb        = options.IsSrgb && ((options.Format == DecodedPixelFormat::BC1) || (options.Format == DecodedPixelFormat::BC3) || (options.Format == DecodedPixelFormat::BC7));
+        compressed.Pixels.resize(compressed.MipByteOffset(compressed.MipLevelCount));
+
+        auto   rows       = CollectBlockRows(*levels, compressed);
+        size_t texel_size = levels->BytePerPixel();
+        size_t block_size = BlockByteSize(options.Format);
+        Helpers::ThreadPoolHelper::ParallelFor(rows.size(), BlockRowBatch, [&](size_t begin, size_t end) {
+            /*
+             * Texels past the right and bottom edges repeat the last column and row
+             */
+            alignas(16) uint8_t texels[BlockTexelCount * 4 * sizeof(float)];
+            for (size_t r = begin; r < end; ++r)
+            {
+                const auto&    row    = rows[r];
+                const uint8_t* input  = levels->Pixels.data() + row.TexelOffset;
+                uint8_t*       output = compressed.Pixels.data() + row.BlockOffset;
+                for (uint32_t x = 0; x < row.Width; x += 4)
+                {
+                    for (uint32_t i = 0; i < BlockTexelCount; ++i)
+                    {
+                        uint32_t texel_x = std::min(x + (i & 3), row.Width - 1);
+                        uint32_t texel_y = std::min(row.Y + (i >> 2), row.Height - 1);
+                        std::memcpy(texels + i * texel_size, input + (size_t(texel_y) * row.Width + texel_x) * texel_size, texel_size);
+                    }
+                    EncodeBlock(options.Format, texels, output + (x / 4) * block_size);
+                }
+            }
+        });
+        return true;
+    }
+
+    bool TextureCompressor::Decompress(const DecodedImage& compressed, DecodedImage& image)
+    {
+        image = {};
+        if (!IsBlockCompressed(compressed.Format) || (compressed.Pixels.size() != compressed.MipByteOffset(compressed.MipLevelCount)))
+        {
+            return false;
+        }
+
+        image.Width         = compressed.Width;
+        image.Height        = compressed.Height;
+        image.LayerCount    = compressed.LayerCount;
+        image.MipLevelCount = compressed.MipLevelCount;
+        image.IsCubemap     = compressed.IsCubemap;
+        image.Format        = (compressed.Format == DecodedPixelFormat::BC6H) ? DecodedPixelFormat::RGBA32F : DecodedPixelFormat::RGBA8;
+        image.Pixels.resize(image.MipByteOffset(image.MipLevelCount));
+
+        auto             rows       = CollectBlockRows(image, compressed);
+        size_t           texel_size = image.BytePerPixel();
+        size_t           block_size = BlockByteSize(compressed.Format);
+        std::atomic_bool succeeded{true};
+        Helpers::ThreadPoolHelper::ParallelFor(rows.size(), BlockRowBatch, [&](size_t begin, size_t end) {
+            alignas(16) uint8_t texels[BlockTexelCount * 4 * sizeof(float)];
+            for (size_t r = begin; r < end; ++r)
+            {
+                const auto&    row    = rows[r];
+                const uint8_t* input  = compressed.Pixels.data() + row.BlockOffset;
+                uint8_t*       output = image.Pixels.data() + row.TexelOffset;
+                for (uint32_t x = 0; x < row.Width; x += 4)
+                {
+                    if (!DecodeBlock(compressed.Format, input + (x / 4) * block_size, texels))
+                    {
+                        succeeded = false;
+                        return;
+                    }
+
+                    for (uint32_t i = 0; i < BlockTexelCount; ++i)
+                    {
+                        uint32_t texel_x = x + (i & 3);
+                        uint32_t texel_y = row.Y + (i >> 2);
+                        if ((texel_x < row.Width) && (texel_y < row.Height))
+                        {
+                            std::memcpy(output + (size_t(texel_y) * row.Width + texel_x) * texel_size, texels + i * texel_size, texel_size);
+                        }
+                    }
+                }
+            }
+        });
+
+        if (!succeeded)
+        {
+            image = {};
+        }
+        return succeeded;
+    }
+
+    void TextureCompressor::EncodeBlock(DecodedPixelFormat format, const void* texels, uint8_t* block)
+    {
+        const auto* rgba = static_cast<const uint8_t*>(texels);
+        switch (format)
+        {
+            case DecodedPixelFormat::BC1:
+                EncodeColorBlock(rgba, block);
+                break;
+            case DecodedPixelFormat::BC3:
+                EncodeChannelBlock(rgba, 3, block);
+                EncodeColorBlock(rgba, block + 8);
+                break;
+            case DecodedPixelFormat::BC4:
+                EncodeChannelBlock(rgba, 0, block);
+                break;
+            case DecodedPixelFormat::BC5:
+                EncodeChannelBlock(rgba, 0, block);
+                EncodeChannelBlock(rgba, 1, block + 8);
+                break;
+            case DecodedPixelFormat::BC6H:
+                EncodeBc6hBlock(static_cast<const float*>(texels), block);
+                break;
+            case DecodedPixelFormat::BC7:
+                EncodeBc7Block(rgba, block);
+                break;
+            default:
+                ZENGINE_VALIDATE_ASSERT(false, "Not a block compressed format")
+                break;
+        }
+    }
+
+    bool TextureCompressor::DecodeBlock(DecodedPixelFormat format, const uint8_t* block, void* texels)
+    {
+        auto* rgba = static_cast<uint8_t*>(texels);
+        switch (format)
+        {
+            case DecodedPixelFormat::BC1:
+                DecodeColorBlock(block, false, rgba);
+                return true;
+            case DecodedPixelFormat::BC3:
+                DecodeColorBlock(block + 8, true, rgba);
+                DecodeChannelBlock(block, 3, rgba);
+                return true;
+            case DecodedPixelFormat::BC4:
+            case DecodedPixelFormat::BC5:
+                /*
+                 * Missing channels read as the hardware returns them : zero, alpha one
+                 */
+                for (int i = 0; i < BlockTexelCount; ++i)
+                {
+                    rgba[i * 4 + 1] = 0;
+                    rgba[i * 4 + 2] = 0;
+                    rgba[i * 4 + 3] = 255;
+                }
+                DecodeChannelBlock(block, 0, rgba);
+                if (format == DecodedPixelFormat::BC5)
+                {
+                    DecodeChannelBlock(block + 8, 1, rgba);
+                }
+                return true;
+            case DecodedPixelFormat::BC6H:
+                return DecodeBc6hBlock(block, static_cast<float*>(texels));
+            case DecodedPixelFormat::BC7:
+                return DecodeBc7Block(block, rgba);
+            default:
+                return false;
+        }
+    }
+} // namespace ZEngine::Rendering::Textures
@@ -0,0 +1,68 @@
+#pragma once
+#include <Rendering/Buffers/Bitmap.h>
+#include <Rendering/Textures/TextureDecoder.h>
+#include <cstdint>
+
+namespace ZEngine::Rendering::Textures
+{
+    /*
+     * What a material samples from a texture, it decides the block format
+     */
+    enum class TextureUsage : uint8_t
+    {
+        COLOR,
+        /*
+         * Tangent space normals : only x and y are kept, z is rebuilt from the unit length when sampling
+         */
+        NORMAL_MAP,
+        /*
+         * Single channel data (opacity), red channel only
+         */
+        MASK
+    };
+
+    struct TextureImportOptions
+    {
+        bool Enabled          = true;
+        /*
+         * Color maps in BC7, otherwise BC1 when opaque and BC3 with alpha : BC1 is half the size, but visibly blockier
+         */
+        bool HighQualityColor = true;
+    };
+
+    struct TextureCompressionOptions
+    {
+        DecodedPixelFormat       Format           = DecodedPixelFormat::BC7;
+        bool                     IsSrgb           = true;
+        /*
+         * Ignored when the source already holds a mip chain
+         */
+        bool                     GenerateMipChain = true;
+        Buffers::MipChainOptions MipOptions       = {};
+    };
+
+    /*
+     * CPU block compression, the import time half of the .zetexture path (see Serializers::TextureAssetSerializer).
+     * Every format is encoded from a principal axis fit refined by least squares, with these restrictions :
+     *  - BC7 blocks are all mode 6 (one subset, 7 bits + p-bit RGBA endpoints, 4 bit indices)
+     *  - BC6H blocks are all mode 11 (one region, 10 bit unsigned endpoints, 4 bit indices), negative values clamp to zero
+     * The decoder reads back what the encoder writes : BC6H / BC7 blocks in any other mode are rejected.
+     */
+    struct TextureCompressor
+    {
+        static TextureCompressionOptions SelectOptions(TextureUsage usage, const DecodedImage& image, const TextureImportOptions& options);
+        /*
+         * source is RGBA32F for BC6H, RGBA8 for every other format. Blocks are encoded in parallel on the thread pool
+         */
+        static bool                      Compress(const DecodedImage& source, const TextureCompressionOptions& options, DecodedImage& compressed);
+        /*
+         * Back to RGBA8 (RGBA32F for BC6H), every level and layer
+         */
+        static bool                      Decompress(const DecodedImage& compressed, DecodedImage& image);
+        /*
+         * One 4x4 block, texels row by row : 16 RGBA float texels for BC6H, 16 RGBA8 texels otherwise
+         */
+        static void                      EncodeBlock(DecodedPixelFormat format, const void* texels, uint8_t* block);
+        static bool                      DecodeBlock(DecodedPixelFormat format, const uint8_t* block, void* texels);
+    };
+} // namespace ZEngine::Rendering::Textures
@@ -0,0 +1,263 @@
+#include <pch.h>
+#include <Rendering/Textures/TextureCompressor.h>
+#include <Rendering/Textures/TextureDecodePool.h>
+#include <algorithm>
+#include <deque>
+#include <tuple>
+
+namespace ZEngine::Rendering::Textures
+{
+    namespace
+    {
+        struct PendingDecode
+        {
+            TextureDecodeRequest Request       = {};
+            uint64_t             Sequence      = 0;
+            size_t               EstimatedSize = 0;
+        };
+
+        /*
+         * Heap order : the highest priority (lowest TaskPriority value) and, within a priority, the oldest request on top
+         */
+        struct PendingDecodeOrder
+        {
+            bool operator()(const PendingDecode& lhs, const PendingDecode& rhs) const
+            {
+                return std::tie(lhs.Request.Priority, lhs.Sequence) > std::tie(rhs.Request.Priority, rhs.Sequence);
+            }
+        };
+    } // namespace
+
+    /*
+     * Shared with the decode tasks : a task queued on the thread pool may start after the pool object is gone
+     */
+    struct TextureDecodePool::State : public std::enable_shared_from_this<State>
+    {
+        mutable std::mutex              Mutex;
+        std::condition_variable         IdleCondition;
+        std::vector<PendingDecode>      Pending;
+        std::deque<TextureDecodeResult> Completed;
+        uint64_t                        NextSequence    = 0;
+        size_t                          Budget          = 0;
+        size_t                          MaxConcurrency  = 1;
+        size_t                          InFlightBytes   = 0;
+        /*
+         * Decodes handed to the thread pool, and among them those actually running
+         */
+        size_t                          DispatchedCount = 0;
+        size_t                          RunningCount    = 0;
+        bool                            IsShutdown      = false;
+        DecodeCallback                  Decode;
+        EstimateCallback                Estimate;
+        std::function<void()>           OnCompleted;
+
+        /*
+         * Pops what fits in the budget and the concurrency limit, must be called with the mutex held
+         */
+        std::vector<PendingDecode>      TakeDispatchable()
+        {
+            std::vector<PendingDecode> dispatchable;
+            while (!IsShutdown && !Pending.empty() && (DispatchedCount < MaxConcurrency))
+            {
+                const auto& head = Pending.front();
+                if ((InFlightBytes > 0) && (InFlightBytes + head.EstimatedSize > Budget))
+                {
+                    break;
+                }
+
+                std::pop_heap(Pending.begin(), Pending.end(), PendingDecodeOrder{});
+                InFlightBytes += Pending.back().EstimatedSize;
+                DispatchedCount++;
+                dispatchable.emplace_back(std::move(Pending.back()));
+                Pending.pop_back();
+            }
+            return dispatchable;
+        }
+
+        void Dispatch(std::vector<PendingDecode>&& decodes)
+        {
+            for (auto& decode : decodes)
+            {
+                auto priority = decode.Request.Priority;
+                Helpers::ThreadPoolHelper::Post([state = shared_from_this(), decode = std::move(decode)]() mutable { state->Run(decode); }, priority);
+            }
+        }
+
+        /*
+         * Body of a decode task. The reservation taken at dispatch time is corrected to the actual byte size once decoded
+         */
+        void Run(PendingDecode& pending)
+        {
+            {
+                std::lock_guard l(Mutex);
+                if (IsShutdown)
+                {
+                    DispatchedCount--;
+                    return;
+                }
+                RunningCount++;
+            }
+
+            TextureDecodeResult result = {.Request = std::move(pending.Request)};
+            result.Succeeded           = Decode(result.Request.Filename, result.Request.FlipVertically, result.Image);
+            if (result.Succeeded && result.Request.GenerateMipChain)
+            {
+                TextureDecoder::GenerateMipChain(result.Image, result.Request.MipOptions);
+            }
+            if (result.Succeeded && (result.Request.FirstMipLevel > 0))
+            {
+                result.Succeeded = TextureDecoder::DropMipLevels(result.Image, result.Request.FirstMipLevel);
+            }
+            if (result.Succeeded && result.Request.DecompressBlocks && IsBlockCompressed(result.Image.Format))
+            {
+                DecodedImage blocks = std::move(result.Image);
+                result.Succeeded    = TextureCompressor::Decompress(blocks, result.Image);
+            }
+            if (!result.Succeeded)
+            {
+                result.Image = {};
+            }
+            result.ReservedByteSize = result.Image.ByteSize();
+
+            std::function<void()> on_completed;
+            {
+                std::lock_guard l(Mutex);
+                InFlightBytes = InFlightBytes - std::min(InFlightBytes, pending.EstimatedSize) + result.ReservedByteSize;
+                if (IsShutdown)
+                {
+                    InFlightBytes -= std::min(InFlightBytes, result.ReservedByteSize);
+                }
+                else
+                {
+                    Completed.emplace_back(std::move(result));
+                    on_completed = OnCompleted;
+                }
+            }
+
+            if (on_completed)
+            {
+                on_completed();
+            }
+
+            std::vector<PendingDecode> next;
+            {
+                std::lock_guard l(Mutex);
+                RunningCount--;
+                DispatchedCount--;
+                next = TakeDispatchable();
+            }
+            IdleCondition.notify_all();
+            Dispatch(std::move(next));
+        }
+    };
+
+    TextureDecodePool::TextureDecodePool(size_t budget, size_t max_concurrency, DecodeCallback decode, EstimateCallback estimate) : m_state(std::make_shared<State>())
+    {
+        m_state->Budget         = budget;
+        m_state->MaxConcurrency = max_concurrency ? max_concurrency : std::max<size_t>(1, std::thread::hardware_concurrency() / 2);
+        m_state->Decode         = std::move(decode);
+        m_state->Estimate       = std::move(estimate);
+    }
+
+    TextureDecodePool::~TextureDecodePool()
+    {
+        Shutdown();
+    }
+
+    void TextureDecodePool::Enqueue(TextureDecodeRequest&& request)
+    {
+        /*
+         * Only the file header is read, but that is still I/O : kept out of the lock. A mip chain adds up to a third of a square
+         * image, decompressed blocks take up to 8 times their size : the reservation is corrected once decoded anyway
+         */
+        size_t                     estimated_size = m_state->Estimate ? m_state->Estimate(request.Filename) : 0;
+        if (request.GenerateMipChain)
+        {
+            estimated_size += estimated_size / 3;
+        }
+        if (request.DecompressBlocks)
+        {
+            estimated_size *= 8;
+        }
+
+        std::vector<PendingDecode> dispatchable;
+        {
+            std::lock_guard l(m_state->Mutex);
+            if (m_state->IsShutdown)
+            {
+                return;
+            }
+
+            m_state->Pending.emplace_back(PendingDecode{.Request = std::move(request), .Sequence = m_state->NextSequence++, .EstimatedSize = estimated_size});
+            std::push_heap(m_state->Pending.begin(), m_state->Pending.end(), PendingDecodeOrder{});
+            dispatchable = m_state->TakeDispatchable();
+        }
+        m_state->Dispatch(std::move(dispatchable));
+    }
+
+    size_t TextureDecodePool::PopCompleted(std::vector<TextureDecodeResult>& results, size_t max_count)
+    {
+        std::lock_guard l(m_state->Mutex);
+
+        size_t count = std::min(max_count, m_state->Completed.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            results.emplace_back(std::move(m_state->Completed.front()));
+            m_state->Completed.pop_front();
+        }
+        return count;
+    }
+
+    void TextureDecodePool::Release(size_t byte_size)
+    {
+        std::vector<PendingDecode> dispatchable;
+        {
+            std::lock_guard l(m_state->Mutex);
+            m_state->InFlightBytes -= std::min(m_state->InFlightBytes, byte_size);
+            dispatchable            = m_state->TakeDispatchable();
+        }
+        m_state->Dispatch(std::move(dispatchable));
+    }
+
+    void TextureDecodePool::SetCompletionCallback(std::function<void()>&& callback)
+    {
+        std::lock_guard l(m_state->Mutex);
+        m_state->OnCompleted = std::move(callback);
+    }
+
+    void TextureDecodePool::Shutdown()
+    {
+        std::unique_lock l(m_state->Mutex);
+        m_state->IsShutdown = true;
+        m_state->Pending.clear();
+        m_state->Completed.clear();
+        /*
+         * Decodes queued on the thread pool but not started yet see the flag and return, only the running ones are waited for
+         */
+        m_state->IdleCondition.wait(l, [this] { return m_state->RunningCount == 0; });
+        m_state->OnCompleted = nullptr;
+    }
+
+    bool TextureDecodePool::HasCompleted() const
+    {
+        std::lock_guard l(m_state->Mutex);
+        return !m_state->Completed.empty();
+    }
+
+    size_t TextureDecodePool::PendingCount() const
+    {
+        std::lock_guard l(m_state->Mutex);
+        return m_state->Pending.size();
+    }
+
+    size_t TextureDecodePool::InFlightByteSize() const
+    {
+        std::lock_guard l(m_state->Mutex);
+        return m_state->InFlightBytes;
+    }
+
+    size_t TextureDecodePool::Budget() const
+    {
+        return m_state->Budget;
+    }
+} // namespace ZEngine::Rendering::Textures
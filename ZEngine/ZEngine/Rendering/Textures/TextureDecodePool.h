@@ -0,0 +1,99 @@
+#pragma once
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Textures/TextureDecoder.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ZEngine::Rendering::Textures
+{
+    struct TextureDecodeRequest
+    {
+        std::string              Filename         = {};
+        /*
+         * Opaque to the pool, handed back with the result so the caller can tell which texture it belongs to
+         */
+        uint64_t                 Tag              = 0;
+        Helpers::TaskPriority    Priority         = Helpers::TaskPriority::Normal;
+        bool                     FlipVertically   = true;
+        /*
+         * The full mip chain is filtered on the decode thread too, see TextureDecoder::GenerateMipChain
+         */
+        bool                     GenerateMipChain = false;
+        Buffers::MipChainOptions MipOptions       = {};
+        /*
+         * Block compressed images come back as RGBA8 / RGBA32F, for devices that can't sample them. See TextureCompressor
+         */
+        bool                     DecompressBlocks = false;
+        /*
+         * Levels before it are dropped once decoded, see TextureDecoder::DropMipLevels. The file, or GenerateMipChain, has to
+         * provide that level
+         */
+        uint32_t                 FirstMipLevel    = 0;
+    };
+
+    struct TextureDecodeResult
+    {
+        TextureDecodeRequest Request          = {};
+        bool                 Succeeded        = false;
+        /*
+         * Share of the in-flight budget this result holds until it is given back with Release()
+         */
+        size_t               ReservedByteSize = 0;
+        DecodedImage         Image            = {};
+    };
+
+    /*
+     * Decodes image files on the shared thread pool, bounded by a memory budget.
+     *
+     * Requests wait in a queue ordered by priority, then by submission order, and are only dispatched while the bytes they
+     * are expected to produce (read from the file header) fit in the budget next to everything already in flight : decoding,
+     * or decoded and not yet released by the consumer. A request larger than the whole budget still goes through once nothing
+     * else is in flight. The order is strict, a request never overtakes one of higher priority that is waiting for room.
+     *
+     * Results are collected with PopCompleted() by a single consumer, which calls Release() once it is done with the pixels.
+     */
+    class TextureDecodePool
+    {
+    public:
+        using DecodeCallback                   = std::function<bool(std::string_view, bool, DecodedImage&)>;
+        using EstimateCallback                 = std::function<size_t(std::string_view)>;
+
+        static constexpr size_t DefaultBudget  = 256ull * 1024 * 1024;
+
+        /*
+         * max_concurrency : decodes running at once, 0 meaning half the hardware threads
+         */
+        TextureDecodePool(size_t budget = DefaultBudget, size_t max_concurrency = 0, DecodeCallback decode = TextureDecoder::Decode, EstimateCallback estimate = TextureDecoder::EstimateByteSize);
+        ~TextureDecodePool();
+
+        TextureDecodePool(const TextureDecodePool&)            = delete;
+        TextureDecodePool& operator=(const TextureDecodePool&) = delete;
+
+        void               Enqueue(TextureDecodeRequest&& request);
+        /*
+         * Appends up to max_count finished decodes to results, returns how many were appended
+         */
+        size_t             PopCompleted(std::vector<TextureDecodeResult>& results, size_t max_count = SIZE_MAX);
+        void               Release(size_t byte_size);
+        /*
+         * Invoked from a worker each time a decode completes, outside of any lock of the pool
+         */
+        void               SetCompletionCallback(std::function<void()>&& callback);
+        /*
+         * Drops the waiting requests and returns once the running decodes are over. Completed results are discarded.
+         */
+        void               Shutdown();
+
+        bool               HasCompleted() const;
+        size_t             PendingCount() const;
+        size_t             InFlightByteSize() const;
+        size_t             Budget() const;
+
+    private:
+        struct State;
+        std::shared_ptr<State> m_state;
+    };
+} // namespace ZEngine::Rendering::Textures
@@ -0,0 +1,226 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Rendering/Buffers/Bitmap.h>
+#include <Rendering/Textures/StbImageBackend.h>
+#include <Rendering/Textures/TextureDecoder.h>
+#include <Serializers/TextureAssetSerializer.h>
+#include <filesystem>
+#include <string>
+
+/*
+ * The stb_image build every stbi_* caller links against, kept scalar : it is the reference the SIMD build is held to
+ */
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_SIMD
+#include <stb/stb_image.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include <stb/stb_image_resize.h>
+#include <stb/stb_image_write.h>
+
+namespace ZEngine::Rendering::Textures
+{
+    namespace
+    {
+        const StbImageBackend ScalarBackend = {
+            .Load                      = stbi_load,
+            .LoadFloat                 = stbi_loadf,
+            .Info                      = stbi_info,
+            .Free                      = stbi_image_free,
+            .SetFlipVerticallyOnThread = stbi_set_flip_vertically_on_load_thread,
+        };
+
+        /*
+         * Environment maps from this face size up have their cubemap projection split in line tiles over the thread pool
+         */
+        constexpr int    ParallelProjectionMinFaceSize = 256;
+        constexpr size_t ParallelProjectionLineBatch   = 32;
+    } // namespace
+
+    const StbImageBackend& GetScalarStbImageBackend()
+    {
+        return ScalarBackend;
+    }
+
+    bool TextureDecoder::IsBackendAvailable(TextureDecodeBackend backend)
+    {
+        return (backend == TextureDecodeBackend::Scalar) || (GetSimdStbImageBackend() != nullptr);
+    }
+
+    TextureDecodeBackend TextureDecoder::DefaultBackend()
+    {
+        return IsBackendAvailable(TextureDecodeBackend::Simd) ? TextureDecodeBackend::Simd : TextureDecodeBackend::Scalar;
+    }
+
+    bool TextureDecoder::IsCubemapFile(std::string_view filename)
+    {
+        auto extension = std::filesystem::path(filename).extension().string();
+        return (extension == ".hdr") || (extension == ".exr");
+    }
+
+    bool TextureDecoder::IsTextureAssetFile(std::string_view filename)
+    {
+        return std::filesystem::path(filename).extension() == ".zetexture";
+    }
+
+    bool TextureDecoder::ReadHeader(std::string_view filename, DecodedImage& image)
+    {
+        std::string path(filename);
+        int         width = 0, height = 0, channel = 0;
+
+        if (IsTextureAssetFile(filename))
+        {
+            return Serializers::TextureAssetSerializer::ReadHeader(filename, image) == Serializers::TextureAssetLoadResult::SUCCESS;
+        }
+
+        image = {};
+        if (!stbi_info(path.c_str(), &width, &height, &channel))
+        {
+            return false;
+        }
+
+        if (IsCubemapFile(filename))
+        {
+            /*
+             * Faces cut out of the equirectangular map by Bitmap::EquirectangularMapToVerticalCross
+             */
+            image.Width      = static_cast<uint32_t>(width / 4);
+            image.Height     = image.Width;
+            image.LayerCount = 6;
+            image.IsCubemap  = true;
+            image.Format     = DecodedPixelFormat::RGBA32F;
+            return true;
+        }
+
+        image.Width  = static_cast<uint32_t>(width);
+        image.Height = static_cast<uint32_t>(height);
+        return true;
+    }
+
+    size_t TextureDecoder::EstimateByteSize(std::string_view filename)
+    {
+        DecodedImage image;
+        if (!ReadHeader(filename, image))
+        {
+            return 0;
+        }
+        return image.MipByteOffset(image.MipLevelCount);
+    }
+
+    bool TextureDecoder::Decode(std::string_view filename, bool flip_vertically, DecodedImage& image)
+    {
+        return DecodeWithBackend(DefaultBackend(), filename, flip_vertically, image);
+    }
+
+    bool TextureDecoder::DecodeWithBackend(TextureDecodeBackend backend, std::string_view filename, bool flip_vertically, DecodedImage& image)
+    {
+        if (IsTextureAssetFile(filename))
+        {
+            return Serializers::TextureAssetSerializer::Load(filename, image) == Serializers::TextureAssetLoadResult::SUCCESS;
+        }
+
+        const StbImageBackend* stb = (backend == TextureDecodeBackend::Simd) ? GetSimdStbImageBackend() : &GetScalarStbImageBackend();
+        if (!stb)
+        {
+            stb = &GetScalarStbImageBackend();
+        }
+
+        std::string path(filename);
+        int         width = 0, height = 0, channel = 0;
+
+        image = {};
+        stb->SetFlipVerticallyOnThread(flip_vertically ? 1 : 0);
+
+        if (IsCubemapFile(filename))
+        {
+            float* data = stb->LoadFloat(path.c_str(), &width, &height, &channel, STBI_rgb_alpha);
+            if (!data)
+            {
+                return false;
+            }
+
+            Buffers::Bitmap equirectangular = {width, height, 4, Buffers::BitmapFormat::FLOAT, data};
+            stb->Free(data);
+
+            /*
+             * The HDR stream itself decodes sequentially, the projection is what dominates and every line of it is independent
+             */
+            Buffers::Bitmap vertical_cross  = Buffers::Bitmap::CreateVerticalCross(equirectangular);
+            size_t          line_count      = Buffers::Bitmap::VerticalCrossLineCount(equirectangular);
+            if ((width / 4) >= ParallelProjectionMinFaceSize)
+            {
+                Helpers::ThreadPoolHelper::ParallelFor(line_count, ParallelProjectionLineBatch, [&](size_t begin, size_t end) { Buffers::Bitmap::EquirectangularMapToVerticalCross(equirectangular, vertical_cross, begin, end); });
+            }
+            else
+            {
+                Buffers::Bitmap::EquirectangularMapToVerticalCross(equirectangular, vertical_cross, 0, line_count);
+            }
+            Buffers::Bitmap cubemap = Buffers::Bitmap::VerticalCrossToCubemap(vertical_cross);
+
+            image.Width             = cubemap.Width;
+            image.Height            = cubemap.Height;
+            image.LayerCount        = 6;
+            image.IsCubemap         = true;
+            image.Format            = DecodedPixelFormat::RGBA32F;
+            image.Pixels            = std::move(cubemap.Buffer);
+            return true;
+        }
+
+        /*
+         * stb expands grey, grey-alpha and RGB to RGBA itself, a missing alpha channel reads as opaque
+         */
+        uint8_t* data = stb->Load(path.c_str(), &width, &height, &channel, STBI_rgb_alpha);
+        if (!data)
+        {
+            return false;
+        }
+
+        image.Width      = static_cast<uint32_t>(width);
+        image.Height     = static_cast<uint32_t>(height);
+        image.LayerCount = 1;
+        image.Format     = DecodedPixelFormat::RGBA8;
+        image.Pixels.assign(data, data + size_t(width) * size_t(height) * 4);
+        stb->Free(data);
+        return true;
+    }
+
+    bool TextureDecoder::GenerateMipChain(DecodedImage& image, const Buffers::MipChainOptions& options)
+    {
+        if (image.IsCubemap || (image.LayerCount != 1) || (image.MipLevelCount != 1) || (image.Format != DecodedPixelFormat::RGBA8) || image.Pixels.empty())
+        {
+            return false;
+        }
+
+        Buffers::Bitmap level_0;
+        level_0.Width   = int(image.Width);
+        level_0.Height  = int(image.Height);
+        level_0.Channel = 4;
+        level_0.Format  = Buffers::BitmapFormat::UNSIGNED_BYTE;
+        level_0.Buffer  = std::move(image.Pixels);
+
+        auto levels  = Buffers::Bitmap::GenerateMipChain(level_0, options);
+        image.Pixels = std::move(level_0.Buffer);
+        image.Pixels.reserve(image.MipByteOffset(uint32_t(levels.size()) + 1));
+        for (const auto& level : levels)
+        {
+            image.Pixels.insert(image.Pixels.end(), level.Buffer.begin(), level.Buffer.end());
+        }
+        image.MipLevelCount = uint32_t(levels.size()) + 1;
+        return true;
+    }
+
+    bool TextureDecoder::DropMipLevels(DecodedImage& image, uint32_t first_level)
+    {
+        if ((first_level >= image.MipLevelCount) || (image.Pixels.size() != image.MipByteOffset(image.MipLevelCount)))
+        {
+            return false;
+        }
+
+        image.Pixels.erase(image.Pixels.begin(), image.Pixels.begin() + image.MipByteOffset(first_level));
+        image.Width          = std::max(image.Width >> first_level, 1u);
+        image.Height         = std::max(image.Height >> first_level, 1u);
+        image.MipLevelCount -= first_level;
+        return true;
+    }
+} // namespace ZEngine::Rendering::Textures
@@ -0,0 +1,157 @@
+#pragma once
+#include <Rendering/Buffers/Bitmap.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ZEngine::Rendering::Textures
+{
+    enum class DecodedPixelFormat : uint8_t
+    {
+        RGBA8,
+        RGBA32F,
+        /*
+         * Block compressed, 4x4 texel blocks : read from .zetexture containers, see TextureCompressor
+         */
+        BC1,
+        BC3,
+        BC4,
+        BC5,
+        BC6H,
+        BC7
+    };
+
+    constexpr bool IsBlockCompressed(DecodedPixelFormat format)
+    {
+        return (format != DecodedPixelFormat::RGBA8) && (format != DecodedPixelFormat::RGBA32F);
+    }
+
+    /*
+     * Byte size of one 4x4 block, 0 for uncompressed formats
+     */
+    constexpr size_t BlockByteSize(DecodedPixelFormat format)
+    {
+        switch (format)
+        {
+            case DecodedPixelFormat::BC1:
+            case DecodedPixelFormat::BC4:
+                return 8;
+            case DecodedPixelFormat::BC3:
+            case DecodedPixelFormat::BC5:
+            case DecodedPixelFormat::BC6H:
+            case DecodedPixelFormat::BC7:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    enum class TextureDecodeBackend : uint8_t
+    {
+        /*
+         * Portable reference build, the results every other backend must reproduce exactly
+         */
+        Scalar,
+        /*
+         * SSE2 or NEON kernels, picked at runtime when the CPU supports them
+         */
+        Simd
+    };
+
+    /*
+     * CPU side result of a decode, always four channels unless block compressed. Cubemaps hold their 6 faces one after the
+     * other, mip chains their levels one after the other from the largest (each level holding all the faces)
+     */
+    struct DecodedImage
+    {
+        uint32_t             Width         = 0;
+        uint32_t             Height        = 0;
+        uint32_t             LayerCount    = 1;
+        uint32_t             MipLevelCount = 1;
+        bool                 IsCubemap     = false;
+        /*
+         * Color space the blocks were encoded for. Only containers carry it, the loader decides for decoded files
+         */
+        bool                 IsSrgb        = false;
+        DecodedPixelFormat   Format        = DecodedPixelFormat::RGBA8;
+        std::vector<uint8_t> Pixels        = {};
+
+        size_t               ByteSize() const
+        {
+            return Pixels.size();
+        }
+
+        size_t               BytePerPixel() const
+        {
+            return (Format == DecodedPixelFormat::RGBA32F) ? 4 * sizeof(float) : 4;
+        }
+
+        size_t               LevelByteSize(uint32_t level) const
+        {
+            size_t width  = std::max(Width >> level, 1u);
+            size_t height = std::max(Height >> level, 1u);
+            if (IsBlockCompressed(Format))
+            {
+                return ((width + 3) / 4) * ((height + 3) / 4) * LayerCount * BlockByteSize(Format);
+            }
+            return width * height * LayerCount * BytePerPixel();
+        }
+
+        size_t               MipByteOffset(uint32_t level) const
+        {
+            size_t offset = 0;
+            for (uint32_t i = 0; i < level; ++i)
+            {
+                offset += LevelByteSize(i);
+            }
+            return offset;
+        }
+    };
+
+    /*
+     * Image file decoding, free of any device state. Every call carries its own options : nothing is shared between
+     * concurrent decodes (stb's flip flag is set per thread), so it can run on any number of threads at once.
+     */
+    struct TextureDecoder
+    {
+        /*
+         * Equirectangular environment maps (.hdr, .exr) are decoded as float cubemaps
+         */
+        static bool                 IsCubemapFile(std::string_view filename);
+        /*
+         * Block compressed .zetexture containers, loaded as they are stored : already flipped, mip chain included
+         */
+        static bool                 IsTextureAssetFile(std::string_view filename);
+        /*
+         * Fills everything but the pixels from the file header only : the shape Decode() will produce
+         */
+        static bool                 ReadHeader(std::string_view filename, DecodedImage& image);
+        /*
+         * Byte size the decode will produce, 0 when the file can't be read
+         */
+        static size_t               EstimateByteSize(std::string_view filename);
+        /*
+         * Decodes with DefaultBackend()
+         */
+        static bool                 Decode(std::string_view filename, bool flip_vertically, DecodedImage& image);
+        /*
+         * Falls back to the scalar backend when the requested one is unavailable
+         */
+        static bool                 DecodeWithBackend(TextureDecodeBackend backend, std::string_view filename, bool flip_vertically, DecodedImage& image);
+        /*
+         * Appends the levels after the first to a single level RGBA8 2D image, see Buffers::Bitmap::GenerateMipChain
+         */
+        static bool                 GenerateMipChain(DecodedImage& image, const Buffers::MipChainOptions& options);
+        /*
+         * Keeps the levels from first_level on : the image becomes the size of that level. False when it has no such level
+         */
+        static bool                 DropMipLevels(DecodedImage& image, uint32_t first_level);
+        static bool                 IsBackendAvailable(TextureDecodeBackend backend);
+        /*
+         * The SIMD backend when available, the scalar one otherwise
+         */
+        static TextureDecodeBackend DefaultBackend();
+    };
+} // namespace ZEngine::Rendering::Textures
@@ -0,0 +1,272 @@
+#include <pch.h>
+#include <Rendering/Textures/TextureStreamer.h>
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace ZEngine::Rendering::Textures
+{
+    TextureStreamer::TextureStreamer(const TextureStreamingOptions& options) : m_options(options) {}
+
+    void TextureStreamer::SetOptions(const TextureStreamingOptions& options)
+    {
+        m_options = options;
+    }
+
+    const TextureStreamingOptions& TextureStreamer::Options() const
+    {
+        return m_options;
+    }
+
+    uint32_t TextureStreamer::TailFirstLevel(const DecodedImage& shape) const
+    {
+        uint32_t level = 0;
+        while ((level + 1 < shape.MipLevelCount) && (std::max(shape.Width >> level, shape.Height >> level) > m_options.TailSize))
+        {
+            level++;
+        }
+        return level;
+    }
+
+    void TextureStreamer::Register(uint32_t key, const DecodedImage& shape)
+    {
+        Unregister(key);
+
+        StreamedTextureState texture = {.Shape = shape, .TailFirstLevel = TailFirstLevel(shape), .ResidentFirstLevel = shape.MipLevelCount, .TargetFirstLevel = shape.MipLevelCount};
+        texture.Shape.Pixels         = {};
+        texture.RequestedFirstLevel  = texture.TailFirstLevel;
+        SetTarget(texture, texture.TailFirstLevel);
+        m_textures.emplace(key, std::move(texture));
+    }
+
+    void TextureStreamer::Unregister(uint32_t key)
+    {
+        auto it = m_textures.find(key);
+        if (it != m_textures.end())
+        {
+            m_committed_byte_size -= LevelsByteSize(it->second.Shape, it->second.TargetFirstLevel);
+            m_textures.erase(it);
+        }
+    }
+
+    void TextureStreamer::ReportUsage(uint32_t key, float screen_size)
+    {
+        auto it = m_textures.find(key);
+        if (it == m_textures.end())
+        {
+            return;
+        }
+
+        auto&    texture = it->second;
+        uint32_t level   = std::min(SelectFirstLevel(texture.Shape, screen_size), texture.TailFirstLevel);
+        if (texture.LastUsedFrame != m_frame)
+        {
+            texture.LastUsedFrame       = m_frame;
+            texture.RequestedFirstLevel = level;
+        }
+        else
+        {
+            texture.RequestedFirstLevel = std::min(texture.RequestedFirstLevel, level);
+        }
+    }
+
+    void TextureStreamer::OnResident(uint32_t key)
+    {
+        auto it = m_textures.find(key);
+        if (it != m_textures.end())
+        {
+            it->second.ResidentFirstLevel = it->second.TargetFirstLevel;
+        }
+    }
+
+    void TextureStreamer::OnFailed(uint32_t key)
+    {
+        auto it = m_textures.find(key);
+        if ((it == m_textures.end()) || !it->second.IsPending())
+        {
+            return;
+        }
+
+        /*
+         * A tail that failed to load stays accounted for : the texture has nothing else to fall back to
+         */
+        auto& texture = it->second;
+        if (texture.ResidentFirstLevel < texture.Shape.MipLevelCount)
+        {
+            SetTarget(texture, texture.ResidentFirstLevel);
+        }
+    }
+
+    void TextureStreamer::Update(std::vector<TextureStreamingAction>& actions)
+    {
+        /*
+         * A lowered budget first
+         */
+        Evict(m_options.BudgetByteSize, std::numeric_limits<uint32_t>::max(), actions);
+
+        std::vector<std::pair<uint32_t, StreamedTextureState*>> loads;
+        for (auto& [key, texture] : m_textures)
+        {
+            if ((texture.LastUsedFrame == m_frame) && !texture.IsPending() && (texture.RequestedFirstLevel < texture.ResidentFirstLevel))
+            {
+                loads.emplace_back(key, &texture);
+            }
+        }
+
+        /*
+         * The textures missing the most levels first
+         */
+        std::sort(loads.begin(), loads.end(), [](const auto& lhs, const auto& rhs) {
+            uint32_t lhs_missing = lhs.second->ResidentFirstLevel - lhs.second->RequestedFirstLevel;
+            uint32_t rhs_missing = rhs.second->ResidentFirstLevel - rhs.second->RequestedFirstLevel;
+            return std::tie(rhs_missing, lhs.first) < std::tie(lhs_missing, rhs.first);
+        });
+
+        uint32_t load_count = 0;
+        for (auto& [key, texture] : loads)
+        {
+            if (load_count == m_options.MaxLoadsPerUpdate)
+            {
+                break;
+            }
+
+            /*
+             * Evictions may have left it pending. Short of room for what it asked, a coarser level still helps
+             */
+            if (texture->IsPending())
+            {
+                continue;
+            }
+
+            uint64_t resident_size = LevelsByteSize(texture->Shape, texture->ResidentFirstLevel);
+            for (uint32_t level = texture->RequestedFirstLevel; level < texture->ResidentFirstLevel; ++level)
+            {
+                if (MakeRoom(LevelsByteSize(texture->Shape, level) - resident_size, key, actions))
+                {
+                    SetTarget(*texture, level);
+                    actions.push_back({.Key = key, .FirstLevel = level});
+                    load_count++;
+                    break;
+                }
+            }
+        }
+
+        m_frame++;
+    }
+
+    const StreamedTextureState* TextureStreamer::Find(uint32_t key) const
+    {
+        auto it = m_textures.find(key);
+        return (it != m_textures.end()) ? &(it->second) : nullptr;
+    }
+
+    uint64_t TextureStreamer::CommittedByteSize() const
+    {
+        return m_committed_byte_size;
+    }
+
+    uint64_t TextureStreamer::Frame() const
+    {
+        return m_frame;
+    }
+
+    uint32_t TextureStreamer::SelectFirstLevel(const DecodedImage& shape, float screen_size)
+    {
+        uint32_t level = 0;
+        while ((level + 1 < shape.MipLevelCount) && (float(std::max(shape.Width >> (level + 1), shape.Height >> (level + 1))) >= screen_size))
+        {
+            level++;
+        }
+        return level;
+    }
+
+    uint64_t TextureStreamer::LevelsByteSize(const DecodedImage& shape, uint32_t first_level)
+    {
+        return shape.MipByteOffset(shape.MipLevelCount) - shape.MipByteOffset(std::min(first_level, shape.MipLevelCount));
+    }
+
+    bool TextureStreamer::MakeRoom(uint64_t byte_size, uint32_t excluded_key, std::vector<TextureStreamingAction>& actions)
+    {
+        if (m_committed_byte_size + byte_size <= m_options.BudgetByteSize)
+        {
+            return true;
+        }
+        if (byte_size > m_options.BudgetByteSize)
+        {
+            return false;
+        }
+
+        uint64_t evictable_size = 0;
+        for (const auto& [key, texture] : m_textures)
+        {
+            uint32_t floor = EvictionFloor(texture);
+            if ((key != excluded_key) && !texture.IsPending() && (texture.TargetFirstLevel < floor))
+            {
+                evictable_size += LevelsByteSize(texture.Shape, texture.TargetFirstLevel) - LevelsByteSize(texture.Shape, floor);
+            }
+        }
+
+        if (m_committed_byte_size - evictable_size + byte_size > m_options.BudgetByteSize)
+        {
+            return false;
+        }
+
+        Evict(m_options.BudgetByteSize - byte_size, excluded_key, actions);
+        return true;
+    }
+
+    void TextureStreamer::Evict(uint64_t budget, uint32_t excluded_key, std::vector<TextureStreamingAction>& actions)
+    {
+        if (m_committed_byte_size <= budget)
+        {
+            return;
+        }
+
+        std::vector<std::pair<uint32_t, StreamedTextureState*>> candidates;
+        for (auto& [key, texture] : m_textures)
+        {
+            if ((key != excluded_key) && !texture.IsPending() && (texture.TargetFirstLevel < EvictionFloor(texture)))
+            {
+                candidates.emplace_back(key, &texture);
+            }
+        }
+
+        /*
+         * Least recently used first
+         */
+        std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) { return std::tie(lhs.second->LastUsedFrame, lhs.first) < std::tie(rhs.second->LastUsedFrame, rhs.first); });
+
+        for (auto& [key, texture] : candidates)
+        {
+            if (m_committed_byte_size <= budget)
+            {
+                break;
+            }
+
+            /*
+             * Largest level first, only what the budget needs
+             */
+            uint32_t level = texture->TargetFirstLevel;
+            uint32_t floor = EvictionFloor(*texture);
+            while ((level < floor) && (m_committed_byte_size - (LevelsByteSize(texture->Shape, texture->TargetFirstLevel) - LevelsByteSize(texture->Shape, level)) > budget))
+            {
+                level++;
+            }
+
+            SetTarget(*texture, level);
+            actions.push_back({.Key = key, .FirstLevel = level});
+        }
+    }
+
+    uint32_t TextureStreamer::EvictionFloor(const StreamedTextureState& texture) const
+    {
+        return (texture.LastUsedFrame == m_frame) ? texture.RequestedFirstLevel : texture.TailFirstLevel;
+    }
+
+    void TextureStreamer::SetTarget(StreamedTextureState& texture, uint32_t first_level)
+    {
+        m_committed_byte_size   -= LevelsByteSize(texture.Shape, texture.TargetFirstLevel);
+        texture.TargetFirstLevel = first_level;
+        m_committed_byte_size   += LevelsByteSize(texture.Shape, texture.TargetFirstLevel);
+    }
+} // namespace ZEngine::Rendering::Textures
@@ -0,0 +1,145 @@
+#pragma once
+#include <Rendering/Textures/TextureDecoder.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ZEngine::Rendering::Textures
+{
+    struct TextureStreamingOptions
+    {
+        /*
+         * Bytes the streamed levels may take on the device. Tails are never evicted : on their own, they can go over it
+         */
+        uint64_t BudgetByteSize    = 512ull * 1024 * 1024;
+        /*
+         * Levels whose largest side is at most that many texels make the tail of a texture : loaded first, always resident
+         */
+        uint32_t TailSize          = 64;
+        /*
+         * Loads an Update() starts at most, evictions aren't limited
+         */
+        uint32_t MaxLoadsPerUpdate = 4;
+    };
+
+    /*
+     * Levels [FirstLevel, MipLevelCount) of the texture become resident : its larger levels are loaded, or evicted
+     */
+    struct TextureStreamingAction
+    {
+        uint32_t Key        = 0;
+        uint32_t FirstLevel = 0;
+    };
+
+    /*
+     * Screen size, in pixels, a texture is drawn at : its largest side on screen, assuming it is mapped once over its mesh
+     */
+    struct TextureUsageReport
+    {
+        uint32_t Key        = 0;
+        float    ScreenSize = 0.0f;
+    };
+
+    struct StreamedTextureState
+    {
+        /*
+         * Full mip chain, no pixels
+         */
+        DecodedImage Shape               = {};
+        uint32_t     TailFirstLevel      = 0;
+        /*
+         * First level on the device, MipLevelCount while nothing is
+         */
+        uint32_t     ResidentFirstLevel  = 0;
+        /*
+         * First level once the last action issued lands, it is what the budget accounts for
+         */
+        uint32_t     TargetFirstLevel    = 0;
+        /*
+         * Finest level asked by the usage reports of LastUsedFrame
+         */
+        uint32_t     RequestedFirstLevel = 0;
+        /*
+         * 0 when never reported
+         */
+        uint64_t     LastUsedFrame       = 0;
+
+        bool         IsPending() const
+        {
+            return ResidentFirstLevel != TargetFirstLevel;
+        }
+    };
+
+    /*
+     * Residency policy of the streamed textures, free of any device state : the loader applies the actions it issues.
+     *
+     * A texture starts with its tail only. Every frame, each visible texture reports the screen size it covers and asks for the
+     * coarsest level still holding a texel per pixel. Update() then loads the textures missing the most levels first, while
+     * their bytes fit in the budget, and makes room by evicting the largest levels of the least recently used textures : those
+     * unused this frame down to their tail, those in use down to what they asked for. A texture has one action in flight at
+     * most. Ties are broken by key, the same reports always produce the same actions.
+     */
+    class TextureStreamer
+    {
+    public:
+        TextureStreamer(const TextureStreamingOptions& options = {});
+
+        /*
+         * A smaller budget is enforced by the next Update()
+         */
+        void                           SetOptions(const TextureStreamingOptions& options);
+        const TextureStreamingOptions& Options() const;
+        uint32_t                       TailFirstLevel(const DecodedImage& shape) const;
+        /*
+         * shape holds the full mip chain. The texture starts pending on its tail, the caller loads it
+         */
+        void                           Register(uint32_t key, const DecodedImage& shape);
+        void                           Unregister(uint32_t key);
+        /*
+         * The texture covers screen_size pixels this frame, several reports keep the largest. Unknown keys are ignored
+         */
+        void                           ReportUsage(uint32_t key, float screen_size);
+        /*
+         * The last action issued for the texture landed, or failed and it keeps what it had
+         */
+        void                           OnResident(uint32_t key);
+        void                           OnFailed(uint32_t key);
+        /*
+         * Closes the frame : appends the actions to issue to actions, in issue order
+         */
+        void                           Update(std::vector<TextureStreamingAction>& actions);
+
+        const StreamedTextureState*    Find(uint32_t key) const;
+        /*
+         * Bytes of the target levels of every texture
+         */
+        uint64_t                       CommittedByteSize() const;
+        uint64_t                       Frame() const;
+
+        /*
+         * Coarsest level of shape whose largest side still covers screen_size pixels
+         */
+        static uint32_t                SelectFirstLevel(const DecodedImage& shape, float screen_size);
+        /*
+         * Bytes of levels [first_level, MipLevelCount)
+         */
+        static uint64_t                LevelsByteSize(const DecodedImage& shape, uint32_t first_level);
+
+    private:
+        /*
+         * Evicts until byte_size more fits in the budget, nothing when it can't fit. excluded_key is left alone
+         */
+        bool                                               MakeRoom(uint64_t byte_size, uint32_t excluded_key, std::vector<TextureStreamingAction>& actions);
+        void                                               Evict(uint64_t budget, uint32_t excluded_key, std::vector<TextureStreamingAction>& actions);
+        /*
+         * Coarsest level eviction leaves the texture with
+         */
+        uint32_t                                           EvictionFloor(const StreamedTextureState& texture) const;
+        void                                               SetTarget(StreamedTextureState& texture, uint32_t first_level);
+
+        TextureStreamingOptions                            m_options;
+        std::unordered_map<uint32_t, StreamedTextureState> m_textures;
+        uint64_t                                           m_committed_byte_size = 0;
+        uint64_t                                           m_frame               = 1;
+    };
+} // namespace ZEngine::Rendering::Textures
@@ -0,0 +1,447 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Serializers/AssetContainer.h>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
+using namespace ZEngine::Helpers;
+
+namespace ZEngine::Serializers
+{
+    namespace
+    {
+        constexpr uint64_t Prime64_1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t Prime64_3 = 0x165667B19E3779F9ULL;
+        constexpr uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64_t Prime64_5 = 0x27D4EB2F165667C5ULL;
+
+        inline uint64_t RotateLeft(uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        inline uint64_t Read64(const std::byte* data)
+        {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        inline uint32_t Read32(const std::byte* data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        inline uint64_t Round(uint64_t accumulator, uint64_t input)
+        {
+            accumulator += input * Prime64_2;
+            accumulator  = RotateLeft(accumulator, 31);
+            return accumulator * Prime64_1;
+        }
+
+        inline uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+        {
+            accumulator ^= Round(0, value);
+            return accumulator * Prime64_1 + Prime64_4;
+        }
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        uint64_t ComputeHeaderChecksum(AssetContainerHeader header)
+        {
+            header.HeaderChecksum = 0;
+            return AssetContainer::ComputeChecksum(std::as_bytes(std::span{&header, 1}));
+        }
+    } // namespace
+
+    uint64_t AssetContainer::ComputeChecksum(std::span<const std::byte> bytes, uint64_t seed)
+    {
+        const std::byte* data = bytes.data();
+        const std::byte* end  = data + bytes.size();
+        uint64_t         hash = 0;
+
+        if (bytes.size() >= 32)
+        {
+            uint64_t         v1    = seed + Prime64_1 + Prime64_2;
+            uint64_t         v2    = seed + Prime64_2;
+            uint64_t         v3    = seed;
+            uint64_t         v4    = seed - Prime64_1;
+            const std::byte* limit = end - 32;
+            do
+            {
+                v1    = Round(v1, Read64(data));
+                v2    = Round(v2, Read64(data + 8));
+                v3    = Round(v3, Read64(data + 16));
+                v4    = Round(v4, Read64(data + 24));
+                data += 32;
+            } while (data <= limit);
+
+            hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else
+        {
+            hash = seed + Prime64_5;
+        }
+
+        hash += static_cast<uint64_t>(bytes.size());
+
+        for (; data + 8 <= end; data += 8)
+        {
+            hash ^= Round(0, Read64(data));
+            hash  = RotateLeft(hash, 27) * Prime64_1 + Prime64_4;
+        }
+
+        if (data + 4 <= end)
+        {
+            hash ^= static_cast<uint64_t>(Read32(data)) * Prime64_1;
+            hash  = RotateLeft(hash, 23) * Prime64_2 + Prime64_3;
+            data += 4;
+        }
+
+        for (; data < end; ++data)
+        {
+            hash ^= static_cast<uint64_t>(*data) * Prime64_5;
+            hash  = RotateLeft(hash, 11) * Prime64_1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= Prime64_2;
+        hash ^= hash >> 29;
+        hash *= Prime64_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    std::string_view AssetContainer::ToString(AssetContainerResult result)
+    {
+        switch (result)
+        {
+            case AssetContainerResult::SUCCESS:
+                return "success";
+            case AssetContainerResult::IO_ERROR:
+                return "the file can't be read or written";
+            case AssetContainerResult::INVALID_MAGIC:
+                return "not an asset container";
+            case AssetContainerResult::UNSUPPORTED_VERSION:
+                return "unsupported container version";
+            case AssetContainerResult::TRUNCATED:
+                return "the container is truncated";
+            case AssetContainerResult::CORRUPTED_HEADER:
+                return "the container header is corrupted";
+            case AssetContainerResult::CORRUPTED_SECTION_TABLE:
+                return "the container section table is corrupted";
+            case AssetContainerResult::CORRUPTED_SECTION:
+                return "a container section is corrupted";
+        }
+        return "unknown error";
+    }
+
+    void AssetContainerWriter::AddSection(uint32_t tag, uint32_t element_byte_size, uint64_t element_count, const void* data)
+    {
+        m_sections.push_back(PendingSection{.Tag = tag, .ElementByteSize = element_byte_size, .ElementCount = (data ? element_count : 0), .Data = data});
+    }
+
+    void AssetContainerWriter::AddStringArray(uint32_t tag, std::span<const std::string> strings)
+    {
+        std::vector<uint32_t> offsets = {0};
+        for (const auto& string : strings)
+        {
+            offsets.push_back(offsets.back() + static_cast<uint32_t>(string.size()));
+        }
+
+        uint32_t               count = static_cast<uint32_t>(strings.size());
+        std::vector<std::byte> packed(sizeof(uint32_t) * (1 + offsets.size()) + offsets.back());
+        std::byte*             out   = packed.data();
+        std::memcpy(out, &count, sizeof(uint32_t));
+        std::memcpy(out + sizeof(uint32_t), offsets.data(), sizeof(uint32_t) * offsets.size());
+        out += sizeof(uint32_t) * (1 + offsets.size());
+        for (const auto& string : strings)
+        {
+            std::memcpy(out, string.data(), string.size());
+            out += string.size();
+        }
+
+        m_sections.push_back(PendingSection{.Tag = tag, .ElementByteSize = 1, .ElementCount = packed.size(), .OwnedIndex = m_owned_data.size()});
+        m_owned_data.emplace_back(std::move(packed));
+    }
+
+    const std::byte* AssetContainerWriter::SectionData(const PendingSection& section) const
+    {
+        return (section.OwnedIndex != SIZE_MAX) ? m_owned_data[section.OwnedIndex].data() : static_cast<const std::byte*>(section.Data);
+    }
+
+    void AssetContainerWriter::BuildLayout(AssetContainerHeader& header, std::vector<AssetContainerSection>& table) const
+    {
+        table.resize(m_sections.size());
+
+        uint64_t offset = AlignUp(sizeof(AssetContainerHeader) + sizeof(AssetContainerSection) * m_sections.size(), AssetContainer::SectionAlignment);
+        for (size_t i = 0; i < m_sections.size(); ++i)
+        {
+            const auto& pending     = m_sections[i];
+            auto&       section     = table[i];
+            section.Tag             = pending.Tag;
+            section.ElementByteSize = pending.ElementByteSize;
+            section.ElementCount    = pending.ElementCount;
+            section.Offset          = offset;
+            section.ByteSize        = pending.ElementCount * pending.ElementByteSize;
+            offset                  = AlignUp(offset + section.ByteSize, AssetContainer::SectionAlignment);
+        }
+
+        ThreadPoolHelper::ParallelFor(table.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                table[i].Checksum = AssetContainer::ComputeChecksum({SectionData(m_sections[i]), static_cast<size_t>(table[i].ByteSize)});
+            }
+        });
+
+        header                      = {};
+        header.Magic                = AssetContainer::Magic;
+        header.VersionMajor         = AssetContainer::VersionMajor;
+        header.VersionMinor         = AssetContainer::VersionMinor;
+        header.HeaderByteSize       = sizeof(AssetContainerHeader);
+        header.SectionCount         = static_cast<uint32_t>(table.size());
+        header.SectionTableOffset   = sizeof(AssetContainerHeader);
+        header.FileByteSize         = table.empty() ? header.SectionTableOffset : (table.back().Offset + table.back().ByteSize);
+        header.SectionTableChecksum = AssetContainer::ComputeChecksum(std::as_bytes(std::span{table}));
+        header.HeaderChecksum       = ComputeHeaderChecksum(header);
+    }
+
+    AssetContainerResult AssetContainerWriter::WriteToFile(std::string_view filename) const
+    {
+        AssetContainerHeader               header = {};
+        std::vector<AssetContainerSection> table  = {};
+        BuildLayout(header, table);
+
+        std::ofstream out(std::string(filename), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            return AssetContainerResult::IO_ERROR;
+        }
+
+        const char padding[AssetContainer::SectionAlignment] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()), sizeof(AssetContainerSection) * table.size());
+
+        uint64_t position = sizeof(header) + sizeof(AssetContainerSection) * table.size();
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            out.write(padding, table[i].Offset - position);
+            out.write(reinterpret_cast<const char*>(SectionData(m_sections[i])), table[i].ByteSize);
+            position = table[i].Offset + table[i].ByteSize;
+        }
+
+        out.close();
+        return out ? AssetContainerResult::SUCCESS : AssetContainerResult::IO_ERROR;
+    }
+
+    std::vector<std::byte> AssetContainerWriter::WriteToMemory() const
+    {
+        AssetContainerHeader               header = {};
+        std::vector<AssetContainerSection> table  = {};
+        BuildLayout(header, table);
+
+        std::vector<std::byte> bytes(header.FileByteSize);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + header.SectionTableOffset, table.data(), sizeof(AssetContainerSection) * table.size());
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            if (table[i].ByteSize > 0)
+            {
+                std::memcpy(bytes.data() + table[i].Offset, SectionData(m_sections[i]), table[i].ByteSize);
+            }
+        }
+        return bytes;
+    }
+
+    AssetContainerResult AssetContainerReader::Open(std::string_view filename, bool verify_sections)
+    {
+        Close();
+        if (!m_file.Open(filename))
+        {
+            return AssetContainerResult::IO_ERROR;
+        }
+
+        m_bytes     = m_file.Bytes();
+        auto result = Parse(verify_sections);
+        if (result != AssetContainerResult::SUCCESS)
+        {
+            Close();
+        }
+        return result;
+    }
+
+    AssetContainerResult AssetContainerReader::Open(std::span<const std::byte> bytes, bool verify_sections)
+    {
+        Close();
+
+        m_bytes     = bytes;
+        auto result = Parse(verify_sections);
+        if (result != AssetContainerResult::SUCCESS)
+        {
+            Close();
+        }
+        return result;
+    }
+
+    void AssetContainerReader::Close()
+    {
+        m_file.Close();
+        m_bytes    = {};
+        m_sections = {};
+        m_header   = {};
+    }
+
+    AssetContainerResult AssetContainerReader::Parse(bool verify_sections)
+    {
+        if (m_bytes.size() < sizeof(AssetContainerHeader))
+        {
+            return (m_bytes.size() >= sizeof(uint32_t)) && (Read32(m_bytes.data()) != AssetContainer::Magic) ? AssetContainerResult::INVALID_MAGIC : AssetContainerResult::TRUNCATED;
+        }
+
+        std::memcpy(&m_header, m_bytes.data(), sizeof(AssetContainerHeader));
+        if (m_header.Magic != AssetContainer::Magic)
+        {
+            return AssetContainerResult::INVALID_MAGIC;
+        }
+
+        /*
+         * The version comes before the checksum : another major version may lay its header out differently
+         */
+        if ((m_header.VersionMajor != AssetContainer::VersionMajor) || (m_header.HeaderByteSize < sizeof(AssetContainerHeader)))
+        {
+            return AssetContainerResult::UNSUPPORTED_VERSION;
+        }
+
+        if (m_header.HeaderChecksum != ComputeHeaderChecksum(m_header))
+        {
+            return AssetContainerResult::CORRUPTED_HEADER;
+        }
+
+        if (m_bytes.size() < m_header.FileByteSize)
+        {
+            return AssetContainerResult::TRUNCATED;
+        }
+
+        uint64_t table_byte_size = uint64_t(m_header.SectionCount) * sizeof(AssetContainerSection);
+        if ((m_header.SectionTableOffset % alignof(AssetContainerSection) != 0) || (m_header.SectionTableOffset > m_header.FileByteSize) || (table_byte_size > m_header.FileByteSize - m_header.SectionTableOffset))
+        {
+            return AssetContainerResult::CORRUPTED_HEADER;
+        }
+
+        auto table_bytes = m_bytes.subspan(m_header.SectionTableOffset, table_byte_size);
+        if (AssetContainer::ComputeChecksum(table_bytes) != m_header.SectionTableChecksum)
+        {
+            return AssetContainerResult::CORRUPTED_SECTION_TABLE;
+        }
+
+        m_sections = {reinterpret_cast<const AssetContainerSection*>(table_bytes.data()), m_header.SectionCount};
+        for (const auto& section : m_sections)
+        {
+            bool overflows = (section.ElementByteSize != 0) && (section.ElementCount > UINT64_MAX / section.ElementByteSize);
+            bool misaligned = (section.Offset % AssetContainer::SectionAlignment) != 0;
+            if (overflows || misaligned || (section.ByteSize != section.ElementCount * section.ElementByteSize) || (section.Offset > m_header.FileByteSize) || (section.ByteSize > m_header.FileByteSize - section.Offset))
+            {
+                return AssetContainerResult::CORRUPTED_SECTION_TABLE;
+            }
+        }
+
+        if (verify_sections)
+        {
+            std::atomic_bool corrupted{false};
+            ThreadPoolHelper::ParallelFor(m_sections.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (VerifySection(m_sections[i]) != AssetContainerResult::SUCCESS)
+                    {
+                        corrupted = true;
+                    }
+                }
+            });
+
+            if (corrupted)
+            {
+                return AssetContainerResult::CORRUPTED_SECTION;
+            }
+        }
+        return AssetContainerResult::SUCCESS;
+    }
+
+    bool AssetContainerReader::IsOpen() const
+    {
+        return !m_bytes.empty();
+    }
+
+    const AssetContainerHeader& AssetContainerReader::Header() const
+    {
+        return m_header;
+    }
+
+    std::span<const AssetContainerSection> AssetContainerReader::Sections() const
+    {
+        return m_sections;
+    }
+
+    const AssetContainerSection* AssetContainerReader::FindSection(uint32_t tag) const
+    {
+        for (const auto& section : m_sections)
+        {
+            if (section.Tag == tag)
+            {
+                return &section;
+            }
+        }
+        return nullptr;
+    }
+
+    AssetContainerResult AssetContainerReader::VerifySection(const AssetContainerSection& section) const
+    {
+        return (AssetContainer::ComputeChecksum(SectionBytes(section)) == section.Checksum) ? AssetContainerResult::SUCCESS : AssetContainerResult::CORRUPTED_SECTION;
+    }
+
+    std::span<const std::byte> AssetContainerReader::SectionBytes(const AssetContainerSection& section) const
+    {
+        return m_bytes.subspan(section.Offset, section.ByteSize);
+    }
+
+    bool AssetContainerReader::ReadStringArray(uint32_t tag, std::vector<std::string>& strings) const
+    {
+        auto bytes = GetSection<std::byte>(tag);
+        if (bytes.size() < sizeof(uint32_t))
+        {
+            return false;
+        }
+
+        uint32_t count = Read32(bytes.data());
+        if ((uint64_t(count) + 2) * sizeof(uint32_t) > bytes.size())
+        {
+            return false;
+        }
+
+        auto characters = bytes.subspan((size_t(count) + 2) * sizeof(uint32_t));
+        strings.clear();
+        strings.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t begin = Read32(bytes.data() + sizeof(uint32_t) * (1 + i));
+            uint32_t end   = Read32(bytes.data() + sizeof(uint32_t) * (2 + i));
+            if ((begin > end) || (end > characters.size()))
+            {
+                strings.clear();
+                return false;
+            }
+            strings.emplace_back(reinterpret_cast<const char*>(characters.data()) + begin, end - begin);
+        }
+        return true;
+    }
+} // namespace ZEngine::Serializers
@@ -0,0 +1,196 @@
+#pragma once
+#include <Helpers/MemoryMappedFile.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ZEngine::Serializers
+{
+    /*
+     * Binary asset container, laid out to be memory mapped and read in place :
+     *
+     *  [Header][Section table][pad][Section 0][pad][Section 1] ... [Section N-1]
+     *
+     *  - The header identifies the file (magic + version) and carries the checksum of the section table.
+     *  - Each section is a tagged array of fixed size elements, starts on a SectionAlignment boundary and carries its own checksum.
+     *  - Readers accept any minor version of their major version and ignore the sections they don't know.
+     *  - Values are stored in the host byte order (little-endian on every platform we support).
+     */
+    constexpr uint32_t MakeSectionTag(const char (&fourcc)[5])
+    {
+        return uint32_t(uint8_t(fourcc[0])) | (uint32_t(uint8_t(fourcc[1])) << 8) | (uint32_t(uint8_t(fourcc[2])) << 16) | (uint32_t(uint8_t(fourcc[3])) << 24);
+    }
+
+    struct AssetContainerHeader
+    {
+        uint32_t Magic                = 0;
+        uint16_t VersionMajor         = 0;
+        uint16_t VersionMinor         = 0;
+        uint32_t HeaderByteSize       = 0;
+        uint32_t SectionCount         = 0;
+        uint64_t SectionTableOffset   = 0;
+        uint64_t FileByteSize         = 0;
+        uint64_t SectionTableChecksum = 0;
+        /*
+         * Checksum of the header bytes, computed with this field set to zero
+         */
+        uint64_t HeaderChecksum       = 0;
+        uint64_t _reserved[2]         = {0, 0};
+    };
+
+    struct AssetContainerSection
+    {
+        uint32_t Tag             = 0;
+        uint32_t ElementByteSize = 0;
+        uint64_t ElementCount    = 0;
+        uint64_t Offset          = 0;
+        uint64_t ByteSize        = 0;
+        uint64_t Checksum        = 0;
+        uint64_t _reserved       = 0;
+    };
+
+    static_assert(sizeof(AssetContainerHeader) == 64, "The container header layout is part of the file format");
+    static_assert(sizeof(AssetContainerSection) == 48, "The container section layout is part of the file format");
+
+    enum class AssetContainerResult
+    {
+        SUCCESS = 0,
+        IO_ERROR,
+        INVALID_MAGIC,
+        UNSUPPORTED_VERSION,
+        TRUNCATED,
+        CORRUPTED_HEADER,
+        CORRUPTED_SECTION_TABLE,
+        CORRUPTED_SECTION
+    };
+
+    struct AssetContainer
+    {
+        static constexpr uint32_t Magic               = MakeSectionTag("ZEAC");
+        static constexpr uint16_t VersionMajor        = 1;
+        static constexpr uint16_t VersionMinor        = 0;
+        /*
+         * Every section starts on a cache line, which covers the alignment of any element type we store (glm::mat4 included)
+         */
+        static constexpr uint64_t SectionAlignment    = 64;
+
+        /*
+         * 64-bit checksum of the bytes (XXH64 algorithm)
+         */
+        static uint64_t           ComputeChecksum(std::span<const std::byte> bytes, uint64_t seed = 0);
+        static std::string_view   ToString(AssetContainerResult result);
+    };
+
+    /*
+     * Collects sections and writes them as a container. Sections reference the caller memory, which must stay alive until Write*() returns
+     */
+    class AssetContainerWriter
+    {
+    public:
+        template <typename T>
+        void AddSection(uint32_t tag, std::span<const T> data)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Container sections store raw bytes");
+            AddSection(tag, sizeof(T), data.size(), data.data());
+        }
+
+        template <typename T>
+        void AddSection(uint32_t tag, const std::vector<T>& data)
+        {
+            AddSection(tag, std::span<const T>(data));
+        }
+
+        void                   AddSection(uint32_t tag, uint32_t element_byte_size, uint64_t element_count, const void* data);
+        /*
+         * Strings are packed in one section : count, count + 1 offsets, then the characters
+         */
+        void                   AddStringArray(uint32_t tag, std::span<const std::string> strings);
+
+        AssetContainerResult   WriteToFile(std::string_view filename) const;
+        std::vector<std::byte> WriteToMemory() const;
+
+    private:
+        struct PendingSection
+        {
+            uint32_t    Tag             = 0;
+            uint32_t    ElementByteSize = 0;
+            uint64_t    ElementCount    = 0;
+            const void* Data            = nullptr;
+            size_t      OwnedIndex      = SIZE_MAX;
+        };
+
+        std::vector<PendingSection>         m_sections;
+        std::vector<std::vector<std::byte>> m_owned_data;
+
+        const std::byte*                    SectionData(const PendingSection& section) const;
+        void                                BuildLayout(AssetContainerHeader& header, std::vector<AssetContainerSection>& table) const;
+    };
+
+    /*
+     * Opens a container and exposes its sections as spans pointing straight into the mapping (or the memory given to Open()).
+     * Spans stay valid until Close(), the reader is destroyed or another container is opened.
+     */
+    class AssetContainerReader
+    {
+    public:
+        AssetContainerReader() = default;
+
+        AssetContainerReader(const AssetContainerReader&)            = delete;
+        AssetContainerReader& operator=(const AssetContainerReader&) = delete;
+        AssetContainerReader(AssetContainerReader&&)                 = default;
+        AssetContainerReader& operator=(AssetContainerReader&&)      = default;
+
+        /*
+         * Section checksums cost one pass over the data, they are verified in parallel across sections when verify_sections is set.
+         * Header and section table are always verified.
+         */
+        AssetContainerResult                   Open(std::string_view filename, bool verify_sections = true);
+        /*
+         * The memory must outlive the reader and be aligned for the section element types (16 bytes covers them all)
+         */
+        AssetContainerResult                   Open(std::span<const std::byte> bytes, bool verify_sections = true);
+        void                                   Close();
+
+        bool                                   IsOpen() const;
+        const AssetContainerHeader&            Header() const;
+        std::span<const AssetContainerSection> Sections() const;
+        const AssetContainerSection*           FindSection(uint32_t tag) const;
+        AssetContainerResult                   VerifySection(const AssetContainerSection& section) const;
+        std::span<const std::byte>             SectionBytes(const AssetContainerSection& section) const;
+
+        /*
+         * Empty span when the section is missing or wasn't written with elements of type T
+         */
+        template <typename T>
+        std::span<const T> GetSection(uint32_t tag) const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Container sections store raw bytes");
+
+            const AssetContainerSection* section = FindSection(tag);
+            if (!section || (section->ElementByteSize != sizeof(T)))
+            {
+                return {};
+            }
+
+            auto bytes = SectionBytes(*section);
+            return {reinterpret_cast<const T*>(bytes.data()), static_cast<size_t>(section->ElementCount)};
+        }
+
+        /*
+         * Returns false when the section is missing or malformed
+         */
+        bool                                   ReadStringArray(uint32_t tag, std::vector<std::string>& strings) const;
+
+    private:
+        Helpers::MemoryMappedFile              m_file;
+        std::span<const std::byte>             m_bytes;
+        AssetContainerHeader                   m_header;
+        std::span<const AssetContainerSection> m_sections;
+
+        AssetContainerResult                   Parse(bool verify_sections);
+    };
+} // namespace ZEngine::Serializers
@@ -0,0 +1,106 @@
+#include <pch.h>
+#include <Serializers/PipelineCacheSerializer.h>
+#include <cstring>
+#include <filesystem>
+
+namespace ZEngine::Serializers
+{
+    namespace
+    {
+        constexpr uint32_t IdentityTag = MakeSectionTag("PCID");
+        constexpr uint32_t DataTag     = MakeSectionTag("PCDT");
+
+        /*
+         * VkPipelineCacheHeaderVersionOne, spelled out to keep the serializer free of Vulkan
+         */
+        struct DriverCacheHeader
+        {
+            uint32_t HeaderSize;
+            uint32_t HeaderVersion;
+            uint32_t VendorID;
+            uint32_t DeviceID;
+            uint8_t  PipelineCacheUUID[16];
+        };
+
+        constexpr uint32_t DriverCacheHeaderVersionOne = 1;
+    } // namespace
+
+    AssetContainerResult PipelineCacheSerializer::Write(std::string_view filename, const PipelineCacheIdentity& identity, std::span<const std::byte> data)
+    {
+        AssetContainerWriter writer;
+        writer.AddSection(IdentityTag, std::span<const PipelineCacheIdentity>(&identity, 1));
+        writer.AddSection(DataTag, data);
+
+        /*
+         * Written aside then renamed : a crash while saving leaves the previous cache in place, never a torn one
+         */
+        std::filesystem::path path      = filename;
+        std::filesystem::path temp_path = path;
+        temp_path += ".tmp";
+
+        std::error_code error;
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+
+        auto result = writer.WriteToFile(temp_path.string());
+        if (result != AssetContainerResult::SUCCESS)
+        {
+            std::filesystem::remove(temp_path, error);
+            return result;
+        }
+
+        std::filesystem::rename(temp_path, path, error);
+        if (error)
+        {
+            std::filesystem::remove(temp_path, error);
+            return AssetContainerResult::IO_ERROR;
+        }
+        return AssetContainerResult::SUCCESS;
+    }
+
+    PipelineCacheLoadResult PipelineCacheSerializer::Load(std::string_view filename, const PipelineCacheIdentity& identity, std::vector<std::byte>& data)
+    {
+        data.clear();
+
+        AssetContainerReader reader;
+        if (reader.Open(filename) != AssetContainerResult::SUCCESS)
+        {
+            return PipelineCacheLoadResult::UNAVAILABLE;
+        }
+
+        auto saved_identity = reader.GetSection<PipelineCacheIdentity>(IdentityTag);
+        auto saved_data     = reader.GetSection<std::byte>(DataTag);
+        if ((saved_identity.size() != 1) || !reader.FindSection(DataTag))
+        {
+            return PipelineCacheLoadResult::UNAVAILABLE;
+        }
+
+        if (saved_identity[0] != identity)
+        {
+            return PipelineCacheLoadResult::IDENTITY_MISMATCH;
+        }
+
+        if (!IsHeaderCompatible(saved_data, identity))
+        {
+            return PipelineCacheLoadResult::INVALID_DATA;
+        }
+
+        data.assign(saved_data.begin(), saved_data.end());
+        return PipelineCacheLoadResult::SUCCESS;
+    }
+
+    bool PipelineCacheSerializer::IsHeaderCompatible(std::span<const std::byte> data, const PipelineCacheIdentity& identity)
+    {
+        if (data.size() < sizeof(DriverCacheHeader))
+        {
+            return false;
+        }
+
+        DriverCacheHeader header;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        return (header.HeaderSize >= sizeof(DriverCacheHeader)) && (header.HeaderSize <= data.size()) && (header.HeaderVersion == DriverCacheHeaderVersionOne) && (header.VendorID == identity.VendorID) && (header.DeviceID == identity.DeviceID) && (std::memcmp(header.PipelineCacheUUID, identity.PipelineCacheUUID.data(), sizeof(header.PipelineCacheUUID)) == 0);
+    }
+} // namespace ZEngine::Serializers
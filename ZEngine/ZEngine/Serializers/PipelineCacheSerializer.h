@@ -0,0 +1,60 @@
+#pragma once
+#include <Serializers/AssetContainer.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ZEngine::Serializers
+{
+    /*
+     * What a pipeline cache blob is only valid for : the physical device and the driver build that produced it
+     */
+    struct PipelineCacheIdentity
+    {
+        uint32_t                VendorID          = 0;
+        uint32_t                DeviceID          = 0;
+        uint32_t                DriverVersion     = 0;
+        uint32_t                _reserved         = 0;
+        std::array<uint8_t, 16> PipelineCacheUUID = {};
+        std::array<uint8_t, 16> DriverUUID        = {};
+
+        bool                    operator==(const PipelineCacheIdentity&) const = default;
+    };
+
+    static_assert(sizeof(PipelineCacheIdentity) == 48, "The identity layout is part of the file format");
+
+    enum class PipelineCacheLoadResult
+    {
+        SUCCESS = 0,
+        /*
+         * No file, or a file that isn't a valid container
+         */
+        UNAVAILABLE,
+        /*
+         * Written for another device or driver : starting from an empty cache is expected
+         */
+        IDENTITY_MISMATCH,
+        /*
+         * The blob header disagrees with the identity it was saved with
+         */
+        INVALID_DATA
+    };
+
+    /*
+     * Reads and writes a .zepipelines asset container : the identity of the device next to the raw vkGetPipelineCacheData blob.
+     * The blob is only handed back when both the saved identity and the header the driver put at the start of the blob
+     * (VkPipelineCacheHeaderVersionOne) match the running device, drivers don't all reject foreign data gracefully.
+     */
+    struct PipelineCacheSerializer
+    {
+        static AssetContainerResult    Write(std::string_view filename, const PipelineCacheIdentity& identity, std::span<const std::byte> data);
+        static PipelineCacheLoadResult Load(std::string_view filename, const PipelineCacheIdentity& identity, std::vector<std::byte>& data);
+        /*
+         * Checks the VkPipelineCacheHeaderVersionOne at the start of data against the vendor, device and cache UUID of identity
+         */
+        static bool                    IsHeaderCompatible(std::span<const std::byte> data, const PipelineCacheIdentity& identity);
+    };
+} // namespace ZEngine::Serializers
@@ -0,0 +1,218 @@
+#include <pch.h>
+#include <Helpers/ThreadPool.h>
+#include <Serializers/SceneAssetSerializer.h>
+#include <atomic>
+#include <mutex>
+
+using namespace ZEngine::Helpers;
+using namespace ZEngine::Rendering::Scenes;
+
+namespace ZEngine::Serializers
+{
+    namespace
+    {
+        /*
+         * Section tags of the .zemeshes, .zematerials and .zemodel containers
+         */
+        constexpr uint32_t MeshesTag           = MakeSectionTag("MESH");
+        constexpr uint32_t IndicesTag          = MakeSectionTag("INDX");
+        constexpr uint32_t VerticesTag         = MakeSectionTag("VERT");
+        constexpr uint32_t MeshLodsTag         = MakeSectionTag("MLOD");
+        constexpr uint32_t MeshletRangesTag    = MakeSectionTag("MLRG");
+        constexpr uint32_t MeshletsTag         = MakeSectionTag("MLET");
+        constexpr uint32_t MeshletVerticesTag  = MakeSectionTag("MLVX");
+        constexpr uint32_t MeshletTrianglesTag = MakeSectionTag("MLTR");
+        constexpr uint32_t MaterialsTag        = MakeSectionTag("MATL");
+        constexpr uint32_t MaterialFilesTag    = MakeSectionTag("MFIL");
+        constexpr uint32_t LocalTransformsTag  = MakeSectionTag("LXFM");
+        constexpr uint32_t GlobalTransformsTag = MakeSectionTag("GXFM");
+        constexpr uint32_t NodeHierarchiesTag  = MakeSectionTag("HIER");
+        constexpr uint32_t NamesTag            = MakeSectionTag("NAME");
+        constexpr uint32_t MaterialNamesTag    = MakeSectionTag("MNAM");
+        constexpr uint32_t NodeNamesTag        = MakeSectionTag("NNAM");
+        constexpr uint32_t NodeMeshesTag       = MakeSectionTag("NMSH");
+        constexpr uint32_t NodeMaterialsTag    = MakeSectionTag("NMAT");
+
+        struct NodeMapEntry
+        {
+            uint32_t Key;
+            uint32_t Value;
+        };
+
+        std::vector<NodeMapEntry> FlattenMap(const std::unordered_map<uint32_t, uint32_t>& map)
+        {
+            std::vector<NodeMapEntry> entries;
+            entries.reserve(map.size());
+            for (const auto& [key, value] : map)
+            {
+                entries.push_back({key, value});
+            }
+            return entries;
+        }
+
+        void ReadMap(const AssetContainerReader& reader, uint32_t tag, std::unordered_map<uint32_t, uint32_t>& map)
+        {
+            auto entries = reader.GetSection<NodeMapEntry>(tag);
+            map.reserve(entries.size());
+            for (const auto& entry : entries)
+            {
+                map[entry.Key] = entry.Value;
+            }
+        }
+
+        /*
+         * Copies a section straight from the mapping into the destination vector
+         */
+        template <typename T>
+        void ReadSection(const AssetContainerReader& reader, uint32_t tag, std::vector<T>& data)
+        {
+            auto section = reader.GetSection<T>(tag);
+            data.assign(section.begin(), section.end());
+        }
+    } // namespace
+
+    AssetContainerResult SceneAssetSerializer::WriteMeshes(const SceneRawData& scene, std::string_view filename)
+    {
+        AssetContainerWriter writer;
+        writer.AddSection(MeshesTag, scene.Meshes);
+        writer.AddSection(IndicesTag, scene.Indices);
+        writer.AddSection(VerticesTag, scene.Vertices);
+        writer.AddSection(MeshLodsTag, scene.MeshLods);
+        writer.AddSection(MeshletRangesTag, scene.MeshletRanges);
+        writer.AddSection(MeshletsTag, scene.Meshlets);
+        writer.AddSection(MeshletVerticesTag, scene.MeshletVertices);
+        writer.AddSection(MeshletTrianglesTag, scene.MeshletTriangles);
+        return writer.WriteToFile(filename);
+    }
+
+    AssetContainerResult SceneAssetSerializer::WriteMaterials(const SceneRawData& scene, std::string_view filename)
+    {
+        AssetContainerWriter writer;
+        writer.AddSection(MaterialsTag, scene.Materials);
+        writer.AddSection(MaterialFilesTag, scene.MaterialFiles);
+        return writer.WriteToFile(filename);
+    }
+
+    AssetContainerResult SceneAssetSerializer::WriteModel(const SceneRawData& scene, std::string_view filename)
+    {
+        auto node_names     = FlattenMap(scene.NodeNames);
+        auto node_meshes    = FlattenMap(scene.NodeMeshes);
+        auto node_materials = FlattenMap(scene.NodeMaterials);
+
+        AssetContainerWriter writer;
+        writer.AddSection(LocalTransformsTag, scene.LocalTransforms);
+        writer.AddSection(GlobalTransformsTag, scene.GlobalTransforms);
+        writer.AddSection(NodeHierarchiesTag, scene.NodeHierarchies);
+        writer.AddStringArray(NamesTag, scene.Names);
+        writer.AddStringArray(MaterialNamesTag, scene.MaterialNames);
+        writer.AddSection(NodeNamesTag, node_names);
+        writer.AddSection(NodeMeshesTag, node_meshes);
+        writer.AddSection(NodeMaterialsTag, node_materials);
+        return writer.WriteToFile(filename);
+    }
+
+    SceneAssetLoadResult SceneAssetSerializer::LoadScene(const SceneAssetFiles& files, SceneRawData& scene)
+    {
+        /*
+         * Sections are copied once, from the mapped file into the scene vectors
+         */
+        AssetContainerReader reader;
+        AssetContainerResult result = AssetContainerResult::SUCCESS;
+
+        if (!files.MeshPath.empty())
+        {
+            if ((result = reader.Open(files.MeshPath)) != AssetContainerResult::SUCCESS)
+            {
+                return {.Result = result, .Filename = files.MeshPath};
+            }
+            ReadSection(reader, MeshesTag, scene.Meshes);
+            ReadSection(reader, IndicesTag, scene.Indices);
+            ReadSection(reader, VerticesTag, scene.Vertices);
+            /* Optional : meshes written before LOD and meshlet generation have neither */
+            ReadSection(reader, MeshLodsTag, scene.MeshLods);
+            ReadSection(reader, MeshletRangesTag, scene.MeshletRanges);
+            ReadSection(reader, MeshletsTag, scene.Meshlets);
+            ReadSection(reader, MeshletVerticesTag, scene.MeshletVertices);
+            ReadSection(reader, MeshletTrianglesTag, scene.MeshletTriangles);
+        }
+
+        if (!files.MaterialPath.empty())
+        {
+            if ((result = reader.Open(files.MaterialPath)) != AssetContainerResult::SUCCESS)
+            {
+                return {.Result = result, .Filename = files.MaterialPath};
+            }
+            ReadSection(reader, MaterialsTag, scene.Materials);
+            ReadSection(reader, MaterialFilesTag, scene.MaterialFiles);
+        }
+
+        if (!files.ModelPath.empty())
+        {
+            if ((result = reader.Open(files.ModelPath)) != AssetContainerResult::SUCCESS)
+            {
+                return {.Result = result, .Filename = files.ModelPath};
+            }
+            ReadSection(reader, LocalTransformsTag, scene.LocalTransforms);
+            ReadSection(reader, GlobalTransformsTag, scene.GlobalTransforms);
+            ReadSection(reader, NodeHierarchiesTag, scene.NodeHierarchies);
+            reader.ReadStringArray(NamesTag, scene.Names);
+            reader.ReadStringArray(MaterialNamesTag, scene.MaterialNames);
+            ReadMap(reader, NodeNamesTag, scene.NodeNames);
+            ReadMap(reader, NodeMeshesTag, scene.NodeMeshes);
+            ReadMap(reader, NodeMaterialsTag, scene.NodeMaterials);
+        }
+        return {};
+    }
+
+    SceneAssetLoadResult SceneAssetSerializer::LoadScenes(std::span<const SceneAssetFiles> files, std::vector<SceneRawData>& scenes, size_t max_concurrency, const ProgressCallback& progress)
+    {
+        scenes.clear();
+        scenes.resize(files.size());
+
+        std::atomic_bool     cancelled{false};
+        std::mutex           mutex;
+        size_t               loaded_count = 0;
+        SceneAssetLoadResult failure      = {};
+        failure.FileIndex                 = files.size();
+
+        ThreadPoolHelper::ParallelFor(
+            files.size(), 1,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (cancelled)
+                    {
+                        return;
+                    }
+
+                    auto load = LoadScene(files[i], scenes[i]);
+
+                    std::lock_guard l(mutex);
+                    if (load.Result != AssetContainerResult::SUCCESS)
+                    {
+                        cancelled = true;
+                        if (i < failure.FileIndex)
+                        {
+                            failure           = std::move(load);
+                            failure.FileIndex = i;
+                        }
+                        return;
+                    }
+
+                    ++loaded_count;
+                    if (progress)
+                    {
+                        progress(loaded_count, files.size());
+                    }
+                }
+            },
+            TaskPriority::Normal, std::max<size_t>(max_concurrency, 1));
+
+        if (failure.Result != AssetContainerResult::SUCCESS)
+        {
+            scenes.clear();
+            return failure;
+        }
+        return {};
+    }
+} // namespace ZEngine::Serializers
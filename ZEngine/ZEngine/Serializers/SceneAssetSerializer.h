@@ -0,0 +1,57 @@
+#pragma once
+#include <Rendering/Scenes/GraphicScene.h>
+#include <Serializers/AssetContainer.h>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ZEngine::Serializers
+{
+    /*
+     * Files an imported model is split into, an empty path is skipped
+     */
+    struct SceneAssetFiles
+    {
+        std::string ModelPath    = {};
+        std::string MeshPath     = {};
+        std::string MaterialPath = {};
+    };
+
+    struct SceneAssetLoadResult
+    {
+        AssetContainerResult Result    = AssetContainerResult::SUCCESS;
+        /*
+         * Index of the failing entry and the file that failed, when Result isn't SUCCESS
+         */
+        size_t               FileIndex = 0;
+        std::string          Filename  = {};
+    };
+
+    /*
+     * Reads and writes the .zemeshes, .zemodel and .zematerials asset containers of a SceneRawData
+     */
+    struct SceneAssetSerializer
+    {
+        /*
+         * Models decoded at the same time by LoadScenes() : enough to overlap disk reads with decoding without
+         * holding the mapped files of a whole scene at once
+         */
+        static constexpr size_t DefaultLoadConcurrency = 4;
+
+        using ProgressCallback                         = std::function<void(size_t loaded_count, size_t total_count)>;
+
+        static AssetContainerResult WriteMeshes(const Rendering::Scenes::SceneRawData& scene, std::string_view filename);
+        static AssetContainerResult WriteMaterials(const Rendering::Scenes::SceneRawData& scene, std::string_view filename);
+        static AssetContainerResult WriteModel(const Rendering::Scenes::SceneRawData& scene, std::string_view filename);
+
+        static SceneAssetLoadResult LoadScene(const SceneAssetFiles& files, Rendering::Scenes::SceneRawData& scene);
+        /*
+         * Loads scenes[i] from files[i], running at most max_concurrency loads at once.
+         * The output order follows the input whatever the completion order, progress calls are serialized and their count
+         * only grows. The first failure stops the loads that haven't started yet, the result reports the failing entry with
+         * the lowest index.
+         */
+        static SceneAssetLoadResult LoadScenes(std::span<const SceneAssetFiles> files, std::vector<Rendering::Scenes::SceneRawData>& scenes, size_t max_concurrency = DefaultLoadConcurrency, const ProgressCallback& progress = {});
+    };
+} // namespace ZEngine::Serializers
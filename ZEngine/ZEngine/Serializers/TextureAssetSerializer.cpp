@@ -0,0 +1,212 @@
+#include <pch.h>
+#include <Helpers/MemoryMappedFile.h>
+#include <Serializers/TextureAssetSerializer.h>
+#include <filesystem>
+#include <fmt/format.h>
+
+using namespace ZEngine::Rendering::Textures;
+
+namespace ZEngine::Serializers
+{
+    namespace
+    {
+        constexpr uint32_t HeaderTag = MakeSectionTag("TXHD");
+        constexpr uint32_t LevelTag  = MakeSectionTag("TXLV");
+        constexpr uint32_t DataTag   = MakeSectionTag("TXDT");
+
+        std::string_view   FormatName(DecodedPixelFormat format)
+        {
+            switch (format)
+            {
+                case DecodedPixelFormat::RGBA8:
+                    return "rgba8";
+                case DecodedPixelFormat::RGBA32F:
+                    return "rgba32f";
+                case DecodedPixelFormat::BC1:
+                    return "bc1";
+                case DecodedPixelFormat::BC3:
+                    return "bc3";
+                case DecodedPixelFormat::BC4:
+                    return "bc4";
+                case DecodedPixelFormat::BC5:
+                    return "bc5";
+                case DecodedPixelFormat::BC6H:
+                    return "bc6h";
+                case DecodedPixelFormat::BC7:
+                    return "bc7";
+            }
+            return "unknown";
+        }
+
+        /*
+         * Opens the container and checks its header and level table against each other, image gets the shape they describe
+         */
+        TextureAssetLoadResult OpenContainer(AssetContainerReader& reader, std::string_view filename, bool verify_sections, DecodedImage& image, uint64_t* source_hash)
+        {
+            image = {};
+            if (reader.Open(filename, verify_sections) != AssetContainerResult::SUCCESS)
+            {
+                return TextureAssetLoadResult::UNAVAILABLE;
+            }
+
+            auto header = reader.GetSection<TextureAssetHeader>(HeaderTag);
+            auto levels = reader.GetSection<TextureAssetLevel>(LevelTag);
+            if (header.size() != 1)
+            {
+                return TextureAssetLoadResult::UNAVAILABLE;
+            }
+
+            if (header[0].EncoderVersion != TextureAssetSerializer::EncoderVersion)
+            {
+                return TextureAssetLoadResult::OUTDATED;
+            }
+
+            if ((header[0].Format > uint32_t(DecodedPixelFormat::BC7)) || (header[0].Width == 0) || (header[0].Height == 0) || (header[0].LayerCount == 0) || (header[0].MipLevelCount == 0) || (levels.size() != header[0].MipLevelCount))
+            {
+                return TextureAssetLoadResult::INVALID_DATA;
+            }
+
+            image.Width         = header[0].Width;
+            image.Height        = header[0].Height;
+            image.LayerCount    = header[0].LayerCount;
+            image.MipLevelCount = header[0].MipLevelCount;
+            image.IsCubemap     = (header[0].Flags & TextureAssetSerializer::CubemapFlag) != 0;
+            image.IsSrgb        = (header[0].Flags & TextureAssetSerializer::SrgbFlag) != 0;
+            image.Format        = DecodedPixelFormat(header[0].Format);
+
+            /*
+             * Levels are packed back to back : any other layout would need a copy per level to reach the staging memory
+             */
+            for (uint32_t level = 0; level < image.MipLevelCount; ++level)
+            {
+                if ((levels[level].Offset != image.MipByteOffset(level)) || (levels[level].ByteSize != image.LevelByteSize(level)))
+                {
+                    image = {};
+                    return TextureAssetLoadResult::INVALID_DATA;
+                }
+            }
+
+            if (source_hash)
+            {
+                *source_hash = header[0].SourceHash;
+            }
+            return TextureAssetLoadResult::SUCCESS;
+        }
+    } // namespace
+
+    AssetContainerResult TextureAssetSerializer::Write(std::string_view filename, const DecodedImage& image, uint64_t source_hash)
+    {
+        TextureAssetHeader header = {
+            .EncoderVersion = EncoderVersion,
+            .Format         = uint32_t(image.Format),
+            .Width          = image.Width,
+            .Height         = image.Height,
+            .LayerCount     = image.LayerCount,
+            .MipLevelCount  = image.MipLevelCount,
+            .Flags          = (image.IsCubemap ? CubemapFlag : 0u) | (image.IsSrgb ? SrgbFlag : 0u),
+            .SourceHash     = source_hash,
+        };
+
+        std::vector<TextureAssetLevel> levels(image.MipLevelCount);
+        for (uint32_t level = 0; level < image.MipLevelCount; ++level)
+        {
+            levels[level] = {.Offset = image.MipByteOffset(level), .ByteSize = image.LevelByteSize(level)};
+        }
+        ZENGINE_VALIDATE_ASSERT(image.Pixels.size() == image.MipByteOffset(image.MipLevelCount), "The pixels don't match the image shape")
+
+        AssetContainerWriter writer;
+        writer.AddSection(HeaderTag, std::span<const TextureAssetHeader>(&header, 1));
+        writer.AddSection(LevelTag, levels);
+        writer.AddSection(DataTag, image.Pixels);
+
+        /*
+         * Written aside then renamed : a loader never sees a half written container under the cache name
+         */
+        std::filesystem::path path      = filename;
+        std::filesystem::path temp_path = path;
+        temp_path += ".tmp";
+
+        std::error_code error;
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+
+        auto result = writer.WriteToFile(temp_path.string());
+        if (result != AssetContainerResult::SUCCESS)
+        {
+            std::filesystem::remove(temp_path, error);
+            return result;
+        }
+
+        std::filesystem::rename(temp_path, path, error);
+        if (error)
+        {
+            std::filesystem::remove(temp_path, error);
+            return AssetContainerResult::IO_ERROR;
+        }
+        return AssetContainerResult::SUCCESS;
+    }
+
+    TextureAssetLoadResult TextureAssetSerializer::Load(std::string_view filename, DecodedImage& image, uint64_t* source_hash)
+    {
+        AssetContainerReader reader;
+        auto                 result = OpenContainer(reader, filename, true, image, source_hash);
+        if (result != TextureAssetLoadResult::SUCCESS)
+        {
+            return result;
+        }
+
+        auto data = reader.GetSection<uint8_t>(DataTag);
+        if (data.size() != image.MipByteOffset(image.MipLevelCount))
+        {
+            image = {};
+            return TextureAssetLoadResult::INVALID_DATA;
+        }
+
+        image.Pixels.assign(data.begin(), data.end());
+        return TextureAssetLoadResult::SUCCESS;
+    }
+
+    TextureAssetLoadResult TextureAssetSerializer::ReadHeader(std::string_view filename, DecodedImage& image, uint64_t* source_hash)
+    {
+        /*
+         * Section checksums would cost a pass over the whole data : the load verifies them
+         */
+        AssetContainerReader reader;
+        return OpenContainer(reader, filename, false, image, source_hash);
+    }
+
+    bool TextureAssetSerializer::ComputeSourceHash(std::string_view filename, uint64_t& hash)
+    {
+        Helpers::MemoryMappedFile file;
+        if (!file.Open(filename))
+        {
+            return false;
+        }
+
+        hash = AssetContainer::ComputeChecksum(file.Bytes());
+        return true;
+    }
+
+    std::string TextureAssetSerializer::CacheFilename(std::string_view directory, uint64_t source_hash, DecodedPixelFormat format)
+    {
+        return fmt::format("{}/{:016x}.{}.zetexture", directory, source_hash, FormatName(format));
+    }
+
+    std::string_view TextureAssetSerializer::ToString(TextureAssetLoadResult result)
+    {
+        switch (result)
+        {
+            case TextureAssetLoadResult::SUCCESS:
+                return "success";
+            case TextureAssetLoadResult::UNAVAILABLE:
+                return "no readable texture container";
+            case TextureAssetLoadResult::OUTDATED:
+                return "encoded by another encoder version";
+            case TextureAssetLoadResult::INVALID_DATA:
+                return "the texture levels disagree with the header";
+        }
+        return "unknown error";
+    }
+} // namespace ZEngine::Serializers
@@ -0,0 +1,89 @@
+#pragma once
+#include <Rendering/Textures/TextureDecoder.h>
+#include <Serializers/AssetContainer.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ZEngine::Serializers
+{
+    struct TextureAssetHeader
+    {
+        /*
+         * TextureAssetSerializer::EncoderVersion the blocks were produced with
+         */
+        uint32_t EncoderVersion = 0;
+        /*
+         * Rendering::Textures::DecodedPixelFormat
+         */
+        uint32_t Format         = 0;
+        uint32_t Width          = 0;
+        uint32_t Height         = 0;
+        uint32_t LayerCount     = 0;
+        uint32_t MipLevelCount  = 0;
+        uint32_t Flags          = 0;
+        uint32_t _reserved      = 0;
+        /*
+         * Checksum of the source image file, the key the container is cached under
+         */
+        uint64_t SourceHash     = 0;
+    };
+
+    struct TextureAssetLevel
+    {
+        uint64_t Offset   = 0;
+        uint64_t ByteSize = 0;
+    };
+
+    static_assert(sizeof(TextureAssetHeader) == 40, "The texture header layout is part of the file format");
+    static_assert(sizeof(TextureAssetLevel) == 16, "The texture level layout is part of the file format");
+
+    enum class TextureAssetLoadResult
+    {
+        SUCCESS = 0,
+        /*
+         * No file, or a file that isn't a valid container
+         */
+        UNAVAILABLE,
+        /*
+         * Produced by another encoder version : it has to be imported again
+         */
+        OUTDATED,
+        /*
+         * The header disagrees with the levels or the data
+         */
+        INVALID_DATA
+    };
+
+    /*
+     * Reads and writes a .zetexture asset container : a block compressed image with its mip chain, stored in upload order
+     * (level after level, each holding all its layers) so it goes to the staging memory in one copy.
+     * Containers live in a cache directory, named after the checksum of the image file they were encoded from :
+     * an unchanged source is never encoded twice, and identical sources share one container.
+     */
+    struct TextureAssetSerializer
+    {
+        /*
+         * Bumped whenever the encoder output changes, containers of another version are reported OUTDATED
+         */
+        static constexpr uint32_t     EncoderVersion = 1;
+        static constexpr uint32_t     CubemapFlag    = 1u << 0;
+        static constexpr uint32_t     SrgbFlag       = 1u << 1;
+
+        static AssetContainerResult   Write(std::string_view filename, const Rendering::Textures::DecodedImage& image, uint64_t source_hash);
+        static TextureAssetLoadResult Load(std::string_view filename, Rendering::Textures::DecodedImage& image, uint64_t* source_hash = nullptr);
+        /*
+         * Fills everything but the pixels, only the header and the level table are read
+         */
+        static TextureAssetLoadResult ReadHeader(std::string_view filename, Rendering::Textures::DecodedImage& image, uint64_t* source_hash = nullptr);
+        /*
+         * Checksum of the file bytes (AssetContainer::ComputeChecksum), false when the file can't be read
+         */
+        static bool                   ComputeSourceHash(std::string_view filename, uint64_t& hash);
+        /*
+         * {directory}/{source hash}.{format}.zetexture : the same source encoded in two formats gets two containers
+         */
+        static std::string            CacheFilename(std::string_view directory, uint64_t source_hash, Rendering::Textures::DecodedPixelFormat format);
+        static std::string_view       ToString(TextureAssetLoadResult result);
+    };
+} // namespace ZEngine::Serializers
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+#include <Serializers/AssetContainer.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+using namespace ZEngine::Serializers;
+
+static constexpr uint32_t FloatTag  = MakeSectionTag("FLOT");
+static constexpr uint32_t IndexTag  = MakeSectionTag("INDX");
+static constexpr uint32_t NameTag   = MakeSectionTag("NAME");
+static constexpr uint32_t EmptyTag  = MakeSectionTag("EMPT");
+static constexpr uint32_t RecordTag = MakeSectionTag("RECD");
+
+struct TestRecord
+{
+    uint32_t Id;
+    float    Weight;
+    uint64_t Flags;
+};
+
+class AssetContainerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_floats.resize(1000);
+        std::iota(m_floats.begin(), m_floats.end(), 0.5f);
+        m_indices.resize(333);
+        std::iota(m_indices.begin(), m_indices.end(), 7u);
+        m_names   = {"Root", "", "Helmet", "A rather long node name with spaces"};
+        m_records = {{1, 0.25f, 0xFF}, {2, 0.5f, 0xF0F0}, {3, 1.0f, ~0ull}};
+
+        m_writer.AddSection(FloatTag, m_floats);
+        m_writer.AddSection(IndexTag, m_indices);
+        m_writer.AddStringArray(NameTag, m_names);
+        m_writer.AddSection(EmptyTag, std::vector<uint32_t>{});
+        m_writer.AddSection(RecordTag, m_records);
+    }
+
+    void TearDown() override
+    {
+        if (!m_filename.empty())
+        {
+            std::filesystem::remove(m_filename);
+        }
+    }
+
+    std::string TempFile(const char* name)
+    {
+        m_filename = (std::filesystem::temp_directory_path() / name).string();
+        return m_filename;
+    }
+
+    void ExpectContent(const AssetContainerReader& reader)
+    {
+        auto floats = reader.GetSection<float>(FloatTag);
+        ASSERT_EQ(floats.size(), m_floats.size());
+        EXPECT_TRUE(std::equal(floats.begin(), floats.end(), m_floats.begin()));
+
+        auto indices = reader.GetSection<uint32_t>(IndexTag);
+        ASSERT_EQ(indices.size(), m_indices.size());
+        EXPECT_TRUE(std::equal(indices.begin(), indices.end(), m_indices.begin()));
+
+        std::vector<std::string> names;
+        ASSERT_TRUE(reader.ReadStringArray(NameTag, names));
+        EXPECT_EQ(names, m_names);
+
+        EXPECT_NE(reader.FindSection(EmptyTag), nullptr);
+        EXPECT_TRUE(reader.GetSection<uint32_t>(EmptyTag).empty());
+
+        auto records = reader.GetSection<TestRecord>(RecordTag);
+        ASSERT_EQ(records.size(), m_records.size());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            EXPECT_EQ(records[i].Id, m_records[i].Id);
+            EXPECT_EQ(records[i].Weight, m_records[i].Weight);
+            EXPECT_EQ(records[i].Flags, m_records[i].Flags);
+        }
+    }
+
+    /*
+     * Rewrites the header checksum so the change under test is the only thing the reader can complain about
+     */
+    template <typename Patch>
+    static void PatchHeader(std::vector<std::byte>& bytes, Patch&& patch)
+    {
+        AssetContainerHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        patch(header);
+        header.HeaderChecksum = 0;
+        header.HeaderChecksum = AssetContainer::ComputeChecksum(std::as_bytes(std::span{&header, 1}));
+        std::memcpy(bytes.data(), &header, sizeof(header));
+    }
+
+    /*
+     * Rewrites the section table checksum (and so the header one) after patching a section entry
+     */
+    static void PatchSection(std::vector<std::byte>& bytes, size_t section_index, void (*patch)(AssetContainerSection&))
+    {
+        AssetContainerHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        AssetContainerSection section;
+        std::byte*            entry = bytes.data() + header.SectionTableOffset + section_index * sizeof(AssetContainerSection);
+        std::memcpy(&section, entry, sizeof(section));
+        patch(section);
+        std::memcpy(entry, &section, sizeof(section));
+
+        uint64_t table_checksum = AssetContainer::ComputeChecksum(std::as_bytes(std::span{bytes}).subspan(header.SectionTableOffset, header.SectionCount * sizeof(AssetContainerSection)));
+        PatchHeader(bytes, [=](AssetContainerHeader& patched) { patched.SectionTableChecksum = table_checksum; });
+    }
+
+    static std::vector<std::byte> FlipBit(std::vector<std::byte> bytes, size_t offset)
+    {
+        bytes[offset] ^= std::byte{0x01};
+        return bytes;
+    }
+
+    std::vector<float>       m_floats;
+    std::vector<uint32_t>    m_indices;
+    std::vector<std::string> m_names;
+    std::vector<TestRecord>  m_records;
+    AssetContainerWriter     m_writer;
+    std::string              m_filename;
+};
+
+TEST_F(AssetContainerTest, RoundTripThroughFile)
+{
+    auto filename = TempFile("zengine_asset_container_test.zeac");
+    ASSERT_EQ(m_writer.WriteToFile(filename), AssetContainerResult::SUCCESS);
+    EXPECT_EQ(std::filesystem::file_size(filename), m_writer.WriteToMemory().size());
+
+    AssetContainerReader reader;
+    ASSERT_EQ(reader.Open(filename), AssetContainerResult::SUCCESS);
+    EXPECT_TRUE(reader.IsOpen());
+    EXPECT_EQ(reader.Header().VersionMajor, AssetContainer::VersionMajor);
+    EXPECT_EQ(reader.Sections().size(), 5u);
+    ExpectContent(reader);
+
+    reader.Close();
+    EXPECT_FALSE(reader.IsOpen());
+    EXPECT_TRUE(reader.GetSection<float>(FloatTag).empty());
+}
+
+TEST_F(AssetContainerTest, RoundTripThroughMemory)
+{
+    auto                 bytes = m_writer.WriteToMemory();
+    AssetContainerReader reader;
+    ASSERT_EQ(reader.Open(bytes), AssetContainerResult::SUCCESS);
+    ExpectContent(reader);
+
+    AssetContainerReader moved = std::move(reader);
+    ExpectContent(moved);
+}
+
+TEST_F(AssetContainerTest, SectionsAreAlignedAndInBounds)
+{
+    auto                 bytes = m_writer.WriteToMemory();
+    AssetContainerReader reader;
+    ASSERT_EQ(reader.Open(bytes), AssetContainerResult::SUCCESS);
+
+    for (const auto& section : reader.Sections())
+    {
+        EXPECT_EQ(section.Offset % AssetContainer::SectionAlignment, 0u);
+        EXPECT_LE(section.Offset + section.ByteSize, bytes.size());
+        EXPECT_EQ(reader.VerifySection(section), AssetContainerResult::SUCCESS);
+    }
+    EXPECT_EQ(reader.Header().FileByteSize, bytes.size());
+}
+
+TEST_F(AssetContainerTest, TypeMismatchAndUnknownSectionsReturnEmpty)
+{
+    auto                 bytes = m_writer.WriteToMemory();
+    AssetContainerReader reader;
+    ASSERT_EQ(reader.Open(bytes), AssetContainerResult::SUCCESS);
+
+    EXPECT_TRUE(reader.GetSection<double>(FloatTag).empty());
+    EXPECT_TRUE(reader.GetSection<float>(MakeSectionTag("NONE")).empty());
+    EXPECT_EQ(reader.FindSection(MakeSectionTag("NONE")), nullptr);
+
+    std::vector<std::string> names = {"stale"};
+    EXPECT_FALSE(reader.ReadStringArray(FloatTag, names));
+    EXPECT_FALSE(reader.ReadStringArray(MakeSectionTag("NONE"), names));
+}
+
+TEST_F(AssetContainerTest, EmptyContainer)
+{
+    AssetContainerWriter writer;
+    auto                 bytes = writer.WriteToMemory();
+    EXPECT_EQ(bytes.size(), sizeof(AssetContainerHeader));
+
+    AssetContainerReader reader;
+    ASSERT_EQ(reader.Open(bytes), AssetContainerResult::SUCCESS);
+    EXPECT_TRUE(reader.Sections().empty());
+}
+
+TEST_F(AssetContainerTest, NewerMinorVersionIsAccepted)
+{
+    auto bytes = m_writer.WriteToMemory();
+    PatchHeader(bytes, [](AssetContainerHeader& header) { header.VersionMinor = AssetContainer::VersionMinor + 3; });
+
+    AssetContainerReader reader;
+    ASSERT_EQ(reader.Open(bytes), AssetContainerResult::SUCCESS);
+    ExpectContent(reader);
+}
+
+TEST_F(AssetContainerTest, RejectsInvalidFiles)
+{
+    AssetContainerReader reader;
+    EXPECT_EQ(reader.Open(TempFile("zengine_asset_container_missing.zeac")), AssetContainerResult::IO_ERROR);
+
+    std::vector<std::byte> legacy(256, std::byte{0x2A});
+    EXPECT_EQ(reader.Open(legacy), AssetContainerResult::INVALID_MAGIC);
+    EXPECT_EQ(reader.Open(std::span<const std::byte>{}), AssetContainerResult::TRUNCATED);
+
+    auto bytes = m_writer.WriteToMemory();
+    EXPECT_EQ(reader.Open(std::span{bytes}.first(bytes.size() - 1)), AssetContainerResult::TRUNCATED);
+    EXPECT_EQ(reader.Open(std::span{bytes}.first(sizeof(AssetContainerHeader) - 1)), AssetContainerResult::TRUNCATED);
+
+    auto newer_major = bytes;
+    PatchHeader(newer_major, [](AssetContainerHeader& header) { header.VersionMajor = AssetContainer::VersionMajor + 1; });
+    EXPECT_EQ(reader.Open(newer_major), AssetContainerResult::UNSUPPORTED_VERSION);
+    EXPECT_FALSE(reader.IsOpen());
+}
+
+TEST_F(AssetContainerTest, DetectsCorruption)
+{
+    auto                 bytes = m_writer.WriteToMemory();
+    AssetContainerReader reader;
+    ASSERT_EQ(reader.Open(bytes), AssetContainerResult::SUCCESS);
+    const auto float_section = *reader.FindSection(FloatTag);
+    reader.Close();
+
+    EXPECT_EQ(reader.Open(FlipBit(bytes, offsetof(AssetContainerHeader, SectionCount))), AssetContainerResult::CORRUPTED_HEADER);
+    EXPECT_EQ(reader.Open(FlipBit(bytes, sizeof(AssetContainerHeader) + 9)), AssetContainerResult::CORRUPTED_SECTION_TABLE);
+
+    /*
+     * Misaligned sections are rejected even when they stay in bounds
+     */
+    auto misaligned = bytes;
+    PatchSection(misaligned, 0, [](AssetContainerSection& section) { section.Offset += 4; });
+    EXPECT_EQ(reader.Open(misaligned), AssetContainerResult::CORRUPTED_SECTION_TABLE);
+
+    auto section_corrupted = FlipBit(bytes, float_section.Offset + 100);
+    EXPECT_EQ(reader.Open(section_corrupted), AssetContainerResult::CORRUPTED_SECTION);
+    EXPECT_FALSE(reader.IsOpen());
+
+    /*
+     * Skipping the section pass leaves the check to the caller
+     */
+    ASSERT_EQ(reader.Open(section_corrupted, false), AssetContainerResult::SUCCESS);
+    EXPECT_EQ(reader.VerifySection(*reader.FindSection(FloatTag)), AssetContainerResult::CORRUPTED_SECTION);
+    EXPECT_EQ(reader.VerifySection(*reader.FindSection(IndexTag)), AssetContainerResult::SUCCESS);
+}
+
+TEST_F(AssetContainerTest, ChecksumIsStableAndSensitive)
+{
+    std::vector<std::byte> data(1027);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = std::byte(i * 31);
+    }
+
+    /*
+     * Reference values of the XXH64 algorithm
+     */
+    EXPECT_EQ(AssetContainer::ComputeChecksum({}), 0xEF46DB3751D8E999ull);
+    const char abc[] = "abc";
+    EXPECT_EQ(AssetContainer::ComputeChecksum(std::as_bytes(std::span{abc, 3})), 0x44BC2CF5AD770999ull);
+
+    uint64_t checksum = AssetContainer::ComputeChecksum(data);
+    EXPECT_EQ(checksum, AssetContainer::ComputeChecksum(data));
+    EXPECT_NE(checksum, AssetContainer::ComputeChecksum(data, 1));
+    for (size_t i : {size_t(0), size_t(31), size_t(32), size_t(1024), size_t(1026)})
+    {
+        EXPECT_NE(checksum, AssetContainer::ComputeChecksum(FlipBit(data, i)));
+    }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "Helpers/BufferRangeTracker.h"
+
+using namespace ZEngine::Helpers;
+
+class BufferRangeTrackerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+static std::vector<BufferRange> ToVector(std::span<const BufferRange> ranges)
+{
+    return std::vector<BufferRange>(ranges.begin(), ranges.end());
+}
+
+TEST_F(BufferRangeTrackerTest, SlotsStartFullyDirty)
+{
+    BufferRangeTracker tracker(3);
+    for (uint32_t slot = 0; slot < 3; ++slot)
+    {
+        EXPECT_TRUE(tracker.IsFullyDirty(slot));
+        EXPECT_TRUE(tracker.HasPendingChanges(slot));
+        tracker.Consume(slot);
+        EXPECT_FALSE(tracker.HasPendingChanges(slot));
+    }
+
+    /* Ranges recorded while a slot is fully dirty are irrelevant to it */
+    tracker.MarkAllDirty();
+    tracker.MarkDirty(0, 64);
+    EXPECT_TRUE(tracker.GetRanges(0).empty());
+    EXPECT_TRUE(tracker.IsFullyDirty(0));
+}
+
+TEST_F(BufferRangeTrackerTest, RangesAreSortedAndCoalesced)
+{
+    BufferRangeTracker tracker(1, 0);
+    tracker.Consume(0);
+
+    tracker.MarkDirty(640, 64);
+    tracker.MarkDirty(0, 64);
+    tracker.MarkDirty(64, 64);
+    tracker.MarkDirty(32, 16);
+    tracker.MarkDirty(1024, 64);
+    tracker.MarkDirty(1000, 40);
+
+    std::vector<BufferRange> expected = {{0, 128}, {640, 64}, {1000, 88}};
+    EXPECT_EQ(ToVector(tracker.GetRanges(0)), expected);
+    EXPECT_EQ(tracker.GetPendingByteSize(0), 280u);
+}
+
+TEST_F(BufferRangeTrackerTest, NearbyRangesMergeWithinGap)
+{
+    BufferRangeTracker tracker(1, 256);
+    tracker.Consume(0);
+
+    tracker.MarkDirty(0, 64);
+    tracker.MarkDirty(256, 64);
+    tracker.MarkDirty(4096, 64);
+
+    std::vector<BufferRange> expected = {{0, 320}, {4096, 64}};
+    EXPECT_EQ(ToVector(tracker.GetRanges(0)), expected);
+}
+
+TEST_F(BufferRangeTrackerTest, EachFrameSlotUploadsAChangeOnce)
+{
+    const uint32_t     frame_count = 3;
+    BufferRangeTracker tracker(frame_count, 0);
+
+    /* Initial full upload of every per-frame copy */
+    for (uint32_t frame = 0; frame < frame_count; ++frame)
+    {
+        EXPECT_TRUE(tracker.IsFullyDirty(frame));
+        tracker.Consume(frame);
+    }
+
+    /* A node transform changes at frame 0 */
+    tracker.MarkDirty(64 * 10, 64);
+
+    std::vector<BufferRange> expected = {{640, 64}};
+    for (uint32_t frame = 0; frame < frame_count; ++frame)
+    {
+        EXPECT_EQ(ToVector(tracker.GetRanges(frame)), expected) << "slot " << frame;
+        tracker.Consume(frame);
+    }
+
+    /* Static scene : nothing left for any slot, for as many frames as it stays static */
+    for (uint32_t frame = 0; frame < 10 * frame_count; ++frame)
+    {
+        uint32_t slot = frame % frame_count;
+        EXPECT_FALSE(tracker.HasPendingChanges(slot));
+        EXPECT_EQ(tracker.GetPendingByteSize(slot), 0u);
+        tracker.Consume(slot);
+    }
+}
+
+TEST_F(BufferRangeTrackerTest, SlotsConsumeIndependently)
+{
+    BufferRangeTracker tracker(2, 0);
+    tracker.Consume(0);
+    tracker.Consume(1);
+
+    tracker.MarkDirty(0, 64);
+    EXPECT_EQ(ToVector(tracker.GetRanges(0)), (std::vector<BufferRange>{{0, 64}}));
+    tracker.Consume(0);
+
+    tracker.MarkDirty(128, 64);
+    EXPECT_EQ(ToVector(tracker.GetRanges(0)), (std::vector<BufferRange>{{128, 64}}));
+    EXPECT_EQ(ToVector(tracker.GetRanges(1)), (std::vector<BufferRange>{{0, 64}, {128, 64}}));
+}
+
+TEST_F(BufferRangeTrackerTest, PendingRangesStayBounded)
+{
+    BufferRangeTracker tracker(1, 0);
+    tracker.Consume(0);
+
+    /* Every other matrix of a 200k transform array, never consumed */
+    for (size_t i = 0; i < 200000; i += 2)
+    {
+        tracker.MarkDirty(i * 64, 64);
+    }
+    tracker.MarkDirty(64, 64);
+
+    auto ranges = tracker.GetRanges(0);
+    EXPECT_EQ(ranges.size(), 99999u);
+    EXPECT_EQ(ranges.front(), (BufferRange{0, 192}));
+    for (size_t i = 1; i < ranges.size(); ++i)
+    {
+        EXPECT_LT(ranges[i - 1].End(), ranges[i].Offset);
+    }
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "Core/Coroutine.h"
+#include "Core/CoroutineScheduler.h"
+#include "Helpers/ThreadPool.h"
+
+using namespace ZEngine::Core;
+
+class CoroutineSchedulerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        CoroutineScheduler::ResetStatistics();
+    }
+
+    void TearDown() override {}
+};
+
+static std::future<int> AddOneAsync(std::future<int>& source)
+{
+    int value = co_await source;
+    co_return value + 1;
+}
+
+TEST_F(CoroutineSchedulerTest, ResumesOnCompletionNotification)
+{
+    std::atomic_bool   completed = false;
+    std::promise<void> resumed;
+    auto               resumed_future = resumed.get_future();
+
+    CoroutineAction    action         = {};
+    action.Ready                      = [&completed] { return completed.load(); };
+    action.Action                     = [&resumed] { resumed.set_value(); };
+    CoroutineScheduler::Schedule(std::move(action));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(CoroutineScheduler::GetStatistics().QueueDepth, 1u);
+
+    completed = true;
+    CoroutineScheduler::NotifyCompletion();
+
+    ASSERT_EQ(resumed_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    auto statistics = CoroutineScheduler::GetStatistics();
+    EXPECT_EQ(statistics.ScheduledCount, 1u);
+    EXPECT_EQ(statistics.ResumedCount, 1u);
+    EXPECT_EQ(statistics.QueueDepth, 0u);
+    EXPECT_GT(statistics.MaxResumeLatencyNs, 0u);
+    EXPECT_LT(statistics.AverageResumeLatencyNs(), 1e9);
+}
+
+TEST_F(CoroutineSchedulerTest, IdleSchedulerDoesNotWakeUp)
+{
+    CoroutineAction action = {};
+    action.Ready           = [] { return true; };
+    action.Action          = [] {};
+    CoroutineScheduler::Schedule(std::move(action));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto before = CoroutineScheduler::GetStatistics();
+    EXPECT_EQ(before.QueueDepth, 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    auto after = CoroutineScheduler::GetStatistics();
+
+    EXPECT_EQ(after.WakeupCount, before.WakeupCount);
+    EXPECT_EQ(after.ReadinessCheckCount, before.ReadinessCheckCount);
+}
+
+TEST_F(CoroutineSchedulerTest, ParkedContinuationIsNotBusyPolled)
+{
+    std::atomic_bool completed = false;
+    std::promise<void> resumed;
+    auto               resumed_future = resumed.get_future();
+
+    CoroutineAction    action         = {};
+    action.Ready                      = [&completed] { return completed.load(); };
+    action.Action                     = [&resumed] { resumed.set_value(); };
+    CoroutineScheduler::Schedule(std::move(action));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    /* Checked once on arrival, never again without a completion */
+    auto statistics = CoroutineScheduler::GetStatistics();
+    EXPECT_EQ(statistics.ReadinessCheckCount, 1u);
+    EXPECT_EQ(statistics.WakeupCount, 1u);
+    EXPECT_EQ(statistics.QueueDepth, 1u);
+
+    completed = true;
+    CoroutineScheduler::NotifyCompletion();
+    ASSERT_EQ(resumed_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+}
+
+TEST_F(CoroutineSchedulerTest, CoroutineAwaitingForeignFutureResumesOnNotification)
+{
+    std::promise<int> source;
+    auto              source_future = source.get_future();
+    auto              result        = AddOneAsync(source_future);
+
+    source.set_value(41);
+    CoroutineScheduler::NotifyCompletion();
+
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(result.get(), 42);
+}
+
+TEST_F(CoroutineSchedulerTest, CoroutineChainResumesOnCompletion)
+{
+    std::promise<int> source;
+    auto              source_future = source.get_future();
+    auto              inner         = AddOneAsync(source_future);
+    auto              outer         = AddOneAsync(inner);
+
+    EXPECT_EQ(CoroutineScheduler::GetStatistics().ScheduledCount, 2u);
+
+    /* Only the raw promise needs notifying, the inner coroutine notifies the outer one */
+    source.set_value(40);
+    CoroutineScheduler::NotifyCompletion();
+
+    ASSERT_EQ(outer.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(outer.get(), 42);
+    EXPECT_EQ(CoroutineScheduler::GetStatistics().ResumedCount, 2u);
+}
+
+TEST_F(CoroutineSchedulerTest, CoroutineAwaitingThreadPoolFutureResumesOnCompletion)
+{
+    std::promise<void> gate;
+    auto               gate_future   = gate.get_future().share();
+    auto               source_future = ZEngine::Helpers::ThreadPoolHelper::Submit([gate_future] {
+        gate_future.wait();
+        return 41;
+    });
+    auto               result        = AddOneAsync(source_future);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gate.set_value();
+
+    /* The pool notifies the scheduler once the task set the future : one check on arrival, one on completion */
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(result.get(), 42);
+    auto statistics = CoroutineScheduler::GetStatistics();
+    EXPECT_EQ(statistics.ResumedCount, 1u);
+    EXPECT_LE(statistics.ReadinessCheckCount, 2u);
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include "Helpers/LockFreeQueue.h"
+#include "Helpers/ThreadSafeQueue.h"
+#include <numeric>
+#include <set>
+
+using namespace ZEngine::Helpers;
+
+class LockFreeQueueTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(LockFreeQueueTest, CapacityIsRoundedToPowerOfTwo)
+{
+    LockFreeQueue<int> queue(100);
+    EXPECT_EQ(queue.Capacity(), 128u);
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST_F(LockFreeQueueTest, PreservesFifoOrder)
+{
+    LockFreeQueue<int> queue(16);
+    for (int i = 0; i < 10; ++i)
+    {
+        queue.Enqueue(i);
+    }
+    EXPECT_EQ(queue.Size(), 10u);
+
+    int value = -1;
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(queue.Pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.Pop(value));
+}
+
+TEST_F(LockFreeQueueTest, TryEnqueueFailsWhenFull)
+{
+    LockFreeQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.TryEnqueue(i));
+    }
+    EXPECT_FALSE(queue.TryEnqueue(4));
+
+    int value = -1;
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_TRUE(queue.TryEmplace(4));
+}
+
+TEST_F(LockFreeQueueTest, FailedTryEmplaceKeepsTheItem)
+{
+    LockFreeQueue<std::string> queue(2);
+    std::string                item = "first";
+    EXPECT_TRUE(queue.TryEmplace(std::move(item)));
+    item = "second";
+    EXPECT_TRUE(queue.TryEmplace(std::move(item)));
+
+    item = "kept";
+    EXPECT_FALSE(queue.TryEmplace(std::move(item)));
+    EXPECT_EQ(item, "kept");
+}
+
+TEST_F(LockFreeQueueTest, WrapsAroundManyTimes)
+{
+    LockFreeQueue<std::string> queue(4);
+    std::string                value;
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue.Emplace(std::to_string(i));
+        ASSERT_TRUE(queue.Pop(value));
+        EXPECT_EQ(value, std::to_string(i));
+    }
+}
+
+TEST_F(LockFreeQueueTest, BlockingEnqueueWaitsForConsumer)
+{
+    LockFreeQueue<int> queue(2);
+    queue.Enqueue(0);
+    queue.Enqueue(1);
+
+    std::atomic_bool enqueued = false;
+    std::thread      producer([&] {
+        queue.Enqueue(2);
+        enqueued = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(enqueued);
+
+    int value = -1;
+    ASSERT_TRUE(queue.Pop(value));
+    producer.join();
+    EXPECT_TRUE(enqueued);
+}
+
+TEST_F(LockFreeQueueTest, WaitPopBlocksUntilItemOrCancellation)
+{
+    LockFreeQueue<int> queue(8);
+    std::atomic_bool   token = false;
+
+    std::thread        producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.Enqueue(42);
+    });
+
+    int                value = -1;
+    EXPECT_TRUE(queue.WaitPop(value, token));
+    EXPECT_EQ(value, 42);
+    producer.join();
+
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        token = true;
+        queue.Clear();
+    });
+    EXPECT_FALSE(queue.WaitPop(value, token));
+    canceller.join();
+}
+
+TEST_F(LockFreeQueueTest, ConcurrentProducersAndConsumersLoseNothing)
+{
+    LockFreeQueue<int>       queue(64);
+    const int                producer_count     = 4;
+    const int                consumer_count     = 4;
+    const int                items_per_producer = 20000;
+    std::atomic_bool         done               = false;
+    std::atomic<int>         consumed           = 0;
+    std::vector<int>         seen(producer_count * items_per_producer, 0);
+    std::mutex               seen_mutex;
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < consumer_count; ++c)
+    {
+        threads.emplace_back([&] {
+            std::vector<int> local;
+            int              value = 0;
+            while (queue.WaitPop(value, done))
+            {
+                local.push_back(value);
+                if (consumed.fetch_add(1) + 1 == producer_count * items_per_producer)
+                {
+                    done = true;
+                    queue.Clear();
+                }
+            }
+
+            std::lock_guard l(seen_mutex);
+            for (int v : local)
+            {
+                seen[v]++;
+            }
+        });
+    }
+
+    for (int p = 0; p < producer_count; ++p)
+    {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < items_per_producer; ++i)
+            {
+                queue.Enqueue(p * items_per_producer + i);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(consumed, producer_count * items_per_producer);
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+}
+
+TEST_F(LockFreeQueueTest, WaitForTimesOutOrWakesOnEnqueue)
+{
+    using Clock = std::chrono::steady_clock;
+    LockFreeQueue<int> queue(8);
+
+    auto               start = Clock::now();
+    queue.WaitFor(std::chrono::milliseconds(20));
+    EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_TRUE(queue.Empty());
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.Enqueue(42);
+    });
+
+    /* Woken by the enqueue, long before the timeout */
+    start = Clock::now();
+    queue.WaitFor(std::chrono::seconds(30));
+    EXPECT_LT(Clock::now() - start, std::chrono::seconds(10));
+    EXPECT_FALSE(queue.Empty());
+    producer.join();
+}
+
+/*
+ * Every thread enqueues then pops, the queue is shared by all of them. Returns the elapsed milliseconds, sum receives the popped values
+ */
+template <typename TQueue>
+static double MeasureContendedThroughput(TQueue& queue, size_t thread_count, int operations_per_thread, int64_t& sum)
+{
+    std::atomic<size_t>      ready  = 0;
+    std::atomic_bool         start  = false;
+    std::atomic<int64_t>     popped = 0;
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&] {
+            ready++;
+            while (!start) {}
+
+            int     value = 0;
+            int64_t local = 0;
+            for (int i = 0; i < operations_per_thread; ++i)
+            {
+                queue.Enqueue(i);
+                while (!queue.Pop(value))
+                {
+                    std::this_thread::yield();
+                }
+                local += value;
+            }
+            popped += local;
+        });
+    }
+
+    while (ready != thread_count) {}
+    auto begin = std::chrono::steady_clock::now();
+    start      = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    sum = popped;
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+TEST_F(LockFreeQueueTest, ContendedThroughputComparedToThreadSafeQueue)
+{
+    const int total_operations = 200000;
+    for (size_t thread_count : {1, 2, 4, 8, 16})
+    {
+        const int     operations_per_thread = total_operations / static_cast<int>(thread_count);
+        const int64_t expected_sum          = int64_t(thread_count) * operations_per_thread * (operations_per_thread - 1) / 2;
+
+        int64_t       mutex_queue_sum       = 0;
+        double        mutex_queue_ms;
+        {
+            ThreadSafeQueue<int> queue;
+            mutex_queue_ms = MeasureContendedThroughput(queue, thread_count, operations_per_thread, mutex_queue_sum);
+        }
+
+        int64_t lock_free_sum = 0;
+        double  lock_free_ms;
+        {
+            LockFreeQueue<int> queue(1024);
+            lock_free_ms = MeasureContendedThroughput(queue, thread_count, operations_per_thread, lock_free_sum);
+            EXPECT_TRUE(queue.Empty());
+        }
+
+        EXPECT_EQ(mutex_queue_sum, expected_sum);
+        EXPECT_EQ(lock_free_sum, expected_sum);
+        RecordProperty("ThreadSafeQueueMs_" + std::to_string(thread_count), std::to_string(mutex_queue_ms));
+        RecordProperty("LockFreeQueueMs_" + std::to_string(thread_count), std::to_string(lock_free_ms));
+    }
+}
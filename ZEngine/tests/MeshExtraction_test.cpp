@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <Helpers/MeshHelper.h>
+#include <assimp/scene.h>
+#include <cstring>
+#include <memory>
+#include <random>
+
+using namespace ZEngine::Helpers;
+using namespace ZEngine::Rendering::Meshes;
+
+struct ExtractedMeshes
+{
+    std::vector<float>     Vertices;
+    std::vector<uint32_t>  Indices;
+    std::vector<MeshVNext> Meshes;
+    uint32_t               VertexOffset = 0;
+    uint32_t               IndexOffset  = 0;
+};
+
+struct GeneratedMesh
+{
+    uint32_t VertexCount   = 0;
+    uint32_t FaceCount     = 0;
+    bool     HasTexCoords  = true;
+    /*
+     * Every third face becomes a line, as left by a mesh that wasn't split by primitive type
+     */
+    bool     MixedFaceSize = false;
+};
+
+class MeshExtractionTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static std::unique_ptr<aiScene> GenerateScene(const std::vector<GeneratedMesh>& descriptions, uint32_t seed = 11)
+    {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+
+        auto scene        = std::make_unique<aiScene>();
+        scene->mNumMeshes = uint32_t(descriptions.size());
+        scene->mMeshes    = new aiMesh*[descriptions.size()];
+        for (size_t m = 0; m < descriptions.size(); ++m)
+        {
+            const auto& description = descriptions[m];
+            aiMesh*     mesh        = new aiMesh();
+            scene->mMeshes[m]       = mesh;
+
+            mesh->mNumVertices      = description.VertexCount;
+            mesh->mVertices         = new aiVector3D[description.VertexCount];
+            mesh->mNormals          = new aiVector3D[description.VertexCount];
+            if (description.HasTexCoords)
+            {
+                mesh->mTextureCoords[0] = new aiVector3D[description.VertexCount];
+            }
+            for (uint32_t v = 0; v < description.VertexCount; ++v)
+            {
+                mesh->mVertices[v] = aiVector3D(value(rng), value(rng), value(rng));
+                mesh->mNormals[v]  = aiVector3D(value(rng), value(rng), value(rng));
+                if (description.HasTexCoords)
+                {
+                    mesh->mTextureCoords[0][v] = aiVector3D(value(rng), value(rng), 0.0f);
+                }
+            }
+
+            mesh->mNumFaces = description.FaceCount;
+            mesh->mFaces    = new aiFace[description.FaceCount];
+            for (uint32_t f = 0; f < description.FaceCount; ++f)
+            {
+                aiFace& face     = mesh->mFaces[f];
+                face.mNumIndices = (description.MixedFaceSize && (f % 3 == 2)) ? 2 : 3;
+                face.mIndices    = new unsigned int[face.mNumIndices];
+                for (uint32_t i = 0; i < face.mNumIndices; ++i)
+                {
+                    face.mIndices[i] = rng() % std::max(description.VertexCount, 1u);
+                }
+            }
+        }
+        return scene;
+    }
+
+    /*
+     * Element by element extraction, as the importer used to do it
+     */
+    static void ExtractSerial(const aiScene* scene, ExtractedMeshes& out)
+    {
+        for (uint32_t m = 0; m < scene->mNumMeshes; ++m)
+        {
+            aiMesh*     ai_mesh = scene->mMeshes[m];
+            BoundingBox bounds  = {};
+            for (uint32_t v = 0; v < ai_mesh->mNumVertices; ++v)
+            {
+                const aiVector3D position = ai_mesh->mVertices[v];
+                const aiVector3D normal   = ai_mesh->mNormals[v];
+                const aiVector3D texture  = ai_mesh->HasTextureCoords(0) ? ai_mesh->mTextureCoords[0][v] : aiVector3D{};
+
+                out.Vertices.insert(out.Vertices.end(), {position.x, position.y, position.z, normal.x, normal.y, normal.z, texture.x, texture.y});
+                bounds.Expand(glm::vec3(position.x, position.y, position.z));
+            }
+
+            uint32_t index_count = 0;
+            uint32_t face_size   = (ai_mesh->mNumFaces > 0) ? ai_mesh->mFaces[0].mNumIndices : 0;
+            for (uint32_t f = 0; f < ai_mesh->mNumFaces; ++f)
+            {
+                face_size = (ai_mesh->mFaces[f].mNumIndices == face_size) ? face_size : 0;
+                for (uint32_t i = 0; i < ai_mesh->mFaces[f].mNumIndices; ++i)
+                {
+                    out.Indices.push_back(ai_mesh->mFaces[f].mIndices[i]);
+                    index_count++;
+                }
+            }
+
+            MeshVNext& mesh           = out.Meshes.emplace_back();
+            mesh.VertexCount          = ai_mesh->mNumVertices;
+            mesh.VertexOffset         = out.VertexOffset;
+            mesh.VertexUnitStreamSize = sizeof(float) * (3 + 3 + 2);
+            mesh.StreamOffset         = (mesh.VertexUnitStreamSize * mesh.VertexOffset);
+            mesh.IndexOffset          = out.IndexOffset;
+            mesh.IndexCount           = index_count;
+            mesh.IndexUnitStreamSize  = sizeof(uint32_t);
+            mesh.IndexStreamOffset    = (mesh.IndexUnitStreamSize * mesh.IndexOffset);
+            mesh.TotalByteSize        = (mesh.VertexCount * mesh.VertexUnitStreamSize) + (mesh.IndexCount * mesh.IndexUnitStreamSize);
+            mesh.FaceSize             = face_size;
+            mesh.Bounds               = bounds;
+
+            out.VertexOffset += ai_mesh->mNumVertices;
+            out.IndexOffset  += index_count;
+        }
+    }
+
+    static void ExtractParallel(const aiScene* scene, ExtractedMeshes& out)
+    {
+        ExtractAssimpMeshes(scene, out.Vertices, out.Indices, out.Meshes, out.VertexOffset, out.IndexOffset);
+    }
+
+    template <typename T>
+    static bool SameBytes(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return (a.size() == b.size()) && (a.empty() || std::memcmp(a.data(), b.data(), sizeof(T) * a.size()) == 0);
+    }
+
+    static void ExpectIdentical(const ExtractedMeshes& a, const ExtractedMeshes& b)
+    {
+        EXPECT_TRUE(SameBytes(a.Vertices, b.Vertices));
+        EXPECT_TRUE(SameBytes(a.Indices, b.Indices));
+        EXPECT_TRUE(SameBytes(a.Meshes, b.Meshes));
+        EXPECT_EQ(a.VertexOffset, b.VertexOffset);
+        EXPECT_EQ(a.IndexOffset, b.IndexOffset);
+    }
+};
+
+TEST_F(MeshExtractionTest, MatchesSerialExtraction)
+{
+    /* Meshes larger than a work chunk, empty ones, no uvs and mixed face sizes */
+    auto scene = GenerateScene({
+        {.VertexCount = 3, .FaceCount = 1},
+        {.VertexCount = 50000, .FaceCount = 70001},
+        {.VertexCount = 0, .FaceCount = 0},
+        {.VertexCount = 1000, .FaceCount = 900, .HasTexCoords = false},
+        {.VertexCount = 40000, .FaceCount = 40000, .MixedFaceSize = true},
+        {.VertexCount = 16384, .FaceCount = 16384},
+    });
+
+    ExtractedMeshes serial;
+    ExtractedMeshes parallel;
+    ExtractSerial(scene.get(), serial);
+    ExtractParallel(scene.get(), parallel);
+    ExpectIdentical(parallel, serial);
+}
+
+TEST_F(MeshExtractionTest, AppendsAfterExistingData)
+{
+    auto first  = GenerateScene({{.VertexCount = 300, .FaceCount = 200}, {.VertexCount = 20000, .FaceCount = 30000}}, 1);
+    auto second = GenerateScene({{.VertexCount = 100, .FaceCount = 120, .MixedFaceSize = true}, {.VertexCount = 5, .FaceCount = 2}}, 2);
+
+    ExtractedMeshes serial;
+    ExtractedMeshes parallel;
+    ExtractSerial(first.get(), serial);
+    ExtractSerial(second.get(), serial);
+    ExtractParallel(first.get(), parallel);
+    ExtractParallel(second.get(), parallel);
+    ExpectIdentical(parallel, serial);
+}
+
+TEST_F(MeshExtractionTest, ManySmallMeshes)
+{
+    std::vector<GeneratedMesh> descriptions;
+    for (uint32_t m = 0; m < 2000; ++m)
+    {
+        descriptions.push_back({.VertexCount = 1 + (m * 37) % 500, .FaceCount = (m * 53) % 700, .HasTexCoords = (m % 5) != 0});
+    }
+    auto scene = GenerateScene(descriptions);
+
+    ExtractedMeshes serial;
+    ExtractedMeshes parallel;
+    ExtractSerial(scene.get(), serial);
+    ExtractParallel(scene.get(), parallel);
+    ExpectIdentical(parallel, serial);
+}
+
+TEST_F(MeshExtractionTest, EmptyScene)
+{
+    ExtractedMeshes out;
+    ExtractParallel(nullptr, out);
+
+    aiScene empty_scene;
+    ExtractParallel(&empty_scene, out);
+    EXPECT_TRUE(out.Vertices.empty());
+    EXPECT_TRUE(out.Meshes.empty());
+    EXPECT_EQ(out.VertexOffset, 0u);
+}
+
+TEST_F(MeshExtractionTest, RepeatedParallelRunsMatchSerial)
+{
+    /* Small enough to run quickly, split across a few work chunks so the workers race on every run */
+    auto scene = GenerateScene({{.VertexCount = 20000, .FaceCount = 30000}, {.VertexCount = 500, .FaceCount = 400, .MixedFaceSize = true}, {.VertexCount = 10000, .FaceCount = 12000}});
+
+    ExtractedMeshes serial;
+    ExtractSerial(scene.get(), serial);
+    for (int run = 0; run < 8; ++run)
+    {
+        ExtractedMeshes parallel;
+        ExtractParallel(scene.get(), parallel);
+        ExpectIdentical(parallel, serial);
+    }
+}
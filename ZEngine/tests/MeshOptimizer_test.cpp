@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include <Rendering/Meshes/MeshOptimizer.h>
+#include <algorithm>
+#include <array>
+#include <random>
+
+using namespace ZEngine::Rendering::Meshes;
+
+using Triangle = std::array<float, 9>;
+
+class MeshOptimizerTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t VertexStride = 8;
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    /*
+     * A (size x size) quad grid, its triangles shuffled as an unoptimized exporter would leave them
+     */
+    static void GenerateGrid(uint32_t size, std::vector<float>& vertices, std::vector<uint32_t>& indices, uint32_t seed = 5)
+    {
+        const uint32_t row = size + 1;
+        for (uint32_t y = 0; y < row; ++y)
+        {
+            for (uint32_t x = 0; x < row; ++x)
+            {
+                vertices.insert(vertices.end(), {float(x), float(y), 0.0f, 0.0f, 0.0f, 1.0f, float(x) / size, float(y) / size});
+            }
+        }
+
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                uint32_t v0 = y * row + x;
+                triangles.push_back({v0, v0 + 1, v0 + row});
+                triangles.push_back({v0 + 1, v0 + row + 1, v0 + row});
+            }
+        }
+
+        std::mt19937 rng(seed);
+        std::shuffle(triangles.begin(), triangles.end(), rng);
+        for (const auto& triangle : triangles)
+        {
+            indices.insert(indices.end(), triangle.begin(), triangle.end());
+        }
+    }
+
+    /*
+     * Triangles as vertex data, rotated so the smallest vertex comes first : comparable across index and vertex reorders
+     */
+    static std::vector<Triangle> CollectTriangles(const std::vector<float>& vertices, std::span<const uint32_t> indices, uint32_t first_vertex = 0)
+    {
+        std::vector<Triangle> triangles;
+        for (size_t t = 0; t < indices.size() / 3; ++t)
+        {
+            std::array<std::array<float, 3>, 3> corners;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const float* p = &vertices[(first_vertex + indices[t * 3 + k]) * VertexStride];
+                corners[k]     = {p[0], p[1], p[2]};
+            }
+            std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+
+            Triangle& triangle = triangles.emplace_back();
+            for (size_t k = 0; k < 3; ++k)
+            {
+                std::copy(corners[k].begin(), corners[k].end(), triangle.begin() + k * 3);
+            }
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+};
+
+TEST_F(MeshOptimizerTest, AnalyzeVertexCache)
+{
+    /* Two triangles sharing an edge : 4 transforms, the second triangle hits twice */
+    std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 3};
+    auto                  stats   = MeshOptimizer::AnalyzeVertexCache(indices, 4);
+    EXPECT_EQ(stats.TransformedVertices, 4u);
+    EXPECT_FLOAT_EQ(stats.ACMR, 2.0f);
+    EXPECT_FLOAT_EQ(stats.ATVR, 1.0f);
+
+    /* A cache of 3 entries evicts vertex 0 before it is used again */
+    std::vector<uint32_t> evicting = {0, 1, 2, 3, 4, 5, 0, 1, 2};
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(evicting, 6, 3).TransformedVertices, 9u);
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(evicting, 6, 6).TransformedVertices, 6u);
+}
+
+TEST_F(MeshOptimizerTest, VertexCacheOrderImprovesMetrics)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateGrid(64, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    auto before    = MeshOptimizer::AnalyzeVertexCache(indices, vertex_count);
+    auto triangles = CollectTriangles(vertices, indices);
+
+    MeshOptimizer::OptimizeVertexCache(indices, vertex_count);
+    auto after = MeshOptimizer::AnalyzeVertexCache(indices, vertex_count);
+
+    EXPECT_GT(before.ACMR, 2.0f);
+    EXPECT_LT(after.ACMR, 0.8f);
+    EXPECT_LT(after.ATVR, 1.6f);
+    EXPECT_EQ(CollectTriangles(vertices, indices), triangles);
+}
+
+TEST_F(MeshOptimizerTest, VertexFetchKeepsGeometry)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateGrid(16, vertices, indices);
+
+    /* Drop the last triangles : some vertices end up unreferenced, they must be kept */
+    indices.resize(indices.size() - 30);
+    auto triangles    = CollectTriangles(vertices, indices);
+    auto vertex_count = vertices.size();
+
+    MeshOptimizer::OptimizeVertexFetch(indices, vertices, VertexStride);
+
+    ASSERT_EQ(vertices.size(), vertex_count);
+    EXPECT_EQ(CollectTriangles(vertices, indices), triangles);
+
+    /* First use order : every index is at most one past the largest index seen before it */
+    uint32_t next_vertex = 0;
+    for (uint32_t index : indices)
+    {
+        ASSERT_LE(index, next_vertex);
+        next_vertex = std::max(next_vertex, index + 1);
+    }
+}
+
+TEST_F(MeshOptimizerTest, OverdrawRespectsThreshold)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateGrid(48, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    MeshOptimizer::OptimizeVertexCache(indices, vertex_count);
+    auto cache_order = indices;
+    auto reference   = MeshOptimizer::AnalyzeVertexCache(indices, vertex_count);
+    auto triangles   = CollectTriangles(vertices, indices);
+
+    for (float threshold : {1.0f, 1.05f, 3.0f})
+    {
+        indices = cache_order;
+        MeshOptimizer::OptimizeOverdraw(indices, vertices, VertexStride, vertex_count, 16, threshold);
+
+        auto stats = MeshOptimizer::AnalyzeVertexCache(indices, vertex_count);
+        EXPECT_LE(stats.ACMR, reference.ACMR * threshold + 1e-5f);
+        EXPECT_EQ(CollectTriangles(vertices, indices), triangles);
+    }
+}
+
+TEST_F(MeshOptimizerTest, OptimizeMeshesPerMeshRanges)
+{
+    std::vector<float>     vertices;
+    std::vector<uint32_t>  indices;
+    std::vector<MeshVNext> meshes;
+    for (uint32_t m = 0; m < 5; ++m)
+    {
+        MeshVNext& mesh   = meshes.emplace_back();
+        mesh.VertexOffset = uint32_t(vertices.size() / VertexStride);
+        mesh.IndexOffset  = uint32_t(indices.size());
+        GenerateGrid(8 + m * 6, vertices, indices, m);
+        mesh.VertexCount  = uint32_t(vertices.size() / VertexStride) - mesh.VertexOffset;
+        mesh.IndexCount   = uint32_t(indices.size()) - mesh.IndexOffset;
+    }
+
+    auto triangles_fn = [&](const MeshVNext& mesh) {
+        return CollectTriangles(vertices, std::span<const uint32_t>(indices).subspan(mesh.IndexOffset, mesh.IndexCount), mesh.VertexOffset);
+    };
+
+    std::vector<std::vector<Triangle>> triangles;
+    for (const auto& mesh : meshes)
+    {
+        triangles.push_back(triangles_fn(mesh));
+    }
+
+    auto stats = MeshOptimizer::OptimizeMeshes(vertices, VertexStride, indices, meshes);
+    EXPECT_EQ(stats.Before.TriangleCount, indices.size() / 3);
+    EXPECT_EQ(stats.After.VertexCount, vertices.size() / VertexStride);
+    EXPECT_LT(stats.After.ACMR, stats.Before.ACMR);
+    EXPECT_LT(stats.After.ATVR, stats.Before.ATVR);
+
+    for (size_t m = 0; m < meshes.size(); ++m)
+    {
+        EXPECT_EQ(triangles_fn(meshes[m]), triangles[m]);
+        for (uint32_t i = 0; i < meshes[m].IndexCount; ++i)
+        {
+            ASSERT_LT(indices[meshes[m].IndexOffset + i], meshes[m].VertexCount);
+        }
+    }
+
+    /* Disabled : metrics only, nothing moves */
+    auto copy     = indices;
+    auto disabled = MeshOptimizer::OptimizeMeshes(vertices, VertexStride, indices, meshes, {.Enabled = false});
+    EXPECT_EQ(indices, copy);
+    EXPECT_FLOAT_EQ(disabled.Before.ACMR, disabled.After.ACMR);
+}
+
+TEST_F(MeshOptimizerTest, InvalidIndexRangesAreLeftUntouched)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateGrid(12, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    /* An index past the vertex count, then a count that isn't a multiple of 3 */
+    auto out_of_range                     = indices;
+    out_of_range[out_of_range.size() / 2] = vertex_count;
+    auto truncated                        = std::vector<uint32_t>(indices.begin(), indices.end() - 1);
+    auto vertices_copy                    = vertices;
+
+    for (auto invalid : {out_of_range, truncated})
+    {
+        auto expected = invalid;
+        MeshOptimizer::OptimizeVertexCache(invalid, vertex_count);
+        MeshOptimizer::OptimizeOverdraw(invalid, vertices, VertexStride, vertex_count);
+        MeshOptimizer::OptimizeVertexFetch(invalid, vertices, VertexStride);
+        EXPECT_EQ(invalid, expected);
+        EXPECT_EQ(vertices, vertices_copy);
+    }
+}
+
+TEST_F(MeshOptimizerTest, OptimizeMeshesSkipsNonTriangleMeshes)
+{
+    std::vector<float>     vertices;
+    std::vector<uint32_t>  indices;
+    std::vector<MeshVNext> meshes;
+    GenerateGrid(10, vertices, indices);
+    meshes.push_back({.VertexCount = uint32_t(vertices.size() / VertexStride), .IndexCount = uint32_t(indices.size())});
+
+    /* A line list sharing the grid vertices, its index count is a multiple of 3 on purpose */
+    const uint32_t line_offset = uint32_t(indices.size());
+    for (uint32_t v = 0; v + 1 < 7; ++v)
+    {
+        indices.insert(indices.end(), {v, v + 1});
+    }
+    meshes.push_back({.VertexCount = meshes[0].VertexCount, .IndexCount = uint32_t(indices.size()) - line_offset, .IndexOffset = line_offset, .FaceSize = 2});
+
+    /* A triangle list with an index past its vertex count */
+    const uint32_t broken_offset = uint32_t(indices.size());
+    indices.insert(indices.end(), {0, 1, 2, 2, 1, meshes[0].VertexCount});
+    meshes.push_back({.VertexCount = meshes[0].VertexCount, .IndexCount = 6, .IndexOffset = broken_offset});
+
+    auto triangle_copy = std::vector<uint32_t>(indices.begin(), indices.begin() + line_offset);
+    auto skipped_copy  = std::vector<uint32_t>(indices.begin() + line_offset, indices.end());
+
+    auto stats = MeshOptimizer::OptimizeMeshes(vertices, VertexStride, indices, meshes);
+    EXPECT_EQ(stats.Before.TriangleCount, line_offset / 3);
+    EXPECT_EQ(stats.After.VertexCount, meshes[0].VertexCount);
+    EXPECT_NE(std::vector<uint32_t>(indices.begin(), indices.begin() + line_offset), triangle_copy);
+    EXPECT_EQ(std::vector<uint32_t>(indices.begin() + line_offset, indices.end()), skipped_copy);
+}
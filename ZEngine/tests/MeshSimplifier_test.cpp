@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <Rendering/Meshes/MeshSimplifier.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace ZEngine::Rendering::Meshes;
+
+class MeshSimplifierTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t VertexStride = 8;
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static void AddVertex(std::vector<float>& vertices, const glm::vec3& position, const glm::vec3& normal)
+    {
+        vertices.insert(vertices.end(), {position.x, position.y, position.z, normal.x, normal.y, normal.z, 0.0f, 0.0f});
+    }
+
+    /*
+     * Closed unit sphere, vertices are shared across the seam and at the poles
+     */
+    static void GenerateSphere(uint32_t rings, uint32_t segments, std::vector<float>& vertices, std::vector<uint32_t>& indices)
+    {
+        AddVertex(vertices, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+        for (uint32_t r = 1; r < rings; ++r)
+        {
+            float theta = float(M_PI) * float(r) / float(rings);
+            for (uint32_t s = 0; s < segments; ++s)
+            {
+                float     phi = 2.0f * float(M_PI) * float(s) / float(segments);
+                glm::vec3 p   = {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+                AddVertex(vertices, p, p);
+            }
+        }
+        AddVertex(vertices, {0.0f, -1.0f, 0.0f}, {0.0f, -1.0f, 0.0f});
+
+        const uint32_t south     = 1 + (rings - 1) * segments;
+        auto           vertex_fn = [segments](uint32_t ring, uint32_t segment) { return 1 + (ring - 1) * segments + (segment % segments); };
+        for (uint32_t s = 0; s < segments; ++s)
+        {
+            indices.insert(indices.end(), {0, vertex_fn(1, s + 1), vertex_fn(1, s)});
+            indices.insert(indices.end(), {south, vertex_fn(rings - 1, s), vertex_fn(rings - 1, s + 1)});
+        }
+        for (uint32_t r = 1; r + 1 < rings; ++r)
+        {
+            for (uint32_t s = 0; s < segments; ++s)
+            {
+                indices.insert(indices.end(), {vertex_fn(r, s), vertex_fn(r, s + 1), vertex_fn(r + 1, s)});
+                indices.insert(indices.end(), {vertex_fn(r, s + 1), vertex_fn(r + 1, s + 1), vertex_fn(r + 1, s)});
+            }
+        }
+    }
+
+    static void GenerateGrid(uint32_t size, std::vector<float>& vertices, std::vector<uint32_t>& indices)
+    {
+        const uint32_t row = size + 1;
+        for (uint32_t y = 0; y < row; ++y)
+        {
+            for (uint32_t x = 0; x < row; ++x)
+            {
+                AddVertex(vertices, {float(x), float(y), 0.0f}, {0.0f, 0.0f, 1.0f});
+            }
+        }
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                uint32_t v0 = y * row + x;
+                indices.insert(indices.end(), {v0, v0 + 1, v0 + row, v0 + 1, v0 + row + 1, v0 + row});
+            }
+        }
+    }
+
+    static glm::vec3 Position(const std::vector<float>& vertices, uint32_t v)
+    {
+        return glm::vec3(vertices[v * VertexStride], vertices[v * VertexStride + 1], vertices[v * VertexStride + 2]);
+    }
+
+    static glm::vec3 SignedArea(const std::vector<float>& vertices, std::span<const uint32_t> indices)
+    {
+        glm::vec3 area(0.0f);
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            glm::vec3 p0  = Position(vertices, indices[t]);
+            area         += glm::cross(Position(vertices, indices[t + 1]) - p0, Position(vertices, indices[t + 2]) - p0) * 0.5f;
+        }
+        return area;
+    }
+};
+
+TEST_F(MeshSimplifierTest, FlatGridCollapsesWithoutError)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateGrid(32, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    auto result = MeshSimplifier::Simplify(indices, vertices, VertexStride, vertex_count, 0, 1e-4f);
+
+    /* Only the locked border is left : about one triangle per border vertex */
+    EXPECT_LT(result.Indices.size(), indices.size() / 8);
+    EXPECT_LE(result.Error, 1e-4f);
+
+    /* Same surface : no hole, no fold */
+    glm::vec3 area = SignedArea(vertices, result.Indices);
+    EXPECT_NEAR(area.z, 32.0f * 32.0f, 1e-2f);
+    for (size_t t = 0; t < result.Indices.size(); t += 3)
+    {
+        glm::vec3 p0 = Position(vertices, result.Indices[t]);
+        EXPECT_GT(glm::cross(Position(vertices, result.Indices[t + 1]) - p0, Position(vertices, result.Indices[t + 2]) - p0).z, 0.0f);
+    }
+}
+
+TEST_F(MeshSimplifierTest, SphereRespectsErrorBound)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(64, 128, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    for (float target_error : {0.001f, 0.01f, 0.05f})
+    {
+        auto result = MeshSimplifier::Simplify(indices, vertices, VertexStride, vertex_count, 0, target_error);
+        EXPECT_LE(result.Error, target_error);
+        EXPECT_LT(result.Indices.size(), indices.size());
+
+        /* Vertices stay on the sphere, the faces between them sag by at most the error */
+        float max_sag = 0.0f;
+        for (size_t t = 0; t < result.Indices.size(); t += 3)
+        {
+            glm::vec3 center = (Position(vertices, result.Indices[t]) + Position(vertices, result.Indices[t + 1]) + Position(vertices, result.Indices[t + 2])) * (1.0f / 3.0f);
+            max_sag          = std::max(max_sag, 1.0f - glm::length(center));
+        }
+        EXPECT_LE(max_sag, target_error);
+    }
+
+    /* A larger budget reduces more */
+    auto fine   = MeshSimplifier::Simplify(indices, vertices, VertexStride, vertex_count, 0, 0.002f);
+    auto coarse = MeshSimplifier::Simplify(indices, vertices, VertexStride, vertex_count, 0, 0.02f);
+    EXPECT_LT(coarse.Indices.size(), fine.Indices.size());
+    EXPECT_LT(coarse.Indices.size(), indices.size() / 4);
+}
+
+TEST_F(MeshSimplifierTest, StopsAtTargetCount)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(32, 64, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    const size_t target = (indices.size() / 3 / 2) * 3;
+    auto         result = MeshSimplifier::Simplify(indices, vertices, VertexStride, vertex_count, target, 1.0f);
+    EXPECT_LE(result.Indices.size(), target);
+    EXPECT_GT(result.Indices.size(), target * 8 / 10);
+
+    /* The volume keeps its orientation */
+    auto unchanged = MeshSimplifier::Simplify(indices, vertices, VertexStride, vertex_count, indices.size(), 1.0f);
+    EXPECT_EQ(unchanged.Indices, indices);
+    EXPECT_EQ(unchanged.Error, 0.0f);
+}
+
+TEST_F(MeshSimplifierTest, LodChainIsMonotonic)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(64, 128, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    auto chain = MeshSimplifier::GenerateLodChain(indices, vertices, VertexStride, vertex_count, 0.05f);
+    ASSERT_GE(chain.size(), 3u);
+    ASSERT_LE(chain.size(), size_t(MAX_MESH_LOD_COUNT));
+
+    size_t previous_count = indices.size();
+    float  previous_error = 0.0f;
+    for (const auto& lod : chain)
+    {
+        EXPECT_LE(lod.Indices.size() * 10, previous_count * 9);
+        EXPECT_GE(lod.Error, previous_error);
+        EXPECT_LE(lod.Error, 0.05f);
+        previous_count = lod.Indices.size();
+        previous_error = lod.Error;
+    }
+}
+
+TEST_F(MeshSimplifierTest, GenerateMeshLodsAppendsLevels)
+{
+    std::vector<float>     vertices;
+    std::vector<uint32_t>  indices;
+    std::vector<MeshVNext> meshes;
+
+    /* A sphere, a mesh too small to simplify and a grid, indices local to each mesh */
+    for (int m = 0; m < 3; ++m)
+    {
+        MeshVNext& mesh   = meshes.emplace_back();
+        mesh.VertexOffset = uint32_t(vertices.size() / VertexStride);
+        mesh.IndexOffset  = uint32_t(indices.size());
+
+        std::vector<float>    mesh_vertices;
+        std::vector<uint32_t> mesh_indices;
+        (m == 0) ? GenerateSphere(32, 64, mesh_vertices, mesh_indices) : GenerateGrid(m == 1 ? 4 : 24, mesh_vertices, mesh_indices);
+        vertices.insert(vertices.end(), mesh_vertices.begin(), mesh_vertices.end());
+        indices.insert(indices.end(), mesh_indices.begin(), mesh_indices.end());
+
+        mesh.VertexCount = uint32_t(mesh_vertices.size() / VertexStride);
+        mesh.IndexCount  = uint32_t(mesh_indices.size());
+        for (uint32_t v = 0; v < mesh.VertexCount; ++v)
+        {
+            mesh.Bounds.Expand(Position(mesh_vertices, v));
+        }
+    }
+
+    const size_t              base_index_count = indices.size();
+    std::vector<MeshLodChain> lod_chains;
+    MeshSimplifier::GenerateMeshLods(vertices, VertexStride, indices, meshes, lod_chains);
+
+    ASSERT_EQ(lod_chains.size(), meshes.size());
+    EXPECT_GT(lod_chains[0].LodCount, 0u);
+    EXPECT_EQ(lod_chains[1].LodCount, 0u);
+    EXPECT_GT(lod_chains[2].LodCount, 0u);
+
+    size_t expected_offset = base_index_count;
+    for (size_t m = 0; m < meshes.size(); ++m)
+    {
+        uint32_t previous_count = meshes[m].IndexCount;
+        for (uint32_t level = 0; level < lod_chains[m].LodCount; ++level)
+        {
+            const auto& lod = lod_chains[m].Lods[level];
+            EXPECT_EQ(lod.IndexOffset, expected_offset);
+            EXPECT_LT(lod.IndexCount, previous_count);
+            for (uint32_t i = 0; i < lod.IndexCount; ++i)
+            {
+                ASSERT_LT(indices[lod.IndexOffset + i], meshes[m].VertexCount);
+            }
+            expected_offset += lod.IndexCount;
+            previous_count   = lod.IndexCount;
+        }
+    }
+    EXPECT_EQ(indices.size(), expected_offset);
+}
@@ -0,0 +1,364 @@
+#include <gtest/gtest.h>
+#include <Rendering/Meshes/MeshletBuilder.h>
+#include <Rendering/Scenes/SceneCulling.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+using namespace ZEngine::Rendering::Meshes;
+using namespace ZEngine::Rendering::Scenes;
+
+class MeshletBuilderTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t VertexStride = 8;
+
+    using Triangle = std::array<uint32_t, 3>;
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static void AddVertex(std::vector<float>& vertices, const glm::vec3& position)
+    {
+        vertices.insert(vertices.end(), {position.x, position.y, position.z, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f});
+    }
+
+    /*
+     * Closed unit sphere, counter clockwise seen from outside
+     */
+    static void GenerateSphere(uint32_t rings, uint32_t segments, std::vector<float>& vertices, std::vector<uint32_t>& indices)
+    {
+        const uint32_t base = uint32_t(vertices.size() / VertexStride);
+        AddVertex(vertices, {0.0f, 1.0f, 0.0f});
+        for (uint32_t r = 1; r < rings; ++r)
+        {
+            float theta = float(M_PI) * float(r) / float(rings);
+            for (uint32_t s = 0; s < segments; ++s)
+            {
+                float phi = 2.0f * float(M_PI) * float(s) / float(segments);
+                AddVertex(vertices, {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            }
+        }
+        AddVertex(vertices, {0.0f, -1.0f, 0.0f});
+
+        const uint32_t south     = base + 1 + (rings - 1) * segments;
+        auto           vertex_fn = [base, segments](uint32_t ring, uint32_t segment) { return base + 1 + (ring - 1) * segments + (segment % segments); };
+        for (uint32_t s = 0; s < segments; ++s)
+        {
+            indices.insert(indices.end(), {base, vertex_fn(1, s + 1), vertex_fn(1, s)});
+            indices.insert(indices.end(), {south, vertex_fn(rings - 1, s), vertex_fn(rings - 1, s + 1)});
+        }
+        for (uint32_t r = 1; r + 1 < rings; ++r)
+        {
+            for (uint32_t s = 0; s < segments; ++s)
+            {
+                indices.insert(indices.end(), {vertex_fn(r, s), vertex_fn(r, s + 1), vertex_fn(r + 1, s)});
+                indices.insert(indices.end(), {vertex_fn(r, s + 1), vertex_fn(r + 1, s + 1), vertex_fn(r + 1, s)});
+            }
+        }
+    }
+
+    static glm::vec3 Position(const std::vector<float>& vertices, uint32_t v)
+    {
+        return glm::vec3(vertices[v * VertexStride], vertices[v * VertexStride + 1], vertices[v * VertexStride + 2]);
+    }
+
+    /*
+     * Same triangle and winding whatever the first corner
+     */
+    static Triangle Canonical(uint32_t a, uint32_t b, uint32_t c)
+    {
+        if ((b < a) && (b <= c))
+        {
+            return {b, c, a};
+        }
+        if ((c < a) && (c < b))
+        {
+            return {c, a, b};
+        }
+        return {a, b, c};
+    }
+
+    static std::vector<Triangle> MeshletTriangles(const MeshletData& data)
+    {
+        std::vector<Triangle> triangles;
+        for (const auto& meshlet : data.Meshlets)
+        {
+            for (uint32_t t = 0; t < meshlet.TriangleCount; ++t)
+            {
+                const uint8_t*  local    = &data.Triangles[meshlet.TriangleOffset + t * 3];
+                const uint32_t* vertices = &data.Vertices[meshlet.VertexOffset];
+                triangles.push_back(Canonical(vertices[local[0]], vertices[local[1]], vertices[local[2]]));
+            }
+        }
+        return triangles;
+    }
+};
+
+TEST_F(MeshletBuilderTest, RespectsSizeLimits)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(48, 96, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    for (auto [max_vertices, max_triangles] : std::vector<std::pair<uint32_t, uint32_t>>{{64, 124}, {32, 32}, {128, 64}, {255, 512}, {3, 1}})
+    {
+        MeshletOptions options = {.MaxVertices = max_vertices, .MaxTriangles = max_triangles};
+        MeshletData    data    = MeshletBuilder::BuildMeshlets(indices, vertices, VertexStride, vertex_count, options);
+
+        size_t triangle_count = 0;
+        for (const auto& meshlet : data.Meshlets)
+        {
+            ASSERT_GT(meshlet.TriangleCount, 0u);
+            ASSERT_LE(meshlet.VertexCount, max_vertices);
+            ASSERT_LE(meshlet.TriangleCount, max_triangles);
+            ASSERT_EQ(meshlet.TriangleOffset % 4, 0u);
+            ASSERT_LE(meshlet.TriangleOffset + meshlet.TriangleCount * 3, data.Triangles.size());
+
+            /* Meshlet vertices are distinct and all used */
+            std::vector<uint32_t> meshlet_vertices(data.Vertices.begin() + meshlet.VertexOffset, data.Vertices.begin() + meshlet.VertexOffset + meshlet.VertexCount);
+            std::vector<bool>     used(meshlet.VertexCount, false);
+            std::sort(meshlet_vertices.begin(), meshlet_vertices.end());
+            ASSERT_EQ(std::adjacent_find(meshlet_vertices.begin(), meshlet_vertices.end()), meshlet_vertices.end());
+            for (uint32_t i = 0; i < meshlet.TriangleCount * 3; ++i)
+            {
+                uint8_t local = data.Triangles[meshlet.TriangleOffset + i];
+                ASSERT_LT(local, meshlet.VertexCount);
+                used[local] = true;
+            }
+            EXPECT_TRUE(std::all_of(used.begin(), used.end(), [](bool u) { return u; }));
+            triangle_count += meshlet.TriangleCount;
+        }
+        EXPECT_EQ(triangle_count, indices.size() / 3);
+    }
+
+    /* Default limits keep meshlets mostly full on a connected surface */
+    MeshletData data = MeshletBuilder::BuildMeshlets(indices, vertices, VertexStride, vertex_count);
+    EXPECT_LT(data.Meshlets.size(), (indices.size() / 3) / 124 * 2);
+}
+
+TEST_F(MeshletBuilderTest, CoversEveryTriangleExactly)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(24, 48, vertices, indices);
+    /* Disconnected second part, a degenerate and a duplicated triangle */
+    GenerateSphere(8, 16, vertices, indices);
+    indices.insert(indices.end(), {5, 5, 9, 10, 11, 12, 10, 11, 12});
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    std::mt19937 rng(17);
+    for (int round = 0; round < 3; ++round)
+    {
+        std::vector<Triangle> expected;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            expected.push_back(Canonical(indices[i], indices[i + 1], indices[i + 2]));
+        }
+
+        MeshletData           data   = MeshletBuilder::BuildMeshlets(indices, vertices, VertexStride, vertex_count, {.MaxVertices = 48, .MaxTriangles = 64});
+        std::vector<Triangle> actual = MeshletTriangles(data);
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(actual, expected);
+
+        /* Same again from a shuffled triangle order */
+        std::vector<Triangle> shuffled;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            shuffled.push_back({indices[i], indices[i + 1], indices[i + 2]});
+        }
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+        indices.clear();
+        for (const auto& triangle : shuffled)
+        {
+            indices.insert(indices.end(), triangle.begin(), triangle.end());
+        }
+    }
+
+    EXPECT_TRUE(MeshletBuilder::BuildMeshlets({}, vertices, VertexStride, vertex_count).Meshlets.empty());
+}
+
+TEST_F(MeshletBuilderTest, BoundsEncloseMeshlets)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(32, 64, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    MeshletData data      = MeshletBuilder::BuildMeshlets(indices, vertices, VertexStride, vertex_count);
+    size_t      with_cone = 0;
+    for (const auto& meshlet : data.Meshlets)
+    {
+        glm::vec3 center = glm::vec3(meshlet.Center[0], meshlet.Center[1], meshlet.Center[2]);
+        for (uint32_t v = 0; v < meshlet.VertexCount; ++v)
+        {
+            ASSERT_LE(glm::length(Position(vertices, data.Vertices[meshlet.VertexOffset + v]) - center), meshlet.Radius * (1.0f + 1e-5f));
+        }
+        /* Small patches of a sphere, far from a hemisphere */
+        EXPECT_LT(meshlet.Radius, 0.75f);
+
+        if (meshlet.ConeCutoff < 1.0f)
+        {
+            ++with_cone;
+            EXPECT_NEAR(glm::length(glm::vec3(meshlet.ConeAxis[0], meshlet.ConeAxis[1], meshlet.ConeAxis[2])), 1.0f, 1e-5f);
+            /* The axis of a sphere patch points away from the center */
+            EXPECT_GT(glm::dot(glm::vec3(meshlet.ConeAxis[0], meshlet.ConeAxis[1], meshlet.ConeAxis[2]), glm::normalize(center)), 0.9f);
+        }
+    }
+    EXPECT_EQ(with_cone, data.Meshlets.size());
+}
+
+TEST_F(MeshletBuilderTest, ConeAndFrustumCullingAreConservative)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(32, 64, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+    MeshletData    data         = MeshletBuilder::BuildMeshlets(indices, vertices, VertexStride, vertex_count);
+
+    std::mt19937                          rng(29);
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    size_t                                culled = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        glm::vec3 camera;
+        do
+        {
+            camera = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)) * 6.0f;
+        } while (glm::length(camera) < 1.5f);
+
+        for (const auto& meshlet : data.Meshlets)
+        {
+            if (!MeshletBuilder::IsBackfacing(meshlet, camera))
+            {
+                continue;
+            }
+            ++culled;
+
+            /* No triangle of a rejected meshlet faces the camera */
+            for (uint32_t t = 0; t < meshlet.TriangleCount; ++t)
+            {
+                const uint8_t* local = &data.Triangles[meshlet.TriangleOffset + t * 3];
+                glm::vec3      p0    = Position(vertices, data.Vertices[meshlet.VertexOffset + local[0]]);
+                glm::vec3      p1    = Position(vertices, data.Vertices[meshlet.VertexOffset + local[1]]);
+                glm::vec3      p2    = Position(vertices, data.Vertices[meshlet.VertexOffset + local[2]]);
+                ASSERT_GE(glm::dot(glm::cross(p1 - p0, p2 - p0), p0 - camera), -1e-6f);
+            }
+        }
+    }
+    /* Seen from outside, about half of a sphere faces away */
+    EXPECT_GT(culled, data.Meshlets.size() * 64 / 4);
+
+    /* A frustum around one side of the sphere keeps the meshlets it touches, seen from that side */
+    Frustum frustum   = {};
+    frustum.Planes[0] = glm::vec4(1.0f, 0.0f, 0.0f, -0.5f); /* x >= 0.5 */
+    for (int p = 1; p < 6; ++p)
+    {
+        frustum.Planes[p] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    std::vector<uint32_t> visible;
+    SceneCuller::CullMeshlets(frustum, glm::vec3(10.0f, 0.0f, 0.0f), data.Meshlets, visible);
+    EXPECT_GT(visible.size(), 0u);
+    EXPECT_LT(visible.size(), data.Meshlets.size() / 2);
+    for (size_t m = 0; m < data.Meshlets.size(); ++m)
+    {
+        bool touches = false;
+        for (uint32_t v = 0; v < data.Meshlets[m].VertexCount; ++v)
+        {
+            touches |= Position(vertices, data.Vertices[data.Meshlets[m].VertexOffset + v]).x >= 0.5f;
+        }
+        if (touches)
+        {
+            EXPECT_TRUE(std::find(visible.begin(), visible.end(), uint32_t(m)) != visible.end());
+        }
+    }
+}
+
+TEST_F(MeshletBuilderTest, GenerateMeshMeshletsConcatenatesMeshes)
+{
+    std::vector<float>     vertices;
+    std::vector<uint32_t>  indices;
+    std::vector<MeshVNext> meshes;
+    for (uint32_t rings : {16u, 4u, 24u})
+    {
+        MeshVNext& mesh   = meshes.emplace_back();
+        mesh.VertexOffset = uint32_t(vertices.size() / VertexStride);
+        mesh.IndexOffset  = uint32_t(indices.size());
+
+        std::vector<float>    mesh_vertices;
+        std::vector<uint32_t> mesh_indices;
+        GenerateSphere(rings, rings * 2, mesh_vertices, mesh_indices);
+        vertices.insert(vertices.end(), mesh_vertices.begin(), mesh_vertices.end());
+        indices.insert(indices.end(), mesh_indices.begin(), mesh_indices.end());
+        mesh.VertexCount = uint32_t(mesh_vertices.size() / VertexStride);
+        mesh.IndexCount  = uint32_t(mesh_indices.size());
+    }
+    meshes.push_back({.IndexCount = 0, .IndexOffset = uint32_t(indices.size())});
+
+    MeshletData               data;
+    std::vector<MeshletRange> ranges;
+    MeshletBuilder::GenerateMeshMeshlets(vertices, VertexStride, indices, meshes, data, ranges);
+
+    ASSERT_EQ(ranges.size(), meshes.size());
+    EXPECT_EQ(ranges.back().MeshletCount, 0u);
+    EXPECT_EQ(data.Triangles.size() % 4, 0u);
+
+    uint32_t expected_offset = 0;
+    for (size_t m = 0; m < meshes.size(); ++m)
+    {
+        EXPECT_EQ(ranges[m].MeshletOffset, expected_offset);
+        size_t triangle_count = 0;
+        for (uint32_t i = 0; i < ranges[m].MeshletCount; ++i)
+        {
+            const auto& meshlet = data.Meshlets[ranges[m].MeshletOffset + i];
+            for (uint32_t v = 0; v < meshlet.VertexCount; ++v)
+            {
+                ASSERT_LT(data.Vertices[meshlet.VertexOffset + v], meshes[m].VertexCount);
+            }
+            triangle_count += meshlet.TriangleCount;
+        }
+        EXPECT_EQ(triangle_count, meshes[m].IndexCount / 3);
+        expected_offset += ranges[m].MeshletCount;
+    }
+    EXPECT_EQ(expected_offset, data.Meshlets.size());
+}
+
+TEST_F(MeshletBuilderTest, SkipsInvalidAndNonTriangleInput)
+{
+    std::vector<float>    vertices;
+    std::vector<uint32_t> indices;
+    GenerateSphere(8, 16, vertices, indices);
+    const uint32_t vertex_count = uint32_t(vertices.size() / VertexStride);
+
+    auto out_of_range                     = indices;
+    out_of_range[out_of_range.size() / 2] = vertex_count;
+    EXPECT_TRUE(MeshletBuilder::BuildMeshlets(out_of_range, vertices, VertexStride, vertex_count).Meshlets.empty());
+
+    auto truncated = std::vector<uint32_t>(indices.begin(), indices.end() - 2);
+    EXPECT_TRUE(MeshletBuilder::BuildMeshlets(truncated, vertices, VertexStride, vertex_count).Meshlets.empty());
+
+    /* A line list over the same vertices, its index count is a multiple of 3 on purpose */
+    std::vector<MeshVNext> meshes;
+    meshes.push_back({.VertexCount = vertex_count, .IndexCount = uint32_t(indices.size())});
+    const uint32_t line_offset = uint32_t(indices.size());
+    for (uint32_t v = 0; v + 1 < 7; ++v)
+    {
+        indices.insert(indices.end(), {v, v + 1});
+    }
+    meshes.push_back({.VertexCount = vertex_count, .IndexCount = uint32_t(indices.size()) - line_offset, .IndexOffset = line_offset, .FaceSize = 2});
+
+    MeshletData               data;
+    std::vector<MeshletRange> ranges;
+    MeshletBuilder::GenerateMeshMeshlets(vertices, VertexStride, indices, meshes, data, ranges);
+
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_GT(ranges[0].MeshletCount, 0u);
+    EXPECT_EQ(ranges[1].MeshletCount, 0u);
+    EXPECT_EQ(MeshletTriangles(data).size(), line_offset / 3);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <Serializers/PipelineCacheSerializer.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace ZEngine::Serializers;
+
+class PipelineCacheSerializerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_identity.VendorID      = 0x10005;
+        m_identity.DeviceID      = 0x0000;
+        m_identity.DriverVersion = (24u << 22) | (1u << 12);
+        for (uint8_t i = 0; i < 16; ++i)
+        {
+            m_identity.PipelineCacheUUID[i] = uint8_t(0xA0 + i);
+            m_identity.DriverUUID[i]        = uint8_t(0x10 + i);
+        }
+        m_blob     = MakeBlob(m_identity, 4096);
+        m_filename = (std::filesystem::temp_directory_path() / "zengine_pipeline_cache_test.zepipelines").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(m_filename);
+    }
+
+    /*
+     * What a driver returns from vkGetPipelineCacheData : a VkPipelineCacheHeaderVersionOne followed by opaque data
+     */
+    static std::vector<std::byte> MakeBlob(const PipelineCacheIdentity& identity, size_t payload_size)
+    {
+        std::vector<std::byte> blob(32 + payload_size);
+        uint32_t               header[4] = {32, 1, identity.VendorID, identity.DeviceID};
+        std::memcpy(blob.data(), header, sizeof(header));
+        std::memcpy(blob.data() + sizeof(header), identity.PipelineCacheUUID.data(), 16);
+        for (size_t i = 32; i < blob.size(); ++i)
+        {
+            blob[i] = std::byte(i * 31);
+        }
+        return blob;
+    }
+
+    PipelineCacheIdentity  m_identity;
+    std::vector<std::byte> m_blob;
+    std::string            m_filename;
+};
+
+TEST_F(PipelineCacheSerializerTest, RoundTrip)
+{
+    ASSERT_EQ(PipelineCacheSerializer::Write(m_filename, m_identity, m_blob), AssetContainerResult::SUCCESS);
+    EXPECT_FALSE(std::filesystem::exists(m_filename + ".tmp"));
+
+    std::vector<std::byte> data;
+    ASSERT_EQ(PipelineCacheSerializer::Load(m_filename, m_identity, data), PipelineCacheLoadResult::SUCCESS);
+    EXPECT_EQ(data, m_blob);
+
+    /* Saving again replaces the previous cache */
+    auto larger_blob = MakeBlob(m_identity, 10000);
+    ASSERT_EQ(PipelineCacheSerializer::Write(m_filename, m_identity, larger_blob), AssetContainerResult::SUCCESS);
+    ASSERT_EQ(PipelineCacheSerializer::Load(m_filename, m_identity, data), PipelineCacheLoadResult::SUCCESS);
+    EXPECT_EQ(data, larger_blob);
+}
+
+TEST_F(PipelineCacheSerializerTest, OtherDeviceOrDriverInvalidates)
+{
+    ASSERT_EQ(PipelineCacheSerializer::Write(m_filename, m_identity, m_blob), AssetContainerResult::SUCCESS);
+
+    std::vector<PipelineCacheIdentity> others(5, m_identity);
+    others[0].VendorID              = 0x10DE;
+    others[1].DeviceID              = 0x2684;
+    others[2].DriverVersion        += 1;
+    others[3].PipelineCacheUUID[7] ^= 0xFF;
+    others[4].DriverUUID[15]       ^= 0x01;
+
+    for (const auto& other : others)
+    {
+        std::vector<std::byte> data = {std::byte(1)};
+        EXPECT_EQ(PipelineCacheSerializer::Load(m_filename, other, data), PipelineCacheLoadResult::IDENTITY_MISMATCH);
+        EXPECT_TRUE(data.empty());
+    }
+}
+
+TEST_F(PipelineCacheSerializerTest, RejectsMismatchingDriverHeader)
+{
+    /* Saved under the right identity, but the blob itself was produced for another device */
+    PipelineCacheIdentity other = m_identity;
+    other.DeviceID              = 42;
+    ASSERT_EQ(PipelineCacheSerializer::Write(m_filename, m_identity, MakeBlob(other, 64)), AssetContainerResult::SUCCESS);
+
+    std::vector<std::byte> data;
+    EXPECT_EQ(PipelineCacheSerializer::Load(m_filename, m_identity, data), PipelineCacheLoadResult::INVALID_DATA);
+    EXPECT_TRUE(data.empty());
+
+    EXPECT_TRUE(PipelineCacheSerializer::IsHeaderCompatible(m_blob, m_identity));
+    EXPECT_FALSE(PipelineCacheSerializer::IsHeaderCompatible(std::span(m_blob).first(31), m_identity));
+
+    auto bad_version = m_blob;
+    bad_version[4]   = std::byte(2);
+    EXPECT_FALSE(PipelineCacheSerializer::IsHeaderCompatible(bad_version, m_identity));
+
+    auto bad_size = m_blob;
+    bad_size[0]   = std::byte(16);
+    EXPECT_FALSE(PipelineCacheSerializer::IsHeaderCompatible(bad_size, m_identity));
+}
+
+TEST_F(PipelineCacheSerializerTest, MissingOrCorruptedFileIsUnavailable)
+{
+    std::vector<std::byte> data;
+    EXPECT_EQ(PipelineCacheSerializer::Load(m_filename, m_identity, data), PipelineCacheLoadResult::UNAVAILABLE);
+
+    ASSERT_EQ(PipelineCacheSerializer::Write(m_filename, m_identity, m_blob), AssetContainerResult::SUCCESS);
+    {
+        std::fstream file(m_filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-100, std::ios::end);
+        file.put(char(0x5A));
+    }
+    EXPECT_EQ(PipelineCacheSerializer::Load(m_filename, m_identity, data), PipelineCacheLoadResult::UNAVAILABLE);
+    EXPECT_TRUE(data.empty());
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <Serializers/SceneAssetSerializer.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace ZEngine::Rendering::Meshes;
+using namespace ZEngine::Rendering::Scenes;
+using namespace ZEngine::Serializers;
+
+/*
+ * Writes generated models to a temporary directory, every model gets its own sizes and content
+ */
+class SceneAssetSerializerTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t ModelCount = 24;
+
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "zengine_scene_asset_serializer_test";
+        std::filesystem::create_directories(m_directory);
+
+        for (size_t i = 0; i < ModelCount; ++i)
+        {
+            SceneRawData scene = GenerateScene(uint32_t(i));
+
+            auto& files        = m_files.emplace_back();
+            files.MeshPath     = (m_directory / (std::to_string(i) + ".zemeshes")).string();
+            files.MaterialPath = (m_directory / (std::to_string(i) + ".zematerials")).string();
+            files.ModelPath    = (m_directory / (std::to_string(i) + ".zemodel")).string();
+
+            ASSERT_EQ(SceneAssetSerializer::WriteMeshes(scene, files.MeshPath), AssetContainerResult::SUCCESS);
+            ASSERT_EQ(SceneAssetSerializer::WriteMaterials(scene, files.MaterialPath), AssetContainerResult::SUCCESS);
+            ASSERT_EQ(SceneAssetSerializer::WriteModel(scene, files.ModelPath), AssetContainerResult::SUCCESS);
+        }
+    }
+
+    void TearDown() override
+    {
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+
+    static SceneRawData GenerateScene(uint32_t seed)
+    {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+        std::uniform_int_distribution<size_t> count(1, 2000);
+
+        SceneRawData scene;
+        scene.Vertices.resize(count(rng) * 8);
+        for (auto& v : scene.Vertices)
+        {
+            v = value(rng);
+        }
+        scene.Indices.resize(count(rng) * 3);
+        for (auto& index : scene.Indices)
+        {
+            index = uint32_t(rng() % (scene.Vertices.size() / 8));
+        }
+
+        size_t node_count = 1 + (seed % 7);
+        scene.Meshes.resize(node_count);
+        scene.Materials.resize(node_count);
+        scene.MaterialFiles.resize(node_count);
+        scene.NodeHierarchies.resize(node_count);
+        scene.LocalTransforms.resize(node_count, glm::mat4(1.0f));
+        scene.GlobalTransforms.resize(node_count, glm::mat4(float(seed)));
+        for (uint32_t n = 0; n < node_count; ++n)
+        {
+            scene.Meshes[n].IndexCount          = n + seed;
+            scene.Meshes[n].VertexCount         = n * 3;
+            scene.Materials[n].AlbedoMap        = n + 1;
+            scene.NodeHierarchies[n].Parent     = int(n) - 1;
+            scene.NodeHierarchies[n].DepthLevel = int(n);
+            scene.LocalTransforms[n][3][0]      = value(rng);
+            std::snprintf(scene.MaterialFiles[n].AlbedoTexture, MAX_FILE_PATH_COUNT, "textures/%u_%u.png", seed, n);
+            scene.Names.push_back("node_" + std::to_string(seed) + "_" + std::to_string(n));
+            scene.MaterialNames.push_back("material_" + std::to_string(n));
+            scene.NodeNames[n]     = n;
+            scene.NodeMeshes[n]    = n;
+            scene.NodeMaterials[n] = node_count - 1 - n;
+        }
+        return scene;
+    }
+
+    template <typename T>
+    static bool SameBytes(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return (a.size() == b.size()) && (a.empty() || std::memcmp(a.data(), b.data(), sizeof(T) * a.size()) == 0);
+    }
+
+    static void ExpectSameScene(const SceneRawData& a, const SceneRawData& b)
+    {
+        EXPECT_TRUE(SameBytes(a.Vertices, b.Vertices));
+        EXPECT_TRUE(SameBytes(a.Indices, b.Indices));
+        EXPECT_TRUE(SameBytes(a.Meshes, b.Meshes));
+        EXPECT_TRUE(SameBytes(a.Materials, b.Materials));
+        EXPECT_TRUE(SameBytes(a.MaterialFiles, b.MaterialFiles));
+        EXPECT_TRUE(SameBytes(a.NodeHierarchies, b.NodeHierarchies));
+        EXPECT_TRUE(SameBytes(a.LocalTransforms, b.LocalTransforms));
+        EXPECT_TRUE(SameBytes(a.GlobalTransforms, b.GlobalTransforms));
+        EXPECT_EQ(a.Names, b.Names);
+        EXPECT_EQ(a.MaterialNames, b.MaterialNames);
+        EXPECT_EQ(a.NodeNames, b.NodeNames);
+        EXPECT_EQ(a.NodeMeshes, b.NodeMeshes);
+        EXPECT_EQ(a.NodeMaterials, b.NodeMaterials);
+    }
+
+    std::filesystem::path        m_directory;
+    std::vector<SceneAssetFiles> m_files;
+};
+
+TEST_F(SceneAssetSerializerTest, LoadSceneRoundTrip)
+{
+    for (size_t i = 0; i < ModelCount; ++i)
+    {
+        SceneRawData scene;
+        auto         load = SceneAssetSerializer::LoadScene(m_files[i], scene);
+        ASSERT_EQ(load.Result, AssetContainerResult::SUCCESS);
+        ExpectSameScene(scene, GenerateScene(uint32_t(i)));
+    }
+}
+
+TEST_F(SceneAssetSerializerTest, ParallelLoadMatchesSerialLoad)
+{
+    std::vector<SceneRawData> serial;
+    ASSERT_EQ(SceneAssetSerializer::LoadScenes(m_files, serial, 1).Result, AssetContainerResult::SUCCESS);
+    ASSERT_EQ(serial.size(), ModelCount);
+
+    for (size_t concurrency : {size_t(2), SceneAssetSerializer::DefaultLoadConcurrency, size_t(16)})
+    {
+        std::vector<SceneRawData> parallel;
+        ASSERT_EQ(SceneAssetSerializer::LoadScenes(m_files, parallel, concurrency).Result, AssetContainerResult::SUCCESS);
+        ASSERT_EQ(parallel.size(), serial.size());
+        for (size_t i = 0; i < serial.size(); ++i)
+        {
+            ExpectSameScene(parallel[i], serial[i]);
+        }
+    }
+}
+
+TEST_F(SceneAssetSerializerTest, ProgressIsAggregated)
+{
+    std::vector<size_t>       reported;
+    std::vector<SceneRawData> scenes;
+    auto                      load = SceneAssetSerializer::LoadScenes(m_files, scenes, 8, [&reported](size_t loaded_count, size_t total_count) {
+        EXPECT_EQ(total_count, ModelCount);
+        reported.push_back(loaded_count);
+    });
+
+    ASSERT_EQ(load.Result, AssetContainerResult::SUCCESS);
+    ASSERT_EQ(reported.size(), ModelCount);
+    for (size_t i = 0; i < reported.size(); ++i)
+    {
+        EXPECT_EQ(reported[i], i + 1);
+    }
+}
+
+TEST_F(SceneAssetSerializerTest, FailureCancelsRemainingLoads)
+{
+    /* Garbage in place of a model file : the load fails and reports it */
+    const size_t broken = ModelCount / 2;
+    {
+        std::ofstream out(m_files[broken].ModelPath, std::ios::binary | std::ios::trunc);
+        out << "not a container";
+    }
+
+    for (size_t concurrency : {size_t(1), size_t(4)})
+    {
+        std::vector<SceneRawData> scenes;
+        size_t                    progress_count = 0;
+        auto                      load           = SceneAssetSerializer::LoadScenes(m_files, scenes, concurrency, [&progress_count](size_t, size_t) { progress_count++; });
+
+        EXPECT_EQ(load.Result, AssetContainerResult::INVALID_MAGIC);
+        EXPECT_EQ(load.FileIndex, broken);
+        EXPECT_EQ(load.Filename, m_files[broken].ModelPath);
+        EXPECT_TRUE(scenes.empty());
+        EXPECT_LT(progress_count, ModelCount);
+    }
+
+    std::filesystem::remove(m_files[broken].MeshPath);
+    SceneRawData scene;
+    EXPECT_EQ(SceneAssetSerializer::LoadScene(m_files[broken], scene).Result, AssetContainerResult::IO_ERROR);
+}
+
+TEST_F(SceneAssetSerializerTest, EmptyPathsAreSkipped)
+{
+    SceneAssetFiles files = {.MeshPath = m_files[0].MeshPath};
+    SceneRawData    scene;
+    ASSERT_EQ(SceneAssetSerializer::LoadScene(files, scene).Result, AssetContainerResult::SUCCESS);
+    EXPECT_FALSE(scene.Vertices.empty());
+    EXPECT_TRUE(scene.Materials.empty());
+    EXPECT_TRUE(scene.NodeHierarchies.empty());
+
+    std::vector<SceneRawData> scenes;
+    EXPECT_EQ(SceneAssetSerializer::LoadScenes({}, scenes).Result, AssetContainerResult::SUCCESS);
+    EXPECT_TRUE(scenes.empty());
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <Rendering/Scenes/SceneCulling.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace ZEngine::Rendering::Meshes;
+using namespace ZEngine::Rendering::Scenes;
+
+class SceneCullingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+static Frustum MakeFrustum(const glm::vec3& eye, const glm::vec3& target, float far_plane = 500.0f)
+{
+    glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, far_plane);
+    glm::mat4 view       = glm::lookAtRH(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum::FromViewProjection(projection * view);
+}
+
+/*
+ * Small meshes scattered over a cube of the given half size, each one placed by its own transform
+ */
+struct CullingTestScene
+{
+    std::vector<BoundingBox> LocalBounds;
+    std::vector<uint32_t>    TransformIndices;
+    std::vector<glm::mat4>   GlobalTransforms;
+
+    CullingTestScene(size_t draw_count, float half_size, uint32_t seed = 7)
+    {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> position(-half_size, half_size);
+        std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+        for (size_t i = 0; i < draw_count; ++i)
+        {
+            BoundingBox box = {};
+            box.Expand(glm::vec3(-size(rng), -size(rng), -size(rng)));
+            box.Expand(glm::vec3(size(rng), size(rng), size(rng)));
+            LocalBounds.push_back(box);
+            TransformIndices.push_back(static_cast<uint32_t>(i));
+            GlobalTransforms.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), position(rng))));
+        }
+    }
+
+    std::vector<BoundingBox> ComputeWorldBounds() const
+    {
+        std::vector<BoundingBox> world_bounds;
+        for (size_t i = 0; i < LocalBounds.size(); ++i)
+        {
+            world_bounds.push_back(LocalBounds[i].Transform(GlobalTransforms[TransformIndices[i]]));
+        }
+        return world_bounds;
+    }
+};
+
+static std::vector<uint32_t> Sorted(std::span<const uint32_t> draws)
+{
+    std::vector<uint32_t> sorted(draws.begin(), draws.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+TEST_F(SceneCullingTest, FrustumClassifiesBoxes)
+{
+    Frustum     frustum = MakeFrustum(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 100.0f);
+
+    BoundingBox ahead   = {.Min = glm::vec3(-1.0f, -1.0f, -11.0f), .Max = glm::vec3(1.0f, 1.0f, -9.0f)};
+    BoundingBox behind  = {.Min = glm::vec3(-1.0f, -1.0f, 9.0f), .Max = glm::vec3(1.0f, 1.0f, 11.0f)};
+    BoundingBox far     = {.Min = glm::vec3(-1.0f, -1.0f, -200.0f), .Max = glm::vec3(1.0f, 1.0f, -150.0f)};
+    BoundingBox crosses = {.Min = glm::vec3(-1.0f, -1.0f, -120.0f), .Max = glm::vec3(1.0f, 1.0f, -90.0f)};
+    BoundingBox aside   = {.Min = glm::vec3(50.0f, -1.0f, -11.0f), .Max = glm::vec3(52.0f, 1.0f, -9.0f)};
+
+    EXPECT_EQ(frustum.Classify(ahead), FrustumTestResult::INSIDE);
+    EXPECT_EQ(frustum.Classify(behind), FrustumTestResult::OUTSIDE);
+    EXPECT_EQ(frustum.Classify(far), FrustumTestResult::OUTSIDE);
+    EXPECT_EQ(frustum.Classify(crosses), FrustumTestResult::INTERSECT);
+    EXPECT_EQ(frustum.Classify(aside), FrustumTestResult::OUTSIDE);
+}
+
+TEST_F(SceneCullingTest, TransformedBoxEnclosesCorners)
+{
+    BoundingBox box       = {.Min = glm::vec3(-1.0f, -2.0f, -3.0f), .Max = glm::vec3(1.0f, 2.0f, 3.0f)};
+    glm::mat4   transform = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, -5.0f));
+    transform[0]          = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
+    transform[1]          = glm::vec4(-1.0f, 0.0f, 0.0f, 0.0f);
+
+    BoundingBox world     = box.Transform(transform);
+    EXPECT_FLOAT_EQ(world.Min.x, 8.0f);
+    EXPECT_FLOAT_EQ(world.Max.x, 12.0f);
+    EXPECT_FLOAT_EQ(world.Min.y, -1.0f);
+    EXPECT_FLOAT_EQ(world.Max.y, 1.0f);
+    EXPECT_FLOAT_EQ(world.Min.z, -8.0f);
+    EXPECT_FLOAT_EQ(world.Max.z, -2.0f);
+
+    EXPECT_FALSE(BoundingBox{}.Valid());
+    EXPECT_FALSE(BoundingBox{}.Transform(transform).Valid());
+}
+
+TEST_F(SceneCullingTest, BvhSubtreesCoverContiguousItems)
+{
+    CullingTestScene scene(1000, 100.0f);
+    auto             world_bounds = scene.ComputeWorldBounds();
+
+    SceneBvh         bvh;
+    bvh.Build(world_bounds);
+
+    ASSERT_FALSE(bvh.Nodes.empty());
+    EXPECT_EQ(bvh.Items.size(), world_bounds.size());
+    EXPECT_EQ(bvh.Nodes[0].ItemCount, world_bounds.size());
+
+    for (size_t i = 0; i < bvh.Nodes.size(); ++i)
+    {
+        const auto& node = bvh.Nodes[i];
+        if (node.IsLeaf())
+        {
+            EXPECT_LE(node.ItemCount, SceneBvh::DefaultLeafSize);
+            for (uint32_t item = node.ItemOffset; item < node.ItemOffset + node.ItemCount; ++item)
+            {
+                const auto& box = world_bounds[bvh.Items[item]];
+                EXPECT_TRUE(node.Bounds.Min.x <= box.Min.x && node.Bounds.Min.y <= box.Min.y && node.Bounds.Min.z <= box.Min.z);
+                EXPECT_TRUE(node.Bounds.Max.x >= box.Max.x && node.Bounds.Max.y >= box.Max.y && node.Bounds.Max.z >= box.Max.z);
+            }
+            continue;
+        }
+
+        const auto& left  = bvh.Nodes[i + 1];
+        const auto& right = bvh.Nodes[node.RightChild];
+        EXPECT_EQ(left.ItemOffset, node.ItemOffset);
+        EXPECT_EQ(right.ItemOffset, left.ItemOffset + left.ItemCount);
+        EXPECT_EQ(left.ItemCount + right.ItemCount, node.ItemCount);
+    }
+}
+
+TEST_F(SceneCullingTest, BvhQueryMatchesBruteForce)
+{
+    CullingTestScene                      scene(5000, 200.0f);
+    auto                                  world_bounds = scene.ComputeWorldBounds();
+
+    SceneBvh                              bvh;
+    std::vector<uint32_t>                 expected;
+    std::vector<uint32_t>                 visible;
+    std::mt19937                          rng(11);
+    std::uniform_real_distribution<float> coordinate(-250.0f, 250.0f);
+
+    bvh.Build(world_bounds);
+    for (int view = 0; view < 32; ++view)
+    {
+        Frustum frustum = MakeFrustum(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)), glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)), 300.0f);
+
+        SceneCuller::CullBruteForce(frustum, world_bounds, expected);
+        visible.clear();
+        bvh.Query(frustum, world_bounds, visible);
+
+        EXPECT_EQ(Sorted(visible), expected) << "view " << view;
+    }
+}
+
+TEST_F(SceneCullingTest, CullerMatchesBruteForceAfterRefit)
+{
+    CullingTestScene      scene(20000, 300.0f);
+    SceneCuller           culler;
+    std::vector<uint32_t> expected;
+
+    /*
+     * An unbounded draw and one whose transform doesn't exist are never culled
+     */
+    scene.LocalBounds[3]      = {};
+    scene.TransformIndices[5] = static_cast<uint32_t>(scene.GlobalTransforms.size() + 10);
+
+    culler.SetDraws(scene.LocalBounds, scene.TransformIndices);
+
+    Frustum frustum = MakeFrustum(glm::vec3(0.0f, 0.0f, 350.0f), glm::vec3(0.0f), 800.0f);
+    auto    visible = Sorted(culler.Cull(frustum, scene.GlobalTransforms));
+    SceneCuller::CullBruteForce(frustum, culler.WorldBounds(), expected);
+
+    EXPECT_EQ(visible, expected);
+    EXPECT_LT(visible.size(), scene.LocalBounds.size());
+    EXPECT_TRUE(std::binary_search(visible.begin(), visible.end(), 3u));
+    EXPECT_TRUE(std::binary_search(visible.begin(), visible.end(), 5u));
+
+    /*
+     * Moving objects must refit the tree once the world bounds are invalidated
+     */
+    for (size_t i = 0; i < scene.GlobalTransforms.size(); i += 3)
+    {
+        scene.GlobalTransforms[i] = glm::translate(scene.GlobalTransforms[i], glm::vec3(0.0f, 0.0f, -400.0f));
+    }
+    culler.InvalidateWorldBounds();
+
+    visible = Sorted(culler.Cull(frustum, scene.GlobalTransforms));
+    SceneCuller::CullBruteForce(frustum, culler.WorldBounds(), expected);
+    EXPECT_EQ(visible, expected);
+    EXPECT_EQ(culler.WorldBounds().size(), scene.LocalBounds.size());
+    EXPECT_EQ(culler.Bvh().UnboundedItems.size(), 2u);
+}
+
+TEST_F(SceneCullingTest, EmptySceneAndFullyVisibleScene)
+{
+    SceneCuller culler;
+    Frustum     frustum = MakeFrustum(glm::vec3(0.0f, 0.0f, 50.0f), glm::vec3(0.0f), 1000.0f);
+
+    EXPECT_TRUE(culler.Cull(frustum, {}).empty());
+
+    CullingTestScene scene(6000, 5.0f);
+    culler.SetDraws(scene.LocalBounds, scene.TransformIndices);
+    EXPECT_EQ(culler.Cull(frustum, scene.GlobalTransforms).size(), scene.LocalBounds.size());
+
+    Frustum looking_away = MakeFrustum(glm::vec3(0.0f, 0.0f, 50.0f), glm::vec3(0.0f, 0.0f, 100.0f), 1000.0f);
+    EXPECT_TRUE(culler.Cull(looking_away, scene.GlobalTransforms).empty());
+}
+
+TEST_F(SceneCullingTest, LargeSceneCullMatchesBruteForce)
+{
+    CullingTestScene      scene(200000, 1000.0f);
+    SceneCuller           culler;
+    std::vector<uint32_t> expected;
+    Frustum               frustum = MakeFrustum(glm::vec3(0.0f, 0.0f, 1000.0f), glm::vec3(0.0f), 600.0f);
+
+    culler.SetDraws(scene.LocalBounds, scene.TransformIndices);
+
+    /*
+     * The first cull builds the tree, the second one reuses it
+     */
+    auto first  = Sorted(culler.Cull(frustum, scene.GlobalTransforms));
+    auto second = Sorted(culler.Cull(frustum, scene.GlobalTransforms));
+    SceneCuller::CullBruteForce(frustum, culler.WorldBounds(), expected);
+
+    EXPECT_EQ(first, expected);
+    EXPECT_EQ(second, expected);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <Rendering/Scenes/SceneInstancing.h>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <numeric>
+#include <random>
+
+using namespace ZEngine::Rendering::Scenes;
+
+class SceneInstancingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    /*
+     * Every visible draw is drawn once, with its own range, by a command of its group
+     */
+    static void ExpectCoverage(std::span<const uint32_t> draws, std::span<const uint32_t> draw_groups, std::span<const DrawLodRange> draw_ranges, const std::vector<DrawCommand>& commands, const std::vector<uint32_t>& instance_draws)
+    {
+        ASSERT_EQ(instance_draws.size(), draws.size());
+
+        std::vector<uint32_t> range_of_draw(draw_groups.size(), std::numeric_limits<uint32_t>::max());
+        for (size_t i = 0; i < draws.size(); ++i)
+        {
+            range_of_draw[draws[i]] = uint32_t(i);
+        }
+
+        uint32_t next_instance = 0;
+        for (const auto& command : commands)
+        {
+            ASSERT_GT(command.InstanceCount, 0u);
+            ASSERT_EQ(command.FirstInstance, next_instance);
+            uint32_t group = draw_groups[instance_draws[command.FirstInstance]];
+            for (uint32_t instance = command.FirstInstance; instance < command.FirstInstance + command.InstanceCount; ++instance)
+            {
+                uint32_t            draw  = instance_draws[instance];
+                const DrawLodRange& range = draw_ranges[range_of_draw[draw]];
+                EXPECT_EQ(draw_groups[draw], group);
+                EXPECT_EQ(range.FirstIndex, command.FirstVertex);
+                EXPECT_EQ(range.IndexCount, command.VertexCount);
+            }
+            next_instance += command.InstanceCount;
+        }
+        EXPECT_EQ(next_instance, draws.size());
+
+        std::vector<uint32_t> sorted_instances = instance_draws;
+        std::vector<uint32_t> sorted_draws(draws.begin(), draws.end());
+        std::sort(sorted_instances.begin(), sorted_instances.end());
+        std::sort(sorted_draws.begin(), sorted_draws.end());
+        EXPECT_EQ(sorted_instances, sorted_draws);
+    }
+};
+
+TEST_F(SceneInstancingTest, GroupsByMeshAndMaterial)
+{
+    std::vector<uint32_t> meshes    = {4, 4, 7, 4, DrawInstancing::NoMesh, 7, 4, DrawInstancing::NoMesh};
+    std::vector<uint32_t> materials = {1, 1, 1, 2, 0, 1, 1, 0};
+    std::vector<uint32_t> groups;
+
+    uint32_t group_count = DrawInstancing::AssignGroups(meshes, materials, groups);
+    EXPECT_EQ(group_count, 5u);
+    EXPECT_EQ(groups, (std::vector<uint32_t>{0, 0, 1, 2, 3, 1, 0, 4}));
+
+    EXPECT_EQ(DrawInstancing::AssignGroups({}, {}, groups), 0u);
+    EXPECT_TRUE(groups.empty());
+}
+
+TEST_F(SceneInstancingTest, RepeatedMeshBecomesOneCommand)
+{
+    /* A forest : 10000 nodes of 3 meshes, one material */
+    constexpr uint32_t    draw_count = 10000;
+    std::vector<uint32_t> meshes(draw_count);
+    std::vector<uint32_t> materials(draw_count, 0);
+    for (uint32_t draw = 0; draw < draw_count; ++draw)
+    {
+        meshes[draw] = draw % 3;
+    }
+
+    std::vector<uint32_t> groups;
+    ASSERT_EQ(DrawInstancing::AssignGroups(meshes, materials, groups), 3u);
+
+    std::vector<uint32_t>     draws(draw_count);
+    std::vector<DrawLodRange> ranges(draw_count);
+    std::iota(draws.begin(), draws.end(), 0);
+    for (uint32_t draw = 0; draw < draw_count; ++draw)
+    {
+        ranges[draw] = {.FirstIndex = 0, .IndexCount = 300 * (meshes[draw] + 1)};
+    }
+
+    std::vector<DrawCommand> commands;
+    std::vector<uint32_t>    instance_draws;
+    DrawInstancing::Batch(draws, groups, ranges, commands, instance_draws);
+    ASSERT_EQ(commands.size(), 3u);
+    ExpectCoverage(draws, groups, ranges, commands, instance_draws);
+
+    /* Instances keep the order of the draws */
+    for (const auto& command : commands)
+    {
+        EXPECT_TRUE(std::is_sorted(instance_draws.begin() + command.FirstInstance, instance_draws.begin() + command.FirstInstance + command.InstanceCount));
+    }
+}
+
+TEST_F(SceneInstancingTest, LevelsSplitCommandsOfAGroup)
+{
+    std::mt19937          rng(41);
+    constexpr uint32_t    draw_count = 2000;
+    std::vector<uint32_t> meshes(draw_count);
+    std::vector<uint32_t> materials(draw_count);
+    for (uint32_t draw = 0; draw < draw_count; ++draw)
+    {
+        meshes[draw]    = rng() % 16;
+        materials[draw] = rng() % 3;
+    }
+    meshes[17] = DrawInstancing::NoMesh;
+
+    std::vector<uint32_t> groups;
+    uint32_t              group_count = DrawInstancing::AssignGroups(meshes, materials, groups);
+
+    /* A culled subset, in visibility order, each with one of 3 levels of its mesh */
+    std::vector<uint32_t> visible;
+    std::vector<uint32_t> levels_used(group_count, 0);
+    for (uint32_t draw = 0; draw < draw_count; ++draw)
+    {
+        if (rng() % 3 != 0)
+        {
+            visible.push_back(draw);
+        }
+    }
+    std::shuffle(visible.begin(), visible.end(), rng);
+
+    std::vector<uint32_t>     draws;
+    std::vector<DrawLodRange> ranges;
+    for (uint32_t draw : visible)
+    {
+        uint32_t level = rng() % 3;
+        draws.push_back(draw);
+        ranges.push_back({.FirstIndex = level * 1000, .IndexCount = 900u >> level});
+        levels_used[groups[draw]] |= 1u << level;
+    }
+
+    std::vector<DrawCommand> commands;
+    std::vector<uint32_t>    instance_draws;
+    DrawInstancing::Batch(draws, groups, ranges, commands, instance_draws);
+    ExpectCoverage(draws, groups, ranges, commands, instance_draws);
+
+    size_t expected_commands = 0;
+    for (uint32_t mask : levels_used)
+    {
+        expected_commands += std::popcount(mask);
+    }
+    EXPECT_EQ(commands.size(), expected_commands);
+
+    /* Nothing visible, no command */
+    DrawInstancing::Batch({}, groups, {}, commands, instance_draws);
+    EXPECT_TRUE(commands.empty());
+    EXPECT_TRUE(instance_draws.empty());
+}
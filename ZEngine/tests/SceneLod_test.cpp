@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <Rendering/Scenes/SceneLod.h>
+
+using namespace ZEngine::Rendering::Meshes;
+using namespace ZEngine::Rendering::Scenes;
+
+class SceneLodTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    /*
+     * 90 degrees vertical field of view on a 1000 pixels high viewport
+     */
+    static LodView MakeView(const glm::vec3& position)
+    {
+        return LodView{.Position = position, .ProjectionScale = 1.0f * 1000.0f * 0.5f, .PixelErrorThreshold = 1.0f};
+    }
+
+    static DrawLodChain MakeChain()
+    {
+        MeshLodChain mesh_lods = {};
+        mesh_lods.LodCount     = 3;
+        mesh_lods.Lods[0]      = {.IndexOffset = 1200, .IndexCount = 600, .Error = 0.001f};
+        mesh_lods.Lods[1]      = {.IndexOffset = 1800, .IndexCount = 300, .Error = 0.01f};
+        mesh_lods.Lods[2]      = {.IndexOffset = 2100, .IndexCount = 90, .Error = 0.1f};
+        return LodSelector::BuildDrawChain(0, 1200, mesh_lods);
+    }
+};
+
+TEST_F(SceneLodTest, BuildDrawChainIsRelativeToTheDraw)
+{
+    DrawLodChain chain = MakeChain();
+    ASSERT_EQ(chain.LodCount, 4u);
+    EXPECT_EQ(chain.Lods[0].FirstIndex, 0u);
+    EXPECT_EQ(chain.Lods[0].IndexCount, 1200u);
+    EXPECT_EQ(chain.Lods[0].Error, 0.0f);
+    EXPECT_EQ(chain.Lods[2].FirstIndex, 1800u);
+    EXPECT_EQ(chain.Lods[3].IndexCount, 90u);
+
+    /* Compact index slices : offsets are rebased on the draw */
+    MeshLodChain shifted = {.LodCount = 1};
+    shifted.Lods[0]      = {.IndexOffset = 5000 + 64, .IndexCount = 30, .Error = 0.5f};
+    DrawLodChain rebased = LodSelector::BuildDrawChain(5000, 64, shifted);
+    ASSERT_EQ(rebased.LodCount, 2u);
+    EXPECT_EQ(rebased.Lods[1].FirstIndex, 64u);
+
+    /* No chain : the full mesh only */
+    EXPECT_EQ(LodSelector::BuildDrawChain(10, 3, {}).LodCount, 1u);
+}
+
+TEST_F(SceneLodTest, SelectionCoarsensWithDistance)
+{
+    DrawLodChain chain  = MakeChain();
+    BoundingBox  bounds = {};
+    bounds.Expand(glm::vec3(-1.0f));
+    bounds.Expand(glm::vec3(1.0f));
+
+    /* Inside the bounds : full mesh */
+    EXPECT_EQ(LodSelector::SelectLod(chain, bounds, 1.0f, MakeView(glm::vec3(0.0f))), 0u);
+
+    /* error * 500 / distance <= 1 pixel : level 1 past 0.5, level 2 past 5, level 3 past 50 */
+    EXPECT_EQ(LodSelector::SelectLod(chain, bounds, 1.0f, MakeView({0.0f, 0.0f, 1.0f + 0.4f})), 0u);
+    EXPECT_EQ(LodSelector::SelectLod(chain, bounds, 1.0f, MakeView({0.0f, 0.0f, 1.0f + 0.6f})), 1u);
+    EXPECT_EQ(LodSelector::SelectLod(chain, bounds, 1.0f, MakeView({0.0f, 0.0f, 1.0f + 6.0f})), 2u);
+    EXPECT_EQ(LodSelector::SelectLod(chain, bounds, 1.0f, MakeView({0.0f, 0.0f, 1.0f + 60.0f})), 3u);
+
+    /* A scaled instance scales its errors */
+    EXPECT_EQ(LodSelector::SelectLod(chain, bounds, 10.0f, MakeView({0.0f, 0.0f, 1.0f + 6.0f})), 1u);
+
+    /* Selection never changes the levels order: coarser when farther, along any axis */
+    uint32_t previous = 0;
+    for (float distance = 0.0f; distance < 200.0f; distance += 0.25f)
+    {
+        uint32_t level = LodSelector::SelectLod(chain, bounds, 1.0f, MakeView({-1.0f - distance, 0.5f, 0.0f}));
+        EXPECT_GE(level, previous);
+        previous = level;
+    }
+    EXPECT_EQ(previous, 3u);
+}
+
+TEST_F(SceneLodTest, UnknownViewOrBoundsSelectsFullMesh)
+{
+    DrawLodChain chain = MakeChain();
+    BoundingBox  empty = {};
+    EXPECT_EQ(LodSelector::SelectLod(chain, empty, 1.0f, MakeView(glm::vec3(1000.0f))), 0u);
+
+    BoundingBox bounds = {};
+    bounds.Expand(glm::vec3(0.0f));
+    EXPECT_EQ(LodSelector::SelectLod(chain, bounds, 1.0f, LodView{.Position = glm::vec3(1000.0f)}), 0u);
+    EXPECT_NEAR(LodSelector::MaxScale(glm::mat4(3.0f)), 3.0f, 1e-6f);
+}
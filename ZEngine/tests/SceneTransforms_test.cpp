@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <Rendering/Scenes/SceneTransforms.h>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+
+using namespace ZEngine::Rendering::Scenes;
+
+class SceneTransformsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+struct TransformTestScene
+{
+    std::vector<SceneNodeHierarchy> Hierarchy;
+    std::vector<glm::mat4>          LocalTransforms;
+    std::vector<glm::mat4>          GlobalTransforms;
+
+    /*
+     * Same linking as SceneRawData::AddNode
+     */
+    int                             AddNode(int parent)
+    {
+        int node_id = (int) Hierarchy.size();
+        int depth   = (parent > -1) ? Hierarchy[parent].DepthLevel + 1 : 0;
+        Hierarchy.push_back({.Parent = parent, .DepthLevel = depth});
+
+        glm::mat4 local(1.0f);
+        local[3] = glm::vec4(float(node_id % 7), float(node_id % 5), float(node_id % 3), 1.0f);
+        local[0] = glm::vec4(1.0f, 0.0f, float(node_id % 2) * 0.5f, 0.0f);
+        LocalTransforms.push_back(local);
+        GlobalTransforms.emplace_back(1.0f);
+
+        if (parent > -1)
+        {
+            int first_child = Hierarchy[parent].FirstChild;
+            if (first_child == -1)
+            {
+                Hierarchy[parent].FirstChild = node_id;
+            }
+            else
+            {
+                int sibling = first_child;
+                while (Hierarchy[sibling].RightSibling != -1)
+                {
+                    sibling = Hierarchy[sibling].RightSibling;
+                }
+                Hierarchy[sibling].RightSibling = node_id;
+            }
+        }
+        return node_id;
+    }
+
+    static TransformTestScene Random(int node_count, uint32_t seed)
+    {
+        TransformTestScene scene;
+        std::mt19937       rng(seed);
+        scene.AddNode(-1);
+        for (int i = 1; i < node_count; ++i)
+        {
+            /* Bias parents towards recent nodes so the tree gets deep as well as wide */
+            int low = std::max(0, i - 64);
+            scene.AddNode(std::uniform_int_distribution<int>(low, i - 1)(rng));
+        }
+        return scene;
+    }
+};
+
+/*
+ * Previous GraphicScene implementation : std::map of std::set filled by a BFS per mark, walked serially
+ */
+struct ReferenceTransformPath
+{
+    std::map<uint32_t, std::set<uint32_t>> LevelSceneNodeChangedMap;
+
+    void                                   Mark(const std::vector<SceneNodeHierarchy>& hierarchy, int node_identifier)
+    {
+        std::queue<int>  q;
+        std::vector<int> n;
+        q.push(node_identifier);
+        while (!q.empty())
+        {
+            int front = q.front();
+            n.push_back(front);
+            q.pop();
+            int first = hierarchy[front].FirstChild;
+            if (first > -1)
+            {
+                q.push(first);
+                for (int sibling = hierarchy[first].RightSibling; sibling != -1; sibling = hierarchy[sibling].RightSibling)
+                {
+                    q.push(sibling);
+                }
+            }
+        }
+
+        for (int node : n)
+        {
+            LevelSceneNodeChangedMap[hierarchy[node].DepthLevel].emplace(node);
+        }
+    }
+
+    void Compute(const std::vector<SceneNodeHierarchy>& hierarchy, const std::vector<glm::mat4>& local_transforms, std::vector<glm::mat4>& global_transforms)
+    {
+        for (auto& [level, nodes] : LevelSceneNodeChangedMap)
+        {
+            for (auto node : nodes)
+            {
+                int parent = hierarchy[node].Parent;
+                if (parent != -1)
+                {
+                    global_transforms[node] = global_transforms[parent] * local_transforms[node];
+                }
+            }
+        }
+        LevelSceneNodeChangedMap.clear();
+    }
+};
+
+TEST_F(SceneTransformsTest, RepeatedMarksAreDeduplicated)
+{
+    TransformTestScene scene = TransformTestScene::Random(1000, 7);
+
+    SceneTransformDirtyList dirty_list;
+    dirty_list.MarkSubtree(scene.Hierarchy, 0);
+    EXPECT_EQ(dirty_list.Count(), 1000u);
+
+    for (int i = 0; i < 1000; i += 3)
+    {
+        dirty_list.MarkSubtree(scene.Hierarchy, i);
+    }
+    EXPECT_EQ(dirty_list.Count(), 1000u);
+
+    size_t total = 0;
+    for (uint32_t level = 0; level < dirty_list.Levels.size(); ++level)
+    {
+        for (uint32_t node : dirty_list.Levels[level])
+        {
+            EXPECT_EQ(scene.Hierarchy[node].DepthLevel, (int) level);
+        }
+        total += dirty_list.Levels[level].size();
+    }
+    EXPECT_EQ(total, 1000u);
+
+    dirty_list.Clear();
+    EXPECT_TRUE(dirty_list.Empty());
+    EXPECT_FALSE(dirty_list.IsMarked(0));
+
+    dirty_list.MarkSubtree(scene.Hierarchy, 999);
+    EXPECT_TRUE(dirty_list.IsMarked(999));
+    EXPECT_EQ(dirty_list.Count(), 1u);
+
+    /* Out of range identifiers are ignored, as an empty hierarchy was before */
+    dirty_list.MarkSubtree(scene.Hierarchy, -1);
+    dirty_list.MarkSubtree(scene.Hierarchy, 5000);
+    EXPECT_EQ(dirty_list.Count(), 1u);
+}
+
+TEST_F(SceneTransformsTest, MatchesPreviousSerialPath)
+{
+    TransformTestScene     scene     = TransformTestScene::Random(20000, 42);
+    std::vector<glm::mat4> reference = scene.GlobalTransforms;
+    std::vector<glm::mat4> serial    = scene.GlobalTransforms;
+    std::vector<glm::mat4> parallel  = scene.GlobalTransforms;
+
+    ReferenceTransformPath  reference_path;
+    SceneTransformDirtyList dirty_list;
+    std::mt19937            rng(3);
+
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        for (int mark = 0; mark < 50; ++mark)
+        {
+            int node = (mark == 0 && frame == 0) ? 0 : std::uniform_int_distribution<int>(0, 19999)(rng);
+            reference_path.Mark(scene.Hierarchy, node);
+            dirty_list.MarkSubtree(scene.Hierarchy, node);
+        }
+
+        reference_path.Compute(scene.Hierarchy, scene.LocalTransforms, reference);
+        SceneTransformSystem::ComputeSerial(scene.Hierarchy, scene.LocalTransforms, serial, dirty_list);
+        /* A small batch size forces many batches per level */
+        SceneTransformSystem::ComputeParallel(scene.Hierarchy, scene.LocalTransforms, parallel, dirty_list, 64);
+        dirty_list.Clear();
+
+        ASSERT_TRUE(reference == serial) << "frame " << frame;
+        ASSERT_TRUE(reference == parallel) << "frame " << frame;
+    }
+}
+
+TEST_F(SceneTransformsTest, LargeSceneFullUpdateMatchesReference)
+{
+    const int              node_count = 150000;
+    TransformTestScene     scene      = TransformTestScene::Random(node_count, 11);
+    std::vector<glm::mat4> reference  = scene.GlobalTransforms;
+    std::vector<glm::mat4> parallel   = scene.GlobalTransforms;
+
+    ReferenceTransformPath reference_path;
+    reference_path.Mark(scene.Hierarchy, 0);
+    reference_path.Compute(scene.Hierarchy, scene.LocalTransforms, reference);
+
+    SceneTransformDirtyList dirty_list;
+    /* Warm-up frame : sizes the buckets, the update below reuses them after Clear() */
+    dirty_list.MarkSubtree(scene.Hierarchy, 0);
+    dirty_list.Clear();
+
+    dirty_list.MarkSubtree(scene.Hierarchy, 0);
+    SceneTransformSystem::ComputeParallel(scene.Hierarchy, scene.LocalTransforms, parallel, dirty_list);
+    dirty_list.Clear();
+
+    EXPECT_TRUE(reference == parallel);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <Helpers/StagingRingAllocator.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ZEngine::Helpers;
+
+class StagingRingAllocatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static constexpr size_t InvalidOffset = StagingRingAllocator::InvalidOffset;
+};
+
+TEST_F(StagingRingAllocatorTest, AllocatesAlignedSlicesInOrder)
+{
+    StagingRingAllocator ring(1024);
+
+    EXPECT_EQ(ring.Allocate(10, 16), 0u);
+    EXPECT_EQ(ring.Allocate(10, 16), 16u);
+    EXPECT_EQ(ring.Allocate(100), 26u);
+    EXPECT_EQ(ring.Allocate(4, 64), 128u);
+    EXPECT_EQ(ring.UsedByteSize(), 132u);
+    EXPECT_EQ(ring.AllocationCount(), 4u);
+
+    EXPECT_EQ(ring.Allocate(0), InvalidOffset);
+    EXPECT_EQ(ring.Allocate(1025), InvalidOffset);
+}
+
+TEST_F(StagingRingAllocatorTest, FullRingRefusesUntilRetired)
+{
+    StagingRingAllocator ring(256);
+
+    size_t a = ring.Allocate(128);
+    size_t b = ring.Allocate(128);
+    EXPECT_EQ(a, 0u);
+    EXPECT_EQ(b, 128u);
+    EXPECT_EQ(ring.Allocate(1), InvalidOffset);
+
+    /* Submitted but not complete yet */
+    EXPECT_TRUE(ring.Submit(a, 1));
+    EXPECT_EQ(ring.Retire(0), 0u);
+    EXPECT_EQ(ring.Allocate(1), InvalidOffset);
+
+    EXPECT_EQ(ring.Retire(1), 128u);
+    EXPECT_EQ(ring.Allocate(64), 0u);
+    EXPECT_EQ(ring.Allocate(64), 64u);
+    EXPECT_EQ(ring.Allocate(1), InvalidOffset);
+}
+
+TEST_F(StagingRingAllocatorTest, RetiresInAllocationOrder)
+{
+    StagingRingAllocator ring(300);
+
+    size_t a = ring.Allocate(100);
+    size_t b = ring.Allocate(100);
+    size_t c = ring.Allocate(100);
+
+    /* b and c complete first, a is not submitted yet and keeps them alive */
+    EXPECT_TRUE(ring.Submit(b, 1));
+    EXPECT_TRUE(ring.Submit(c, 2));
+    EXPECT_EQ(ring.Retire(2), 0u);
+    EXPECT_EQ(ring.UsedByteSize(), 300u);
+
+    EXPECT_TRUE(ring.Submit(a, 3));
+    EXPECT_FALSE(ring.Submit(a, 4));
+    EXPECT_EQ(ring.Retire(2), 0u);
+    EXPECT_EQ(ring.Retire(3), 300u);
+    EXPECT_EQ(ring.UsedByteSize(), 0u);
+    EXPECT_EQ(ring.AllocationCount(), 0u);
+
+    /* Empty ring starts over at 0 */
+    EXPECT_EQ(ring.Allocate(300), 0u);
+}
+
+TEST_F(StagingRingAllocatorTest, WrapsAroundAndReleasesSkippedTail)
+{
+    StagingRingAllocator ring(1000);
+
+    size_t a = ring.Allocate(400);
+    size_t b = ring.Allocate(400);
+    ring.Submit(a, 1);
+    ring.Retire(1);
+
+    /* 200 bytes left at the end, 400 at the start : the allocation restarts at 0 and owns the skipped tail */
+    size_t c = ring.Allocate(300);
+    EXPECT_EQ(c, 0u);
+    EXPECT_EQ(ring.UsedByteSize(), 400u + 200u + 300u);
+
+    /* Only [300, 400) is free now */
+    EXPECT_EQ(ring.Allocate(101), InvalidOffset);
+    size_t d = ring.Allocate(100);
+    EXPECT_EQ(d, 300u);
+    EXPECT_EQ(ring.Allocate(1), InvalidOffset);
+
+    ring.Submit(b, 2);
+    ring.Submit(c, 3);
+    EXPECT_EQ(ring.Retire(3), 400u + 200u + 300u);
+    EXPECT_EQ(ring.UsedByteSize(), 100u);
+
+    /* The tail past d is free again, up to the end of the buffer */
+    EXPECT_EQ(ring.Allocate(600), 400u);
+    EXPECT_EQ(ring.Allocate(300), 0u);
+    EXPECT_EQ(ring.Allocate(1), InvalidOffset);
+}
+
+TEST_F(StagingRingAllocatorTest, LiveSlicesNeverOverlap)
+{
+    struct Live
+    {
+        size_t   Offset;
+        size_t   ByteSize;
+        uint64_t FenceValue;
+    };
+
+    constexpr size_t     capacity = 64 * 1024;
+    StagingRingAllocator ring(capacity);
+    std::mt19937         rng(7);
+    std::vector<Live>    live;
+    uint64_t             fence_value     = 0;
+    uint64_t             completed_value = 0;
+    size_t               refused         = 0;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        size_t byte_size = 1 + rng() % 9000;
+        size_t alignment = size_t(1) << (rng() % 9);
+        size_t offset    = ring.Allocate(byte_size, alignment);
+        if (offset == InvalidOffset)
+        {
+            ++refused;
+        }
+        else
+        {
+            ASSERT_EQ(offset % alignment, 0u);
+            ASSERT_LE(offset + byte_size, capacity);
+            for (const auto& other : live)
+            {
+                ASSERT_TRUE((offset + byte_size <= other.Offset) || (other.Offset + other.ByteSize <= offset));
+            }
+            live.push_back({.Offset = offset, .ByteSize = byte_size, .FenceValue = StagingRingAllocator::NotSubmitted});
+        }
+
+        /* Submissions in a random order, completions trailing behind */
+        if (!live.empty() && (rng() % 2))
+        {
+            auto& pending = live[rng() % live.size()];
+            if (pending.FenceValue == StagingRingAllocator::NotSubmitted)
+            {
+                pending.FenceValue = ++fence_value;
+                ASSERT_TRUE(ring.Submit(pending.Offset, pending.FenceValue));
+            }
+        }
+        if (rng() % 3 == 0)
+        {
+            completed_value = std::max(completed_value, fence_value - std::min<uint64_t>(fence_value, rng() % 4));
+            ring.Retire(completed_value);
+
+            /* What the ring may have released is complete, drop the oldest of those from the model */
+            size_t remaining = ring.AllocationCount();
+            ASSERT_LE(remaining, live.size());
+            for (size_t i = 0; i < live.size() - remaining; ++i)
+            {
+                ASSERT_NE(live[i].FenceValue, StagingRingAllocator::NotSubmitted);
+                ASSERT_LE(live[i].FenceValue, completed_value);
+            }
+            live.erase(live.begin(), live.begin() + (live.size() - remaining));
+        }
+        ASSERT_LE(ring.UsedByteSize(), capacity);
+    }
+
+    EXPECT_GT(refused, 0u);
+
+    for (auto& pending : live)
+    {
+        if (pending.FenceValue == StagingRingAllocator::NotSubmitted)
+        {
+            ring.Submit(pending.Offset, ++fence_value);
+        }
+    }
+    ring.Retire(fence_value);
+    EXPECT_EQ(ring.UsedByteSize(), 0u);
+    EXPECT_EQ(ring.Allocate(capacity), 0u);
+}
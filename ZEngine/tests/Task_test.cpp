@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "Core/Task.h"
+
+using namespace ZEngine::Core;
+
+struct CountingFrameAllocator : public ITaskFrameAllocator
+{
+    std::atomic<int> AllocationCount   = 0;
+    std::atomic<int> DeallocationCount = 0;
+
+    void*            Allocate(size_t byte_size) override
+    {
+        AllocationCount++;
+        return ::operator new(byte_size);
+    }
+
+    void Deallocate(void* ptr, size_t byte_size) override
+    {
+        DeallocationCount++;
+        ::operator delete(ptr, byte_size);
+    }
+};
+
+class TaskTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override
+    {
+        TaskFrameAllocator::Set(nullptr);
+    }
+};
+
+static Task<int> ValueAsync(int value)
+{
+    co_return value;
+}
+
+static Task<int> SumAsync(int count)
+{
+    int sum = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        sum += co_await ValueAsync(i % 2);
+    }
+    co_return sum;
+}
+
+static Task<int> DepthAsync(int depth)
+{
+    if (depth == 0)
+    {
+        co_return 0;
+    }
+    co_return 1 + co_await DepthAsync(depth - 1);
+}
+
+static Task<> ThrowAsync()
+{
+    throw std::runtime_error("task failure");
+    co_return;
+}
+
+static Task<std::thread::id> ThreadIdOnPoolAsync()
+{
+    co_await ResumeOnThreadPool();
+    co_return std::this_thread::get_id();
+}
+
+static ValueTask<int> CachedValueAsync(bool cached)
+{
+    if (cached)
+    {
+        return 7;
+    }
+    return ValueAsync(7);
+}
+
+static Task<int> ReadValueTasksAsync(int count, bool cached)
+{
+    int sum = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        sum += co_await CachedValueAsync(cached);
+    }
+    co_return sum;
+}
+
+static std::future<int> FutureValueAsync(int value)
+{
+    co_return value;
+}
+
+static std::future<int> FutureSumAsync(int count)
+{
+    int sum = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        sum += co_await FutureValueAsync(i % 2);
+    }
+    co_return sum;
+}
+
+static Task<int> AwaitFutureAsync(std::future<int>& future)
+{
+    co_return (co_await future) + 1;
+}
+
+TEST_F(TaskTest, ReturnsValue)
+{
+    EXPECT_EQ(SyncWait(ValueAsync(42)), 42);
+    EXPECT_EQ(SyncWait(SumAsync(10)), 5);
+}
+
+TEST_F(TaskTest, IsLazilyStarted)
+{
+    bool started = false;
+    auto task    = [](bool& flag) -> Task<> {
+        flag = true;
+        co_return;
+    }(started);
+
+    EXPECT_FALSE(started);
+    EXPECT_FALSE(task.IsReady());
+    SyncWait(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST_F(TaskTest, PropagatesException)
+{
+    EXPECT_THROW(SyncWait(ThrowAsync()), std::runtime_error);
+}
+
+TEST_F(TaskTest, SymmetricTransferKeepsStackBounded)
+{
+    EXPECT_EQ(SyncWait(SumAsync(1000000)), 500000);
+    EXPECT_EQ(SyncWait(DepthAsync(10000)), 10000);
+}
+
+TEST_F(TaskTest, ResumesOnThreadPool)
+{
+    auto worker_id = SyncWait(ThreadIdOnPoolAsync());
+    EXPECT_NE(worker_id, std::this_thread::get_id());
+}
+
+TEST_F(TaskTest, InteroperatesWithFutures)
+{
+    EXPECT_EQ(AsFuture(ValueAsync(5)).get(), 5);
+
+    std::promise<int> source;
+    auto              source_future = source.get_future();
+    auto              task          = AwaitFutureAsync(source_future);
+    auto              result        = AsFuture(std::move(task));
+
+    source.set_value(41);
+    CoroutineScheduler::NotifyCompletion();
+    EXPECT_EQ(result.get(), 42);
+}
+
+TEST_F(TaskTest, FramesUseConfiguredAllocator)
+{
+    CountingFrameAllocator allocator;
+    TaskFrameAllocator::Set(&allocator);
+
+    EXPECT_EQ(SyncWait(SumAsync(100)), 50);
+    EXPECT_EQ(allocator.AllocationCount, 101);
+    EXPECT_EQ(allocator.DeallocationCount, 101);
+
+    TaskFrameAllocator::Set(nullptr);
+}
+
+TEST_F(TaskTest, ValueTaskReadyPathAllocatesNoFrame)
+{
+    CountingFrameAllocator allocator;
+    TaskFrameAllocator::Set(&allocator);
+
+    EXPECT_EQ(SyncWait(ReadValueTasksAsync(100, true)), 700);
+    EXPECT_EQ(allocator.AllocationCount, 1);
+
+    EXPECT_EQ(SyncWait(ReadValueTasksAsync(100, false)), 700);
+    EXPECT_EQ(allocator.AllocationCount, 102);
+    EXPECT_EQ(allocator.DeallocationCount, 102);
+}
+
+TEST_F(TaskTest, AwaitChainsMatchFutures)
+{
+    const int count   = 1000;
+    int       futures = FutureSumAsync(count).get();
+    EXPECT_EQ(SyncWait(SumAsync(count)), futures);
+
+    PooledTaskFrameAllocator pooled_allocator = {};
+    TaskFrameAllocator::Set(&pooled_allocator);
+    EXPECT_EQ(SyncWait(SumAsync(count)), futures);
+    TaskFrameAllocator::Set(nullptr);
+}
@@ -0,0 +1,309 @@
+#include <gtest/gtest.h>
+#include <Rendering/Textures/TextureCompressor.h>
+#include <Serializers/TextureAssetSerializer.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+using namespace ZEngine::Rendering::Textures;
+using namespace ZEngine::Serializers;
+
+class TextureCompressorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "zengine_texture_compressor_test";
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    /*
+     * Smooth gradients, a few hard edges and some noise : what material textures look like to a block encoder
+     */
+    static DecodedImage MakeImage(uint32_t width, uint32_t height, uint32_t seed, bool with_alpha)
+    {
+        DecodedImage image = {.Width = width, .Height = height};
+        image.Pixels.resize(size_t(width) * height * 4);
+        uint32_t state = seed * 2654435761u + 1;
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                state         = state * 1664525u + 1013904223u;
+                int   noise   = int((state >> 24) & 0x7) - 4;
+                bool  edge    = ((x / 24) + (y / 24)) & 1;
+                float u       = float(x) / float(width);
+                float v       = float(y) / float(height);
+                int   rgba[4] = {int(255.0f * u), int(255.0f * v), edge ? 200 : 40, with_alpha ? int(255.0f * (1.0f - u * v)) : 255};
+                auto* texel   = &image.Pixels[(size_t(y) * width + x) * 4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    texel[c] = uint8_t(std::clamp(rgba[c] + ((c < 3) ? noise : 0), 0, 255));
+                }
+            }
+        }
+        return image;
+    }
+
+    /*
+     * Over the first level, on the channels set in channel_mask
+     */
+    static double ComputePsnr(const DecodedImage& reference, const DecodedImage& image, uint32_t channel_mask)
+    {
+        double squared_error = 0.0;
+        size_t count         = 0;
+        for (size_t i = 0; i < reference.LevelByteSize(0); ++i)
+        {
+            if (channel_mask & (1u << (i & 3)))
+            {
+                double delta   = double(reference.Pixels[i]) - double(image.Pixels[i]);
+                squared_error += delta * delta;
+                ++count;
+            }
+        }
+        double mse = squared_error / double(count);
+        return (mse > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+    }
+
+    static double RoundTripPsnr(const DecodedImage& source, DecodedPixelFormat format, uint32_t channel_mask)
+    {
+        DecodedImage compressed, decompressed;
+        EXPECT_TRUE(TextureCompressor::Compress(source, {.Format = format, .GenerateMipChain = false}, compressed));
+        EXPECT_EQ(compressed.ByteSize(), compressed.LevelByteSize(0));
+        EXPECT_TRUE(TextureCompressor::Decompress(compressed, decompressed));
+        return ComputePsnr(source, decompressed, channel_mask);
+    }
+
+    std::filesystem::path m_directory;
+};
+
+TEST_F(TextureCompressorTest, BlockSizes)
+{
+    DecodedImage image = {.Width = 37, .Height = 23, .Format = DecodedPixelFormat::BC1};
+    EXPECT_EQ(image.LevelByteSize(0), size_t(10 * 6 * 8));
+    EXPECT_EQ(image.LevelByteSize(5), size_t(8));
+
+    image.Format     = DecodedPixelFormat::BC7;
+    image.LayerCount = 6;
+    EXPECT_EQ(image.LevelByteSize(0), size_t(10 * 6 * 16 * 6));
+    EXPECT_EQ(image.MipByteOffset(2), image.LevelByteSize(0) + image.LevelByteSize(1));
+    EXPECT_FALSE(IsBlockCompressed(DecodedPixelFormat::RGBA8));
+    EXPECT_TRUE(IsBlockCompressed(DecodedPixelFormat::BC6H));
+}
+
+TEST_F(TextureCompressorTest, LdrFormatsMeetPsnrThresholds)
+{
+    auto opaque      = MakeImage(128, 96, 1, false);
+    auto translucent = MakeImage(128, 96, 2, true);
+
+    EXPECT_GE(RoundTripPsnr(opaque, DecodedPixelFormat::BC1, 0x7), 38.0);
+    EXPECT_GE(RoundTripPsnr(translucent, DecodedPixelFormat::BC3, 0x7), 38.0);
+    EXPECT_GE(RoundTripPsnr(translucent, DecodedPixelFormat::BC3, 0x8), 50.0);
+    EXPECT_GE(RoundTripPsnr(opaque, DecodedPixelFormat::BC4, 0x1), 50.0);
+    EXPECT_GE(RoundTripPsnr(opaque, DecodedPixelFormat::BC5, 0x3), 50.0);
+    EXPECT_GE(RoundTripPsnr(translucent, DecodedPixelFormat::BC7, 0xF), 42.0);
+
+    /*
+     * BC7 has twice the bits of BC1 per block, it must show
+     */
+    EXPECT_GT(RoundTripPsnr(opaque, DecodedPixelFormat::BC7, 0x7), RoundTripPsnr(opaque, DecodedPixelFormat::BC1, 0x7) + 3.0);
+}
+
+TEST_F(TextureCompressorTest, UniformBlocksAreNearlyExact)
+{
+    for (uint8_t value : {0, 1, 77, 128, 254, 255})
+    {
+        DecodedImage image = {.Width = 8, .Height = 8};
+        image.Pixels.assign(8 * 8 * 4, value);
+
+        for (auto format : {DecodedPixelFormat::BC1, DecodedPixelFormat::BC3, DecodedPixelFormat::BC4, DecodedPixelFormat::BC5, DecodedPixelFormat::BC7})
+        {
+            DecodedImage compressed, decompressed;
+            ASSERT_TRUE(TextureCompressor::Compress(image, {.Format = format, .GenerateMipChain = false}, compressed));
+            ASSERT_TRUE(TextureCompressor::Decompress(compressed, decompressed));
+            uint32_t mask = (format == DecodedPixelFormat::BC4) ? 0x1 : (format == DecodedPixelFormat::BC5) ? 0x3 : (format == DecodedPixelFormat::BC1) ? 0x7 : 0xF;
+            for (size_t i = 0; i < decompressed.Pixels.size(); ++i)
+            {
+                if (mask & (1u << (i & 3)))
+                {
+                    /*
+                     * 5:6:5 endpoints can't hit every value, their interpolation gets within a few steps
+                     */
+                    int tolerance = (format == DecodedPixelFormat::BC1 || format == DecodedPixelFormat::BC3) && ((i & 3) < 3) ? 4 : 1;
+                    ASSERT_NEAR(int(decompressed.Pixels[i]), int(value), tolerance) << "format " << int(format) << " value " << int(value);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TextureCompressorTest, HdrMeetsPsnrThreshold)
+{
+    /*
+     * Four stops of dynamic range, PSNR against the brightest value
+     */
+    DecodedImage image = {.Width = 64, .Height = 64, .Format = DecodedPixelFormat::RGBA32F};
+    image.Pixels.resize(image.LevelByteSize(0));
+    auto* texels = reinterpret_cast<float*>(image.Pixels.data());
+    float peak   = 0.0f;
+    for (uint32_t y = 0; y < image.Height; ++y)
+    {
+        for (uint32_t x = 0; x < image.Width; ++x)
+        {
+            float* texel = texels + (size_t(y) * image.Width + x) * 4;
+            texel[0]     = std::exp2(float(x) / 16.0f);
+            texel[1]     = std::exp2(float(y) / 16.0f) * 0.5f;
+            texel[2]     = 0.25f + 0.125f * float((x / 8 + y / 8) & 1);
+            texel[3]     = 1.0f;
+            peak         = std::max({peak, texel[0], texel[1], texel[2]});
+        }
+    }
+
+    DecodedImage compressed, decompressed;
+    ASSERT_TRUE(TextureCompressor::Compress(image, {.Format = DecodedPixelFormat::BC6H, .IsSrgb = false, .GenerateMipChain = false}, compressed));
+    ASSERT_TRUE(TextureCompressor::Decompress(compressed, decompressed));
+    ASSERT_EQ(decompressed.Format, DecodedPixelFormat::RGBA32F);
+    EXPECT_FALSE(compressed.IsSrgb);
+
+    const auto* result        = reinterpret_cast<const float*>(decompressed.Pixels.data());
+    double      squared_error = 0.0;
+    for (size_t i = 0; i < size_t(image.Width) * image.Height; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            double delta   = double(texels[i * 4 + c]) - double(result[i * 4 + c]);
+            squared_error += delta * delta;
+        }
+        EXPECT_EQ(result[i * 4 + 3], 1.0f);
+    }
+    double mse = squared_error / (double(image.Width) * image.Height * 3);
+    EXPECT_GE(10.0 * std::log10(double(peak) * peak / mse), 40.0);
+
+    /*
+     * Only RGBA32F sources go to BC6H, and RGBA8 ones never do
+     */
+    EXPECT_FALSE(TextureCompressor::Compress(MakeImage(16, 16, 3, false), {.Format = DecodedPixelFormat::BC6H}, compressed));
+    EXPECT_FALSE(TextureCompressor::Compress(image, {.Format = DecodedPixelFormat::BC7}, compressed));
+}
+
+TEST_F(TextureCompressorTest, MipChainCoversEveryLevelAndLayer)
+{
+    /*
+     * Odd sizes : partial blocks on the edges, then levels under a block
+     */
+    auto face        = MakeImage(37, 23, 4, true);
+    auto image       = face;
+    image.LayerCount = 2;
+    image.Pixels.insert(image.Pixels.end(), face.Pixels.begin(), face.Pixels.end());
+
+    DecodedImage compressed, decompressed;
+    ASSERT_TRUE(TextureCompressor::Compress(image, {.Format = DecodedPixelFormat::BC7}, compressed));
+    EXPECT_EQ(compressed.MipLevelCount, 6u);
+    EXPECT_EQ(compressed.LayerCount, 2u);
+    EXPECT_TRUE(compressed.IsSrgb);
+    EXPECT_EQ(compressed.ByteSize(), compressed.MipByteOffset(6));
+
+    ASSERT_TRUE(TextureCompressor::Decompress(compressed, decompressed));
+    EXPECT_EQ(decompressed.MipLevelCount, 6u);
+    EXPECT_GE(ComputePsnr(image, decompressed, 0xF), 33.0);
+
+    /*
+     * Both layers were encoded from the same texels, at every level
+     */
+    for (uint32_t level = 0; level < compressed.MipLevelCount; ++level)
+    {
+        size_t layer_size = compressed.LevelByteSize(level) / 2;
+        auto   first      = compressed.Pixels.begin() + compressed.MipByteOffset(level);
+        EXPECT_TRUE(std::equal(first, first + layer_size, first + layer_size)) << "level " << level;
+    }
+
+    /*
+     * The last level is a single texel : the average of the image, within what the filter and the blocks allow
+     */
+    const uint8_t* last = decompressed.Pixels.data() + decompressed.MipByteOffset(5);
+    EXPECT_NEAR(int(last[3]), 191, 12);
+}
+
+TEST_F(TextureCompressorTest, SelectOptionsFollowsUsage)
+{
+    auto opaque      = MakeImage(16, 16, 5, false);
+    auto translucent = MakeImage(16, 16, 6, true);
+
+    EXPECT_EQ(TextureCompressor::SelectOptions(TextureUsage::COLOR, opaque, {}).Format, DecodedPixelFormat::BC7);
+    EXPECT_EQ(TextureCompressor::SelectOptions(TextureUsage::COLOR, opaque, {.HighQualityColor = false}).Format, DecodedPixelFormat::BC1);
+    EXPECT_EQ(TextureCompressor::SelectOptions(TextureUsage::COLOR, translucent, {.HighQualityColor = false}).Format, DecodedPixelFormat::BC3);
+    EXPECT_EQ(TextureCompressor::SelectOptions(TextureUsage::MASK, opaque, {}).Format, DecodedPixelFormat::BC4);
+
+    auto normal = TextureCompressor::SelectOptions(TextureUsage::NORMAL_MAP, opaque, {});
+    EXPECT_EQ(normal.Format, DecodedPixelFormat::BC5);
+    EXPECT_FALSE(normal.IsSrgb);
+    EXPECT_TRUE(normal.MipOptions.IsNormalMap);
+
+    DecodedImage hdr = {.Width = 4, .Height = 4, .Format = DecodedPixelFormat::RGBA32F};
+    EXPECT_EQ(TextureCompressor::SelectOptions(TextureUsage::COLOR, hdr, {}).Format, DecodedPixelFormat::BC6H);
+}
+
+TEST_F(TextureCompressorTest, ContainerRoundTrip)
+{
+    auto source_file = (m_directory / "albedo.png").string();
+    {
+        std::ofstream out(source_file, std::ios::binary);
+        out << "not really a png, the hash only reads bytes";
+    }
+
+    uint64_t source_hash = 0;
+    ASSERT_TRUE(TextureAssetSerializer::ComputeSourceHash(source_file, source_hash));
+    EXPECT_NE(source_hash, 0u);
+
+    DecodedImage compressed;
+    ASSERT_TRUE(TextureCompressor::Compress(MakeImage(64, 32, 7, false), {.Format = DecodedPixelFormat::BC1}, compressed));
+
+    auto filename = TextureAssetSerializer::CacheFilename(m_directory.string(), source_hash, compressed.Format);
+    EXPECT_NE(filename.find(".bc1.zetexture"), std::string::npos);
+    ASSERT_EQ(TextureAssetSerializer::Write(filename, compressed, source_hash), AssetContainerResult::SUCCESS);
+    EXPECT_FALSE(std::filesystem::exists(filename + ".tmp"));
+    EXPECT_TRUE(TextureDecoder::IsTextureAssetFile(filename));
+
+    DecodedImage header;
+    uint64_t     saved_hash = 0;
+    ASSERT_EQ(TextureAssetSerializer::ReadHeader(filename, header, &saved_hash), TextureAssetLoadResult::SUCCESS);
+    EXPECT_EQ(saved_hash, source_hash);
+    EXPECT_EQ(header.Width, 64u);
+    EXPECT_EQ(header.MipLevelCount, 7u);
+    EXPECT_EQ(header.Format, DecodedPixelFormat::BC1);
+    EXPECT_TRUE(header.IsSrgb);
+    EXPECT_TRUE(header.Pixels.empty());
+    EXPECT_EQ(TextureDecoder::EstimateByteSize(filename), compressed.ByteSize());
+
+    DecodedImage loaded;
+    ASSERT_EQ(TextureAssetSerializer::Load(filename, loaded), TextureAssetLoadResult::SUCCESS);
+    EXPECT_EQ(loaded.Pixels, compressed.Pixels);
+    EXPECT_EQ(loaded.MipLevelCount, compressed.MipLevelCount);
+
+    /*
+     * The decoder hands containers back as stored, whatever the flip asked for
+     */
+    DecodedImage decoded;
+    ASSERT_TRUE(TextureDecoder::Decode(filename, true, decoded));
+    EXPECT_EQ(decoded.Pixels, compressed.Pixels);
+
+    /*
+     * A flipped bit in the blocks fails the section checksum
+     */
+    {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        char last = 0;
+        file.get(last);
+        file.seekp(-1, std::ios::end);
+        file.put(char(last ^ 0x10));
+    }
+    EXPECT_EQ(TextureAssetSerializer::Load(filename, loaded), TextureAssetLoadResult::UNAVAILABLE);
+    EXPECT_TRUE(loaded.Pixels.empty());
+    EXPECT_EQ(TextureAssetSerializer::Load((m_directory / "missing.zetexture").string(), loaded), TextureAssetLoadResult::UNAVAILABLE);
+}
@@ -0,0 +1,338 @@
+#include <gtest/gtest.h>
+#include <Rendering/Textures/TextureDecodePool.h>
+#include <stb/stb_image_write.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <string>
+
+using namespace ZEngine::Helpers;
+using namespace ZEngine::Rendering::Textures;
+
+class TextureDecodePoolTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    /*
+     * Fake files : the name is the byte size the decode produces
+     */
+    static size_t FakeSize(std::string_view filename)
+    {
+        return std::stoull(std::string(filename));
+    }
+
+    static bool FakeDecode(std::string_view filename, bool, DecodedImage& image)
+    {
+        image.Width  = 1;
+        image.Height = 1;
+        image.Pixels.assign(FakeSize(filename), 0);
+        return true;
+    }
+
+    static std::vector<TextureDecodeResult> WaitForResults(TextureDecodePool& pool, size_t count)
+    {
+        std::vector<TextureDecodeResult> results;
+        auto                             deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while ((results.size() < count) && (std::chrono::steady_clock::now() < deadline))
+        {
+            if (!pool.PopCompleted(results, count - results.size()))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return results;
+    }
+};
+
+TEST_F(TextureDecodePoolTest, HigherPriorityDecodesFirst)
+{
+    std::promise<void> gate;
+    auto               gate_future = gate.get_future().share();
+    auto               decode      = [gate_future](std::string_view filename, bool flip, DecodedImage& image) {
+        if (filename == "1")
+        {
+            gate_future.wait();
+        }
+        return FakeDecode(filename, flip, image);
+    };
+
+    /* A single decode at a time, the first request holds it while the others queue up */
+    TextureDecodePool pool(1024, 1, decode, FakeSize);
+    pool.Enqueue({.Filename = "1", .Tag = 0, .Priority = TaskPriority::Low});
+    pool.Enqueue({.Filename = "2", .Tag = 1, .Priority = TaskPriority::Low});
+    pool.Enqueue({.Filename = "2", .Tag = 2, .Priority = TaskPriority::Normal});
+    pool.Enqueue({.Filename = "2", .Tag = 3, .Priority = TaskPriority::High});
+    pool.Enqueue({.Filename = "2", .Tag = 4, .Priority = TaskPriority::Normal});
+    pool.Enqueue({.Filename = "2", .Tag = 5, .Priority = TaskPriority::High});
+    EXPECT_EQ(pool.PendingCount(), 5u);
+    gate.set_value();
+
+    auto results = WaitForResults(pool, 6);
+    ASSERT_EQ(results.size(), 6u);
+
+    std::vector<uint64_t> order;
+    for (const auto& result : results)
+    {
+        EXPECT_TRUE(result.Succeeded);
+        order.push_back(result.Request.Tag);
+        pool.Release(result.ReservedByteSize);
+    }
+    EXPECT_EQ(order, (std::vector<uint64_t>{0, 3, 5, 2, 4, 1}));
+    EXPECT_EQ(pool.InFlightByteSize(), 0u);
+}
+
+TEST_F(TextureDecodePoolTest, InFlightBytesStayWithinBudget)
+{
+    std::atomic_size_t decoding{0};
+    std::atomic_size_t max_decoding{0};
+    auto               decode = [&](std::string_view filename, bool flip, DecodedImage& image) {
+        size_t current = ++decoding;
+        size_t max     = max_decoding.load();
+        while ((current > max) && !max_decoding.compare_exchange_weak(max, current)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        --decoding;
+        return FakeDecode(filename, flip, image);
+    };
+
+    /* Room for two 40 bytes decodes, the results keep their share until released */
+    TextureDecodePool pool(100, 8, decode, FakeSize);
+    for (uint64_t i = 0; i < 5; ++i)
+    {
+        pool.Enqueue({.Filename = "40", .Tag = i});
+    }
+
+    auto first = WaitForResults(pool, 2);
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(pool.InFlightByteSize(), 80u);
+    EXPECT_EQ(pool.PendingCount(), 3u);
+
+    size_t released = 0;
+    for (const auto& result : first)
+    {
+        EXPECT_EQ(result.ReservedByteSize, 40u);
+        pool.Release(result.ReservedByteSize);
+        released++;
+    }
+
+    while (released < 5)
+    {
+        auto results = WaitForResults(pool, 1);
+        ASSERT_EQ(results.size(), 1u);
+        EXPECT_LE(pool.InFlightByteSize(), pool.Budget());
+        pool.Release(results[0].ReservedByteSize);
+        released++;
+    }
+    EXPECT_LE(max_decoding.load(), 2u);
+    EXPECT_EQ(pool.InFlightByteSize(), 0u);
+
+    /* Larger than the whole budget : still decoded, alone */
+    pool.Enqueue({.Filename = "500", .Tag = 5});
+    auto oversized = WaitForResults(pool, 1);
+    ASSERT_EQ(oversized.size(), 1u);
+    EXPECT_EQ(pool.InFlightByteSize(), 500u);
+    pool.Release(oversized[0].ReservedByteSize);
+}
+
+TEST_F(TextureDecodePoolTest, FailedDecodeReleasesItsReservation)
+{
+    auto              decode = [](std::string_view, bool, DecodedImage& image) {
+        image.Pixels.resize(16);
+        return false;
+    };
+
+    TextureDecodePool pool(1024, 2, decode, FakeSize);
+    pool.Enqueue({.Filename = "64", .Tag = 7});
+
+    auto results = WaitForResults(pool, 1);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_FALSE(results[0].Succeeded);
+    EXPECT_EQ(results[0].Request.Tag, 7u);
+    EXPECT_EQ(results[0].ReservedByteSize, 0u);
+    EXPECT_TRUE(results[0].Image.Pixels.empty());
+    EXPECT_EQ(pool.InFlightByteSize(), 0u);
+}
+
+TEST_F(TextureDecodePoolTest, ShutdownDropsWaitingRequests)
+{
+    std::atomic_size_t decoded{0};
+    auto               decode = [&](std::string_view filename, bool flip, DecodedImage& image) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        decoded++;
+        return FakeDecode(filename, flip, image);
+    };
+
+    TextureDecodePool pool(1024, 1, decode, FakeSize);
+    for (uint64_t i = 0; i < 32; ++i)
+    {
+        pool.Enqueue({.Filename = "4", .Tag = i});
+    }
+    pool.Shutdown();
+
+    size_t decoded_at_shutdown = decoded.load();
+    EXPECT_LT(decoded_at_shutdown, 32u);
+    EXPECT_EQ(pool.PendingCount(), 0u);
+    EXPECT_FALSE(pool.HasCompleted());
+
+    pool.Enqueue({.Filename = "4", .Tag = 32});
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(decoded.load(), decoded_at_shutdown);
+}
+
+TEST_F(TextureDecodePoolTest, GeneratesMipChainOnDecodeThread)
+{
+    auto decode = [](std::string_view, bool, DecodedImage& image) {
+        image.Width  = 8;
+        image.Height = 4;
+        image.Pixels.assign(8 * 4 * 4, 200);
+        return true;
+    };
+
+    TextureDecodePool pool(1024, 2, decode, FakeSize);
+    pool.Enqueue({.Filename = "128", .Tag = 0, .GenerateMipChain = true, .MipOptions = {.Filter = ZEngine::Rendering::Buffers::MipFilter::BOX}});
+    pool.Enqueue({.Filename = "128", .Tag = 1});
+    pool.Enqueue({.Filename = "128", .Tag = 2, .GenerateMipChain = true, .MipOptions = {.Filter = ZEngine::Rendering::Buffers::MipFilter::BOX}, .FirstMipLevel = 2});
+
+    auto results = WaitForResults(pool, 3);
+    ASSERT_EQ(results.size(), 3u);
+    for (const auto& result : results)
+    {
+        ASSERT_TRUE(result.Succeeded);
+        const auto& image = result.Image;
+        if (result.Request.Tag == 0)
+        {
+            /* 8x4, 4x2, 2x1 and 1x1 one after the other */
+            EXPECT_EQ(image.MipLevelCount, 4u);
+            EXPECT_EQ(image.MipByteOffset(1), 128u);
+            EXPECT_EQ(image.MipByteOffset(3), 168u);
+            EXPECT_EQ(image.ByteSize(), 172u);
+            EXPECT_EQ(image.Pixels.back(), 200);
+        }
+        else if (result.Request.Tag == 2)
+        {
+            /* Streamed from its third level : 2x1 and 1x1 */
+            EXPECT_EQ(image.MipLevelCount, 2u);
+            EXPECT_EQ(image.Width, 2u);
+            EXPECT_EQ(image.Height, 1u);
+            EXPECT_EQ(image.ByteSize(), 12u);
+            EXPECT_EQ(image.Pixels.front(), 200);
+        }
+        else
+        {
+            EXPECT_EQ(image.MipLevelCount, 1u);
+            EXPECT_EQ(image.ByteSize(), 128u);
+        }
+        EXPECT_EQ(result.ReservedByteSize, image.ByteSize());
+        pool.Release(result.ReservedByteSize);
+    }
+    EXPECT_EQ(pool.InFlightByteSize(), 0u);
+}
+
+/*
+ * Headless end to end run with the stb decoder : a directory of generated PNGs in every channel count stb expands to RGBA
+ */
+TEST_F(TextureDecodePoolTest, DecodesGeneratedImageDirectory)
+{
+    constexpr int         ImageCount = 48;
+    constexpr int         Size       = 256;
+    std::filesystem::path directory  = std::filesystem::temp_directory_path() / "zengine_texture_decode_pool_test";
+    std::filesystem::create_directories(directory);
+
+    /* Red is the row, green the column, blue the image index : every pixel tells where it should land */
+    std::vector<std::string> filenames;
+    for (int i = 0; i < ImageCount; ++i)
+    {
+        int                  channel = (i % 4) + 1;
+        std::vector<uint8_t> pixels(Size * Size * channel);
+        for (int y = 0; y < Size; ++y)
+        {
+            for (int x = 0; x < Size; ++x)
+            {
+                uint8_t  texel[4] = {uint8_t(y), uint8_t(x), uint8_t(i), uint8_t(255 - x)};
+                uint8_t* out      = &pixels[(y * Size + x) * channel];
+                if (channel <= 2)
+                {
+                    out[0] = texel[0];
+                    if (channel == 2)
+                    {
+                        out[1] = texel[3];
+                    }
+                }
+                else
+                {
+                    std::copy_n(texel, channel, out);
+                }
+            }
+        }
+
+        auto filename = (directory / ("image_" + std::to_string(i) + ".png")).string();
+        ASSERT_NE(stbi_write_png(filename.c_str(), Size, Size, channel, pixels.data(), Size * channel), 0);
+        filenames.push_back(filename);
+    }
+
+    EXPECT_EQ(TextureDecoder::EstimateByteSize(filenames[0]), size_t(Size) * Size * 4);
+    EXPECT_EQ(TextureDecoder::EstimateByteSize((directory / "missing.png").string()), 0u);
+
+    /* Budget for a handful of images at once */
+    TextureDecodePool pool(8 * Size * Size * 4);
+    auto              start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ImageCount; ++i)
+    {
+        pool.Enqueue({.Filename = filenames[i], .Tag = uint64_t(i), .FlipVertically = (i % 2) == 1});
+    }
+    pool.Enqueue({.Filename = (directory / "missing.png").string(), .Tag = ImageCount});
+
+    size_t received = 0;
+    while (received < ImageCount + 1)
+    {
+        auto results = WaitForResults(pool, 1);
+        ASSERT_EQ(results.size(), 1u);
+        EXPECT_LE(pool.InFlightByteSize(), pool.Budget());
+
+        const auto& result = results[0];
+        if (result.Request.Tag == ImageCount)
+        {
+            EXPECT_FALSE(result.Succeeded);
+        }
+        else
+        {
+            int channel = int(result.Request.Tag % 4) + 1;
+            ASSERT_TRUE(result.Succeeded);
+            ASSERT_EQ(result.Image.Width, uint32_t(Size));
+            ASSERT_EQ(result.Image.Height, uint32_t(Size));
+            ASSERT_EQ(result.Image.ByteSize(), size_t(Size) * Size * 4);
+            EXPECT_EQ(result.Image.Format, DecodedPixelFormat::RGBA8);
+
+            for (int y : {0, 17, Size - 1})
+            {
+                int            row   = result.Request.FlipVertically ? (Size - 1 - y) : y;
+                const uint8_t* texel = &result.Image.Pixels[(y * Size + 5) * 4];
+                EXPECT_EQ(texel[0], uint8_t(row));
+                if (channel <= 2)
+                {
+                    EXPECT_EQ(texel[1], uint8_t(row));
+                    EXPECT_EQ(texel[2], uint8_t(row));
+                    EXPECT_EQ(texel[3], channel == 2 ? uint8_t(255 - 5) : uint8_t(255));
+                }
+                else
+                {
+                    EXPECT_EQ(texel[1], uint8_t(5));
+                    EXPECT_EQ(texel[2], uint8_t(result.Request.Tag));
+                    EXPECT_EQ(texel[3], channel == 4 ? uint8_t(255 - 5) : uint8_t(255));
+                }
+            }
+        }
+        pool.Release(result.ReservedByteSize);
+        received++;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    RecordProperty("ImagesPerSecond", std::to_string(ImageCount / seconds));
+    RecordProperty("MegapixelsPerSecond", std::to_string(ImageCount * double(Size * Size) / 1e6 / seconds));
+    EXPECT_EQ(pool.InFlightByteSize(), 0u);
+
+    std::filesystem::remove_all(directory);
+}
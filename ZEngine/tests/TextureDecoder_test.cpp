@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <Rendering/Textures/TextureDecoder.h>
+#include <stb/stb_image_write.h>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+using namespace ZEngine::Rendering::Textures;
+
+class TextureDecoderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "zengine_texture_decoder_test";
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    /*
+     * Smooth gradients with some high frequency noise, to exercise every JPEG coefficient band
+     */
+    static std::vector<uint8_t> MakePixels(int width, int height, int channel, uint32_t seed)
+    {
+        std::vector<uint8_t> pixels(size_t(width) * height * channel);
+        uint32_t             state = seed * 2654435761u + 1;
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                state = state * 1664525u + 1013904223u;
+                for (int c = 0; c < channel; ++c)
+                {
+                    int value                                     = (x * (c + 1) + y * (3 - c) + int((state >> (8 * c)) & 0x1F)) & 0xFF;
+                    pixels[(size_t(y) * width + x) * channel + c] = uint8_t(value);
+                }
+            }
+        }
+        return pixels;
+    }
+
+    std::string Write(const std::string& name, std::function<int(const char*)> writer)
+    {
+        auto filename = (m_directory / name).string();
+        EXPECT_NE(writer(filename.c_str()), 0) << filename;
+        return filename;
+    }
+
+    /*
+     * Both backends, both orientations : the SIMD build must reproduce the scalar one bit for bit
+     */
+    static void ExpectBackendsMatch(const std::string& filename)
+    {
+        for (bool flip : {false, true})
+        {
+            DecodedImage scalar, simd;
+            ASSERT_TRUE(TextureDecoder::DecodeWithBackend(TextureDecodeBackend::Scalar, filename, flip, scalar)) << filename;
+            ASSERT_TRUE(TextureDecoder::DecodeWithBackend(TextureDecodeBackend::Simd, filename, flip, simd)) << filename;
+            EXPECT_EQ(scalar.Width, simd.Width) << filename;
+            EXPECT_EQ(scalar.Height, simd.Height) << filename;
+            EXPECT_EQ(scalar.LayerCount, simd.LayerCount) << filename;
+            EXPECT_EQ(scalar.Format, simd.Format) << filename;
+            EXPECT_TRUE(scalar.Pixels == simd.Pixels) << filename << (flip ? " (flipped)" : "");
+        }
+    }
+
+    std::filesystem::path m_directory;
+};
+
+TEST_F(TextureDecoderTest, ScalarBackendIsAlwaysAvailable)
+{
+    EXPECT_TRUE(TextureDecoder::IsBackendAvailable(TextureDecodeBackend::Scalar));
+    auto expected = TextureDecoder::IsBackendAvailable(TextureDecodeBackend::Simd) ? TextureDecodeBackend::Simd : TextureDecodeBackend::Scalar;
+    EXPECT_EQ(TextureDecoder::DefaultBackend(), expected);
+
+    DecodedImage image;
+    EXPECT_FALSE(TextureDecoder::DecodeWithBackend(TextureDecodeBackend::Scalar, (m_directory / "missing.png").string(), false, image));
+    EXPECT_FALSE(TextureDecoder::DecodeWithBackend(TextureDecodeBackend::Simd, (m_directory / "missing.png").string(), false, image));
+}
+
+TEST_F(TextureDecoderTest, PngIsLossless)
+{
+    constexpr int Width = 67, Height = 45;
+    for (int channel = 1; channel <= 4; ++channel)
+    {
+        auto pixels   = MakePixels(Width, Height, channel, channel);
+        auto filename = Write("png_" + std::to_string(channel) + ".png", [&](const char* path) { return stbi_write_png(path, Width, Height, channel, pixels.data(), Width * channel); });
+
+        DecodedImage image;
+        ASSERT_TRUE(TextureDecoder::Decode(filename, true, image));
+        ASSERT_EQ(image.ByteSize(), size_t(Width) * Height * 4);
+
+        for (int y = 0; y < Height; ++y)
+        {
+            for (int x = 0; x < Width; ++x)
+            {
+                const uint8_t* source  = &pixels[(size_t(Height - 1 - y) * Width + x) * channel];
+                const uint8_t* texel   = &image.Pixels[(size_t(y) * Width + x) * 4];
+                uint8_t        grey    = source[0];
+                uint8_t        rgba[4] = {grey, grey, grey, channel == 2 ? source[1] : uint8_t(255)};
+                if (channel >= 3)
+                {
+                    std::copy_n(source, 3, rgba);
+                    rgba[3] = (channel == 4) ? source[3] : uint8_t(255);
+                }
+                ASSERT_EQ(std::memcmp(texel, rgba, 4), 0) << "channel " << channel << " at " << x << ", " << y;
+            }
+        }
+        ExpectBackendsMatch(filename);
+    }
+}
+
+TEST_F(TextureDecoderTest, JpegBackendsMatch)
+{
+    if (!TextureDecoder::IsBackendAvailable(TextureDecodeBackend::Simd))
+    {
+        GTEST_SKIP() << "No SIMD decode path on this CPU";
+    }
+
+    /* Odd sizes leave partial MCUs on the right and bottom edges, quality at or under 90 writes 4:2:0 chroma */
+    const int sizes[][2] = {{8, 8}, {333, 217}, {1024, 768}, {17, 1001}};
+    for (const auto& size : sizes)
+    {
+        for (int channel : {1, 3})
+        {
+            for (int quality : {50, 90, 100})
+            {
+                auto pixels   = MakePixels(size[0], size[1], channel, quality);
+                auto name     = "jpeg_" + std::to_string(size[0]) + "x" + std::to_string(size[1]) + "_" + std::to_string(channel) + "_" + std::to_string(quality) + ".jpg";
+                auto filename = Write(name, [&](const char* path) { return stbi_write_jpg(path, size[0], size[1], channel, pixels.data(), quality); });
+                ExpectBackendsMatch(filename);
+            }
+        }
+    }
+}
+
+TEST_F(TextureDecoderTest, HdrBackendsMatch)
+{
+    /* 1024 wide : 256 texel faces, the projection runs split over the thread pool */
+    for (int width : {64, 1024})
+    {
+        int                height = width / 2;
+        std::vector<float> pixels(size_t(width) * height * 3);
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = std::exp2(float(int(i % 97)) / 8.0f - 6.0f);
+        }
+        auto filename = Write("env_" + std::to_string(width) + ".hdr", [&](const char* path) { return stbi_write_hdr(path, width, height, 3, pixels.data()); });
+
+        DecodedImage image;
+        ASSERT_TRUE(TextureDecoder::Decode(filename, true, image));
+        EXPECT_TRUE(image.IsCubemap);
+        EXPECT_EQ(image.LayerCount, 6u);
+        EXPECT_EQ(image.Width, uint32_t(width / 4));
+        EXPECT_EQ(image.ByteSize(), TextureDecoder::EstimateByteSize(filename));
+
+        if (TextureDecoder::IsBackendAvailable(TextureDecodeBackend::Simd))
+        {
+            ExpectBackendsMatch(filename);
+        }
+    }
+}
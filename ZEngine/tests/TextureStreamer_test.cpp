@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+#include <Rendering/Textures/TextureStreamer.h>
+
+using namespace ZEngine::Rendering::Textures;
+
+class TextureStreamerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    /*
+     * 1024x1024 RGBA8 with its 11 levels : the 64 texels tail starts at level 4
+     */
+    static DecodedImage MakeShape(uint32_t size = 1024)
+    {
+        DecodedImage shape  = {};
+        shape.Width         = size;
+        shape.Height        = size;
+        shape.MipLevelCount = ZEngine::Rendering::Buffers::Bitmap::MipLevelCount(size, size);
+        return shape;
+    }
+
+    /*
+     * Registers the textures and lands their tails
+     */
+    static void RegisterResident(TextureStreamer& streamer, std::initializer_list<uint32_t> keys, const DecodedImage& shape)
+    {
+        for (uint32_t key : keys)
+        {
+            streamer.Register(key, shape);
+            streamer.OnResident(key);
+        }
+    }
+
+    static std::vector<TextureStreamingAction> Update(TextureStreamer& streamer, bool land = true)
+    {
+        std::vector<TextureStreamingAction> actions;
+        streamer.Update(actions);
+        if (land)
+        {
+            for (const auto& action : actions)
+            {
+                streamer.OnResident(action.Key);
+            }
+        }
+        return actions;
+    }
+};
+
+TEST_F(TextureStreamerTest, LevelSelection)
+{
+    DecodedImage    shape    = MakeShape();
+    TextureStreamer streamer = {};
+
+    EXPECT_EQ(shape.MipLevelCount, 11u);
+    EXPECT_EQ(streamer.TailFirstLevel(shape), 4u);
+    EXPECT_EQ(streamer.TailFirstLevel(MakeShape(32)), 0u);
+
+    /* The coarsest level still holding a texel per pixel */
+    EXPECT_EQ(TextureStreamer::SelectFirstLevel(shape, 2000.0f), 0u);
+    EXPECT_EQ(TextureStreamer::SelectFirstLevel(shape, 1024.0f), 0u);
+    EXPECT_EQ(TextureStreamer::SelectFirstLevel(shape, 512.0f), 1u);
+    EXPECT_EQ(TextureStreamer::SelectFirstLevel(shape, 300.0f), 1u);
+    EXPECT_EQ(TextureStreamer::SelectFirstLevel(shape, 0.0f), 10u);
+
+    EXPECT_EQ(TextureStreamer::LevelsByteSize(shape, 0), shape.MipByteOffset(11));
+    EXPECT_EQ(TextureStreamer::LevelsByteSize(shape, 10), 4u);
+    EXPECT_EQ(TextureStreamer::LevelsByteSize(shape, 11), 0u);
+}
+
+TEST_F(TextureStreamerTest, TexturesStartWithTheirTail)
+{
+    DecodedImage    shape    = MakeShape();
+    TextureStreamer streamer = {};
+    streamer.Register(7, shape);
+
+    const auto* texture = streamer.Find(7);
+    ASSERT_NE(texture, nullptr);
+    EXPECT_TRUE(texture->IsPending());
+    EXPECT_EQ(texture->ResidentFirstLevel, 11u);
+    EXPECT_EQ(texture->TargetFirstLevel, 4u);
+    EXPECT_EQ(streamer.CommittedByteSize(), TextureStreamer::LevelsByteSize(shape, 4));
+
+    /* Pending on its tail : no load before it lands */
+    streamer.ReportUsage(7, 1024.0f);
+    EXPECT_TRUE(Update(streamer, false).empty());
+
+    streamer.OnResident(7);
+    EXPECT_FALSE(texture->IsPending());
+    EXPECT_EQ(texture->ResidentFirstLevel, 4u);
+
+    streamer.Unregister(7);
+    EXPECT_EQ(streamer.Find(7), nullptr);
+    EXPECT_EQ(streamer.CommittedByteSize(), 0u);
+}
+
+TEST_F(TextureStreamerTest, UsageLoadsTheLargestDeficitFirst)
+{
+    DecodedImage    shape    = MakeShape();
+    TextureStreamer streamer = {TextureStreamingOptions{.MaxLoadsPerUpdate = 2}};
+    RegisterResident(streamer, {1, 2, 3, 4}, shape);
+
+    streamer.ReportUsage(1, 100.0f);
+    streamer.ReportUsage(2, 1024.0f);
+    streamer.ReportUsage(3, 500.0f);
+    streamer.ReportUsage(3, 50.0f); /* The largest report of a frame wins */
+    streamer.ReportUsage(4, 10.0f); /* The tail is enough */
+    streamer.ReportUsage(99, 1024.0f);
+
+    auto actions = Update(streamer);
+    ASSERT_EQ(actions.size(), 2u);
+    EXPECT_EQ(actions[0].Key, 2u);
+    EXPECT_EQ(actions[0].FirstLevel, 0u);
+    EXPECT_EQ(actions[1].Key, 3u);
+    EXPECT_EQ(actions[1].FirstLevel, 1u);
+
+    /* Still in use the next frame : the one left behind gets its turn */
+    streamer.ReportUsage(1, 100.0f);
+    actions = Update(streamer);
+    ASSERT_EQ(actions.size(), 1u);
+    EXPECT_EQ(actions[0].Key, 1u);
+    EXPECT_EQ(actions[0].FirstLevel, 3u);
+    EXPECT_EQ(streamer.Find(1)->ResidentFirstLevel, 3u);
+
+    /* Everything resident as asked : nothing to do */
+    streamer.ReportUsage(1, 100.0f);
+    streamer.ReportUsage(2, 1024.0f);
+    EXPECT_TRUE(Update(streamer).empty());
+}
+
+TEST_F(TextureStreamerTest, BudgetEvictsLeastRecentlyUsedLevels)
+{
+    DecodedImage shape     = MakeShape();
+    uint64_t     tail_size = TextureStreamer::LevelsByteSize(shape, 4);
+    uint64_t     full_size = TextureStreamer::LevelsByteSize(shape, 0);
+
+    /* Room for the tails and two full textures */
+    TextureStreamer streamer = {TextureStreamingOptions{.BudgetByteSize = 4 * tail_size + 2 * (full_size - tail_size)}};
+    RegisterResident(streamer, {1, 2, 3, 4}, shape);
+
+    streamer.ReportUsage(1, 1024.0f);
+    Update(streamer);
+    streamer.ReportUsage(2, 1024.0f);
+    Update(streamer);
+    EXPECT_EQ(streamer.Find(1)->ResidentFirstLevel, 0u);
+    EXPECT_EQ(streamer.Find(2)->ResidentFirstLevel, 0u);
+    EXPECT_EQ(streamer.CommittedByteSize(), streamer.Options().BudgetByteSize);
+
+    /* 1 was used least recently : it loses its largest level, that's enough for 3 */
+    streamer.ReportUsage(3, 300.0f);
+    auto actions = Update(streamer, false);
+    ASSERT_EQ(actions.size(), 2u);
+    EXPECT_EQ(actions[0].Key, 1u);
+    EXPECT_EQ(actions[0].FirstLevel, 1u);
+    EXPECT_EQ(actions[1].Key, 3u);
+    EXPECT_EQ(actions[1].FirstLevel, 1u);
+    EXPECT_LE(streamer.CommittedByteSize(), streamer.Options().BudgetByteSize);
+    EXPECT_EQ(streamer.Find(2)->TargetFirstLevel, 0u);
+
+    /* Pending evictions are left alone until they land */
+    EXPECT_TRUE(streamer.Find(1)->IsPending());
+    streamer.OnResident(1);
+    streamer.OnResident(3);
+
+    /*
+     * Textures in use keep what they asked for : even with 1 down to its tail, 4 can't have its largest level. The next one
+     * fits as things are, nothing is evicted for it
+     */
+    streamer.ReportUsage(2, 1024.0f);
+    streamer.ReportUsage(3, 300.0f);
+    streamer.ReportUsage(4, 1024.0f);
+    actions = Update(streamer);
+    ASSERT_EQ(actions.size(), 1u);
+    EXPECT_EQ(actions[0].Key, 4u);
+    EXPECT_EQ(actions[0].FirstLevel, 1u);
+    EXPECT_EQ(streamer.Find(1)->ResidentFirstLevel, 1u);
+    EXPECT_EQ(streamer.Find(2)->ResidentFirstLevel, 0u);
+    EXPECT_EQ(streamer.Find(3)->ResidentFirstLevel, 1u);
+    EXPECT_LE(streamer.CommittedByteSize(), streamer.Options().BudgetByteSize);
+}
+
+TEST_F(TextureStreamerTest, TexturesInUseGiveBackWhatTheyNoLongerNeed)
+{
+    DecodedImage    shape     = MakeShape();
+    uint64_t        tail_size = TextureStreamer::LevelsByteSize(shape, 4);
+    uint64_t        full_size = TextureStreamer::LevelsByteSize(shape, 0);
+    TextureStreamer streamer  = {TextureStreamingOptions{.BudgetByteSize = 2 * tail_size + (full_size - tail_size)}};
+    RegisterResident(streamer, {1, 2}, shape);
+
+    streamer.ReportUsage(1, 1024.0f);
+    Update(streamer);
+    EXPECT_EQ(streamer.Find(1)->ResidentFirstLevel, 0u);
+
+    /*
+     * 1 moved away, both are in use : 1 can give back the two levels it no longer needs, that's still not room enough for
+     * all of 2. Its largest level makes room for the next one
+     */
+    streamer.ReportUsage(1, 200.0f);
+    streamer.ReportUsage(2, 1024.0f);
+    auto actions = Update(streamer);
+    ASSERT_EQ(actions.size(), 2u);
+    EXPECT_EQ(actions[0].Key, 1u);
+    EXPECT_EQ(actions[0].FirstLevel, 1u);
+    EXPECT_EQ(actions[1].Key, 2u);
+    EXPECT_EQ(actions[1].FirstLevel, 1u);
+    EXPECT_LE(streamer.CommittedByteSize(), streamer.Options().BudgetByteSize);
+}
+
+TEST_F(TextureStreamerTest, LoweredBudgetAndFailures)
+{
+    DecodedImage    shape     = MakeShape();
+    uint64_t        tail_size = TextureStreamer::LevelsByteSize(shape, 4);
+    TextureStreamer streamer  = {};
+    RegisterResident(streamer, {1, 2}, shape);
+
+    streamer.ReportUsage(1, 1024.0f);
+    streamer.ReportUsage(2, 1024.0f);
+    Update(streamer);
+
+    /* Down to the tails, which stay whatever the budget */
+    streamer.SetOptions({.BudgetByteSize = 0});
+    auto actions = Update(streamer);
+    ASSERT_EQ(actions.size(), 2u);
+    EXPECT_EQ(actions[0].Key, 1u);
+    EXPECT_EQ(actions[0].FirstLevel, 4u);
+    EXPECT_EQ(actions[1].Key, 2u);
+    EXPECT_EQ(streamer.CommittedByteSize(), 2 * tail_size);
+
+    /* A failed load keeps the levels the texture had */
+    streamer.SetOptions({});
+    streamer.ReportUsage(1, 1024.0f);
+    actions = Update(streamer, false);
+    ASSERT_EQ(actions.size(), 1u);
+    streamer.OnFailed(1);
+    EXPECT_FALSE(streamer.Find(1)->IsPending());
+    EXPECT_EQ(streamer.Find(1)->TargetFirstLevel, 4u);
+    EXPECT_EQ(streamer.CommittedByteSize(), 2 * tail_size);
+}
+
+TEST_F(TextureStreamerTest, SameReportsSameActions)
+{
+    DecodedImage                                     shape     = MakeShape();
+    uint64_t                                         tail_size = TextureStreamer::LevelsByteSize(shape, 4);
+    std::vector<std::vector<TextureStreamingAction>> runs[2];
+    for (auto& run : runs)
+    {
+        TextureStreamer streamer = {TextureStreamingOptions{.BudgetByteSize = 32 * tail_size + 1024 * 1024 * 3, .MaxLoadsPerUpdate = 3}};
+        for (uint32_t key = 0; key < 32; ++key)
+        {
+            streamer.Register(key * 7 % 32, shape);
+        }
+        for (uint32_t key = 0; key < 32; ++key)
+        {
+            streamer.OnResident(key);
+        }
+
+        for (uint32_t frame = 0; frame < 40; ++frame)
+        {
+            for (uint32_t key = 0; key < 32; ++key)
+            {
+                if ((key + frame) % 5 < 2)
+                {
+                    streamer.ReportUsage(key, float((key * 37 + frame * 11) % 1200));
+                }
+            }
+            run.emplace_back(Update(streamer));
+            EXPECT_LE(streamer.CommittedByteSize(), streamer.Options().BudgetByteSize);
+        }
+    }
+
+    ASSERT_EQ(runs[0].size(), runs[1].size());
+    size_t action_count = 0;
+    for (size_t frame = 0; frame < runs[0].size(); ++frame)
+    {
+        ASSERT_EQ(runs[0][frame].size(), runs[1][frame].size());
+        for (size_t i = 0; i < runs[0][frame].size(); ++i)
+        {
+            EXPECT_EQ(runs[0][frame][i].Key, runs[1][frame][i].Key);
+            EXPECT_EQ(runs[0][frame][i].FirstLevel, runs[1][frame][i].FirstLevel);
+        }
+        action_count += runs[0][frame].size();
+    }
+    EXPECT_GT(action_count, 40u);
+}
@@ -51,3 +51,227 @@ TEST_F(ThreadPoolTest, MultipleTasksExecution)
 
     EXPECT_EQ(counter, numberOfTasks);
 }
+
+TEST_F(ThreadPoolTest, SubmitReturnsFuture)
+{
+    auto value = ThreadPoolHelper::Submit([] { return 21 * 2; });
+    EXPECT_EQ(value.get(), 42);
+
+    std::atomic<bool> executed = false;
+    auto              done     = ThreadPoolHelper::Submit([&executed] { executed = true; });
+    done.wait();
+    EXPECT_TRUE(executed);
+}
+
+TEST_F(ThreadPoolTest, FutureCarriesException)
+{
+    auto result = ThreadPoolHelper::Submit([]() -> int { throw std::runtime_error("task failure"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTest, PriorityOrdering)
+{
+    ThreadPool         pool(1);
+
+    std::promise<void> gate;
+    auto               gate_future = gate.get_future().share();
+    std::promise<void> blocked;
+    pool.Enqueue([&blocked, gate_future] {
+        blocked.set_value();
+        gate_future.wait();
+    });
+    blocked.get_future().wait();
+
+    std::mutex       order_mutex;
+    std::vector<int> order;
+    auto             record = [&](int value) {
+        std::lock_guard l(order_mutex);
+        order.push_back(value);
+    };
+
+    auto low    = pool.EnqueueWithResult([&] { record(2); }, TaskPriority::Low);
+    auto normal = pool.EnqueueWithResult([&] { record(1); }, TaskPriority::Normal);
+    auto high   = pool.EnqueueWithResult([&] { record(0); }, TaskPriority::High);
+
+    gate.set_value();
+    low.wait();
+    normal.wait();
+    high.wait();
+
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+    EXPECT_EQ(order[2], 2);
+}
+
+TEST_F(ThreadPoolTest, NestedSubmissionsAreStolen)
+{
+    ThreadPool       pool(4);
+    std::atomic<int> counter = 0;
+    const int        fan_out = 64;
+
+    auto             root    = pool.EnqueueWithResult([&pool, &counter] {
+        std::vector<std::future<void>> children;
+        for (int i = 0; i < fan_out; ++i)
+        {
+            children.emplace_back(pool.EnqueueWithResult([&counter] { counter++; }));
+        }
+        return children;
+    });
+
+    for (auto& child : root.get())
+    {
+        child.wait();
+    }
+    EXPECT_EQ(counter, fan_out);
+}
+
+TEST_F(ThreadPoolTest, ShutdownJoinsWorkers)
+{
+    std::atomic<int> counter = 0;
+    {
+        ThreadPool pool(4);
+        std::vector<std::future<void>> results;
+        for (int i = 0; i < 100; ++i)
+        {
+            results.emplace_back(pool.EnqueueWithResult([&counter] { counter++; }));
+        }
+
+        for (auto& result : results)
+        {
+            result.wait();
+        }
+
+        EXPECT_EQ(pool.WorkerCount(), 4u);
+        pool.Shutdown();
+        EXPECT_EQ(pool.WorkerCount(), 0u);
+
+        /* Submissions after shutdown are discarded */
+        pool.Enqueue([&counter] { counter++; });
+    }
+    EXPECT_EQ(counter, 100);
+}
+
+TEST_F(ThreadPoolTest, ParallelForCoversEveryIndexOnce)
+{
+    for (size_t count : {0, 1, 100, 1000, 100003})
+    {
+        std::vector<std::atomic<int>> visits(count);
+        ThreadPoolHelper::ParallelFor(count, 256, [&visits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                visits[i]++;
+            }
+        });
+        EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v == 1; }));
+    }
+}
+
+TEST_F(ThreadPoolTest, ParallelForFromWorkerAndExceptions)
+{
+    /* Nested from a pool worker : the calling worker drains the batches itself if nobody helps */
+    auto nested = ThreadPoolHelper::Submit([] {
+        std::atomic<size_t> sum = 0;
+        ThreadPoolHelper::ParallelFor(10000, 64, [&sum](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                sum += i;
+            }
+        });
+        return sum.load();
+    });
+    EXPECT_EQ(nested.get(), size_t(10000 * 9999 / 2));
+
+    EXPECT_THROW(ThreadPoolHelper::ParallelFor(1000, 10,
+                                               [](size_t begin, size_t) {
+                                                   if (begin == 500)
+                                                   {
+                                                       throw std::runtime_error("batch failure");
+                                                   }
+                                               }),
+                 std::runtime_error);
+}
+
+TEST_F(ThreadPoolTest, ParallelForBoundedConcurrency)
+{
+    for (size_t limit : {1, 2, 3})
+    {
+        std::atomic<size_t> active      = 0;
+        std::atomic<size_t> max_active  = 0;
+        std::atomic<size_t> visit_count = 0;
+        ThreadPoolHelper::ParallelFor(
+            64, 1,
+            [&](size_t begin, size_t end) {
+                size_t now = ++active;
+                for (size_t seen = max_active.load(); now > seen && !max_active.compare_exchange_weak(seen, now);)
+                {
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                visit_count += end - begin;
+                --active;
+            },
+            TaskPriority::High, limit);
+
+        EXPECT_EQ(visit_count, 64u);
+        EXPECT_LE(max_active, limit);
+    }
+}
+
+TEST_F(ThreadPoolTest, BlockedWorkerTasksAreStolen)
+{
+    const int                    fan_out = 16;
+    std::mutex                   ids_mutex;
+    std::vector<std::thread::id> ids;
+    std::atomic<int>             done = 0;
+    std::promise<void>           all_done;
+    auto                         all_done_future = all_done.get_future();
+    /* Declared last : its workers are joined before what they touch goes away */
+    ThreadPool                   pool(4);
+
+    /* The children land on the root's own deque while it blocks : only the other workers can run them */
+    auto root = pool.EnqueueWithResult([&] {
+        for (int i = 0; i < fan_out; ++i)
+        {
+            pool.Enqueue([&] {
+                {
+                    std::lock_guard l(ids_mutex);
+                    ids.push_back(std::this_thread::get_id());
+                }
+                if (++done == fan_out)
+                {
+                    all_done.set_value();
+                }
+            });
+        }
+        all_done_future.wait();
+        return std::this_thread::get_id();
+    });
+
+    ASSERT_EQ(root.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    auto root_id = root.get();
+    ASSERT_EQ(ids.size(), size_t(fan_out));
+    EXPECT_TRUE(std::none_of(ids.begin(), ids.end(), [root_id](std::thread::id id) { return id == root_id; }));
+}
+
+TEST_F(ThreadPoolTest, ManyTasksAllExecute)
+{
+    const int          task_count = 200000;
+    std::atomic<int>   counter    = 0;
+    std::promise<void> done;
+    auto               done_future = done.get_future();
+    ThreadPool         pool(4);
+
+    for (int i = 0; i < task_count; ++i)
+    {
+        pool.Enqueue([&] {
+            if (++counter == task_count)
+            {
+                done.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(done_future.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+    EXPECT_EQ(counter, task_count);
+    EXPECT_EQ(pool.PendingTaskCount(), 0u);
+}
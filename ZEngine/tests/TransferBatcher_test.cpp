@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include <Hardwares/VulkanDevice.h>
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+using namespace ZEngine::Hardwares;
+
+/*
+ * Runs the transfer batch on a headless device with the Khronos validation layer (lavapipe when no GPU is around) : any validation
+ * error fails the test. It is skipped when the layer, a Vulkan 1.3 device or timeline semaphores are missing.
+ * Devices with a dedicated transfer queue family also cover the release/acquire split between the families.
+ */
+class TransferBatcherTest : public ::testing::Test
+{
+protected:
+    static constexpr const char*  ValidationLayerName = "VK_LAYER_KHRONOS_validation";
+    static constexpr VkDeviceSize BufferByteSize      = 4096;
+
+    void SetUp() override
+    {
+        uint32_t layer_count = 0;
+        vkEnumerateInstanceLayerProperties(&layer_count, nullptr);
+        std::vector<VkLayerProperties> layers(layer_count);
+        vkEnumerateInstanceLayerProperties(&layer_count, layers.data());
+        if (std::none_of(layers.begin(), layers.end(), [](const VkLayerProperties& layer) { return std::strcmp(layer.layerName, ValidationLayerName) == 0; }))
+        {
+            GTEST_SKIP() << ValidationLayerName << " is not installed";
+        }
+
+        const char*          layer_name           = ValidationLayerName;
+        const char*          extension_name       = VK_EXT_DEBUG_UTILS_EXTENSION_NAME;
+        VkApplicationInfo    app_info             = {.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO, .pNext = nullptr, .pApplicationName = "ZEngineTests", .applicationVersion = 1, .pEngineName = "ZEngine", .engineVersion = 1, .apiVersion = VK_API_VERSION_1_3};
+        VkInstanceCreateInfo instance_create_info = {.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO, .pNext = nullptr, .flags = 0, .pApplicationInfo = &app_info, .enabledLayerCount = 1, .ppEnabledLayerNames = &layer_name, .enabledExtensionCount = 1, .ppEnabledExtensionNames = &extension_name};
+        if (vkCreateInstance(&instance_create_info, nullptr, &m_device.Instance) != VK_SUCCESS)
+        {
+            GTEST_SKIP() << "No Vulkan 1.3 instance";
+        }
+
+        VkDebugUtilsMessengerCreateInfoEXT messenger_create_info = {};
+        messenger_create_info.sType                              = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+        messenger_create_info.messageSeverity                    = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        messenger_create_info.messageType                        = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+        messenger_create_info.pfnUserCallback                    = ValidationCallback;
+        auto create_messenger                                    = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(m_device.Instance, "vkCreateDebugUtilsMessengerEXT"));
+        ASSERT_NE(create_messenger, nullptr);
+        ASSERT_EQ(create_messenger(m_device.Instance, &messenger_create_info, nullptr, &m_messenger), VK_SUCCESS);
+
+        uint32_t device_count = 0;
+        vkEnumeratePhysicalDevices(m_device.Instance, &device_count, nullptr);
+        std::vector<VkPhysicalDevice> physical_devices(device_count);
+        vkEnumeratePhysicalDevices(m_device.Instance, &device_count, physical_devices.data());
+
+        VkPhysicalDeviceVulkan12Features vulkan_12_features = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
+        VkPhysicalDeviceFeatures2        features           = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &vulkan_12_features};
+        for (VkPhysicalDevice physical_device : physical_devices)
+        {
+            vkGetPhysicalDeviceFeatures2(physical_device, &features);
+            if (vulkan_12_features.timelineSemaphore)
+            {
+                m_device.PhysicalDevice = physical_device;
+                break;
+            }
+        }
+        if (m_device.PhysicalDevice == VK_NULL_HANDLE)
+        {
+            GTEST_SKIP() << "No device with timeline semaphores";
+        }
+
+        /*
+         * Same family selection as VulkanDevice::Initialize : a transfer only family when there is one
+         */
+        uint32_t family_count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_device.PhysicalDevice, &family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(family_count);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_device.PhysicalDevice, &family_count, families.data());
+        for (uint32_t index = 0; index < family_count; ++index)
+        {
+            if ((families[index].queueFlags & VK_QUEUE_GRAPHICS_BIT) && (m_device.GraphicFamilyIndex >= family_count))
+            {
+                m_device.GraphicFamilyIndex = index;
+            }
+            else if ((families[index].queueFlags & VK_QUEUE_TRANSFER_BIT) && !(families[index].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+            {
+                m_device.TransferFamilyIndex = index;
+            }
+        }
+        ASSERT_LT(m_device.GraphicFamilyIndex, family_count);
+        m_device.TransferFamilyIndex             = (m_device.TransferFamilyIndex < family_count) ? m_device.TransferFamilyIndex : m_device.GraphicFamilyIndex;
+        m_device.HasSeperateTransfertQueueFamily = m_device.GraphicFamilyIndex != m_device.TransferFamilyIndex;
+
+        const float                          queue_priority = 1.0f;
+        std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
+        for (uint32_t family_index : std::set{m_device.GraphicFamilyIndex, m_device.TransferFamilyIndex})
+        {
+            queue_create_infos.push_back({.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO, .pNext = nullptr, .flags = 0, .queueFamilyIndex = family_index, .queueCount = 1, .pQueuePriorities = &queue_priority});
+        }
+
+        VkPhysicalDeviceVulkan12Features enabled_12_features = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES, .timelineSemaphore = VK_TRUE};
+        VkDeviceCreateInfo               device_create_info  = {.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO, .pNext = &enabled_12_features, .queueCreateInfoCount = static_cast<uint32_t>(queue_create_infos.size()), .pQueueCreateInfos = queue_create_infos.data()};
+        ASSERT_EQ(vkCreateDevice(m_device.PhysicalDevice, &device_create_info, nullptr, &m_device.LogicalDevice), VK_SUCCESS);
+        m_device.GetDeviceQueues();
+
+        VmaAllocatorCreateInfo vma_allocator_create_info = {.physicalDevice = m_device.PhysicalDevice, .device = m_device.LogicalDevice, .instance = m_device.Instance, .vulkanApiVersion = VK_API_VERSION_1_3};
+        ASSERT_EQ(vmaCreateAllocator(&vma_allocator_create_info, &m_device.VmaAllocator), VK_SUCCESS);
+
+        m_batcher.Initialize(&m_device);
+    }
+
+    void TearDown() override
+    {
+        if (m_device.LogicalDevice)
+        {
+            m_batcher.Deinitialize();
+            for (auto& buffer : m_buffers)
+            {
+                m_device.EnqueueBufferForDeletion(buffer);
+            }
+            m_device.QueueWaitAll();
+            m_device.CollectDirtyResources();
+            vmaDestroyAllocator(m_device.VmaAllocator);
+            vkDestroyDevice(m_device.LogicalDevice, nullptr);
+        }
+
+        if (m_messenger)
+        {
+            auto destroy_messenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(m_device.Instance, "vkDestroyDebugUtilsMessengerEXT"));
+            destroy_messenger(m_device.Instance, m_messenger, nullptr);
+        }
+
+        if (m_device.Instance)
+        {
+            vkDestroyInstance(m_device.Instance, nullptr);
+        }
+    }
+
+    static VKAPI_ATTR VkBool32 VKAPI_CALL ValidationCallback(VkDebugUtilsMessageSeverityFlagBitsEXT, VkDebugUtilsMessageTypeFlagsEXT, const VkDebugUtilsMessengerCallbackDataEXT* callback_data, void*)
+    {
+        ADD_FAILURE() << callback_data->pMessage;
+        return VK_FALSE;
+    }
+
+    /*
+     * Host visible buffer, used as upload source and read back destination
+     */
+    BufferView CreateHostBuffer(const std::vector<uint8_t>& content)
+    {
+        BufferView buffer = m_device.CreateBuffer(BufferByteSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+        m_buffers.push_back(buffer);
+
+        VmaAllocationInfo allocation_info = {};
+        vmaGetAllocationInfo(m_device.VmaAllocator, buffer.Allocation, &allocation_info);
+        std::memcpy(allocation_info.pMappedData, content.data(), content.size());
+        vmaFlushAllocation(m_device.VmaAllocator, buffer.Allocation, 0, VK_WHOLE_SIZE);
+        return buffer;
+    }
+
+    BufferView CreateDeviceBuffer()
+    {
+        BufferView buffer = m_device.CreateBuffer(BufferByteSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+        m_buffers.push_back(buffer);
+        return buffer;
+    }
+
+    std::vector<uint8_t> ReadBack(const BufferView& source)
+    {
+        BufferView   readback = CreateHostBuffer(std::vector<uint8_t>(BufferByteSize, 0));
+        VkBufferCopy region   = {.srcOffset = 0, .dstOffset = 0, .size = BufferByteSize};
+        EXPECT_TRUE(m_batcher.Wait(m_batcher.EnqueueBufferCopy(source, readback, {&region, 1})));
+
+        VmaAllocationInfo allocation_info = {};
+        vmaGetAllocationInfo(m_device.VmaAllocator, readback.Allocation, &allocation_info);
+        vmaInvalidateAllocation(m_device.VmaAllocator, readback.Allocation, 0, VK_WHOLE_SIZE);
+        const uint8_t* data = static_cast<const uint8_t*>(allocation_info.pMappedData);
+        return std::vector<uint8_t>(data, data + BufferByteSize);
+    }
+
+    static std::vector<uint8_t> Pattern(uint8_t seed)
+    {
+        std::vector<uint8_t> content(BufferByteSize);
+        for (size_t i = 0; i < content.size(); ++i)
+        {
+            content[i] = static_cast<uint8_t>(seed + i * 7);
+        }
+        return content;
+    }
+
+    VulkanDevice             m_device;
+    TransferBatcher          m_batcher;
+    VkDebugUtilsMessengerEXT m_messenger{VK_NULL_HANDLE};
+    std::vector<BufferView>  m_buffers;
+};
+
+TEST_F(TransferBatcherTest, PartialWritesAfterFirstUploadKeepTheRest)
+{
+    auto       first       = Pattern(1);
+    auto       second      = Pattern(100);
+    BufferView destination = CreateDeviceBuffer();
+    BufferView full_source = CreateHostBuffer(first);
+    BufferView sub_source  = CreateHostBuffer(second);
+
+    VkBufferCopy whole = {.srcOffset = 0, .dstOffset = 0, .size = BufferByteSize};
+    ASSERT_TRUE(m_batcher.Wait(m_batcher.EnqueueBufferCopy(full_source, destination, {&whole, 1})));
+
+    /*
+     * The first batch handed the buffer to the graphic queue : the partial updates (SetSubData) write it again from the transfer queue
+     */
+    std::vector<VkBufferCopy> regions = {{.srcOffset = 64, .dstOffset = 64, .size = 128}, {.srcOffset = 1024, .dstOffset = 2048, .size = 256}};
+    ASSERT_TRUE(m_batcher.Wait(m_batcher.EnqueueBufferCopy(sub_source, destination, regions)));
+
+    auto expected = first;
+    for (const auto& region : regions)
+    {
+        std::copy_n(second.begin() + region.srcOffset, region.size, expected.begin() + region.dstOffset);
+    }
+    EXPECT_EQ(ReadBack(destination), expected);
+}
+
+TEST_F(TransferBatcherTest, BatchesInFlightReuseTheirSlots)
+{
+    BufferView           destination = CreateDeviceBuffer();
+    std::vector<uint8_t> expected(BufferByteSize, 0);
+    uint64_t             token       = 0;
+
+    /*
+     * More flushed batches than slots, each writing its own slice
+     */
+    const uint32_t     batch_count = TransferBatcher::MaxBatchInFlight * 3;
+    const VkDeviceSize slice_size  = BufferByteSize / batch_count;
+    for (uint32_t batch = 0; batch < batch_count; ++batch)
+    {
+        auto         content = Pattern(static_cast<uint8_t>(batch * 31));
+        BufferView   source  = CreateHostBuffer(content);
+        VkBufferCopy region  = {.srcOffset = batch * slice_size, .dstOffset = batch * slice_size, .size = slice_size};
+        token                = m_batcher.EnqueueBufferCopy(source, destination, {&region, 1});
+        EXPECT_EQ(m_batcher.Flush(), token);
+        std::copy_n(content.begin() + region.srcOffset, region.size, expected.begin() + region.dstOffset);
+    }
+
+    ASSERT_TRUE(m_batcher.Wait(token));
+    EXPECT_TRUE(m_batcher.IsComplete(token));
+    expected.resize(batch_count * slice_size);
+
+    auto content = ReadBack(destination);
+    content.resize(batch_count * slice_size);
+    EXPECT_EQ(content, expected);
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <Rendering/Meshes/VertexQuantization.h>
+#include <random>
+
+using namespace ZEngine::Rendering::Meshes;
+
+class VertexQuantizationTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t VertexStride = 8;
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static glm::vec3 RandomUnitVector(std::mt19937& rng)
+    {
+        std::normal_distribution<float> value(0.0f, 1.0f);
+        glm::vec3                       v;
+        do
+        {
+            v = glm::vec3(value(rng), value(rng), value(rng));
+        } while (glm::length(v) < 1e-3f);
+        return glm::normalize(v);
+    }
+
+    /*
+     * Quantization step of a unorm16 position over the extent, the encoder rounds so the error is half of it
+     */
+    static float PositionErrorBound(float extent)
+    {
+        return extent / 65535.0f * 0.5f + extent * 1e-6f;
+    }
+
+    /*
+     * Half floats keep 11 significant bits, rounding to nearest is within half an ulp
+     */
+    static float TexCoordErrorBound(float value)
+    {
+        return std::max(std::abs(value), 6.1e-5f) * std::ldexp(1.0f, -11);
+    }
+};
+
+TEST_F(VertexQuantizationTest, OctahedralNormalErrorBound)
+{
+    std::mt19937 rng(3);
+    float        max_angle = 0.0f;
+
+    std::vector<glm::vec3> normals = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}, glm::normalize(glm::vec3(1, 1, -1))};
+    for (int i = 0; i < 200000; ++i)
+    {
+        normals.push_back(RandomUnitVector(rng));
+    }
+
+    for (const auto& normal : normals)
+    {
+        glm::vec3 decoded = VertexQuantization::DecodeOctahedral(VertexQuantization::EncodeOctahedral(normal));
+        ASSERT_NEAR(glm::length(decoded), 1.0f, 1e-5f);
+        /* atan2 rather than acos, which has no precision left this close to 1 */
+        max_angle = std::max(max_angle, std::atan2(glm::length(glm::cross(normal, decoded)), glm::dot(normal, decoded)));
+    }
+
+    /* snorm16 x2 : well under a hundredth of a degree */
+    EXPECT_LT(glm::degrees(max_angle), 0.01f);
+}
+
+TEST_F(VertexQuantizationTest, VertexErrorBounds)
+{
+    std::mt19937                          rng(7);
+    std::uniform_real_distribution<float> position(-250.0f, 1250.0f);
+    std::uniform_real_distribution<float> tex_coord(-4.0f, 4.0f);
+
+    std::vector<float> vertices;
+    BoundingBox        bounds;
+    for (int v = 0; v < 50000; ++v)
+    {
+        glm::vec3 p = {position(rng), position(rng) * 0.01f, position(rng)};
+        glm::vec3 n = RandomUnitVector(rng);
+        vertices.insert(vertices.end(), {p.x, p.y, p.z, n.x, n.y, n.z, tex_coord(rng), tex_coord(rng)});
+        bounds.Expand(p);
+    }
+
+    glm::vec3 extent = bounds.Max - bounds.Min;
+    for (size_t v = 0; v < vertices.size() / VertexStride; ++v)
+    {
+        const float* in = &vertices[v * VertexStride];
+        float        out[VertexStride];
+        VertexQuantization::DecodeVertex(VertexQuantization::EncodeVertex(in, bounds), bounds, out);
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            ASSERT_LE(std::abs(out[axis] - in[axis]), PositionErrorBound(extent[axis])) << "vertex " << v << " axis " << axis;
+        }
+        ASSERT_GT(glm::dot(glm::vec3(in[3], in[4], in[5]), glm::vec3(out[3], out[4], out[5])), 0.99999f);
+        ASSERT_LE(std::abs(out[6] - in[6]), TexCoordErrorBound(in[6]));
+        ASSERT_LE(std::abs(out[7] - in[7]), TexCoordErrorBound(in[7]));
+    }
+}
+
+TEST_F(VertexQuantizationTest, FlatBoundsDecodeToTheirPlane)
+{
+    /* Zero extent on an axis : every vertex decodes onto the plane, not to NaN */
+    float       vertex[VertexStride] = {3.0f, -2.0f, 5.0f, 0.0f, 1.0f, 0.0f, 0.5f, 0.25f};
+    BoundingBox bounds;
+    bounds.Expand({3.0f, -2.0f, 0.0f});
+    bounds.Expand({3.0f, -2.0f, 10.0f});
+
+    float out[VertexStride];
+    VertexQuantization::DecodeVertex(VertexQuantization::EncodeVertex(vertex, bounds), bounds, out);
+    EXPECT_EQ(out[0], 3.0f);
+    EXPECT_EQ(out[1], -2.0f);
+    EXPECT_NEAR(out[2], 5.0f, PositionErrorBound(10.0f));
+    EXPECT_EQ(out[6], 0.5f);
+    EXPECT_EQ(out[7], 0.25f);
+}
+
+TEST_F(VertexQuantizationTest, CompressRebasesAndNarrowsIndices)
+{
+    std::mt19937                          rng(11);
+    std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+
+    /* Scene layout : absolute vertex = mesh.VertexOffset + index, the last mesh needs 32 bits indices */
+    const std::vector<uint32_t> vertex_counts = {3, 1000, 65536, 70000};
+    std::vector<float>          vertices;
+    std::vector<uint32_t>       indices;
+    std::vector<MeshVNext>      meshes;
+    for (uint32_t vertex_count : vertex_counts)
+    {
+        MeshVNext& mesh   = meshes.emplace_back();
+        mesh.VertexOffset = uint32_t(vertices.size() / VertexStride);
+        mesh.VertexCount  = vertex_count;
+        mesh.IndexOffset  = uint32_t(indices.size());
+        mesh.IndexCount   = 3 * (vertex_count / 2 + 1);
+
+        for (uint32_t v = 0; v < vertex_count; ++v)
+        {
+            glm::vec3 n = RandomUnitVector(rng);
+            vertices.insert(vertices.end(), {value(rng), value(rng), value(rng), n.x, n.y, n.z, value(rng), value(rng)});
+        }
+        /* Odd index counts, first and last vertices referenced */
+        indices.insert(indices.end(), {0, vertex_count - 1, vertex_count / 2});
+        for (uint32_t i = 3; i < mesh.IndexCount; ++i)
+        {
+            indices.push_back(rng() % vertex_count);
+        }
+    }
+    meshes.push_back({.IndexCount = 0, .IndexOffset = uint32_t(indices.size())});
+
+    CompactGeometry geometry = VertexQuantization::Compress(vertices, indices, meshes);
+    ASSERT_EQ(geometry.Meshes.size(), meshes.size());
+    EXPECT_EQ(geometry.Vertices.size() * sizeof(CompactVertex), vertices.size() * sizeof(float) / 2);
+    EXPECT_EQ(geometry.Meshes[0].IndexFormat, IndexFormat::UINT16);
+    EXPECT_EQ(geometry.Meshes[2].IndexFormat, IndexFormat::UINT16);
+    EXPECT_EQ(geometry.Meshes[3].IndexFormat, IndexFormat::UINT32);
+    EXPECT_EQ(geometry.Meshes[4].VertexCount, 0u);
+
+    for (size_t m = 0; m < meshes.size(); ++m)
+    {
+        const auto& mesh    = meshes[m];
+        const auto& compact = geometry.Meshes[m];
+        glm::vec3   extent  = compact.Bounds.Max - compact.Bounds.Min;
+        ASSERT_EQ(compact.IndexCount, mesh.IndexCount);
+        for (uint32_t i = 0; i < mesh.IndexCount; ++i)
+        {
+            uint32_t local = VertexQuantization::FetchIndex(geometry, compact, i);
+            ASSERT_LT(local, compact.VertexCount);
+
+            const float* in = &vertices[size_t(mesh.VertexOffset + indices[mesh.IndexOffset + i]) * VertexStride];
+            float        out[VertexStride];
+            VertexQuantization::DecodeVertex(geometry.Vertices[compact.VertexOffset + local], compact.Bounds, out);
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                ASSERT_LE(std::abs(out[axis] - in[axis]), PositionErrorBound(extent[axis]));
+            }
+            ASSERT_LE(std::abs(out[6] - in[6]), TexCoordErrorBound(in[6]));
+        }
+    }
+}
+
+TEST_F(VertexQuantizationTest, CompressCarriesLodRanges)
+{
+    std::mt19937                          rng(5);
+    std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+
+    /* Two meshes, levels appended after every full mesh as the importer lays them out, the second mesh has none */
+    std::vector<float>        vertices;
+    std::vector<uint32_t>     indices;
+    std::vector<MeshVNext>    meshes;
+    std::vector<MeshLodChain> lod_chains(1);
+    for (uint32_t m = 0; m < 2; ++m)
+    {
+        MeshVNext& mesh   = meshes.emplace_back();
+        mesh.VertexOffset = uint32_t(vertices.size() / VertexStride);
+        mesh.VertexCount  = 100;
+        mesh.IndexOffset  = uint32_t(indices.size());
+        mesh.IndexCount   = 3 * 61;
+        for (uint32_t v = 0; v < mesh.VertexCount; ++v)
+        {
+            vertices.insert(vertices.end(), {value(rng), value(rng), value(rng), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f});
+        }
+        indices.insert(indices.end(), {0, mesh.VertexCount - 1, 1});
+        for (uint32_t i = 3; i < mesh.IndexCount; ++i)
+        {
+            indices.push_back(rng() % mesh.VertexCount);
+        }
+    }
+    for (uint32_t level = 0; level < 2; ++level)
+    {
+        auto& lod       = lod_chains[0].Lods[lod_chains[0].LodCount++];
+        lod.IndexOffset = uint32_t(indices.size());
+        lod.IndexCount  = (level == 0) ? 3 * 21 : 3 * 5;
+        lod.Error       = 0.1f * float(level + 1);
+        for (uint32_t i = 0; i < lod.IndexCount; ++i)
+        {
+            indices.push_back(indices[i]);
+        }
+    }
+
+    CompactGeometry geometry = VertexQuantization::Compress(vertices, indices, meshes, lod_chains);
+    const auto&     compact  = geometry.Meshes[0];
+    ASSERT_EQ(compact.IndexFormat, IndexFormat::UINT16);
+    ASSERT_EQ(compact.Lods.LodCount, 2u);
+    EXPECT_EQ(geometry.Meshes[1].Lods.LodCount, 0u);
+
+    /* Levels follow the mesh in its own slice, before the next mesh */
+    uint32_t expected_offset = compact.IndexOffset + compact.IndexCount;
+    for (uint32_t level = 0; level < compact.Lods.LodCount; ++level)
+    {
+        const auto& lod = compact.Lods.Lods[level];
+        EXPECT_EQ(lod.IndexOffset, expected_offset);
+        EXPECT_EQ(lod.IndexCount, lod_chains[0].Lods[level].IndexCount);
+        EXPECT_EQ(lod.Error, lod_chains[0].Lods[level].Error);
+        for (uint32_t i = 0; i < lod.IndexCount; ++i)
+        {
+            EXPECT_EQ(VertexQuantization::FetchIndex(geometry, compact, lod.IndexOffset - compact.IndexOffset + i), VertexQuantization::FetchIndex(geometry, compact, i));
+        }
+        expected_offset += lod.IndexCount;
+    }
+    EXPECT_LE(expected_offset, geometry.Meshes[1].IndexOffset);
+}
@@ -87,4 +87,165 @@ TEST(BitmapTest, TestVerticalCross2)
 
     EXPECT_TRUE(std::filesystem::exists(current_path + "/screenshot3.hdr"));
     EXPECT_TRUE(std::filesystem::exists(current_path + "/screenshot4.hdr"));
-}
\ No newline at end of file
+}
+
+/*
+ * Mip chain filtering, on synthetic bitmaps
+ */
+static Bitmap MakeCheckerboard(int width, int height, int channel, uint8_t low, uint8_t high)
+{
+    Bitmap bitmap(width, height, channel, BitmapFormat::UNSIGNED_BYTE);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            std::fill_n(&bitmap.Buffer[(y * width + x) * channel], channel, ((x + y) % 2) ? high : low);
+        }
+    }
+    return bitmap;
+}
+
+TEST(BitmapTest, MipLevelCount)
+{
+    EXPECT_EQ(Bitmap::MipLevelCount(1, 1), 1u);
+    EXPECT_EQ(Bitmap::MipLevelCount(2, 1), 2u);
+    EXPECT_EQ(Bitmap::MipLevelCount(256, 256), 9u);
+    EXPECT_EQ(Bitmap::MipLevelCount(300, 17), 9u);
+    EXPECT_EQ(Bitmap::MipLevelCount(1, 1024), 11u);
+}
+
+TEST(BitmapTest, MipChainSizes)
+{
+    for (auto filter : {MipFilter::BOX, MipFilter::KAISER})
+    {
+        Bitmap level_0 = MakeCheckerboard(13, 6, 4, 0, 255);
+        auto   levels  = Bitmap::GenerateMipChain(level_0, {.Filter = filter});
+        ASSERT_EQ(levels.size(), 3u);
+
+        const int expected[][2] = {{6, 3}, {3, 1}, {1, 1}};
+        for (size_t i = 0; i < levels.size(); ++i)
+        {
+            EXPECT_EQ(levels[i].Width, expected[i][0]);
+            EXPECT_EQ(levels[i].Height, expected[i][1]);
+            EXPECT_EQ(levels[i].Channel, 4);
+            EXPECT_EQ(levels[i].Buffer.size(), size_t(expected[i][0] * expected[i][1] * 4));
+        }
+    }
+}
+
+TEST(BitmapTest, MipFiltersKeepUniformColor)
+{
+    for (auto filter : {MipFilter::BOX, MipFilter::KAISER})
+    {
+        for (int channel = 1; channel <= 4; ++channel)
+        {
+            Bitmap level_0 = MakeCheckerboard(37, 21, channel, 93, 93);
+            for (const auto& level : Bitmap::GenerateMipChain(level_0, {.Filter = filter}))
+            {
+                for (uint8_t value : level.Buffer)
+                {
+                    ASSERT_EQ(value, 93) << "channel " << channel << " at " << level.Width << "x" << level.Height;
+                }
+            }
+        }
+    }
+}
+
+TEST(BitmapTest, MipColorsAreAveragedInLinearSpace)
+{
+    Bitmap level_0 = MakeCheckerboard(8, 8, 4, 0, 255);
+
+    /* Half black, half white : linear 0.5 is sRGB 188. Alpha is linear, as are colors when the bitmap isn't sRGB */
+    Bitmap srgb    = Bitmap::Downsample(level_0, {.Filter = MipFilter::BOX, .IsSrgb = true});
+    Bitmap linear  = Bitmap::Downsample(level_0, {.Filter = MipFilter::BOX, .IsSrgb = false});
+    ASSERT_EQ(srgb.Width, 4);
+    ASSERT_EQ(srgb.Height, 4);
+    for (int i = 0; i < srgb.Width * srgb.Height; ++i)
+    {
+        EXPECT_EQ(srgb.Buffer[i * 4 + 0], 188);
+        EXPECT_EQ(srgb.Buffer[i * 4 + 1], 188);
+        EXPECT_EQ(srgb.Buffer[i * 4 + 2], 188);
+        EXPECT_EQ(srgb.Buffer[i * 4 + 3], 128);
+        EXPECT_EQ(linear.Buffer[i * 4 + 0], 128);
+        EXPECT_EQ(linear.Buffer[i * 4 + 3], 128);
+    }
+
+    /* Grey-alpha : the second channel is alpha */
+    Bitmap grey_alpha = Bitmap::Downsample(MakeCheckerboard(8, 8, 2, 0, 255), {.Filter = MipFilter::BOX});
+    EXPECT_EQ(grey_alpha.Buffer[0], 188);
+    EXPECT_EQ(grey_alpha.Buffer[1], 128);
+
+    /* The whole chain is filtered from full precision levels : the last one still is the average, up to the rounding */
+    auto levels = Bitmap::GenerateMipChain(level_0, {.Filter = MipFilter::KAISER});
+    EXPECT_NEAR(levels.back().Buffer[0], 188, 1);
+    EXPECT_NEAR(levels.back().Buffer[3], 128, 1);
+}
+
+TEST(BitmapTest, MipKaiserKeepsLinearRamp)
+{
+    /* A ramp of 2 per texel halves to a ramp of 4 per texel, away from the clamped edges */
+    Bitmap level_0(64, 4, 1, BitmapFormat::UNSIGNED_BYTE);
+    for (int y = 0; y < level_0.Height; ++y)
+    {
+        for (int x = 0; x < level_0.Width; ++x)
+        {
+            level_0.Buffer[y * level_0.Width + x] = uint8_t(40 + 2 * x);
+        }
+    }
+
+    for (auto filter : {MipFilter::BOX, MipFilter::KAISER})
+    {
+        Bitmap level_1 = Bitmap::Downsample(level_0, {.Filter = filter, .IsSrgb = false});
+        for (int x = 4; x < level_1.Width - 4; ++x)
+        {
+            EXPECT_NEAR(level_1.Buffer[x], 41 + 4 * x, 1) << x;
+        }
+    }
+}
+
+TEST(BitmapTest, MipNormalsAreRenormalized)
+{
+    /* Columns alternate between +X and +Z normals : their average points half way and is unit length again */
+    Bitmap level_0(8, 8, 4, BitmapFormat::UNSIGNED_BYTE);
+    for (int y = 0; y < level_0.Height; ++y)
+    {
+        for (int x = 0; x < level_0.Width; ++x)
+        {
+            uint8_t* texel = &level_0.Buffer[(y * level_0.Width + x) * 4];
+            texel[0]       = (x % 2) ? 128 : 255;
+            texel[1]       = 128;
+            texel[2]       = (x % 2) ? 255 : 128;
+            texel[3]       = 255;
+        }
+    }
+
+    auto levels = Bitmap::GenerateMipChain(level_0, {.Filter = MipFilter::BOX, .IsNormalMap = true});
+    ASSERT_EQ(levels.size(), 3u);
+    for (const auto& level : levels)
+    {
+        for (int i = 0; i < level.Width * level.Height; ++i)
+        {
+            const uint8_t* texel = &level.Buffer[i * 4];
+            EXPECT_NEAR(texel[0] / 255.0f * 2.0f - 1.0f, 0.7071f, 0.01f);
+            EXPECT_NEAR(texel[1] / 255.0f * 2.0f - 1.0f, 0.0f, 0.01f);
+            EXPECT_NEAR(texel[2] / 255.0f * 2.0f - 1.0f, 0.7071f, 0.01f);
+            EXPECT_EQ(texel[3], 255);
+        }
+    }
+}
+
+TEST(BitmapTest, MipFloatBitmapsStayLinear)
+{
+    std::vector<float> pixels = {0.0f, 1.0f, 2.0f, 1.0f, 4.0f, 1.0f, 6.0f, 1.0f, 8.0f, 1.0f, 10.0f, 1.0f, 12.0f, 1.0f, 14.0f, 1.0f};
+    Bitmap             level_0(2, 4, 2, BitmapFormat::FLOAT, pixels.data());
+
+    Bitmap             level_1 = Bitmap::Downsample(level_0, {.Filter = MipFilter::BOX});
+    ASSERT_EQ(level_1.Width, 1);
+    ASSERT_EQ(level_1.Height, 2);
+
+    const float* texels = reinterpret_cast<const float*>(level_1.Buffer.data());
+    EXPECT_FLOAT_EQ(texels[0], 3.0f);
+    EXPECT_FLOAT_EQ(texels[1], 1.0f);
+    EXPECT_FLOAT_EQ(texels[2], 11.0f);
+    EXPECT_FLOAT_EQ(texels[3], 1.0f);
+}
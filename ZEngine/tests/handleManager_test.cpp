@@ -1,5 +1,6 @@
 #include <Helpers/HandleManager.h>
 #include <gtest/gtest.h>
+#include <set>
 #include <thread>
 
 class HandleManagerTest : public ::testing::Test
@@ -73,12 +74,40 @@ TEST_F(HandleManagerTest, RemoveHandle)
     EXPECT_FALSE(handle.Valid());
 }
 
+TEST_F(HandleManagerTest, GrowsPastInitialCapacity)
+{
+    std::vector<ZEngine::Helpers::Handle<int*>> handles;
+    const size_t                                initial_size = manager->Size();
+    const size_t                                count        = initial_size + 3 * ZEngine::Helpers::HandleManager<int*>::PageSize;
+    std::vector<int>                            values(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i]   = static_cast<int>(i);
+        auto handle = manager->Add(&values[i]);
+        ASSERT_TRUE(handle.Valid());
+        handles.push_back(handle);
+    }
+
+    EXPECT_GE(manager->Size(), count);
+    EXPECT_EQ(manager->Delta(), count);
+
+    /*
+     * Growing must not relocate existing slots
+     */
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(*(*manager)[handles[i]], static_cast<int>(i));
+    }
+}
+
 TEST_F(HandleManagerTest, FullCapacity)
 {
+    manager = std::make_unique<ZEngine::Helpers::HandleManager<int*>>(10, 10);
     std::vector<ZEngine::Helpers::Handle<int*>> handles;
-    std::vector<int>                            values(manager->Size());
+    std::vector<int>                            values(manager->MaxSize());
 
-    for (size_t i = 0; i < manager->Size(); ++i)
+    for (size_t i = 0; i < manager->MaxSize(); ++i)
     {
         values[i]   = static_cast<int>(i);
         auto handle = manager->Add(&values[i]);
@@ -89,6 +118,57 @@ TEST_F(HandleManagerTest, FullCapacity)
     int  extraValue    = 999;
     auto invalidHandle = manager->Add(&extraValue);
     EXPECT_FALSE(invalidHandle.Valid());
+
+    manager->Remove(handles[4]);
+    auto reusedHandle = manager->Add(&extraValue);
+    EXPECT_TRUE(reusedHandle.Valid());
+    EXPECT_EQ(reusedHandle.Index, 4);
+    EXPECT_FALSE(manager->Create().Valid());
+}
+
+TEST_F(HandleManagerTest, StaleHandleIsRejected)
+{
+    int  value1 = 42;
+    int  value2 = 84;
+
+    auto handle = manager->Add(&value1);
+    auto stale  = handle;
+    manager->Remove(handle);
+
+    EXPECT_TRUE(stale.Valid());
+    EXPECT_FALSE(manager->IsAlive(stale));
+    EXPECT_EQ(manager->TryAccess(stale), nullptr);
+
+    auto fresh = manager->Add(&value2);
+    EXPECT_EQ(fresh.Index, stale.Index);
+    EXPECT_TRUE(manager->IsAlive(fresh));
+    EXPECT_FALSE(manager->IsAlive(stale));
+
+    /*
+     * Writes through the stale handle must not reach the slot's new owner
+     */
+    manager->Update(stale, &value1);
+    EXPECT_EQ(*(*manager)[fresh], 84);
+
+    manager->Remove(stale);
+    EXPECT_TRUE(manager->IsAlive(fresh));
+    EXPECT_EQ(manager->Delta(), 1u);
+}
+
+TEST_F(HandleManagerTest, ToHandleSkipsFreeSlots)
+{
+    int  values[3] = {1, 2, 3};
+    auto h0        = manager->Add(&values[0]);
+    auto h1        = manager->Add(&values[1]);
+    auto h2        = manager->Add(&values[2]);
+
+    manager->Remove(h1);
+
+    EXPECT_EQ(manager->Head(), 3u);
+    EXPECT_TRUE(manager->ToHandle(0).Valid());
+    EXPECT_FALSE(manager->ToHandle(1).Valid());
+    EXPECT_TRUE(manager->ToHandle(2).Valid());
+    EXPECT_EQ(*(*manager)[manager->ToHandle(2)], 3);
 }
 
 TEST_F(HandleManagerTest, ReuseSlot)
@@ -139,4 +219,203 @@ TEST_F(HandleManagerTest, ConcurrentAccess)
     {
         thread.join();
     }
-}
\ No newline at end of file
+}
+TEST_F(HandleManagerTest, ConcurrentCreateAccessRemove)
+{
+    manager                                = std::make_unique<ZEngine::Helpers::HandleManager<int*>>(0);
+    const int                writer_count  = 4;
+    const int                reader_count  = 4;
+    const int                rounds        = 2000;
+    std::atomic_bool         done          = false;
+    std::atomic<int>         stale_reads   = 0;
+    std::vector<int>         values(writer_count * rounds);
+    std::vector<std::thread> threads;
+
+    /*
+     * Readers keep probing handles that writers are concurrently recycling : once a handle is observed as released,
+     * it must never be reported alive again, even after its slot has been handed to a new owner
+     */
+    std::vector<ZEngine::Helpers::Handle<int*>> published(writer_count);
+    std::mutex                                  published_mutex;
+
+    for (int r = 0; r < reader_count; ++r)
+    {
+        threads.emplace_back([&] {
+            std::vector<ZEngine::Helpers::Handle<int*>> released;
+            while (!done)
+            {
+                for (int w = 0; w < writer_count; ++w)
+                {
+                    ZEngine::Helpers::Handle<int*> handle;
+                    {
+                        std::lock_guard lock(published_mutex);
+                        handle = published[w];
+                    }
+
+                    if (handle && !manager->IsAlive(handle))
+                    {
+                        stale_reads++;
+                        released.push_back(handle);
+                    }
+                }
+
+                for (const auto& handle : released)
+                {
+                    EXPECT_FALSE(manager->IsAlive(handle));
+                    EXPECT_EQ(manager->TryAccess(handle), nullptr);
+                }
+                if (released.size() > 64)
+                {
+                    released.erase(released.begin(), released.begin() + 32);
+                }
+            }
+        });
+    }
+
+    for (int w = 0; w < writer_count; ++w)
+    {
+        threads.emplace_back([&, w] {
+            std::vector<ZEngine::Helpers::Handle<int*>> handles;
+            for (int i = 0; i < rounds; ++i)
+            {
+                int index     = w * rounds + i;
+                values[index] = index;
+                auto handle   = manager->Add(&values[index]);
+                ASSERT_TRUE(handle.Valid());
+                EXPECT_EQ(*(*manager)[handle], index);
+                handles.push_back(handle);
+
+                {
+                    std::lock_guard lock(published_mutex);
+                    published[w] = handle;
+                }
+
+                if (i % 3 == 2)
+                {
+                    for (auto& h : handles)
+                    {
+                        manager->Remove(h);
+                        EXPECT_FALSE(h.Valid());
+                    }
+                    handles.clear();
+                }
+            }
+
+            for (auto& h : handles)
+            {
+                manager->Remove(h);
+            }
+        });
+    }
+
+    for (size_t t = reader_count; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+    done = true;
+    for (int r = 0; r < reader_count; ++r)
+    {
+        threads[r].join();
+    }
+
+    EXPECT_EQ(manager->Delta(), 0u);
+    EXPECT_LE(manager->Head(), static_cast<uint32_t>(writer_count * 3));
+}
+
+TEST_F(HandleManagerTest, ForEachVisitsOnlyLiveEntries)
+{
+    std::vector<int>                            values(100);
+    std::vector<ZEngine::Helpers::Handle<int*>> handles;
+    for (int i = 0; i < 100; ++i)
+    {
+        values[i] = i;
+        handles.push_back(manager->Add(&values[i]));
+    }
+
+    for (int i = 0; i < 100; i += 3)
+    {
+        manager->Remove(handles[i]);
+    }
+
+    std::set<int> visited;
+    manager->ForEach([&](int* value) { EXPECT_TRUE(visited.insert(*value).second); });
+
+    EXPECT_EQ(visited.size(), manager->Delta());
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(visited.count(i), (i % 3) ? 1u : 0u);
+    }
+}
+
+TEST_F(HandleManagerTest, RemoveIfReleasesMatchingEntries)
+{
+    std::vector<int>                            values(64);
+    std::vector<ZEngine::Helpers::Handle<int*>> handles;
+    for (int i = 0; i < 64; ++i)
+    {
+        values[i] = i;
+        handles.push_back(manager->Add(&values[i]));
+    }
+
+    uint32_t removed = manager->RemoveIf([](int* value) { return (*value % 2) == 0; });
+    EXPECT_EQ(removed, 32u);
+    EXPECT_EQ(manager->Delta(), 32u);
+
+    for (int i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(manager->IsAlive(handles[i]), (i % 2) == 1);
+    }
+
+    /*
+     * Released slots go back to the free list and the packed array keeps tracking new entries
+     */
+    int  extra        = 1000;
+    auto extra_handle = manager->Add(&extra);
+    EXPECT_EQ(extra_handle.Index % 2, 0);
+
+    int sum = 0;
+    manager->ForEach([&](int* value) { sum += *value; });
+    EXPECT_EQ(sum, 32 * 32 + extra);
+
+    EXPECT_EQ(manager->RemoveIf([](int*) { return true; }), 33u);
+    EXPECT_EQ(manager->Delta(), 0u);
+}
+
+TEST_F(HandleManagerTest, ForEachVisitsExactlyTheLiveHandlesAtOccupancy)
+{
+    const uint32_t slot_count = 4096;
+
+    for (int occupancy_percent : {1, 10, 50, 100})
+    {
+        ZEngine::Helpers::HandleManager<int*>       pool(slot_count);
+        std::vector<int>                            values(slot_count);
+        std::vector<ZEngine::Helpers::Handle<int*>> handles;
+        for (uint32_t i = 0; i < slot_count; ++i)
+        {
+            values[i] = static_cast<int>(i);
+            handles.push_back(pool.Add(&values[i]));
+        }
+
+        /*
+         * Spread the survivors over the whole range, the way long-lived resources end up after churn
+         */
+        std::multiset<int> expected;
+        for (uint32_t i = 0; i < slot_count; ++i)
+        {
+            if (((i * 2654435761u) % 100) >= static_cast<uint32_t>(occupancy_percent))
+            {
+                pool.Remove(handles[i]);
+            }
+            else
+            {
+                expected.insert(values[i]);
+            }
+        }
+
+        std::multiset<int> visited;
+        pool.ForEach([&](int* value) { visited.insert(*value); });
+
+        EXPECT_EQ(pool.Delta(), expected.size());
+        EXPECT_EQ(visited, expected);
+    }
+}